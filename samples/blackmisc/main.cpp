@@ -55,6 +55,18 @@ int main(int argc, char *argv[])
         qtout << "6e .. string utils vs.regex" << Qt::endl;
         qtout << "6f .. string concatenation (+=, arg, ..)" << Qt::endl;
         qtout << "6g .. const &QString vs. QStringLiteral" << Qt::endl;
+        qtout << "6h .. Audio mixing 4 receivers x 5 callsigns" << Qt::endl;
+        qtout << "6i .. Model matching 50k models, 200 aircraft" << Qt::endl;
+        qtout << "6j .. Geo spatial index 40k airports" << Qt::endl;
+        qtout << "6k .. Interpolation per frame 50/200/500 aircraft" << Qt::endl;
+        qtout << "6l .. Compact situation histories 500 aircraft" << Qt::endl;
+        qtout << "6m .. METAR decoding" << Qt::endl;
+        qtout << "6n .. Logging from 1/4 threads" << Qt::endl;
+        qtout << "6o .. Replay interpolation trace" << Qt::endl;
+        qtout << "6p .. DB JSON decoding of the shared files" << Qt::endl;
+        qtout << "6q .. AFV voice datagrams" << Qt::endl;
+        qtout << "6r .. AFV jitter buffer" << Qt::endl;
+        qtout << "6s .. AFV microphone capture" << Qt::endl;
         qtout << "7 .. Algorithms" << Qt::endl;
         qtout << "8 .. File/Directory" << Qt::endl;
         qtout << "-----" << Qt::endl;
@@ -73,6 +85,24 @@ int main(int argc, char *argv[])
         else if (s.startsWith("6e")) { CSamplesPerformance::samplesStringUtilsVsRegEx(qtout); }
         else if (s.startsWith("6f")) { CSamplesPerformance::samplesStringConcat(qtout); }
         else if (s.startsWith("6g")) { CSamplesPerformance::samplesStringLiteralVsConstQString(qtout); }
+        else if (s.startsWith("6h")) { CSamplesPerformance::samplesAudioMixing(qtout, 4, 5); }
+        else if (s.startsWith("6i")) { CSamplesPerformance::samplesModelMatching(qtout, 50000, 200); }
+        else if (s.startsWith("6j")) { CSamplesPerformance::samplesGeoSpatialIndex(qtout, 40000, 1000); }
+        else if (s.startsWith("6k"))
+        {
+            for (int aircraft : { 50, 200, 500 }) { CSamplesPerformance::samplesInterpolationPerFrame(qtout, aircraft, 600); }
+        }
+        else if (s.startsWith("6l")) { CSamplesPerformance::samplesCompactSituations(qtout, 500, 1000); }
+        else if (s.startsWith("6m")) { CSamplesPerformance::samplesMetarDecoding(qtout, 30); }
+        else if (s.startsWith("6n"))
+        {
+            for (int threads : { 1, 4 }) { CSamplesPerformance::samplesLogging(qtout, threads, 20000); }
+        }
+        else if (s.startsWith("6o")) { CSamplesPerformance::samplesInterpolationTrace(qtout, 50, 1000); }
+        else if (s.startsWith("6p")) { CSamplesPerformance::samplesDbJsonDecoding(qtout, 3); }
+        else if (s.startsWith("6q")) { CSamplesPerformance::samplesAfvVoiceDatagrams(qtout, 200000); }
+        else if (s.startsWith("6r")) { CSamplesPerformance::samplesAfvJitterBuffer(qtout, 20); }
+        else if (s.startsWith("6s")) { CSamplesPerformance::samplesAfvMicrophoneCapture(qtout, 5000); }
         else if (s.startsWith("7"))  { CSamplesAlgorithm::samples(); }
         else if (s.startsWith("8"))  { CSamplesFile::samples(qtout); }
         else if (s.startsWith("x"))  { break; }
@@ -1,13 +1,13 @@
 load(common_pre)
 
-QT += core dbus network
+QT += core dbus network multimedia
 
 TARGET = sampleblackmisc
 TEMPLATE = app
 
 CONFIG   += console
 CONFIG   -= app_bundle
-CONFIG   += blackmisc blackcore blackgui blackconfig
+CONFIG   += blackmisc blacksound blackcore blackgui blackconfig
 
 DEPENDPATH += . $$SourceRoot/src/blackmisc
 INCLUDEPATH += . $$SourceRoot/src
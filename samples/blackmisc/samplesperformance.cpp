@@ -11,26 +11,67 @@
 
 #include "samplesperformance.h"
 #include "blackcore/db/databasereader.h"
+#include "blackcore/db/databaseutils.h"
+#include "blackcore/aircraftmatcher.h"
+#include "blackcore/afv/audio/input.h"
+#include "blackcore/afv/audio/jitterbuffersampleprovider.h"
+#include "blackcore/afv/crypto/cryptodtochannel.h"
+#include "blackcore/afv/crypto/cryptodtoserializer.h"
+#include "blackcore/afv/dto.h"
 #include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/aircraftmodelsetindex.h"
+#include "blackmisc/simulation/simulatedaircraft.h"
+#include "blackmisc/simulation/simulatedaircraftlist.h"
 #include "blackmisc/simulation/distributorlist.h"
+#include "blackmisc/simulation/interpolationbatch.h"
+#include "blackmisc/simulation/interpolationlogger.h"
+#include "blackmisc/simulation/interpolationtrace.h"
+#include "blackmisc/simulation/interpolatormulti.h"
+#include "blackmisc/simulation/remoteaircraftproviderdummy.h"
 #include "blackmisc/aviation/aircrafticaocodelist.h"
 #include "blackmisc/aviation/aircraftsituation.h"
 #include "blackmisc/aviation/aircraftsituationlist.h"
+#include "blackmisc/aviation/airportlist.h"
+#include "blackmisc/aviation/airlineicaocodelist.h"
 #include "blackmisc/aviation/altitude.h"
 #include "blackmisc/aviation/atcstation.h"
 #include "blackmisc/aviation/atcstationlist.h"
 #include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/compactsituation.h"
+#include "blackmisc/aviation/heading.h"
 #include "blackmisc/aviation/liverylist.h"
 #include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/geo/geospatialindex.h"
+#include "blackmisc/geo/latitude.h"
+#include "blackmisc/geo/longitude.h"
 #include "blackmisc/math/mathutils.h"
 #include "blackmisc/pq/units.h"
+#include "blackmisc/weather/metardecoder.h"
+#include "blackmisc/loghandler.h"
+#include "blackmisc/logmessage.h"
+#include "blackmisc/weather/metarlist.h"
 #include "blackmisc/test/testing.h"
 #include "blackmisc/swiftdirectories.h"
 #include "blackmisc/directoryutils.h"
+#include "blackmisc/fileutils.h"
 #include "blackmisc/stringutils.h"
-
+#include "blackmisc/db/dbinfo.h"
+#include "blacksound/sampleprovider/bufferedwaveprovider.h"
+#include "blacksound/sampleprovider/equalizersampleprovider.h"
+#include "blacksound/sampleprovider/mixingsampleprovider.h"
+#include "blacksound/sampleprovider/sawtoothgenerator.h"
+#include "blacksound/sampleprovider/simplecompressoreffect.h"
+#include "blacksound/sampleprovider/volumesampleprovider.h"
+#include "blacksound/dsp/samplekernels.h"
+#include "blacksound/audioutilities.h"
+#include "blacksound/codecs/opusencoder.h"
+
+#include <QAudioFormat>
 #include <QDateTime>
+#include <QDir>
+#include <QFile>
 #include <QHash>
+#include <QHostAddress>
 #include <QList>
 #include <QRegExp>
 #include <QRegularExpression>
@@ -39,11 +80,64 @@
 #include <QStringList>
 #include <QStringBuilder>
 #include <QTextStream>
+#include <QThread>
 #include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QNetworkDatagram>
+#include <QUdpSocket>
 #include <QVector>
+#include <QtMath>
 #include <Qt>
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <iterator>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#if defined(Q_OS_LINUX) && defined(__GLIBC__)
+#include <malloc.h>
+#define BLACKSAMPLE_COUNT_MALLOC
+
+//! \cond PRIVATE
+extern "C"
+{
+    // the glibc implementation, called by the counting functions below
+    void *__libc_malloc(size_t size);
+    void *__libc_calloc(size_t count, size_t size);
+    void *__libc_realloc(void *ptr, size_t size);
+}
+
+namespace
+{
+    //! malloc, calloc and realloc calls of the process, as counted for samplesAfvVoiceDatagrams
+    std::atomic<qint64> g_mallocCount { 0 };
+}
+
+//! Counting malloc, Qt containers and operator new allocate with it
+extern "C" void *malloc(size_t size)
+{
+    g_mallocCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+//! Counting calloc
+extern "C" void *calloc(size_t count, size_t size)
+{
+    g_mallocCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+//! Counting realloc
+extern "C" void *realloc(void *ptr, size_t size)
+{
+    g_mallocCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(ptr, size);
+}
+//! \endcond
+#endif
 
 using namespace BlackMisc;
 using namespace BlackMisc::Aviation;
@@ -53,7 +147,10 @@ using namespace BlackMisc::Network;
 using namespace BlackMisc::PhysicalQuantities;
 using namespace BlackMisc::Simulation;
 using namespace BlackMisc::Test;
+using namespace BlackMisc::Weather;
 using namespace BlackCore::Db;
+using namespace BlackCore::Afv::Crypto;
+using namespace BlackSound::SampleProvider;
 
 namespace BlackSample
 {
@@ -668,6 +765,962 @@ namespace BlackSample
         return EXIT_SUCCESS;
     }
 
+    int CSamplesPerformance::samplesAudioMixing(QTextStream &out, int numberOfReceivers, int numberOfCallsigns)
+    {
+        QAudioFormat format;
+        format.setSampleRate(48000);
+        format.setChannelCount(1);
+        format.setSampleSize(32);
+        format.setSampleType(QAudioFormat::Float);
+        format.setByteOrder(QAudioFormat::LittleEndian);
+        format.setCodec("audio/pcm");
+
+        // same chain as in the AFV receive path: voice input -> compressor -> EQ, mixed with noise, per receiver volume
+        QObject owner;
+        CMixingSampleProvider *soundcard = new CMixingSampleProvider(&owner);
+        QVector<CBufferedWaveProvider *> voiceInputs;
+        for (int r = 0; r < numberOfReceivers; r++)
+        {
+            CMixingSampleProvider *receiverMixer = new CMixingSampleProvider(&owner);
+            for (int c = 0; c < numberOfCallsigns; c++)
+            {
+                CMixingSampleProvider *callsignMixer = new CMixingSampleProvider(&owner);
+                CBufferedWaveProvider *voice = new CBufferedWaveProvider(format, &owner);
+                CSimpleCompressorEffect *compressor = new CSimpleCompressorEffect(voice, &owner);
+                CEqualizerSampleProvider *equalizer = new CEqualizerSampleProvider(compressor, BlackSound::SampleProvider::VHFEmulation, &owner);
+                CSawToothGenerator *busNoise = new CSawToothGenerator(400, &owner);
+                busNoise->setGain(0.01);
+                callsignMixer->addMixerInput(equalizer);
+                callsignMixer->addMixerInput(busNoise);
+                receiverMixer->addMixerInput(callsignMixer);
+                voiceInputs.push_back(voice);
+            }
+            CVolumeSampleProvider *volume = new CVolumeSampleProvider(receiverMixer, &owner);
+            volume->setGainRatio(0.8);
+            soundcard->addMixerInput(volume);
+        }
+
+        // 20ms frames, 10 seconds
+        constexpr int FrameSamples = 960;
+        constexpr int Frames = 500;
+        QVector<float> voiceFrame(FrameSamples);
+        for (int i = 0; i < FrameSamples; i++) { voiceFrame[i] = static_cast<float>(0.5 * qSin(2.0 * M_PI * 440.0 * i / 48000.0)); }
+
+        QVector<float> output(FrameSamples);
+        qint64 renderNs = 0;
+        QElapsedTimer timer;
+        for (int f = 0; f < Frames; f++)
+        {
+            for (CBufferedWaveProvider *voice : as_const(voiceInputs)) { voice->addSamples(voiceFrame); }
+            timer.start();
+            soundcard->readSamplesInto(output.data(), FrameSamples);
+            renderNs += timer.nsecsElapsed();
+        }
+
+        const qint64 samples = static_cast<qint64>(Frames) * FrameSamples;
+        out << "Audio mixing " << numberOfReceivers << " receivers x " << numberOfCallsigns << " callsigns, SIMD: " << boolToYesNo(BlackSound::Dsp::hasSimdSampleKernels()) << Qt::endl;
+        out << "Rendered " << samples << " samples in " << (renderNs / 1000000) << "ms, "
+            << (static_cast<double>(renderNs) / samples) << "ns per output sample" << Qt::endl;
+        out << "-----------------------------------------------"  << Qt::endl;
+        return EXIT_SUCCESS;
+    }
+
+    int CSamplesPerformance::samplesModelMatching(QTextStream &out, int numberOfModels, int numberOfAircraft)
+    {
+        const CAircraftModelList models = createMatchingModels(numberOfModels);
+
+        // remote aircraft without model string, every 4th with an unknown type so reductions have to fall back
+        QVector<CSimulatedAircraft> remoteAircraft;
+        for (int i = 0; i < numberOfAircraft; i++)
+        {
+            CAircraftModel model = models[CMathUtils::randomInteger(0, models.size() - 1)];
+            model.setModelString({});
+            if (i % 4 == 0) { model.setAircraftIcaoCode(CAircraftIcaoCode("ZZZZ", "L2J")); }
+            CSimulatedAircraft aircraft(model);
+            aircraft.setCallsign(CCallsign("SWIFT" + QString::number(i)));
+            remoteAircraft.push_back(aircraft);
+        }
+
+        // the same reduction stages as in the matcher, each stage only applied if it finds something
+        QVector<CAircraftModelList> byList;
+        QElapsedTimer timer;
+        timer.start();
+        for (const CSimulatedAircraft &aircraft : as_const(remoteAircraft))
+        {
+            CAircraftModelList candidates(models);
+            const auto reduce = [&candidates](const CAircraftModelList &reduced) { if (!reduced.isEmpty()) { candidates = reduced; } };
+            reduce(candidates.findByAircraftDesignatorAndLiveryCombinedCode(aircraft.getAircraftIcaoCodeDesignator(), aircraft.getLivery().getCombinedCode()));
+            reduce(candidates.findByIcaoDesignators(aircraft.getAircraftIcaoCode(), CAirlineIcaoCode::null()));
+            reduce(candidates.findByFamily(aircraft.getAircraftIcaoCode().getFamily()));
+            reduce(candidates.findByIcaoDesignators(CAircraftIcaoCode::null(), aircraft.getAirlineIcaoCode()));
+            reduce(candidates.findByCombinedAndManufacturer(aircraft.getAircraftIcaoCode()));
+            reduce(candidates.findByCombinedType(aircraft.getAircraftIcaoCode().getCombinedType()));
+            reduce(candidates.findByManufacturer(aircraft.getAircraftIcaoCode().getManufacturer()));
+            reduce(candidates.findByMilitaryFlag(aircraft.getModel().isMilitary()));
+            byList.push_back(candidates);
+        }
+        const qint64 listMs = timer.elapsed();
+
+        timer.start();
+        const CAircraftModelSetIndex index(models);
+        const qint64 indexBuildMs = timer.elapsed();
+
+        QVector<CAircraftModelSetIndex::ModelIds> byIndex;
+        timer.start();
+        for (const CSimulatedAircraft &aircraft : as_const(remoteAircraft))
+        {
+            CAircraftModelSetIndex::ModelIds candidates(index.allIds());
+            const auto reduce = [&candidates](const CAircraftModelSetIndex::ModelIds &ids)
+            {
+                const CAircraftModelSetIndex::ModelIds reduced = CAircraftModelSetIndex::intersect(candidates, ids);
+                if (!reduced.isEmpty()) { candidates = reduced; }
+            };
+            reduce(index.findByAircraftDesignatorAndLiveryCombinedCode(aircraft.getAircraftIcaoCodeDesignator(), aircraft.getLivery().getCombinedCode()));
+            reduce(index.findByIcaoDesignators(aircraft.getAircraftIcaoCode(), CAirlineIcaoCode::null()));
+            reduce(index.findByFamily(aircraft.getAircraftIcaoCode().getFamily()));
+            reduce(index.findByIcaoDesignators(CAircraftIcaoCode::null(), aircraft.getAirlineIcaoCode()));
+            reduce(index.findByCombinedAndManufacturer(aircraft.getAircraftIcaoCode()));
+            reduce(index.findByCombinedType(aircraft.getAircraftIcaoCode().getCombinedType()));
+            reduce(index.findByManufacturer(aircraft.getAircraftIcaoCode().getManufacturer()));
+            reduce(index.findByMilitaryFlag(aircraft.getModel().isMilitary()));
+            byIndex.push_back(candidates);
+        }
+        const qint64 indexMs = timer.elapsed();
+
+        int differences = 0;
+        for (int i = 0; i < byList.size(); i++)
+        {
+            if (byList[i].getModelStringList(false) != index.toModels(byIndex[i]).getModelStringList(false)) { differences++; }
+        }
+
+        // complete matching with the default setup
+        BlackCore::CAircraftMatcher matcher;
+        matcher.setModelSet(models, CSimulatorInfo::FSX, true);
+        timer.start();
+        matcher.getModelSetIndex();
+        const qint64 matcherIndexMs = timer.elapsed();
+        timer.start();
+        for (const CSimulatedAircraft &aircraft : as_const(remoteAircraft))
+        {
+            matcher.getClosestMatch(aircraft, MatchingLogNothing, nullptr, false);
+        }
+        const qint64 matchingMs = timer.elapsed();
+
+        // same aircraft matched in parallel, results have to be the same
+        const CSimulatedAircraftList aircraftList(CSequence<CSimulatedAircraft>(remoteAircraft));
+        timer.start();
+        const CAircraftModelList batchMatched = matcher.getClosestMatches(aircraftList, MatchingLogNothing, nullptr, false);
+        const qint64 batchMatchingMs = timer.elapsed();
+        int batchDifferences = 0;
+        for (int i = 0; i < aircraftList.size(); i++)
+        {
+            if (batchMatched[i].getModelString() != matcher.getClosestMatch(aircraftList[i], MatchingLogNothing, nullptr, false).getModelString()) { batchDifferences++; }
+        }
+
+        out << "Model matching, " << models.size() << " models, " << remoteAircraft.size() << " aircraft" << Qt::endl;
+        out << "Reduction stages on model list:    " << listMs << "ms" << Qt::endl;
+        out << "Building model set index:          " << indexBuildMs << "ms" << Qt::endl;
+        out << "Reduction stages on index:         " << indexMs << "ms" << Qt::endl;
+        out << "Different results:                 " << differences << Qt::endl;
+        out << "Matcher index (lazy, once per set) " << matcherIndexMs << "ms" << Qt::endl;
+        out << "Matcher getClosestMatch:           " << matchingMs << "ms" << Qt::endl;
+        out << "Matcher getClosestMatches:         " << batchMatchingMs << "ms, " << QThread::idealThreadCount() << " threads" << Qt::endl;
+        out << "Different batch results:           " << batchDifferences << Qt::endl;
+        out << "-----------------------------------------------"  << Qt::endl;
+        return EXIT_SUCCESS;
+    }
+
+    int CSamplesPerformance::samplesGeoSpatialIndex(QTextStream &out, int numberOfAirports, int numberOfQueries)
+    {
+        const CAirportList airports = createAirports(numberOfAirports);
+        QVector<CCoordinateGeodetic> positions;
+        for (int i = 0; i < numberOfQueries; i++)
+        {
+            positions.push_back(CCoordinateGeodetic(CMathUtils::randomDouble(180.0) - 90.0, CMathUtils::randomDouble(360.0) - 180.0));
+        }
+        const CLength range(100, CLengthUnit::km());
+        const CLength closeRange(10, CLengthUnit::NM());
+        constexpr int closest = 20;
+
+        QElapsedTimer timer;
+        timer.start();
+        CGeoSpatialIndex index = CGeoSpatialIndex::fromObjects(airports);
+        const qint64 buildMs = timer.elapsed();
+
+        // within range
+        int foundList = 0;
+        timer.start();
+        for (const CCoordinateGeodetic &position : as_const(positions)) { foundList += airports.findWithinRange(position, range).size(); }
+        const qint64 rangeListMs = timer.elapsed();
+        int foundIndex = 0;
+        timer.start();
+        for (const CCoordinateGeodetic &position : as_const(positions)) { foundIndex += airports.findWithinRange(index, position, range).size(); }
+        const qint64 rangeIndexMs = timer.elapsed();
+
+        // n closest, as for the airports in range of the simulator
+        int differences = 0;
+        QVector<CAirportList> closestByList;
+        timer.start();
+        for (const CCoordinateGeodetic &position : as_const(positions)) { closestByList.push_back(airports.findClosest(closest, position)); }
+        const qint64 closestListMs = timer.elapsed();
+        QVector<CAirportList> closestByIndex;
+        timer.start();
+        for (const CCoordinateGeodetic &position : as_const(positions)) { closestByIndex.push_back(airports.findClosest(index, closest, position)); }
+        const qint64 closestIndexMs = timer.elapsed();
+        for (int i = 0; i < positions.size(); i++)
+        {
+            if (closestByList[i].size() != closestByIndex[i].size()) { differences++; continue; }
+            for (int j = 0; j < closestByList[i].size(); j++)
+            {
+                if (calculateEuclideanDistanceSquared(closestByList[i][j], positions[i]) != calculateEuclideanDistanceSquared(closestByIndex[i][j], positions[i])) { differences++; break; }
+            }
+        }
+
+        // closest within a small range
+        timer.start();
+        for (const CCoordinateGeodetic &position : as_const(positions)) { airports.findClosestWithinRange(position, closeRange); }
+        const qint64 closestRangeListMs = timer.elapsed();
+        timer.start();
+        for (const CCoordinateGeodetic &position : as_const(positions)) { airports.findClosestWithinRange(index, position, closeRange); }
+        const qint64 closestRangeIndexMs = timer.elapsed();
+
+        // positions moving, as aircraft do
+        timer.start();
+        for (int i = 0; i < positions.size(); i++) { index.update(i % index.size(), positions[i]); }
+        const qint64 updateMs = timer.elapsed();
+
+        out << "Geo spatial index, " << airports.size() << " airports, " << positions.size() << " queries, cell size " << index.getCellSize() << Qt::endl;
+        out << "Building index:                   " << buildMs << "ms" << Qt::endl;
+        out << "Within " << range.toQString() << " on list:          " << rangeListMs << "ms, found " << foundList << Qt::endl;
+        out << "Within " << range.toQString() << " on index:         " << rangeIndexMs << "ms, found " << foundIndex << Qt::endl;
+        out << closest << " closest on list:               " << closestListMs << "ms" << Qt::endl;
+        out << closest << " closest on index:              " << closestIndexMs << "ms" << Qt::endl;
+        out << "Different closest results:        " << differences << Qt::endl;
+        out << "Closest within " << closeRange.toQString() << " on list:  " << closestRangeListMs << "ms" << Qt::endl;
+        out << "Closest within " << closeRange.toQString() << " on index: " << closestRangeIndexMs << "ms" << Qt::endl;
+        out << "Index updates:                    " << updateMs << "ms" << Qt::endl;
+        out << "-----------------------------------------------"  << Qt::endl;
+        return EXIT_SUCCESS;
+    }
+
+    int CSamplesPerformance::samplesInterpolationPerFrame(QTextStream &out, int numberOfAircraft, int numberOfFrames)
+    {
+        // fixed time, FSD like updates every 5secs
+        constexpr qint64 ts = 1425000000000;
+        constexpr qint64 deltaT = 5000;
+        constexpr qint64 offset = 5000;
+
+        CRemoteAircraftProviderDummy provider;
+        CCallsignSet callsigns;
+        for (int a = 0; a < numberOfAircraft; a++)
+        {
+            const CCallsign callsign("CS" + QString::number(a));
+            callsigns.push_back(callsign);
+            for (int i = IRemoteAircraftProvider::MaxSituationsPerCallsign - 1; i >= 0; i--)
+            {
+                const CLatitude lat(a * 0.1 - i * 0.01, CAngleUnit::deg());
+                const CLongitude lng(a * 0.1 - i * 0.02, CAngleUnit::deg());
+                const CAltitude alt(10000 - i * 100, CAltitude::MeanSeaLevel, CLengthUnit::ft());
+                CAircraftSituation s(callsign, CCoordinateGeodetic(lat, lng, alt), CHeading(a % 360, CHeading::True, CAngleUnit::deg()),
+                                     CAngle(2, CAngleUnit::deg()), CAngle(i, CAngleUnit::deg()), CSpeed(250, CSpeedUnit::kts()));
+                s.setMSecsSinceEpoch(ts - deltaT * i);
+                s.setTimeOffsetMs(offset);
+                provider.insertNewSituation(s);
+            }
+        }
+
+        // the same interpolators as the drivers, separate ones for the batch as they keep the state of the last step
+        std::vector<std::unique_ptr<CInterpolatorMulti>> interpolators;
+        std::vector<std::unique_ptr<CInterpolatorMulti>> batchInterpolators;
+        for (const CCallsign &callsign : callsigns)
+        {
+            interpolators.push_back(std::make_unique<CInterpolatorMulti>(callsign, nullptr, nullptr, &provider));
+            batchInterpolators.push_back(std::make_unique<CInterpolatorMulti>(callsign, nullptr, nullptr, &provider));
+        }
+        CInterpolationBatch batch;
+
+        // frames between the 2 latest situations
+        const qint64 from = ts - 2 * deltaT + offset;
+        const qint64 frameMs = qMax<qint64>(1, 2 * deltaT / qMax(1, numberOfFrames));
+        const auto perFrameUs = [numberOfFrames](qint64 ns) { return ns / 1000 / qMax(1, numberOfFrames); };
+
+        out << "Interpolation, " << numberOfAircraft << " aircraft, " << numberOfFrames << " frames" << Qt::endl;
+        for (CInterpolationAndRenderingSetupBase::InterpolatorMode mode : { CInterpolationAndRenderingSetupBase::Linear, CInterpolationAndRenderingSetupBase::Spline })
+        {
+            CInterpolationAndRenderingSetupPerCallsign setup;
+            setup.setInterpolatorMode(mode);
+
+            int interpolated = 0;
+            QElapsedTimer timer;
+            timer.start();
+            for (int f = 0; f < numberOfFrames; f++)
+            {
+                int aircraftNumber = 0;
+                for (const auto &interpolator : interpolators)
+                {
+                    if (interpolator->getInterpolation(from + f * frameMs, setup, aircraftNumber++).getInterpolationStatus().isInterpolated()) { interpolated++; }
+                }
+            }
+            const qint64 perAircraftNs = timer.nsecsElapsed();
+
+            int interpolatedBatch = 0;
+            timer.start();
+            for (int f = 0; f < numberOfFrames; f++)
+            {
+                // as in the drivers, the aircraft are added again for every frame
+                batch.clear();
+                int aircraftNumber = 0;
+                for (const auto &interpolator : batchInterpolators) { batch.add(interpolator.get(), setup, aircraftNumber++); }
+                for (const CInterpolationResult &result : batch.interpolate(from + f * frameMs))
+                {
+                    if (result.getInterpolationStatus().isInterpolated()) { interpolatedBatch++; }
+                }
+            }
+            const qint64 batchNs = timer.nsecsElapsed();
+
+            // both ways shall give the same positions
+            double maxDiffM = 0.0;
+            for (int a = 0; a < numberOfAircraft; a++)
+            {
+                const CAircraftSituation &s = interpolators[static_cast<std::size_t>(a)]->getLastInterpolatedSituation(mode);
+                const CAircraftSituation &sb = batchInterpolators[static_cast<std::size_t>(a)]->getLastInterpolatedSituation(mode);
+                if (s.isNull() || sb.isNull()) { continue; }
+                maxDiffM = qMax(maxDiffM, s.calculateGreatCircleDistance(sb).value(CLengthUnit::m()));
+            }
+
+            const QString &modeString = CInterpolationAndRenderingSetupBase::modeToString(mode);
+            out << modeString << " per aircraft: " << perFrameUs(perAircraftNs) << "us/frame, interpolated " << interpolated << Qt::endl;
+            out << modeString << " batch:        " << perFrameUs(batchNs) << "us/frame, interpolated " << interpolatedBatch << ", max. difference " << maxDiffM << "m" << Qt::endl;
+        }
+        out << "-----------------------------------------------"  << Qt::endl;
+        return EXIT_SUCCESS;
+    }
+
+    int CSamplesPerformance::samplesCompactSituations(QTextStream &out, int numberOfAircraft, int numberOfCopies)
+    {
+        constexpr qint64 ts = 1425000000000;
+        constexpr int historySize = IRemoteAircraftProvider::MaxSituationsPerCallsign;
+        const int numberOfSituations = numberOfAircraft * historySize;
+
+        std::vector<CAircraftSituation> situations;
+        situations.reserve(static_cast<size_t>(numberOfSituations));
+        for (int a = 0; a < numberOfAircraft; a++)
+        {
+            const CCallsign callsign("CS" + QString::number(a));
+            for (int i = 0; i < historySize; i++)
+            {
+                const CLatitude lat(a * 0.1 - i * 0.01, CAngleUnit::deg());
+                const CLongitude lng(a * 0.1 - i * 0.02, CAngleUnit::deg());
+                const CAltitude alt(10000 - i * 100, CAltitude::MeanSeaLevel, CLengthUnit::ft());
+                CAircraftSituation s(callsign, CCoordinateGeodetic(lat, lng, alt), CHeading(a % 360, CHeading::True, CAngleUnit::deg()),
+                                     CAngle(2, CAngleUnit::deg()), CAngle(i, CAngleUnit::deg()), CSpeed(250, CSpeedUnit::kts()));
+                s.setMSecsSinceEpoch(ts - 5000 * i);
+                s.setTimeOffsetMs(5000);
+                s.setGroundElevation(CAltitude(500, CAltitude::MeanSeaLevel, CLengthUnit::ft()), CAircraftSituation::FromProvider);
+                situations.push_back(s);
+            }
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        std::vector<CCompactSituation> compact(static_cast<size_t>(numberOfSituations));
+        for (int c = 0; c < numberOfCopies; c++)
+        {
+            for (size_t i = 0; i < situations.size(); i++) { compact[i] = CCompactSituation::fromSituation(situations[i]); }
+        }
+        const qint64 toCompactNs = timer.nsecsElapsed();
+
+        std::vector<CAircraftSituation> situationsCopy(situations.size());
+        timer.start();
+        for (int c = 0; c < numberOfCopies; c++)
+        {
+            std::copy(situations.cbegin(), situations.cend(), situationsCopy.begin());
+        }
+        const qint64 copyNs = timer.nsecsElapsed();
+
+        std::vector<CCompactSituation> compactCopy(compact.size());
+        timer.start();
+        for (int c = 0; c < numberOfCopies; c++)
+        {
+            std::copy(compact.cbegin(), compact.cend(), compactCopy.begin());
+        }
+        const qint64 compactCopyNs = timer.nsecsElapsed();
+
+        const auto perSecond = [numberOfSituations, numberOfCopies](qint64 ns) { return static_cast<qint64>(1.0e9 * numberOfSituations * numberOfCopies / qMax<qint64>(1, ns)); };
+        out << "Situation histories, " << numberOfAircraft << " aircraft x " << historySize << " situations, " << numberOfCopies << " copies" << Qt::endl;
+        out << "CAircraftSituation: " << sizeof(CAircraftSituation) << " bytes, " << sizeof(CAircraftSituation) * situations.size() / 1024 << "kB without strings, " << perSecond(copyNs) << " copies/s" << Qt::endl;
+        out << "CCompactSituation:  " << sizeof(CCompactSituation) << " bytes, " << sizeof(CCompactSituation) * compact.size() / 1024 << "kB, " << perSecond(compactCopyNs) << " copies/s" << Qt::endl;
+        out << "Conversion to compact: " << perSecond(toCompactNs) << " situations/s" << Qt::endl;
+        out << "Check: " << compactCopy.back().getAdjustedMSecsSinceEpoch() << " " << situationsCopy.back().getAdjustedMSecsSinceEpoch() << Qt::endl;
+        out << "-----------------------------------------------"  << Qt::endl;
+        return EXIT_SUCCESS;
+    }
+
+    int CSamplesPerformance::samplesMetarDecoding(QTextStream &out, int numberOfCopies)
+    {
+        const QString metars = CFileUtils::readFileToString(CSwiftDirectories::shareTestDirectory(), "metars.txt");
+        if (metars.isEmpty())
+        {
+            out << "No METAR test file" << Qt::endl;
+            return EXIT_FAILURE;
+        }
+
+        // a file of the size of a global METAR dump
+        QString metarFile;
+        for (int c = 0; c < numberOfCopies; c++) { metarFile += metars; }
+        const QStringList lines = metarFile.split('\n');
+
+        const CMetarDecoder decoder;
+        QElapsedTimer timer;
+        timer.start();
+        int validRegExp = 0;
+        for (const QString &line : lines)
+        {
+            if (line.trimmed().isEmpty()) { continue; }
+            if (decoder.decodeByRegularExpressions(line) != CMetar()) { validRegExp++; }
+        }
+        const qint64 regExpMs = timer.elapsed();
+
+        timer.start();
+        int validSinglePass = 0;
+        for (const QString &line : lines)
+        {
+            if (line.trimmed().isEmpty()) { continue; }
+            if (decoder.decode(line) != CMetar()) { validSinglePass++; }
+        }
+        const qint64 singlePassMs = timer.elapsed();
+
+        timer.start();
+        int invalid = 0;
+        const CMetarList decoded = decoder.decodeMetarFile(metarFile, &invalid);
+        const qint64 fileMs = timer.elapsed();
+
+        out << "METAR decoding, " << lines.size() << " lines" << Qt::endl;
+        out << "Regular expressions: " << regExpMs << "ms, valid " << validRegExp << Qt::endl;
+        out << "Single pass: " << singlePassMs << "ms, valid " << validSinglePass << Qt::endl;
+        out << "Parallel file, " << QThread::idealThreadCount() << " threads: " << fileMs << "ms, valid " << decoded.size() << " invalid " << invalid << Qt::endl;
+        out << "-----------------------------------------------"  << Qt::endl;
+        return EXIT_SUCCESS;
+    }
+
+    int CSamplesPerformance::samplesLogging(QTextStream &out, int numberOfThreads, int numberOfMessages)
+    {
+        static const CLogCategory category("swift.sample.logging");
+        static const CLogCategoryList categories({ category });
+
+        // no console output for the sample messages, they still go to the log file
+        CLogSubscriber subscriber;
+        subscriber.changeSubscription(CLogPattern::exactMatch(category));
+        subscriber.enableConsoleOutput(false);
+
+        // logs from numberOfThreads threads while this thread dispatches, like the event loop would, returns ns per message
+        const auto logFromThreads = [ = ](const std::function<void(int)> &logOne)
+        {
+            std::atomic_int running { numberOfThreads };
+            std::atomic<qint64> loggingNs { 0 };
+            std::vector<std::thread> threads;
+            for (int t = 0; t < numberOfThreads; t++)
+            {
+                threads.emplace_back([&]
+                {
+                    QElapsedTimer timer;
+                    timer.start();
+                    for (int i = 0; i < numberOfMessages; i++) { logOne(i); }
+                    loggingNs += timer.nsecsElapsed();
+                    running--;
+                });
+            }
+            while (running > 0) { CLogHandler::instance()->flush(); QThread::msleep(1); }
+            for (std::thread &thread : threads) { thread.join(); }
+            CLogHandler::instance()->flush();
+            return loggingNs / (numberOfThreads * numberOfMessages);
+        };
+
+        const qint64 qtNs = logFromThreads([](int i)
+        {
+            QMessageLogger().debug(QLoggingCategory(category.toQString().toLatin1().constData())).noquote() << QStringLiteral("Sample message %1 of %2").arg(i).arg(QStringLiteral("logging"));
+        });
+        const qint64 deferredNs = logFromThreads([](int i)
+        {
+            CLogMessage(categories).debug(u"Sample message %1 of %2") << i << QStringLiteral("logging");
+        });
+
+        out << "Logging " << numberOfMessages << " messages from each of " << numberOfThreads << " threads" << Qt::endl;
+        out << "Qt message handler (formatted in the logging thread): " << qtNs << "ns per message" << Qt::endl;
+        out << "CLogMessage (queued, formatted when dispatched): " << deferredNs << "ns per message" << Qt::endl;
+        out << "-----------------------------------------------"  << Qt::endl;
+        return EXIT_SUCCESS;
+    }
+
+    int CSamplesPerformance::samplesInterpolationTrace(QTextStream &out, int numberOfAircraft, int numberOfFrames)
+    {
+        CInterpolationTrace trace;
+        const QString latestTrace = CInterpolationLogger::getLatestTraceFile();
+        if (!latestTrace.isEmpty() && trace.readFromFile(latestTrace))
+        {
+            out << "Trace file: " << latestTrace << Qt::endl;
+        }
+        else
+        {
+            // record a trace, FSD like updates every 5secs, 50 frames per second
+            constexpr qint64 ts = 1425000000000;
+            constexpr qint64 deltaT = 5000;
+            constexpr qint64 offset = 5000;
+            constexpr qint64 frameMs = 20;
+
+            CRemoteAircraftProviderDummy provider;
+            CInterpolationLogger logger;
+            logger.traceRecorder().setEnabled(true);
+            std::vector<std::unique_ptr<CInterpolatorMulti>> interpolators;
+            QVector<CCallsign> callsigns;
+            for (int a = 0; a < numberOfAircraft; a++)
+            {
+                callsigns.push_back(CCallsign("CS" + QString::number(a)));
+                interpolators.push_back(std::make_unique<CInterpolatorMulti>(callsigns.back(), nullptr, nullptr, &provider, &logger));
+            }
+
+            // even aircraft numbers linear, odd ones spline
+            CInterpolationAndRenderingSetupPerCallsign linearSetup;
+            CInterpolationAndRenderingSetupPerCallsign splineSetup;
+            linearSetup.setInterpolatorMode(CInterpolationAndRenderingSetupBase::Linear);
+            splineSetup.setInterpolatorMode(CInterpolationAndRenderingSetupBase::Spline);
+
+            for (int f = 0; f < numberOfFrames; f++)
+            {
+                const qint64 now = ts + f * frameMs;
+                if ((f * frameMs) % deltaT == 0)
+                {
+                    const int update = static_cast<int>(f * frameMs / deltaT);
+                    for (int a = 0; a < numberOfAircraft; a++)
+                    {
+                        const CLatitude lat(a * 0.1 + update * 0.01, CAngleUnit::deg());
+                        const CLongitude lng(a * 0.1 + update * 0.02, CAngleUnit::deg());
+                        const CAltitude alt(10000 + update * 100, CAltitude::MeanSeaLevel, CLengthUnit::ft());
+                        CAircraftSituation s(callsigns[a], CCoordinateGeodetic(lat, lng, alt), CHeading(a % 360, CHeading::True, CAngleUnit::deg()),
+                                             CAngle(2, CAngleUnit::deg()), CAngle(update % 10, CAngleUnit::deg()), CSpeed(250, CSpeedUnit::kts()));
+                        s.setMSecsSinceEpoch(now);
+                        s.setTimeOffsetMs(offset);
+                        provider.insertNewSituation(s);
+                        interpolators[static_cast<size_t>(a)]->markSituationsChanged();
+                    }
+                }
+                for (int a = 0; a < numberOfAircraft; a++)
+                {
+                    interpolators[static_cast<size_t>(a)]->getInterpolation(now, a % 2 ? splineSetup : linearSetup, a);
+                }
+            }
+
+            // round trip through a file
+            const QString fn = CFileUtils::appendFilePaths(QDir::tempPath(), "swiftsample_interpolation.trace");
+            const bool written = logger.traceRecorder().getTrace().writeToFile(fn) && trace.readFromFile(fn);
+            QFile::remove(fn);
+            if (!written)
+            {
+                out << "Writing/reading the trace failed" << Qt::endl;
+                return EXIT_FAILURE;
+            }
+            out << "Recorded " << numberOfAircraft << " aircraft, " << numberOfFrames << " frames" << Qt::endl;
+        }
+
+        out << "Trace: " << trace.getCallsigns().size() << " callsigns, " << trace.getInputs().size() << " inputs, " << trace.getSteps().size() << " steps" << Qt::endl;
+        QElapsedTimer timer;
+        timer.start();
+        const CInterpolationTrace::ReplayStatistics statistics = trace.replay();
+        const qint64 replayMs = timer.elapsed();
+        out << "Replay " << replayMs << "ms, " << statistics.toQString() << Qt::endl;
+        if (statistics.steps > 0) { out << "Interpolation: " << statistics.interpolationNs / statistics.steps << "ns per step" << Qt::endl; }
+        out << "-----------------------------------------------"  << Qt::endl;
+        return EXIT_SUCCESS;
+    }
+
+    int CSamplesPerformance::samplesDbJsonDecoding(QTextStream &out, int numberOfRuns)
+    {
+        const QString dir = CSwiftDirectories::staticDbFilesDirectory();
+        QStringList files;
+        for (CEntityFlags::Entity entity : { CEntityFlags::LiveryEntity, CEntityFlags::ModelEntity, CEntityFlags::AircraftIcaoEntity, CEntityFlags::AirlineIcaoEntity })
+        {
+            files.push_back(CFileUtils::appendFilePaths(dir, BlackMisc::Db::CDbInfo::entityToSharedName(entity)));
+        }
+        for (const QString &file : files)
+        {
+            if (QFile::exists(file)) { continue; }
+            out << "Missing shared DB file " << file << Qt::endl;
+            return EXIT_FAILURE;
+        }
+
+        // reading and parsing the JSON alone, part of both bootstraps
+        QElapsedTimer timer;
+        timer.start();
+        for (int r = 0; r < numberOfRuns; r++)
+        {
+            for (const QString &file : files) { CDatabaseUtils::readQJsonObjectFromDatabaseFile(file); }
+        }
+        const qint64 readMs = timer.elapsed() / numberOfRuns;
+
+        // one file after the other, one object after the other (as before)
+        int serialObjects = 0;
+        timer.start();
+        for (int r = 0; r < numberOfRuns; r++)
+        {
+            const auto dataArray = [](const QString &file) { return CDatabaseUtils::readQJsonObjectFromDatabaseFile(file).value("data").toArray(); };
+            CLiveryList liveries;
+            for (const QJsonValue &value : dataArray(files[0])) { liveries.push_back(CLivery::fromDatabaseJson(value.toObject())); }
+            CAircraftModelList models;
+            for (const QJsonValue &value : dataArray(files[1])) { models.push_back(CAircraftModel::fromDatabaseJson(value.toObject())); }
+            CAircraftIcaoCodeList aircraftIcaos;
+            for (const QJsonValue &value : dataArray(files[2])) { aircraftIcaos.push_back(CAircraftIcaoCode::fromDatabaseJson(value.toObject())); }
+            CAirlineIcaoCodeList airlineIcaos;
+            for (const QJsonValue &value : dataArray(files[3])) { airlineIcaos.push_back(CAirlineIcaoCode::fromDatabaseJson(value.toObject())); }
+            serialObjects = liveries.size() + models.size() + aircraftIcaos.size() + airlineIcaos.size();
+        }
+        const qint64 serialMs = timer.elapsed() / numberOfRuns;
+
+        // as the DB readers do it now: next file read ahead, objects decoded in parallel
+        int parallelObjects = 0;
+        timer.start();
+        for (int r = 0; r < numberOfRuns; r++)
+        {
+            CDatabaseFilesReadAhead readAhead(files);
+            const CLiveryList liveries = CLiveryList::fromMultipleJsonFormats(readAhead.take(files[0]));
+            const CAircraftModelList models = CAircraftModelList::fromMultipleJsonFormats(readAhead.take(files[1]));
+            const CAircraftIcaoCodeList aircraftIcaos = CAircraftIcaoCodeList::fromMultipleJsonFormats(readAhead.take(files[2]));
+            const CAirlineIcaoCodeList airlineIcaos = CAirlineIcaoCodeList::fromMultipleJsonFormats(readAhead.take(files[3]));
+            parallelObjects = liveries.size() + models.size() + aircraftIcaos.size() + airlineIcaos.size();
+        }
+        const qint64 parallelMs = timer.elapsed() / numberOfRuns;
+
+        out << "Shared DB files: " << dir << ", " << QThread::idealThreadCount() << " threads" << Qt::endl;
+        out << "Reading/parsing JSON: " << readMs << "ms" << Qt::endl;
+        out << "Serial bootstrap: " << serialMs << "ms, " << serialObjects << " objects" << Qt::endl;
+        out << "Parallel bootstrap: " << parallelMs << "ms, " << parallelObjects << " objects" << Qt::endl;
+        out << "-----------------------------------------------"  << Qt::endl;
+        return serialObjects == parallelObjects ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    int CSamplesPerformance::samplesAfvVoiceDatagrams(QTextStream &out, int numberOfPackets)
+    {
+        // the same key in both directions, so the channel can decrypt its own datagrams
+        const QByteArray key(static_cast<int>(crypto_aead_chacha20poly1305_IETF_KEYBYTES), 'k');
+        CCryptoDtoChannel channel(QStringLiteral("AFV-BENCHMARK"), key, key);
+
+        // a 20ms Opus frame on 2 transceivers, as received from the voice server
+        BlackCore::Afv::AudioRxOnTransceiversDto dto {};
+        dto.callsign = "DLH123";
+        dto.audio = std::vector<char>(80, 'a');
+        dto.lastPacket = false;
+        dto.transceivers = { { 0, 122800000, 1.0f }, { 1, 121500000, 0.5f } };
+
+        // the datagrams are sent over the loopback interface, the receiver acts as the voice client
+        QUdpSocket receiver;
+        QUdpSocket sender;
+        if (!receiver.bind(QHostAddress::LocalHost, 0))
+        {
+            out << "Cannot bind UDP socket: " << receiver.errorString() << Qt::endl;
+            return EXIT_FAILURE;
+        }
+        const QHostAddress receiverAddress(QHostAddress::LocalHost);
+        const quint16 receiverPort = receiver.localPort();
+
+        // malloc calls and heap in use of the whole process, so also the ones of the sockets
+        struct Allocations
+        {
+            qint64 calls = 0;
+            qint64 heapBytes = 0;
+        };
+        const auto allocations = []
+        {
+            Allocations a;
+#ifdef BLACKSAMPLE_COUNT_MALLOC
+            a.calls = g_mallocCount.load(std::memory_order_relaxed);
+#if __GLIBC_PREREQ(2, 33)
+            a.heapBytes = static_cast<qint64>(mallinfo2().uordblks);
+#endif
+#endif
+            return a;
+        };
+
+        // new buffers for each datagram, as before
+        int allocatingReceived = 0;
+        int datagramSize = 0;
+        QElapsedTimer timer;
+        timer.start();
+        const Allocations allocatingStart = allocations();
+        for (int i = 0; i < numberOfPackets; i++)
+        {
+            dto.sequenceCounter = static_cast<uint>(i);
+            const QByteArray datagram = CryptoDtoSerializer::serialize(channel, CryptoDtoMode::AEAD_ChaCha20Poly1305, dto);
+            sender.writeDatagram(datagram, receiverAddress, receiverPort);
+            if (!receiver.hasPendingDatagrams() && !receiver.waitForReadyRead(1000)) { continue; } // lost
+
+            const QNetworkDatagram received = receiver.receiveDatagram();
+            CryptoDtoSerializer::Deserializer deserializer = CryptoDtoSerializer::deserialize(channel, received.data(), false);
+            const BlackCore::Afv::AudioRxOnTransceiversDto decoded = deserializer.getDto<BlackCore::Afv::AudioRxOnTransceiversDto>();
+            if (decoded.sequenceCounter == dto.sequenceCounter && decoded.audio == dto.audio) { allocatingReceived++; }
+            datagramSize = datagram.size();
+        }
+        const Allocations allocatingEnd = allocations();
+        const qint64 allocatingNs = timer.nsecsElapsed();
+
+        // reused buffers, as CClientConnection does it now, the first datagram grows the buffers
+        CCryptoDtoEncoder encoder;
+        CCryptoDtoDecoder decoder;
+        BlackCore::Afv::AudioRxOnTransceiversDto decoded {};
+        decoder.decrypt(channel, encoder.serialize(channel, CryptoDtoMode::AEAD_ChaCha20Poly1305, dto), false);
+        decoder.getDto(decoded);
+
+        int reusingReceived = 0;
+        timer.start();
+        const Allocations reusingStart = allocations();
+        for (int i = 0; i < numberOfPackets; i++)
+        {
+            dto.sequenceCounter = static_cast<uint>(i);
+            const QByteArray &datagram = encoder.serialize(channel, CryptoDtoMode::AEAD_ChaCha20Poly1305, dto);
+            sender.writeDatagram(datagram, receiverAddress, receiverPort);
+            if (!receiver.hasPendingDatagrams() && !receiver.waitForReadyRead(1000)) { continue; } // lost
+
+            const qint64 size = receiver.pendingDatagramSize();
+            if (size < 0) { continue; }
+            const qint64 read = receiver.readDatagram(decoder.receiveBuffer(static_cast<int>(size)), size);
+            if (read < 0) { continue; }
+            if (decoder.decrypt(channel, static_cast<int>(read), false) && decoder.getDto(decoded) &&
+                    decoded.sequenceCounter == dto.sequenceCounter && decoded.audio == dto.audio) { reusingReceived++; }
+        }
+        const Allocations reusingEnd = allocations();
+        const qint64 reusingNs = timer.nsecsElapsed();
+
+        const auto packetsPerSecond = [ = ](qint64 ns) { return ns > 0 ? QString::number(1.0e9 * numberOfPackets / ns, 'f', 0) : QStringLiteral("-"); };
+        const auto perPacket = [ = ](const Allocations &start, const Allocations &end)
+        {
+#ifdef BLACKSAMPLE_COUNT_MALLOC
+            return QStringLiteral(", %1 malloc per packet, %2 bytes more heap in use").
+                   arg(static_cast<double>(end.calls - start.calls) / qMax(1, numberOfPackets), 0, 'f', 2).
+                   arg(end.heapBytes - start.heapBytes);
+#else
+            Q_UNUSED(start)
+            Q_UNUSED(end)
+            return QString();
+#endif
+        };
+        out << "AFV voice datagrams of " << datagramSize << " bytes, " << numberOfPackets << " packets encoded, encrypted, sent over UDP on " << receiverAddress.toString() << ", decrypted and decoded" << Qt::endl;
+        out << "Allocating buffers: " << packetsPerSecond(allocatingNs) << " packets/s" << perPacket(allocatingStart, allocatingEnd) << ", " << allocatingReceived << " verified" << Qt::endl;
+        out << "Reused buffers: " << packetsPerSecond(reusingNs) << " packets/s" << perPacket(reusingStart, reusingEnd) << ", " << reusingReceived << " verified" << Qt::endl;
+#ifndef BLACKSAMPLE_COUNT_MALLOC
+        out << "(malloc calls are only counted on Linux with glibc)" << Qt::endl;
+#endif
+        out << "-----------------------------------------------"  << Qt::endl;
+        return allocatingReceived == numberOfPackets && reusingReceived == numberOfPackets ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    int CSamplesPerformance::samplesAfvJitterBuffer(QTextStream &out, int numberOfTransmissions)
+    {
+        using BlackCore::Afv::Audio::CJitterBufferSampleProvider;
+
+        // transmissions of 3secs every 5secs, the sequence counter of the sender runs on in between
+        constexpr int SampleRate = 48000;
+        constexpr int FrameSamples = 960;
+        constexpr int FrameMs = 20;
+        constexpr int TransmissionFrames = 150;
+        constexpr int TransmissionIntervalMs = 5000;
+
+        // speech like: 300Hz tone in syllables of 200ms, quiet in between
+        BlackSound::Codecs::COpusEncoder encoder(SampleRate, 1);
+        QVector<QByteArray> frames;
+        QVector<qint16> pcm(FrameSamples);
+        for (int f = 0; f < TransmissionFrames; f++)
+        {
+            const bool syllable = (f / 10) % 3 != 2;
+            for (int i = 0; i < FrameSamples; i++)
+            {
+                const double t = static_cast<double>(f * FrameSamples + i) / SampleRate;
+                pcm[i] = syllable ? static_cast<qint16>(8000.0 * qSin(2.0 * M_PI * 300.0 * t) * qSin(M_PI * std::fmod(t, 0.2) / 0.2)) : 0;
+            }
+            int encodedLength = 0;
+            frames.push_back(encoder.encode(pcm, FrameSamples, &encodedLength));
+        }
+
+        // network delay: base + jitter, with spikes where the following packets bunch up
+        struct Network
+        {
+            QString name;
+            double baseMs;
+            double jitterMeanMs;  //!< exponentially distributed
+            double spikeRate;     //!< per packet
+            double spikeMs;
+            double lossRate;
+        };
+        const QVector<Network> networks
+        {
+            { QStringLiteral("LAN"), 5, 1, 0, 0, 0 },
+            { QStringLiteral("Internet"), 40, 8, 0.002, 120, 0.005 },
+            { QStringLiteral("Wi-Fi"), 40, 20, 0.01, 200, 0.02 }
+        };
+
+        struct Variant
+        {
+            QString name;
+            CJitterBufferSampleProvider::Setup setup;
+        };
+        QVector<Variant> variants;
+        for (int fixedMs : { 60, 120, 200 })
+        {
+            CJitterBufferSampleProvider::Setup fixed;
+            fixed.minDelayMs = fixed.maxDelayMs = fixed.initialDelayMs = fixedMs;
+            variants.push_back({ QStringLiteral("fixed %1ms").arg(fixedMs), fixed });
+        }
+        for (double lateRate : { 0.05, 0.01, 0.002 })
+        {
+            CJitterBufferSampleProvider::Setup adaptive;
+            adaptive.lateRate = lateRate;
+            variants.push_back({ QStringLiteral("adaptive %1%").arg(lateRate * 100), adaptive });
+        }
+
+        std::mt19937 generator(4711);
+        CJitterBufferSampleProvider jitterBuffer(SampleRate);
+        out << "AFV jitter buffer, " << numberOfTransmissions << " transmissions of " << TransmissionFrames * FrameMs << "ms per network" << Qt::endl;
+        for (const Network &network : networks)
+        {
+            std::exponential_distribution<double> jitter(1.0 / qMax(0.001, network.jitterMeanMs));
+            std::uniform_real_distribution<double> uniform(0.0, 1.0);
+            QVector<CJitterBufferSampleProvider::TracePacket> trace;
+            double spikeRemainingMs = 0;
+            for (int t = 0; t < numberOfTransmissions; t++)
+            {
+                const qint64 startMs = static_cast<qint64>(t) * TransmissionIntervalMs;
+                for (int f = 0; f < TransmissionFrames; f++)
+                {
+                    if (uniform(generator) < network.spikeRate) { spikeRemainingMs = network.spikeMs; }
+                    spikeRemainingMs = qMax(0.0, spikeRemainingMs - FrameMs);
+                    if (uniform(generator) < network.lossRate) { continue; }
+
+                    CJitterBufferSampleProvider::TracePacket packet;
+                    packet.sentMs = startMs + f * FrameMs;
+                    packet.arrivalMs = packet.sentMs + qRound64(network.baseMs + jitter(generator) + spikeRemainingMs);
+                    packet.sequence = static_cast<uint>(packet.sentMs / FrameMs);
+                    packet.lastPacket = f == TransmissionFrames - 1;
+                    packet.opusData = frames[f];
+                    trace.push_back(packet);
+                }
+            }
+
+            out << network.name << ": " << network.baseMs << "ms + " << network.jitterMeanMs << "ms jitter, "
+                << network.spikeMs << "ms spikes, " << network.lossRate * 100 << "% loss" << Qt::endl;
+            for (const Variant &variant : variants)
+            {
+                jitterBuffer.setSetup(variant.setup);
+                const CJitterBufferSampleProvider::Statistics statistics = jitterBuffer.replay(trace, 10);
+                out << "  " << variant.name.leftJustified(16) << " mouth to ear " << QString::number(statistics.averageMouthToEarMs(), 'f', 1) << "ms, "
+                    << "underruns/concealed " << QString::number(statistics.underrunRate() * 100, 'f', 2) << "%, "
+                    << "late " << statistics.late << ", dropped " << statistics.dropped << ", inserted " << statistics.inserted
+                    << ", target " << jitterBuffer.getTargetDelayMs() << "ms" << Qt::endl;
+            }
+        }
+        out << "-----------------------------------------------"  << Qt::endl;
+        return EXIT_SUCCESS;
+    }
+
+    int CSamplesPerformance::samplesAfvMicrophoneCapture(QTextStream &out, int numberOfFrames)
+    {
+        using BlackCore::Afv::Audio::CAudioInputBuffer;
+
+        // 16bit mono device data of speech like level changes, written in chunks of varying size as by the audio devices
+        constexpr int FrameSamples = 960;
+        constexpr int FrameBytes = 2 * FrameSamples;
+        constexpr float Gain = 1.5f;
+        QByteArray device(numberOfFrames * FrameBytes, 0);
+        qint16 *deviceSamples = reinterpret_cast<qint16 *>(device.data());
+        for (int i = 0; i < numberOfFrames * FrameSamples; i++)
+        {
+            const double level = 0.1 + 0.5 * qAbs(qSin(2.0 * M_PI * i / 48000.0));
+            deviceSamples[i] = static_cast<qint16>(32767 * level * qSin(2.0 * M_PI * 220.0 * i / 48000.0));
+        }
+        const QVector<int> chunkSizes { 882, 1920, 3840, 1001, 959, 7680, 480, 1 };
+
+        // as CAudioInputBuffer and CInput did it before: buffer shifted per frame, converted, gain and peak per sample
+        QByteArray buffer;
+        int previousFrames = 0;
+        int previousPeak = 0;
+        QElapsedTimer timer;
+        timer.start();
+        for (int pos = 0, chunk = 0; pos < device.size(); chunk++)
+        {
+            const int size = qMin(chunkSizes[chunk % chunkSizes.size()], device.size() - pos);
+            buffer.append(device.constData() + pos, size);
+            pos += size;
+            while (buffer.size() >= FrameBytes)
+            {
+                QVector<qint16> samples = BlackSound::convertBytesTo16BitPCM(buffer.left(FrameBytes));
+                buffer.remove(0, FrameBytes);
+                for (qint16 &sample : samples)
+                {
+                    const int value = qBound(-32768, qRound(sample * Gain), 32767);
+                    sample = static_cast<qint16>(value);
+                    previousPeak = qMax(previousPeak, qMin(qAbs(value), 32767));
+                }
+                previousFrames++;
+            }
+        }
+        const qint64 previousNs = timer.nsecsElapsed();
+
+        // frames passed by index, fused gain and peak
+        QAudioFormat format;
+        format.setSampleRate(48000);
+        format.setChannelCount(1);
+        format.setSampleSize(16);
+        format.setSampleType(QAudioFormat::SignedInt);
+        format.setByteOrder(QAudioFormat::LittleEndian);
+        format.setCodec("audio/pcm");
+        CAudioInputBuffer ring(nullptr);
+        ring.start(format);
+
+        int ringFrames = 0;
+        int ringPeak = 0;
+        qint64 maxWriteNs = 0;
+        qint64 ringNs = 0;
+        QElapsedTimer writeTimer;
+        for (int pos = 0, chunk = 0; pos < device.size(); chunk++)
+        {
+            const int size = qMin(chunkSizes[chunk % chunkSizes.size()], device.size() - pos);
+            writeTimer.start();
+            ring.write(device.constData() + pos, size);
+            const qint64 writeNs = writeTimer.nsecsElapsed();
+            maxWriteNs = qMax(maxWriteNs, writeNs);
+            ringNs += writeNs;
+            pos += size;
+
+            timer.start();
+            int frame = -1;
+            while (ring.takeFrame(frame, 0))
+            {
+                ringPeak = qMax(ringPeak, BlackSound::Dsp::applyGainWithPeak(ring.frameSamples(frame), Gain, FrameSamples));
+                ring.releaseFrame(frame);
+                ringFrames++;
+            }
+            ringNs += timer.nsecsElapsed();
+        }
+        ring.stop();
+
+        const auto nsPerFrame = [](qint64 ns, int frames) { return frames > 0 ? QString::number(static_cast<double>(ns) / frames, 'f', 0) : QStringLiteral("-"); };
+        out << "AFV microphone capture of " << numberOfFrames << " frames, 20ms each, without the Opus encoding, SIMD: " << boolToYesNo(BlackSound::Dsp::hasSimdSampleKernels()) << Qt::endl;
+        out << "Shifted byte buffer, gain per sample: " << nsPerFrame(previousNs, previousFrames) << "ns per frame, " << previousFrames << " frames, peak " << previousPeak << Qt::endl;
+        out << "Frame ring, fused gain and peak: " << nsPerFrame(ringNs, ringFrames) << "ns per frame, " << ringFrames << " frames, peak " << ringPeak
+            << ", longest device write " << (maxWriteNs / 1000) << "us, dropped frames " << ring.getDroppedFrames() << Qt::endl;
+        out << "-----------------------------------------------"  << Qt::endl;
+        return previousFrames == ringFrames && qAbs(previousPeak - ringPeak) <= 1 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    CAirportList CSamplesPerformance::createAirports(int numberOfAirports)
+    {
+        CAirportList airports;
+        for (int i = 0; i < numberOfAirports; i++)
+        {
+            // uniform on the sphere, so there are not too many airports at the poles
+            const double lat = qRadiansToDegrees(std::asin(2.0 * CMathUtils::randomDouble() - 1.0));
+            const double lng = CMathUtils::randomDouble(360.0) - 180.0;
+            airports.push_back(CAirport(CAirportIcaoCode(QStringLiteral("X%1").arg(i, 4, 36, QChar('0')).toUpper()), CCoordinateGeodetic(lat, lng)));
+        }
+        return airports;
+    }
+
     CAircraftSituationList CSamplesPerformance::createSituations(qint64 baseTimeEpoch, int numberOfCallsigns, int numberOfTimes)
     {
         CAircraftSituationList situations;
@@ -709,6 +1762,37 @@ namespace BlackSample
         return models;
     }
 
+    CAircraftModelList CSamplesPerformance::createMatchingModels(int numberOfModels)
+    {
+        static const QStringList combinedTypes({ "L2J", "L4J", "L2T", "L1P", "H1T" });
+        static const QStringList manufacturers({ "BOEING", "AIRBUS", "EMBRAER", "CESSNA", "BELL" });
+
+        CAircraftIcaoCodeList aircraftIcaos;
+        for (int i = 0; i < 400; ++i)
+        {
+            const int type = i % combinedTypes.size();
+            CAircraftIcaoCode icao(QStringLiteral("D%1").arg(i, 3, 10, QChar('0')), combinedTypes[type], manufacturers[type], "Model", "M", true, false, (i % 20) == 0, 0);
+            icao.setFamily(QStringLiteral("F%1").arg(i / 4, 3, 10, QChar('0')));
+            aircraftIcaos.push_back(icao);
+        }
+
+        CLiveryList liveries;
+        for (int i = 0; i < 300; ++i)
+        {
+            CAirlineIcaoCode airline(QStringLiteral("A%1").arg(i, 2, 10, QChar('0')), "Airline", CCountry("DE", "Germany"), "Telephony", false, true);
+            liveries.push_back(CLivery(CLivery::getStandardCode(airline), airline, "Standard"));
+        }
+
+        CAircraftModelList models;
+        for (int i = 0; i < numberOfModels; ++i)
+        {
+            const CAircraftIcaoCode &aircraftIcao = aircraftIcaos[CMathUtils::randomInteger(0, aircraftIcaos.size() - 1)];
+            const CLivery &livery = liveries[CMathUtils::randomInteger(0, liveries.size() - 1)];
+            models.push_back(CAircraftModel("MODEL" + QString::number(i), CAircraftModel::TypeUnknown, CSimulatorInfo::FSX, QString::number(i), QString::number(i), aircraftIcao, livery));
+        }
+        return models;
+    }
+
     void CSamplesPerformance::calculateDistance(int n)
     {
         if (n < 1) { return; }
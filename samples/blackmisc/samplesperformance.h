@@ -14,6 +14,7 @@
 
 #include "blackmisc/simulation/aircraftmodellist.h"
 #include "blackmisc/aviation/aircraftsituationlist.h"
+#include "blackmisc/aviation/airportlist.h"
 #include "blackmisc/aviation/callsignset.h"
 #include <QTextStream>
 #include <QtGlobal>
@@ -52,6 +53,42 @@ namespace BlackSample
         //! Callsign based hash/map comparison
         static int sampleQMapVsQHashByCallsign(QTextStream &out);
 
+        //! Offline rendering of the AFV like audio graph, N receivers with M callsigns each
+        static int samplesAudioMixing(QTextStream &out, int numberOfReceivers, int numberOfCallsigns);
+
+        //! Model matching, reduction stages on the plain model list vs. the model set index
+        static int samplesModelMatching(QTextStream &out, int numberOfModels, int numberOfAircraft);
+
+        //! Range and closest queries on an airport list, linear vs. the spatial index
+        static int samplesGeoSpatialIndex(QTextStream &out, int numberOfAirports, int numberOfQueries);
+
+        //! Interpolation cost per simulator frame, one interpolation per aircraft vs. the batch interpolation used by the drivers
+        static int samplesInterpolationPerFrame(QTextStream &out, int numberOfAircraft, int numberOfFrames);
+
+        //! Memory footprint and copies of the situation histories, CAircraftSituation vs. CCompactSituation
+        static int samplesCompactSituations(QTextStream &out, int numberOfAircraft, int numberOfCopies);
+
+        //! METAR decoding, regular expressions vs. single pass vs. parallel decoding of the file
+        static int samplesMetarDecoding(QTextStream &out, int numberOfCopies);
+
+        //! Cost of logging in the logging threads, Qt message handler vs. deferred formatting of CLogMessage
+        static int samplesLogging(QTextStream &out, int numberOfThreads, int numberOfMessages);
+
+        //! Replay of the latest interpolation trace from the log directory, or of a trace recorded from generated traffic
+        static int samplesInterpolationTrace(QTextStream &out, int numberOfAircraft, int numberOfFrames);
+
+        //! Bootstrap from the bundled shared DB files (liveries, models, ICAO codes), serial vs. parallel decoding with files read ahead
+        static int samplesDbJsonDecoding(QTextStream &out, int numberOfRuns);
+
+        //! AFV voice datagrams encoded, encrypted, sent over loopback UDP, decrypted and decoded again, allocating vs. reused buffers
+        static int samplesAfvVoiceDatagrams(QTextStream &out, int numberOfPackets);
+
+        //! AFV jitter buffer on synthetic network traces, fixed delays vs. the adaptive delay: late frames and mouth to ear delay
+        static int samplesAfvJitterBuffer(QTextStream &out, int numberOfTransmissions);
+
+        //! AFV microphone capture, shifted byte buffer with a gain per sample vs. the frame ring with fused gain and peak
+        static int samplesAfvMicrophoneCapture(QTextStream &out, int numberOfFrames);
+
     private:
         static const qint64 DeltaTime = 10;
 
@@ -61,6 +98,12 @@ namespace BlackSample
         //! Model values for testing
         static BlackMisc::Simulation::CAircraftModelList createModels(int numberOfModels, int numberOfMemoParts);
 
+        //! Model set with a spread of aircraft and airline ICAO codes like a real set
+        static BlackMisc::Simulation::CAircraftModelList createMatchingModels(int numberOfModels);
+
+        //! Airports at random positions
+        static BlackMisc::Aviation::CAirportList createAirports(int numberOfAirports);
+
         //! Calculate n times distance (greater circle distance)
         static void calculateDistance(int n);
 
@@ -17,56 +17,20 @@ namespace BlackCore
             void CallsignDelayCache::initialise(const QString &callsign)
             {
                 if (!m_delayCache.contains(callsign)) { m_delayCache[callsign] = delayDefault; }
-                if (!successfulTransmissionsCache.contains(callsign)) { successfulTransmissionsCache[callsign] = 0; }
             }
 
             int CallsignDelayCache::get(const QString &callsign)
             {
+                if (!m_delayCache.contains(callsign)) { return delayDefault; }
                 return m_delayCache[callsign];
             }
 
-            void CallsignDelayCache::underflow(const QString &callsign)
+            void CallsignDelayCache::set(const QString &callsign, int delayMs)
             {
-                if (!successfulTransmissionsCache.contains(callsign)) return;
-
-                successfulTransmissionsCache[callsign] = 0;
-                increaseDelayMs(callsign);
-            }
-
-            void CallsignDelayCache::success(const QString &callsign)
-            {
-                if (!successfulTransmissionsCache.contains(callsign)) return;
-
-                successfulTransmissionsCache[callsign]++;
-                if (successfulTransmissionsCache[callsign] > 5)
-                {
-                    decreaseDelayMs(callsign);
-                    successfulTransmissionsCache[callsign] = 0;
-                }
-            }
-
-            void CallsignDelayCache::increaseDelayMs(const QString &callsign)
-            {
-                if (!m_delayCache.contains(callsign))
-                    return;
-
-                m_delayCache[callsign] += delayIncrement;
-                if (m_delayCache[callsign] > delayMax)
-                {
-                    m_delayCache[callsign] = delayMax;
-                }
-            }
-
-            void CallsignDelayCache::decreaseDelayMs(const QString &callsign)
-            {
-                if (!m_delayCache.contains(callsign))
-                    return;
-
-                m_delayCache[callsign] -= delayIncrement;
-                if (m_delayCache[callsign] < delayMin)
-                {
-                    m_delayCache[callsign] = delayMin;
-                }
+                if (callsign.isEmpty()) { return; }
+                if (delayMs < delayMin) { delayMs = delayMin; }
+                if (delayMs > delayMax) { delayMs = delayMax; }
+                m_delayCache[callsign] = delayMs;
             }
 
             CallsignDelayCache &CallsignDelayCache::instance()
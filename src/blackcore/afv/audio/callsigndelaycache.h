@@ -21,26 +21,18 @@ namespace BlackCore
         namespace Audio
         {
             //! Callsign delay cache
+            //! \remark target delays learned by the jitter buffers, for the next transmissions of a callsign
             class CallsignDelayCache
             {
             public:
                 //! Initialize
                 void initialise(const QString &callsign);
 
-                //! Callsign index
+                //! Delay of a callsign
                 int get(const QString &callsign);
 
-                //! Underflow
-                void underflow(const QString &callsign);
-
-                //! Success
-                void success(const QString &callsign);
-
-                //! Delay plus/minus
-                //! @{
-                void increaseDelayMs(const QString &callsign);
-                void decreaseDelayMs(const QString &callsign);
-                //! @}
+                //! Set the delay learned for a callsign
+                void set(const QString &callsign, int delayMs);
 
                 //! Singleton
                 static CallsignDelayCache &instance();
@@ -50,12 +42,10 @@ namespace BlackCore
                 CallsignDelayCache() = default;
 
                 static constexpr int delayDefault = 60;
-                static constexpr int delayMin = 40;
-                static constexpr int delayIncrement = 20;
+                static constexpr int delayMin = 20;
                 static constexpr int delayMax = 300;
 
                 QHash<QString, int> m_delayCache;
-                QHash<QString, int> successfulTransmissionsCache;
             };
 
         } // ns
@@ -34,8 +34,7 @@ namespace BlackCore
             CCallsignSampleProvider::CCallsignSampleProvider(const QAudioFormat &audioFormat, const CReceiverSampleProvider *receiver, QObject *parent) :
                 ISampleProvider(parent),
                 m_audioFormat(audioFormat),
-                m_receiver(receiver),
-                m_decoder(audioFormat.sampleRate(), 1)
+                m_receiver(receiver)
             {
                 Q_ASSERT(audioFormat.channelCount() == 1);
                 Q_ASSERT(receiver);
@@ -54,10 +53,10 @@ namespace BlackCore
                 m_hfWhiteNoise->setLooping(true);
                 m_hfWhiteNoise->setGain(0.0);
                 m_acBusNoise = new CSawToothGenerator(400, m_mixer);
-                m_audioInput = new CBufferedWaveProvider(audioFormat, m_mixer);
+                m_jitterBuffer = new CJitterBufferSampleProvider(audioFormat.sampleRate(), m_mixer);
 
                 // Create the compressor
-                m_simpleCompressorEffect = new CSimpleCompressorEffect(m_audioInput, m_mixer);
+                m_simpleCompressorEffect = new CSimpleCompressorEffect(m_jitterBuffer, m_mixer);
                 m_simpleCompressorEffect->setMakeUpGain(-5.5);
 
                 // Create the voice EQ
@@ -77,27 +76,26 @@ namespace BlackCore
 
             int CCallsignSampleProvider::readSamples(QVector<float> &samples, qint64 count)
             {
-                const int noOfSamples = m_mixer->readSamples(samples, count);
+                samples.resize(static_cast<int>(count)); // mixed, all samples valid
+                return this->readSamplesInto(samples.data(), count);
+            }
+
+            int CCallsignSampleProvider::readSamplesInto(float *samples, qint64 count)
+            {
+                const int noOfSamples = m_mixer->readSamplesInto(samples, count);
 
-                if (m_inUse && m_lastPacketLatch && m_audioInput->getBufferedBytes() == 0)
+                if (m_inUse && m_lastPacketLatch && !m_jitterBuffer->isActive())
                 {
                     idle();
                     m_lastPacketLatch = false;
                 }
 
-                if (m_inUse && !m_underflow && m_audioInput->getBufferedBytes() == 0)
-                {
-                    if (verbose()) { CLogMessage(this).debug(u"[%1] [Delay++]") << m_callsign; }
-                    CallsignDelayCache::instance().underflow(m_callsign);
-                    m_underflow = true;
-                }
-
                 return noOfSamples;
             }
 
             void CCallsignSampleProvider::timerElapsed()
             {
-                if (m_inUse && m_audioInput->getBufferedBytes() == 0 && m_lastSamplesAddedUtc.msecsTo(QDateTime::currentDateTimeUtc()) > m_idleTimeoutMs)
+                if (m_inUse && !m_jitterBuffer->isActive() && m_lastSamplesAddedUtc.msecsTo(QDateTime::currentDateTimeUtc()) > m_idleTimeoutMs)
                 {
                     idle();
                 }
@@ -108,19 +106,9 @@ namespace BlackCore
                 m_callsign = callsign;
                 CallsignDelayCache::instance().initialise(callsign);
                 m_aircraftType = aircraftType;
-                m_decoder.resetState();
                 m_inUse = true;
                 setEffects();
-                m_underflow = false;
-
-                const int delayMs = CallsignDelayCache::instance().get(callsign);
-                if (verbose()) { CLogMessage(this).debug(u"[%1] [Delay %2ms]") << m_callsign << delayMs; }
-                if (delayMs > 0)
-                {
-                    const int phaseDelayLength = (m_audioFormat.sampleRate() / 1000) * delayMs;
-                    const QVector<float> phaseDelay(phaseDelayLength * 2, 0);
-                    m_audioInput->addSamples(phaseDelay);
-                }
+                this->initJitterBuffer();
             }
 
             void CCallsignSampleProvider::activeSilent(const QString &callsign, const QString &aircraftType)
@@ -128,16 +116,16 @@ namespace BlackCore
                 m_callsign = callsign;
                 CallsignDelayCache::instance().initialise(callsign);
                 m_aircraftType = aircraftType;
-                m_decoder.resetState();
                 m_inUse = true;
                 setEffects(true);
-                m_underflow = true;
+                this->initJitterBuffer();
             }
 
             void CCallsignSampleProvider::clear()
             {
                 idle();
-                m_audioInput->clearBuffer();
+                m_jitterBuffer->reset();
+                m_jitterBufferCallsign.clear();
             }
 
             void CCallsignSampleProvider::addOpusSamples(const IAudioDto &audioDto, float distanceRatio)
@@ -145,10 +133,9 @@ namespace BlackCore
                 m_distanceRatio = distanceRatio;
                 setEffects();
 
-                const QVector<qint16> audio = decodeOpus(audioDto.audio);
-                m_audioInput->addSamples(BlackSound::convertFromShortToFloat(audio));
+                // decoded when played by the jitter buffer
+                m_jitterBuffer->addPacket(audioDto.sequenceCounter, audioDto.audio, audioDto.lastPacket, QDateTime::currentMSecsSinceEpoch());
                 m_lastPacketLatch = audioDto.lastPacket;
-                if (audioDto.lastPacket && !m_underflow) { CallsignDelayCache::instance().success(m_callsign); }
                 m_lastSamplesAddedUtc = QDateTime::currentDateTimeUtc();
                 if (!m_timer->isActive()) { m_timer->start(); }
             }
@@ -165,8 +152,19 @@ namespace BlackCore
                 if (!m_timer->isActive()) { m_timer->start(); }
             }
 
+            void CCallsignSampleProvider::initJitterBuffer()
+            {
+                // the arrival history of the callsign is kept between its transmissions
+                if (m_jitterBufferCallsign == m_callsign) { return; }
+                const int delayMs = CallsignDelayCache::instance().get(m_callsign);
+                if (verbose()) { CLogMessage(this).debug(u"[%1] [Delay %2ms]") << m_callsign << delayMs; }
+                m_jitterBuffer->reset(delayMs);
+                m_jitterBufferCallsign = m_callsign;
+            }
+
             void CCallsignSampleProvider::idle()
             {
+                if (!m_callsign.isEmpty()) { CallsignDelayCache::instance().set(m_callsign, m_jitterBuffer->getTargetDelayMs()); }
                 m_timer->stop();
                 m_inUse = false;
                 setEffects();
@@ -174,13 +172,6 @@ namespace BlackCore
                 m_aircraftType.clear();
             }
 
-            QVector<qint16> CCallsignSampleProvider::decodeOpus(const QByteArray &opusData)
-            {
-                int decodedLength = 0;
-                const QVector<qint16> decoded = m_decoder.decode(opusData, opusData.size(), &decodedLength);
-                return decoded;
-            }
-
             void CCallsignSampleProvider::setEffects(bool noEffects)
             {
                 if (noEffects || m_bypassEffects || !m_inUse)
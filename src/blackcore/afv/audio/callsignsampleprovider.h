@@ -12,14 +12,13 @@
 #define BLACKCORE_AFV_AUDIO_CALLSIGNSAMPLEPROVIDER_H
 
 #include "blackcore/afv/dto.h"
+#include "blackcore/afv/audio/jitterbuffersampleprovider.h"
 #include "blacksound/sampleprovider/pinknoisegenerator.h"
-#include "blacksound/sampleprovider/bufferedwaveprovider.h"
 #include "blacksound/sampleprovider/mixingsampleprovider.h"
 #include "blacksound/sampleprovider/equalizersampleprovider.h"
 #include "blacksound/sampleprovider/sawtoothgenerator.h"
 #include "blacksound/sampleprovider/simplecompressoreffect.h"
 #include "blacksound/sampleprovider/resourcesoundsampleprovider.h"
-#include "blacksound/codecs/opusdecoder.h"
 
 #include <QAudioFormat>
 #include <QSoundEffect>
@@ -47,6 +46,9 @@ namespace BlackCore
                 //! Read samples
                 int readSamples(QVector<float> &samples, qint64 count) override;
 
+                //! \copydoc BlackSound::SampleProvider::ISampleProvider::readSamplesInto
+                int readSamplesInto(float *samples, qint64 count) override;
+
                 //! The callsign
                 const QString &callsign() const { return m_callsign; }
 
@@ -80,7 +82,7 @@ namespace BlackCore
             private:
                 void timerElapsed();
                 void idle();
-                QVector<qint16> decodeOpus(const QByteArray &opusData);
+                void initJitterBuffer();
                 void setEffects(bool noEffects = false);
 
                 QAudioFormat m_audioFormat;
@@ -105,13 +107,12 @@ namespace BlackCore
                 BlackSound::SampleProvider::CSawToothGenerator           *m_acBusNoise             = nullptr;
                 BlackSound::SampleProvider::CSimpleCompressorEffect      *m_simpleCompressorEffect = nullptr;
                 BlackSound::SampleProvider::CEqualizerSampleProvider     *m_voiceEqualizer         = nullptr;
-                BlackSound::SampleProvider::CBufferedWaveProvider        *m_audioInput             = nullptr;
+                CJitterBufferSampleProvider                              *m_jitterBuffer           = nullptr;
                 QTimer *m_timer = nullptr;
 
-                BlackSound::Codecs::COpusDecoder m_decoder;
+                QString m_jitterBufferCallsign; //!< callsign of the arrival history in the jitter buffer
                 bool m_lastPacketLatch = false;
                 QDateTime m_lastSamplesAddedUtc;
-                bool m_underflow = false;
             };
         } // ns
     } // ns
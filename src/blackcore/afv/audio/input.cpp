@@ -10,6 +10,7 @@
 
 #include "input.h"
 #include "blacksound/audioutilities.h"
+#include "blacksound/dsp/samplekernels.h"
 #include "blackmisc/logmessage.h"
 #include "blackmisc/verify.h"
 
@@ -18,6 +19,7 @@
 #include <QDebug>
 #include <QAudioDeviceInfo>
 #include <cmath>
+#include <cstring>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Audio;
@@ -29,16 +31,32 @@ namespace BlackCore
     {
         namespace Audio
         {
+            constexpr int CAudioInputBuffer::FrameSamples;
+            constexpr int CAudioInputBuffer::FrameCount;
+            constexpr int CInput::MaxOpusBytes;
+
             CAudioInputBuffer::CAudioInputBuffer(QObject *parent) :
-                QIODevice(parent)
+                QIODevice(parent),
+                m_samples(static_cast<size_t>(FrameCount * FrameSamples)),
+                m_fullFrames(FrameCount), m_freeFrames(FrameCount)
             {
                 this->setObjectName("CAudioInputBuffer");
+                for (int frame = 0; frame < FrameCount; frame++) { m_freeFrames.tryPush(frame); }
             }
 
             void CAudioInputBuffer::start(const QAudioFormat &format)
             {
+                // the encoder thread is not running, frames still in the buffer are discarded
+                int frame = -1;
+                while (m_fullFrameCount.tryAcquire() && m_fullFrames.tryPop(frame)) { m_freeFrames.tryPush(frame); }
+                if (m_writeFrame >= 0) { m_freeFrames.tryPush(m_writeFrame); }
+                m_writeFrame = -1;
+                m_writtenSamples = 0;
+                m_droppedSamples = 0;
+                m_partialBytes = 0;
+
                 m_format = format;
-                m_buffer.clear();
+                m_channels = qBound(1, format.channelCount(), 2);
                 if (!this->isOpen())
                 {
                     open(QIODevice::WriteOnly | QIODevice::Unbuffered);
@@ -59,21 +77,79 @@ namespace BlackCore
 
             qint64 CAudioInputBuffer::writeData(const char *data, qint64 len)
             {
-                m_buffer.append(data, static_cast<int>(len));
-                const int byteCount = 1920 * m_format.channelCount();
-                while (m_buffer.size() > byteCount)
+                const int bytesPerSample = 2 * m_channels;
+                const char *end = data + len;
+
+                // sample split across the last and this write
+                if (m_partialBytes > 0)
                 {
-                    // qDebug() << QDateTime::currentMSecsSinceEpoch() << "CAudioInputBuffer::writeData " << m_buffer.size();
-                    emit frameAvailable(m_buffer.left(byteCount));
-                    m_buffer.remove(0, byteCount);
+                    while (m_partialBytes < bytesPerSample && data < end) { m_partialSample[m_partialBytes++] = *data++; }
+                    if (m_partialBytes < bytesPerSample) { return len; }
+                    this->appendSamples(m_partialSample, 1);
+                    m_partialBytes = 0;
                 }
+
+                const int samples = static_cast<int>((end - data) / bytesPerSample);
+                this->appendSamples(data, samples);
+                data += samples * bytesPerSample;
+                while (data < end) { m_partialSample[m_partialBytes++] = *data++; }
                 return len;
             }
 
+            void CAudioInputBuffer::appendSamples(const char *data, int count)
+            {
+                while (count > 0)
+                {
+                    if (m_writeFrame < 0 && !m_freeFrames.tryPop(m_writeFrame))
+                    {
+                        // encoder thread does not keep up, the device must not wait
+                        m_droppedSamples += count;
+                        m_droppedFrames += m_droppedSamples / FrameSamples;
+                        m_droppedSamples %= FrameSamples;
+                        return;
+                    }
+
+                    const int copied = qMin(count, FrameSamples - m_writtenSamples);
+                    qint16 *frame = this->frameSamples(m_writeFrame) + m_writtenSamples;
+                    if (m_channels == 1)
+                    {
+                        std::memcpy(frame, data, static_cast<size_t>(copied) * sizeof(qint16));
+                    }
+                    else
+                    {
+                        // left channel, as convertFromStereoToMono
+                        for (int i = 0; i < copied; i++) { std::memcpy(frame + i, data + i * 4, sizeof(qint16)); }
+                    }
+                    data += copied * 2 * m_channels;
+                    count -= copied;
+                    m_writtenSamples += copied;
+
+                    if (m_writtenSamples == FrameSamples)
+                    {
+                        m_fullFrames.tryPush(m_writeFrame); // cannot be full, there are only FrameCount frames
+                        m_fullFrameCount.release();
+                        m_writeFrame = -1;
+                        m_writtenSamples = 0;
+                    }
+                }
+            }
+
+            bool CAudioInputBuffer::takeFrame(int &o_frame, int timeoutMs)
+            {
+                if (!m_fullFrameCount.tryAcquire(1, timeoutMs)) { return false; }
+                return m_fullFrames.tryPop(o_frame);
+            }
+
+            void CAudioInputBuffer::releaseFrame(int frame)
+            {
+                m_freeFrames.tryPush(frame);
+            }
+
             CInput::CInput(int sampleRate, QObject *parent) :
                 QObject(parent),
                 m_sampleRate(sampleRate),
-                m_encoder(sampleRate, 1, OPUS_APPLICATION_VOIP)
+                m_encoder(sampleRate, 1, OPUS_APPLICATION_VOIP),
+                m_opusBuffer(MaxOpusBytes, 0)
             {
                 this->setObjectName("CInput");
                 m_encoder.setBitRate(16 * 1024);
@@ -121,16 +197,13 @@ namespace BlackCore
                 m_inputFormat = inputFormat;
                 m_audioInput.reset(new QAudioInput(selectedDevice, m_inputFormat));
                 if (!m_audioInputBuffer) { m_audioInputBuffer = new CAudioInputBuffer(this); }
-                else { m_audioInputBuffer->disconnect(); } // make sure disconnected in any case
                 m_audioInputBuffer->start(m_inputFormat);
 
 #ifdef Q_OS_MAC
                 CMacOSMicrophoneAccess::AuthorizationStatus status = m_micAccess.getAuthorizationStatus();
                 if (status == CMacOSMicrophoneAccess::Authorized)
                 {
-                    m_audioInput->start(m_audioInputBuffer);
-                    connect(m_audioInputBuffer, &CAudioInputBuffer::frameAvailable, this, &CInput::audioInDataAvailable);
-                    m_started = true;
+                    this->startInput();
                     return;
                 }
                 else if (status == CMacOSMicrophoneAccess::NotDetermined)
@@ -145,9 +218,7 @@ namespace BlackCore
                     return;
                 }
 #else
-                m_audioInput->start(m_audioInputBuffer);
-                connect(m_audioInputBuffer, &CAudioInputBuffer::frameAvailable, this, &CInput::audioInDataAvailable);
-                m_started = true;
+                this->startInput();
 #endif
                 const QString format = toQString(m_inputFormat);
                 CLogMessage(this).info(u"Starting: '%1' with: %2") << selectedDevice.deviceName() << format;
@@ -159,6 +230,12 @@ namespace BlackCore
                 m_started = false;
                 if (m_audioInput) { m_audioInput->stop(); }
                 m_audioInput.reset();
+                if (m_encoderThread)
+                {
+                    m_stopEncoding = true;
+                    m_encoderThread->wait();
+                    m_encoderThread.reset();
+                }
                 if (m_audioInputBuffer)
                 {
                     m_audioInputBuffer->stop();
@@ -167,32 +244,41 @@ namespace BlackCore
                 }
             }
 
-            void CInput::audioInDataAvailable(const QByteArray &frame)
+            void CInput::startInput()
             {
-                QVector<qint16> samples = convertBytesTo16BitPCM(frame);
+                m_stopEncoding = false;
+                CAudioInputBuffer *buffer = m_audioInputBuffer;
+                m_encoderThread.reset(QThread::create([this, buffer] { this->encodeFrames(buffer); }));
+                m_encoderThread->setObjectName("CInput encoder");
+                m_encoderThread->start(QThread::HighestPriority);
+                m_audioInput->start(m_audioInputBuffer);
+                m_started = true;
+            }
 
-                if (m_inputFormat.channelCount() == 2)
+            void CInput::encodeFrames(CAudioInputBuffer *buffer)
+            {
+                // the timeout only limits the time until a stop is noticed
+                constexpr int StopCheckMs = 100;
+                while (!m_stopEncoding)
                 {
-                    samples = convertFromStereoToMono(samples);
+                    int frame = -1;
+                    if (!buffer->takeFrame(frame, StopCheckMs)) { continue; }
+                    this->encodeFrame(buffer->frameSamples(frame));
+                    buffer->releaseFrame(frame);
                 }
+            }
 
-                const double volume = m_gainRatio;
-                for (qint16 &sample : samples)
-                {
-                    int value = qRound(sample * volume);
-                    if (value > std::numeric_limits<qint16>::max()) value = std::numeric_limits<qint16>::max();
-                    if (value < std::numeric_limits<qint16>::min()) value = std::numeric_limits<qint16>::min();
-                    sample = static_cast<qint16>(value);
-
-                    qint16 sampleInput = qAbs(sample);
-                    m_maxSampleInput   = qMax(qAbs(sampleInput), m_maxSampleInput);
-                }
+            void CInput::encodeFrame(qint16 *samples)
+            {
+                constexpr int FrameSamples = CAudioInputBuffer::FrameSamples;
+                const int peak = Dsp::applyGainWithPeak(samples, static_cast<float>(m_gainRatio.load()), FrameSamples);
+                m_maxSampleInput = qMax(peak, m_maxSampleInput);
 
-                int length;
-                const QByteArray encodedBuffer = m_encoder.encode(samples, samples.size(), &length);
+                const int length = m_encoder.encodeInto(samples, FrameSamples, m_opusBuffer.data(), MaxOpusBytes);
+                if (length < 0) { return; }
                 m_opusBytesEncoded += length;
 
-                m_sampleCount += samples.size();
+                m_sampleCount += FrameSamples;
                 if (m_sampleCount >= SampleCountPerEvent)
                 {
                     InputVolumeStreamArgs inputVolumeStreamArgs;
@@ -209,16 +295,14 @@ namespace BlackCore
                     m_maxSampleInput = 0;
                 }
 
-                OpusDataAvailableArgs opusDataAvailableArgs = { m_audioSequenceCounter++, encodedBuffer };
+                const OpusDataAvailableArgs opusDataAvailableArgs = { m_audioSequenceCounter++, QByteArray(m_opusBuffer.constData(), length) };
                 emit opusDataAvailable(opusDataAvailableArgs);
             }
 
 #ifdef Q_OS_MAC
             void CInput::delayedInitMicrophone()
             {
-                m_audioInput->start(m_audioInputBuffer);
-                connect(m_audioInputBuffer, &CAudioInputBuffer::frameAvailable, this, &CInput::audioInDataAvailable);
-                m_started = true;
+                this->startInput();
             }
 #endif
 
@@ -11,9 +11,10 @@
 #ifndef BLACKCORE_AFV_AUDIO_AUDIO_INPUT_H
 #define BLACKCORE_AFV_AUDIO_AUDIO_INPUT_H
 
-#include "blacksound/sampleprovider/bufferedwaveprovider.h"
+#include "blackcore/blackcoreexport.h"
 #include "blacksound/codecs/opusencoder.h"
 #include "blackmisc/audio/audiodeviceinfo.h"
+#include "blackmisc/spscringbuffer.h"
 
 #ifdef Q_OS_MAC
 #include "blackmisc/macos/microphoneaccess.h"
@@ -22,7 +23,12 @@
 #include <QAudioInput>
 #include <QString>
 #include <QDateTime>
+#include <QSemaphore>
 #include <QSharedPointer>
+#include <QThread>
+#include <atomic>
+#include <memory>
+#include <vector>
 
 namespace BlackCore
 {
@@ -30,12 +36,21 @@ namespace BlackCore
     {
         namespace Audio
         {
-            //! Input buffer
-            class CAudioInputBuffer : public QIODevice
+            //! Input buffer, the audio device writes to it, the encoder thread takes the 20ms frames
+            //! \remark lock-free, the frames are passed by index through two single producer single consumer rings:
+            //!         full frames to the encoder thread, encoded frames back to the device. Only the device data is
+            //!         copied, into the frame, nothing is allocated after the construction.
+            class BLACKCORE_EXPORT CAudioInputBuffer : public QIODevice
             {
                 Q_OBJECT
 
             public:
+                //! Samples of a frame, 20ms mono
+                static constexpr int FrameSamples = 960;
+
+                //! Frames of the buffer, 320ms
+                static constexpr int FrameCount = 16;
+
                 //! Inout buffer
                 CAudioInputBuffer(QObject *parent);
 
@@ -49,16 +64,38 @@ namespace BlackCore
                 virtual qint64 readData(char *data, qint64 maxlen) override;
 
                 //! \copydoc QIODevice::writeData
+                //! \remark device thread, the samples are dropped if the encoder does not keep up
                 virtual qint64 writeData(const char *data, qint64 len) override;
 
-            signals:
-                //! Frame is available
-                void frameAvailable(const QByteArray &frame);
+                //! Wait for the oldest full frame, false on timeout
+                //! \remark encoder thread only, the frame has to be given back by releaseFrame
+                bool takeFrame(int &o_frame, int timeoutMs);
+
+                //! FrameSamples mono samples of a taken frame
+                qint16 *frameSamples(int frame) { return m_samples.data() + frame * FrameSamples; }
+
+                //! Give back a taken frame
+                void releaseFrame(int frame);
+
+                //! Frames dropped because the encoder did not keep up
+                int getDroppedFrames() const { return m_droppedFrames; }
 
             private:
-                static constexpr qint64 frameSize = 960;
-                QByteArray   m_buffer;
+                //! Append mono or stereo samples of the device
+                void appendSamples(const char *data, int count);
+
                 QAudioFormat m_format;
+                int m_channels = 1;
+                std::vector<qint16> m_samples;                   //!< FrameCount frames
+                BlackMisc::CSpscRingBuffer<int> m_fullFrames;    //!< device to encoder thread
+                BlackMisc::CSpscRingBuffer<int> m_freeFrames;    //!< encoder thread to device
+                QSemaphore m_fullFrameCount;                     //!< wakes the encoder thread
+                int m_writeFrame = -1;                           //!< frame being written, -1 if none
+                int m_writtenSamples = 0;                        //!< samples in m_writeFrame
+                int m_droppedSamples = 0;                        //!< dropped, less than a frame
+                std::atomic_int m_droppedFrames { 0 };
+                char m_partialSample[4] {};                      //!< bytes of a sample split across writes
+                int m_partialBytes = 0;
             };
 
             //! Opus data arguments
@@ -82,6 +119,7 @@ namespace BlackCore
             };
 
             //! Input
+            //! \remark the frames are amplified and encoded in a thread of their own, the signals are emitted by this thread
             class CInput : public QObject
             {
                 Q_OBJECT
@@ -141,9 +179,18 @@ namespace BlackCore
                 void opusDataAvailable(const OpusDataAvailableArgs &args);
 
             private:
-                void audioInDataAvailable(const QByteArray &frame);
+                //! Start the audio input and the encoder thread
+                void startInput();
+
+                //! Loop of the encoder thread, encoding the frames of the buffer until stopped
+                void encodeFrames(CAudioInputBuffer *buffer);
+
+                //! Amplify and encode a frame
+                void encodeFrame(qint16 *samples);
+
+                //! Buffer for the encoded frame, more than an Opus packet can have
+                static constexpr int MaxOpusBytes = 4000;
 
-                static constexpr qint64 c_frameSize = 960;
                 int m_sampleRate = 0;
 
                 BlackSound::Codecs::COpusEncoder   m_encoder;
@@ -152,10 +199,14 @@ namespace BlackCore
                 QAudioFormat                       m_inputFormat;
 
                 bool m_started = false;
-                int m_opusBytesEncoded  = 0;
-                int m_sampleCount       = 0;
-                double m_gainRatio         = 1.0;
-                qint16 m_maxSampleInput = 0.0;
+                std::atomic_int m_opusBytesEncoded { 0 };
+                std::atomic<double> m_gainRatio { 1.0 };
+                int m_sampleCount    = 0; //!< encoder thread
+                int m_maxSampleInput = 0; //!< encoder thread
+                QByteArray m_opusBuffer;  //!< encoder thread
+
+                std::unique_ptr<QThread> m_encoderThread;
+                std::atomic_bool m_stopEncoding { false };
 
                 const int SampleCountPerEvent = 4800;
                 const double maxDb =   0;
@@ -173,4 +224,7 @@ namespace BlackCore
     } // ns
 } // ns
 
+Q_DECLARE_METATYPE(BlackCore::Afv::Audio::OpusDataAvailableArgs)
+Q_DECLARE_METATYPE(BlackCore::Afv::Audio::InputVolumeStreamArgs)
+
 #endif // guard
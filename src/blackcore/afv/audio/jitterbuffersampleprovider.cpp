@@ -0,0 +1,369 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "jitterbuffersampleprovider.h"
+#include "blacksound/dsp/samplekernels.h"
+
+#include <QDateTime>
+#include <QStringBuilder>
+#include <QtMath>
+#include <algorithm>
+#include <numeric>
+
+using namespace BlackSound;
+
+namespace BlackCore
+{
+    namespace Afv
+    {
+        namespace Audio
+        {
+            double CJitterBufferSampleProvider::Statistics::underrunRate() const
+            {
+                const int frames = played + concealed + underruns;
+                return frames > 0 ? static_cast<double>(concealed + underruns) / frames : 0.0;
+            }
+
+            QString CJitterBufferSampleProvider::Statistics::toQString() const
+            {
+                return QStringLiteral("packets: %1 played: %2 late: %3 concealed: %4 underruns: %5 dropped: %6 inserted: %7 transmissions: %8").
+                       arg(packets).arg(played).arg(late).arg(concealed).arg(underruns).arg(dropped).arg(inserted).arg(transmissions) %
+                       QStringLiteral(" mouth to ear: %1ms").arg(this->averageMouthToEarMs(), 0, 'f', 1);
+            }
+
+            CJitterBufferSampleProvider::CJitterBufferSampleProvider(int sampleRate, QObject *parent) :
+                ISampleProvider(parent),
+                m_sampleRate(sampleRate),
+                m_frameSamples(sampleRate / (1000 / FrameMs)),
+                m_decoder(sampleRate, 1),
+                m_slots(SlotCount),
+                m_pcm(6 * m_frameSamples, 0) // Opus packets are up to 120ms
+            {
+                this->setObjectName(QStringLiteral("CJitterBufferSampleProvider"));
+                m_frame.reserve(m_pcm.size());
+                this->setSetup(Setup());
+            }
+
+            void CJitterBufferSampleProvider::setSetup(const Setup &setup)
+            {
+                m_setup = setup;
+                m_setup.historySize = qMax(1, setup.historySize);
+                m_transits.fill(0, m_setup.historySize);
+                m_scratch.reserve(m_setup.historySize);
+                this->reset();
+            }
+
+            void CJitterBufferSampleProvider::addPacket(uint sequence, const QByteArray &opusData, bool lastPacket, qint64 arrivalMs)
+            {
+                this->addPacket(sequence, opusData, lastPacket, arrivalMs, -1);
+            }
+
+            void CJitterBufferSampleProvider::addPacket(uint sequence, const QByteArray &opusData, bool lastPacket, qint64 arrivalMs, qint64 sentMs)
+            {
+                m_statistics.packets++;
+
+                // late packets count as well, they are the reason to increase the delay
+                this->updateTargetDelay(sequence, arrivalMs);
+
+                if (m_state == Idle && m_sequenceKnown && isBefore(sequence, m_nextSequence) && m_nextSequence - sequence < SlotCount)
+                {
+                    // straggler of the last transmission
+                    m_statistics.late++;
+                    return;
+                }
+
+                if (m_state == Idle)
+                {
+                    // new transmission, the silence is calculated when the playout starts
+                    m_state = Buffering;
+                    m_nextSequence = sequence;
+                    m_silenceSamples = -1;
+                    m_endOfTransmission = false;
+                    m_underrunFrames = 0;
+                    m_lastPeak = 0;
+                    m_sequenceKnown = true;
+                    m_statistics.transmissions++;
+                }
+                else if (isBefore(sequence, m_nextSequence))
+                {
+                    m_statistics.late++;
+                    return;
+                }
+
+                // frames beyond the max. delay, the oldest are dropped
+                const int maxAhead = qMax(1, m_setup.maxDelayMs / FrameMs);
+                const int ahead = static_cast<int>(sequence - m_nextSequence);
+                if (ahead >= maxAhead)
+                {
+                    const uint newNextSequence = sequence - static_cast<uint>(maxAhead - 1);
+                    for (uint s = m_nextSequence; ahead < SlotCount + maxAhead && isBefore(s, newNextSequence); s++)
+                    {
+                        if (Slot *dropped = this->slot(s)) { this->release(*dropped); m_statistics.dropped++; }
+                    }
+                    if (ahead >= SlotCount + maxAhead)
+                    {
+                        m_statistics.dropped += m_buffered;
+                        for (Slot &s : m_slots) { if (s.used) { this->release(s); } }
+                    }
+                    m_nextSequence = newNextSequence;
+                }
+
+                Slot &s = m_slots[static_cast<int>(sequence % SlotCount)];
+                if (s.used)
+                {
+                    if (s.sequence == sequence) { return; } // duplicate
+                    this->release(s);
+                }
+                s.sequence = sequence;
+                s.used = true;
+                s.lastPacket = lastPacket;
+                s.sentMs = sentMs;
+                s.opusData = opusData;
+                m_buffered++;
+            }
+
+            int CJitterBufferSampleProvider::readSamples(QVector<float> &samples, qint64 count)
+            {
+                return this->readSamplesIntoVector(samples, count);
+            }
+
+            int CJitterBufferSampleProvider::readSamplesInto(float *samples, qint64 count)
+            {
+                const int c = static_cast<int>(count);
+                const qint64 readMs = this->nowMs();
+                int written = 0;
+                while (written < c)
+                {
+                    if (m_framePos < m_frame.size())
+                    {
+                        const int n = qMin(c - written, m_frame.size() - m_framePos);
+                        std::copy(m_frame.constBegin() + m_framePos, m_frame.constBegin() + m_framePos + n, samples + written);
+                        m_framePos += n;
+                        written += n;
+                        continue;
+                    }
+
+                    if (m_state == Idle) { break; }
+                    const qint64 frameMs = readMs + static_cast<qint64>(written) * 1000 / m_sampleRate;
+                    if (m_state == Buffering)
+                    {
+                        if (m_silenceSamples < 0)
+                        {
+                            const qint64 silenceMs = qMax<qint64>(0, m_targetDelayMs - this->playoutDelayMs(m_nextSequence, frameMs));
+                            m_silenceSamples = silenceMs * m_sampleRate / 1000;
+                        }
+                        if (m_silenceSamples > 0)
+                        {
+                            const int n = static_cast<int>(qMin<qint64>(c - written, m_silenceSamples));
+                            Dsp::clearSamples(samples + written, n);
+                            m_silenceSamples -= n;
+                            written += n;
+                            continue;
+                        }
+                        m_state = Playing;
+                    }
+
+                    if (!this->nextFrame(frameMs))
+                    {
+                        this->stop();
+                        break;
+                    }
+                }
+                return written;
+            }
+
+            void CJitterBufferSampleProvider::reset(int initialDelayMs)
+            {
+                this->stop();
+                m_framePos = m_frame.size();
+                m_sequenceKnown = false;
+                m_transitsWritten = 0;
+                m_minTransitMs = 0;
+                m_lastTransitMs = 0;
+                m_targetDelayMs = qBound(m_setup.minDelayMs, initialDelayMs < 0 ? m_setup.initialDelayMs : initialDelayMs, m_setup.maxDelayMs);
+            }
+
+            CJitterBufferSampleProvider::Statistics CJitterBufferSampleProvider::replay(const QVector<TracePacket> &trace, int readMs)
+            {
+                this->reset();
+                this->resetStatistics();
+                if (trace.isEmpty() || readMs < 1) { return m_statistics; }
+
+                QVector<int> order(trace.size());
+                std::iota(order.begin(), order.end(), 0);
+                std::stable_sort(order.begin(), order.end(), [&trace](int a, int b) { return trace[a].arrivalMs < trace[b].arrivalMs; });
+
+                const int readSamples = readMs * m_sampleRate / 1000;
+                QVector<float> buffer(readSamples);
+                int next = 0;
+                for (qint64 clockMs = trace[order.front()].arrivalMs; next < order.size() || this->isActive(); clockMs += readMs)
+                {
+                    m_replayClockMs = clockMs;
+                    for (; next < order.size() && trace[order[next]].arrivalMs <= clockMs; next++)
+                    {
+                        const TracePacket &packet = trace[order[next]];
+                        this->addPacket(packet.sequence, packet.opusData, packet.lastPacket, packet.arrivalMs, packet.sentMs);
+                    }
+                    this->readSamplesInto(buffer.data(), readSamples);
+                }
+                m_replayClockMs = -1;
+                return m_statistics;
+            }
+
+            void CJitterBufferSampleProvider::updateTargetDelay(uint sequence, qint64 arrivalMs)
+            {
+                // transit time up to the unknown clock offset of sender and receiver
+                const qint64 transitMs = arrivalMs - static_cast<qint64>(sequence) * FrameMs;
+                if (m_transitsWritten > 0 && qAbs(transitMs - m_lastTransitMs) > 2000)
+                {
+                    // new sequence of the sender, the old history does not fit
+                    m_transitsWritten = 0;
+                }
+                m_lastTransitMs = transitMs;
+                m_transits[m_transitsWritten % m_setup.historySize] = transitMs;
+                m_transitsWritten++;
+
+                const int n = qMin(m_transitsWritten, m_setup.historySize);
+                m_minTransitMs = *std::min_element(m_transits.constBegin(), m_transits.constBegin() + n);
+
+                // too few packets to estimate the distribution
+                if (n < 10) { return; }
+
+                // delay which all but the accepted late rate of the packets arrive within
+                m_scratch.resize(n);
+                for (int i = 0; i < n; i++) { m_scratch[i] = m_transits[i] - m_minTransitMs; }
+                const int k = qBound(0, qCeil((1.0 - m_setup.lateRate) * n) - 1, n - 1);
+                std::nth_element(m_scratch.begin(), m_scratch.begin() + k, m_scratch.end());
+                m_targetDelayMs = qBound(m_setup.minDelayMs, static_cast<int>(m_scratch[k]) + m_setup.marginMs, m_setup.maxDelayMs);
+            }
+
+            bool CJitterBufferSampleProvider::nextFrame(qint64 nowMs)
+            {
+                if (m_endOfTransmission) { return false; }
+
+                Slot *current = this->slot(m_nextSequence);
+                if (current)
+                {
+                    m_underrunFrames = 0;
+
+                    // the delay follows the target in quiet parts of the transmission
+                    const bool quiet = m_lastPeak < QuietPeak;
+                    const qint64 delayMs = this->playoutDelayMs(m_nextSequence, nowMs);
+                    if (quiet && delayMs < m_targetDelayMs - FrameMs)
+                    {
+                        this->silentFrame();
+                        m_statistics.inserted++;
+                        return true;
+                    }
+                    if (quiet && delayMs > m_targetDelayMs + FrameMs && !current->lastPacket && this->slot(m_nextSequence + 1))
+                    {
+                        // still decoded, so the decoder state follows the stream
+                        this->decodeFrame(current->opusData);
+                        this->release(*current);
+                        m_nextSequence++;
+                        m_statistics.dropped++;
+                        current = this->slot(m_nextSequence);
+                    }
+
+                    if (!this->decodeFrame(current->opusData)) { this->silentFrame(); }
+                    if (current->sentMs >= 0) { m_statistics.mouthToEarSumMs += nowMs - current->sentMs; }
+                    m_statistics.played++;
+                    m_endOfTransmission = current->lastPacket;
+                    this->release(*current);
+                    m_nextSequence++;
+                    return true;
+                }
+
+                if (m_buffered > 0)
+                {
+                    // lost or overtaken, the next packet carries the FEC data if any
+                    const Slot *next = this->slot(m_nextSequence + 1);
+                    this->concealFrame(next ? next->opusData : QByteArray());
+                    m_statistics.concealed++;
+                    m_nextSequence++;
+                    return true;
+                }
+
+                // empty buffer, end of a transmission without last packet or a delay spike
+                if (m_underrunFrames >= MaxUnderrunFrames) { return false; }
+                m_underrunFrames++;
+                m_statistics.underruns++;
+                this->concealFrame(QByteArray()); // the delay grows by a frame
+                return true;
+            }
+
+            bool CJitterBufferSampleProvider::decodeFrame(const QByteArray &opusData)
+            {
+                const int decoded = m_decoder.decodeInto(opusData, m_pcm.data(), m_pcm.size());
+                if (decoded <= 0) { return false; }
+                this->toFrame(decoded);
+                return true;
+            }
+
+            void CJitterBufferSampleProvider::concealFrame(const QByteArray &nextOpusData)
+            {
+                const int decoded = m_decoder.decodeLost(nextOpusData, m_pcm.data(), m_frameSamples);
+                if (decoded <= 0) { this->silentFrame(); return; }
+                this->toFrame(decoded);
+            }
+
+            void CJitterBufferSampleProvider::toFrame(int samples)
+            {
+                m_frame.resize(samples);
+                const qint16 *pcm = m_pcm.constData();
+                float *frame = m_frame.data();
+                for (int i = 0; i < samples; i++) { frame[i] = pcm[i] / 32768.0f; }
+                m_framePos = 0;
+                m_lastPeak = Dsp::peakSample(frame, samples);
+            }
+
+            void CJitterBufferSampleProvider::silentFrame()
+            {
+                m_frame.resize(m_frameSamples);
+                Dsp::clearSamples(m_frame.data(), m_frameSamples);
+                m_framePos = 0;
+                m_lastPeak = 0;
+            }
+
+            qint64 CJitterBufferSampleProvider::playoutDelayMs(uint sequence, qint64 nowMs) const
+            {
+                return nowMs - static_cast<qint64>(sequence) * FrameMs - m_minTransitMs;
+            }
+
+            void CJitterBufferSampleProvider::stop()
+            {
+                m_state = Idle;
+                for (Slot &s : m_slots) { if (s.used) { this->release(s); } }
+                m_buffered = 0;
+                m_endOfTransmission = false;
+                m_underrunFrames = 0;
+                m_silenceSamples = 0;
+                m_lastPeak = 0;
+                m_decoder.resetState();
+            }
+
+            CJitterBufferSampleProvider::Slot *CJitterBufferSampleProvider::slot(uint sequence)
+            {
+                Slot &s = m_slots[static_cast<int>(sequence % SlotCount)];
+                return s.used && s.sequence == sequence ? &s : nullptr;
+            }
+
+            void CJitterBufferSampleProvider::release(Slot &slot)
+            {
+                slot.used = false;
+                slot.opusData = QByteArray();
+                m_buffered--;
+            }
+
+            qint64 CJitterBufferSampleProvider::nowMs() const
+            {
+                return m_replayClockMs >= 0 ? m_replayClockMs : QDateTime::currentMSecsSinceEpoch();
+            }
+        } // ns
+    } // ns
+} // ns
@@ -0,0 +1,227 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKCORE_AFV_AUDIO_JITTERBUFFERSAMPLEPROVIDER_H
+#define BLACKCORE_AFV_AUDIO_JITTERBUFFERSAMPLEPROVIDER_H
+
+#include "blackcore/blackcoreexport.h"
+#include "blacksound/sampleprovider/sampleprovider.h"
+#include "blacksound/codecs/opusdecoder.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+namespace BlackCore
+{
+    namespace Afv
+    {
+        namespace Audio
+        {
+            //! Adaptive jitter buffer of the Opus frames of one voice stream, the frames are decoded when played
+            //! \remark The target delay is the delay which all but the accepted late rate of the recent packets
+            //!         arrive within, relative to the fastest recent packet. A transmission starts with this delay,
+            //!         later the delay follows the target by dropping or repeating quiet frames.
+            //! \remark Lost frames are concealed by Opus, with the forward error correction data of the following
+            //!         packet if it arrived. If the buffer runs empty, concealed frames are inserted, which grows the delay.
+            class BLACKCORE_EXPORT CJitterBufferSampleProvider : public BlackSound::SampleProvider::ISampleProvider
+            {
+                Q_OBJECT
+
+            public:
+                //! Setup
+                struct Setup
+                {
+                    int minDelayMs = 20;        //!< lower bound of the target delay
+                    int maxDelayMs = 300;       //!< upper bound of the target delay, older frames are dropped
+                    int initialDelayMs = 60;    //!< target delay until enough packets have arrived
+                    int marginMs = 10;          //!< added to the estimate, the sound card reads in chunks
+                    double lateRate = 0.01;     //!< accepted share of packets arriving too late
+                    int historySize = 250;      //!< packets the delay is estimated from, 5secs of voice
+                };
+
+                //! Statistics
+                struct BLACKCORE_EXPORT Statistics
+                {
+                    int packets = 0;            //!< received packets
+                    int played = 0;             //!< frames played from packets
+                    int late = 0;               //!< packets arriving after their frame was played or concealed
+                    int concealed = 0;          //!< lost frames replaced by concealment or FEC
+                    int underruns = 0;          //!< concealed frames inserted because the buffer was empty
+                    int dropped = 0;            //!< frames dropped to reduce the delay
+                    int inserted = 0;           //!< silent frames inserted to increase the delay
+                    int transmissions = 0;      //!< started transmissions
+                    qint64 mouthToEarSumMs = 0; //!< sum of the delays from sending to playing the played frames, replays only
+
+                    //! Average delay from sending to playing
+                    double averageMouthToEarMs() const { return played > 0 ? static_cast<double>(mouthToEarSumMs) / played : 0.0; }
+
+                    //! Share of the frames which were concealed or inserted because the packet was missing
+                    double underrunRate() const;
+
+                    //! As string
+                    QString toQString() const;
+                };
+
+                //! Packet of a trace
+                struct TracePacket
+                {
+                    qint64 sentMs = 0;          //!< time the frame was sent
+                    qint64 arrivalMs = 0;       //!< time the packet was received
+                    uint sequence = 0;          //!< sequence counter of the sender
+                    bool lastPacket = false;    //!< last packet of a transmission
+                    QByteArray opusData;        //!< encoded frame
+                };
+
+                //! Ctor
+                CJitterBufferSampleProvider(int sampleRate, QObject *parent = nullptr);
+
+                //! Setup
+                //! @{
+                const Setup &getSetup() const { return m_setup; }
+                void setSetup(const Setup &setup);
+                //! @}
+
+                //! Add a received packet
+                //! \param arrivalMs time of arrival, e.g. QDateTime::currentMSecsSinceEpoch
+                void addPacket(uint sequence, const QByteArray &opusData, bool lastPacket, qint64 arrivalMs);
+
+                //! \copydoc BlackSound::SampleProvider::ISampleProvider::readSamples
+                virtual int readSamples(QVector<float> &samples, qint64 count) override;
+
+                //! \copydoc BlackSound::SampleProvider::ISampleProvider::readSamplesInto
+                //! \remark silence while waiting for the delay of a starting transmission, nothing if there is no transmission
+                virtual int readSamplesInto(float *samples, qint64 count) override;
+
+                //! Is a transmission buffered or played?
+                bool isActive() const { return m_state != Idle; }
+
+                //! Current target delay
+                int getTargetDelayMs() const { return m_targetDelayMs; }
+
+                //! New stream, e.g. another callsign: clears packets and arrival history
+                //! \param initialDelayMs target delay until enough packets have arrived, setup value if negative
+                void reset(int initialDelayMs = -1);
+
+                //! Statistics since the last reset
+                //! @{
+                const Statistics &getStatistics() const { return m_statistics; }
+                void resetStatistics() { m_statistics = {}; }
+                //! @}
+
+                //! Play a recorded or synthetic trace offline, as if the sound card read chunks of readMs
+                //! \remark the trace is played in the order of arrival, resets the buffer
+                Statistics replay(const QVector<TracePacket> &trace, int readMs = 10);
+
+            private:
+                //! State of the playout
+                enum State
+                {
+                    Idle,       //!< no transmission
+                    Buffering,  //!< transmission started, silence until the delay is reached
+                    Playing     //!< frames are played
+                };
+
+                //! Buffered packet
+                struct Slot
+                {
+                    uint sequence = 0;
+                    bool used = false;
+                    bool lastPacket = false;
+                    qint64 sentMs = -1; //!< replays only
+                    QByteArray opusData;
+                };
+
+                //! Number of slots, far more than the frames of the max. delay
+                static constexpr int SlotCount = 64;
+
+                //! Frame duration
+                static constexpr int FrameMs = 20;
+
+                //! Concealed frames inserted into an empty buffer, before the transmission is considered to be over
+                static constexpr int MaxUnderrunFrames = 10;
+
+                //! Peak below which a frame can be dropped or repeated as silence
+                static constexpr float QuietPeak = 0.02f;
+
+                //! Add a packet
+                void addPacket(uint sequence, const QByteArray &opusData, bool lastPacket, qint64 arrivalMs, qint64 sentMs);
+
+                //! Add to the arrival history and update the target delay
+                void updateTargetDelay(uint sequence, qint64 arrivalMs);
+
+                //! Decode the next frame into m_frame, false if the transmission is over
+                bool nextFrame(qint64 nowMs);
+
+                //! Decode a packet into m_frame, false if it cannot be decoded
+                bool decodeFrame(const QByteArray &opusData);
+
+                //! Conceal a lost frame in m_frame
+                void concealFrame(const QByteArray &nextOpusData);
+
+                //! Convert the decoded samples to m_frame
+                void toFrame(int samples);
+
+                //! Silent frame in m_frame
+                void silentFrame();
+
+                //! Delay of the frame to be played now, relative to the fastest recent packet
+                qint64 playoutDelayMs(uint sequence, qint64 nowMs) const;
+
+                //! End of the transmission
+                void stop();
+
+                //! Buffered slot of a sequence, nullptr if not there
+                Slot *slot(uint sequence);
+
+                //! Remove the packet of a used slot
+                void release(Slot &slot);
+
+                //! Is a sequence before another one (wrap around)
+                static bool isBefore(uint sequence, uint other) { return static_cast<int>(sequence - other) < 0; }
+
+                //! Now, the replay clock during replays
+                qint64 nowMs() const;
+
+                Setup m_setup;
+                const int m_sampleRate = 48000;
+                const int m_frameSamples = 960;
+                BlackSound::Codecs::COpusDecoder m_decoder;
+
+                State m_state = Idle;
+                QVector<Slot> m_slots;
+                int m_buffered = 0;                 //!< used slots
+                uint m_nextSequence = 0;            //!< to be played next, after the last played when idle
+                bool m_sequenceKnown = false;       //!< m_nextSequence is valid
+                bool m_endOfTransmission = false;   //!< last packet was played
+                int m_underrunFrames = 0;           //!< consecutive
+                qint64 m_silenceSamples = 0;        //!< remaining silence while buffering, -1 until the playout starts
+
+                QVector<qint16> m_pcm;              //!< decoded frame
+                QVector<float> m_frame;             //!< frame being played
+                int m_framePos = 0;                 //!< played samples of m_frame
+                float m_lastPeak = 0;               //!< of the last frame
+
+                QVector<qint64> m_transits;         //!< ring of arrival minus send time by sequence
+                int m_transitsWritten = 0;
+                QVector<qint64> m_scratch;          //!< for the quantile, capacity is kept
+                qint64 m_minTransitMs = 0;
+                qint64 m_lastTransitMs = 0;
+                int m_targetDelayMs = 60;
+
+                Statistics m_statistics;
+                qint64 m_replayClockMs = -1;        //!< clock of a replay, -1 if not replaying
+            };
+        } // ns
+    } // ns
+} // ns
+
+#endif // guard
@@ -8,6 +8,7 @@
 
 #include "output.h"
 #include "blacksound/audioutilities.h"
+#include "blacksound/dsp/samplekernels.h"
 #include "blackmisc/metadatautils.h"
 #include "blackmisc/logmessage.h"
 #include "blackmisc/verify.h"
@@ -20,6 +21,7 @@ using namespace BlackMisc;
 using namespace BlackMisc::Audio;
 using namespace BlackSound;
 using namespace BlackSound::SampleProvider;
+using namespace BlackSound::Dsp;
 
 namespace BlackCore
 {
@@ -41,14 +43,11 @@ namespace BlackCore
                 const int sampleBytes  = m_outputFormat.sampleSize() / 8;
                 const int channelCount = m_outputFormat.channelCount();
                 const qint64 count     = maxlen / (sampleBytes * channelCount);
-                QVector<float> buffer;
+                QVector<float> &buffer = m_buffer; // capacity is kept
                 m_sampleProvider->readSamples(buffer, count);
+                if (buffer.size() < count) { buffer.resize(static_cast<int>(count)); } // silence, whatever the provider did
 
-                for (float sample : as_const(buffer))
-                {
-                    const float absSample = qAbs(sample);
-                    if (absSample > m_maxSampleOutput) { m_maxSampleOutput = absSample; }
-                }
+                m_maxSampleOutput = qMax(m_maxSampleOutput, peakSample(buffer.constData(), buffer.size()));
 
                 m_sampleCount += buffer.size();
                 if (m_sampleCount >= SampleCountPerEvent)
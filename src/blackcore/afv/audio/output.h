@@ -60,6 +60,7 @@ namespace BlackCore
                 static constexpr int SampleCountPerEvent = 4800;
                 QAudioFormat m_outputFormat;
                 float m_maxSampleOutput = 0.0;
+                QVector<float> m_buffer; //!< reused between the calls
                 int m_sampleCount       =   0;
                 const double m_maxDb    =   0;
                 const double m_minDb    = -40;
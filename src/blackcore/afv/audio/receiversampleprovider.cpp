@@ -96,6 +96,12 @@ namespace BlackCore
             }
 
             int CReceiverSampleProvider::readSamples(QVector<float> &samples, qint64 count)
+            {
+                samples.resize(static_cast<int>(count)); // mixed, all samples valid
+                return this->readSamplesInto(samples.data(), count);
+            }
+
+            int CReceiverSampleProvider::readSamplesInto(float *samples, qint64 count)
             {
                 int numberOfInUseInputs = activeCallsigns();
                 if (numberOfInUseInputs > 1 && m_doBlockWhenAppropriate)
@@ -135,7 +141,7 @@ namespace BlackCore
                     emit receivingCallsignsChanged(args);
                 }
                 m_lastNumberOfInUseInputs = numberOfInUseInputs;
-                return m_volume->readSamples(samples, count);
+                return m_volume->readSamplesInto(samples, count);
             }
 
             void CReceiverSampleProvider::addOpusSamples(const IAudioDto &audioDto, uint frequency, float distanceRatio)
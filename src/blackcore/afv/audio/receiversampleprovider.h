@@ -69,6 +69,9 @@ namespace BlackCore
                 //! \copydoc BlackSound::SampleProvider::ISampleProvider::readSamples
                 virtual int readSamples(QVector<float> &samples, qint64 count) override;
 
+                //! \copydoc BlackSound::SampleProvider::ISampleProvider::readSamplesInto
+                virtual int readSamplesInto(float *samples, qint64 count) override;
+
                 //! Add samples
                 //! @{
                 void addOpusSamples(const IAudioDto &audioDto, uint frequency, float distanceRatio);
@@ -96,6 +96,11 @@ namespace BlackCore
                 return m_mixer->readSamples(samples, count);
             }
 
+            int CSoundcardSampleProvider::readSamplesInto(float *samples, qint64 count)
+            {
+                return m_mixer->readSamplesInto(samples, count);
+            }
+
             void CSoundcardSampleProvider::addOpusSamples(const IAudioDto &audioDto, const QVector<RxTransceiverDto> &rxTransceivers)
             {
                 QVector<RxTransceiverDto> rxTransceiversFilteredAndSorted = rxTransceivers;
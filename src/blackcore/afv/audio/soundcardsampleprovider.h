@@ -46,6 +46,9 @@ namespace BlackCore
                 //! \copydoc BlackSound::SampleProvider::ISampleProvider::readSamples
                 virtual int readSamples(QVector<float> &samples, qint64 count) override;
 
+                //! \copydoc BlackSound::SampleProvider::ISampleProvider::readSamplesInto
+                virtual int readSamplesInto(float *samples, qint64 count) override;
+
                 //! Add OPUS samples
                 void addOpusSamples(const IAudioDto &audioDto, const QVector<RxTransceiverDto> &rxTransceivers);
 
@@ -862,7 +862,7 @@ namespace BlackCore
                     audioData.audio      = QByteArray(args.audio.data(), args.audio.size());
                     audioData.callsign   = QStringLiteral("loopback");
                     audioData.lastPacket = false;
-                    audioData.sequenceCounter = 0;
+                    audioData.sequenceCounter = args.sequenceCounter; // the jitter buffer orders by sequence
 
                     const RxTransceiverDto com1 = { 0, transceivers.size() > 0 ?  transceivers[0].frequencyHz : UniCom, 1.0 };
                     const RxTransceiverDto com2 = { 1, transceivers.size() > 1 ?  transceivers[1].frequencyHz : UniCom, 1.0 };
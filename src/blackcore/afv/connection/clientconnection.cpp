@@ -10,7 +10,7 @@
 #include "blackmisc/logmessage.h"
 #include "blackconfig/buildconfig.h"
 
-#include <QNetworkDatagram>
+#include <QUrl>
 
 using namespace BlackConfig;
 using namespace BlackMisc;
@@ -135,6 +135,7 @@ namespace BlackCore
 
             void CClientConnection::connectToVoiceServer()
             {
+                this->updateVoiceServerEndpoint();
                 const QHostAddress localAddress(QHostAddress::AnyIPv4);
                 m_udpSocket->bind(localAddress);
                 m_voiceServerTimer->start(3000);
@@ -146,15 +147,35 @@ namespace BlackCore
             {
                 m_voiceServerTimer->stop();
                 m_udpSocket->disconnectFromHost();
+                m_voiceServerAddress.clear();
+                m_voiceServerPort = 0;
                 CLogMessage(this).info(u"All TaskVoiceServer tasks stopped");
             }
 
+            void CClientConnection::updateVoiceServerEndpoint()
+            {
+                const QUrl voiceServerUrl("udp://" + m_connection.getTokens().VoiceServer.addressIpV4);
+                m_voiceServerAddress = QHostAddress(voiceServerUrl.host());
+                m_voiceServerPort = static_cast<quint16>(voiceServerUrl.port());
+            }
+
             void CClientConnection::readPendingDatagrams()
             {
+                // all pending datagrams are read into and decrypted in the same buffer
                 while (m_udpSocket->hasPendingDatagrams())
                 {
-                    const QNetworkDatagram datagram = m_udpSocket->receiveDatagram();
-                    this->processMessage(datagram.data());
+                    const qint64 size = m_udpSocket->pendingDatagramSize();
+                    if (size < 0) { break; }
+                    const qint64 read = m_udpSocket->readDatagram(m_voiceDecoder.receiveBuffer(static_cast<int>(size)), size);
+                    if (read < 0) { break; }
+
+                    if (!m_connection.m_voiceCryptoChannel)
+                    {
+                        BLACK_VERIFY_X(false, Q_FUNC_INFO, "readPendingDatagrams used without crypto channel");
+                        continue;
+                    }
+                    m_voiceDecoder.decrypt(*m_connection.m_voiceCryptoChannel, static_cast<int>(read), false);
+                    this->processDecryptedMessage();
                 }
             }
 
@@ -166,25 +187,28 @@ namespace BlackCore
                     return;
                 }
 
-                CryptoDtoSerializer::Deserializer deserializer = CryptoDtoSerializer::deserialize(*m_connection.m_voiceCryptoChannel, messageDdata, loopback);
+                m_voiceDecoder.decrypt(*m_connection.m_voiceCryptoChannel, messageDdata, loopback);
+                this->processDecryptedMessage();
+            }
 
-                if (deserializer.m_dtoNameBuffer == AudioRxOnTransceiversDto::getShortDtoName())
+            void CClientConnection::processDecryptedMessage()
+            {
+                if (m_voiceDecoder.isDto<AudioRxOnTransceiversDto>())
                 {
                     // qDebug() << "Received audio data";
-                    const AudioRxOnTransceiversDto audioOnTransceiverDto = deserializer.getDto<AudioRxOnTransceiversDto>();
-                    if (m_connection.isReceivingAudio() && m_connection.isConnected())
+                    if (m_connection.isReceivingAudio() && m_connection.isConnected() && m_voiceDecoder.getDto(m_audioRxDto))
                     {
-                        emit audioReceived(audioOnTransceiverDto);
+                        emit audioReceived(m_audioRxDto);
                     }
                 }
-                else if (deserializer.m_dtoNameBuffer == HeartbeatAckDto::getShortDtoName())
+                else if (m_voiceDecoder.isDto<HeartbeatAckDto>())
                 {
                     m_connection.setTsHeartbeatToNow();
                     if (CBuildConfig::isLocalDeveloperDebugBuild()) { CLogMessage(this).debug(u"Received voice server heartbeat"); }
                 }
                 else
                 {
-                    CLogMessage(this).warning(u"Received unknown data: %1 %2") << QString(deserializer.m_dtoNameBuffer) << deserializer.m_dataLength;
+                    CLogMessage(this).warning(u"Received unknown data: %1 %2") << QString(m_voiceDecoder.getDtoName()) << m_voiceDecoder.getDtoLength();
                 }
             }
 
@@ -202,12 +226,11 @@ namespace BlackCore
                     return;
                 }
 
-                const QUrl voiceServerUrl("udp://" + m_connection.getTokens().VoiceServer.addressIpV4);
-                if (CBuildConfig::isLocalDeveloperDebugBuild()) { CLogMessage(this).debug(u"Sending voice server heartbeat to '%1'") << voiceServerUrl.host(); }
+                if (CBuildConfig::isLocalDeveloperDebugBuild()) { CLogMessage(this).debug(u"Sending voice server heartbeat to '%1'") << m_voiceServerAddress.toString(); }
                 HeartbeatDto keepAlive;
                 keepAlive.callsign = m_connection.getCallsign().toStdString();
                 const QByteArray dataBytes = CryptoDtoSerializer::serialize(*m_connection.m_voiceCryptoChannel, CryptoDtoMode::AEAD_ChaCha20Poly1305, keepAlive);
-                m_udpSocket->writeDatagram(dataBytes, QHostAddress(voiceServerUrl.host()), static_cast<quint16>(voiceServerUrl.port()));
+                m_udpSocket->writeDatagram(dataBytes, m_voiceServerAddress, m_voiceServerPort);
             }
         } // ns
     } // ns
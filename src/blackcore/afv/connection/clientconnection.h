@@ -17,6 +17,7 @@
 #include "blackcore/afv/dto.h"
 #include "blackmisc/verify.h"
 
+#include <QHostAddress>
 #include <QObject>
 #include <QString>
 #include <QTimer>
@@ -70,6 +71,7 @@ namespace BlackCore
                 //! @}
 
                 //! Send voice DTO to server
+                //! \remark serialized and encrypted in a reused buffer, sent to the endpoint resolved when connecting
                 template<typename T>
                 void sendToVoiceServer(const T &dto)
                 {
@@ -78,9 +80,9 @@ namespace BlackCore
                         BLACK_VERIFY_X(false, Q_FUNC_INFO, "sendVoice used without crypto channel or socket");
                         return;
                     }
-                    const QUrl voiceServerUrl("udp://" + m_connection.getTokens().VoiceServer.addressIpV4);
-                    const QByteArray dataBytes = Crypto::CryptoDtoSerializer::serialize(*m_connection.m_voiceCryptoChannel, Crypto::CryptoDtoMode::AEAD_ChaCha20Poly1305, dto);
-                    m_udpSocket->writeDatagram(dataBytes, QHostAddress(voiceServerUrl.host()), static_cast<quint16>(voiceServerUrl.port()));
+                    const QByteArray &dataBytes = m_voiceEncoder.serialize(*m_connection.m_voiceCryptoChannel, Crypto::CryptoDtoMode::AEAD_ChaCha20Poly1305, dto);
+                    if (dataBytes.isEmpty()) { return; }
+                    m_udpSocket->writeDatagram(dataBytes, m_voiceServerAddress, m_voiceServerPort);
                 }
 
                 //! Update transceivers
@@ -115,8 +117,11 @@ namespace BlackCore
                 void connectToVoiceServer();
                 void disconnectFromVoiceServer();
 
+                void updateVoiceServerEndpoint();
+
                 void readPendingDatagrams();
                 void processMessage(const QByteArray &messageDdata, bool loopback = false);
+                void processDecryptedMessage();
                 void handleSocketError(QAbstractSocket::SocketError error);
 
                 void voiceServerHeartbeat();
@@ -129,6 +134,11 @@ namespace BlackCore
                 // Voice server
                 QUdpSocket *m_udpSocket        = nullptr;
                 QTimer     *m_voiceServerTimer = nullptr;
+                QHostAddress m_voiceServerAddress;  //!< resolved from the tokens when connecting
+                quint16      m_voiceServerPort = 0;
+                Crypto::CCryptoDtoEncoder m_voiceEncoder;
+                Crypto::CCryptoDtoDecoder m_voiceDecoder;
+                AudioRxOnTransceiversDto  m_audioRxDto {}; //!< decoded into, so its memory is reused
 
                 // API server
                 CApiServerConnection *m_apiServerConnection = nullptr;
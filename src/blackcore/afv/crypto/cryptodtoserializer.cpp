@@ -8,12 +8,178 @@
 
 #include "cryptodtoserializer.h"
 
+#include <array>
+#include <cstring>
+
 namespace BlackCore
 {
     namespace Afv
     {
         namespace Crypto
         {
+            namespace
+            {
+                //! Initial size of the datagram buffers, voice datagrams are far smaller
+                constexpr int InitialDatagramBufferSize = 1500;
+
+                //! Size of the length fields
+                constexpr int LengthSize = static_cast<int>(sizeof(quint16));
+
+                //! AEAD nonce
+                using Nonce = std::array<unsigned char, crypto_aead_chacha20poly1305_IETF_NPUBBYTES>;
+
+                //! Nonce of a sequence number: 4 bytes id (always 0), 8 bytes sequence
+                Nonce sequenceNonce(quint64 sequence)
+                {
+                    Nonce nonce {};
+                    std::memcpy(nonce.data() + sizeof(quint32), &sequence, sizeof(sequence));
+                    return nonce;
+                }
+
+                //! Read a length field
+                int readLength(const char *data)
+                {
+                    quint16 length = 0;
+                    std::memcpy(&length, data, sizeof(length));
+                    return length;
+                }
+            }
+
+            CCryptoDtoEncoder::CCryptoDtoEncoder()
+            {
+                // reserved capacity is kept when resizing to 0
+                m_datagram.reserve(InitialDatagramBufferSize);
+            }
+
+            int CCryptoDtoEncoder::appendLength()
+            {
+                const int lengthPos = m_datagram.size();
+                m_datagram.resize(lengthPos + LengthSize);
+                return lengthPos;
+            }
+
+            void CCryptoDtoEncoder::writeLength(int lengthPos)
+            {
+                const quint16 length = static_cast<quint16>(m_datagram.size() - lengthPos - LengthSize);
+                std::memcpy(m_datagram.data() + lengthPos, &length, sizeof(length));
+            }
+
+            const QByteArray &CCryptoDtoEncoder::encryptInPlace(int adLength, const QByteArray &transmitKey, quint64 sequence)
+            {
+                if (transmitKey.size() < static_cast<int>(crypto_aead_chacha20poly1305_IETF_KEYBYTES))
+                {
+                    m_datagram.resize(0);
+                    return m_datagram;
+                }
+
+                const int plainLength = m_datagram.size() - adLength;
+                m_datagram.resize(m_datagram.size() + static_cast<int>(crypto_aead_chacha20poly1305_IETF_ABYTES));
+                unsigned char *data = reinterpret_cast<unsigned char *>(m_datagram.data());
+                const Nonce nonce = sequenceNonce(sequence);
+
+                unsigned long long clen = 0;
+                const int result = crypto_aead_chacha20poly1305_ietf_encrypt(data + adLength, &clen,
+                                   data + adLength, static_cast<unsigned long long>(plainLength),
+                                   data, static_cast<unsigned long long>(adLength),
+                                   nullptr, nonce.data(),
+                                   reinterpret_cast<const unsigned char *>(transmitKey.constData()));
+                if (result != 0) { m_datagram.resize(0); }
+                return m_datagram;
+            }
+
+            CCryptoDtoDecoder::CCryptoDtoDecoder()
+            {
+                m_buffer.resize(InitialDatagramBufferSize);
+            }
+
+            char *CCryptoDtoDecoder::receiveBuffer(int size)
+            {
+                if (m_buffer.size() < size) { m_buffer.resize(size); }
+                return m_buffer.data();
+            }
+
+            bool CCryptoDtoDecoder::decrypt(CCryptoDtoChannel &channel, int size, bool loopback)
+            {
+                m_verified = false;
+                m_dtoName = nullptr;
+                m_dtoData = nullptr;
+                m_dtoNameLength = 0;
+                m_dtoLength = 0;
+                if (size < LengthSize || size > m_buffer.size()) { return false; }
+
+                char *data = m_buffer.data();
+                const int headerLength = readLength(data);
+                const int adLength = LengthSize + headerLength;
+                const int aeLength = size - adLength;
+                if (aeLength < static_cast<int>(crypto_aead_chacha20poly1305_IETF_ABYTES)) { return false; }
+
+                try
+                {
+                    m_zone.clear();
+                    msgpack::unpack(m_zone, data + LengthSize, static_cast<std::size_t>(headerLength), &CCryptoDtoDecoder::referenceBuffer).convert(m_header);
+                }
+                catch (const std::exception &)
+                {
+                    return false;
+                }
+                if (m_header.Mode != CryptoDtoMode::AEAD_ChaCha20Poly1305) { return false; }
+
+                const QByteArray key = loopback ?
+                                       channel.getTransmitKey(CryptoDtoMode::AEAD_ChaCha20Poly1305) :
+                                       channel.getReceiveKey(CryptoDtoMode::AEAD_ChaCha20Poly1305);
+                if (key.size() < static_cast<int>(crypto_aead_chacha20poly1305_IETF_KEYBYTES)) { return false; }
+
+                unsigned char *payload = reinterpret_cast<unsigned char *>(data + adLength);
+                const Nonce nonce = sequenceNonce(m_header.Sequence);
+                unsigned long long mlen = 0;
+                const int result = crypto_aead_chacha20poly1305_ietf_decrypt(payload, &mlen, nullptr,
+                                   payload, static_cast<unsigned long long>(aeLength),
+                                   reinterpret_cast<const unsigned char *>(data), static_cast<unsigned long long>(adLength),
+                                   nonce.data(),
+                                   reinterpret_cast<const unsigned char *>(key.constData()));
+                if (result != 0) { return false; }
+
+                // name length, name, DTO length, DTO
+                const char *plain = data + adLength;
+                const int plainLength = static_cast<int>(mlen);
+                if (plainLength < LengthSize) { return false; }
+                const int nameLength = readLength(plain);
+                if (LengthSize + nameLength + LengthSize > plainLength) { return false; }
+                const int dtoLength = readLength(plain + LengthSize + nameLength);
+                if (LengthSize + nameLength + LengthSize + dtoLength > plainLength) { return false; }
+
+                m_dtoName = plain + LengthSize;
+                m_dtoNameLength = nameLength;
+                m_dtoData = m_dtoName + nameLength + LengthSize;
+                m_dtoLength = dtoLength;
+                m_verified = true;
+                return true;
+            }
+
+            bool CCryptoDtoDecoder::decrypt(CCryptoDtoChannel &channel, const QByteArray &datagram, bool loopback)
+            {
+                std::memcpy(this->receiveBuffer(datagram.size()), datagram.constData(), static_cast<size_t>(datagram.size()));
+                return this->decrypt(channel, datagram.size(), loopback);
+            }
+
+            QByteArray CCryptoDtoDecoder::getDtoName() const
+            {
+                return m_verified ? QByteArray(m_dtoName, m_dtoNameLength) : QByteArray();
+            }
+
+            bool CCryptoDtoDecoder::isDtoName(const QByteArray &name) const
+            {
+                return m_verified && name.size() == m_dtoNameLength && std::memcmp(name.constData(), m_dtoName, static_cast<size_t>(m_dtoNameLength)) == 0;
+            }
+
+            bool CCryptoDtoDecoder::referenceBuffer(msgpack::type::object_type type, std::size_t length, void *userData)
+            {
+                Q_UNUSED(type)
+                Q_UNUSED(length)
+                Q_UNUSED(userData)
+                return true;
+            }
+
             CryptoDtoSerializer::CryptoDtoSerializer() { }
 
             CryptoDtoSerializer::Deserializer CryptoDtoSerializer::deserialize(CCryptoDtoChannel &channel, const QByteArray &bytes, bool loopback)
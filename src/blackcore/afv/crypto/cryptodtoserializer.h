@@ -14,11 +14,13 @@
 #include "cryptodtochannel.h"
 #include "cryptodtomode.h"
 #include "cryptodtoheaderdto.h"
+#include "blackcore/blackcoreexport.h"
 #include "sodium.h"
 
 #include <QByteArray>
 #include <QBuffer>
 #include <QtDebug>
+#include <exception>
 
 #ifndef crypto_aead_chacha20poly1305_IETF_ABYTES
 //! Number of a bytes
@@ -34,81 +36,163 @@ namespace BlackCore
             //! Hash of AFV short dto names
             extern QHash<QByteArray, QByteArray> gShortDtoNames;
 
-            //! Crypto serializer
-            class CryptoDtoSerializer
+            //! Serializes DTOs into a reused datagram buffer, the payload is encrypted in place
+            //! \remark once the buffer has grown to the datagram size, serializing allocates no memory
+            class BLACKCORE_EXPORT CCryptoDtoEncoder
             {
             public:
-                CryptoDtoSerializer();
+                //! Ctor
+                CCryptoDtoEncoder();
 
-                //! Serialize a DTO
+                //! Serialize a DTO, the datagram is valid until the next call
+                //! \remark empty if the mode is not supported or the encryption failed
                 template<typename T>
-                static QByteArray serialize(const QString &channelTag, CryptoDtoMode mode, const QByteArray &transmitKey, uint sequenceToBeSent, T dto)
+                const QByteArray &serialize(const QString &channelTag, CryptoDtoMode mode, const QByteArray &transmitKey, uint sequenceToBeSent, const T &dto)
+                {
+                    m_datagram.resize(0);
+                    if (mode != CryptoDtoMode::AEAD_ChaCha20Poly1305) { return m_datagram; }
+
+                    if (channelTag != m_channelTag)
+                    {
+                        m_channelTag = channelTag;
+                        m_header.ChannelTag = channelTag.toStdString();
+                    }
+                    m_header.Sequence = sequenceToBeSent;
+                    m_header.Mode = mode;
+
+                    // header length, header: the associated data
+                    Writer writer { m_datagram };
+                    int lengthPos = this->appendLength();
+                    msgpack::pack(writer, m_header);
+                    this->writeLength(lengthPos);
+                    const int adLength = m_datagram.size();
+
+                    // name length, name, DTO length, DTO: the encrypted payload
+                    lengthPos = this->appendLength();
+                    m_datagram.append(T::getShortDtoName());
+                    this->writeLength(lengthPos);
+                    lengthPos = this->appendLength();
+                    msgpack::pack(writer, dto);
+                    this->writeLength(lengthPos);
+
+                    return this->encryptInPlace(adLength, transmitKey, sequenceToBeSent);
+                }
+
+                //! Serialize a DTO with the next sequence number of the channel
+                template<typename T>
+                const QByteArray &serialize(CCryptoDtoChannel &channel, CryptoDtoMode mode, const T &dto)
                 {
-                    const CryptoDtoHeaderDto header = { channelTag.toStdString(), sequenceToBeSent, mode };
+                    uint sequenceToSend = 0;
+                    const QByteArray transmitKey = channel.getTransmitKey(mode, sequenceToSend);
+                    return this->serialize(channel.getChannelTag(), mode, transmitKey, sequenceToSend, dto);
+                }
+
+            private:
+                //! msgpack stream appending to the datagram
+                struct Writer
+                {
+                    QByteArray &datagram; //!< written to
+
+                    //! Append
+                    void write(const char *data, size_t size) { datagram.append(data, static_cast<int>(size)); }
+                };
+
+                //! Append a placeholder for a length, returns its position
+                int appendLength();
+
+                //! Write the number of bytes following the length at the given position
+                void writeLength(int lengthPos);
+
+                //! Encrypt everything after the associated data and append the tag
+                const QByteArray &encryptInPlace(int adLength, const QByteArray &transmitKey, quint64 sequence);
+
+                QByteArray m_datagram;
+                QString m_channelTag;             //!< tag of m_header.ChannelTag
+                CryptoDtoHeaderDto m_header {};
+            };
+
+            //! Decrypts and decodes datagrams in place in a reused buffer
+            //! \remark once the buffer has grown to the datagram size, only decoding into the DTO can allocate memory
+            class BLACKCORE_EXPORT CCryptoDtoDecoder
+            {
+            public:
+                //! Ctor
+                CCryptoDtoDecoder();
+
+                //! Buffer to receive a datagram of the given size into, to be decrypted by decrypt(channel, size, loopback)
+                char *receiveBuffer(int size);
+
+                //! Decrypt the datagram in the receive buffer
+                //! \remark false if the datagram is malformed or cannot be verified
+                bool decrypt(CCryptoDtoChannel &channel, int size, bool loopback);
 
-                    QBuffer headerBuffer;
-                    headerBuffer.open(QIODevice::WriteOnly);
-                    msgpack::pack(headerBuffer, header);
-                    headerBuffer.close();
-                    const quint16 headerLength = static_cast<quint16>(headerBuffer.buffer().size());
+                //! Copy the datagram into the receive buffer and decrypt it
+                bool decrypt(CCryptoDtoChannel &channel, const QByteArray &datagram, bool loopback);
 
-                    const QByteArray dtoShortName = T::getShortDtoName();
-                    const quint16 dtoNameLength = static_cast<quint16>(dtoShortName.size());
+                //! Was the last datagram verified?
+                bool isVerified() const { return m_verified; }
+
+                //! Header of the last datagram
+                const CryptoDtoHeaderDto &getHeader() const { return m_header; }
+
+                //! Is the DTO of the last datagram a T?
+                template<typename T>
+                bool isDto() const { return this->isDtoName(T::getShortDtoName()) || this->isDtoName(T::getDtoName()); }
 
-                    QBuffer dtoBuffer;
-                    dtoBuffer.open(QIODevice::WriteOnly);
-                    msgpack::pack(dtoBuffer, dto);
-                    dtoBuffer.close();
-                    const quint16 dtoLength = static_cast<quint16>(dtoBuffer.buffer().size());
+                //! Name of the DTO of the last datagram
+                QByteArray getDtoName() const;
 
-                    if (header.Mode == CryptoDtoMode::AEAD_ChaCha20Poly1305)
+                //! Length of the DTO of the last datagram
+                int getDtoLength() const { return m_dtoLength; }
+
+                //! Decode the DTO of the last datagram, the memory already held by dto is reused
+                //! \remark false if the DTO is not a T or cannot be decoded
+                template<typename T>
+                bool getDto(T &dto)
+                {
+                    if (!this->isDto<T>()) { return false; }
+                    try
                     {
-                        QBuffer aePayloadBuffer;
-                        aePayloadBuffer.open(QIODevice::WriteOnly);
-                        aePayloadBuffer.write(reinterpret_cast<const char *>(&dtoNameLength), sizeof(dtoNameLength));
-                        aePayloadBuffer.write(dtoShortName);
-                        aePayloadBuffer.write(reinterpret_cast<const char *>(&dtoLength), sizeof(dtoLength));
-                        aePayloadBuffer.write(dtoBuffer.buffer());
-                        aePayloadBuffer.close();
-
-                        QBuffer adPayloadBuffer;
-                        adPayloadBuffer.open(QIODevice::WriteOnly);
-                        adPayloadBuffer.write(reinterpret_cast<const char *>(&headerLength), sizeof(headerLength));
-                        adPayloadBuffer.write(headerBuffer.buffer());
-                        adPayloadBuffer.close();
-
-                        QByteArray nonce;
-                        nonce.fill(0, crypto_aead_chacha20poly1305_IETF_NPUBBYTES);
-                        QBuffer nonceBuffer(&nonce);
-                        nonceBuffer.open(QIODevice::WriteOnly);
-                        uint32_t id = 0;
-                        nonceBuffer.write(reinterpret_cast<const char *>(&id), sizeof(id));
-                        nonceBuffer.write(reinterpret_cast<const char *>(&header.Sequence), sizeof(header.Sequence));
-                        nonceBuffer.close();
-
-                        unsigned long long clen;
-                        QByteArray aeadPayload;
-                        aeadPayload.fill(0, static_cast<int>(aePayloadBuffer.size() + crypto_aead_chacha20poly1305_IETF_ABYTES));
-                        int result = crypto_aead_chacha20poly1305_ietf_encrypt(reinterpret_cast<unsigned char *>(aeadPayload.data()),
-                                     &clen,
-                                     reinterpret_cast<const unsigned char *>(aePayloadBuffer.buffer().constData()), aePayloadBuffer.size(),
-                                     reinterpret_cast<const unsigned char *>(adPayloadBuffer.buffer().constData()), adPayloadBuffer.size(),
-                                     nullptr,
-                                     reinterpret_cast<const unsigned char *>(nonce.constData()),
-                                     reinterpret_cast<const unsigned char *>(transmitKey.constData()));
-                        if (result != 0) { return {}; }
-
-                        QBuffer packetBuffer;
-                        packetBuffer.open(QIODevice::WriteOnly);
-                        packetBuffer.write(reinterpret_cast<const char *>(&headerLength), sizeof(headerLength));
-                        packetBuffer.write(headerBuffer.buffer());
-                        packetBuffer.write(aeadPayload);
-                        packetBuffer.close();
-
-                        return packetBuffer.buffer();
+                        m_zone.clear();
+                        msgpack::unpack(m_zone, m_dtoData, static_cast<std::size_t>(m_dtoLength), &CCryptoDtoDecoder::referenceBuffer).convert(dto);
+                        return true;
                     }
+                    catch (const std::exception &)
+                    {
+                        return false;
+                    }
+                }
 
-                    return {};
+            private:
+                //! Compare with the DTO name of the last datagram
+                bool isDtoName(const QByteArray &name) const;
+
+                //! Unpacked strings and binaries refer to the receive buffer instead of being copied
+                static bool referenceBuffer(msgpack::type::object_type type, std::size_t length, void *userData);
+
+                QByteArray m_buffer;
+                msgpack::zone m_zone;
+                CryptoDtoHeaderDto m_header {};
+                const char *m_dtoName = nullptr; //!< in m_buffer
+                const char *m_dtoData = nullptr; //!< in m_buffer
+                int m_dtoNameLength = 0;
+                int m_dtoLength = 0;
+                bool m_verified = false;
+            };
+
+            //! Crypto serializer
+            class BLACKCORE_EXPORT CryptoDtoSerializer
+            {
+            public:
+                CryptoDtoSerializer();
+
+                //! Serialize a DTO
+                //! \remark allocates a new datagram, use a CCryptoDtoEncoder for frequently sent DTOs
+                template<typename T>
+                static QByteArray serialize(const QString &channelTag, CryptoDtoMode mode, const QByteArray &transmitKey, uint sequenceToBeSent, T dto)
+                {
+                    CCryptoDtoEncoder encoder;
+                    return encoder.serialize(channelTag, mode, transmitKey, sequenceToBeSent, dto);
                 }
 
                 //! Serialize a DTO
@@ -121,7 +205,8 @@ namespace BlackCore
                 }
 
                 //! Deserializer
-                struct Deserializer
+                //! \remark copies the payload, use a CCryptoDtoDecoder for frequently received DTOs
+                struct BLACKCORE_EXPORT Deserializer
                 {
                     //! Ctor
                     Deserializer(CCryptoDtoChannel &channel, const QByteArray &bytes, bool loopback);
@@ -189,8 +189,8 @@ namespace BlackCore
         {
             //! Name
             //! @{
-            static QByteArray getDtoName() { return "HeartbeatDto"; }
-            static QByteArray getShortDtoName() { return "H"; }
+            static QByteArray getDtoName() { return QByteArrayLiteral("HeartbeatDto"); }
+            static QByteArray getShortDtoName() { return QByteArrayLiteral("H"); }
             //! @}
 
             std::string callsign; //!< callsign
@@ -202,8 +202,8 @@ namespace BlackCore
         {
             //! Name
             //! @{
-            static QByteArray getDtoName() { return "HeartbeatAckDto"; }
-            static QByteArray getShortDtoName() { return "HA"; }
+            static QByteArray getDtoName() { return QByteArrayLiteral("HeartbeatAckDto"); }
+            static QByteArray getShortDtoName() { return QByteArrayLiteral("HA"); }
             //! @}
 
             MSGPACK_DEFINE()
@@ -250,8 +250,8 @@ namespace BlackCore
         {
             //! Names
             //! @{
-            static QByteArray getDtoName() { return "AudioTxOnTransceiversDto"; }
-            static QByteArray getShortDtoName() { return "AT"; }
+            static QByteArray getDtoName() { return QByteArrayLiteral("AudioTxOnTransceiversDto"); }
+            static QByteArray getShortDtoName() { return QByteArrayLiteral("AT"); }
             //! @}
 
             //! Properties
@@ -270,8 +270,8 @@ namespace BlackCore
         {
             //! Names
             //! @{
-            static QByteArray getDtoName() { return "AudioRxOnTransceiversDto"; }
-            static QByteArray getShortDtoName() { return "AR"; }
+            static QByteArray getDtoName() { return QByteArrayLiteral("AudioRxOnTransceiversDto"); }
+            static QByteArray getShortDtoName() { return QByteArrayLiteral("AR"); }
             //! @}
 
             //! Properties
@@ -24,6 +24,7 @@
 #include "blackmisc/statusmessagelist.h"
 #include "blackmisc/swiftdirectories.h"
 #include "blackmisc/directoryutils.h"
+#include "blackmisc/parallel.h"
 #include "aircraftmatcher.h"
 
 #include <QList>
@@ -32,6 +33,8 @@
 #include <QPair>
 #include <QStringBuilder>
 #include <QJSEngine>
+#include <QMutexLocker>
+#include <memory>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Aviation;
@@ -255,8 +258,39 @@ namespace BlackCore
 
     CAircraftModel CAircraftMatcher::getClosestMatch(const CSimulatedAircraft &remoteAircraft, MatchingLog whatToLog, CStatusMessageList *log, bool useMatchingScript) const
     {
-        CAircraftModelList modelSet(m_modelSet); // Models for this matching
+        const CAircraftModelSetIndexPtr index = this->getModelSetIndex(); // Models for this matching
         const CAircraftMatcherSetup setup = m_setup;
+        return CAircraftMatcher::getClosestMatchImplementation(remoteAircraft, *index, setup, m_categoryMatcher, m_defaultModel, whatToLog, log, useMatchingScript);
+    }
+
+    CAircraftModelList CAircraftMatcher::getClosestMatches(const CSimulatedAircraftList &remoteAircraft, MatchingLog whatToLog, QVector<CStatusMessageList> *logs, bool useMatchingScript, const std::atomic_bool *canceled) const
+    {
+        if (logs) { *logs = QVector<CStatusMessageList>(remoteAircraft.size()); }
+        if (remoteAircraft.isEmpty()) { return {}; }
+
+        // one snapshot for all aircraft, the matcher itself can change meanwhile
+        const CAircraftModelSetIndexPtr index = this->getModelSetIndex();
+        const CAircraftMatcherSetup setup = m_setup;
+        const CCategoryMatcher categoryMatcher = m_categoryMatcher;
+        const CAircraftModel defaultModel = m_defaultModel;
+
+        // results are written by position, so they are in order of the aircraft
+        const int count = remoteAircraft.size();
+        QVector<CAircraftModel> matched(count);
+        CAircraftModel *matchedData = matched.data();
+        CStatusMessageList *logData = logs ? logs->data() : nullptr;
+        runInParallel(count, [ & ](int i)
+        {
+            if ((canceled && *canceled) || (sApp && sApp->isShuttingDown())) { return; }
+            matchedData[i] = CAircraftMatcher::getClosestMatchImplementation(remoteAircraft[i], *index, setup, categoryMatcher, defaultModel, whatToLog, logData ? &logData[i] : nullptr, useMatchingScript);
+        });
+
+        return CAircraftModelList(CSequence<CAircraftModel>(std::move(matched)));
+    }
+
+    CAircraftModel CAircraftMatcher::getClosestMatchImplementation(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const CAircraftMatcherSetup &setup, const CCategoryMatcher &categoryMatcher, const CAircraftModel &defaultModel, MatchingLog whatToLog, CStatusMessageList *log, bool useMatchingScript)
+    {
+        ModelIds modelSet = index.allIds();
 
         static const QString format("hh:mm:ss.zzz");
         static const QString m1("--- Start matching: UTC %1 ---");
@@ -280,7 +314,7 @@ namespace BlackCore
 
         CMatchingUtils::addLogDetailsToList(log, remoteAircraft, m1.arg(startTime.toString(format)));
         CMatchingUtils::addLogDetailsToList(log, remoteAircraft, m2.arg(remoteAircraft.getCallsignAsString(), removeSurroundingApostrophes(remoteAircraft.getModel().toQString())));
-        CMatchingUtils::addLogDetailsToList(log, remoteAircraft, m3.arg(modelSet.size()).arg(modelSet.coverageSummaryForModel(remoteAircraft.getModel())));
+        if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, m3.arg(modelSet.size()).arg(index.models().coverageSummaryForModel(remoteAircraft.getModel()))); }
         CMatchingUtils::addLogDetailsToList(log, remoteAircraft, m4.arg(setup.toQString(true)));
 
         // Before I really search I check some special conditions
@@ -302,7 +336,7 @@ namespace BlackCore
         else if (modelSet.isEmpty())
         {
             CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("No models for matching, using default"), getLogCategories(), CStatusMessage::SeverityError);
-            matchedModel = this->getDefaultModel();
+            matchedModel = defaultModel;
             resolvedInPrephase = true;
         }
         else if (remoteAircraft.hasModelString())
@@ -310,7 +344,7 @@ namespace BlackCore
             // try to find in installed models by model string
             if (setup.getMatchingMode().testFlag(CAircraftMatcherSetup::ByModelString))
             {
-                matchedModel = matchByExactModelString(remoteAircraft, modelSet, whatToLog, log);
+                matchedModel = matchByExactModelString(remoteAircraft, index, whatToLog, log);
                 if (matchedModel.hasModelString())
                 {
                     CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Exact match by model string '" % matchedModel.getModelStringAndDbKey() % "'", getLogCategories(), CStatusMessage::SeverityError);
@@ -326,21 +360,26 @@ namespace BlackCore
         if (!resolvedInPrephase)
         {
             // sanity
-            const int noString = modelSet.removeAllWithoutModelString();
+            const int noString = modelSet.size() - index.withModelString().size();
+            modelSet = index.withModelString();
             static const QString noModelStr("Excluded %1 models without model string");
             if (noString > 0 && log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, noModelStr.arg(noString)); }
 
             // exclusion
             if (setup.getMatchingMode().testFlag(CAircraftMatcherSetup::ExcludeNoDbData))
             {
-                const int noDbKey = modelSet.removeObjectsWithoutDbKey();
+                const int count = modelSet.size();
+                modelSet = CAircraftModelSetIndex::intersect(modelSet, index.withValidDbKey());
+                const int noDbKey = count - modelSet.size();
                 static const QString excludedStr("Excluded %1 models without DB key");
                 if (noDbKey > 0 && log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, excludedStr.arg(noDbKey)); }
             }
 
             if (setup.getMatchingMode().testFlag(CAircraftMatcherSetup::ExcludeNoExcluded))
             {
-                const int excluded = modelSet.removeIfExcluded();
+                const int count = modelSet.size();
+                modelSet = CAircraftModelSetIndex::intersect(modelSet, index.withoutExcluded());
+                const int excluded = count - modelSet.size();
                 static const QString excludedStr("Excluded %1 models marked 'Excluded'");
                 if (excluded > 0 && log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, excludedStr.arg(excluded)); }
             }
@@ -354,21 +393,21 @@ namespace BlackCore
             switch (setup.getMatchingAlgorithm())
             {
             case CAircraftMatcherSetup::MatchingStepwiseReduce:
-                candidates = CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(modelSet, setup, m_categoryMatcher, remoteAircraft, whatToLog, log);
+                candidates = index.toModels(CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(index, modelSet, setup, categoryMatcher, remoteAircraft, whatToLog, log));
                 break;
             case CAircraftMatcherSetup::MatchingScoreBased:
-                candidates = CAircraftMatcher::getClosestMatchScoreImplementation(modelSet, setup, remoteAircraft, maxScore, whatToLog, log);
+                candidates = CAircraftMatcher::getClosestMatchScoreImplementation(index.toModels(modelSet), setup, remoteAircraft, maxScore, whatToLog, log);
                 break;
             case CAircraftMatcherSetup::MatchingStepwiseReducePlusScoreBased:
             default:
-                candidates = CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(modelSet, setup, m_categoryMatcher, remoteAircraft, whatToLog, log);
+                candidates = index.toModels(CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(index, modelSet, setup, categoryMatcher, remoteAircraft, whatToLog, log));
                 candidates = CAircraftMatcher::getClosestMatchScoreImplementation(candidates, setup, remoteAircraft, maxScore, whatToLog, log);
                 break;
             }
 
             if (candidates.isEmpty())
             {
-                matchedModel = CAircraftMatcher::getCombinedTypeDefaultModel(modelSet, remoteAircraft, this->getDefaultModel(), whatToLog, log);
+                matchedModel = CAircraftMatcher::getCombinedTypeDefaultModel(index, modelSet, remoteAircraft, defaultModel, whatToLog, log);
             }
             else
             {
@@ -405,7 +444,7 @@ namespace BlackCore
         if (useMatchingScript && setup.doRunMsMatchingStageScript())
         {
             CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("Matching script: Matching stage script used"));
-            const MatchingScriptReturnValues rv = CAircraftMatcher::matchingStageScript(remoteAircraft.getModel(), matchedModel, setup, modelSet, log);
+            const MatchingScriptReturnValues rv = CAircraftMatcher::matchingStageScript(remoteAircraft.getModel(), matchedModel, setup, index.toModels(modelSet), log);
             CAircraftModel matchedModelMs = matchedModel;
 
             if (rv.runScriptAndModified())
@@ -422,7 +461,7 @@ namespace BlackCore
                 CSimulatedAircraft rerunAircraft(remoteAircraft);
                 rerunAircraft.setModel(matchedModelMs);
                 CStatusMessageList log2ndRun;
-                matchedModelMs = CAircraftMatcher::getClosestMatch(rerunAircraft, whatToLog, log ? &log2ndRun : nullptr, false);
+                matchedModelMs = CAircraftMatcher::getClosestMatchImplementation(rerunAircraft, index, setup, categoryMatcher, defaultModel, whatToLog, log ? &log2ndRun : nullptr, false);
                 if (log) { log->push_back(log2ndRun); }
 
                 // the script can fuckup the model, leading to an empty model string or such
@@ -450,7 +489,6 @@ namespace BlackCore
         if (!matchedModel.hasModelString())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("All matching yielded no result, VERY odd...")); }
-            CAircraftModel defaultModel = this->getDefaultModel();
             if (defaultModel.hasModelString())
             {
                 matchedModel = defaultModel;
@@ -1295,6 +1333,7 @@ namespace BlackCore
 
         // set values
         m_modelSet  = modelsCleaned;
+        this->invalidateModelSetIndex();
         m_simulator = simulator;
         m_modelSetInfo = QStringLiteral("Set: '%1' entries: %2").arg(simulator.toQString()).arg(modelsCleaned.size());
         return models.size();
@@ -1313,11 +1352,26 @@ namespace BlackCore
             m_disabledModels = removedModels;
             m_modelSet.removeModelsWithString(removedModels, Qt::CaseInsensitive);
         }
+        this->invalidateModelSetIndex();
     }
 
     void CAircraftMatcher::restoreDisabledModels()
     {
         m_modelSet.replaceOrAddModelsWithString(m_disabledModels, Qt::CaseInsensitive);
+        this->invalidateModelSetIndex();
+    }
+
+    CAircraftModelSetIndexPtr CAircraftMatcher::getModelSetIndex() const
+    {
+        QMutexLocker l(&m_modelSetIndexMutex);
+        if (!m_modelSetIndex) { m_modelSetIndex = std::make_shared<const CAircraftModelSetIndex>(m_modelSet); }
+        return m_modelSetIndex;
+    }
+
+    void CAircraftMatcher::invalidateModelSetIndex()
+    {
+        QMutexLocker l(&m_modelSetIndexMutex);
+        m_modelSetIndex.reset();
     }
 
     void CAircraftMatcher::setDefaultModel(const CAircraftModel &defaultModel)
@@ -1394,9 +1448,9 @@ namespace BlackCore
         return CFileUtils::writeStringToFile(json, CFileUtils::appendFilePathsAndFixUnc(CSwiftDirectories::logDirectory(), QStringLiteral("removed models %1.json").arg(ts)));
     }
 
-    CAircraftModelList CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(const CAircraftModelList &modelSet, const CAircraftMatcherSetup &setup, const CCategoryMatcher &categoryMatcher, const CSimulatedAircraft &remoteAircraft, MatchingLog whatToLog, CStatusMessageList *log)
+    CAircraftMatcher::ModelIds CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(const CAircraftModelSetIndex &index, const ModelIds &modelSet, const CAircraftMatcherSetup &setup, const CCategoryMatcher &categoryMatcher, const CSimulatedAircraft &remoteAircraft, MatchingLog whatToLog, CStatusMessageList *log)
     {
-        CAircraftModelList matchedModels(modelSet);
+        ModelIds matchedModels(modelSet);
         CAircraftModel matchedModel(remoteAircraft.getModel());
         Q_UNUSED(whatToLog)
 
@@ -1408,7 +1462,7 @@ namespace BlackCore
             // by livery, then by ICAO
             if (mode.testFlag(CAircraftMatcherSetup::ByLivery))
             {
-                matchedModels = ifPossibleReduceByLiveryAndAircraftIcaoCode(remoteAircraft, matchedModels, reduced, log);
+                matchedModels = ifPossibleReduceByLiveryAndAircraftIcaoCode(remoteAircraft, index, matchedModels, reduced, log);
                 if (reduced) { break; } // almost perfect, we stop here (we have ICAO + livery match)
             }
             else if (reduceLog)
@@ -1420,7 +1474,7 @@ namespace BlackCore
             {
                 // by airline/aircraft or by aircraft/airline depending on setup
                 // family is also considered
-                matchedModels = ifPossibleReduceByIcaoData(remoteAircraft, matchedModels, setup, reduced, log);
+                matchedModels = ifPossibleReduceByIcaoData(remoteAircraft, index, matchedModels, setup, reduced, log);
             }
             else if (reduceLog)
             {
@@ -1430,7 +1484,7 @@ namespace BlackCore
                 if (mode.testFlag(CAircraftMatcherSetup::ByFamily))
                 {
                     QString usedFamily;
-                    matchedModels = ifPossibleReduceByFamily(remoteAircraft, UsePseudoFamily, matchedModels, reduced, usedFamily, log);
+                    matchedModels = ifPossibleReduceByFamily(remoteAircraft, UsePseudoFamily, index, matchedModels, reduced, usedFamily, log);
                     if (reduced) { break; }
                 }
                 else if (reduceLog)
@@ -1441,7 +1495,8 @@ namespace BlackCore
 
             if (setup.useCategoryMatching())
             {
-                matchedModels = categoryMatcher.reduceByCategories(matchedModels, modelSet, setup, remoteAircraft, reduced, whatToLog, log);
+                // categories are not indexed, the category matcher filters the ids by the models
+                matchedModels = categoryMatcher.reduceByCategories(index, matchedModels, modelSet, setup, remoteAircraft, reduced, whatToLog, log);
                 // ?? break here ??
             }
             else if (reduceLog)
@@ -1450,30 +1505,34 @@ namespace BlackCore
             }
 
             // if not yet reduced, reduce to VTOL
-            if (!reduced && remoteAircraft.isVtol() && matchedModels.containsVtol() && mode.testFlag(CAircraftMatcherSetup::ByVtol))
+            if (!reduced && remoteAircraft.isVtol() && mode.testFlag(CAircraftMatcherSetup::ByVtol))
             {
-                matchedModels = matchedModels.findByVtolFlag(true);
-                CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("Aircraft is VTOL, reduced to VTOL"), getLogCategories());
+                const ModelIds vtolModels = CAircraftModelSetIndex::intersect(matchedModels, index.findByVtolFlag(true));
+                if (!vtolModels.isEmpty())
+                {
+                    matchedModels = vtolModels;
+                    CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("Aircraft is VTOL, reduced to VTOL"), getLogCategories());
+                }
             }
 
             // military / civilian
             bool milFlagReduced = false;
             if (mode.testFlag(CAircraftMatcherSetup::ByMilitary) && remoteAircraft.isMilitary())
             {
-                matchedModels = ifPossibleReduceByMilitaryFlag(remoteAircraft, matchedModels, reduced, reduceLog);
+                matchedModels = ifPossibleReduceByMilitaryFlag(remoteAircraft, index, matchedModels, reduced, reduceLog);
                 milFlagReduced = true;
             }
 
             if (!milFlagReduced && mode.testFlag(CAircraftMatcherSetup::ByCivilian) && !remoteAircraft.isMilitary())
             {
-                matchedModels = ifPossibleReduceByMilitaryFlag(remoteAircraft, matchedModels, reduced, reduceLog);
+                matchedModels = ifPossibleReduceByMilitaryFlag(remoteAircraft, index, matchedModels, reduced, reduceLog);
                 milFlagReduced = true;
             }
 
             // combined code
             if (mode.testFlag(CAircraftMatcherSetup::ByCombinedType))
             {
-                matchedModels = ifPossibleReduceByCombinedType(remoteAircraft, matchedModels, setup, reduced, reduceLog);
+                matchedModels = ifPossibleReduceByCombinedType(remoteAircraft, index, matchedModels, setup, reduced, reduceLog);
                 if (reduced) { break; }
             }
             else if (log)
@@ -1486,7 +1545,7 @@ namespace BlackCore
         // here we have a list of possible models, we reduce/refine further
         if (matchedModels.size() > 1 && mode.testFlag(CAircraftMatcherSetup::ByManufacturer))
         {
-            matchedModels = ifPossibleReduceByManufacturer(remoteAircraft, matchedModels, QStringLiteral("2nd trial to reduce by manufacturer. "), reduced, reduceLog);
+            matchedModels = ifPossibleReduceByManufacturer(remoteAircraft, index, matchedModels, QStringLiteral("2nd trial to reduce by manufacturer. "), reduced, reduceLog);
         }
 
         return matchedModels;
@@ -1513,7 +1572,7 @@ namespace BlackCore
         return maxScoreAircraft;
     }
 
-    CAircraftModel CAircraftMatcher::getCombinedTypeDefaultModel(const CAircraftModelList &modelSet, const CSimulatedAircraft &remoteAircraft, const CAircraftModel &defaultModel, MatchingLog whatToLog, CStatusMessageList *log)
+    CAircraftModel CAircraftMatcher::getCombinedTypeDefaultModel(const CAircraftModelSetIndex &index, const ModelIds &modelSet, const CSimulatedAircraft &remoteAircraft, const CAircraftModel &defaultModel, MatchingLog whatToLog, CStatusMessageList *log)
     {
         const QString combinedType = remoteAircraft.getAircraftIcaoCombinedType();
         CStatusMessageList *combinedLog = log && whatToLog.testFlag(MatchingLogCombinedDefaultType) ? log : nullptr;
@@ -1530,7 +1589,7 @@ namespace BlackCore
         }
 
         CMatchingUtils::addLogDetailsToList(combinedLog, remoteAircraft, u"Searching by combined type with color livery '" % combinedType % "'", getLogCategories());
-        CAircraftModelList matchedModels = modelSet.findByCombinedTypeWithColorLivery(combinedType);
+        ModelIds matchedModels = CAircraftModelSetIndex::intersect(modelSet, index.findByCombinedTypeWithColorLivery(combinedType));
         if (!matchedModels.isEmpty())
         {
             CMatchingUtils::addLogDetailsToList(combinedLog, remoteAircraft, u"Found " % QString::number(matchedModels.size()) % u" by combined type w/color livery '" % combinedType % "'", getLogCategories());
@@ -1538,7 +1597,7 @@ namespace BlackCore
         else
         {
             CMatchingUtils::addLogDetailsToList(combinedLog, remoteAircraft, u"Searching by combined type '" % combinedType % "'", getLogCategories());
-            matchedModels = matchedModels.findByCombinedType(combinedType);
+            matchedModels = CAircraftModelSetIndex::intersect(matchedModels, index.findByCombinedType(combinedType));
             if (!matchedModels.isEmpty())
             {
                 CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found " % QString::number(matchedModels.size()) % u" by combined '" % combinedType % "'", getLogCategories());
@@ -1547,10 +1606,10 @@ namespace BlackCore
 
         // return
         if (matchedModels.isEmpty()) { return defaultModel; }
-        return matchedModels.front();
+        return index.model(matchedModels.front());
     }
 
-    CAircraftModel CAircraftMatcher::matchByExactModelString(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &models, MatchingLog whatToLog, CStatusMessageList *log)
+    CAircraftModel CAircraftMatcher::matchByExactModelString(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, MatchingLog whatToLog, CStatusMessageList *log)
     {
         CStatusMessageList *msLog = log && whatToLog.testFlag(MatchingLogModelstring) ? log : nullptr;
         if (remoteAircraft.getModelString().isEmpty())
@@ -1559,7 +1618,8 @@ namespace BlackCore
             return CAircraftModel();
         }
 
-        CAircraftModel model = models.findFirstByModelStringAliasOrDefault(remoteAircraft.getModelString());
+        const int id = index.findFirstByModelStringAlias(remoteAircraft.getModelString());
+        CAircraftModel model = id < 0 ? CAircraftModel() : index.model(id);
         if (msLog)
         {
             if (model.hasModelString())
@@ -1576,37 +1636,37 @@ namespace BlackCore
         return model;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByLiveryAndAircraftIcaoCode(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, bool &reduced, CStatusMessageList *log)
+    CAircraftMatcher::ModelIds CAircraftMatcher::ifPossibleReduceByLiveryAndAircraftIcaoCode(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const ModelIds &inIds, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         if (!remoteAircraft.getLivery().hasCombinedCode())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("No livery code, no reduction possible"), getLogCategories()); }
-            return inList;
+            return inIds;
         }
 
-        const CAircraftModelList byLivery(
-            inList.findByAircraftDesignatorAndLiveryCombinedCode(
-                remoteAircraft.getLivery().getCombinedCode(),
-                remoteAircraft.getAircraftIcaoCodeDesignator()
-            ));
+        const ModelIds byLivery = CAircraftModelSetIndex::intersect(inIds,
+                                  index.findByAircraftDesignatorAndLiveryCombinedCode(
+                                      remoteAircraft.getLivery().getCombinedCode(),
+                                      remoteAircraft.getAircraftIcaoCodeDesignator()
+                                  ));
 
         if (byLivery.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Not found by livery code " % remoteAircraft.getLivery().getCombinedCode(), getLogCategories()); }
-            return inList;
+            return inIds;
         }
         reduced = true;
         return byLivery;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByIcaoData(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const CAircraftMatcherSetup &setup, bool &reduced, CStatusMessageList *log)
+    CAircraftMatcher::ModelIds CAircraftMatcher::ifPossibleReduceByIcaoData(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const ModelIds &inIds, const CAircraftMatcherSetup &setup, bool &reduced, CStatusMessageList *log)
     {
         const CAircraftMatcherSetup::MatchingMode mode = setup.getMatchingMode();
-        if (inList.isEmpty())
+        if (inIds.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("Empty list, skipping step"), getLogCategories()); }
-            return inList;
+            return inIds;
         }
 
         reduced = false;
@@ -1614,8 +1674,8 @@ namespace BlackCore
         {
             bool r1 = false;
             bool r2 = false;
-            CAircraftModelList models = ifPossibleReduceByAirline(remoteAircraft, inList, setup, QStringLiteral("Reduce by airline first."), r1, log);
-            models = ifPossibleReduceByAircraftOrFamily(remoteAircraft, UsePseudoFamily, models, setup, QStringLiteral("Reduce by aircraft ICAO second."), r2, log);
+            ModelIds models = ifPossibleReduceByAirline(remoteAircraft, index, inIds, setup, QStringLiteral("Reduce by airline first."), r1, log);
+            models = ifPossibleReduceByAircraftOrFamily(remoteAircraft, UsePseudoFamily, index, models, setup, QStringLiteral("Reduce by aircraft ICAO second."), r2, log);
             reduced = r1 || r2;
             if (reduced) { return models; }
         }
@@ -1623,8 +1683,8 @@ namespace BlackCore
         {
             bool r1 = false;
             bool r2 = false;
-            CAircraftModelList models = ifPossibleReduceByAircraftOrFamily(remoteAircraft, UsePseudoFamily, inList, setup, QStringLiteral("Reduce by aircraft ICAO first."), r1, log);
-            models = ifPossibleReduceByAirline(remoteAircraft, models, setup, QStringLiteral("Reduce aircraft ICAO by airline second."), r2, log);
+            ModelIds models = ifPossibleReduceByAircraftOrFamily(remoteAircraft, UsePseudoFamily, index, inIds, setup, QStringLiteral("Reduce by aircraft ICAO first."), r1, log);
+            models = ifPossibleReduceByAirline(remoteAircraft, index, models, setup, QStringLiteral("Reduce aircraft ICAO by airline second."), r2, log);
 
             // not finding anything so far means we have no valid aircraft/airline ICAO combination
             // but it can happen we found B738, and for DLH there is no B738 but B737, so we search again
@@ -1638,12 +1698,12 @@ namespace BlackCore
 
                 bool r3 = false;
                 QString usedFamily;
-                CAircraftModelList models2nd = ifPossibleReduceByFamily(remoteAircraft, UsePseudoFamily, inList, r3, usedFamily, log);
-                models2nd = ifPossibleReduceByAirline(remoteAircraft, models2nd, setup, "Reduce family by airline second.", r3, log);
+                ModelIds models2nd = ifPossibleReduceByFamily(remoteAircraft, UsePseudoFamily, index, inIds, r3, usedFamily, log);
+                models2nd = ifPossibleReduceByAirline(remoteAircraft, index, models2nd, setup, "Reduce family by airline second.", r3, log);
                 if (r3)
                 {
                     // we found family / airline combination
-                    if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found " % QString::number(models2nd.sizeInt()) % " aircraft family/airline '" % usedFamily % u"' combination", getLogCategories()); }
+                    if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found " % QString::number(models2nd.size()) % " aircraft family/airline '" % usedFamily % u"' combination", getLogCategories()); }
                     return models2nd;
                 }
             }
@@ -1657,56 +1717,56 @@ namespace BlackCore
         }
 
         if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("No reduction by ICAO data"), getLogCategories()); }
-        return inList;
+        return inIds;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByFamily(const CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const CAircraftModelList &inList, bool &reduced, QString &usedFamily, CStatusMessageList *log)
+    CAircraftMatcher::ModelIds CAircraftMatcher::ifPossibleReduceByFamily(const CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const CAircraftModelSetIndex &index, const ModelIds &inIds, bool &reduced, QString &usedFamily, CStatusMessageList *log)
     {
         reduced = false;
         usedFamily = remoteAircraft.getAircraftIcaoCode().getFamily();
         if (!usedFamily.isEmpty())
         {
-            CAircraftModelList matchedModels = ifPossibleReduceByFamily(remoteAircraft, usedFamily, allowPseudoFamily, inList, QStringLiteral("real family from ICAO"), reduced, log);
+            ModelIds matchedModels = ifPossibleReduceByFamily(remoteAircraft, usedFamily, allowPseudoFamily, index, inIds, QStringLiteral("real family from ICAO"), reduced, log);
             if (reduced) { return matchedModels; }
         }
 
         // scenario: the ICAO actually is the family
         usedFamily = remoteAircraft.getAircraftIcaoCodeDesignator();
-        return ifPossibleReduceByFamily(remoteAircraft, usedFamily, allowPseudoFamily, inList, QStringLiteral("ICAO treated as family"), reduced, log);
+        return ifPossibleReduceByFamily(remoteAircraft, usedFamily, allowPseudoFamily, index, inIds, QStringLiteral("ICAO treated as family"), reduced, log);
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByFamily(const CSimulatedAircraft &remoteAircraft, const QString &family, bool allowPseudoFamily, const CAircraftModelList &inList, const QString &hint, bool &reduced, CStatusMessageList *log)
+    CAircraftMatcher::ModelIds CAircraftMatcher::ifPossibleReduceByFamily(const CSimulatedAircraft &remoteAircraft, const QString &family, bool allowPseudoFamily, const CAircraftModelSetIndex &index, const ModelIds &inIds, const QString &hint, bool &reduced, CStatusMessageList *log)
     {
         // Use an algorithm to find the best match
         reduced = false;
         if (family.isEmpty() && !allowPseudoFamily)
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"No family, skipping step (" % hint % u")", getLogCategories()); }
-            return inList;
+            return inIds;
         }
 
-        if (inList.isEmpty())
+        if (inIds.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"No models for family match (" % hint % u")", getLogCategories()); }
-            return inList;
+            return inIds;
         }
 
-        CAircraftModelList foundByFamily(inList.findByFamily(family));
+        ModelIds foundByFamily = CAircraftModelSetIndex::intersect(inIds, index.findByFamily(family));
         if (foundByFamily.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Not found by family '" % family % u"' (" % hint % ")"); }
-            if (!allowPseudoFamily) { return inList; }
+            if (!allowPseudoFamily) { return inIds; }
             // fallthru
         }
         else
         {
-            if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by family '" % family % u"' (" % hint % u") size " % QString::number(foundByFamily.sizeInt()), getLogCategories()); }
+            if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by family '" % family % u"' (" % hint % u") size " % QString::number(foundByFamily.size()), getLogCategories()); }
         }
 
-        CAircraftModelList foundByCM;
+        ModelIds foundByCM;
         if (allowPseudoFamily)
         {
-            foundByCM = inList.findByCombinedAndManufacturer(remoteAircraft.getAircraftIcaoCode());
+            foundByCM = CAircraftModelSetIndex::intersect(inIds, index.findByCombinedAndManufacturer(remoteAircraft.getAircraftIcaoCode()));
             const QString pseudo = remoteAircraft.getAircraftIcaoCode().getCombinedType() % "/" % remoteAircraft.getAircraftIcaoCode().getManufacturer();
             if (foundByCM.isEmpty())
             {
@@ -1714,42 +1774,41 @@ namespace BlackCore
             }
             else
             {
-                if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by pseudo family '" % pseudo % u"' (" % hint % u") size " % QString::number(foundByCM.sizeInt()), getLogCategories()); }
+                if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by pseudo family '" % pseudo % u"' (" % hint % u") size " % QString::number(foundByCM.size()), getLogCategories()); }
             }
         }
 
-        if (foundByCM.isEmpty() && foundByFamily.isEmpty()) { return inList; }
+        if (foundByCM.isEmpty() && foundByFamily.isEmpty()) { return inIds; }
         reduced = true;
 
         // avoid dpulicates, then add
-        if (!foundByFamily.isEmpty()) { foundByCM.removeModelsWithString(foundByFamily.getModelStringList(), Qt::CaseInsensitive); }
-        foundByFamily.push_back(foundByCM);
+        foundByFamily = CAircraftModelSetIndex::unite(foundByFamily, foundByCM);
 
-        if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by family (totally) '" % family % u"' (" % hint % u") size " % QString::number(foundByFamily.sizeInt()), getLogCategories()); }
+        if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by family (totally) '" % family % u"' (" % hint % u") size " % QString::number(foundByFamily.size()), getLogCategories()); }
         return foundByFamily;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByManufacturer(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const QString &info, bool &reduced, CStatusMessageList *log)
+    CAircraftMatcher::ModelIds CAircraftMatcher::ifPossibleReduceByManufacturer(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const ModelIds &inIds, const QString &info, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
-        if (inList.isEmpty())
+        if (inIds.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Empty input list, cannot reduce", getLogCategories()); }
-            return inList;
+            return inIds;
         }
 
         const QString m = remoteAircraft.getAircraftIcaoCode().getManufacturer();
         if (m.isEmpty())
         {
-            if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" No manufacturer, cannot reduce " % QString::number(inList.size()) %  u" entries", getLogCategories()); }
-            return inList;
+            if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" No manufacturer, cannot reduce " % QString::number(inIds.size()) %  u" entries", getLogCategories()); }
+            return inIds;
         }
 
-        const CAircraftModelList outList(inList.findByManufacturer(m));
+        const ModelIds outList = CAircraftModelSetIndex::intersect(inIds, index.findByManufacturer(m));
         if (outList.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Not found '" % m % u"', cannot reduce", getLogCategories()); }
-            return inList;
+            return inIds;
         }
 
         if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Reduced by '" % m % u"' results: " % QString::number(outList.size()), getLogCategories()); }
@@ -1785,26 +1844,26 @@ namespace BlackCore
         return outList;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByAircraft(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const QString &info, bool &reduced, CStatusMessageList *log)
+    CAircraftMatcher::ModelIds CAircraftMatcher::ifPossibleReduceByAircraft(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const ModelIds &inIds, const QString &info, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
-        if (inList.isEmpty())
+        if (inIds.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % " Empty input list, cannot reduce", getLogCategories()); }
-            return inList;
+            return inIds;
         }
 
         if (!remoteAircraft.hasAircraftDesignator())
         {
-            if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % " No aircraft designator, cannot reduce " % QString::number(inList.size()) %  " entries", getLogCategories()); }
-            return inList;
+            if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % " No aircraft designator, cannot reduce " % QString::number(inIds.size()) %  " entries", getLogCategories()); }
+            return inIds;
         }
 
-        const CAircraftModelList outList(inList.findByIcaoDesignators(remoteAircraft.getAircraftIcaoCode(), CAirlineIcaoCode::null()));
+        const ModelIds outList = CAircraftModelSetIndex::intersect(inIds, index.findByIcaoDesignators(remoteAircraft.getAircraftIcaoCode(), CAirlineIcaoCode::null()));
         if (outList.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Cannot reduce by '" % remoteAircraft.getAircraftIcaoCodeDesignator() % u"' results: " % QString::number(outList.size()), getLogCategories()); }
-            return inList;
+            return inIds;
         }
 
         if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Reduced by '" % remoteAircraft.getAircraftIcaoCodeDesignator() % u"' to " % QString::number(outList.size()), getLogCategories()); }
@@ -1812,46 +1871,46 @@ namespace BlackCore
         return outList;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByAircraftOrFamily(const CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const CAircraftModelList &inList,  const CAircraftMatcherSetup &setup, const QString &info, bool &reduced, CStatusMessageList *log)
+    CAircraftMatcher::ModelIds CAircraftMatcher::ifPossibleReduceByAircraftOrFamily(const CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const CAircraftModelSetIndex &index, const ModelIds &inIds, const CAircraftMatcherSetup &setup, const QString &info, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
-        const CAircraftModelList outList = ifPossibleReduceByAircraft(remoteAircraft, inList, info, reduced, log);
+        const ModelIds outList = ifPossibleReduceByAircraft(remoteAircraft, index, inIds, info, reduced, log);
         if (reduced || !setup.getMatchingMode().testFlag(CAircraftMatcherSetup::ByFamily)) { return outList; }
         QString family;
-        return ifPossibleReduceByFamily(remoteAircraft, allowPseudoFamily, inList, reduced, family, log);
+        return ifPossibleReduceByFamily(remoteAircraft, allowPseudoFamily, index, inIds, reduced, family, log);
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByAirline(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const CAircraftMatcherSetup &setup, const QString &info, bool &reduced, CStatusMessageList *log)
+    CAircraftMatcher::ModelIds CAircraftMatcher::ifPossibleReduceByAirline(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const ModelIds &inIds, const CAircraftMatcherSetup &setup, const QString &info, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
-        if (inList.isEmpty())
+        if (inIds.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Empty input list, cannot reduce", getLogCategories()); }
-            return inList;
+            return inIds;
         }
 
         if (!remoteAircraft.hasAirlineDesignator())
         {
-            if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" No airline designator, cannot reduce " % QString::number(inList.size()) %  u" entries", getLogCategories()); }
-            return inList;
+            if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" No airline designator, cannot reduce " % QString::number(inIds.size()) %  u" entries", getLogCategories()); }
+            return inIds;
         }
 
         CAircraftMatcherSetup::MatchingMode mode = setup.getMatchingMode();
-        CAircraftModelList outList(inList.findByIcaoDesignators(CAircraftIcaoCode::null(), remoteAircraft.getAirlineIcaoCode()));
+        ModelIds outList = CAircraftModelSetIndex::intersect(inIds, index.findByIcaoDesignators(CAircraftIcaoCode::null(), remoteAircraft.getAirlineIcaoCode()));
         if (
             mode.testFlag(CAircraftMatcherSetup::ByAirlineGroupSameAsAirline) ||
             (outList.isEmpty() || mode.testFlag(CAircraftMatcherSetup::ByAirlineGroupIfNoAirline)))
         {
             if (remoteAircraft.getAirlineIcaoCode().hasGroupMembership())
             {
-                const CAircraftModelList groupModels = inList.findByAirlineGroup(remoteAircraft.getAirlineIcaoCode());
-                outList.replaceOrAddModelsWithString(groupModels, Qt::CaseInsensitive);
+                const ModelIds groupModels = CAircraftModelSetIndex::intersect(inIds, index.findByAirlineGroup(remoteAircraft.getAirlineIcaoCode()));
+                outList = CAircraftModelSetIndex::replaceOrAdd(outList, groupModels); // group models at the end, as CAircraftModelList::replaceOrAddModelsWithString
                 if (log)
                 {
                     CMatchingUtils::addLogDetailsToList(log, remoteAircraft,
                                                         groupModels.isEmpty() ?
                                                         QStringLiteral("No group models found by using airline group '%1'").arg(remoteAircraft.getAirlineIcaoCode().getGroupDesignator()) :
-                                                        QStringLiteral("Added %1 model(s) by using airline group '%2', all members: '%3'").arg(groupModels.sizeInt()).arg(remoteAircraft.getAirlineIcaoCode().getGroupDesignator(), joinStringSet(groupModels.getAirlineVDesignators(), ", ")),
+                                                        QStringLiteral("Added %1 model(s) by using airline group '%2', all members: '%3'").arg(groupModels.size()).arg(remoteAircraft.getAirlineIcaoCode().getGroupDesignator(), joinStringSet(index.toModels(groupModels).getAirlineVDesignators(), ", ")),
                                                         getLogCategories());
                 }
             } // group membership
@@ -1860,7 +1919,7 @@ namespace BlackCore
         if (outList.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Cannot reduce by '" % remoteAircraft.getAirlineIcaoCodeDesignator() % u"' results: " % QString::number(outList.size()), getLogCategories()); }
-            return inList;
+            return inIds;
         }
 
         if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Reduced by '" % remoteAircraft.getAirlineIcaoCodeDesignator() % u"' to " % QString::number(outList.size()), getLogCategories()); }
@@ -1922,58 +1981,58 @@ namespace BlackCore
         **/
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByCombinedType(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const CAircraftMatcherSetup &setup, bool &reduced, CStatusMessageList *log)
+    CAircraftMatcher::ModelIds CAircraftMatcher::ifPossibleReduceByCombinedType(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const ModelIds &inIds, const CAircraftMatcherSetup &setup, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         if (!remoteAircraft.getAircraftIcaoCode().hasValidCombinedType())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("No valid combined code"), getLogCategories()); }
-            return inList;
+            return inIds;
         }
 
         const QString cc = remoteAircraft.getAircraftIcaoCode().getCombinedType();
-        CAircraftModelList modelsByCombinedCode(inList.findByCombinedType(cc));
+        ModelIds modelsByCombinedCode = CAircraftModelSetIndex::intersect(inIds, index.findByCombinedType(cc));
         if (modelsByCombinedCode.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Not found by combined code " % cc, getLogCategories()); }
-            return inList;
+            return inIds;
         }
 
         if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by combined code " % cc % u", possible " % QString::number(modelsByCombinedCode.size()), getLogCategories()); }
         if (modelsByCombinedCode.size() > 1)
         {
-            modelsByCombinedCode = ifPossibleReduceByAirline(remoteAircraft, modelsByCombinedCode, setup, QStringLiteral("Combined code airline reduction. "), reduced, log);
-            modelsByCombinedCode = ifPossibleReduceByManufacturer(remoteAircraft, modelsByCombinedCode, QStringLiteral("Combined code manufacturer reduction. "), reduced, log);
+            modelsByCombinedCode = ifPossibleReduceByAirline(remoteAircraft, index, modelsByCombinedCode, setup, QStringLiteral("Combined code airline reduction. "), reduced, log);
+            modelsByCombinedCode = ifPossibleReduceByManufacturer(remoteAircraft, index, modelsByCombinedCode, QStringLiteral("Combined code manufacturer reduction. "), reduced, log);
             reduced = true;
         }
         return modelsByCombinedCode;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByMilitaryFlag(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, bool &reduced, CStatusMessageList *log)
+    CAircraftMatcher::ModelIds CAircraftMatcher::ifPossibleReduceByMilitaryFlag(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const ModelIds &inIds, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         const bool military = remoteAircraft.getModel().isMilitary();
-        const CAircraftModelList byMilitaryFlag(inList.findByMilitaryFlag(military));
+        const ModelIds byMilitaryFlag = CAircraftModelSetIndex::intersect(inIds, index.findByMilitaryFlag(military));
         const QString mil(military ? "military" : "civilian");
         if (byMilitaryFlag.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Models not found by " % mil, getLogCategories()); }
-            return inList;
+            return inIds;
         }
 
         if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Models reduced to " % mil % u" aircraft, size " % QString::number(byMilitaryFlag.size()), getLogCategories()); }
         return byMilitaryFlag;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByVTOLFlag(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, bool &reduced, CStatusMessageList *log)
+    CAircraftMatcher::ModelIds CAircraftMatcher::ifPossibleReduceByVTOLFlag(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const ModelIds &inIds, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
-        if (!inList.containsVtol())
+        const ModelIds vtolModels = CAircraftModelSetIndex::intersect(inIds, index.findByVtolFlag(true));
+        if (vtolModels.isEmpty())
         {
             CMatchingUtils::addLogDetailsToList(log, remoteAircraft, "Cannot reduce to VTOL aircraft", getLogCategories());
-            return inList;
+            return inIds;
         }
-        CAircraftModelList vtolModels = inList.findByVtolFlag(true);
         if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Models reduced to " % QString::number(vtolModels.size()) % u" VTOL aircraft", getLogCategories()); }
         return vtolModels;
     }
@@ -16,6 +16,8 @@
 #include "blackmisc/simulation/aircraftmodelsetprovider.h"
 #include "blackmisc/simulation/aircraftmatchersetup.h"
 #include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/aircraftmodelsetindex.h"
+#include "blackmisc/simulation/simulatedaircraftlist.h"
 #include "blackmisc/simulation/matchingscriptmisc.h"
 #include "blackmisc/simulation/matchingstatistics.h"
 #include "blackmisc/simulation/matchinglog.h"
@@ -25,10 +27,13 @@
 #include "blackmisc/variant.h"
 
 #include <QFlags>
+#include <QMutex>
 #include <QObject>
 #include <QString>
 #include <QPair>
 #include <QSet>
+#include <QVector>
+#include <atomic>
 
 namespace BlackMisc
 {
@@ -86,6 +91,20 @@ namespace BlackCore
             BlackMisc::CStatusMessageList *log,
             bool useMatchingScript) const;
 
+        //! Get the closest matching models for many aircraft, matched in parallel against one snapshot of the model set.
+        //! Each model and log is the same as getClosestMatch yields for the aircraft.
+        //! \remark models and logs are in the order of remoteAircraft
+        //! \remark the calling thread blocks until all aircraft are matched, canceled is set or the application shuts down,
+        //!         aircraft not matched because of canceling get a default constructed model (no callsign)
+        //! \remark canceled is checked before each aircraft and can be set from any thread, an aircraft currently being matched is still completed
+        //! \threadsafe
+        BlackMisc::Simulation::CAircraftModelList getClosestMatches(
+            const BlackMisc::Simulation::CSimulatedAircraftList &remoteAircraft,
+            BlackMisc::Simulation::MatchingLog whatToLog,
+            QVector<BlackMisc::CStatusMessageList> *logs,
+            bool useMatchingScript,
+            const std::atomic_bool *canceled = nullptr) const;
+
         //! Return an valid airline ICAO code
         //! \threadsafe
         static BlackMisc::Aviation::CAirlineIcaoCode failoverValidAirlineIcaoDesignator(
@@ -273,6 +292,11 @@ namespace BlackCore
         //! Models
         bool hasModels() const { return !m_modelSet.isEmpty(); }
 
+        //! Index of the current model set, built on first use after the set has changed
+        //! \remark the returned index is immutable, it stays valid if the set changes meanwhile
+        //! \threadsafe
+        BlackMisc::Simulation::CAircraftModelSetIndexPtr getModelSetIndex() const;
+
         //! Set the models we want to use
         //! \note uses a set from "somewhere else" so it can also be used with arbitrary sets for testing
         int setModelSet(const BlackMisc::Simulation::CAircraftModelList &models, const BlackMisc::Simulation::CSimulatorInfo &simulator, bool forced);
@@ -310,12 +334,26 @@ namespace BlackCore
         void setupChanged();
 
     private:
+        //! Model ids in the model set index
+        using ModelIds = BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds;
+
+        //! The model set has changed, index needs to be rebuilt
+        void invalidateModelSetIndex();
+
         //! Save the disabled models if any
         bool saveDisabledForMatchingModels();
 
+        //! The matching for one aircraft, only using the passed snapshot data
+        //! \threadsafe
+        static BlackMisc::Simulation::CAircraftModel getClosestMatchImplementation(
+            const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft,
+            const BlackMisc::Simulation::CAircraftModelSetIndex &index, const BlackMisc::Simulation::CAircraftMatcherSetup &setup,
+            const BlackMisc::Simulation::CCategoryMatcher &categoryMatcher, const BlackMisc::Simulation::CAircraftModel &defaultModel,
+            BlackMisc::Simulation::MatchingLog whatToLog, BlackMisc::CStatusMessageList *log, bool useMatchingScript);
+
         //! The search based implementation
-        static BlackMisc::Simulation::CAircraftModelList getClosestMatchStepwiseReduceImplementation(
-            const BlackMisc::Simulation::CAircraftModelList &modelSet, const BlackMisc::Simulation::CAircraftMatcherSetup &setup,
+        static ModelIds getClosestMatchStepwiseReduceImplementation(
+            const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &modelSet, const BlackMisc::Simulation::CAircraftMatcherSetup &setup,
             const BlackMisc::Simulation::CCategoryMatcher &categoryMatcher, const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft,
             BlackMisc::Simulation::MatchingLog whatToLog, BlackMisc::CStatusMessageList *log = nullptr);
 
@@ -325,32 +363,32 @@ namespace BlackCore
         //! Get combined type default model, i.e. get a default model under consideration of the combined code such as "L2J"
         //! \see BlackMisc::Simulation::CSimulatedAircraft::getAircraftIcaoCombinedType
         //! \remark in any case a (default) model is returned
-        static BlackMisc::Simulation::CAircraftModel getCombinedTypeDefaultModel(const BlackMisc::Simulation::CAircraftModelList &modelSet, const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModel &defaultModel, BlackMisc::Simulation::MatchingLog whatToLog, BlackMisc::CStatusMessageList *log = nullptr);
+        static BlackMisc::Simulation::CAircraftModel getCombinedTypeDefaultModel(const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &modelSet, const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModel &defaultModel, BlackMisc::Simulation::MatchingLog whatToLog, BlackMisc::CStatusMessageList *log = nullptr);
 
         //! Search in models by key (aka model string)
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModel matchByExactModelString(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &models, BlackMisc::Simulation::MatchingLog whatToLog, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModel matchByExactModelString(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, BlackMisc::Simulation::MatchingLog whatToLog, BlackMisc::CStatusMessageList *log);
 
         //! Installed models by ICAO data
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByIcaoData(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &models, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static ModelIds ifPossibleReduceByIcaoData(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &inIds, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Find model by aircraft family
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByFamily(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const BlackMisc::Simulation::CAircraftModelList &inList, bool &reduced, QString &usedFamily, BlackMisc::CStatusMessageList *log);
+        static ModelIds ifPossibleReduceByFamily(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &inIds, bool &reduced, QString &usedFamily, BlackMisc::CStatusMessageList *log);
 
         //! Find model by aircraft family
         //! \remark pseudo family searches for same combined type and manufacturer
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByFamily(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const QString &family, bool allowPseudoFamily, const BlackMisc::Simulation::CAircraftModelList &inList, const QString &hint, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static ModelIds ifPossibleReduceByFamily(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const QString &family, bool allowPseudoFamily, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &inIds, const QString &hint, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Search for exact livery and aircraft ICAO code
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByLiveryAndAircraftIcaoCode(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static ModelIds ifPossibleReduceByLiveryAndAircraftIcaoCode(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &inIds, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Reduce by manufacturer
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByManufacturer(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static ModelIds ifPossibleReduceByManufacturer(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &inIds, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Reduce by manufacturer
         //! \threadsafe
@@ -358,15 +396,15 @@ namespace BlackCore
 
         //! Reduce by aircraft ICAO
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByAircraft(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static ModelIds ifPossibleReduceByAircraft(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &inIds, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Reduce by aircraft ICAO or family
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByAircraftOrFamily(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const BlackMisc::Simulation::CAircraftModelList &inList, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static ModelIds ifPossibleReduceByAircraftOrFamily(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &inIds, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Reduce by airline ICAO
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByAirline(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static ModelIds ifPossibleReduceByAirline(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &inIds, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Reduce by airline name/telephone designator
         //! \threadsafe
@@ -374,15 +412,15 @@ namespace BlackCore
 
         //! Installed models by combined code (ie L2J, L1P, ...)
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByCombinedType(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static ModelIds ifPossibleReduceByCombinedType(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &inIds, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! By military flag
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByMilitaryFlag(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static ModelIds ifPossibleReduceByMilitaryFlag(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &inIds, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! By VTOL flag
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByVTOLFlag(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static ModelIds ifPossibleReduceByVTOLFlag(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &inIds, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Scores to string for debugging
         //! \threadsafe
@@ -407,6 +445,8 @@ namespace BlackCore
         BlackMisc::Simulation::CMatchingStatistics   m_statistics;      //!< matching statistics
         BlackMisc::Simulation::CCategoryMatcher      m_categoryMatcher; //!< the category matcher
         QString                                      m_modelSetInfo;    //!< info string
+        mutable BlackMisc::Simulation::CAircraftModelSetIndexPtr m_modelSetIndex; //!< lazily built index of m_modelSet
+        mutable QMutex                                           m_modelSetIndexMutex; //!< guards m_modelSetIndex
     };
 } // namespace
 
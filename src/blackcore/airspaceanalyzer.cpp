@@ -12,6 +12,7 @@
 #include "blackmisc/aviation/callsign.h"
 #include "blackmisc/aviation/transponder.h"
 #include "blackmisc/logmessage.h"
+#include "blackmisc/range.h"
 #include "blackmisc/simulation/simulatedaircraftlist.h"
 #include "blackmisc/statusmessage.h"
 #include "blackmisc/threadutils.h"
@@ -22,6 +23,7 @@
 #include <QString>
 #include <QThread>
 #include <QWriteLocker>
+#include <algorithm>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Aviation;
@@ -156,6 +158,8 @@ namespace BlackCore
     {
         m_aircraftCallsignTimestamps.clear();
         m_atcCallsignTimestamps.clear();
+        m_callsignsByDistance.clear();
+        m_enabledInSnapshot.clear();
 
         QWriteLocker l(&m_lockSnapshot);
         m_latestAircraftSnapshot = CAirspaceAircraftSnapshot();
@@ -236,12 +240,13 @@ namespace BlackCore
         // remark for simulation snapshot is used when there are restrictions
         // nevertheless we calculate all the time as the snapshot could be used in other scenarios
 
-        CSimulatedAircraftList aircraftInRange(this->getAircraftInRange()); // thread safe copy from provider
-        CAirspaceAircraftSnapshot snapshot(
-            aircraftInRange,
+        const CSimulatedAircraftList aircraftInRange(this->getAircraftInRange()); // thread safe copy from provider
+        CAirspaceAircraftSnapshot snapshot = CAirspaceAircraftSnapshot::fromAircraftByDistance(
+            this->sortByDistanceIncrementally(aircraftInRange),
             restricted, enabled,
             maxAircraft, maxRenderedDistance
         );
+        this->setSnapshotDelta(snapshot);
 
         // lock block
         {
@@ -257,4 +262,86 @@ namespace BlackCore
 
         emit this->airspaceAircraftSnapshot(snapshot);
     }
+
+    CSimulatedAircraftList CAirspaceAnalyzer::sortByDistanceIncrementally(const CSimulatedAircraftList &aircraft)
+    {
+        // same order as CSimulatedAircraftList::sortByDistanceToReferencePositionRenderedCallsign
+        const auto lessThan = [](const CSimulatedAircraft * a, const CSimulatedAircraft * b)
+        {
+            if (a->getRelativeDistance() != b->getRelativeDistance()) { return a->getRelativeDistance() < b->getRelativeDistance(); }
+            if (a->isRendered() != b->isRendered()) { return a->isRendered(); } // get the rendered first
+            return a->getCallsignAsString() < b->getCallsignAsString();
+        };
+
+        QHash<CCallsign, int> indexByCallsign;
+        indexByCallsign.reserve(aircraft.size());
+        for (int i = 0; i < aircraft.size(); ++i) { indexByCallsign.insert(aircraft[i].getCallsign(), i); }
+
+        // previous order first, aircraft no longer in range are skipped, new aircraft are appended
+        QVector<const CSimulatedAircraft *> sorted;
+        sorted.reserve(aircraft.size());
+        for (const CCallsign &callsign : as_const(m_callsignsByDistance))
+        {
+            const auto it = indexByCallsign.find(callsign);
+            if (it == indexByCallsign.end() || it.value() < 0) { continue; }
+            sorted.push_back(&aircraft[it.value()]);
+            it.value() = -1; // taken
+        }
+        for (auto it = indexByCallsign.cbegin(); it != indexByCallsign.cend(); ++it)
+        {
+            if (it.value() >= 0) { sorted.push_back(&aircraft[it.value()]); }
+        }
+
+        // insertion sort is linear for an almost sorted order, if the order changed a lot (e.g. own aircraft moved far) sort again
+        const int maxShifts = 8 * sorted.size();
+        int shifts = 0;
+        for (int i = 1; i < sorted.size() && shifts <= maxShifts; ++i)
+        {
+            const CSimulatedAircraft *current = sorted[i];
+            int j = i;
+            for (; j > 0 && lessThan(current, sorted[j - 1]); --j) { sorted[j] = sorted[j - 1]; }
+            sorted[j] = current;
+            shifts += i - j;
+        }
+        if (shifts > maxShifts) { std::sort(sorted.begin(), sorted.end(), lessThan); }
+
+        CSimulatedAircraftList aircraftByDistance;
+        m_callsignsByDistance.clear();
+        m_callsignsByDistance.reserve(sorted.size());
+        for (const CSimulatedAircraft *a : as_const(sorted))
+        {
+            aircraftByDistance.push_back(*a);
+            m_callsignsByDistance.push_back(a->getCallsign());
+        }
+        return aircraftByDistance;
+    }
+
+    void CAirspaceAnalyzer::setSnapshotDelta(CAirspaceAircraftSnapshot &snapshot)
+    {
+        const CCallsignSet &all = snapshot.getAircraftCallsignsByDistance();
+        const CCallsignSet &enabled = snapshot.getEnabledAircraftCallsignsByDistance();
+
+        CCallsignSet added;
+        CCallsignSet renderingChanged;
+        QHash<CCallsign, bool> enabledInSnapshot;
+        enabledInSnapshot.reserve(all.size());
+        for (const CCallsign &callsign : all)
+        {
+            const bool isEnabled = enabled.contains(callsign);
+            enabledInSnapshot.insert(callsign, isEnabled);
+            const auto previous = m_enabledInSnapshot.constFind(callsign);
+            if (previous == m_enabledInSnapshot.cend()) { added.insert(callsign); }
+            else if (previous.value() != isEnabled) { renderingChanged.insert(callsign); }
+        }
+
+        CCallsignSet removed;
+        for (auto it = m_enabledInSnapshot.cbegin(); it != m_enabledInSnapshot.cend(); ++it)
+        {
+            if (!enabledInSnapshot.contains(it.key())) { removed.insert(it.key()); }
+        }
+
+        snapshot.setDelta(added, removed, renderingChanged);
+        snapshot.setVersion(++m_snapshotVersion);
+        m_enabledInSnapshot = enabledInSnapshot;
+    }
 } // ns
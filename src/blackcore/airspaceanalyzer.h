@@ -17,7 +17,10 @@
 #include "blackmisc/simulation/airspaceaircraftsnapshot.h"
 #include "blackmisc/simulation/ownaircraftprovider.h"
 #include "blackmisc/simulation/remoteaircraftprovider.h"
+#include "blackmisc/simulation/simulatedaircraftlist.h"
 #include "blackmisc/aviation/atcstation.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/callsignset.h"
 #include "blackmisc/geo/coordinategeodetic.h"
 #include "blackmisc/pq/frequency.h"
 #include "blackmisc/pq/length.h"
@@ -29,6 +32,7 @@
 #include <QObject>
 #include <QReadWriteLock>
 #include <QTimer>
+#include <QVector>
 #include <QtGlobal>
 #include <atomic>
 
@@ -37,7 +41,6 @@ namespace BlackMisc
     namespace Aviation
     {
         class CAircraftSituation;
-        class CCallsign;
         class CTransponder;
     }
 }
@@ -128,6 +131,13 @@ namespace BlackCore
         //! Analyze the airspace
         void analyzeAirspace();
 
+        //! Aircraft sorted by distance, starting from the order of the previous snapshot
+        //! \remark between two snapshots the order changes only a little, so this is almost linear
+        BlackMisc::Simulation::CSimulatedAircraftList sortByDistanceIncrementally(const BlackMisc::Simulation::CSimulatedAircraftList &aircraft);
+
+        //! Set the changes compared to the previous snapshot and remember the current state
+        void setSnapshotDelta(BlackMisc::Simulation::CAirspaceAircraftSnapshot &snapshot);
+
         // watchdog
         CCallsignTimestampSet m_aircraftCallsignTimestamps; //!< for watchdog (pilots)
         CCallsignTimestampSet m_atcCallsignTimestamps;      //!< for watchdog (ATC)
@@ -145,6 +155,11 @@ namespace BlackCore
         BlackMisc::PhysicalQuantities::CLength m_simulatorMaxRenderedDistance { 0.0, nullptr };
         mutable QReadWriteLock m_lockSnapshot;     //!< lock snapshot
         mutable QReadWriteLock m_lockRestrictions; //!< lock simulator restrictions
+
+        // incremental snapshot state, only used in the analyzer thread
+        QVector<BlackMisc::Aviation::CCallsign> m_callsignsByDistance;  //!< order of the previous snapshot
+        QHash<BlackMisc::Aviation::CCallsign, bool> m_enabledInSnapshot; //!< enabled state in the previous snapshot
+        qint64 m_snapshotVersion = 0;                                   //!< version of the latest snapshot
     };
 } // namespace
 
@@ -106,7 +106,7 @@ namespace BlackCore
 
         if (this->supportsVatsimDataFile())
         {
-            connect(sApp->getWebDataServices()->getVatsimDataFileReader(), &CVatsimDataFileReader::dataFileRead, this, &CAirspaceMonitor::onReceivedVatsimDataFile);
+            connect(sApp->getWebDataServices()->getVatsimDataFileReader(), &CVatsimDataFileReader::dataFileChanged, this, &CAirspaceMonitor::onReceivedVatsimDataFile);
         }
 
         // Force snapshot in the main event loop
@@ -590,22 +590,23 @@ namespace BlackCore
         emit this->changedAtcStationsBooked(); // treat as stations were changed
     }
 
-    void CAirspaceMonitor::onReceivedVatsimDataFile()
+    void CAirspaceMonitor::onReceivedVatsimDataFile(const VatsimDataFileChanges &changes)
     {
         Q_ASSERT(CThreadUtils::isInThisThread(this));
         if (!sApp || sApp->isShuttingDown() || !sApp->getWebDataServices()) { return; }
-        CClientList clients(this->getClients()); // copy
-        bool changed = false;
-        for (auto client = clients.begin(); client != clients.end(); ++client)
+
+        // voice capabilities are looked up when a client is added,
+        // afterwards they can only change for aircraft which are new or changed in the data file
+        const CCallsignSet callsigns = changes.addedOrChangedAircraft();
+        for (const CCallsign &callsign : callsigns)
         {
-            if (client->hasSpecifiedVoiceCapabilities()) { continue; } // we already have voice caps
-            const CVoiceCapabilities vc = sApp->getWebDataServices()->getVoiceCapabilityForCallsign(client->getCallsign());
+            const CClient client = this->getClientOrDefaultForCallsign(callsign);
+            if (client.getCallsign().isEmpty()) { continue; } // no such client
+            if (client.hasSpecifiedVoiceCapabilities()) { continue; } // we already have voice caps
+            const CVoiceCapabilities vc = sApp->getWebDataServices()->getVoiceCapabilityForCallsign(callsign);
             if (vc.isUnknown()) { continue; }
-            changed = true;
-            client->setVoiceCapabilities(vc);
+            this->updateOrAddClient(callsign, CPropertyIndexVariantMap(CClient::IndexVoiceCapabilities, CVariant::from(vc)), false);
         }
-        if (!changed) { return; }
-        this->setClients(clients);
     }
 
     CAirspaceMonitor::Readiness &CAirspaceMonitor::addMatchingReadinessFlag(const CCallsign &callsign, CAirspaceMonitor::MatchingReadinessFlag mrf)
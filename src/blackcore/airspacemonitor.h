@@ -54,6 +54,7 @@
 namespace BlackCore
 {
     namespace Fsd { class CFSDClient; }
+    namespace Vatsim { struct VatsimDataFileChanges; }
     class CAirspaceAnalyzer;
 
     //! Keeps track of other entities in the airspace: aircraft, ATC stations, etc.
@@ -441,7 +442,7 @@ namespace BlackCore
         void onFrequencyReceived(const BlackMisc::Aviation::CCallsign &callsign, const BlackMisc::PhysicalQuantities::CFrequency &frequency);
         void onReceivedAtcBookings(const BlackMisc::Aviation::CAtcStationList &bookedStations);
         void onReadUnchangedAtcBookings();
-        void onReceivedVatsimDataFile();
+        void onReceivedVatsimDataFile(const Vatsim::VatsimDataFileChanges &changes);
         void onAircraftConfigReceived(const BlackMisc::Aviation::CCallsign &callsign, const QJsonObject &jsonObject, qint64 currentOffsetMs);
         void onAircraftInterimUpdateReceived(const BlackMisc::Aviation::CAircraftSituation &situation);
         void onConnectionStatusChanged(BlackMisc::Network::CConnectionStatus oldStatus, BlackMisc::Network::CConnectionStatus newStatus);
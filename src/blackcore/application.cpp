@@ -381,6 +381,13 @@ namespace BlackCore
                 msgs.push_back(CLogMessage(this).debug() << "Cleared cache, " << files.size() << " files");
             }
 
+            // binary data cache?
+            if (this->isSet(m_cmdBinaryCache))
+            {
+                CDataCache::instance()->setBinaryFileFormat(true);
+                msgs.push_back(CLogMessage(this).info(u"Data cache is saved in binary format"));
+            }
+
             // crashpad dump
             if (this->isSet(m_cmdTestCrashpad))
             {
@@ -1042,6 +1049,11 @@ namespace BlackCore
                                              QCoreApplication::translate("application", "Clear (reset) the caches."));
         this->addParserOption(m_cmdClearCache);
 
+        // binary data cache
+        m_cmdBinaryCache = QCommandLineOption({ "bcache", "binarycache" },
+                                              QCoreApplication::translate("application", "Save the data cache in binary format."));
+        this->addParserOption(m_cmdBinaryCache);
+
         // test crashpad upload
         m_cmdTestCrashpad = QCommandLineOption({ "testcp", "testcrashpad" },
                                                QCoreApplication::translate("application", "Trigger crashpad situation."));
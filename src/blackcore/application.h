@@ -652,6 +652,7 @@ namespace BlackCore
         QCommandLineOption m_cmdDevelopment   {"dev"};          //!< Development flag
         QCommandLineOption m_cmdSharedDir     {"shared"};       //!< Shared directory
         QCommandLineOption m_cmdClearCache    {"clearcache"};   //!< Clear cache
+        QCommandLineOption m_cmdBinaryCache   {"binarycache"};  //!< Save data cache in binary format
         QCommandLineOption m_cmdTestCrashpad  {"testcrashpad"}; //!< Test a crasphpad upload
         QCommandLineOption m_cmdSkipSingleApp {"skipsa"};       //!< Skip test for single application
         bool               m_parsed    = false;                 //!< Parsing accomplished?
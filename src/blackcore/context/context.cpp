@@ -8,6 +8,7 @@
 
 #include "blackcore/context/context.h"
 #include "blackcore/application.h"
+#include "blackmisc/dbusblobcall.h"
 #include "blackmisc/logcategorylist.h"
 
 using namespace BlackMisc;
@@ -87,6 +88,11 @@ namespace BlackCore
             return m_debugEnabled;
         }
 
+        QByteArray IContext::invokeSlotAsBlob(const QString &slotName, const QByteArray &packedArguments)
+        {
+            return CDBusBlobCall::invoke(this, slotName, packedArguments);
+        }
+
         void IContext::relayBaseClassSignals(const QString &serviceName, QDBusConnection &connection, const QString &objectPath, const QString &interfaceName)
         {
             bool s = connection.connect(serviceName, objectPath, interfaceName,
@@ -18,6 +18,7 @@
 #include "blackmisc/logmessage.h"
 #include "blackmisc/statusmessage.h"
 
+#include <QByteArray>
 #include <QDateTime>
 #include <QObject>
 #include <QString>
@@ -139,6 +140,11 @@ namespace BlackCore
             //! Log or debug values changed
             void changedLogOrDebugSettings();
 
+        public slots:
+            //! Call a slot of this context, arguments and return value as QDataStream blobs
+            //! \remark used by the proxies for large return values, see BlackMisc::CGenericDBusInterface::callDBusRetBlob
+            QByteArray invokeSlotAsBlob(const QString &slotName, const QByteArray &packedArguments);
+
         protected:
             CCoreFacadeConfig::ContextMode m_mode; //!< How context is used
             qint64 m_contextId;                    //!< unique identifer, avoid redirection rountrips
@@ -111,6 +111,10 @@ namespace BlackCore
             //! Read for model matching
             void readyForModelMatching(const BlackMisc::Simulation::CSimulatedAircraft &renderedAircraft);
 
+            //! Several aircraft ready for model matching at once, e.g. after login
+            //! \remark only emitted locally, to be matched in one batch
+            void readyForModelMatchingList(const BlackMisc::Simulation::CSimulatedAircraftList &remoteAircraft);
+
             //! ATC station (online) list has been changed
             void changedAtcStationsOnline();
 
@@ -141,6 +141,12 @@ namespace BlackCore
             return m_airspace->remoteAircraftSituations(callsign);
         }
 
+        QVector<CCompactSituation> CContextNetwork::remoteAircraftCompactSituations(const CCallsign &callsign) const
+        {
+            if (!this->canUseAirspaceMonitor()) { return {}; }
+            return m_airspace->remoteAircraftCompactSituations(callsign);
+        }
+
         CAircraftSituation CContextNetwork::remoteAircraftSituation(const Aviation::CCallsign &callsign, int index) const
         {
             if (!this->canUseAirspaceMonitor()) { return {}; }
@@ -705,9 +711,22 @@ namespace BlackCore
             if (m_readyForModelMatching.isEmpty()) { return; }
             if (!sApp || sApp->isShuttingDown())   { return; }
 
-            const CSimulatedAircraft aircraft = m_readyForModelMatching.dequeue();
-            if (!this->isAircraftInRange(aircraft.getCallsign())) { return; }
-            emit this->readyForModelMatching(aircraft);
+            CSimulatedAircraftList aircraft;
+            while (!m_readyForModelMatching.isEmpty())
+            {
+                const CSimulatedAircraft queued = m_readyForModelMatching.dequeue();
+                if (!this->isAircraftInRange(queued.getCallsign())) { continue; }
+                aircraft.push_back(queued);
+            }
+
+            if (aircraft.size() == 1)
+            {
+                emit this->readyForModelMatching(aircraft.front());
+            }
+            else if (aircraft.size() > 1)
+            {
+                emit this->readyForModelMatchingList(aircraft);
+            }
         }
 
         void CContextNetwork::createRelayMessageToPartnerCallsign(const CTextMessage &textMessage, const CCallsign &partnerCallsign, CTextMessageList &relayedMessages)
@@ -98,6 +98,7 @@ namespace BlackCore
             //! \ingroup remoteaircraftprovider
             //! @{
             virtual BlackMisc::Aviation::CAircraftSituationList remoteAircraftSituations(const BlackMisc::Aviation::CCallsign &callsign) const override;
+            virtual QVector<BlackMisc::Aviation::CCompactSituation> remoteAircraftCompactSituations(const BlackMisc::Aviation::CCallsign &callsign) const override;
             virtual BlackMisc::Aviation::CAircraftSituation remoteAircraftSituation(const BlackMisc::Aviation::CCallsign &callsign, int index) const override;
             virtual BlackMisc::MillisecondsMinMaxMean remoteAircraftSituationsTimestampDifferenceMinMaxMean(const BlackMisc::Aviation::CCallsign &callsign) const override;
             virtual BlackMisc::Aviation::CAircraftSituationList latestRemoteAircraftSituations() const override;
@@ -339,6 +340,7 @@ namespace BlackCore
             void onReadyForModelMatching(const BlackMisc::Simulation::CSimulatedAircraft &aircraft);
 
             //! Emit ready for matching
+            //! \remark all aircraft queued meanwhile are emitted together, so a burst is matched as one batch
             void emitReadyForMatching();
 
             //! Relay to partner callsign
@@ -109,22 +109,22 @@ namespace BlackCore
 
         CAtcStationList CContextNetworkProxy::getAtcStationsOnline(bool recalculateDistance) const
         {
-            return m_dBusInterface->callDBusRet<BlackMisc::Aviation::CAtcStationList>(QLatin1String("getAtcStationsOnline"), recalculateDistance);
+            return m_dBusInterface->callDBusRetBlob<BlackMisc::Aviation::CAtcStationList>(QLatin1String("getAtcStationsOnline"), recalculateDistance);
         }
 
         CAtcStationList CContextNetworkProxy::getClosestAtcStationsOnline(int number) const
         {
-            return m_dBusInterface->callDBusRet<BlackMisc::Aviation::CAtcStationList>(QLatin1String("getClosestAtcStationsOnline"), number);
+            return m_dBusInterface->callDBusRetBlob<BlackMisc::Aviation::CAtcStationList>(QLatin1String("getClosestAtcStationsOnline"), number);
         }
 
         CAtcStationList CContextNetworkProxy::getAtcStationsBooked(bool recalculateDistance) const
         {
-            return m_dBusInterface->callDBusRet<BlackMisc::Aviation::CAtcStationList>(QLatin1String("getAtcStationsBooked"), recalculateDistance);
+            return m_dBusInterface->callDBusRetBlob<BlackMisc::Aviation::CAtcStationList>(QLatin1String("getAtcStationsBooked"), recalculateDistance);
         }
 
         CSimulatedAircraftList CContextNetworkProxy::getAircraftInRange() const
         {
-            return m_dBusInterface->callDBusRet<BlackMisc::Simulation::CSimulatedAircraftList>(QLatin1String("getAircraftInRange"));
+            return m_dBusInterface->callDBusRetBlob<BlackMisc::Simulation::CSimulatedAircraftList>(QLatin1String("getAircraftInRange"));
         }
 
         CCallsignSet CContextNetworkProxy::getAircraftInRangeCallsigns() const
@@ -164,7 +164,7 @@ namespace BlackCore
 
         CUserList CContextNetworkProxy::getUsers() const
         {
-            return m_dBusInterface->callDBusRet<BlackMisc::Network::CUserList>(QLatin1String("getUsers"));
+            return m_dBusInterface->callDBusRetBlob<BlackMisc::Network::CUserList>(QLatin1String("getUsers"));
         }
 
         CUserList CContextNetworkProxy::getUsersForCallsigns(const BlackMisc::Aviation::CCallsignSet &callsigns) const
@@ -179,12 +179,12 @@ namespace BlackCore
 
         CClientList CContextNetworkProxy::getClients() const
         {
-            return m_dBusInterface->callDBusRet<BlackMisc::Network::CClientList>(QLatin1String("getClients"));
+            return m_dBusInterface->callDBusRetBlob<BlackMisc::Network::CClientList>(QLatin1String("getClients"));
         }
 
         CServerList CContextNetworkProxy::getVatsimFsdServers() const
         {
-            return m_dBusInterface->callDBusRet<BlackMisc::Network::CServerList>(QLatin1String("getVatsimFsdServers"));
+            return m_dBusInterface->callDBusRetBlob<BlackMisc::Network::CServerList>(QLatin1String("getVatsimFsdServers"));
         }
 
         CServerList CContextNetworkProxy::getVatsimVoiceServers() const
@@ -688,8 +688,44 @@ namespace BlackCore
             MatchingLog whatToLog = m_logMatchingMessages;
             CStatusMessageList matchingMessages;
             CStatusMessageList *pMatchingMessages = m_logMatchingMessages > 0 ? &matchingMessages : nullptr;
-            CAircraftModel aircraftModel = m_aircraftMatcher.getClosestMatch(remoteAircraft, whatToLog, pMatchingMessages, true);
-            Q_ASSERT_X(remoteAircraft.getCallsign() == aircraftModel.getCallsign(), Q_FUNC_INFO, "Mismatching callsigns");
+            const CAircraftModel aircraftModel = m_aircraftMatcher.getClosestMatch(remoteAircraft, whatToLog, pMatchingMessages, true);
+            this->addMatchedRemoteAircraft(remoteAircraft, aircraftModel, matchingMessages);
+        }
+
+        void CContextSimulator::xCtxAddedRemoteAircraftListReadyForModelMatching(const CSimulatedAircraftList &remoteAircraft)
+        {
+            if (!this->isSimulatorPluginAvailable()) { return; }
+
+            CSimulatedAircraftList aircraft(remoteAircraft);
+            const int emptyCallsigns = aircraft.removeIf([](const CSimulatedAircraft &a) { return a.getCallsign().isEmpty(); });
+            BLACK_VERIFY_X(emptyCallsigns == 0, Q_FUNC_INFO, "Remote aircraft with empty callsign");
+            this->matchAndAddRemoteAircraft(aircraft);
+        }
+
+        void CContextSimulator::matchAndAddRemoteAircraft(const CSimulatedAircraftList &remoteAircraft)
+        {
+            if (remoteAircraft.isEmpty()) { return; }
+
+            // a new batch, a cancel for an earlier batch does not apply
+            m_cancelMatching = false;
+            QVector<CStatusMessageList> matchingMessages;
+            QVector<CStatusMessageList> *pMatchingMessages = m_logMatchingMessages > 0 ? &matchingMessages : nullptr;
+            const CAircraftModelList matchedModels = m_aircraftMatcher.getClosestMatches(remoteAircraft, m_logMatchingMessages, pMatchingMessages, true, &m_cancelMatching);
+            for (int i = 0; i < remoteAircraft.size(); i++)
+            {
+                if (!this->isSimulatorPluginAvailable()) { break; }
+                if (matchedModels[i].getCallsign().isEmpty()) { continue; } // canceled or shutting down
+                CStatusMessageList noMessages;
+                this->addMatchedRemoteAircraft(remoteAircraft[i], matchedModels[i], pMatchingMessages ? matchingMessages[i] : noMessages);
+            }
+        }
+
+        void CContextSimulator::addMatchedRemoteAircraft(const CSimulatedAircraft &remoteAircraft, const CAircraftModel &matchedModel, CStatusMessageList &matchingMessages)
+        {
+            const CCallsign callsign = remoteAircraft.getCallsign();
+            CStatusMessageList *pMatchingMessages = m_logMatchingMessages > 0 ? &matchingMessages : nullptr;
+            CAircraftModel aircraftModel = matchedModel;
+            Q_ASSERT_X(callsign == aircraftModel.getCallsign(), Q_FUNC_INFO, "Mismatching callsigns");
 
             // decide CG
             const CLength cgModel = aircraftModel.getCG();
@@ -762,13 +798,10 @@ namespace BlackCore
                 Q_ASSERT_X(networkContext, Q_FUNC_INFO, "Need context");
                 Q_ASSERT_X(networkContext->isLocalObject(), Q_FUNC_INFO, "Need local object");
 
-                // initially add aircraft
-                const CSimulatedAircraftList aircraft = networkContext->getAircraftInRange();
-                for (const CSimulatedAircraft &simulatedAircraft : aircraft)
-                {
-                    BLACK_VERIFY_X(!simulatedAircraft.getCallsign().isEmpty(), Q_FUNC_INFO, "Need callsign");
-                    this->xCtxAddedRemoteAircraftReadyForModelMatching(simulatedAircraft);
-                }
+                // initially add aircraft, matched in parallel as this can be a lot of aircraft
+                CSimulatedAircraftList aircraft = networkContext->getAircraftInRange();
+                aircraft.removeIf([](const CSimulatedAircraft &a) { return a.getCallsign().isEmpty(); });
+                this->matchAndAddRemoteAircraft(aircraft);
                 m_initallyAddAircraft = false;
             }
 
@@ -43,6 +43,7 @@
 #include <QPair>
 #include <QString>
 #include <QPointer>
+#include <atomic>
 
 // clazy:excludeall=const-signal-or-slot
 
@@ -195,6 +196,13 @@ namespace BlackCore
             //! Remote aircraft added and ready for model matching
             void xCtxAddedRemoteAircraftReadyForModelMatching(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft);
 
+            //! Several remote aircraft added and ready for model matching, matched as one batch
+            void xCtxAddedRemoteAircraftListReadyForModelMatching(const BlackMisc::Simulation::CSimulatedAircraftList &remoteAircraft);
+
+            //! Cancel a batch model matching in progress, e.g. as the network is disconnecting
+            //! \threadsafe called directly in the thread where the network connection status changes
+            void xCtxCancelModelMatching() { m_cancelMatching = true; }
+
             //! Remove remote aircraft
             void xCtxRemovedRemoteAircraft(const BlackMisc::Aviation::CCallsign &callsign);
 
@@ -263,6 +271,13 @@ namespace BlackCore
             //! Call stop() on all loaded listeners
             void stopSimulatorListeners();
 
+            //! Match the remote aircraft in one batch and add them to the simulator
+            //! \sa CAircraftMatcher::getClosestMatches
+            void matchAndAddRemoteAircraft(const BlackMisc::Simulation::CSimulatedAircraftList &remoteAircraft);
+
+            //! Apply the matched model and logically add the remote aircraft to the simulator
+            void addMatchedRemoteAircraft(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModel &matchedModel, BlackMisc::CStatusMessageList &matchingMessages);
+
             //! Add to message list for matching
             void addMatchingMessages(const BlackMisc::Aviation::CCallsign &callsign, const BlackMisc::CStatusMessageList &messages);
 
@@ -288,6 +303,7 @@ namespace BlackCore
 
             bool m_wasSimulating          = false;
             bool m_initallyAddAircraft    = false;
+            std::atomic_bool m_cancelMatching { false }; //!< cancels a batch matching in progress
             bool m_isWeatherActivated     = false; // used to activate after plugin is loaded
             BlackMisc::Simulation::MatchingLog m_logMatchingMessages = BlackMisc::Simulation::MatchingLogSimplified;
 
@@ -130,12 +130,12 @@ namespace BlackCore
 
         CAirportList CContextSimulatorProxy::getAirportsInRange(bool recalculatePosition) const
         {
-            return m_dBusInterface->callDBusRet<CAirportList>(QLatin1String("getAirportsInRange"), recalculatePosition);
+            return m_dBusInterface->callDBusRetBlob<CAirportList>(QLatin1String("getAirportsInRange"), recalculatePosition);
         }
 
         CAircraftModelList CContextSimulatorProxy::getModelSet() const
         {
-            return m_dBusInterface->callDBusRet<CAircraftModelList>(QLatin1String("getModelSet"));
+            return m_dBusInterface->callDBusRetBlob<CAircraftModelList>(QLatin1String("getModelSet"));
         }
 
         CSimulatorInfo CContextSimulatorProxy::simulatorsWithInitializedModelSet() const
@@ -160,12 +160,12 @@ namespace BlackCore
 
         QStringList CContextSimulatorProxy::getModelSetStrings() const
         {
-            return m_dBusInterface->callDBusRet<QStringList>(QLatin1String("getModelSetStrings"));
+            return m_dBusInterface->callDBusRetBlob<QStringList>(QLatin1String("getModelSetStrings"));
         }
 
         QStringList CContextSimulatorProxy::getModelSetCompleterStrings(bool sorted) const
         {
-            return m_dBusInterface->callDBusRet<QStringList>(QLatin1String("getModelSetCompleterStrings"), sorted);
+            return m_dBusInterface->callDBusRetBlob<QStringList>(QLatin1String("getModelSetCompleterStrings"), sorted);
         }
 
         int CContextSimulatorProxy::removeModelsFromSet(const CAircraftModelList &removeModels)
@@ -180,7 +180,7 @@ namespace BlackCore
 
         CAircraftModelList CContextSimulatorProxy::getModelSetModelsStartingWith(const QString &modelString) const
         {
-            return m_dBusInterface->callDBusRet<CAircraftModelList>(QLatin1String("getModelSetModelsStartingWith"), modelString);
+            return m_dBusInterface->callDBusRetBlob<CAircraftModelList>(QLatin1String("getModelSetModelsStartingWith"), modelString);
         }
 
         int CContextSimulatorProxy::getModelSetCount() const
@@ -205,7 +205,7 @@ namespace BlackCore
 
         CAircraftModelList CContextSimulatorProxy::getDisabledModelsForMatching() const
         {
-            return m_dBusInterface->callDBusRet<CAircraftModelList>(QLatin1String("getDisabledModelsForMatching"));
+            return m_dBusInterface->callDBusRetBlob<CAircraftModelList>(QLatin1String("getDisabledModelsForMatching"));
         }
 
         bool CContextSimulatorProxy::triggerModelSetValidation(const CSimulatorInfo &simulator)
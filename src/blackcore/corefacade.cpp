@@ -24,6 +24,7 @@
 #include "blackcore/corefacadeconfig.h"
 #include "blackcore/registermetadata.h"
 #include "blackcore/airspacemonitor.h"
+#include "blackcore/fsd/fsdclient.h"
 #include "blackmisc/dbusserver.h"
 #include "blackmisc/identifier.h"
 #include "blackmisc/logmessage.h"
@@ -239,6 +240,18 @@ namespace BlackCore
                 c = connect(m_contextNetwork, &IContextNetwork::readyForModelMatching,
                             this->getCContextSimulator(), &CContextSimulator::xCtxAddedRemoteAircraftReadyForModelMatching, Qt::QueuedConnection);
                 Q_ASSERT(c);
+                c = connect(m_contextNetwork, &IContextNetwork::readyForModelMatchingList,
+                            this->getCContextSimulator(), &CContextSimulator::xCtxAddedRemoteAircraftListReadyForModelMatching, Qt::QueuedConnection);
+                Q_ASSERT(c);
+
+                // batch matching blocks the simulator context's thread, so a logout has to cancel it directly from the FSD thread
+                CContextSimulator *simulatorContext = this->getCContextSimulator();
+                c = connect(this->getCContextNetwork()->fsdClient(), &Fsd::CFSDClient::connectionStatusChanged, simulatorContext,
+                            [simulatorContext](const BlackMisc::Network::CConnectionStatus &, const BlackMisc::Network::CConnectionStatus &to)
+                {
+                    if (to.isDisconnecting() || to.isDisconnected()) { simulatorContext->xCtxCancelModelMatching(); }
+                }, Qt::DirectConnection);
+                Q_ASSERT(c);
                 c = connect(m_contextNetwork, &IContextNetwork::removedAircraft,
                             this->getCContextSimulator(), &CContextSimulator::xCtxRemovedRemoteAircraft, Qt::QueuedConnection);
                 Q_ASSERT(c);
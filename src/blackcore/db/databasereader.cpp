@@ -17,6 +17,7 @@
 #include "blackmisc/network/entityflags.h"
 #include "blackmisc/swiftdirectories.h"
 #include "blackmisc/directoryutils.h"
+#include "blackmisc/fileutils.h"
 #include "blackmisc/logcategory.h"
 #include "blackmisc/logcategorylist.h"
 #include "blackmisc/logmessage.h"
@@ -673,6 +674,19 @@ namespace BlackCore
             }
         }
 
+        QString CDatabaseReader::jsonFileToRead(const QString &directory, CEntityFlags::Entity entity, const QString &fileName, bool overrideNewerOnly, CStatusMessageList &msgs) const
+        {
+            const QString filePath = CFileUtils::appendFilePaths(directory, fileName);
+            const QFileInfo fi(filePath);
+            if (!fi.exists())
+            {
+                msgs.push_back(CStatusMessage(this).warning(u"File '%1' does not exist") << filePath);
+                return {};
+            }
+            if (!this->overrideCacheFromFile(overrideNewerOnly, fi, entity, msgs)) { return {}; }
+            return filePath;
+        }
+
         void CDatabaseReader::logParseMessage(const QString &entity, int size, int msElapsed, const CDatabaseReader::JsonDatastoreResponse &response) const
         {
             CLogMessage(this).info(u"Parsed %1 %2 in %3ms, thread %4 | '%5'")
@@ -425,6 +425,11 @@ namespace BlackCore
             //! \threadsafe
             bool overrideCacheFromFile(bool overrideNewerOnly, const QFileInfo &fileInfo, BlackMisc::Network::CEntityFlags::Entity entity, BlackMisc::CStatusMessageList &msgs) const;
 
+            //! File of an entity to be read from a shared files directory, empty if missing or not overriding the cache
+            //! \remark checked for all entities before reading, so the files can be read ahead, see CDatabaseFilesReadAhead
+            //! \threadsafe
+            QString jsonFileToRead(const QString &directory, BlackMisc::Network::CEntityFlags::Entity entity, const QString &fileName, bool overrideNewerOnly, BlackMisc::CStatusMessageList &msgs) const;
+
             //! Parsing info message
             void logParseMessage(const QString &entity, int size, int msElapsed, const JsonDatastoreResponse &response) const;
 
@@ -459,6 +459,44 @@ namespace BlackCore
             return CDatabaseUtils::readQJsonObjectFromDatabaseFile(CFileUtils::appendFilePaths(directory, filename));
         }
 
+        CDatabaseFilesReadAhead::CDatabaseFilesReadAhead(const QStringList &fileNames) :
+            m_fileNames(fileNames.size() > 1 ? fileNames : QStringList()) // a single file is just read when taken
+        {
+            if (m_fileNames.isEmpty()) { return; }
+            m_thread.reset(QThread::create([this] { this->readFiles(); }));
+            m_thread->setObjectName("CDatabaseFilesReadAhead");
+            m_thread->start();
+        }
+
+        CDatabaseFilesReadAhead::~CDatabaseFilesReadAhead()
+        {
+            if (!m_thread) { return; }
+            m_stop = true;
+            m_thread->wait();
+        }
+
+        QJsonObject CDatabaseFilesReadAhead::take(const QString &fileName)
+        {
+            if (!m_fileNames.contains(fileName)) { return CDatabaseUtils::readQJsonObjectFromDatabaseFile(fileName); }
+
+            QMutexLocker lock(&m_mutex);
+            while (!m_objects.contains(fileName)) { m_fileRead.wait(&m_mutex); }
+            return m_objects.take(fileName);
+        }
+
+        void CDatabaseFilesReadAhead::readFiles()
+        {
+            for (const QString &fileName : m_fileNames)
+            {
+                if (m_stop) { break; }
+                const QJsonObject object = CDatabaseUtils::readQJsonObjectFromDatabaseFile(fileName);
+
+                QMutexLocker lock(&m_mutex);
+                m_objects.insert(fileName, object);
+                m_fileRead.wakeAll();
+            }
+        }
+
         bool CDatabaseUtils::hasDbAircraftData()
         {
             return sApp && sApp->hasWebDataServices() && sApp->getWebDataServices()->hasDbAircraftData();
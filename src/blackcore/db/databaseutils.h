@@ -21,6 +21,13 @@
 #include <QByteArray>
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QHash>
+#include <QMutex>
+#include <QStringList>
+#include <QThread>
+#include <QWaitCondition>
+#include <atomic>
+#include <memory>
 
 namespace BlackCore
 {
@@ -119,6 +126,40 @@ namespace BlackCore
             //! \sa CAutoPublishData::analyzeAgainstDBData
             static BlackMisc::Simulation::ChangedAutoPublishData autoPublishDataChanged(const BlackMisc::Simulation::CAircraftModel &model, const BlackMisc::PhysicalQuantities::CLength &cg, const BlackMisc::Simulation::CSimulatorInfo &simulator);
         };
+
+        //! Reads and parses database JSON files (normally shared files) in a background thread, in the given order,
+        //! so the next file is read while the previous one is decoded
+        //! \remark like CDatabaseUtils::readQJsonObjectFromDatabaseFile, an empty object if a file cannot be read
+        class BLACKCORE_EXPORT CDatabaseFilesReadAhead
+        {
+        public:
+            //! Ctor, starts reading
+            explicit CDatabaseFilesReadAhead(const QStringList &fileNames);
+
+            //! Dtor, waits for the file being read
+            ~CDatabaseFilesReadAhead();
+
+            //! Not copyable
+            //! @{
+            CDatabaseFilesReadAhead(const CDatabaseFilesReadAhead &) = delete;
+            CDatabaseFilesReadAhead &operator =(const CDatabaseFilesReadAhead &) = delete;
+            //! @}
+
+            //! JSON object of a file, waits until the file has been read
+            //! \remark each file can be taken once, a file not passed to the ctor is read in the calling thread
+            QJsonObject take(const QString &fileName);
+
+        private:
+            //! Read all files, in the background thread
+            void readFiles();
+
+            const QStringList m_fileNames;         //!< read in the background thread
+            std::atomic_bool m_stop { false };
+            QMutex m_mutex;                        //!< guards m_objects
+            QWaitCondition m_fileRead;
+            QHash<QString, QJsonObject> m_objects; //!< read, but not taken yet
+            std::unique_ptr<QThread> m_thread;
+        };
     } // ns
 } // ns
 #endif // guard
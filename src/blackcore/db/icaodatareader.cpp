@@ -511,158 +511,129 @@ namespace BlackCore
             CStatusMessageList msgs;
             whatToRead &= CEntityFlags::AllIcaoCountriesCategory;
             CEntityFlags::Entity reallyRead = CEntityFlags::NoEntity;
-            if (whatToRead.testFlag(CEntityFlags::CountryEntity))
+
+            // all files are checked first, so the next file is read ahead while the previous one is decoded
+            const QString path = directory.absolutePath();
+            const auto fileToRead = [ & ](CEntityFlags::Entity entity)
+            {
+                return whatToRead.testFlag(entity) ? this->jsonFileToRead(path, entity, CDbInfo::entityToSharedName(entity), overrideNewerOnly, msgs) : QString();
+            };
+            const QString countriesFile = fileToRead(CEntityFlags::CountryEntity);
+            const QString aircraftIcaosFile = fileToRead(CEntityFlags::AircraftIcaoEntity);
+            const QString airlineIcaosFile = fileToRead(CEntityFlags::AirlineIcaoEntity);
+            const QString categoriesFile = fileToRead(CEntityFlags::AircraftCategoryEntity);
+            QStringList files({ countriesFile, aircraftIcaosFile, airlineIcaosFile, categoriesFile });
+            files.removeAll(QString());
+            CDatabaseFilesReadAhead readAhead(files);
+
+            if (!countriesFile.isEmpty())
             {
-                const QString fileName = CFileUtils::appendFilePaths(directory.absolutePath(), CDbInfo::entityToSharedName(CEntityFlags::CountryEntity));
+                const QString &fileName = countriesFile;
                 const QFileInfo fi(fileName);
-                if (!fi.exists())
+                const QUrl url = QUrl::fromLocalFile(fi.absoluteFilePath());
+                const QJsonObject countriesJson(readAhead.take(fileName));
+                if (countriesJson.isEmpty())
                 {
-                    msgs.push_back(CStatusMessage(this).warning(u"File '%1' does not exist") << fileName);
-                }
-                else if (!this->overrideCacheFromFile(overrideNewerOnly, fi, CEntityFlags::CountryEntity, msgs))
-                {
-                    // void
+                    msgs.push_back(CStatusMessage(this).error(u"Failed to read from file/empty file '%1'") << fileName);
                 }
                 else
                 {
-                    const QUrl url = QUrl::fromLocalFile(fi.absoluteFilePath());
-                    const QJsonObject countriesJson(CDatabaseUtils::readQJsonObjectFromDatabaseFile(fileName));
-                    if (countriesJson.isEmpty())
+                    try
                     {
-                        msgs.push_back(CStatusMessage(this).error(u"Failed to read from file/empty file '%1'") << fileName);
+                        const CCountryList countries = CCountryList::fromMultipleJsonFormats(countriesJson);
+                        const int c = countries.size();
+                        msgs.push_back(m_countryCache.set(countries, fi.birthTime().toUTC().toMSecsSinceEpoch()));
+                        reallyRead |= CEntityFlags::CountryEntity;
+                        emit this->dataRead(CEntityFlags::CountryEntity, CEntityFlags::ReadFinished, c, url);
                     }
-                    else
+                    catch (const CJsonException &ex)
                     {
-                        try
-                        {
-                            const CCountryList countries = CCountryList::fromMultipleJsonFormats(countriesJson);
-                            const int c = countries.size();
-                            msgs.push_back(m_countryCache.set(countries, fi.birthTime().toUTC().toMSecsSinceEpoch()));
-                            reallyRead |= CEntityFlags::CountryEntity;
-                            emit this->dataRead(CEntityFlags::CountryEntity, CEntityFlags::ReadFinished, c, url);
-                        }
-                        catch (const CJsonException &ex)
-                        {
-                            emit this->dataRead(CEntityFlags::CountryEntity, CEntityFlags::ReadFailed, 0, url);
-                            msgs.push_back(CStatusMessage::fromJsonException(ex, this, QStringLiteral("Reading countries from '%1'").arg(fileName)));
-                        }
+                        emit this->dataRead(CEntityFlags::CountryEntity, CEntityFlags::ReadFailed, 0, url);
+                        msgs.push_back(CStatusMessage::fromJsonException(ex, this, QStringLiteral("Reading countries from '%1'").arg(fileName)));
                     }
                 }
             } // country
 
-            if (whatToRead.testFlag(CEntityFlags::AircraftIcaoEntity))
+            if (!aircraftIcaosFile.isEmpty())
             {
-                const QString fileName = CFileUtils::appendFilePaths(directory.absolutePath(), CDbInfo::entityToSharedName(CEntityFlags::AircraftIcaoEntity));
+                const QString &fileName = aircraftIcaosFile;
                 const QFileInfo fi(fileName);
-                if (!fi.exists())
+                const QUrl url = QUrl::fromLocalFile(fi.absoluteFilePath());
+                const QJsonObject aircraftJson(readAhead.take(fileName));
+                if (aircraftJson.isEmpty())
                 {
-                    msgs.push_back(CStatusMessage(this).warning(u"File '%1' does not exist") << fileName);
-                }
-                else if (!this->overrideCacheFromFile(overrideNewerOnly, fi, CEntityFlags::AircraftIcaoEntity, msgs))
-                {
-                    // void
+                    msgs.push_back(CStatusMessage(this).error(u"Failed to read from file/empty file '%1'") << fileName);
                 }
                 else
                 {
-                    const QUrl url = QUrl::fromLocalFile(fi.absoluteFilePath());
-                    const QJsonObject aircraftJson(CDatabaseUtils::readQJsonObjectFromDatabaseFile(fileName));
-                    if (aircraftJson.isEmpty())
+                    try
                     {
-                        msgs.push_back(CStatusMessage(this).error(u"Failed to read from file/empty file '%1'") << fileName);
+                        const CAircraftIcaoCodeList aircraftIcaos = CAircraftIcaoCodeList::fromMultipleJsonFormats(aircraftJson);
+                        const int c = aircraftIcaos.size();
+                        msgs.push_back(m_aircraftIcaoCache.set(aircraftIcaos, fi.birthTime().toUTC().toMSecsSinceEpoch()));
+                        reallyRead |= CEntityFlags::AircraftIcaoEntity;
+                        emit this->dataRead(CEntityFlags::AircraftIcaoEntity, CEntityFlags::ReadFinished, c, url);
                     }
-                    else
+                    catch (const CJsonException &ex)
                     {
-                        try
-                        {
-                            const CAircraftIcaoCodeList aircraftIcaos = CAircraftIcaoCodeList::fromMultipleJsonFormats(aircraftJson);
-                            const int c = aircraftIcaos.size();
-                            msgs.push_back(m_aircraftIcaoCache.set(aircraftIcaos, fi.birthTime().toUTC().toMSecsSinceEpoch()));
-                            reallyRead |= CEntityFlags::AircraftIcaoEntity;
-                            emit this->dataRead(CEntityFlags::AircraftIcaoEntity, CEntityFlags::ReadFinished, c, url);
-                        }
-                        catch (const CJsonException &ex)
-                        {
-                            emit this->dataRead(CEntityFlags::AircraftIcaoEntity, CEntityFlags::ReadFailed, 0, url);
-                            msgs.push_back(CStatusMessage::fromJsonException(ex, this, QStringLiteral("Reading aircraft ICAOs from '%1'").arg(fileName)));
-                        }
+                        emit this->dataRead(CEntityFlags::AircraftIcaoEntity, CEntityFlags::ReadFailed, 0, url);
+                        msgs.push_back(CStatusMessage::fromJsonException(ex, this, QStringLiteral("Reading aircraft ICAOs from '%1'").arg(fileName)));
                     }
                 }
             } // aircraft
 
-            if (whatToRead.testFlag(CEntityFlags::AirlineIcaoEntity))
+            if (!airlineIcaosFile.isEmpty())
             {
-                const QString fileName = CFileUtils::appendFilePaths(directory.absolutePath(), CDbInfo::entityToSharedName(CEntityFlags::AirlineIcaoEntity));
+                const QString &fileName = airlineIcaosFile;
                 const QFileInfo fi(fileName);
-                if (!fi.exists())
-                {
-                    msgs.push_back(CStatusMessage(this).warning(u"File '%1' does not exist") << fileName);
-                }
-                else if (!this->overrideCacheFromFile(overrideNewerOnly, fi, CEntityFlags::AirlineIcaoEntity, msgs))
+                const QUrl url = QUrl::fromLocalFile(fi.absoluteFilePath());
+                const QJsonObject airlineJson(readAhead.take(fileName));
+                if (airlineJson.isEmpty())
                 {
-                    // void
+                    msgs.push_back(CStatusMessage(this).error(u"Failed to read from file/empty file '%1'") << fileName);
                 }
                 else
                 {
-                    const QUrl url = QUrl::fromLocalFile(fi.absoluteFilePath());
-                    const QJsonObject airlineJson(CDatabaseUtils::readQJsonObjectFromDatabaseFile(fileName));
-                    if (airlineJson.isEmpty())
+                    try
                     {
-                        msgs.push_back(CStatusMessage(this).error(u"Failed to read from file/empty file '%1'") << fileName);
+                        const CAirlineIcaoCodeList airlineIcaos = CAirlineIcaoCodeList::fromMultipleJsonFormats(airlineJson);
+                        const int c = airlineIcaos.size();
+                        msgs.push_back(m_airlineIcaoCache.set(airlineIcaos, fi.birthTime().toUTC().toMSecsSinceEpoch()));
+                        reallyRead |= CEntityFlags::AirlineIcaoEntity;
+                        emit this->dataRead(CEntityFlags::AirlineIcaoEntity, CEntityFlags::ReadFinished, c, url);
                     }
-                    else
+                    catch (const CJsonException &ex)
                     {
-                        try
-                        {
-                            const CAirlineIcaoCodeList airlineIcaos = CAirlineIcaoCodeList::fromMultipleJsonFormats(airlineJson);
-                            const int c = airlineIcaos.size();
-                            msgs.push_back(m_airlineIcaoCache.set(airlineIcaos, fi.birthTime().toUTC().toMSecsSinceEpoch()));
-                            reallyRead |= CEntityFlags::AirlineIcaoEntity;
-                            emit this->dataRead(CEntityFlags::AirlineIcaoEntity, CEntityFlags::ReadFinished, c, url);
-                        }
-                        catch (const CJsonException &ex)
-                        {
-                            emit this->dataRead(CEntityFlags::AirlineIcaoEntity, CEntityFlags::ReadFailed, 0, url);
-                            msgs.push_back(CStatusMessage::fromJsonException(ex, this, QStringLiteral("Reading airline ICAOs from '%1'").arg(fileName)));
-                        }
+                        emit this->dataRead(CEntityFlags::AirlineIcaoEntity, CEntityFlags::ReadFailed, 0, url);
+                        msgs.push_back(CStatusMessage::fromJsonException(ex, this, QStringLiteral("Reading airline ICAOs from '%1'").arg(fileName)));
                     }
                 }
             } // airline
 
-            if (whatToRead.testFlag(CEntityFlags::AircraftCategoryEntity))
+            if (!categoriesFile.isEmpty())
             {
-                const QString fileName = CFileUtils::appendFilePaths(directory.absolutePath(), CDbInfo::entityToSharedName(CEntityFlags::AircraftCategoryEntity));
+                const QString &fileName = categoriesFile;
                 const QFileInfo fi(fileName);
-                if (!fi.exists())
-                {
-                    msgs.push_back(CStatusMessage(this).warning(u"File '%1' does not exist") << fileName);
-                }
-                else if (!this->overrideCacheFromFile(overrideNewerOnly, fi, CEntityFlags::AircraftCategoryEntity, msgs))
+                const QUrl url = QUrl::fromLocalFile(fi.absoluteFilePath());
+                const QJsonObject aircraftCategory(readAhead.take(fileName));
+                if (aircraftCategory.isEmpty())
                 {
-                    // void
+                    msgs.push_back(CStatusMessage(this).error(u"Failed to read from file/empty file '%1'") << fileName);
                 }
                 else
                 {
-                    const QUrl url = QUrl::fromLocalFile(fi.absoluteFilePath());
-                    const QJsonObject aircraftCategory(CDatabaseUtils::readQJsonObjectFromDatabaseFile(fileName));
-                    if (aircraftCategory.isEmpty())
+                    try
                     {
-                        msgs.push_back(CStatusMessage(this).error(u"Failed to read from file/empty file '%1'") << fileName);
+                        const CAircraftCategoryList aircraftCategories = CAircraftCategoryList::fromMultipleJsonFormats(aircraftCategory);
+                        const int c = aircraftCategories.size();
+                        msgs.push_back(m_categoryCache.set(aircraftCategories, fi.birthTime().toUTC().toMSecsSinceEpoch()));
+                        reallyRead |= CEntityFlags::AircraftCategoryEntity;
+                        emit this->dataRead(CEntityFlags::AircraftCategoryEntity, CEntityFlags::ReadFinished, c, url);
                     }
-                    else
+                    catch (const CJsonException &ex)
                     {
-                        try
-                        {
-                            const CAircraftCategoryList aircraftCategories = CAircraftCategoryList::fromMultipleJsonFormats(aircraftCategory);
-                            const int c = aircraftCategories.size();
-                            msgs.push_back(m_categoryCache.set(aircraftCategories, fi.birthTime().toUTC().toMSecsSinceEpoch()));
-                            reallyRead |= CEntityFlags::AircraftCategoryEntity;
-                            emit this->dataRead(CEntityFlags::AircraftCategoryEntity, CEntityFlags::ReadFinished, c, url);
-                        }
-                        catch (const CJsonException &ex)
-                        {
-                            emit this->dataRead(CEntityFlags::AircraftCategoryEntity, CEntityFlags::ReadFailed, 0, url);
-                            msgs.push_back(CStatusMessage::fromJsonException(ex, this, QStringLiteral("Reading categories from '%1'").arg(fileName)));
-                        }
+                        emit this->dataRead(CEntityFlags::AircraftCategoryEntity, CEntityFlags::ReadFailed, 0, url);
+                        msgs.push_back(CStatusMessage::fromJsonException(ex, this, QStringLiteral("Reading categories from '%1'").arg(fileName)));
                     }
                 }
             } // categories
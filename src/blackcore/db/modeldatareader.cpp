@@ -459,122 +459,98 @@ namespace BlackCore
             whatToRead &= CEntityFlags::DistributorLiveryModel; // supported
             CEntityFlags::Entity reallyRead = CEntityFlags::NoEntity;
 
+            // all files are checked first, so the next file is read ahead while the previous one is decoded
             CStatusMessageList msgs;
-            if (whatToRead.testFlag(CEntityFlags::LiveryEntity))
+            const QString path = directory.absolutePath();
+            const QString liveriesFile = whatToRead.testFlag(CEntityFlags::LiveryEntity) ? this->jsonFileToRead(path, CEntityFlags::LiveryEntity, "liveries.json", overrideNewerOnly, msgs) : QString();
+            const QString modelsFile = whatToRead.testFlag(CEntityFlags::ModelEntity) ? this->jsonFileToRead(path, CEntityFlags::ModelEntity, "models.json", overrideNewerOnly, msgs) : QString();
+            const QString distributorsFile = whatToRead.testFlag(CEntityFlags::DistributorEntity) ? this->jsonFileToRead(path, CEntityFlags::DistributorEntity, "distributors.json", overrideNewerOnly, msgs) : QString();
+            QStringList files({ liveriesFile, modelsFile, distributorsFile });
+            files.removeAll(QString());
+            CDatabaseFilesReadAhead readAhead(files);
+
+            if (!liveriesFile.isEmpty())
             {
-                const QString fileName = CFileUtils::appendFilePaths(directory.absolutePath(), "liveries.json");
+                const QString &fileName = liveriesFile;
                 const QFileInfo fi(fileName);
-                if (!fi.exists())
+                const QJsonObject liveriesJson(readAhead.take(fileName));
+                const QUrl url = QUrl::fromLocalFile(fi.absoluteFilePath());
+                if (liveriesJson.isEmpty())
                 {
-                    msgs.push_back(CStatusMessage(this).warning(u"File '%1' does not exist") << fileName);
-                }
-                else if (!this->overrideCacheFromFile(overrideNewerOnly, fi, CEntityFlags::LiveryEntity, msgs))
-                {
-                    // void
+                    msgs.push_back(CStatusMessage(this).error(u"Failed to read from file/empty file '%1'") << fileName);
                 }
                 else
                 {
-                    const QJsonObject liveriesJson(CDatabaseUtils::readQJsonObjectFromDatabaseFile(fileName));
-                    const QUrl url = QUrl::fromLocalFile(fi.absoluteFilePath());
-                    if (liveriesJson.isEmpty())
+                    try
                     {
-                        msgs.push_back(CStatusMessage(this).error(u"Failed to read from file/empty file '%1'") << fileName);
+                        const CLiveryList liveries = CLiveryList::fromMultipleJsonFormats(liveriesJson);
+                        const int c = liveries.size();
+                        msgs.push_back(m_liveryCache.set(liveries, fi.birthTime().toUTC().toMSecsSinceEpoch()));
+                        emit this->dataRead(CEntityFlags::LiveryEntity, CEntityFlags::ReadFinished, c, url);
+                        reallyRead |= CEntityFlags::LiveryEntity;
                     }
-                    else
+                    catch (const CJsonException &ex)
                     {
-                        try
-                        {
-                            const CLiveryList liveries = CLiveryList::fromMultipleJsonFormats(liveriesJson);
-                            const int c = liveries.size();
-                            msgs.push_back(m_liveryCache.set(liveries, fi.birthTime().toUTC().toMSecsSinceEpoch()));
-                            emit this->dataRead(CEntityFlags::LiveryEntity, CEntityFlags::ReadFinished, c, url);
-                            reallyRead |= CEntityFlags::LiveryEntity;
-                        }
-                        catch (const CJsonException &ex)
-                        {
-                            emit this->dataRead(CEntityFlags::LiveryEntity, CEntityFlags::ReadFailed, 0, url);
-                            msgs.push_back(CStatusMessage::fromJsonException(ex, this, QStringLiteral("Reading liveries from '%1'").arg(fileName)));
-                        }
+                        emit this->dataRead(CEntityFlags::LiveryEntity, CEntityFlags::ReadFailed, 0, url);
+                        msgs.push_back(CStatusMessage::fromJsonException(ex, this, QStringLiteral("Reading liveries from '%1'").arg(fileName)));
                     }
                 }
             }
 
-            if (whatToRead.testFlag(CEntityFlags::ModelEntity))
+            if (!modelsFile.isEmpty())
             {
-                const QString fileName = CFileUtils::appendFilePaths(directory.absolutePath(), "models.json");
+                const QString &fileName = modelsFile;
                 const QFileInfo fi(fileName);
-                if (!fi.exists())
-                {
-                    msgs.push_back(CStatusMessage(this).warning(u"File '%1' does not exist") << fileName);
-                }
-                else if (!this->overrideCacheFromFile(overrideNewerOnly, fi, CEntityFlags::ModelEntity, msgs))
+                const QJsonObject modelsJson(readAhead.take(fileName));
+                const QUrl url = QUrl::fromLocalFile(fi.absoluteFilePath());
+
+                if (modelsJson.isEmpty())
                 {
-                    // void
+                    msgs.push_back(CStatusMessage(this).error(u"Failed to read from file/empty file '%1'") << fileName);
                 }
                 else
                 {
-                    const QJsonObject modelsJson(CDatabaseUtils::readQJsonObjectFromDatabaseFile(fileName));
-                    const QUrl url = QUrl::fromLocalFile(fi.absoluteFilePath());
-
-                    if (modelsJson.isEmpty())
+                    try
                     {
-                        msgs.push_back(CStatusMessage(this).error(u"Failed to read from file/empty file '%1'") << fileName);
+                        const CAircraftModelList models = CAircraftModelList::fromMultipleJsonFormats(modelsJson);
+                        const int c = models.size();
+                        msgs.push_back(m_modelCache.set(models, fi.birthTime().toUTC().toMSecsSinceEpoch()));
+                        emit this->dataRead(CEntityFlags::ModelEntity, CEntityFlags::ReadFinished, c, url);
+                        reallyRead |= CEntityFlags::ModelEntity;
                     }
-                    else
+                    catch (const CJsonException &ex)
                     {
-                        try
-                        {
-                            const CAircraftModelList models = CAircraftModelList::fromMultipleJsonFormats(modelsJson);
-                            const int c = models.size();
-                            msgs.push_back(m_modelCache.set(models, fi.birthTime().toUTC().toMSecsSinceEpoch()));
-                            emit this->dataRead(CEntityFlags::ModelEntity, CEntityFlags::ReadFinished, c, url);
-                            reallyRead |= CEntityFlags::ModelEntity;
-                        }
-                        catch (const CJsonException &ex)
-                        {
-                            emit this->dataRead(CEntityFlags::ModelEntity, CEntityFlags::ReadFailed, 0, url);
-                            msgs.push_back(CStatusMessage::fromJsonException(ex, this, QStringLiteral("Reading models from '%1'").arg(fileName)));
-                        }
+                        emit this->dataRead(CEntityFlags::ModelEntity, CEntityFlags::ReadFailed, 0, url);
+                        msgs.push_back(CStatusMessage::fromJsonException(ex, this, QStringLiteral("Reading models from '%1'").arg(fileName)));
                     }
                 }
             }
 
-            if (whatToRead.testFlag(CEntityFlags::DistributorEntity))
+            if (!distributorsFile.isEmpty())
             {
-                const QString fileName = CFileUtils::appendFilePaths(directory.absolutePath(), "distributors.json");
+                const QString &fileName = distributorsFile;
                 const QFileInfo fi(fileName);
-                if (!fi.exists())
-                {
-                    msgs.push_back(CStatusMessage(this).warning(u"File '%1' does not exist") << fileName);
-                }
-                else if (!this->overrideCacheFromFile(overrideNewerOnly, fi, CEntityFlags::DistributorEntity, msgs))
+                const QJsonObject distributorsJson(readAhead.take(fileName));
+                const QUrl url = QUrl::fromLocalFile(fi.absoluteFilePath());
+
+                if (distributorsJson.isEmpty())
                 {
-                    // void
+                    msgs.push_back(CStatusMessage(this).error(u"Failed to read from file/empty file '%1'") << fileName);
                 }
                 else
                 {
-                    const QJsonObject distributorsJson(CDatabaseUtils::readQJsonObjectFromDatabaseFile(fileName));
-                    const QUrl url = QUrl::fromLocalFile(fi.absoluteFilePath());
-
-                    if (distributorsJson.isEmpty())
+                    try
                     {
-                        msgs.push_back(CStatusMessage(this).error(u"Failed to read from file/empty file '%1'") << fileName);
+                        const CDistributorList distributors = CDistributorList::fromMultipleJsonFormats(distributorsJson);
+                        const int c = distributors.size();
+                        msgs.push_back(m_distributorCache.set(distributors, fi.birthTime().toUTC().toMSecsSinceEpoch()));
+                        emit this->dataRead(CEntityFlags::DistributorEntity, CEntityFlags::ReadFinished, c, url);
+                        reallyRead |= CEntityFlags::DistributorEntity;
                     }
-                    else
+                    catch (const CJsonException &ex)
                     {
-                        try
-                        {
-                            const CDistributorList distributors = CDistributorList::fromMultipleJsonFormats(distributorsJson);
-                            const int c = distributors.size();
-                            msgs.push_back(m_distributorCache.set(distributors, fi.birthTime().toUTC().toMSecsSinceEpoch()));
-                            emit this->dataRead(CEntityFlags::DistributorEntity, CEntityFlags::ReadFinished, c, url);
-                            reallyRead |= CEntityFlags::DistributorEntity;
-                        }
-                        catch (const CJsonException &ex)
-                        {
-                            emit this->dataRead(CEntityFlags::DistributorEntity, CEntityFlags::ReadFailed, 0, url);
-                            msgs.push_back(CStatusMessage::fromJsonException(ex, this, QStringLiteral("Reading distributors from '%1'").arg(fileName)));
-                        }
+                        emit this->dataRead(CEntityFlags::DistributorEntity, CEntityFlags::ReadFailed, 0, url);
+                        msgs.push_back(CStatusMessage::fromJsonException(ex, this, QStringLiteral("Reading distributors from '%1'").arg(fileName)));
                     }
                 }
             }
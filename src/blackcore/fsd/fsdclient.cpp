@@ -951,33 +951,11 @@ namespace BlackCore
 
         void CFSDClient::initializeMessageTypes()
         {
-            m_messageTypeMapping["#AA"] = MessageType::AddAtc;
-            m_messageTypeMapping["#AP"] = MessageType::AddPilot;
-            m_messageTypeMapping["%"]   = MessageType::AtcDataUpdate;
-            m_messageTypeMapping["$ZC"] = MessageType::AuthChallenge;
-            m_messageTypeMapping["$ZR"] = MessageType::AuthResponse;
-            m_messageTypeMapping["$ID"] = MessageType::ClientIdentification;
-            m_messageTypeMapping["$CQ"] = MessageType::ClientQuery;
-            m_messageTypeMapping["$CR"] = MessageType::ClientResponse;
-            m_messageTypeMapping["#DA"] = MessageType::DeleteATC;
-            m_messageTypeMapping["#DP"] = MessageType::DeletePilot;
-            m_messageTypeMapping["$FP"] = MessageType::FlightPlan;
-            m_messageTypeMapping["#PC"] = MessageType::ProController;
-            m_messageTypeMapping["$DI"] = MessageType::FsdIdentification;
-            m_messageTypeMapping["$!!"] = MessageType::KillRequest;
-            m_messageTypeMapping["@"]   = MessageType::PilotDataUpdate;
-            m_messageTypeMapping["$PI"] = MessageType::Ping;
-            m_messageTypeMapping["$PO"] = MessageType::Pong;
-            m_messageTypeMapping["$ER"] = MessageType::ServerError;
-            m_messageTypeMapping["#DL"] = MessageType::ServerHeartbeat;
-            m_messageTypeMapping["#TM"] = MessageType::TextMessage;
-            m_messageTypeMapping["#SB"] = MessageType::PilotClientCom;
-
-            // IVAO only
-            // Ref: https://github.com/DemonRem/X-IvAP/blob/1b0a14880532a0f5c8fe84be44e462c6892a5596/src/XIvAp/FSDprotocol.h
-            m_messageTypeMapping["!R"]  = MessageType::RegistrationInfo;
-            m_messageTypeMapping["-MD"] = MessageType::RevBClientParts;
-            m_messageTypeMapping["-PD"] = MessageType::RevBPilotDescription; // not handled, to avoid error messages
+            // same table as used for parsing
+            for (const MessageTypePrefix &p : messageTypePrefixes())
+            {
+                m_messageTypeMapping[QString::fromLatin1(p.prefix)] = p.type;
+            }
 
             // IVAO parts
             // https://discordapp.com/channels/539048679160676382/695961646992195644/707915838845485187
@@ -1969,22 +1947,14 @@ namespace BlackCore
 
         void CFSDClient::parseMessage(const QString &lineRaw)
         {
-            MessageType messageType = MessageType::Unknown;
-            QString cmd;
-            const QString line = lineRaw.trimmed();
+            // views, no copies of the line
+            const QStringView line = QStringView(lineRaw).trimmed();
 
             if (m_printToConsole) { qDebug() << "FSD Recv=>" << line; }
-            emitRawFsdMessage(line, false);
+            if (this->isRawFsdMessageEmittingEnabled()) { emitRawFsdMessage(line.toString(), false); }
 
-            for (const QString &str : makeKeysRange(as_const(m_messageTypeMapping)))
-            {
-                if (line.startsWith(str))
-                {
-                    cmd = str;
-                    messageType = m_messageTypeMapping.value(str, MessageType::Unknown);
-                    break;
-                }
-            }
+            int prefixLength = 0;
+            const MessageType messageType = messageTypeFromPrefix(line, prefixLength);
 
             // statistics
             if (m_statistics)
@@ -1994,16 +1964,9 @@ namespace BlackCore
 
             if (messageType != MessageType::Unknown)
             {
-                // Cutoff the cmd from the beginning
-                const QString payload = line.mid(cmd.size()).trimmed();
-
-                // We expected a payload, but there is nothing
-                if (payload.length() == 0) { return; }
-
-                const QStringList tokens = payload.split(':');
+                // ignored ones, no need to tokenize them
                 switch (messageType)
                 {
-                // ignored ones
                 case MessageType::AddAtc:
                 case MessageType::AddPilot:
                 case MessageType::ServerHeartbeat:
@@ -2011,9 +1974,20 @@ namespace BlackCore
                 case MessageType::ClientIdentification:
                 case MessageType::RegistrationInfo:
                 case MessageType::RevBPilotDescription:
-
+                    return;
+                default:
                     break;
+                }
+
+                // Cutoff the cmd from the beginning
+                const QStringView payload = line.mid(prefixLength).trimmed();
+
+                // We expected a payload, but there is nothing
+                if (payload.isEmpty()) { return; }
 
+                const QStringList tokens = splitTokens(payload);
+                switch (messageType)
+                {
                 // handled ones
                 case MessageType::AtcDataUpdate:     handleAtcDataUpdate(tokens);     break;
                 case MessageType::AuthChallenge:     handleAuthChallenge(tokens);     break;
@@ -2045,13 +2019,18 @@ namespace BlackCore
             }
             else
             {
-                handleUnknownPacket(line);
+                handleUnknownPacket(line.toString());
             }
         }
 
+        bool CFSDClient::isRawFsdMessageEmittingEnabled() const
+        {
+            return m_unitTestMode || m_rawFsdMessagesEnabled;
+        }
+
         void CFSDClient::emitRawFsdMessage(const QString &fsdMessage, bool isSent)
         {
-            if (!m_unitTestMode && !m_rawFsdMessagesEnabled) { return; }
+            if (!this->isRawFsdMessageEmittingEnabled()) { return; }
             QString fsdMessageFiltered(fsdMessage);
             if (m_filterPasswordFromLogin)
             {
@@ -428,6 +428,9 @@ namespace BlackCore
             //! Emit raw FSD message (mostly for debugging)
             void emitRawFsdMessage(const QString &fsdMessage, bool isSent);
 
+            //! Are raw FSD messages emitted?
+            bool isRawFsdMessageEmittingEnabled() const;
+
             //! Additional offset time
             //! @{
             qint64 getAdditionalOffsetTime() const;
@@ -464,7 +467,7 @@ namespace BlackCore
             qint64       m_loginSince = -1; //!< when login was triggered
             static constexpr qint64 PendingConnectionTimeoutMs = 7500;
 
-            // Parser
+            // Parser, dispatching is done by BlackCore::Fsd::messageTypeFromPrefix, this is used for the statistics
             QHash<QString, MessageType> m_messageTypeMapping;
 
             QTcpSocket m_socket { this }; //!< used TCP socket, parent needed as it runs in worker thread
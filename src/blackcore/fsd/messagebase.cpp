@@ -8,6 +8,8 @@
 
 #include "messagebase.h"
 
+#include <algorithm>
+
 namespace BlackCore
 {
     namespace Fsd
@@ -20,5 +22,115 @@ namespace BlackCore
             : m_sender(sender),
               m_receiver(receiver)
         { }
+
+        namespace
+        {
+            //! Pack up to 3 prefix characters into one key
+            constexpr int prefixKey(unsigned char c0, unsigned char c1 = 0, unsigned char c2 = 0)
+            {
+                return (c0 << 16) | (c1 << 8) | c2;
+            }
+
+            //! Key of a prefix string
+            int prefixKey(const char *prefix)
+            {
+                const auto c = [ = ](int i) { return static_cast<unsigned char>(prefix[i]); };
+                if (!c(0)) { return 0; }
+                if (!c(1)) { return prefixKey(c(0)); }
+                return c(2) ? prefixKey(c(0), c(1), c(2)) : prefixKey(c(0), c(1));
+            }
+
+            //! Prefix keys sorted for the lookup
+            const std::vector<std::pair<int, MessageType>> &sortedPrefixKeys()
+            {
+                static const std::vector<std::pair<int, MessageType>> keys = []
+                {
+                    std::vector<std::pair<int, MessageType>> k;
+                    for (const MessageTypePrefix &p : messageTypePrefixes()) { k.emplace_back(prefixKey(p.prefix), p.type); }
+                    std::sort(k.begin(), k.end());
+                    return k;
+                }();
+                return keys;
+            }
+
+            //! Type of a packed prefix, MessageType::Unknown if there is none
+            MessageType lookupPrefixKey(int key)
+            {
+                const auto &keys = sortedPrefixKeys();
+                const auto it = std::lower_bound(keys.begin(), keys.end(), key, [](const std::pair<int, MessageType> &e, int k) { return e.first < k; });
+                return (it != keys.end() && it->first == key) ? it->second : MessageType::Unknown;
+            }
+        }
+
+        const std::vector<MessageTypePrefix> &messageTypePrefixes()
+        {
+            static const std::vector<MessageTypePrefix> prefixes
+            {
+                { "#AA", MessageType::AddAtc },
+                { "#AP", MessageType::AddPilot },
+                { "%",   MessageType::AtcDataUpdate },
+                { "$ZC", MessageType::AuthChallenge },
+                { "$ZR", MessageType::AuthResponse },
+                { "$ID", MessageType::ClientIdentification },
+                { "$CQ", MessageType::ClientQuery },
+                { "$CR", MessageType::ClientResponse },
+                { "#DA", MessageType::DeleteATC },
+                { "#DP", MessageType::DeletePilot },
+                { "$FP", MessageType::FlightPlan },
+                { "#PC", MessageType::ProController },
+                { "$DI", MessageType::FsdIdentification },
+                { "$!!", MessageType::KillRequest },
+                { "@",   MessageType::PilotDataUpdate },
+                { "$PI", MessageType::Ping },
+                { "$PO", MessageType::Pong },
+                { "$ER", MessageType::ServerError },
+                { "#DL", MessageType::ServerHeartbeat },
+                { "#TM", MessageType::TextMessage },
+                { "#SB", MessageType::PilotClientCom },
+
+                // IVAO only
+                // Ref: https://github.com/DemonRem/X-IvAP/blob/1b0a14880532a0f5c8fe84be44e462c6892a5596/src/XIvAp/FSDprotocol.h
+                { "!R",  MessageType::RegistrationInfo },
+                { "-MD", MessageType::RevBClientParts },
+                { "-PD", MessageType::RevBPilotDescription }, // not handled, to avoid error messages
+            };
+            return prefixes;
+        }
+
+        MessageType messageTypeFromPrefix(QStringView line, int &prefixLength)
+        {
+            prefixLength = 0;
+            const qsizetype size = line.size();
+            const auto c = [ & ](int i) { return static_cast<unsigned char>(line.at(i).toLatin1()); };
+
+            // shortest prefix first, no prefix is the beginning of a longer one
+            MessageType mt = MessageType::Unknown;
+            if (size >= 1 && (mt = lookupPrefixKey(prefixKey(c(0)))) != MessageType::Unknown) { prefixLength = 1; return mt; }
+            if (size >= 2 && (mt = lookupPrefixKey(prefixKey(c(0), c(1)))) != MessageType::Unknown) { prefixLength = 2; return mt; }
+            if (size >= 3 && (mt = lookupPrefixKey(prefixKey(c(0), c(1), c(2)))) != MessageType::Unknown) { prefixLength = 3; return mt; }
+            return MessageType::Unknown;
+        }
+
+        QStringList splitTokens(QStringView payload)
+        {
+            const qsizetype size = payload.size();
+            int separators = 0;
+            for (qsizetype i = 0; i < size; ++i)
+            {
+                if (payload.at(i) == QLatin1Char(':')) { separators++; }
+            }
+
+            QStringList tokens;
+            tokens.reserve(separators + 1);
+            qsizetype start = 0;
+            for (qsizetype i = 0; i < size; ++i)
+            {
+                if (payload.at(i) != QLatin1Char(':')) { continue; }
+                tokens.push_back(payload.mid(start, i - start).toString());
+                start = i + 1;
+            }
+            tokens.push_back(payload.mid(start).toString());
+            return tokens;
+        }
     }
 }
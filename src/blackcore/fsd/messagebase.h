@@ -16,7 +16,9 @@
 #include <QString>
 #include <QStringBuilder>
 #include <QStringList>
+#include <QStringView>
 #include <QDebug>
+#include <vector>
 
 //! Message type
 //! \remark FSD Server docu https://studentweb.uvic.ca/~norrisng/fsd-doc/
@@ -91,6 +93,26 @@ namespace BlackCore
             bool m_isValid = true;  //!< is valid?
         };
 
+        //! Command prefix of a message type
+        struct MessageTypePrefix
+        {
+            const char *prefix; //!< command prefix, 1 to 3 characters
+            MessageType type;   //!< message type
+        };
+
+        //! All command prefixes, parsing and statistics use this table
+        BLACKCORE_EXPORT const std::vector<MessageTypePrefix> &messageTypePrefixes();
+
+        //! Message type by the command prefix of a received line
+        //! \param line       received line, leading whitespaces already removed
+        //! \param prefixLength length of the matched command prefix, 0 for MessageType::Unknown
+        //! \remark binary search over the packed prefixes of messageTypePrefixes, no allocations
+        BLACKCORE_EXPORT MessageType messageTypeFromPrefix(QStringView line, int &prefixLength);
+
+        //! Split the payload of a message into its tokens, same result as QString::split(':')
+        //! \remark no intermediate copies of line or payload
+        BLACKCORE_EXPORT QStringList splitTokens(QStringView payload);
+
         //! String which will be send
         template <class T>
         QString messageToFSDString(const T &message)
@@ -13,6 +13,7 @@
 #include "blackcore/data/vatsimsetup.h"
 #include "blackcore/db/databasereader.h"
 #include "blackcore/vatsim/vatsimsettings.h"
+#include "blackcore/vatsim/vatsimdatafilereader.h"
 #include "blackcore/fsd/fsdclient.h"
 #include "blackcore/afv/clients/afvclient.h"
 #include "blackcore/simulator.h"
@@ -39,6 +40,9 @@ namespace BlackCore
         qRegisterMetaType<BlackCore::Afv::Clients::CAfvClient::ConnectionStatus>("ConnectionStatus");
         qRegisterMetaType<BlackCore::Afv::Audio::TransceiverReceivingCallsignsChangedArgs>();
         qRegisterMetaType<BlackCore::Afv::Audio::TransceiverReceivingCallsignsChangedArgs>("TransceiverReceivingCallsignsChangedArgs");
+        qRegisterMetaType<BlackCore::Afv::Audio::OpusDataAvailableArgs>();
+        qRegisterMetaType<BlackCore::Afv::Audio::InputVolumeStreamArgs>();
+        qRegisterMetaType<BlackCore::Vatsim::VatsimDataFileChanges>();
 
         qDBusRegisterMetaType<Context::CSettingsDictionary>();
         qDBusRegisterMetaType<BlackMisc::Network::CLoginMode>();
@@ -23,6 +23,7 @@
 #include <QtGlobal>
 #include <QPointer>
 #include <QDateTime>
+#include <QMutexLocker>
 #include <QString>
 #include <QStringBuilder>
 #include <QThread>
@@ -482,6 +483,29 @@ namespace BlackCore
                 CLogMessage(this).info(u"Started writing interpolation log");
                 return true;
             }
+            if (part2 == "trace")
+            {
+                const QString part3 = parser.part(3).toLower();
+                CInterpolationTraceRecorder &recorder = m_interpolationLogger.traceRecorder();
+                if (part3 == "on" || part3 == "off")
+                {
+                    recorder.setEnabled(part3 == "on");
+                    CLogMessage(this).info(u"Interpolation trace: %1") << part3;
+                    return true;
+                }
+                if (part3 == "clear" || part3 == "clr")
+                {
+                    recorder.clear();
+                    CLogMessage(this).info(u"Cleared interpolation trace");
+                    return true;
+                }
+                if (part3.isEmpty() || part3 == "write" || part3 == "save")
+                {
+                    if (m_interpolationLogger.writeTraceInBackground()) { CLogMessage(this).info(u"Started writing interpolation trace"); }
+                    return true;
+                }
+                return false;
+            }
             if (part2 == "show")
             {
                 const QDir dir(CInterpolationLogger::getLogDirectory());
@@ -658,6 +682,8 @@ namespace BlackCore
         CSimpleCommandParser::registerCommand({".drv logint write", "write interpolator log to file"});
         CSimpleCommandParser::registerCommand({".drv logint clear", "clear current log"});
         CSimpleCommandParser::registerCommand({".drv logint max number", "max. number of entries logged"});
+        CSimpleCommandParser::registerCommand({".drv logint trace", "write interpolation trace to file"});
+        CSimpleCommandParser::registerCommand({".drv logint trace on|off|clear", "record/clear interpolation trace"});
         CSimpleCommandParser::registerCommand({".drv pos callsign", "show position for callsign"});
         CSimpleCommandParser::registerCommand({".drv spline|linear callsign", "set spline/linear interpolator for one/all callsign(s)"});
         CSimpleCommandParser::registerCommand({".drv aircraft readd callsign", "add again (re-add) a given callsign"});
@@ -755,6 +781,7 @@ namespace BlackCore
     {
         this->setObjectName("Simulator: " + pluginInfo.getIdentifier());
         m_interpolationLogger.setObjectName("Logger: " + pluginInfo.getIdentifier());
+        m_interpolationLogger.traceRecorder().setEnabled(true); // cheap, written on demand with .drv logint trace
 
         ISimulator::registerHelp();
 
@@ -778,6 +805,7 @@ namespace BlackCore
         {
             connect(sApp->getWebDataServices(), &CWebDataServices::swiftDbAllDataRead,  this, &ISimulator::onSwiftDbAllDataRead, Qt::QueuedConnection);
             connect(sApp->getWebDataServices(), &CWebDataServices::swiftDbAirportsRead, this, &ISimulator::onSwiftDbAirportsRead, Qt::QueuedConnection);
+            connect(sApp->getWebDataServices(), &CWebDataServices::swiftDbAirportsRead, this, [ = ] { m_airportsIndexOutdated = true; }, Qt::DirectConnection);
             connect(sApp->getWebDataServices(), &CWebDataServices::swiftDbModelMatchingEntitiesRead, this, &ISimulator::onSwiftDbModelMatchingEntitiesRead, Qt::QueuedConnection);
         }
         connect(sApp, &CApplication::aboutToShutdown, this, &ISimulator::unload, Qt::QueuedConnection);
@@ -792,6 +820,7 @@ namespace BlackCore
         {
             // NORMAL CASE or plugin with info already set
             this->setNewPluginInfo(pluginInfo, m_multiSettings.getSettings(pluginInfo.getSimulatorInfo()));
+            this->loadElevations(); // from the last sessions
         }
 
         // info data
@@ -819,6 +848,11 @@ namespace BlackCore
         Q_ASSERT_X(CThreadUtils::isInThisThread(this), Q_FUNC_INFO, "Needs to run in object thread");
         Q_ASSERT_X(snapshot.generatingThreadName() != QThread::currentThread()->objectName(), Q_FUNC_INFO, "Expect snapshot from background thread");
 
+        // nothing relevant changed since the previous snapshot we have handled, so the simulator is still in sync
+        const bool reconcile = snapshot.isReconcileRequired(m_handledSnapshotVersion);
+        m_handledSnapshotVersion = snapshot.getVersion();
+        if (!reconcile) { return; }
+
         // restricted snapshot values?
         bool changed = false;
         if (snapshot.isRenderingEnabled())
@@ -942,7 +976,7 @@ namespace BlackCore
         if (elevation.hasMSLGeodeticHeight())
         {
             const int aircraftCount = this->getAircraftInRangeCount();
-            this->setMaxElevationsRemembered(aircraftCount * 3); // at least 3 elevations per aircraft, even better as not all are requesting elevations
+            this->setMaxElevationsRemembered(aircraftCount * 3); // at least 3 elevations per aircraft, never below the default size
             this->rememberGroundElevation(callsign, likelyOnGroundElevation, elevation);
         }
 
@@ -1027,10 +1061,20 @@ namespace BlackCore
         if (this->isShuttingDown()) { return CAirportList(); }
         if (!sApp || !sApp->hasWebDataServices()) { return CAirportList(); }
 
-        const CAirportList airports = sApp->getWebDataServices()->getAirports();
-        if (airports.isEmpty()) { return airports; }
         const CCoordinateGeodetic ownPosition = this->getOwnAircraftPosition();
-        CAirportList airportsInRange = airports.findClosest(maxAirportsInRange(), ownPosition);
+        CAirportList airportsInRange;
+        {
+            // the airport list only changes when read, the index is rebuilt then
+            // the indexed copy is queried, so list and index always match
+            QMutexLocker l(&m_airportsIndexMutex);
+            if (m_airportsIndexOutdated.exchange(false) || m_indexedAirports.isEmpty())
+            {
+                m_indexedAirports = sApp->getWebDataServices()->getAirports();
+                m_airportsIndex = CGeoSpatialIndex::fromObjects(m_indexedAirports);
+            }
+            if (m_indexedAirports.isEmpty()) { return m_indexedAirports; }
+            airportsInRange = m_indexedAirports.findClosest(m_airportsIndex, maxAirportsInRange(), ownPosition);
+        }
         if (recalculateDistance) { airportsInRange.calculcateAndUpdateRelativeDistanceAndBearing(this->getOwnAircraftPosition()); }
         return airportsInRange;
     }
@@ -1103,6 +1147,7 @@ namespace BlackCore
     void ISimulator::unload()
     {
         this->disconnectFrom(); // disconnect from simulator
+        this->saveElevations(); // for the next session
         const bool saved = m_autoPublishing.writeJsonToFile(); // empty data are ignored
         if (saved) { emit this->autoPublishDataWritten(this->getSimulatorInfo()); }
         m_autoPublishing.clear();
@@ -30,6 +30,7 @@
 #include "blackmisc/network/clientprovider.h"
 #include "blackmisc/weather/weathergridprovider.h"
 #include "blackmisc/geo/elevationplane.h"
+#include "blackmisc/geo/geospatialindex.h"
 #include "blackmisc/pq/length.h"
 #include "blackmisc/pq/time.h"
 #include "blackmisc/statusmessage.h"
@@ -41,6 +42,7 @@
 #include "blackconfig/buildconfig.h"
 
 #include <QFlags>
+#include <QMutex>
 #include <QObject>
 #include <QString>
 #include <atomic>
@@ -648,6 +650,15 @@ namespace BlackCore
         int m_statsPhysicallyAddedAircraft   = 0; //!< statistics, how many aircraft added
         int m_statsPhysicallyRemovedAircraft = 0; //!< statistics, how many aircraft removed
 
+        // snapshot
+        qint64 m_handledSnapshotVersion = -1;     //!< version of the last airspace snapshot handled
+
+        // airports
+        mutable QMutex m_airportsIndexMutex;                                //!< lock airports index
+        mutable BlackMisc::Aviation::CAirportList m_indexedAirports;       //!< airports of the index
+        mutable BlackMisc::Geo::CGeoSpatialIndex m_airportsIndex;          //!< spatial index of m_indexedAirports
+        mutable std::atomic_bool m_airportsIndexOutdated { true };         //!< airports read since the index was built
+
         // highlighting
         bool m_blinkCycle = false;                //!< used for highlighting
         qint64 m_highlightEndTimeMsEpoch = 0;     //!< end highlighting
@@ -17,6 +17,7 @@
 #include "blackmisc/logcategorylist.h"
 #include "blackmisc/worker.h"
 
+#include <QByteArray>
 #include <QDateTime>
 #include <QObject>
 #include <QReadWriteLock>
@@ -119,6 +120,10 @@ namespace BlackCore
         //! \threadsafe
         bool didContentChange(const QString &content, int startPosition = -1);
 
+        //! \copydoc didContentChange
+        //! \remark for content which is not converted to a string
+        bool didContentChange(const QByteArray &content, int startPosition = -1);
+
         //! Set initial and periodic times
         void setInitialAndPeriodicTime(int initialTime, int periodicTime);
 
@@ -21,6 +21,7 @@
 #include "blackmisc/pq/length.h"
 #include "blackmisc/pq/speed.h"
 #include "blackmisc/pq/units.h"
+#include "blackmisc/json.h"
 #include "blackmisc/logmessage.h"
 #include "blackmisc/mixin/mixincompare.h"
 #include "blackmisc/predicates.h"
@@ -32,6 +33,8 @@
 #include <QStringBuilder>
 #include <QByteArray>
 #include <QDateTime>
+#include <QHash>
+#include <QJsonDocument>
 #include <QMetaObject>
 #include <QNetworkReply>
 #include <QReadLocker>
@@ -58,6 +61,47 @@ namespace BlackCore
 {
     namespace Vatsim
     {
+        namespace
+        {
+            //! Entries of the current file by their raw JSON, diffed by callsign with the entries of the previous file
+            //! \remark only entries whose raw JSON is not in the previous file are parsed
+            //! \return false if terminated
+            template <class Entry, class Parser, class WorkCheck>
+            bool diffEntries(const QVector<QByteArray> &rawEntries, const QHash<QByteArray, Entry> &previous, Parser parse, WorkCheck workCheck,
+                             QHash<QByteArray, Entry> &o_current, CCallsignSet &o_added, CCallsignSet &o_changed, CCallsignSet &o_removed)
+            {
+                CCallsignSet previousCallsigns;
+                for (const Entry &entry : previous) { previousCallsigns.insert(entry.getCallsign()); }
+
+                CCallsignSet currentCallsigns;
+                o_current.reserve(rawEntries.size());
+                for (const QByteArray &raw : rawEntries)
+                {
+                    if (!workCheck()) { return false; }
+                    const auto unchanged = previous.constFind(raw);
+                    if (unchanged != previous.constEnd())
+                    {
+                        currentCallsigns.insert(unchanged->getCallsign());
+                        o_current.insert(raw, *unchanged);
+                        continue;
+                    }
+
+                    const Entry entry = parse(QJsonDocument::fromJson(raw).object());
+                    const CCallsign callsign = entry.getCallsign();
+                    currentCallsigns.insert(callsign);
+                    if (previousCallsigns.contains(callsign)) { o_changed.insert(callsign); }
+                    else { o_added.insert(callsign); }
+                    o_current.insert(raw, entry);
+                }
+
+                for (const CCallsign &callsign : as_const(previousCallsigns))
+                {
+                    if (!currentCallsigns.contains(callsign)) { o_removed.insert(callsign); }
+                }
+                return true;
+            }
+        }
+
         CVatsimDataFileReader::CVatsimDataFileReader(QObject *owner) :
             CThreadedReader(owner, "CVatsimDataFileReader"),
             CEcosystemAware(CEcosystemAware::providerIfPossible(owner))
@@ -135,6 +179,12 @@ namespace BlackCore
             return m_flightPlanRemarks.value(callsign);
         }
 
+        int CVatsimDataFileReader::getDataVersion() const
+        {
+            QReadLocker rl(&m_lock);
+            return m_dataVersion;
+        }
+
         void CVatsimDataFileReader::updateWithVatsimDataFileData(CSimulatedAircraft &aircraftToBeUdpated) const
         {
             this->getAircraft().updateWithVatsimDataFileData(aircraftToBeUdpated);
@@ -223,7 +273,7 @@ namespace BlackCore
 
             if (nwReply->error() == QNetworkReply::NoError)
             {
-                const QString dataFileData = nwReply->readAll();
+                const QByteArray dataFileData = nwReply->readAll();
                 nwReply->close(); // close asap
 
                 if (dataFileData.isEmpty()) { return; }
@@ -232,16 +282,13 @@ namespace BlackCore
                     CLogMessage(this).info(u"VATSIM file '%1' has same content, skipped") << urlString;
                     return;
                 }
-                auto jsonDoc = QJsonDocument::fromJson(dataFileData.toUtf8());
-                if (jsonDoc.isEmpty()) { return; }
 
-                // build on local vars for thread safety
-                CServerList                         fsdServers;
-                CAtcStationList                     atcStations;
-                CSimulatedAircraftList              aircraft;
-                QMap<CCallsign, CFlightPlanRemarks> flightPlanRemarksMap;
-                auto updateTimestampFromFile = QDateTime::fromString(jsonDoc["general"]["update_timestamp"].toString(), Qt::ISODateWithMs);
+                // one pass over the bytes, no document of the whole file is built
+                QHash<QString, QByteArray> sections;
+                if (!Json::splitRawObjectMembers(dataFileData, sections)) { return; }
 
+                const QJsonObject general = QJsonDocument::fromJson(sections.value("general")).object();
+                const QDateTime updateTimestampFromFile = QDateTime::fromString(general["update_timestamp"].toString(), Qt::ISODateWithMs);
                 const bool alreadyRead = (updateTimestampFromFile == this->getUpdateTimestamp());
                 if (alreadyRead)
                 {
@@ -249,41 +296,64 @@ namespace BlackCore
                     return;
                 }
 
-                for (QJsonValueRef pilot : jsonDoc["pilots"].toArray())
+                QVector<QByteArray> rawPilots;
+                QVector<QByteArray> rawAtcStations;
+                QVector<QByteArray> rawAtis;
+                Json::splitRawArrayElements(sections.value("pilots"), rawPilots);
+                Json::splitRawArrayElements(sections.value("controllers"), rawAtcStations);
+                Json::splitRawArrayElements(sections.value("atis"), rawAtis);
+                rawAtcStations += rawAtis;
+
+                // only new or changed entries are parsed
+                const auto workCheck = [this] { return this->doWorkCheck(); };
+                const auto parsePilotEntry = [&](const QJsonObject &pilot)
                 {
-                    if (!this->doWorkCheck())
-                    {
-                        CLogMessage(this).info(u"Terminated VATSIM file parsing process");
-                        return;
-                    }
-                    aircraft.push_back(parsePilot(pilot.toObject(), illegalEquipmentCodes));
-                    flightPlanRemarksMap.insert(aircraft.back().getCallsign(), parseFlightPlanRemarks(pilot.toObject()));
+                    PilotEntry entry;
+                    entry.aircraft = this->parsePilot(pilot, illegalEquipmentCodes);
+                    entry.remarks = this->parseFlightPlanRemarks(pilot);
+                    return entry;
+                };
+                const auto parseAtcEntry = [&](const QJsonObject &controller)
+                {
+                    AtcEntry entry;
+                    entry.station = this->parseController(controller);
+                    return entry;
+                };
+
+                VatsimDataFileChanges changes;
+                QHash<QByteArray, PilotEntry> pilotEntries;
+                QHash<QByteArray, AtcEntry> atcEntries;
+                if (!diffEntries(rawPilots, m_pilotEntries, parsePilotEntry, workCheck, pilotEntries, changes.addedAircraft, changes.changedAircraft, changes.removedAircraft) ||
+                        !diffEntries(rawAtcStations, m_atcEntries, parseAtcEntry, workCheck, atcEntries, changes.addedAtcStations, changes.changedAtcStations, changes.removedAtcStations))
+                {
+                    CLogMessage(this).info(u"Terminated VATSIM file parsing process");
+                    return;
                 }
-                for (QJsonValueRef controller : jsonDoc["controllers"].toArray())
+                m_pilotEntries = pilotEntries;
+                m_atcEntries = atcEntries;
+
+                // build on local vars for thread safety, in the order of the file
+                CServerList                         fsdServers;
+                CAtcStationList                     atcStations;
+                CSimulatedAircraftList              aircraft;
+                QMap<CCallsign, CFlightPlanRemarks> flightPlanRemarksMap;
+                if (!changes.isEmpty())
                 {
-                    if (!this->doWorkCheck())
+                    for (const QByteArray &raw : as_const(rawPilots))
                     {
-                        CLogMessage(this).info(u"Terminated VATSIM file parsing process");
-                        return;
+                        const PilotEntry &entry = *pilotEntries.constFind(raw);
+                        aircraft.push_back(entry.aircraft);
+                        flightPlanRemarksMap.insert(entry.getCallsign(), entry.remarks);
                     }
-                    atcStations.push_back(parseController(controller.toObject()));
-                }
-                for (QJsonValueRef atis : jsonDoc["atis"].toArray())
-                {
-                    if (!this->doWorkCheck())
+                    for (const QByteArray &raw : as_const(rawAtcStations))
                     {
-                        CLogMessage(this).info(u"Terminated VATSIM file parsing process");
-                        return;
+                        atcStations.push_back(atcEntries.constFind(raw)->station);
                     }
-                    atcStations.push_back(parseController(atis.toObject()));
                 }
-                for (QJsonValueRef server : jsonDoc["servers"].toArray())
+
+                const QJsonArray servers = QJsonDocument::fromJson(sections.value("servers")).array();
+                for (const QJsonValue &server : servers)
                 {
-                    if (!this->doWorkCheck())
-                    {
-                        CLogMessage(this).info(u"Terminated VATSIM file parsing process");
-                        return;
-                    }
                     fsdServers.push_back(parseServer(server.toObject()));
                     if (!fsdServers.back().hasName()) { fsdServers.pop_back(); }
                 }
@@ -295,9 +365,14 @@ namespace BlackCore
                 {
                     QWriteLocker wl(&m_lock);
                     this->setUpdateTimestamp(updateTimestampFromFile);
-                    m_aircraft = aircraft;
-                    m_atcStations = atcStations;
-                    m_flightPlanRemarks = flightPlanRemarksMap;
+                    if (!changes.isEmpty())
+                    {
+                        m_aircraft = aircraft;
+                        m_atcStations = atcStations;
+                        m_flightPlanRemarks = flightPlanRemarksMap;
+                        m_dataVersion++;
+                    }
+                    changes.version = m_dataVersion;
                 }
 
                 // update cache itself is thread safe
@@ -308,6 +383,7 @@ namespace BlackCore
                     vs.setUtcTimestamp(updateTimestampFromFile);
                     m_lastGoodSetup.set(vs);
                 }
+                changes.changedServers = changedSetup;
 
                 // warnings, if required
                 if (!illegalEquipmentCodes.isEmpty())
@@ -320,6 +396,7 @@ namespace BlackCore
                 // data read finished
                 emit this->dataFileRead(dataFileData.size() / 1000);
                 emit this->dataRead(CEntityFlags::VatsimDataFile, CEntityFlags::ReadFinished, dataFileData.size() / 1000, url);
+                if (!changes.isEmpty()) { emit this->dataFileChanged(changes); }
             }
             else
             {
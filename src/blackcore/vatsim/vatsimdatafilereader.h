@@ -27,7 +27,10 @@
 #include "blackmisc/datacache.h"
 #include "blackcore/threadedreader.h"
 
+#include <QByteArray>
+#include <QHash>
 #include <QMap>
+#include <QMetaType>
 #include <QObject>
 #include <QString>
 #include <QStringList>
@@ -39,6 +42,35 @@ namespace BlackCore
 {
     namespace Vatsim
     {
+        //! Changes of a VATSIM data file compared with the previously read file, by callsign
+        struct VatsimDataFileChanges
+        {
+            int version = 0;                                     //!< data version after the changes, see CVatsimDataFileReader::getDataVersion
+            BlackMisc::Aviation::CCallsignSet addedAircraft;     //!< aircraft not in the previous file
+            BlackMisc::Aviation::CCallsignSet changedAircraft;   //!< aircraft with changed data, including the flight plan remarks
+            BlackMisc::Aviation::CCallsignSet removedAircraft;   //!< aircraft no longer in the file
+            BlackMisc::Aviation::CCallsignSet addedAtcStations;  //!< ATC stations not in the previous file
+            BlackMisc::Aviation::CCallsignSet changedAtcStations;//!< ATC stations with changed data
+            BlackMisc::Aviation::CCallsignSet removedAtcStations;//!< ATC stations no longer in the file
+            bool changedServers = false;                         //!< FSD server list changed
+
+            //! No changes?
+            bool isEmpty() const
+            {
+                return addedAircraft.isEmpty() && changedAircraft.isEmpty() && removedAircraft.isEmpty() &&
+                       addedAtcStations.isEmpty() && changedAtcStations.isEmpty() && removedAtcStations.isEmpty() &&
+                       !changedServers;
+            }
+
+            //! Added or changed aircraft
+            BlackMisc::Aviation::CCallsignSet addedOrChangedAircraft() const
+            {
+                BlackMisc::Aviation::CCallsignSet callsigns(addedAircraft);
+                callsigns.push_back(changedAircraft);
+                return callsigns;
+            }
+        };
+
         //! Read vatsim data file
         //! \sa http://info.vroute.net/vatsim-data.txt
         class BLACKCORE_EXPORT CVatsimDataFileReader :
@@ -115,6 +147,11 @@ namespace BlackCore
             //! \threadsafe
             BlackMisc::Aviation::CFlightPlanRemarks getFlightPlanRemarksForCallsign(const BlackMisc::Aviation::CCallsign &callsign) const;
 
+            //! Version of the aircraft and ATC stations, increased with every read file with changes
+            //! \remark cheap check whether anything changed since a previous call, 0 if nothing has been read yet
+            //! \threadsafe
+            int getDataVersion() const;
+
             //! Update aircraft with VATSIM aircraft data from data file
             //! \threadsafe
             void updateWithVatsimDataFileData(BlackMisc::Simulation::CSimulatedAircraft &aircraftToBeUdpated) const;
@@ -129,6 +166,9 @@ namespace BlackCore
             //! Data have been read
             void dataRead(BlackMisc::Network::CEntityFlags::Entity entity, BlackMisc::Network::CEntityFlags::ReadState state, int number, const QUrl &url);
 
+            //! Aircraft or ATC stations changed, only sent if there are changes
+            void dataFileChanged(const BlackCore::Vatsim::VatsimDataFileChanges &changes);
+
         protected:
             //! \name BlackCore::CThreadedReader overrides
             //! @{
@@ -146,11 +186,35 @@ namespace BlackCore
                 SectionGeneral
             };
 
+            //! Pilot of the data file
+            struct PilotEntry
+            {
+                BlackMisc::Simulation::CSimulatedAircraft aircraft; //!< aircraft
+                BlackMisc::Aviation::CFlightPlanRemarks remarks;    //!< flight plan remarks
+
+                //! Callsign
+                const BlackMisc::Aviation::CCallsign &getCallsign() const { return aircraft.getCallsign(); }
+            };
+
+            //! Controller or ATIS of the data file
+            struct AtcEntry
+            {
+                BlackMisc::Aviation::CAtcStation station; //!< station
+
+                //! Callsign
+                const BlackMisc::Aviation::CCallsign &getCallsign() const { return station.getCallsign(); }
+            };
+
             BlackMisc::Aviation::CAtcStationList m_atcStations;
             BlackMisc::Simulation::CSimulatedAircraftList m_aircraft;
             BlackMisc::CData<BlackCore::Data::TVatsimSetup> m_lastGoodSetup { this };
             BlackMisc::CSettingReadOnly<BlackCore::Vatsim::TVatsimDataFile> m_settings { this, &CVatsimDataFileReader::reloadSettings };
             QMap<BlackMisc::Aviation::CCallsign, BlackMisc::Aviation::CFlightPlanRemarks> m_flightPlanRemarks; //!< cache for flight plan remarks
+            int m_dataVersion = 0; //!< version of m_aircraft and m_atcStations
+
+            // entries of the previous file by their raw JSON, only used in the reader thread
+            QHash<QByteArray, PilotEntry> m_pilotEntries; //!< pilots
+            QHash<QByteArray, AtcEntry> m_atcEntries;     //!< controllers and ATIS
 
             //! Data have been read, parse VATSIM file
             void parseVatsimFile(QNetworkReply *nwReply);
@@ -169,4 +233,6 @@ namespace BlackCore
     } // ns
 } // ns
 
+Q_DECLARE_METATYPE(BlackCore::Vatsim::VatsimDataFileChanges)
+
 #endif // guard
@@ -22,7 +22,6 @@
 #include <QScopedPointer>
 #include <QScopedPointerDeleteLater>
 #include <QString>
-#include <QTextStream>
 #include <QTimer>
 #include <QUrl>
 #include <QWriteLocker>
@@ -128,25 +127,10 @@ namespace BlackCore
                     return;
                 }
 
-                CMetarList metars;
+                // lines are decoded in parallel, lines which are no METAR (e.g. HTML) are counted as invalid
                 int invalidLines = 0;
-                QTextStream lineReader(&metarData);
-                while (!lineReader.atEnd())
-                {
-                    if (!this->doWorkCheck()) { return; }
-                    const QString line = lineReader.readLine();
-                    // some check for obvious errors
-                    if (line.contains("<html")) { continue; }
-                    const CMetar metar = m_metarDecoder.decode(line);
-                    if (metar != CMetar())
-                    {
-                        metars.push_back(metar);
-                    }
-                    else
-                    {
-                        invalidLines++;
-                    }
-                }
+                const CMetarList metars = m_metarDecoder.decodeMetarFile(metarData, &invalidLines, [this] { return !this->doWorkCheck(); });
+                if (!this->doWorkCheck()) { return; }
 
                 CLogMessage(this).info(u"METARs: %1 Metars (invalid %2) from '%3'") << metars.size() << invalidLines << metarUrl;
                 {
@@ -13,6 +13,7 @@
 #include "blackmisc/weather/gridpoint.h"
 #include "blackmisc/weather/weatherdataplugininfo.h"
 #include "blackmisc/weather/weatherdataplugininfolist.h"
+#include "blackmisc/geo/geospatialindex.h"
 #include "blackmisc/pq/length.h"
 #include "blackmisc/pq/units.h"
 #include "blackmisc/logmessage.h"
@@ -211,9 +212,12 @@ namespace BlackCore
         CWeatherGrid requestedWeatherGrid   = weatherRequest.weatherGrid;
 
         // Interpolation. So far it just picks the closest point without interpolation.
+        // The fetched grid is searched for each requested point, so it is indexed once
+        const CGeoSpatialIndex fetchedIndex = CGeoSpatialIndex::fromPositions(fetchedWeatherGrid, [](const CGridPoint & gridPoint) -> const ICoordinateGeodetic & { return gridPoint.getPosition(); });
         for (CGridPoint &gridPoint : requestedWeatherGrid)
         {
-            const auto nearestGridPoint = fetchedWeatherGrid.findClosest(1, gridPoint.getPosition()).frontOrDefault();
+            const CGeoSpatialIndex::Ids closest = fetchedIndex.findClosest(1, gridPoint.getPosition());
+            const CGridPoint nearestGridPoint = closest.isEmpty() ? CGridPoint() : fetchedWeatherGrid[closest.front()];
             gridPoint.copyWeatherDataFrom(nearestGridPoint);
             gridPoint.setPosition(nearestGridPoint.getPosition());
         }
@@ -1093,6 +1093,8 @@ namespace BlackCore
             Q_ASSERT_X(c, Q_FUNC_INFO, "VATSIM data reader signals");
             c = connect(m_vatsimDataFileReader, &CVatsimDataFileReader::dataRead, this, &CWebDataServices::dataRead, typeReaderReadSignals);
             Q_ASSERT_X(c, Q_FUNC_INFO, "connect failed VATSIM data file");
+            c = connect(m_vatsimDataFileReader, &CVatsimDataFileReader::dataFileChanged, this, &CWebDataServices::vatsimDataFileChanged, typeReaderReadSignals);
+            Q_ASSERT_X(c, Q_FUNC_INFO, "connect failed VATSIM data file changes");
             m_entitiesPeriodicallyRead |= CEntityFlags::VatsimDataFile;
             m_vatsimDataFileReader->start(QThread::LowPriority);
             m_vatsimDataFileReader->startReader();
@@ -67,6 +67,7 @@ namespace BlackCore
         class CVatsimDataFileReader;
         class CVatsimMetarReader;
         class CVatsimStatusFileReader;
+        struct VatsimDataFileChanges;
     }
 
     namespace Db
@@ -528,6 +529,10 @@ namespace BlackCore
         //! DB data read
         void swiftDbDataRead(bool success);
 
+        //! VATSIM data file with changed aircraft, ATC stations or servers read
+        //! \remark only the changes, consumers do not need to reload everything on each read
+        void vatsimDataFileChanged(const BlackCore::Vatsim::VatsimDataFileChanges &changes);
+
         // simplified signals follow
         // 1) simple signature
         // 2) fired directly after read, no need to wait for other entities
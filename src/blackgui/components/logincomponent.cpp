@@ -20,6 +20,7 @@
 #include "blackcore/context/contextnetwork.h"
 #include "blackcore/context/contextownaircraft.h"
 #include "blackcore/context/contextsimulator.h"
+#include "blackcore/vatsim/vatsimdatafilereader.h"
 #include "blackcore/webdataservices.h"
 #include "blackcore/data/globalsetup.h"
 #include "blackcore/simulator.h"
@@ -61,6 +62,7 @@ using namespace BlackMisc::Simulation;
 using namespace BlackCore;
 using namespace BlackCore::Data;
 using namespace BlackCore::Context;
+using namespace BlackCore::Vatsim;
 using namespace BlackGui;
 
 namespace BlackGui
@@ -162,14 +164,14 @@ namespace BlackGui
             // web service data
             if (sGui && sGui->getWebDataServices())
             {
-                connect(sGui->getWebDataServices(), &CWebDataServices::dataRead, this, &CLoginComponent::onWebServiceDataRead, Qt::QueuedConnection);
+                connect(sGui->getWebDataServices(), &CWebDataServices::vatsimDataFileChanged, this, &CLoginComponent::onVatsimDataFileChanged, Qt::QueuedConnection);
             }
 
             // inital setup, if data already available
             this->validateAircraftValues();
             ui->form_Pilot->validate();
             ui->cb_AutoLogoff->setChecked(m_networkSetup.useAutoLogoff());
-            this->onWebServiceDataRead(CEntityFlags::VatsimDataFile, CEntityFlags::ReadFinished, -1, {});
+            this->reloadVatsimServers();
             this->reloadOtherServersSetup();
 
             connect(ui->pb_OverrideCredentialsVatsim, &QPushButton::clicked, this, &CLoginComponent::overrideCredentialsToPilot);
@@ -364,23 +366,23 @@ namespace BlackGui
             }
         }
 
-        void CLoginComponent::onWebServiceDataRead(CEntityFlags::Entity entity, CEntityFlags::ReadState state, int number, const QUrl &url)
+        void CLoginComponent::onVatsimDataFileChanged(const VatsimDataFileChanges &changes)
         {
-            if (!CEntityFlags::isFinishedReadState(state)) { return; }
-            if (!sGui || !sGui->getIContextNetwork() || sGui->isShuttingDown()) { return; }
+            // aircraft and ATC stations are not displayed here
+            if (!changes.changedServers) { return; }
+            this->reloadVatsimServers();
+        }
 
-            Q_UNUSED(number)
-            Q_UNUSED(url)
+        void CLoginComponent::reloadVatsimServers()
+        {
+            if (!sGui || !sGui->getIContextNetwork() || sGui->isShuttingDown()) { return; }
 
-            if (entity == CEntityFlags::VatsimDataFile)
-            {
-                CServerList vatsimFsdServers = sGui->getIContextNetwork()->getVatsimFsdServers();
-                if (vatsimFsdServers.isEmpty()) { return; }
-                vatsimFsdServers.sortBy(&CServer::getName);
-                const CServer currentServer = m_networkSetup.getLastVatsimServer();
-                ui->comp_VatsimServers->setServers(vatsimFsdServers, true);
-                ui->comp_VatsimServers->preSelect(currentServer.getName());
-            }
+            CServerList vatsimFsdServers = sGui->getIContextNetwork()->getVatsimFsdServers();
+            if (vatsimFsdServers.isEmpty()) { return; }
+            vatsimFsdServers.sortBy(&CServer::getName);
+            const CServer currentServer = m_networkSetup.getLastVatsimServer();
+            ui->comp_VatsimServers->setServers(vatsimFsdServers, true);
+            ui->comp_VatsimServers->preSelect(currentServer.getName());
         }
 
         void CLoginComponent::loadRememberedUserData()
@@ -44,6 +44,10 @@ namespace BlackMisc
         class CSimulatedAircraft;
     }
 }
+namespace BlackCore
+{
+    namespace Vatsim { struct VatsimDataFileChanges; }
+}
 namespace BlackGui
 {
     namespace Components
@@ -161,8 +165,11 @@ namespace BlackGui
             //! Login cancelled
             void loginCancelled();
 
-            //! VATSIM data file was loaded
-            void onWebServiceDataRead(BlackMisc::Network::CEntityFlags::Entity entity, BlackMisc::Network::CEntityFlags::ReadState state, int number, const QUrl &url);
+            //! VATSIM data file with changes was loaded
+            void onVatsimDataFileChanged(const BlackCore::Vatsim::VatsimDataFileChanges &changes);
+
+            //! Reload the VATSIM servers
+            void reloadVatsimServers();
 
             //! Validate aircaft
             bool validateAircraftValues();
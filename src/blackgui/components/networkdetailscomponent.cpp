@@ -11,6 +11,7 @@
 #include "blackgui/uppercasevalidator.h"
 #include "blackgui/guiapplication.h"
 #include "blackcore/context/contextnetwork.h"
+#include "blackcore/vatsim/vatsimdatafilereader.h"
 #include "blackcore/webdataservices.h"
 
 #include <QToolButton>
@@ -20,6 +21,7 @@ using namespace BlackMisc::Audio;
 using namespace BlackMisc::Aviation;
 using namespace BlackCore;
 using namespace BlackCore::Data;
+using namespace BlackCore::Vatsim;
 
 namespace BlackGui
 {
@@ -48,7 +50,7 @@ namespace BlackGui
             // web service data
             if (sGui && sGui->getWebDataServices())
             {
-                connect(sGui->getWebDataServices(), &CWebDataServices::dataRead, this, &CNetworkDetailsComponent::onWebServiceDataRead, Qt::QueuedConnection);
+                connect(sGui->getWebDataServices(), &CWebDataServices::vatsimDataFileChanged, this, &CNetworkDetailsComponent::onVatsimDataFileChanged, Qt::QueuedConnection);
             }
 
             ui->form_FsdDetails->showEnableInfo(true);
@@ -69,7 +71,7 @@ namespace BlackGui
             ui->tw_Network->setCurrentIndex(tab);
 
             this->reloadOtherServersSetup();
-            this->onWebServiceDataRead(CEntityFlags::VatsimDataFile, CEntityFlags::ReadFinished, -1, {});
+            this->reloadVatsimServers();
         }
 
         CNetworkDetailsComponent::~CNetworkDetailsComponent()
@@ -182,21 +184,23 @@ namespace BlackGui
             emit this->overridePilot(server.getUser());
         }
 
-        void CNetworkDetailsComponent::onWebServiceDataRead(CEntityFlags::Entity entity, CEntityFlags::ReadState state, int number, const QUrl &url)
+        void CNetworkDetailsComponent::onVatsimDataFileChanged(const VatsimDataFileChanges &changes)
         {
-            if (!CEntityFlags::isFinishedReadState(state)) { return; }
-            Q_UNUSED(number)
-            Q_UNUSED(url)
+            // aircraft and ATC stations are not displayed here
+            if (!changes.changedServers) { return; }
+            this->reloadVatsimServers();
+        }
 
-            if (entity == CEntityFlags::VatsimDataFile)
-            {
-                CServerList vatsimFsdServers = sGui->getIContextNetwork()->getVatsimFsdServers();
-                if (vatsimFsdServers.isEmpty()) { return; }
-                vatsimFsdServers.sortBy(&CServer::getName);
-                const CServer currentServer = m_networkSetup.getLastVatsimServer();
-                ui->comp_VatsimServers->setServers(vatsimFsdServers, true);
-                ui->comp_VatsimServers->preSelect(currentServer.getName());
-            }
+        void CNetworkDetailsComponent::reloadVatsimServers()
+        {
+            if (!sGui || !sGui->getIContextNetwork() || sGui->isShuttingDown()) { return; }
+
+            CServerList vatsimFsdServers = sGui->getIContextNetwork()->getVatsimFsdServers();
+            if (vatsimFsdServers.isEmpty()) { return; }
+            vatsimFsdServers.sortBy(&CServer::getName);
+            const CServer currentServer = m_networkSetup.getLastVatsimServer();
+            ui->comp_VatsimServers->setServers(vatsimFsdServers, true);
+            ui->comp_VatsimServers->preSelect(currentServer.getName());
         }
 
         void CNetworkDetailsComponent::onChangePage()
@@ -25,6 +25,10 @@
 #include "blackmisc/network/loginmode.h"
 
 namespace Ui { class CNetworkDetailsComponent; }
+namespace BlackCore
+{
+    namespace Vatsim { struct VatsimDataFileChanges; }
+}
 namespace BlackGui
 {
     namespace Components
@@ -134,8 +138,11 @@ namespace BlackGui
             //! Override credentials
             void onOverrideCredentialsToPilot();
 
-            //! VATSIM data file was loaded
-            void onWebServiceDataRead(BlackMisc::Network::CEntityFlags::Entity entity, BlackMisc::Network::CEntityFlags::ReadState state, int number, const QUrl &url);
+            //! VATSIM data file with changes was loaded
+            void onVatsimDataFileChanged(const BlackCore::Vatsim::VatsimDataFileChanges &changes);
+
+            //! Reload the VATSIM servers
+            void reloadVatsimServers();
 
             //! Change page
             void onChangePage();
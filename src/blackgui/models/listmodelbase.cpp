@@ -16,9 +16,12 @@
 #include "blackmisc/worker.h"
 
 #include <QFlags>
+#include <QHash>
 #include <QJsonDocument>
 #include <QList>
 #include <QMimeData>
+#include <QVector>
+#include <algorithm>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Aviation;
@@ -166,36 +169,205 @@ namespace BlackGui
 
             // Keep sorting out of begin/end reset model
             ContainerType sortedContainer;
-            ContainerType selection;
-            if (m_selectionModel)
-            {
-                selection = m_selectionModel->selectedObjects();
-            }
-            const int oldSize = m_container.size();
             const bool performSort = sort && container.size() > 1 && this->hasValidSortColumn();
             if (performSort)
             {
                 const int sortColumn = this->getSortColumn();
                 sortedContainer = this->sortContainerByColumn(container, sortColumn, m_sortOrder);
             }
+            const ContainerType &newContainer = performSort ? sortedContainer : container;
 
-            this->beginResetModel();
-            m_container = performSort ? sortedContainer : container;
-            this->updateFilteredContainer(); // use sorted container for filtered if applicable
-            this->endResetModel();
-
-            // reselect if implemented in specialized view
-            if (!selection.isEmpty())
+            // unchanged rows keep selection and position in the views
+            if (!this->updateByDifferences(newContainer))
             {
-                m_selectionModel->selectObjects(selection);
-            }
+                ContainerType selection;
+                if (m_selectionModel)
+                {
+                    selection = m_selectionModel->selectedObjects();
+                }
 
-            const int newSize = m_container.size();
-            Q_UNUSED(oldSize)
+                this->beginResetModel();
+                m_container = newContainer;
+                this->updateFilteredContainer(); // use sorted container for filtered if applicable
+                this->endResetModel();
+
+                // reselect if implemented in specialized view
+                if (!selection.isEmpty())
+                {
+                    m_selectionModel->selectObjects(selection);
+                }
+            }
 
             // I have to update even with same size because I cannot tell what/if data are changed
             this->emitModelDataChanged();
-            return newSize;
+            return m_container.size();
+        }
+
+        template <typename T, bool UseCompare>
+        bool CListModelBase<T, UseCompare>::updateByDifferences(const ContainerType &container)
+        {
+            // the rows as in the views, filtered if there is a filter
+            const bool filtered = this->hasFilter();
+            const ContainerType newRows = filtered ? m_filter->filter(container) : container;
+            ContainerType &rows = filtered ? m_containerFiltered : m_container; // changed step by step, along with the signals
+            const int oldCount = rows.size();
+            const int newCount = newRows.size();
+            if (oldCount < 1 || newCount < 1) { return false; } // a reset is as good
+
+            // equal objects, the first unused old row for each new row
+            QHash<uint, QVector<int>> oldRowsByHash;
+            for (int o = 0; o < oldCount; o++) { oldRowsByHash[qHash(rows[o])].push_back(o); }
+            QVector<int> matchedOldRow(newCount, -1);
+            QVector<bool> oldRowUsed(oldCount, false);
+            for (int r = 0; r < newCount; r++)
+            {
+                const auto bucket = oldRowsByHash.constFind(qHash(newRows[r]));
+                if (bucket == oldRowsByHash.constEnd()) { continue; }
+                for (int o : *bucket)
+                {
+                    if (oldRowUsed[o] || !(rows[o] == newRows[r])) { continue; }
+                    oldRowUsed[o] = true;
+                    matchedOldRow[r] = o;
+                    break;
+                }
+            }
+
+            // unchanged rows are the longest sequence of equal objects in the same order, the other equal objects are moved
+            QVector<bool> unchanged(newCount, false);
+            {
+                QVector<int> tails; // last row of the increasing sequences by length
+                QVector<int> predecessors(newCount, -1);
+                for (int r = 0; r < newCount; r++)
+                {
+                    const int o = matchedOldRow[r];
+                    if (o < 0) { continue; }
+                    const auto tail = std::lower_bound(tails.begin(), tails.end(), o, [&](int tailRow, int oldRow) { return matchedOldRow[tailRow] < oldRow; });
+                    if (tail != tails.begin()) { predecessors[r] = *(tail - 1); }
+                    if (tail == tails.end()) { tails.push_back(r); }
+                    else { *tail = r; }
+                }
+                for (int r = tails.isEmpty() ? -1 : tails.last(); r >= 0; r = predecessors[r]) { unchanged[r] = true; }
+            }
+
+            // between the same unchanged rows, new and old objects without an equal object are changed rows
+            QVector<int> changedOldRow(newCount, -1);
+            int previousNewRow = -1;
+            int previousOldRow = -1;
+            const auto pairChangedRows = [&](int newEnd, int oldEnd)
+            {
+                int o = previousOldRow + 1;
+                for (int r = previousNewRow + 1; r < newEnd; r++)
+                {
+                    if (matchedOldRow[r] >= 0) { continue; }
+                    while (o < oldEnd && oldRowUsed[o]) { o++; }
+                    if (o >= oldEnd) { break; }
+                    oldRowUsed[o] = true;
+                    changedOldRow[r] = o++;
+                }
+            };
+            for (int r = 0; r < newCount; r++)
+            {
+                if (!unchanged[r]) { continue; }
+                pairChangedRows(r, matchedOldRow[r]);
+                previousNewRow = r;
+                previousOldRow = matchedOldRow[r];
+            }
+            pairChangedRows(newCount, oldCount);
+
+            // too many differences?
+            int operations = 0;
+            int differentRows = 0;
+            for (int o = 0; o < oldCount; o++)
+            {
+                if (oldRowUsed[o]) { continue; }
+                differentRows++;
+                if (o == 0 || oldRowUsed[o - 1]) { operations++; } // removed range
+            }
+            for (int r = 0; r < newCount; r++)
+            {
+                const bool inserted = matchedOldRow[r] < 0 && changedOldRow[r] < 0;
+                if (inserted || changedOldRow[r] >= 0) { differentRows++; }
+                if (inserted && (r == 0 || matchedOldRow[r - 1] >= 0 || changedOldRow[r - 1] >= 0)) { operations++; } // inserted range
+                if (matchedOldRow[r] >= 0 && !unchanged[r]) { operations++; } // moved row
+            }
+            if (operations > diffMaxOperations || 2 * differentRows > newCount) { return false; }
+
+            // 1st removed rows, from the end so the row numbers do not change
+            for (int last = oldCount - 1; last >= 0; last--)
+            {
+                if (oldRowUsed[last]) { continue; }
+                int first = last;
+                while (first > 0 && !oldRowUsed[first - 1]) { first--; }
+                this->beginRemoveRows(QModelIndex(), first, last);
+                rows.erase(rows.begin() + first, rows.begin() + last + 1);
+                this->endRemoveRows();
+                last = first;
+            }
+
+            // 2nd moved rows, each right behind the row which is before it in the new rows
+            QVector<int> currentOldRows; // old row for each current row
+            for (int o = 0; o < oldCount; o++)
+            {
+                if (oldRowUsed[o]) { currentOldRows.push_back(o); }
+            }
+            int previous = -1;
+            for (int r = 0; r < newCount; r++)
+            {
+                const int o = matchedOldRow[r] >= 0 ? matchedOldRow[r] : changedOldRow[r];
+                if (o < 0) { continue; } // inserted
+                if (matchedOldRow[r] >= 0 && !unchanged[r])
+                {
+                    const int from = currentOldRows.indexOf(o);
+                    int to = previous < 0 ? 0 : currentOldRows.indexOf(previous) + 1; // before moving
+                    if (from != to && from + 1 != to)
+                    {
+                        this->beginMoveRows(QModelIndex(), from, from, QModelIndex(), to);
+                        const ObjectType object = rows[from];
+                        rows.erase(rows.begin() + from);
+                        currentOldRows.removeAt(from);
+                        if (to > from) { to--; }
+                        rows.insert(rows.begin() + to, object);
+                        currentOldRows.insert(to, o);
+                        this->endMoveRows();
+                    }
+                }
+                previous = o;
+            }
+
+            // 3rd inserted and changed rows, all rows before the current row are as in the new rows
+            int firstChanged = -1;
+            int lastChanged = -1;
+            for (int r = 0; r < newCount; r++)
+            {
+                if (changedOldRow[r] >= 0)
+                {
+                    rows[r] = newRows[r];
+                    if (firstChanged < 0) { firstChanged = r; }
+                    lastChanged = r;
+                    continue;
+                }
+                if (matchedOldRow[r] >= 0) { continue; }
+
+                int end = r + 1;
+                while (end < newCount && matchedOldRow[end] < 0 && changedOldRow[end] < 0) { end++; }
+                ContainerType insertedRows;
+                for (int i = 0; i < end; i++) { insertedRows.push_back(newRows[i]); }
+                for (int i = r; i < rows.size(); i++) { insertedRows.push_back(rows[i]); } // current rows from here
+                this->beginInsertRows(QModelIndex(), r, end - 1);
+                rows = insertedRows;
+                this->endInsertRows();
+                r = end - 1;
+            }
+            Q_ASSERT_X(rows.size() == newCount, Q_FUNC_INFO, "Wrong number of rows");
+
+            // implicitly shared with the new container
+            rows = newRows;
+            if (filtered) { m_container = container; }
+            if (firstChanged >= 0)
+            {
+                emit this->dataChanged(this->index(firstChanged, 0), this->index(lastChanged, this->columnCount() - 1));
+            }
+            return true;
         }
 
         template <typename T, bool UseCompare>
@@ -557,15 +729,14 @@ namespace BlackGui
                 return container;    // at release build do nothing
             }
 
-            // sort the values
+            // sort the row numbers, then copy the objects once
             const auto tieBreakersCopy = m_sortTieBreakers; //! \todo workaround T579 still not thread-safe, but less likely to crash
             const std::integral_constant<bool, UseCompare> marker {};
-            const auto p = [ = ](const ObjectType & a, const ObjectType & b) -> bool
-            {
-                return Private::compareForModelSort<ObjectType>(a, b, order, propertyIndex, tieBreakersCopy, marker);
-            };
+            const QVector<int> sortedRows = Private::sortedRowsForModelSort(container, order, propertyIndex, tieBreakersCopy, marker);
 
-            return container.sorted(p);
+            ContainerType sorted(container);
+            for (int r = 0; r < sortedRows.size(); r++) { sorted[r] = container[sortedRows[r]]; }
+            return sorted;
         }
 
         template <typename T, bool UseCompare>
@@ -17,12 +17,16 @@
 
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QMetaType>
 #include <QModelIndex>
 #include <QModelIndexList>
 #include <QString>
 #include <QVariant>
 #include <QVector>
+#include <algorithm>
 #include <memory>
+#include <numeric>
+#include <type_traits>
 
 class QMimeData;
 class QModelIndex;
@@ -83,6 +87,7 @@ namespace BlackGui
             //! Update by new container
             //! \return int size after update
             //! \remarks a sorting is performed only if a valid sort column is set
+            //! \remarks only the rows which differ are removed, inserted, moved or changed, unless there are too many differences
             virtual int update(const ContainerType &container, bool sort = true);
 
             //! Asynchronous update
@@ -178,6 +183,10 @@ namespace BlackGui
             //! Update filtered container
             void updateFilteredContainer();
 
+            //! Update the rows by the differences to a new container, with signals for the removed, moved, inserted and changed rows
+            //! \return false if there are too many differences, in that case nothing is changed and the model has to be reset
+            bool updateByDifferences(const ContainerType &container);
+
             //! Model changed
             void emitModelDataChanged();
 
@@ -189,35 +198,57 @@ namespace BlackGui
 
         namespace Private
         {
-            //! Sort with compare function
-            template<class ObjectType>
-            bool compareForModelSort(const ObjectType &a, const ObjectType &b, Qt::SortOrder order, const BlackMisc::CPropertyIndex &index, const BlackMisc::CPropertyIndexList &tieBreakers, std::true_type)
+            //! Row order sorted by compare function
+            //! \remark the compare functions decide the order, which can differ from the order of the property values,
+            //!          e.g. severities compared by enum but displayed as string, or case sensitive strings
+            //! \remark the objects are not copied or swapped while sorting
+            template <class ContainerType>
+            QVector<int> sortedRowsForModelSort(const ContainerType &container, Qt::SortOrder order, const BlackMisc::CPropertyIndex &index, const BlackMisc::CPropertyIndexList &tieBreakers, std::true_type)
             {
-                const int c = a.comparePropertyByIndex(index, b);
-                if (c == 0)
+                QVector<int> rows(container.size());
+                std::iota(rows.begin(), rows.end(), 0);
+                std::stable_sort(rows.begin(), rows.end(), [&](int rowA, int rowB)
                 {
-                    if (!tieBreakers.isEmpty())
+                    const auto &a = container[rowA];
+                    const auto &b = container[rowB];
+                    int c = a.comparePropertyByIndex(index, b);
+                    for (auto tieBreaker = tieBreakers.cbegin(); c == 0 && tieBreaker != tieBreakers.cend(); ++tieBreaker)
                     {
-                        const std::integral_constant<bool, true> marker;
-                        return compareForModelSort<ObjectType>(a, b, order, tieBreakers.front(), tieBreakers.copyFrontRemoved(), marker);
+                        c = a.comparePropertyByIndex(*tieBreaker, b);
                     }
-                    return false;
-                }
-                return (order == Qt::AscendingOrder) ? (c < 0) : (c > 0);
+                    return (order == Qt::AscendingOrder) ? (c < 0) : (c > 0);
+                });
+                return rows;
             }
 
-            //! Sort without compare function
-            template <typename ObjectType>
-            bool compareForModelSort(const ObjectType &a, const ObjectType &b, Qt::SortOrder order, const BlackMisc::CPropertyIndex &index, const BlackMisc::CPropertyIndexList &tieBreakers, std::false_type)
+            //! Row order sorted by property values
+            //! \remark the values (sort keys) are fetched once per row and not for every comparison
+            template <class ContainerType>
+            QVector<int> sortedRowsForModelSort(const ContainerType &container, Qt::SortOrder order, const BlackMisc::CPropertyIndex &index, const BlackMisc::CPropertyIndexList &tieBreakers, std::false_type)
             {
-                const BlackMisc::CVariant aQv = a.propertyByIndex(index);
-                const BlackMisc::CVariant bQv = b.propertyByIndex(index);
-                if (!tieBreakers.isEmpty() && aQv == bQv)
+                const int rowCount = container.size();
+                const int keyCount = 1 + tieBreakers.size();
+                QVector<BlackMisc::CVariant> keys(rowCount * keyCount);
+                for (int row = 0; row < rowCount; row++)
                 {
-                    const std::integral_constant<bool, false> marker;
-                    return compareForModelSort<ObjectType>(a, b, order, tieBreakers.front(), tieBreakers.copyFrontRemoved(), marker);
+                    const auto &object = container[row];
+                    BlackMisc::CVariant *rowKeys = keys.data() + row * keyCount;
+                    rowKeys[0] = object.propertyByIndex(index);
+                    for (int t = 1; t < keyCount; t++) { rowKeys[t] = object.propertyByIndex(tieBreakers[t - 1]); }
                 }
-                return (order == Qt::AscendingOrder) ? (aQv < bQv) : (bQv < aQv);
+
+                QVector<int> rows(rowCount);
+                std::iota(rows.begin(), rows.end(), 0);
+                const BlackMisc::CVariant *keysData = keys.constData();
+                std::stable_sort(rows.begin(), rows.end(), [&](int rowA, int rowB)
+                {
+                    const BlackMisc::CVariant *a = keysData + rowA * keyCount;
+                    const BlackMisc::CVariant *b = keysData + rowB * keyCount;
+                    int k = 0;
+                    while (k < keyCount - 1 && a[k] == b[k]) { k++; } // equal, use tie breaker
+                    return (order == Qt::AscendingOrder) ? (a[k] < b[k]) : (b[k] < a[k]);
+                });
+                return rows;
             }
         } // namespace
     } // namespace
@@ -46,6 +46,10 @@ namespace BlackGui
             //! Number of elements when to use asynchronous updates
             static constexpr int asyncThreshold = 50;
 
+            //! Max.number of moved rows, or ranges of inserted and removed rows, when updating by differences
+            //! \remark with more differences, or if more than half of the rows differ, the model is reset
+            static constexpr int diffMaxOperations = 64;
+
             //! Destructor
             virtual ~CListModelBaseNonTemplate() override {}
 
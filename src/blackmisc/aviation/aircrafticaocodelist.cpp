@@ -8,6 +8,7 @@
 
 #include "aircrafticaocodelist.h"
 #include "aircraftcategorylist.h"
+#include "blackmisc/db/paralleljsondecoding.h"
 #include "blackmisc/range.h"
 
 #include <QJsonObject>
@@ -327,20 +328,27 @@ namespace BlackMisc
 
         CAircraftIcaoCodeList CAircraftIcaoCodeList::fromDatabaseJson(const QJsonArray &array, const CAircraftCategoryList &categories, bool ignoreIncompleteAndDuplicates, CAircraftIcaoCodeList *inconsistent)
         {
-            CAircraftIcaoCodeList codes;
-            for (const QJsonValue &value : array)
+            // decoding in parallel, lookup of the categories by key instead of a search per code
+            const AircraftCategoryIdMap categoriesMap = categories.toDbKeyValueMap();
+            const QVector<CAircraftIcaoCode> decoded = Db::decodeJsonArrayInParallel<CAircraftIcaoCode>(array, [ & ]
             {
-                CAircraftIcaoCode icao(CAircraftIcaoCode::fromDatabaseJson(value.toObject()));
-                const int catId = icao.getCategory().getDbKey();
-                if (!categories.isEmpty() && catId >= 0)
+                return [ & ](const QJsonObject &json)
                 {
-                    const CAircraftCategory category = categories.findByKey(catId);
-                    if (!category.isNull())
+                    CAircraftIcaoCode icao(CAircraftIcaoCode::fromDatabaseJson(json));
+                    const int catId = icao.getCategory().getDbKey();
+                    const auto itCategory = catId >= 0 ? categoriesMap.constFind(catId) : categoriesMap.constEnd();
+                    if (itCategory != categoriesMap.constEnd() && !itCategory->isNull())
                     {
-                        icao.setCategory(category);
+                        icao.setCategory(*itCategory);
                     }
-                }
+                    return icao;
+                };
+            });
 
+            QVector<CAircraftIcaoCode> codes;
+            codes.reserve(decoded.size());
+            for (const CAircraftIcaoCode &icao : decoded)
+            {
                 if (!icao.hasSpecialDesignator() && !icao.hasCompleteData())
                 {
                     if (ignoreIncompleteAndDuplicates) { continue; }
@@ -361,7 +369,7 @@ namespace BlackMisc
                 }
                 codes.push_back(icao);
             }
-            return codes;
+            return CAircraftIcaoCodeList(CSequence<CAircraftIcaoCode>(std::move(codes)));
         }
 
         CAircraftIcaoCode CAircraftIcaoCodeList::smartAircraftIcaoSelector(const CAircraftIcaoCode &icaoPattern) const
@@ -8,6 +8,7 @@
 
 #include "blackmisc/aviation/airlineicaocodelist.h"
 #include "blackmisc/aviation/logutils.h"
+#include "blackmisc/db/paralleljsondecoding.h"
 #include "blackmisc/logcategory.h"
 #include "blackmisc/country.h"
 #include "blackmisc/range.h"
@@ -288,10 +289,15 @@ namespace BlackMisc
 
         CAirlineIcaoCodeList CAirlineIcaoCodeList::fromDatabaseJson(const QJsonArray &array,  bool ignoreIncomplete, CAirlineIcaoCodeList *inconsistent)
         {
-            CAirlineIcaoCodeList codes;
-            for (const QJsonValue &value : array)
+            const QVector<CAirlineIcaoCode> decoded = Db::decodeJsonArrayInParallel<CAirlineIcaoCode>(array, []
+            {
+                return [](const QJsonObject &json) { return CAirlineIcaoCode::fromDatabaseJson(json); };
+            });
+
+            QVector<CAirlineIcaoCode> codes;
+            codes.reserve(decoded.size());
+            for (const CAirlineIcaoCode &icao : decoded)
             {
-                const CAirlineIcaoCode icao(CAirlineIcaoCode::fromDatabaseJson(value.toObject()));
                 const bool incomplete = !icao.hasCompleteData();
                 if (incomplete)
                 {
@@ -304,7 +310,7 @@ namespace BlackMisc
                 }
                 codes.push_back(icao);
             }
-            return codes;
+            return CAirlineIcaoCodeList(CSequence<CAirlineIcaoCode>(std::move(codes)));
         }
 
         QStringList CAirlineIcaoCodeList::toIcaoDesignatorCompleterStrings(bool combinedString, bool sort) const
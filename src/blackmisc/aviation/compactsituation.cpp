@@ -0,0 +1,173 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/aviation/compactsituation.h"
+#include "blackmisc/aviation/aircraftsituationlist.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/heading.h"
+#include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/geo/elevationplane.h"
+#include "blackmisc/pq/angle.h"
+#include "blackmisc/pq/length.h"
+#include "blackmisc/pq/speed.h"
+#include "blackmisc/pq/units.h"
+
+using namespace BlackMisc::Geo;
+using namespace BlackMisc::PhysicalQuantities;
+
+namespace BlackMisc
+{
+    namespace Aviation
+    {
+        namespace
+        {
+            //! Value in unit, NaN if null
+            template <class PQ, class MU>
+            double valueOrNull(const PQ &pq, const MU &unit)
+            {
+                return pq.isNull() ? std::numeric_limits<double>::quiet_NaN() : pq.value(unit);
+            }
+        }
+
+        CCompactSituation CCompactSituation::fromSituation(const CAircraftSituation &situation)
+        {
+            static const CLengthUnit m = CLengthUnit::m();
+            static const CAngleUnit rad = CAngleUnit::rad();
+
+            CCompactSituation compact;
+            compact.m_msSinceEpoch = situation.getMSecsSinceEpoch();
+            compact.m_timeOffsetMs = situation.getTimeOffsetMs();
+            compact.m_normalVector = situation.getPosition().normalVectorDouble();
+
+            const CAltitude &altitude = situation.getAltitude();
+            compact.m_altitudeM = valueOrNull(altitude, m);
+            compact.m_altitudeDatum = static_cast<quint8>(altitude.getReferenceDatum());
+            compact.m_altitudeType = static_cast<quint8>(altitude.getAltitudeType());
+            compact.m_correctedAltitudeM = valueOrNull(situation.getCorrectedAltitude(), m);
+            compact.m_pressureAltitudeM = valueOrNull(situation.getPressureAltitude(), m);
+
+            if (situation.hasGroundElevation())
+            {
+                const CElevationPlane &plane = situation.getGroundElevationPlane();
+                compact.m_groundElevationNormalVector = plane.normalVectorDouble();
+                compact.m_groundElevationM = plane.getAltitude().value(m);
+                compact.m_groundElevationRadiusM = valueOrNull(plane.getRadius(), m);
+            }
+
+            const CHeading &heading = situation.getHeading();
+            compact.m_headingRad = valueOrNull(heading, rad);
+            compact.m_pitchRad = valueOrNull(situation.getPitch(), rad);
+            compact.m_bankRad = valueOrNull(situation.getBank(), rad);
+            compact.m_groundSpeedMps = valueOrNull(situation.getGroundSpeed(), CSpeedUnit::m_s());
+            compact.m_cgM = valueOrNull(situation.getCG(), m);
+            compact.m_sceneryOffsetM = valueOrNull(situation.getSceneryOffset(), m);
+            compact.m_onGroundFactor = situation.getOnGroundFactor();
+            compact.m_onGround = static_cast<qint8>(situation.getOnGround());
+            compact.m_onGroundDetails = static_cast<qint8>(situation.getOnGroundDetails());
+            compact.m_elvInfo = static_cast<qint8>(situation.getGroundElevationInfo());
+
+            if (situation.isInterim()) { compact.m_flags |= Interim; }
+            if (situation.isGroundElevationInfoTransferred()) { compact.m_flags |= ElvInfoTransferred; }
+            if (heading.getReferenceNorth() == CHeading::True) { compact.m_flags |= HeadingTrueNorth; }
+            return compact;
+        }
+
+        QVector<CCompactSituation> CCompactSituation::fromSituations(const CAircraftSituationList &situations)
+        {
+            QVector<CCompactSituation> compact;
+            compact.reserve(situations.size());
+            for (const CAircraftSituation &situation : situations)
+            {
+                compact.push_back(CCompactSituation::fromSituation(situation));
+            }
+            return compact;
+        }
+
+        CAircraftSituation CCompactSituation::toSituation(const CCallsign &callsign) const
+        {
+            static const CLengthUnit m = CLengthUnit::m();
+            static const CAngleUnit rad = CAngleUnit::rad();
+            const CLengthUnit altUnit = CAltitude::defaultUnit();
+
+            CAircraftSituation situation(callsign);
+            situation.setMSecsSinceEpoch(m_msSinceEpoch);
+            situation.setTimeOffsetMs(m_timeOffsetMs);
+
+            CCoordinateGeodetic position(m_normalVector);
+            if (std::isnan(m_altitudeM)) { position.setGeodeticHeightToNull(); }
+            else
+            {
+                const CAltitude altitude(m_altitudeM, static_cast<CAltitude::ReferenceDatum>(m_altitudeDatum), static_cast<CAltitude::AltitudeType>(m_altitudeType), m);
+                position.setGeodeticHeight(altitude.switchedUnit(altUnit));
+            }
+            situation.setPosition(position);
+
+            if (!std::isnan(m_pressureAltitudeM))
+            {
+                situation.setPressureAltitude(CAltitude(m_pressureAltitudeM, CAltitude::MeanSeaLevel, CAltitude::PressureAltitude, m).switchedUnit(altUnit));
+            }
+
+            if (this->hasGroundElevation())
+            {
+                CElevationPlane plane(m_groundElevationNormalVector);
+                plane.setGeodeticHeight(CAltitude(m_groundElevationM, CAltitude::MeanSeaLevel, m).switchedUnit(altUnit));
+                if (!std::isnan(m_groundElevationRadiusM)) { plane.setRadius(CLength(m_groundElevationRadiusM, m)); }
+                situation.setGroundElevation(plane, static_cast<CAircraftSituation::GndElevationInfo>(m_elvInfo), this->hasFlag(ElvInfoTransferred));
+            }
+
+            if (!std::isnan(m_headingRad))
+            {
+                const CHeading::ReferenceNorth north = this->hasFlag(HeadingTrueNorth) ? CHeading::True : CHeading::Magnetic;
+                situation.setHeading(CHeading(CAngle(m_headingRad, rad).switchedUnit(CAngleUnit::deg()), north));
+            }
+            if (!std::isnan(m_pitchRad)) { situation.setPitch(CAngle(m_pitchRad, rad).switchedUnit(CAngleUnit::deg())); }
+            if (!std::isnan(m_bankRad))  { situation.setBank(CAngle(m_bankRad, rad).switchedUnit(CAngleUnit::deg())); }
+            if (!std::isnan(m_groundSpeedMps)) { situation.setGroundSpeed(CSpeed(m_groundSpeedMps, CSpeedUnit::m_s()).switchedUnit(CSpeedUnit::kts())); }
+            if (!std::isnan(m_cgM)) { situation.setCG(CLength(m_cgM, m)); }
+            if (!std::isnan(m_sceneryOffsetM)) { situation.setSceneryOffset(CLength(m_sceneryOffsetM, m)); }
+
+            // the factor is set last, setOnGround would overwrite it
+            situation.setOnGround(this->getOnGround(), this->getOnGroundDetails());
+            situation.setOnGroundFactor(m_onGroundFactor);
+            situation.setInterimFlag(this->hasFlag(Interim));
+            return situation;
+        }
+
+        void CCompactSituation::marshalToDataStream(QDataStream &stream) const
+        {
+            stream << m_msSinceEpoch << m_timeOffsetMs
+                   << m_normalVector[0] << m_normalVector[1] << m_normalVector[2]
+                   << m_altitudeM << m_correctedAltitudeM << m_pressureAltitudeM
+                   << m_groundElevationNormalVector[0] << m_groundElevationNormalVector[1] << m_groundElevationNormalVector[2]
+                   << m_groundElevationM << m_groundElevationRadiusM
+                   << m_headingRad << m_pitchRad << m_bankRad << m_groundSpeedMps << m_cgM << m_sceneryOffsetM << m_onGroundFactor
+                   << m_onGround << m_onGroundDetails << m_elvInfo << m_altitudeDatum << m_altitudeType << m_flags;
+        }
+
+        void CCompactSituation::unmarshalFromDataStream(QDataStream &stream)
+        {
+            stream >> m_msSinceEpoch >> m_timeOffsetMs
+                   >> m_normalVector[0] >> m_normalVector[1] >> m_normalVector[2]
+                   >> m_altitudeM >> m_correctedAltitudeM >> m_pressureAltitudeM
+                   >> m_groundElevationNormalVector[0] >> m_groundElevationNormalVector[1] >> m_groundElevationNormalVector[2]
+                   >> m_groundElevationM >> m_groundElevationRadiusM
+                   >> m_headingRad >> m_pitchRad >> m_bankRad >> m_groundSpeedMps >> m_cgM >> m_sceneryOffsetM >> m_onGroundFactor
+                   >> m_onGround >> m_onGroundDetails >> m_elvInfo >> m_altitudeDatum >> m_altitudeType >> m_flags;
+        }
+
+        CAircraftSituationList CCompactSituation::toSituations(const QVector<CCompactSituation> &situations, const CCallsign &callsign)
+        {
+            CAircraftSituationList list;
+            for (const CCompactSituation &situation : situations)
+            {
+                list.push_back(situation.toSituation(callsign));
+            }
+            return list;
+        }
+    } // namespace
+} // namespace
@@ -0,0 +1,161 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_AVIATION_COMPACTSITUATION_H
+#define BLACKMISC_AVIATION_COMPACTSITUATION_H
+
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/altitude.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QDataStream>
+#include <QVector>
+#include <QtGlobal>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace BlackMisc
+{
+    namespace Aviation
+    {
+        class CAircraftSituationList;
+        class CCallsign;
+
+        //! Fixed layout copy of a CAircraftSituation in SI units
+        //! \remark trivially copyable, so histories of many aircraft can be copied with memcpy
+        //! \remark physical quantities are stored as double values, NaN if the quantity is null
+        //! \remark the callsign and the guessing details are not stored, they are the same for the whole history
+        class BLACKMISC_EXPORT CCompactSituation
+        {
+        public:
+            //! Flags
+            enum Flag : quint8
+            {
+                Interim            = 1 << 0, //!< CAircraftSituation::isInterim
+                ElvInfoTransferred = 1 << 1, //!< CAircraftSituation::isGroundElevationInfoTransferred
+                HeadingTrueNorth   = 1 << 2  //!< heading relative to true north
+            };
+
+            //! Default, a null situation
+            CCompactSituation() {}
+
+            //! From situation
+            static CCompactSituation fromSituation(const CAircraftSituation &situation);
+
+            //! From situations, same order
+            static QVector<CCompactSituation> fromSituations(const CAircraftSituationList &situations);
+
+            //! To situation
+            //! \remark values are in the default units of CAircraftSituation
+            CAircraftSituation toSituation(const CCallsign &callsign) const;
+
+            //! To situations, same order
+            static CAircraftSituationList toSituations(const QVector<CCompactSituation> &situations, const CCallsign &callsign);
+
+            //! Null situation, i.e. without position?
+            bool isNull() const { return std::isnan(m_altitudeM) || (m_normalVector[0] == 0.0 && m_normalVector[1] == 0.0 && m_normalVector[2] == 0.0); }
+
+            //! Timestamp
+            qint64 getMSecsSinceEpoch() const { return m_msSinceEpoch; }
+
+            //! Time offset
+            qint64 getTimeOffsetMs() const { return m_timeOffsetMs; }
+
+            //! Timestamp plus offset
+            qint64 getAdjustedMSecsSinceEpoch() const { return m_msSinceEpoch + m_timeOffsetMs; }
+
+            //! Normal vector of the position
+            const std::array<double, 3> &getNormalVector() const { return m_normalVector; }
+
+            //! Altitude in m
+            double getAltitudeM() const { return m_altitudeM; }
+
+            //! Altitude reference datum
+            CAltitude::ReferenceDatum getAltitudeDatum() const { return static_cast<CAltitude::ReferenceDatum>(m_altitudeDatum); }
+
+            //! Corrected altitude in m as from CAircraftSituation::getCorrectedAltitude with the situation's CG
+            double getCorrectedAltitudeM() const { return m_correctedAltitudeM; }
+
+            //! Ground elevation in m, NaN if there is none
+            double getGroundElevationM() const { return m_groundElevationM; }
+
+            //! Has a ground elevation?
+            bool hasGroundElevation() const { return !std::isnan(m_groundElevationM); }
+
+            //! Heading in radians
+            double getHeadingRad() const { return m_headingRad; }
+
+            //! Pitch in radians
+            double getPitchRad() const { return m_pitchRad; }
+
+            //! Bank in radians
+            double getBankRad() const { return m_bankRad; }
+
+            //! Ground speed in m/s
+            double getGroundSpeedMps() const { return m_groundSpeedMps; }
+
+            //! CG in m
+            double getCGM() const { return m_cgM; }
+
+            //! On ground
+            CAircraftSituation::IsOnGround getOnGround() const { return static_cast<CAircraftSituation::IsOnGround>(m_onGround); }
+
+            //! On ground details
+            CAircraftSituation::OnGroundDetails getOnGroundDetails() const { return static_cast<CAircraftSituation::OnGroundDetails>(m_onGroundDetails); }
+
+            //! On ground factor, -1 if not available
+            double getOnGroundFactor() const { return m_onGroundFactor; }
+
+            //! Flag set?
+            bool hasFlag(Flag flag) const { return (m_flags & flag) != 0; }
+
+            //! \copydoc BlackMisc::Mixin::DataStreamByMetaClass::marshalToDataStream
+            void marshalToDataStream(QDataStream &stream) const;
+
+            //! \copydoc BlackMisc::Mixin::DataStreamByMetaClass::unmarshalFromDataStream
+            void unmarshalFromDataStream(QDataStream &stream);
+
+        private:
+            //! NaN for null values
+            static constexpr double null() { return std::numeric_limits<double>::quiet_NaN(); }
+
+            qint64 m_msSinceEpoch = -1;
+            qint64 m_timeOffsetMs = 0;
+            std::array<double, 3> m_normalVector {{ 0, 0, 0 }};
+            double m_altitudeM = null();
+            double m_correctedAltitudeM = null();
+            double m_pressureAltitudeM = null();
+            std::array<double, 3> m_groundElevationNormalVector {{ 0, 0, 0 }};
+            double m_groundElevationM = null();
+            double m_groundElevationRadiusM = null();
+            double m_headingRad = null();
+            double m_pitchRad = null();
+            double m_bankRad = null();
+            double m_groundSpeedMps = null();
+            double m_cgM = null();
+            double m_sceneryOffsetM = null();
+            double m_onGroundFactor = -1;
+            qint8 m_onGround = static_cast<qint8>(CAircraftSituation::OnGroundSituationUnknown);
+            qint8 m_onGroundDetails = static_cast<qint8>(CAircraftSituation::NotSetGroundDetails);
+            qint8 m_elvInfo = static_cast<qint8>(CAircraftSituation::NoElevationInfo);
+            quint8 m_altitudeDatum = static_cast<quint8>(CAltitude::MeanSeaLevel);
+            quint8 m_altitudeType = static_cast<quint8>(CAltitude::TrueAltitude);
+            quint8 m_flags = 0;
+        };
+
+        static_assert(std::is_trivially_copyable<CCompactSituation>::value, "Copied with memcpy");
+    } // namespace
+} // namespace
+
+Q_DECLARE_TYPEINFO(BlackMisc::Aviation::CCompactSituation, Q_MOVABLE_TYPE);
+
+#endif // guard
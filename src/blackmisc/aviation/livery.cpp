@@ -294,10 +294,11 @@ namespace BlackMisc
             {
                 static const QString prefixAirline("al_");
                 const int idAirlineIcao = json.value(prefixAirline % u"id").toInt(-1);
-                const bool cachedAirlineIcao = idAirlineIcao >= 0 && airlineIcaos.contains(idAirlineIcao);
+                const auto itAirlineIcao = idAirlineIcao >= 0 ? airlineIcaos.constFind(idAirlineIcao) : airlineIcaos.constEnd();
+                const bool cachedAirlineIcao = itAirlineIcao != airlineIcaos.constEnd(); // constFind does not detach a shared map
 
                 airline = cachedAirlineIcao ?
-                          airlineIcaos[idAirlineIcao] :
+                          *itAirlineIcao :
                           CAirlineIcaoCode::fromDatabaseJson(json, prefixAirline);
 
                 if (!cachedAirlineIcao && airline.isLoadedFromDb())
@@ -7,6 +7,7 @@
  */
 
 #include "blackmisc/aviation/liverylist.h"
+#include "blackmisc/db/paralleljsondecoding.h"
 #include "blackmisc/predicates.h"
 #include "blackmisc/range.h"
 
@@ -211,14 +212,14 @@ namespace BlackMisc
 
         CLiveryList CLiveryList::fromDatabaseJsonCaching(const QJsonArray &array, const CAirlineIcaoCodeList &relatedAirlines)
         {
-            AirlineIcaoIdMap airlineIcaos = relatedAirlines.toIdMap();
+            const AirlineIcaoIdMap airlineIcaos = relatedAirlines.toIdMap();
 
-            CLiveryList models;
-            for (const QJsonValue &value : array)
+            // every thread caches in its own copy of the map
+            QVector<CLivery> liveries = Db::decodeJsonArrayInParallel<CLivery>(array, [ & ]
             {
-                models.push_back(CLivery::fromDatabaseJsonCaching(value.toObject(), airlineIcaos));
-            }
-            return models;
+                return [airlineIcaos = airlineIcaos](const QJsonObject &json) mutable { return CLivery::fromDatabaseJsonCaching(json, airlineIcaos); };
+            });
+            return CLiveryList(CSequence<CLivery>(std::move(liveries)));
         }
     } // namespace
 } // namespace
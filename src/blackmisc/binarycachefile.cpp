@@ -0,0 +1,244 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/binarycachefile.h"
+
+#include <QDataStream>
+#include <QIODevice>
+#include <array>
+#include <limits>
+
+namespace BlackMisc
+{
+    namespace
+    {
+        constexpr quint32 Magic = 0x53574443;    // "SWDC"
+        constexpr quint32 FormatVersion = 2;
+        constexpr int StreamVersion = QDataStream::Qt_5_6;
+        constexpr qint64 HeaderSize = 8 * sizeof(quint32);
+
+        //! CRC-32 (IEEE 802.3)
+        quint32 crc32(const char *data, qint64 size)
+        {
+            static const std::array<quint32, 256> table = []
+            {
+                std::array<quint32, 256> t {};
+                for (quint32 i = 0; i < 256; i++)
+                {
+                    quint32 c = i;
+                    for (int k = 0; k < 8; k++) { c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1); }
+                    t[i] = c;
+                }
+                return t;
+            }();
+
+            quint32 crc = 0xFFFFFFFFu;
+            for (qint64 i = 0; i < size; i++)
+            {
+                crc = table[(crc ^ static_cast<quint8>(data[i])) & 0xFFu] ^ (crc >> 8);
+            }
+            return crc ^ 0xFFFFFFFFu;
+        }
+    }
+
+    const QString &CBinaryCacheFile::fileExtension()
+    {
+        static const QString ext(".bin");
+        return ext;
+    }
+
+    bool CBinaryCacheFile::open()
+    {
+        this->close();
+        if (!m_file.open(QFile::ReadOnly))
+        {
+            m_error = m_file.errorString();
+            return false;
+        }
+
+        m_size = m_file.size();
+        if (m_size < HeaderSize)
+        {
+            m_error = QStringLiteral("File too small");
+            this->close();
+            return false;
+        }
+
+        const uchar *mapped = m_file.map(0, m_size);
+        if (!mapped)
+        {
+            m_error = m_file.errorString();
+            this->close();
+            return false;
+        }
+        m_data = reinterpret_cast<const char *>(mapped);
+
+        // header
+        const QByteArray header = QByteArray::fromRawData(m_data, HeaderSize);
+        QDataStream headerStream(header);
+        quint32 magic = 0, version = 0, streamVersion = 0, count = 0, tableSize = 0, tableChecksum = 0;
+        headerStream >> magic >> version >> streamVersion >> count >> tableSize >> tableChecksum >> m_supersededSize >> m_supersededChecksum;
+        if (magic != Magic || version != FormatVersion || streamVersion > static_cast<quint32>(QDataStream::Qt_DefaultCompiledVersion))
+        {
+            m_error = QStringLiteral("Unknown file format or version %1").arg(version);
+            this->close();
+            return false;
+        }
+        if (HeaderSize + tableSize > m_size || crc32(m_data + HeaderSize, tableSize) != tableChecksum)
+        {
+            m_error = QStringLiteral("Corrupted table");
+            this->close();
+            return false;
+        }
+
+        // table
+        const QByteArray table = QByteArray::fromRawData(m_data + HeaderSize, static_cast<int>(tableSize));
+        QDataStream tableStream(table);
+        m_streamVersion = static_cast<int>(streamVersion);
+        tableStream.setVersion(m_streamVersion);
+        for (quint32 i = 0; i < count; i++)
+        {
+            QString key;
+            Entry entry;
+            tableStream >> key >> entry.offset >> entry.size >> entry.checksum;
+            // offset and size are checked separately, their sum could overflow
+            const quint64 fileSize = static_cast<quint64>(m_size);
+            if (tableStream.status() != QDataStream::Ok || entry.offset > fileSize || entry.size > fileSize - entry.offset ||
+                    entry.size > static_cast<quint64>(std::numeric_limits<int>::max()))
+            {
+                m_error = QStringLiteral("Corrupted table entry %1").arg(i);
+                this->close();
+                return false;
+            }
+            m_table.insert(key, entry);
+        }
+        return true;
+    }
+
+    void CBinaryCacheFile::close()
+    {
+        if (m_data) { m_file.unmap(reinterpret_cast<uchar *>(const_cast<char *>(m_data))); }
+        m_file.close();
+        m_data = nullptr;
+        m_size = 0;
+        m_supersededSize = NoFileSize;
+        m_supersededChecksum = 0;
+        m_table.clear();
+    }
+
+    bool CBinaryCacheFile::value(const QString &key, CVariant &o_value)
+    {
+        int size = 0;
+        const char *data = this->checkedData(key, size);
+        if (!data) { return false; }
+
+        const QByteArray bytes = QByteArray::fromRawData(data, size);
+        QDataStream stream(bytes);
+        stream.setVersion(m_streamVersion);
+        stream >> o_value;
+        if (stream.status() != QDataStream::Ok)
+        {
+            m_error = QStringLiteral("Cannot deserialize '%1'").arg(key);
+            return false;
+        }
+        return true;
+    }
+
+    QByteArray CBinaryCacheFile::rawValue(const QString &key)
+    {
+        int size = 0;
+        const char *data = this->checkedData(key, size);
+        return data ? QByteArray(data, size) : QByteArray();
+    }
+
+    QByteArray CBinaryCacheFile::serializeValue(const CVariant &value)
+    {
+        QByteArray bytes;
+        QDataStream stream(&bytes, QIODevice::WriteOnly);
+        stream.setVersion(StreamVersion);
+        stream << value;
+        return bytes;
+    }
+
+    bool CBinaryCacheFile::supersedes(const QString &fileName) const
+    {
+        if (!m_data) { return false; }
+        quint32 size = 0, checksum = 0;
+        fileStamp(fileName, size, checksum);
+        return size == m_supersededSize && checksum == m_supersededChecksum;
+    }
+
+    void CBinaryCacheFile::fileStamp(const QString &fileName, quint32 &o_size, quint32 &o_checksum)
+    {
+        o_size = NoFileSize;
+        o_checksum = 0;
+        QFile file(fileName);
+        if (fileName.isEmpty() || !file.open(QFile::ReadOnly)) { return; }
+        const QByteArray content = file.readAll();
+        o_size = static_cast<quint32>(content.size());
+        o_checksum = crc32(content.constData(), content.size());
+    }
+
+    bool CBinaryCacheFile::write(QIODevice &device, const RawValues &values, const QString &supersededFileName)
+    {
+        // offsets are relative to the file start, so the size of the table is needed upfront
+        qint64 tableSize = 0;
+        for (auto it = values.cbegin(); it != values.cend(); ++it)
+        {
+            tableSize += sizeof(quint32) + 2 * it.key().size() + 2 * sizeof(quint64) + sizeof(quint32);
+        }
+
+        QByteArray table;
+        QDataStream tableStream(&table, QIODevice::WriteOnly);
+        tableStream.setVersion(StreamVersion);
+        quint64 offset = static_cast<quint64>(HeaderSize + tableSize);
+        for (auto it = values.cbegin(); it != values.cend(); ++it)
+        {
+            const quint64 size = static_cast<quint64>(it.value().size());
+            tableStream << it.key() << offset << size << crc32(it.value().constData(), it.value().size());
+            offset += size;
+        }
+        Q_ASSERT_X(table.size() == tableSize, Q_FUNC_INFO, "Wrong table size");
+
+        quint32 supersededSize = 0, supersededChecksum = 0;
+        fileStamp(supersededFileName, supersededSize, supersededChecksum);
+
+        QByteArray header;
+        QDataStream headerStream(&header, QIODevice::WriteOnly);
+        headerStream << Magic << FormatVersion << static_cast<quint32>(StreamVersion) << static_cast<quint32>(values.size())
+                     << static_cast<quint32>(table.size()) << crc32(table.constData(), table.size())
+                     << supersededSize << supersededChecksum;
+
+        if (device.write(header) != header.size()) { return false; }
+        if (device.write(table) != table.size()) { return false; }
+        for (const QByteArray &value : values)
+        {
+            if (device.write(value) != value.size()) { return false; }
+        }
+        return true;
+    }
+
+    const char *CBinaryCacheFile::checkedData(const QString &key, int &o_size)
+    {
+        const auto it = m_table.constFind(key);
+        if (!m_data || it == m_table.cend())
+        {
+            m_error = QStringLiteral("No value for '%1'").arg(key);
+            return nullptr;
+        }
+
+        const char *data = m_data + it->offset;
+        o_size = static_cast<int>(it->size);
+        if (crc32(data, o_size) != it->checksum)
+        {
+            m_error = QStringLiteral("Checksum mismatch for '%1'").arg(key);
+            return nullptr;
+        }
+        return data;
+    }
+} // ns
@@ -0,0 +1,131 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_BINARYCACHEFILE_H
+#define BLACKMISC_BINARYCACHEFILE_H
+
+#include "blackmisc/variant.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+class QIODevice;
+
+namespace BlackMisc
+{
+    /*!
+     * Binary file of cache values, the alternative to the JSON files of CValueCache.
+     *
+     * Layout, all numbers big endian:
+     * - header: magic, format version, QDataStream version, number of entries, size and CRC-32 of the table,
+     *           size and CRC-32 of the superseded file
+     * - table: per entry the key, offset and size of the value in the file, and the CRC-32 of the value
+     * - values: each value is a CVariant serialized with QDataStream
+     *
+     * The file is memory mapped when opened and only the table is parsed, a value is checked and deserialized
+     * when it is requested. So loading a single key of a file with many keys is cheap, and keys can be listed
+     * without deserializing any value at all.
+     *
+     * The superseded file is the file of the other format (JSON) with the same values. Its stamp tells whether it
+     * was written after this file, independent of the resolution of the file timestamps.
+     */
+    class BLACKMISC_EXPORT CBinaryCacheFile
+    {
+    public:
+        //! Values serialized, but not (yet) written, by key
+        using RawValues = QMap<QString, QByteArray>;
+
+        //! File extension, including the dot
+        static const QString &fileExtension();
+
+        //! Constructor
+        explicit CBinaryCacheFile(const QString &fileName) : m_file(fileName) {}
+
+        //! Not copyable
+        //! @{
+        CBinaryCacheFile(const CBinaryCacheFile &) = delete;
+        CBinaryCacheFile &operator =(const CBinaryCacheFile &) = delete;
+        //! @}
+
+        //! Map the file and read the table
+        //! \return false if the file can not be read, or has an unknown version, or the table is corrupted
+        bool open();
+
+        //! Unmap and close the file
+        void close();
+
+        //! Is the file open?
+        bool isOpen() const { return m_data; }
+
+        //! The file name
+        QString fileName() const { return m_file.fileName(); }
+
+        //! Error of the last failed operation
+        const QString &errorString() const { return m_error; }
+
+        //! Keys of all values in the file
+        QStringList keys() const { return m_table.keys(); }
+
+        //! Contains a value for that key?
+        bool contains(const QString &key) const { return m_table.contains(key); }
+
+        //! Deserialize the value of key
+        //! \return false if there is no such key, or its value is corrupted
+        bool value(const QString &key, CVariant &o_value);
+
+        //! The serialized value of key, checked but not deserialized
+        //! \remark the returned data is a copy, it stays valid after the file is closed
+        QByteArray rawValue(const QString &key);
+
+        //! Serialize a value, the result can be written with write
+        static QByteArray serializeValue(const CVariant &value);
+
+        //! Is fileName still the file this file superseded when written, i.e. unchanged since then?
+        //! \remark a missing file is unchanged if it was missing then
+        bool supersedes(const QString &fileName) const;
+
+        //! Write a complete file
+        //! \param supersededFileName file of the other format, stamped as superseded by this file
+        static bool write(QIODevice &device, const RawValues &values, const QString &supersededFileName = {});
+
+    private:
+        //! Position of a value
+        struct Entry
+        {
+            quint64 offset = 0;   //!< offset of the value in the file
+            quint64 size = 0;     //!< size of the value
+            quint32 checksum = 0; //!< CRC-32 of the value
+        };
+
+        //! The mapped data of key, checked against its checksum
+        const char *checkedData(const QString &key, int &o_size);
+
+        //! Size and CRC-32 of a file, NoFileSize if there is none
+        static void fileStamp(const QString &fileName, quint32 &o_size, quint32 &o_checksum);
+
+        //! Stamped size of a missing file
+        static constexpr quint32 NoFileSize = 0xFFFFFFFFu;
+
+        QFile m_file;
+        const char *m_data = nullptr;
+        qint64 m_size = 0;
+        int m_streamVersion = 0;
+        quint32 m_supersededSize = NoFileSize;
+        quint32 m_supersededChecksum = 0;
+        QMap<QString, Entry> m_table;
+        QString m_error;
+    };
+} // ns
+
+#endif // guard
@@ -14,6 +14,7 @@
 #include "blackmisc/aviation/aircraftcategorylist.h"
 #include "blackmisc/aviation/airlineicaocodelist.h"
 #include "blackmisc/db/datastoreobjectlist.h"
+#include "blackmisc/db/paralleljsondecoding.h"
 #include "blackmisc/db/dbinfolist.h"
 #include "blackmisc/db/artifactlist.h"
 #include "blackmisc/db/distributionlist.h"
@@ -344,23 +345,21 @@ namespace BlackMisc
         template <class OBJ, class CONTAINER, typename KEYTYPE>
         CONTAINER IDatastoreObjectList<OBJ, CONTAINER, KEYTYPE>::fromDatabaseJson(const QJsonArray &array)
         {
-            CONTAINER container;
-            for (const QJsonValue &value : array)
+            QVector<OBJ> objects = decodeJsonArrayInParallel<OBJ>(array, []
             {
-                container.push_back(OBJ::fromDatabaseJson(value.toObject()));
-            }
-            return container;
+                return [](const QJsonObject &json) { return OBJ::fromDatabaseJson(json); };
+            });
+            return CONTAINER(CSequence<OBJ>(std::move(objects)));
         }
 
         template <class OBJ, class CONTAINER, typename KEYTYPE>
         CONTAINER IDatastoreObjectList<OBJ, CONTAINER, KEYTYPE>::fromDatabaseJson(const QJsonArray &array, const QString &prefix)
         {
-            CONTAINER container;
-            for (const QJsonValue &value : array)
+            QVector<OBJ> objects = decodeJsonArrayInParallel<OBJ>(array, [ & ]
             {
-                container.push_back(OBJ::fromDatabaseJson(value.toObject(), prefix));
-            }
-            return container;
+                return [ & ](const QJsonObject &json) { return OBJ::fromDatabaseJson(json, prefix); };
+            });
+            return CONTAINER(CSequence<OBJ>(std::move(objects)));
         }
 
         // see here for the reason of thess forward instantiations
@@ -97,6 +97,7 @@ namespace BlackMisc
 
             //! From DB JSON with default prefixes
             //! \remark Specialized classes might have their own fromDatabaseJson implementation
+            //! \remark large arrays are decoded in parallel, see decodeJsonArrayInParallel
             static CONTAINER fromDatabaseJson(const QJsonArray &array);
 
             //! From DB JSON
@@ -0,0 +1,61 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_DB_PARALLELJSONDECODING_H
+#define BLACKMISC_DB_PARALLELJSONDECODING_H
+
+#include "blackmisc/parallel.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QThread>
+#include <QVector>
+#include <QtGlobal>
+#include <atomic>
+#include <functional>
+
+namespace BlackMisc
+{
+    namespace Db
+    {
+        //! Decode the objects of a DB JSON array in parallel, the results are in the order of the array
+        //! \param array JSON array of objects, only read
+        //! \param createDecoder called once per thread, returns the function decoding one QJsonObject to T,
+        //!        so each thread can have its own copy of the lookup maps (implicitly shared until changed by the thread)
+        //! \param chunkSize objects claimed by a thread at once
+        //! \remark the decoder must not touch state shared with other threads, all DB fromDatabaseJson functions qualify
+        template <typename T, typename CreateDecoder>
+        QVector<T> decodeJsonArrayInParallel(const QJsonArray &array, CreateDecoder createDecoder, int chunkSize = 256)
+        {
+            const int count = array.size();
+            QVector<T> decoded(count);
+            if (count < 1) { return decoded; }
+
+            T *data = decoded.data();
+            std::atomic_int next { 0 };
+            const auto decodeChunks = [ & ]
+            {
+                auto decode = createDecoder();
+                for (int first = next.fetch_add(chunkSize); first < count; first = next.fetch_add(chunkSize))
+                {
+                    const int last = qMin(count, first + chunkSize);
+                    for (int i = first; i < last; i++) { data[i] = decode(array.at(i).toObject()); }
+                }
+            };
+
+            const int chunks = (count + chunkSize - 1) / chunkSize;
+            runInThreads(qBound(1, QThread::idealThreadCount(), chunks), decodeChunks);
+            return decoded;
+        }
+    } // namespace
+} // namespace
+
+#endif // guard
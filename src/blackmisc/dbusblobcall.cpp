@@ -0,0 +1,117 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/dbusblobcall.h"
+#include "blackmisc/logcategory.h"
+#include "blackmisc/logmessage.h"
+
+#include <QDataStream>
+#include <QMetaMethod>
+#include <QMetaObject>
+#include <QObject>
+#include <array>
+
+namespace BlackMisc
+{
+    namespace
+    {
+        //! Same version on both sides, independent of the Qt version
+        constexpr int StreamVersion = QDataStream::Qt_5_6;
+    }
+
+    const QString &CDBusBlobCall::forwardingSlotName()
+    {
+        static const QString name("invokeSlotAsBlob");
+        return name;
+    }
+
+    QByteArray CDBusBlobCall::packArguments(const QVariantList &arguments)
+    {
+        QByteArray packed;
+        QDataStream stream(&packed, QIODevice::WriteOnly);
+        stream.setVersion(StreamVersion);
+        stream << arguments;
+        return packed;
+    }
+
+    QByteArray CDBusBlobCall::invoke(QObject *object, const QString &slotName, const QByteArray &packedArguments)
+    {
+        Q_ASSERT_X(object, Q_FUNC_INFO, "Missing object");
+        constexpr int MaxArguments = 10; // QMetaMethod::invoke
+
+        QVariantList arguments;
+        QDataStream argumentStream(packedArguments);
+        argumentStream.setVersion(StreamVersion);
+        argumentStream >> arguments;
+        if (argumentStream.status() != QDataStream::Ok || arguments.size() > MaxArguments)
+        {
+            CLogMessage(CLogCategory::dbus()).warning(u"Cannot read arguments for '%1'") << slotName;
+            return {};
+        }
+
+        if (slotName == forwardingSlotName()) { return {}; } // no recursion
+        const QByteArray name = slotName.toLatin1();
+        const QMetaObject *metaObject = object->metaObject();
+        for (int i = 0; i < metaObject->methodCount(); i++)
+        {
+            // only what DBus exports anyway
+            const QMetaMethod method = metaObject->method(i);
+            if (method.methodType() != QMetaMethod::Slot || method.access() != QMetaMethod::Public) { continue; }
+            if (method.name() != name || method.parameterCount() != arguments.size()) { continue; }
+
+            QVariantList converted(arguments);
+            bool matching = true;
+            for (int a = 0; a < converted.size() && matching; a++)
+            {
+                const int type = method.parameterType(a);
+                matching = converted[a].userType() == type || converted[a].convert(type);
+            }
+            if (!matching) { continue; } // maybe an overload
+
+            std::array<QGenericArgument, MaxArguments> args;
+            for (int a = 0; a < converted.size(); a++)
+            {
+                args[a] = QGenericArgument(QMetaType::typeName(method.parameterType(a)), converted[a].constData());
+            }
+
+            QVariant result;
+            QGenericReturnArgument returnArgument;
+            if (method.returnType() != QMetaType::Void)
+            {
+                result = QVariant(method.returnType(), nullptr);
+                returnArgument = QGenericReturnArgument(method.typeName(), result.data());
+            }
+
+            const bool ok = method.invoke(object, Qt::DirectConnection, returnArgument,
+                                          args[0], args[1], args[2], args[3], args[4], args[5], args[6], args[7], args[8], args[9]);
+            if (!ok)
+            {
+                CLogMessage(CLogCategory::dbus()).warning(u"Cannot invoke '%1'") << slotName;
+                return {};
+            }
+
+            QByteArray packed;
+            QDataStream resultStream(&packed, QIODevice::WriteOnly);
+            resultStream.setVersion(StreamVersion);
+            resultStream << result;
+            return packed;
+        }
+
+        CLogMessage(CLogCategory::dbus()).warning(u"No slot '%1' with %2 arguments") << slotName << arguments.size();
+        return {};
+    }
+
+    bool CDBusBlobCall::unpackResult(const QByteArray &packedResult, QVariant &o_result)
+    {
+        if (packedResult.isEmpty()) { return false; }
+        QDataStream stream(packedResult);
+        stream.setVersion(StreamVersion);
+        stream >> o_result;
+        return stream.status() == QDataStream::Ok;
+    }
+} // ns
@@ -0,0 +1,53 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_DBUSBLOBCALL_H
+#define BLACKMISC_DBUSBLOBCALL_H
+
+#include "blackmisc/blackmiscexport.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QVariant>
+#include <QVariantList>
+
+class QObject;
+
+namespace BlackMisc
+{
+    /*!
+     * Calls of a slot where arguments and return value travel as QDataStream blobs.
+     *
+     * DBus marshals a value object member by member, and a list element by element. For large lists
+     * (aircraft in range, ATC stations, model sets) this dominates the time of a call. A blob is a
+     * single byte array for DBus, the values are serialized and deserialized with QDataStream instead.
+     *
+     * The called object needs a slot taking the slot name and the packed arguments, which calls invoke.
+     * \sa CGenericDBusInterface::callDBusRetBlob
+     */
+    class BLACKMISC_EXPORT CDBusBlobCall
+    {
+    public:
+        //! Name of the slot forwarding to invoke
+        static const QString &forwardingSlotName();
+
+        //! Serialize the arguments of a call
+        static QByteArray packArguments(const QVariantList &arguments);
+
+        //! Call the public slot with the packed arguments, and return the serialized return value
+        //! \return empty byte array if there is no matching slot, or the call failed
+        static QByteArray invoke(QObject *object, const QString &slotName, const QByteArray &packedArguments);
+
+        //! Deserialize a return value
+        static bool unpackResult(const QByteArray &packedResult, QVariant &o_result);
+    };
+} // ns
+
+#endif // guard
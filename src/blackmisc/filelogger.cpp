@@ -20,8 +20,10 @@
 #include <QFlags>
 #include <QIODevice>
 #include <QLatin1String>
+#include <QMutexLocker>
 #include <QString>
 #include <QStringBuilder>
+#include <QThread>
 #include <QtGlobal>
 
 using namespace BlackConfig;
@@ -60,6 +62,11 @@ namespace BlackMisc
         m_stream.setCodec("UTF-8");
         writeHeaderToFile();
 
+        // from here on the file is only written by the writer thread
+        m_writerThread.reset(QThread::create([this] { this->writePendingMessages(); }));
+        m_writerThread->setObjectName("CFileLogger writer");
+        m_writerThread->start(QThread::LowPriority);
+
         connect(CLogHandler::instance(), &CLogHandler::localMessageLogged, this, &CFileLogger::ps_writeStatusMessageToFile);
         connect(CLogHandler::instance(), &CLogHandler::remoteMessageLogged, this, &CFileLogger::ps_writeStatusMessageToFile);
     }
@@ -71,10 +78,24 @@ namespace BlackMisc
 
     void CFileLogger::close()
     {
+        if (!m_writerThread) { return; }
+
+        // messages still queued by the log handler
+        if (CLogHandler::instance()->thread() == QThread::currentThread()) { CLogHandler::instance()->flush(); }
+
+        disconnect(this); // disconnect from log handler
+        {
+            QMutexLocker lock(&m_pendingMutex);
+            m_stopWriting = true;
+            m_pendingCondition.wakeOne();
+        }
+        m_writerThread->wait();
+        m_writerThread.reset();
+
         if (m_logFile.isOpen())
         {
-            disconnect(this); // disconnect from log handler
             writeContentToFile(QStringLiteral("Logging stops."));
+            m_stream.flush();
             m_logFile.close();
         }
     }
@@ -87,15 +108,55 @@ namespace BlackMisc
     void CFileLogger::ps_writeStatusMessageToFile(const BlackMisc::CStatusMessage &statusMessage)
     {
         if (statusMessage.isEmpty()) { return; }
-        if (!m_logFile.isOpen()) { return; }
+        if (!m_writerThread) { return; }
         if (! m_logPattern.match(statusMessage)) { return; }
+
+        QMutexLocker lock(&m_pendingMutex);
+        m_pendingMessages.push_back(statusMessage);
+
+        // errors are written at once, the application could be about to crash
+        if (statusMessage.getSeverity() == CStatusMessage::SeverityError || m_pendingMessages.size() >= WriteBatchSize)
+        {
+            m_writeNow = true;
+            m_pendingCondition.wakeOne();
+        }
+    }
+
+    void CFileLogger::writePendingMessages()
+    {
+        QVector<CStatusMessage> messages;
+        bool stop = false;
+        while (!stop)
+        {
+            {
+                QMutexLocker lock(&m_pendingMutex);
+                if (!m_writeNow && !m_stopWriting) { m_pendingCondition.wait(&m_pendingMutex, WriteIntervalMs); }
+                messages.swap(m_pendingMessages);
+                m_writeNow = false;
+                stop = m_stopWriting;
+            }
+
+            if (messages.isEmpty()) { continue; }
+            if (m_logFile.isOpen())
+            {
+                for (const CStatusMessage &message : messages) { writeStatusMessage(message); }
+                m_stream.flush();
+            }
+            messages.clear();
+        }
+    }
+
+    void CFileLogger::writeStatusMessage(const CStatusMessage &statusMessage)
+    {
         const QString categories = statusMessage.getCategoriesAsString();
         if (categories != m_previousCategories)
         {
             writeContentToFile(u"\n[" % categories % u']');
             m_previousCategories = categories;
         }
-        const QString finalContent(QDateTime::currentDateTime().toString(QStringLiteral("hh:mm:ss "))
+
+        // time when the message was logged, not when it is written
+        const QString finalContent(QDateTime::fromMSecsSinceEpoch(statusMessage.getMSecsSinceEpoch()).toString(QStringLiteral("hh:mm:ss "))
                                    % statusMessage.getSeverityAsString()
                                    % u": "
                                    % statusMessage.getMessage());
@@ -146,6 +207,6 @@ namespace BlackMisc
 
     void CFileLogger::writeContentToFile(const QString &content)
     {
-        m_stream << content << Qt::endl;
+        m_stream << content << '\n';
     }
 }
@@ -16,13 +16,20 @@
 #include "blackmisc/statusmessage.h"
 
 #include <QFile>
+#include <QMutex>
 #include <QObject>
 #include <QString>
 #include <QTextStream>
+#include <QVector>
+#include <QWaitCondition>
+#include <memory>
+
+class QThread;
 
 namespace BlackMisc
 {
     //! Class to write log messages to file
+    //! \remark messages are formatted and written in batches by a background thread
     class BLACKMISC_EXPORT CFileLogger : public QObject
     {
         Q_OBJECT
@@ -52,15 +59,32 @@ namespace BlackMisc
         void ps_writeStatusMessageToFile(const BlackMisc::CStatusMessage &statusMessage);
 
     private:
+        //! Max. time a message waits before it is written
+        static constexpr unsigned long WriteIntervalMs = 250;
+
+        //! Number of pending messages which are written at once
+        static constexpr int WriteBatchSize = 256;
+
         void removeOldLogFiles();
         void writeHeaderToFile();
         void writeContentToFile(const QString &content);
+        void writeStatusMessage(const CStatusMessage &statusMessage);
+
+        //! Loop of the writer thread, writing the pending messages until stopped
+        void writePendingMessages();
 
         CLogPattern m_logPattern;
         QFile m_logFile;
         QString m_fileName;
         QTextStream m_stream;
         QString m_previousCategories;
+        std::unique_ptr<QThread> m_writerThread;
+
+        QMutex m_pendingMutex;
+        QWaitCondition m_pendingCondition;
+        QVector<CStatusMessage> m_pendingMessages; //!< guarded by m_pendingMutex
+        bool m_writeNow = false;                   //!< guarded by m_pendingMutex
+        bool m_stopWriting = false;                //!< guarded by m_pendingMutex
     };
 }
 
@@ -11,6 +11,7 @@
 #ifndef BLACKMISC_GENERICDBUSINTERFACE_H
 #define BLACKMISC_GENERICDBUSINTERFACE_H
 
+#include "blackmisc/dbusblobcall.h"
 #include "blackmisc/logmessage.h"
 #include "blackmisc/promise.h"
 #include <QDBusAbstractInterface>
@@ -90,6 +91,38 @@ namespace BlackMisc
             return pr;
         }
 
+        //! Call DBus with synchronous return value, arguments and return value are transferred as QDataStream blobs
+        //! \remark for large values, avoids marshalling them element by element
+        //! \remark falls back to callDBusRet if the remote side does not support blobs
+        //! \sa CDBusBlobCall
+        template <typename Ret, typename... Args>
+        Ret callDBusRetBlob(QLatin1String method, Args &&... args)
+        {
+            if (!m_blobCallsEnabled) { return this->callDBusRet<Ret>(method, std::forward<Args>(args)...); }
+
+            const QByteArray packedArguments = CDBusBlobCall::packArguments({ QVariant::fromValue(args)... });
+            QDBusPendingReply<QByteArray> pr = this->asyncCall(CDBusBlobCall::forwardingSlotName(), QString(method), packedArguments);
+            pr.waitForFinished();
+
+            QVariant result;
+            if (pr.isError() || !CDBusBlobCall::unpackResult(pr.value(), result) || !result.canConvert<Ret>())
+            {
+                if (pr.isError())
+                {
+                    CLogMessage(this).debug(u"CGenericDBusInterface::callDBusRetBlob(%1) returned: %2") << method << pr.error().message();
+                    if (pr.error().type() == QDBusError::UnknownMethod) { m_blobCallsEnabled = false; } // remote side without blob support
+                }
+                return this->callDBusRet<Ret>(method, std::forward<Args>(args)...);
+            }
+            return result.value<Ret>();
+        }
+
+        //! Enable/disable blob calls, disabled callDBusRetBlob is the same as callDBusRet
+        void setBlobCallsEnabled(bool enabled) { m_blobCallsEnabled = enabled; }
+
+        //! Blob calls enabled?
+        bool isBlobCallsEnabled() const { return m_blobCallsEnabled; }
+
         //! Call DBus with asynchronous return value
         //! Callback can be any callable object taking a single argument of type QDBusPendingCallWatcher*.
         template <typename Func, typename... Args>
@@ -121,6 +154,9 @@ namespace BlackMisc
                 delete w;
             }
         }
+
+    private:
+        bool m_blobCallsEnabled = true; //!< use blobs for callDBusRetBlob
     };
 } // ns
 
@@ -9,6 +9,7 @@
 #include "blackmisc/geo/geoobjectlist.h"
 #include "blackmisc/geo/geo.h"
 #include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/geo/geospatialindex.h"
 #include "blackmisc/aviation/atcstationlist.h"
 #include "blackmisc/aviation/airportlist.h"
 #include "blackmisc/aviation/atcstationlist.h"
@@ -226,6 +227,36 @@ namespace BlackMisc
             return closest;
         }
 
+        template<class OBJ, class CONTAINER>
+        CONTAINER IGeoObjectList<OBJ, CONTAINER>::findWithinRange(const CGeoSpatialIndex &index, const ICoordinateGeodetic &coordinate, const CLength &range) const
+        {
+            return this->objectsByIds(index, index.findWithinRange(coordinate, range));
+        }
+
+        template<class OBJ, class CONTAINER>
+        CONTAINER IGeoObjectList<OBJ, CONTAINER>::findClosest(const CGeoSpatialIndex &index, int number, const ICoordinateGeodetic &coordinate) const
+        {
+            return this->objectsByIds(index, index.findClosest(number, coordinate));
+        }
+
+        template<class OBJ, class CONTAINER>
+        OBJ IGeoObjectList<OBJ, CONTAINER>::findClosestWithinRange(const CGeoSpatialIndex &index, const ICoordinateGeodetic &coordinate, const CLength &range) const
+        {
+            Q_ASSERT_X(index.size() == this->container().size(), Q_FUNC_INFO, "Index not built for this list");
+            const int id = index.findClosestWithinRange(coordinate, range);
+            return id < 0 ? OBJ() : this->container()[id];
+        }
+
+        template<class OBJ, class CONTAINER>
+        CONTAINER IGeoObjectList<OBJ, CONTAINER>::objectsByIds(const CGeoSpatialIndex &index, const QVector<int> &ids) const
+        {
+            Q_ASSERT_X(index.size() == this->container().size(), Q_FUNC_INFO, "Index not built for this list");
+            Q_UNUSED(index)
+            CONTAINER objects;
+            for (int id : ids) { objects.push_back(this->container()[id]); }
+            return objects;
+        }
+
         template<class OBJ, class CONTAINER>
         void IGeoObjectList<OBJ, CONTAINER>::sortByEuclideanDistanceSquared(const ICoordinateGeodetic &coordinate)
         {
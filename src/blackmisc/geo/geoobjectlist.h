@@ -17,6 +17,7 @@
 #include "blackmisc/sequence.h"
 
 #include <QList>
+#include <QVector>
 #include <tuple>
 
 namespace BlackMisc
@@ -48,6 +49,7 @@ namespace BlackMisc
         class ICoordinateGeodetic;
         class CCoordinateGeodetic;
         class CCoordinateGeodeticList;
+        class CGeoSpatialIndex;
 
         //! List of objects with geo coordinates.
         template<class OBJ, class CONTAINER>
@@ -109,6 +111,18 @@ namespace BlackMisc
             //! Find closest within range to the given coordinate
             OBJ findClosestWithinRange(const ICoordinateGeodetic &coordinate, const PhysicalQuantities::CLength &range) const;
 
+            //! Find 0..n objects within range of given coordinate, using a spatial index of this list
+            //! \remark the index has to be built for this list, see CGeoSpatialIndex::fromObjects
+            CONTAINER findWithinRange(const CGeoSpatialIndex &index, const ICoordinateGeodetic &coordinate, const PhysicalQuantities::CLength &range) const;
+
+            //! Find 0..n objects closest to the given coordinate, using a spatial index of this list
+            //! \remark the index has to be built for this list, see CGeoSpatialIndex::fromObjects
+            CONTAINER findClosest(const CGeoSpatialIndex &index, int number, const ICoordinateGeodetic &coordinate) const;
+
+            //! Find closest within range to the given coordinate, using a spatial index of this list
+            //! \remark the index has to be built for this list, see CGeoSpatialIndex::fromObjects
+            OBJ findClosestWithinRange(const CGeoSpatialIndex &index, const ICoordinateGeodetic &coordinate, const PhysicalQuantities::CLength &range) const;
+
             //! Sort by distance
             void sortByEuclideanDistanceSquared(const ICoordinateGeodetic &coordinate);
 
@@ -124,6 +138,10 @@ namespace BlackMisc
 
             //! Container
             CONTAINER &container();
+
+        private:
+            //! Objects by index ids, in order of the ids
+            CONTAINER objectsByIds(const CGeoSpatialIndex &index, const QVector<int> &ids) const;
         };
 
         //! \cond PRIVATE
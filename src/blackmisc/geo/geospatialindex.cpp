@@ -0,0 +1,265 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/geo/geospatialindex.h"
+#include "blackmisc/pq/units.h"
+
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+using namespace BlackMisc::PhysicalQuantities;
+
+namespace BlackMisc
+{
+    namespace Geo
+    {
+        namespace
+        {
+            //! As in calculateGreatCircleDistance
+            constexpr float EarthRadiusMeters = 6371000.8f;
+
+            //! Bits per grid coordinate in a cell key
+            constexpr int KeyBits = 21;
+        }
+
+        constexpr CGeoSpatialIndex::CellKey CGeoSpatialIndex::NoCell;
+
+        template <class Visitor>
+        void CGeoSpatialIndex::visitWithinChord(const QVector3D &center, float chord, Visitor visitor) const
+        {
+            if (chord < 0) { return; }
+            const float chordSquared = chord * chord;
+            const auto visitCell = [&](const Ids &ids)
+            {
+                for (int id : ids)
+                {
+                    const QVector3D &position = m_positions[id];
+                    if ((position - center).lengthSquared() > chordSquared) { continue; }
+                    if (!visitor(id, position)) { return false; }
+                }
+                return true;
+            };
+
+            // bounding box of the sphere around center
+            const int minX = this->gridCoordinate(center.x() - chord);
+            const int maxX = this->gridCoordinate(center.x() + chord);
+            const int minY = this->gridCoordinate(center.y() - chord);
+            const int maxY = this->gridCoordinate(center.y() + chord);
+            const int minZ = this->gridCoordinate(center.z() - chord);
+            const int maxZ = this->gridCoordinate(center.z() + chord);
+            const double boxCells = static_cast<double>(maxX - minX + 1) * (maxY - minY + 1) * (maxZ - minZ + 1);
+
+            // most cells of a large box are empty (only the sphere surface is populated), then checking all cells is faster
+            if (boxCells > m_cells.size())
+            {
+                constexpr CellKey Mask = (CellKey(1) << KeyBits) - 1;
+                for (auto it = m_cells.cbegin(); it != m_cells.cend(); ++it)
+                {
+                    const int x = static_cast<int>(it.key() & Mask);
+                    const int y = static_cast<int>((it.key() >> KeyBits) & Mask);
+                    const int z = static_cast<int>((it.key() >> (2 * KeyBits)) & Mask);
+                    if (x < minX || x > maxX || y < minY || y > maxY || z < minZ || z > maxZ) { continue; }
+                    if (!visitCell(it.value())) { return; }
+                }
+                return;
+            }
+
+            for (int x = minX; x <= maxX; ++x)
+            {
+                for (int y = minY; y <= maxY; ++y)
+                {
+                    for (int z = minZ; z <= maxZ; ++z)
+                    {
+                        const CellKey key = static_cast<CellKey>(x) | static_cast<CellKey>(y) << KeyBits | static_cast<CellKey>(z) << (2 * KeyBits);
+                        const auto it = m_cells.constFind(key);
+                        if (it == m_cells.cend()) { continue; }
+                        if (!visitCell(it.value())) { return; }
+                    }
+                }
+            }
+        }
+
+        CGeoSpatialIndex::CGeoSpatialIndex(const QVector<QVector3D> &normalVectors, double cellSize) :
+            m_positions(normalVectors)
+        {
+            m_cellSize = cellSize > 0 ? qBound(1.0e-5, cellSize, 2.0) : defaultCellSize(normalVectors.size());
+            m_inverseCellSize = 1.0 / m_cellSize;
+            m_gridSize = static_cast<int>(std::ceil(2.0 * m_inverseCellSize));
+
+            m_cellById.fill(NoCell, m_positions.size());
+            m_cells.reserve(m_positions.size());
+            for (int id = 0; id < m_positions.size(); ++id) { this->insertIntoCell(id); }
+        }
+
+        int CGeoSpatialIndex::add(const ICoordinateGeodetic &position)
+        {
+            const int id = m_positions.size();
+            m_positions.push_back(normalVectorOrNull(position));
+            m_cellById.push_back(NoCell);
+            this->insertIntoCell(id);
+            return id;
+        }
+
+        void CGeoSpatialIndex::update(int id, const ICoordinateGeodetic &position)
+        {
+            Q_ASSERT_X(id >= 0 && id < m_positions.size(), Q_FUNC_INFO, "Wrong id");
+            const CellKey oldKey = m_cellById[id];
+            m_positions[id] = normalVectorOrNull(position);
+            if (this->cellKey(m_positions[id]) == oldKey) { return; } // moved within the cell
+
+            if (oldKey != NoCell)
+            {
+                const auto it = m_cells.find(oldKey);
+                Q_ASSERT_X(it != m_cells.end(), Q_FUNC_INFO, "Missing cell");
+                it->removeOne(id);
+                if (it->isEmpty()) { m_cells.erase(it); }
+            }
+            this->insertIntoCell(id);
+        }
+
+        CGeoSpatialIndex::Ids CGeoSpatialIndex::findWithinRange(const ICoordinateGeodetic &coordinate, const CLength &range) const
+        {
+            Ids ids;
+            if (range.isNull() || coordinate.isNull() || m_cells.isEmpty()) { return ids; }
+
+            const QVector3D center = coordinate.normalVector();
+            const double rangeM = range.value(CLengthUnit::m());
+            this->visitWithinChord(center, filterChord(range), [&](int id, const QVector3D & position)
+            {
+                if (static_cast<double>(greatCircleDistanceM(position, center)) <= rangeM) { ids.push_back(id); }
+                return true;
+            });
+            std::sort(ids.begin(), ids.end());
+            return ids;
+        }
+
+        bool CGeoSpatialIndex::containsObjectInRange(const ICoordinateGeodetic &coordinate, const CLength &range) const
+        {
+            if (range.isNull() || coordinate.isNull() || m_cells.isEmpty()) { return false; }
+
+            bool found = false;
+            const QVector3D center = coordinate.normalVector();
+            const double rangeM = range.value(CLengthUnit::m());
+            this->visitWithinChord(center, filterChord(range), [&](int, const QVector3D & position)
+            {
+                found = static_cast<double>(greatCircleDistanceM(position, center)) <= rangeM;
+                return !found;
+            });
+            return found;
+        }
+
+        CGeoSpatialIndex::Ids CGeoSpatialIndex::findClosest(int number, const ICoordinateGeodetic &coordinate) const
+        {
+            Ids ids;
+            if (number < 1 || coordinate.isNull() || m_cells.isEmpty()) { return ids; }
+
+            struct Candidate
+            {
+                float distanceSquared;
+                int id;
+                bool operator <(const Candidate &other) const { return distanceSquared < other.distanceSquared || (distanceSquared == other.distanceSquared && id < other.id); }
+            };
+
+            // everything outside a chord is farther than everything inside,
+            // so once there are enough candidates within the chord the closest ones are among them
+            const QVector3D center = coordinate.normalVector();
+            QVector<Candidate> candidates;
+            for (float chord = static_cast<float>(m_cellSize); ; chord *= 2.0f)
+            {
+                candidates.clear();
+                this->visitWithinChord(center, chord, [&](int id, const QVector3D & position)
+                {
+                    candidates.push_back({ (position - center).lengthSquared(), id });
+                    return true;
+                });
+                if (candidates.size() >= number || chord > 2.0f) { break; } // 2 is the diameter of the unit sphere
+            }
+
+            const int n = qMin(number, candidates.size());
+            std::partial_sort(candidates.begin(), candidates.begin() + n, candidates.end());
+            ids.reserve(n);
+            for (int i = 0; i < n; ++i) { ids.push_back(candidates[i].id); }
+            return ids;
+        }
+
+        int CGeoSpatialIndex::findClosestWithinRange(const ICoordinateGeodetic &coordinate, const CLength &range) const
+        {
+            if (range.isNull() || coordinate.isNull() || m_cells.isEmpty()) { return -1; }
+
+            int closestId = -1;
+            float closestDistanceM = 0;
+            const QVector3D center = coordinate.normalVector();
+            const double rangeM = range.value(CLengthUnit::m());
+            this->visitWithinChord(center, filterChord(range), [&](int id, const QVector3D & position)
+            {
+                const float distanceM = greatCircleDistanceM(position, center);
+                if (static_cast<double>(distanceM) > rangeM) { return true; }
+
+                // first one wins for equal distances, as in the list
+                if (closestId < 0 || distanceM < closestDistanceM || (distanceM == closestDistanceM && id < closestId))
+                {
+                    closestId = id;
+                    closestDistanceM = distanceM;
+                }
+                return true;
+            });
+            return closestId;
+        }
+
+        double CGeoSpatialIndex::defaultCellSize(int numberOfPositions)
+        {
+            // the sphere (area 4 pi) crosses about 4 pi / s^2 cells of size s, aim for some objects per cell
+            constexpr double ObjectsPerCell = 4.0;
+            const double n = qMax(256, numberOfPositions);
+            return qBound(1.0e-3, std::sqrt(ObjectsPerCell * 4.0 * M_PI / n), 0.5);
+        }
+
+        QVector3D CGeoSpatialIndex::normalVectorOrNull(const ICoordinateGeodetic &position)
+        {
+            return position.isNull() ? QVector3D() : position.normalVector();
+        }
+
+        CGeoSpatialIndex::CellKey CGeoSpatialIndex::cellKey(const QVector3D &position) const
+        {
+            if (position.isNull()) { return NoCell; }
+            return  static_cast<CellKey>(this->gridCoordinate(position.x())) |
+                    static_cast<CellKey>(this->gridCoordinate(position.y())) << KeyBits |
+                    static_cast<CellKey>(this->gridCoordinate(position.z())) << (2 * KeyBits);
+        }
+
+        int CGeoSpatialIndex::gridCoordinate(float value) const
+        {
+            const int c = static_cast<int>(std::floor((static_cast<double>(value) + 1.0) * m_inverseCellSize));
+            return qBound(0, c, m_gridSize - 1);
+        }
+
+        void CGeoSpatialIndex::insertIntoCell(int id)
+        {
+            const CellKey key = this->cellKey(m_positions[id]);
+            m_cellById[id] = key;
+            if (key != NoCell) { m_cells[key].push_back(id); }
+        }
+
+        float CGeoSpatialIndex::filterChord(const CLength &range)
+        {
+            const double angle = range.value(CLengthUnit::m()) / static_cast<double>(EarthRadiusMeters);
+            if (angle < 0) { return -1.0f; }
+            if (angle >= M_PI) { return 3.0f; } // whole sphere
+
+            // some margin, the exact check is done with the great circle distance
+            const double chord = 2.0 * std::sin(angle / 2.0);
+            return static_cast<float>(chord * 1.0001 + 1.0e-6);
+        }
+
+        float CGeoSpatialIndex::greatCircleDistanceM(const QVector3D &v1, const QVector3D &v2)
+        {
+            return EarthRadiusMeters * std::atan2(QVector3D::crossProduct(v1, v2).length(), QVector3D::dotProduct(v1, v2));
+        }
+    } // namespace
+} // namespace
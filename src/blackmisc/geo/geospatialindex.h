@@ -0,0 +1,141 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_GEO_GEOSPATIALINDEX_H
+#define BLACKMISC_GEO_GEOSPATIALINDEX_H
+
+#include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/pq/length.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QHash>
+#include <QVector>
+#include <QVector3D>
+
+namespace BlackMisc
+{
+    namespace Geo
+    {
+        //! Spatial index over the positions of a list of geo objects, for range and closest queries in sub-linear time
+        //! \remark an object is identified by its position in the indexed list (id)
+        //! \remark positions are the normal vectors (points on the unit sphere), bucketed in a uniform grid of cubic cells
+        //! \remark distances are calculated as in calculateGreatCircleDistance and calculateEuclideanDistanceSquared,
+        //!         so results are the same as with the linear IGeoObjectList functions. Objects with NULL position are never found.
+        //! \threadsafe for concurrent queries, add and update need external synchronization
+        class BLACKMISC_EXPORT CGeoSpatialIndex
+        {
+        public:
+            //! Object ids, i.e. positions in the indexed list
+            using Ids = QVector<int>;
+
+            //! Default constructor, empty index
+            CGeoSpatialIndex() : CGeoSpatialIndex(QVector<QVector3D>()) {}
+
+            //! Index for the given normal vectors
+            //! \param normalVectors positions, a NULL vector for objects without position
+            //! \param cellSize      edge length of the grid cells (unit sphere), <= 0 to choose it by the number of positions
+            explicit CGeoSpatialIndex(const QVector<QVector3D> &normalVectors, double cellSize = -1);
+
+            //! Index for any list of ICoordinateGeodetic objects
+            template <class CONTAINER>
+            static CGeoSpatialIndex fromObjects(const CONTAINER &objects, double cellSize = -1)
+            {
+                QVector<QVector3D> normalVectors;
+                normalVectors.reserve(objects.size());
+                for (const auto &object : objects) { normalVectors.push_back(normalVectorOrNull(object)); }
+                return CGeoSpatialIndex(normalVectors, cellSize);
+            }
+
+            //! Index for any list of objects with a position, e.g. weather grid points
+            //! \param position returns the ICoordinateGeodetic of an object
+            template <class CONTAINER, class F>
+            static CGeoSpatialIndex fromPositions(const CONTAINER &objects, F position, double cellSize = -1)
+            {
+                QVector<QVector3D> normalVectors;
+                normalVectors.reserve(objects.size());
+                for (const auto &object : objects) { normalVectors.push_back(normalVectorOrNull(position(object))); }
+                return CGeoSpatialIndex(normalVectors, cellSize);
+            }
+
+            //! Number of indexed objects, including those with NULL position
+            int size() const { return m_positions.size(); }
+
+            //! Empty index?
+            bool isEmpty() const { return m_positions.isEmpty(); }
+
+            //! Edge length of the grid cells
+            double getCellSize() const { return m_cellSize; }
+
+            //! Indexed position
+            const QVector3D &normalVector(int id) const { return m_positions[id]; }
+
+            //! Append a position, the id is the next position in the indexed list
+            //! \return id of the new position
+            int add(const ICoordinateGeodetic &position);
+
+            //! Position of an object changed
+            void update(int id, const ICoordinateGeodetic &position);
+
+            //! Ids of objects within range, in ascending order
+            //! \sa IGeoObjectList::findWithinRange
+            Ids findWithinRange(const ICoordinateGeodetic &coordinate, const PhysicalQuantities::CLength &range) const;
+
+            //! Any object within range?
+            //! \sa IGeoObjectList::containsObjectInRange
+            bool containsObjectInRange(const ICoordinateGeodetic &coordinate, const PhysicalQuantities::CLength &range) const;
+
+            //! Ids of the n closest objects, closest first
+            //! \sa IGeoObjectList::findClosest
+            Ids findClosest(int number, const ICoordinateGeodetic &coordinate) const;
+
+            //! Id of the closest object within range, -1 if there is none
+            //! \sa IGeoObjectList::findClosestWithinRange
+            int findClosestWithinRange(const ICoordinateGeodetic &coordinate, const PhysicalQuantities::CLength &range) const;
+
+            //! Default cell size for a number of positions
+            static double defaultCellSize(int numberOfPositions);
+
+        private:
+            using CellKey = quint64;
+            static constexpr CellKey NoCell = ~CellKey(0);
+
+            //! Normal vector, NULL vector for NULL position
+            static QVector3D normalVectorOrNull(const ICoordinateGeodetic &position);
+
+            //! Cell of a position, NoCell for a NULL position
+            CellKey cellKey(const QVector3D &position) const;
+
+            //! Grid coordinate of a value in [-1, 1]
+            int gridCoordinate(float value) const;
+
+            //! Add id to its cell
+            void insertIntoCell(int id);
+
+            //! Call visitor for all ids with a straight line (chord) distance <= chord
+            template <class Visitor>
+            void visitWithinChord(const QVector3D &center, float chord, Visitor visitor) const;
+
+            //! Chord on the unit sphere for a great circle distance, slightly larger to be used as filter
+            static float filterChord(const PhysicalQuantities::CLength &range);
+
+            //! Same as calculateGreatCircleDistance in meters
+            static float greatCircleDistanceM(const QVector3D &v1, const QVector3D &v2);
+
+            double m_cellSize = 1.0;               //!< edge length of a cell
+            double m_inverseCellSize = 1.0;        //!< 1 / cell size
+            int m_gridSize = 2;                    //!< cells per axis
+            QVector<QVector3D> m_positions;        //!< position by id
+            QVector<CellKey> m_cellById;           //!< cell by id
+            QHash<CellKey, Ids> m_cells;           //!< ids by cell, only non empty cells
+        };
+    } // namespace
+} // namespace
+
+#endif // guard
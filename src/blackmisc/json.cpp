@@ -14,6 +14,7 @@
 #include <QJsonDocument>
 #include <QList>
 #include <QStringList>
+#include <cstring>
 
 using namespace BlackMisc;
 
@@ -437,6 +438,130 @@ namespace BlackMisc
             return jsonDoc.array();
         }
 
+        namespace
+        {
+            //! Position of the first non whitespace character
+            int skipWhitespace(const char *data, int size, int pos)
+            {
+                while (pos < size && (data[pos] == ' ' || data[pos] == '\n' || data[pos] == '\r' || data[pos] == '\t')) { pos++; }
+                return pos;
+            }
+
+            //! Position after the string starting with the quote at pos, -1 if not terminated
+            int skipString(const char *data, int size, int pos)
+            {
+                for (int i = pos + 1; i < size; i++)
+                {
+                    if (data[i] == '\\') { i++; }
+                    else if (data[i] == '"') { return i + 1; }
+                }
+                return -1;
+            }
+
+            //! Position after the value starting at pos, -1 if malformed
+            int skipValue(const char *data, int size, int pos)
+            {
+                if (pos >= size) { return -1; }
+                if (data[pos] == '"') { return skipString(data, size, pos); }
+                if (data[pos] == '{' || data[pos] == '[')
+                {
+                    int depth = 0;
+                    for (int i = pos; i < size; i++)
+                    {
+                        switch (data[i])
+                        {
+                        case '"':
+                            i = skipString(data, size, i);
+                            if (i < 0) { return -1; }
+                            i--;
+                            break;
+                        case '{':
+                        case '[':
+                            depth++;
+                            break;
+                        case '}':
+                        case ']':
+                            if (--depth == 0) { return i + 1; }
+                            break;
+                        default:
+                            break;
+                        }
+                    }
+                    return -1;
+                }
+
+                // number, true, false, null
+                int i = pos;
+                while (i < size && data[i] != ',' && data[i] != '}' && data[i] != ']' &&
+                        data[i] != ' ' && data[i] != '\n' && data[i] != '\r' && data[i] != '\t') { i++; }
+                return i > pos ? i : -1;
+            }
+
+            //! Unquoted string
+            QString rawStringToQString(const char *data, int begin, int end)
+            {
+                const int length = end - begin - 2;
+                if (!std::memchr(data + begin + 1, '\\', static_cast<size_t>(length))) { return QString::fromUtf8(data + begin + 1, length); }
+                const QByteArray array = '[' + QByteArray(data + begin, end - begin) + ']';
+                return QJsonDocument::fromJson(array).array().at(0).toString();
+            }
+
+            //! Split object members or array elements
+            template <class Consumer>
+            bool splitRaw(const QByteArray &json, char open, char close, Consumer consumer)
+            {
+                const char *data = json.constData();
+                const int size = json.size();
+                int pos = skipWhitespace(data, size, 0);
+                if (pos >= size || data[pos] != open) { return false; }
+                pos = skipWhitespace(data, size, pos + 1);
+
+                // only whitespace may follow the closing bracket
+                if (pos < size && data[pos] == close) { return skipWhitespace(data, size, pos + 1) == size; }
+                while (pos < size)
+                {
+                    pos = consumer(data, size, pos);
+                    if (pos < 0) { return false; }
+                    pos = skipWhitespace(data, size, pos);
+                    if (pos >= size) { return false; }
+                    if (data[pos] == close) { return skipWhitespace(data, size, pos + 1) == size; }
+                    if (data[pos] != ',') { return false; }
+                    pos = skipWhitespace(data, size, pos + 1);
+                }
+                return false;
+            }
+        }
+
+        bool splitRawObjectMembers(const QByteArray &json, QHash<QString, QByteArray> &o_members)
+        {
+            o_members.clear();
+            return splitRaw(json, '{', '}', [&](const char *data, int size, int pos)
+            {
+                if (data[pos] != '"') { return -1; }
+                const int keyEnd = skipString(data, size, pos);
+                if (keyEnd < 0) { return -1; }
+                const int colon = skipWhitespace(data, size, keyEnd);
+                if (colon >= size || data[colon] != ':') { return -1; }
+                const int value = skipWhitespace(data, size, colon + 1);
+                const int valueEnd = skipValue(data, size, value);
+                if (valueEnd < 0) { return -1; }
+                o_members.insert(rawStringToQString(data, pos, keyEnd), json.mid(value, valueEnd - value));
+                return valueEnd;
+            });
+        }
+
+        bool splitRawArrayElements(const QByteArray &json, QVector<QByteArray> &o_elements)
+        {
+            o_elements.clear();
+            return splitRaw(json, '[', ']', [&](const char *data, int size, int pos)
+            {
+                const int valueEnd = skipValue(data, size, pos);
+                if (valueEnd < 0) { return -1; }
+                o_elements.push_back(json.mid(pos, valueEnd - pos));
+                return valueEnd;
+            });
+        }
+
         QJsonObject &appendJsonObject(QJsonObject &target, const QJsonObject &toBeAppended)
         {
             if (toBeAppended.isEmpty()) return target;
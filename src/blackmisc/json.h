@@ -18,12 +18,14 @@
 #include "blackmisc/jsonexception.h"
 
 #include <QByteArray>
+#include <QHash>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonValue>
 #include <QJsonValueRef>
 #include <QStringList>
+#include <QVector>
 #include <QtGlobal>
 #include <type_traits>
 #include <utility>
@@ -235,6 +237,18 @@ namespace BlackMisc
         //! \ingroup JSON
         BLACKMISC_EXPORT QJsonArray jsonArrayFromString(const QString &json);
 
+        //! Raw JSON of the member values of a JSON object, the values themselves are not parsed
+        //! \remark one pass over the bytes, no document is built. Values are only scanned for their end
+        //! \return false if the data are no (well formed) JSON object
+        //! \ingroup JSON
+        BLACKMISC_EXPORT bool splitRawObjectMembers(const QByteArray &json, QHash<QString, QByteArray> &o_members);
+
+        //! Raw JSON of the elements of a JSON array, the elements themselves are not parsed
+        //! \remark same as splitRawObjectMembers, for instance for the arrays found by splitRawObjectMembers
+        //! \return false if the data are no (well formed) JSON array
+        //! \ingroup JSON
+        BLACKMISC_EXPORT bool splitRawArrayElements(const QByteArray &json, QVector<QByteArray> &o_elements);
+
         //! First JSON string object marked as "value"
         BLACKMISC_EXPORT QString firstJsonValueAsString(const QString &json);
 
@@ -12,6 +12,7 @@
 #include "blackmisc/algorithm.h"
 #include "blackmisc/mixin/mixincompare.h"
 #include "blackmisc/crashhandler.h"
+#include "blackmisc/spscringbuffer.h"
 #include "blackmisc/threadutils.h"
 #include "blackconfig/buildconfig.h"
 
@@ -20,9 +21,11 @@
 #endif
 
 #include <QCoreApplication>
+#include <QDateTime>
 #include <QGlobalStatic>
 #include <QMessageLogContext>
 #include <QMetaMethod>
+#include <QMutexLocker>
 #include <QString>
 #include <Qt>
 #include <QtDebug>
@@ -43,11 +46,48 @@ namespace BlackMisc
         return g_handler;
     }
 
+    namespace
+    {
+        //! The installed handler, null if none is installed
+        std::atomic<CLogHandler *> g_installedHandler { nullptr };
+
+        //! Messages a thread can queue before it has to lock, i.e. until the main thread dispatches them
+        constexpr int ThreadQueueCapacity = 256;
+    }
+
+    //! Message as captured by the logging thread
+    struct CLogHandler::CapturedMessage
+    {
+        CLogCategoryList categories;
+        CStrongStringView format; //!< format string, or the message itself if preformatted
+        QStringList args;
+        qint64 msSinceEpoch = -1;
+        CStatusMessage::StatusSeverity severity = CStatusMessage::SeverityDebug;
+        bool preformatted = false;
+
+        //! Formatted message, as it would have been created by the logging thread
+        CStatusMessage toStatusMessage() const
+        {
+            CStatusMessage message(categories, severity, preformatted ? format.view().toString() : Private::arg(format.view(), args));
+            message.setMSecsSinceEpoch(msSinceEpoch);
+            return message;
+        }
+    };
+
+    //! Messages logged by one thread, only this thread pushes and only the main thread pops
+    struct CLogHandler::ThreadQueue
+    {
+        CSpscRingBuffer<CapturedMessage> ring { ThreadQueueCapacity };
+        QMutex overflowMutex;
+        QVector<CapturedMessage> overflow; //!< used while the ring is full, guarded by overflowMutex
+        std::atomic<bool> isOverflowing { false };
+        std::atomic<bool> isThreadFinished { false };
+    };
+
     //! Qt message handler
     void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &message)
     {
         const CStatusMessage statusMessage(type, context, message);
-        const auto invokee = [statusMessage] { CLogHandler::instance()->logLocalMessage(statusMessage); };
 #if defined(Q_CC_MSVC) && defined(QT_NO_DEBUG)
         if (type == QtFatalMsg)
         {
@@ -57,14 +97,28 @@ namespace BlackMisc
 #   endif
         }
 #endif
-        if (type == QtFatalMsg && CLogHandler::instance()->thread() != QThread::currentThread())
+        if (type == QtFatalMsg)
         {
-            // Fatal message means this thread is about to crash the application. A queued connection would be useless.
-            // Blocking queued connection means we pause this thread just long enough to let the main thread handle the message.
-            QMetaObject::invokeMethod(CLogHandler::instance(), invokee, Qt::BlockingQueuedConnection);
+            // Messages queued before the fatal message should not get lost.
+            const auto invokee = [statusMessage] { CLogHandler::instance()->flush(); CLogHandler::instance()->logLocalMessage(statusMessage); };
+            if (CLogHandler::instance()->thread() != QThread::currentThread())
+            {
+                // Fatal message means this thread is about to crash the application. A queued connection would be useless.
+                // Blocking queued connection means we pause this thread just long enough to let the main thread handle the message.
+                QMetaObject::invokeMethod(CLogHandler::instance(), invokee, Qt::BlockingQueuedConnection);
+                return;
+            }
+            QMetaObject::invokeMethod(CLogHandler::instance(), invokee);
             return;
         }
-        QMetaObject::invokeMethod(CLogHandler::instance(), invokee);
+
+        CLogHandler::CapturedMessage captured;
+        captured.categories = statusMessage.getCategories();
+        captured.format = statusMessage.getMessage();
+        captured.msSinceEpoch = statusMessage.getMSecsSinceEpoch();
+        captured.severity = statusMessage.getSeverity();
+        captured.preformatted = true;
+        CLogHandler::instance()->enqueue(std::move(captured));
     }
 
     void CLogHandler::install(bool skipIfAlreadyInstalled)
@@ -72,6 +126,10 @@ namespace BlackMisc
         if (skipIfAlreadyInstalled && m_oldHandler) { return; }
         Q_ASSERT_X(!m_oldHandler, Q_FUNC_INFO, "Re-installing the log handler should be avoided");
         m_oldHandler = qInstallMessageHandler(messageHandler);
+        g_installedHandler = this;
+
+        // whatever is still queued when the event loop ends
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &CLogHandler::flush);
     }
 
     CLogHandler::CLogHandler()
@@ -82,6 +140,8 @@ namespace BlackMisc
 
     CLogHandler::~CLogHandler()
     {
+        CLogHandler *self = this;
+        g_installedHandler.compare_exchange_strong(self, nullptr);
         qInstallMessageHandler(m_oldHandler);
     }
 
@@ -211,6 +271,127 @@ namespace BlackMisc
         }
     }
 
+    void CLogHandler::flush()
+    {
+        Q_ASSERT_X(thread() == QThread::currentThread(), Q_FUNC_INFO, "Wrong thread");
+        this->dispatchQueuedMessages();
+    }
+
+    bool CLogHandler::logDeferred(const CLogCategoryList &categories, CStatusMessage::StatusSeverity severity, const CStrongStringView &format, const QStringList &args)
+    {
+        CLogHandler *handler = g_installedHandler.load(std::memory_order_acquire);
+        if (!handler || categories.isEmpty()) { return false; }
+
+        CapturedMessage captured;
+        captured.categories = categories;
+        captured.format = format;
+        captured.args = args;
+        captured.msSinceEpoch = QDateTime::currentMSecsSinceEpoch();
+        captured.severity = severity;
+        handler->enqueue(std::move(captured));
+        return true;
+    }
+
+    void CLogHandler::enqueue(CapturedMessage &&message)
+    {
+        // m_isDispatching is only used by the main thread, so check the thread first
+        if (QThread::currentThread() == thread() && !m_isDispatching)
+        {
+            // messages of the main thread are delivered at once, after the messages queued before
+            if (m_dispatchPending.load()) { this->dispatchQueuedMessages(); }
+            m_isDispatching = true; // messages logged by the subscribers are queued
+            this->logLocalMessage(message.toStatusMessage());
+            m_isDispatching = false;
+            return;
+        }
+
+        //! Queue of the calling thread, the main thread removes it once the thread has finished
+        struct ThreadQueueRef
+        {
+            std::shared_ptr<ThreadQueue> queue;
+            ~ThreadQueueRef() { if (queue) { queue->isThreadFinished = true; } }
+        };
+        thread_local ThreadQueueRef t_queue;
+
+        if (!t_queue.queue)
+        {
+            t_queue.queue = std::make_shared<ThreadQueue>();
+            QMutexLocker lock(&m_queuesMutex);
+            m_queues.push_back(t_queue.queue);
+        }
+
+        // the format string could be a view of a string which is gone when the message is formatted
+        if (!message.format.isOwning()) { message.format = message.format.convertToQString(); }
+
+        ThreadQueue &queue = *t_queue.queue;
+        if (queue.isOverflowing.load(std::memory_order_acquire) || !queue.ring.tryPush(std::move(message)))
+        {
+            // once overflowing, all messages go to the overflow until the main thread has taken it, so the order is kept
+            QMutexLocker lock(&queue.overflowMutex);
+            queue.overflow.push_back(std::move(message));
+            queue.isOverflowing.store(true, std::memory_order_release);
+        }
+
+        if (!m_dispatchPending.exchange(true))
+        {
+            QMetaObject::invokeMethod(this, &CLogHandler::dispatchQueuedMessages, Qt::QueuedConnection);
+        }
+    }
+
+    QVector<CLogHandler::CapturedMessage> CLogHandler::takeQueuedMessages()
+    {
+        QVector<CapturedMessage> messages;
+        QMutexLocker lock(&m_queuesMutex);
+        for (auto it = m_queues.begin(); it != m_queues.end();)
+        {
+            ThreadQueue &queue = **it;
+            const bool isThreadFinished = queue.isThreadFinished.load(); // before popping, a finished thread pushes nothing afterwards
+
+            CapturedMessage message;
+            for (int i = queue.ring.capacity(); i > 0 && queue.ring.tryPop(message); --i)
+            {
+                messages.push_back(std::move(message));
+            }
+
+            // while overflowing the thread does not push to the ring, so an empty ring means the overflow is next
+            if (queue.isOverflowing.load(std::memory_order_acquire) && queue.ring.isEmpty())
+            {
+                QMutexLocker overflowLock(&queue.overflowMutex);
+                for (CapturedMessage &overflowed : queue.overflow) { messages.push_back(std::move(overflowed)); }
+                queue.overflow.clear();
+                queue.isOverflowing.store(false, std::memory_order_release);
+            }
+
+            if (isThreadFinished && queue.ring.isEmpty() && !queue.isOverflowing.load()) { it = m_queues.erase(it); }
+            else { ++it; }
+        }
+        return messages;
+    }
+
+    void CLogHandler::dispatchQueuedMessages()
+    {
+        Q_ASSERT_X(thread() == QThread::currentThread(), Q_FUNC_INFO, "Wrong thread");
+
+        // messages logged by the subscribers are dispatched by the loop below
+        if (m_isDispatching) { return; }
+        m_isDispatching = true;
+
+        // a few batches at most, so a thread flooding the log does not block the event loop
+        for (int batch = 0; batch < 4 && m_dispatchPending.exchange(false); batch++)
+        {
+            for (const CapturedMessage &message : this->takeQueuedMessages())
+            {
+                this->logLocalMessage(message.toStatusMessage());
+            }
+        }
+        m_isDispatching = false;
+
+        if (m_dispatchPending.load())
+        {
+            QMetaObject::invokeMethod(this, &CLogHandler::dispatchQueuedMessages, Qt::QueuedConnection);
+        }
+    }
+
     void CLogHandler::removePatternHandler(CLogPatternHandler *handler)
     {
         auto it = std::find_if(m_patternHandlers.begin(), m_patternHandlers.end(), [handler](const PatternPair & pair)
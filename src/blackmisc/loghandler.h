@@ -21,13 +21,17 @@
 #include <QHash>
 #include <QMetaMethod>
 #include <QMetaObject>
+#include <QMutex>
 #include <QObject>
 #include <QPointer>
+#include <QStringList>
 #include <QThread>
 #include <QTimer>
+#include <QVector>
 #include <QtGlobal>
 #include <QtMessageHandler>
 #include <atomic>
+#include <memory>
 #include <utility>
 
 namespace BlackMisc
@@ -36,6 +40,10 @@ namespace BlackMisc
 
     /*!
      * Class for subscribing to log messages.
+     *
+     * Messages logged in the main thread are delivered at once. Messages logged in any other thread are put into a
+     * queue of that thread and dispatched in batches by the main thread, so the logging thread neither formats the
+     * message nor waits for the subscribers.
      */
     class BLACKMISC_EXPORT CLogHandler : public QObject
     {
@@ -73,6 +81,15 @@ namespace BlackMisc
         //! Returns all log patterns for which there are currently subscribed log pattern handlers.
         QList<CLogPattern> getAllSubscriptions() const;
 
+        //! Dispatch all queued messages now, instead of the next time around the event loop.
+        //! \warning This must only be called from the main thread.
+        void flush();
+
+        //! \private Called by CLogMessage to queue a message which is only formatted when it is dispatched.
+        //! \return false if no handler is installed, then the message must be passed to Qt's message handler.
+        //! \threadsafe Delivered at once in the main thread. Lock-free in other threads, the message is dispatched by the main thread.
+        static bool logDeferred(const CLogCategoryList &categories, CStatusMessage::StatusSeverity severity, const CStrongStringView &format, const QStringList &args);
+
     signals:
         //! Emitted when a message is logged in this process.
         void localMessageLogged(const BlackMisc::CStatusMessage &message);
@@ -98,6 +115,16 @@ namespace BlackMisc
 
     private:
         friend class CLogPatternHandler;
+        friend void messageHandler(QtMsgType, const QMessageLogContext &, const QString &);
+        struct CapturedMessage;
+        struct ThreadQueue;
+        void enqueue(CapturedMessage &&message);
+        void dispatchQueuedMessages();
+        QVector<CapturedMessage> takeQueuedMessages();
+        QMutex m_queuesMutex; //!< guards m_queues, not the queues themselves
+        QVector<std::shared_ptr<ThreadQueue>> m_queues; //!< one queue per thread which has logged
+        std::atomic<bool> m_dispatchPending { false };
+        bool m_isDispatching = false; //!< only used by the main thread
         void logMessage(const BlackMisc::CStatusMessage &message);
         QtMessageHandler m_oldHandler = nullptr;
         bool m_enableFallThrough = true;
@@ -9,6 +9,7 @@
 //! \cond PRIVATE
 
 #include "blackmisc/logmessage.h"
+#include "blackmisc/loghandler.h"
 
 namespace BlackMisc
 {
@@ -29,6 +30,9 @@ namespace BlackMisc
 
     CLogMessage::~CLogMessage()
     {
+        // formatted later by the log handler, not by this thread
+        if (CLogHandler::logDeferred(m_categories, m_severity, m_message, m_args)) { return; }
+
         ostream(qtCategory()).noquote() << message();
     }
 
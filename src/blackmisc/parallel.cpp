@@ -0,0 +1,92 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/parallel.h"
+
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+#include <QtGlobal>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace BlackMisc
+{
+    namespace
+    {
+        //! Pool shared by all parallel work
+        Q_GLOBAL_STATIC(QThreadPool, g_pool)
+
+        //! Runs the work in the pool and signals when done
+        //! \remark owned by the caller of runInThreads, not deleted by the pool
+        class CParallelRunnable : public QRunnable
+        {
+        public:
+            //! Constructor
+            CParallelRunnable(const std::function<void()> &work, QSemaphore &done) : m_work(work), m_done(done)
+            {
+                this->setAutoDelete(false);
+            }
+
+            //! \copydoc QRunnable::run
+            virtual void run() override
+            {
+                m_work();
+                m_done.release(); // last access, the caller might delete this runnable now
+            }
+
+        private:
+            const std::function<void()> &m_work;
+            QSemaphore &m_done;
+        };
+    }
+
+    void runInThreads(int threads, const std::function<void()> &work)
+    {
+        QThreadPool *pool = g_pool();
+        if (threads < 2 || !pool) { work(); return; }
+
+        QSemaphore done;
+        std::vector<std::unique_ptr<CParallelRunnable>> runnables;
+        for (int t = 1; t < threads; t++)
+        {
+            runnables.push_back(std::make_unique<CParallelRunnable>(work, done));
+            pool->start(runnables.back().get());
+        }
+
+        // the calling thread works as well, afterwards only the copies already running are waited for
+        work();
+        int running = 0;
+        for (const std::unique_ptr<CParallelRunnable> &runnable : runnables)
+        {
+            if (!pool->tryTake(runnable.get())) { running++; }
+        }
+        done.acquire(running);
+    }
+
+    void runInParallel(int count, const std::function<void(int)> &work, int chunkSize)
+    {
+        if (count < 1) { return; }
+        chunkSize = qMax(1, chunkSize);
+
+        std::atomic_int next { 0 };
+        const std::function<void()> claimChunks = [ & ]
+        {
+            for (int first = next.fetch_add(chunkSize); first < count; first = next.fetch_add(chunkSize))
+            {
+                const int last = qMin(count, first + chunkSize);
+                for (int i = first; i < last; i++) { work(i); }
+            }
+        };
+
+        const int chunks = (count - 1) / chunkSize + 1;
+        runInThreads(qBound(1, QThread::idealThreadCount(), chunks), claimChunks);
+    }
+} // ns
@@ -0,0 +1,39 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_PARALLEL_H
+#define BLACKMISC_PARALLEL_H
+
+#include "blackmisc/blackmiscexport.h"
+
+#include <functional>
+
+namespace BlackMisc
+{
+    /*!
+     * Run work in up to the given number of threads, the calling thread being one of them, and wait until all are done.
+     *
+     * The other threads are taken from one thread pool shared by all callers. Each thread calls work once,
+     * so work has to claim its share itself, e.g. by an atomic counter. Copies not yet started by the pool when
+     * the calling thread has finished are not run at all: then all work was claimed anyway. So the calling thread
+     * never waits for a busy pool, and nested or concurrent calls cannot deadlock.
+     */
+    BLACKMISC_EXPORT void runInThreads(int threads, const std::function<void()> &work);
+
+    /*!
+     * Call work for 0..count-1 in parallel, see runInThreads, and wait until all are done.
+     *
+     * Indexes are claimed in chunks of chunkSize, so threads rarely meet at the counter if one call is cheap.
+     * The order of the calls is undefined, results should be written by index.
+     */
+    BLACKMISC_EXPORT void runInParallel(int count, const std::function<void(int)> &work, int chunkSize = 1);
+} // ns
+
+#endif // guard
@@ -1029,20 +1029,24 @@ namespace BlackMisc
             const int idAircraftIcao = json.value(prefixAircraftIcao % u"id").toInt(-1);
             const int idLivery = json.value(prefixLivery % u"id").toInt(-1);
 
-            const bool cachedAircraftIcao = (idAircraftIcao >= 0) && aircraftIcaos.contains(idAircraftIcao);
-            const bool cachedLivery = (idLivery >= 0) && liveries.contains(idLivery);
-            const bool cachedDistributor = !idDistributor.isEmpty() && distributors.contains(idDistributor);
+            // constFind, a lookup must not detach maps shared with other decoding threads
+            const auto itAircraftIcao = (idAircraftIcao >= 0) ? aircraftIcaos.constFind(idAircraftIcao) : aircraftIcaos.constEnd();
+            const auto itLivery = (idLivery >= 0) ? liveries.constFind(idLivery) : liveries.constEnd();
+            const auto itDistributor = !idDistributor.isEmpty() ? distributors.constFind(idDistributor) : distributors.constEnd();
+            const bool cachedAircraftIcao = itAircraftIcao != aircraftIcaos.constEnd();
+            const bool cachedLivery = itLivery != liveries.constEnd();
+            const bool cachedDistributor = itDistributor != distributors.constEnd();
 
             CAircraftIcaoCode aircraftIcao(cachedAircraftIcao ?
-                                           aircraftIcaos[idAircraftIcao] :
+                                           *itAircraftIcao :
                                            CAircraftIcaoCode::fromDatabaseJson(json, prefixAircraftIcao));
 
             CLivery livery(cachedLivery ?
-                           liveries[idLivery] :
+                           *itLivery :
                            CLivery::fromDatabaseJson(json, prefixLivery));
 
             CDistributor distributor(cachedDistributor ?
-                                     distributors[idDistributor] :
+                                     *itDistributor :
                                      CDistributor::fromDatabaseJson(json, prefixDistributor));
 
             if (!aircraftIcao.isLoadedFromDb() && idAircraftIcao >= 0) { aircraftIcao.setDbKey(idAircraftIcao); }
@@ -1053,9 +1057,10 @@ namespace BlackMisc
             if (!cachedAircraftIcao)
             {
                 const int catId = aircraftIcao.getCategory().getDbKey();
-                if (catId >= 0 && categories.contains(catId))
+                const auto itCategory = (catId >= 0) ? categories.constFind(catId) : categories.constEnd();
+                if (itCategory != categories.constEnd())
                 {
-                    aircraftIcao.setCategory(categories[catId]);
+                    aircraftIcao.setCategory(*itCategory);
                 }
             }
 
@@ -8,6 +8,7 @@
 
 #include "blackmisc/simulation/aircraftmodellist.h"
 #include "blackmisc/simulation/matchingutils.h"
+#include "blackmisc/db/paralleljsondecoding.h"
 #include "blackmisc/network/networkutils.h"
 #include "blackmisc/aviation/callsign.h"
 #include "blackmisc/aviation/logutils.h"
@@ -1872,17 +1873,20 @@ namespace BlackMisc
             const CDistributorList &distributors
         )
         {
-            AircraftIcaoIdMap aircraftIcaosMap = icaos.toDbKeyValueMap();
-            LiveryIdMap       liveriesMap = liveries.toDbKeyValueMap();
-            DistributorIdMap  distributorsMap = distributors.toDbKeyValueMap();
+            const AircraftIcaoIdMap aircraftIcaosMap = icaos.toDbKeyValueMap();
+            const LiveryIdMap liveriesMap = liveries.toDbKeyValueMap();
+            const DistributorIdMap distributorsMap = distributors.toDbKeyValueMap();
             const AircraftCategoryIdMap categoriesMap = categories.toDbKeyValueMap();
 
-            CAircraftModelList models;
-            for (const QJsonValue &value : array)
+            // every thread caches in its own copy of the maps, copies are shared until a thread adds an entry
+            QVector<CAircraftModel> models = Db::decodeJsonArrayInParallel<CAircraftModel>(array, [ & ]
             {
-                models.push_back(CAircraftModel::fromDatabaseJsonCaching(value.toObject(), aircraftIcaosMap, categoriesMap, liveriesMap, distributorsMap));
-            }
-            return models;
+                return [aircraftIcaosMap = aircraftIcaosMap, liveriesMap = liveriesMap, distributorsMap = distributorsMap, &categoriesMap](const QJsonObject &json) mutable
+                {
+                    return CAircraftModel::fromDatabaseJsonCaching(json, aircraftIcaosMap, categoriesMap, liveriesMap, distributorsMap);
+                };
+            });
+            return CAircraftModelList(CSequence<CAircraftModel>(std::move(models)));
         }
 
         const QString &CAircraftModelList::invalidModelFileAndPath()
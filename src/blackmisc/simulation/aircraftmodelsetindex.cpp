@@ -0,0 +1,234 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/aircraftmodelsetindex.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/airlineicaocode.h"
+#include "blackmisc/aviation/livery.h"
+#include "blackmisc/range.h"
+
+#include <algorithm>
+#include <iterator>
+
+using namespace BlackMisc::Aviation;
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        template <typename K>
+        const CAircraftModelSetIndex::ModelIds &CAircraftModelSetIndex::idsOrEmpty(const QHash<K, ModelIds> &hash, const K &key)
+        {
+            static const ModelIds empty;
+            const auto it = hash.constFind(key);
+            return it == hash.cend() ? empty : it.value();
+        }
+
+        CAircraftModelSetIndex::CAircraftModelSetIndex(const CAircraftModelList &models) : m_models(models)
+        {
+            const int count = m_models.size();
+            m_all.reserve(count);
+            m_withModelString.reserve(count);
+            m_withDbKey.reserve(count);
+            m_withoutExcluded.reserve(count);
+
+            // ids are added in ascending order, so all id vectors are sorted
+            int id = 0;
+            for (const CAircraftModel &model : as_const(m_models))
+            {
+                const CAircraftIcaoCode &aircraftIcao = model.getAircraftIcaoCode();
+                const CAirlineIcaoCode  &airlineIcao  = model.getAirlineIcaoCode();
+                const CLivery           &livery       = model.getLivery();
+
+                m_all.push_back(id);
+                if (model.hasModelString())  { m_withModelString.push_back(id); }
+                if (model.hasValidDbKey())   { m_withDbKey.push_back(id); }
+                if (model.getModelMode() != CAircraftModel::Exclude) { m_withoutExcluded.push_back(id); }
+                if (model.isMilitary())      { m_military.push_back(id); }
+                else                         { m_civilian.push_back(id); }
+                if (model.isVtol())          { m_vtol.push_back(id); }
+                else                         { m_nonVtol.push_back(id); }
+                if (livery.isColorLivery())  { m_colorLiveries.push_back(id); }
+
+                m_byAircraftDesignator[aircraftIcao.getDesignator()].push_back(id);
+                m_byAirlineDesignator[airlineIcao.getDesignator()].push_back(id);
+                m_byCombinedType[aircraftIcao.getCombinedType()].push_back(id);
+                m_byManufacturer[aircraftIcao.getManufacturer()].push_back(id);
+                m_byManufacturerFolded[aircraftIcao.getManufacturer().toCaseFolded()].push_back(id);
+                if (aircraftIcao.hasFamily())      { m_byFamily[aircraftIcao.getFamily()].push_back(id); }
+                if (airlineIcao.getGroupId() >= 0) { m_byAirlineGroup[airlineIcao.getGroupId()].push_back(id); }
+                if (livery.hasCombinedCode())      { m_byLiveryCombinedCode[livery.getCombinedCode()].push_back(id); }
+
+                // first one wins, as with findFirstBy
+                if (model.hasModelString())
+                {
+                    const QString key = model.getModelString().toCaseFolded();
+                    if (!m_byModelString.contains(key)) { m_byModelString.insert(key, id); }
+                }
+                if (model.hasModelStringAlias())
+                {
+                    const QString key = model.getModelStringAlias().toCaseFolded();
+                    if (!m_byModelStringAlias.contains(key)) { m_byModelStringAlias.insert(key, id); }
+                }
+                id++;
+            }
+        }
+
+        CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::findByIcaoDesignators(const CAircraftIcaoCode &aircraftIcaoCode, const CAirlineIcaoCode &airlineIcaoCode) const
+        {
+            const QString &aircraft = aircraftIcaoCode.getDesignator();
+            const QString &airline  = airlineIcaoCode.getDesignator();
+            if (airline.isEmpty())  { return idsOrEmpty(m_byAircraftDesignator, aircraft); }
+            if (aircraft.isEmpty()) { return idsOrEmpty(m_byAirlineDesignator, airline); }
+            return intersect(idsOrEmpty(m_byAircraftDesignator, aircraft), idsOrEmpty(m_byAirlineDesignator, airline));
+        }
+
+        CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::findByAircraftDesignatorAndLiveryCombinedCode(const QString &aircraftDesignator, const QString &combinedCode) const
+        {
+            if (aircraftDesignator.isEmpty() || combinedCode.isEmpty()) { return {}; }
+            const QString d = aircraftDesignator.trimmed().toUpper();
+            const QString c = combinedCode.trimmed().toUpper();
+            return intersect(idsOrEmpty(m_byAircraftDesignator, d), idsOrEmpty(m_byLiveryCombinedCode, c));
+        }
+
+        const CAircraftModelSetIndex::ModelIds &CAircraftModelSetIndex::findByAirlineGroup(const CAirlineIcaoCode &airline) const
+        {
+            return idsOrEmpty(m_byAirlineGroup, airline.getGroupId());
+        }
+
+        const CAircraftModelSetIndex::ModelIds &CAircraftModelSetIndex::findByManufacturer(const QString &manufacturer) const
+        {
+            static const ModelIds empty;
+            if (manufacturer.isEmpty()) { return empty; }
+            return idsOrEmpty(m_byManufacturer, manufacturer.toUpper().trimmed());
+        }
+
+        const CAircraftModelSetIndex::ModelIds &CAircraftModelSetIndex::findByFamily(const QString &family) const
+        {
+            static const ModelIds empty;
+            if (family.isEmpty()) { return empty; }
+            return idsOrEmpty(m_byFamily, family.toUpper().trimmed());
+        }
+
+        CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::findByCombinedType(const QString &combinedType) const
+        {
+            if (combinedType.length() != 3) { return {}; }
+            const QString cc = combinedType.trimmed().toUpper();
+            if (cc.length() != 3) { return {}; }
+
+            // wildcards like "L*J" or "L-J" are rare, they are resolved by the ICAO code itself
+            QString exact(cc);
+            exact.replace(' ', '*').replace('-', '*');
+            if (!exact.contains('*')) { return idsOrEmpty(m_byCombinedType, exact); }
+
+            ModelIds ids;
+            for (int id = 0; id < m_models.size(); ++id)
+            {
+                if (m_models[id].getAircraftIcaoCode().matchesCombinedType(cc)) { ids.push_back(id); }
+            }
+            return ids;
+        }
+
+        CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::findByCombinedTypeWithColorLivery(const QString &combinedType) const
+        {
+            return intersect(this->findByCombinedType(combinedType), m_colorLiveries);
+        }
+
+        CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::findByCombinedAndManufacturer(const CAircraftIcaoCode &icao) const
+        {
+            const QString &combinedType = icao.getCombinedType();
+            const QString &manufacturer = icao.getManufacturer();
+            if (manufacturer.isEmpty()) { return this->findByCombinedType(combinedType); }
+            if (combinedType.isEmpty()) { return this->findByManufacturer(manufacturer); }
+            return intersect(this->findByCombinedType(combinedType), idsOrEmpty(m_byManufacturerFolded, manufacturer.toCaseFolded()));
+        }
+
+        int CAircraftModelSetIndex::findFirstByModelStringAlias(const QString &modelString) const
+        {
+            if (modelString.isEmpty()) { return -1; }
+            const QString key = modelString.toCaseFolded();
+            const int byString = m_byModelString.value(key, -1);
+            const int byAlias  = m_byModelStringAlias.value(key, -1);
+            if (byString < 0) { return byAlias; }
+            if (byAlias  < 0) { return byString; }
+            return qMin(byString, byAlias);
+        }
+
+        CAircraftModelList CAircraftModelSetIndex::toModels(const ModelIds &ids) const
+        {
+            // whole set in original order, avoids a deep copy
+            if (ids.size() == m_models.size() && std::is_sorted(ids.cbegin(), ids.cend())) { return m_models; }
+
+            CAircraftModelList models;
+            for (int id : ids) { models.push_back(m_models[id]); }
+            return models;
+        }
+
+        CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::intersect(const ModelIds &candidates, const ModelIds &sortedIds)
+        {
+            ModelIds result;
+            if (candidates.isEmpty() || sortedIds.isEmpty()) { return result; }
+            result.reserve(qMin(candidates.size(), sortedIds.size()));
+
+            if (std::is_sorted(candidates.cbegin(), candidates.cend()))
+            {
+                // few ids against many candidates is the typical case after a hash lookup
+                if (sortedIds.size() * 8 < candidates.size())
+                {
+                    for (int id : sortedIds)
+                    {
+                        if (std::binary_search(candidates.cbegin(), candidates.cend(), id)) { result.push_back(id); }
+                    }
+                    return result;
+                }
+                std::set_intersection(candidates.cbegin(), candidates.cend(), sortedIds.cbegin(), sortedIds.cend(), std::back_inserter(result));
+                return result;
+            }
+
+            for (int id : candidates)
+            {
+                if (std::binary_search(sortedIds.cbegin(), sortedIds.cend(), id)) { result.push_back(id); }
+            }
+            return result;
+        }
+
+        CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::unite(const ModelIds &first, const ModelIds &second)
+        {
+            if (first.isEmpty())  { return second; }
+            if (second.isEmpty()) { return first; }
+
+            ModelIds sortedFirst(first);
+            std::sort(sortedFirst.begin(), sortedFirst.end());
+
+            ModelIds result(first);
+            for (int id : second)
+            {
+                if (!std::binary_search(sortedFirst.cbegin(), sortedFirst.cend(), id)) { result.push_back(id); }
+            }
+            return result;
+        }
+
+        CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::replaceOrAdd(const ModelIds &ids, const ModelIds &added)
+        {
+            if (ids.isEmpty())   { return added; }
+            if (added.isEmpty()) { return ids; }
+
+            ModelIds sortedAdded(added);
+            std::sort(sortedAdded.begin(), sortedAdded.end());
+
+            ModelIds result;
+            result.reserve(ids.size() + added.size());
+            for (int id : ids)
+            {
+                if (!std::binary_search(sortedAdded.cbegin(), sortedAdded.cend(), id)) { result.push_back(id); }
+            }
+            result += added;
+            return result;
+        }
+    } // namespace
+} // namespace
@@ -0,0 +1,166 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_AIRCRAFTMODELSETINDEX_H
+#define BLACKMISC_SIMULATION_AIRCRAFTMODELSETINDEX_H
+
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <memory>
+
+namespace BlackMisc
+{
+    namespace Aviation
+    {
+        class CAircraftIcaoCode;
+        class CAirlineIcaoCode;
+    }
+
+    namespace Simulation
+    {
+        //! Immutable lookup index over a model set, used to reduce matching candidates without scanning the set
+        //! \remark a model is identified by its position in the indexed set (model id)
+        //! \remark all find functions have the semantics of the CAircraftModelList function with the same name,
+        //!         but return the ids of the whole set in ascending order. Use intersect to reduce candidates.
+        //! \threadsafe once constructed the index is never modified
+        class BLACKMISC_EXPORT CAircraftModelSetIndex
+        {
+        public:
+            //! Model ids, i.e. positions in the indexed set
+            using ModelIds = QVector<int>;
+
+            //! Default constructor, empty index
+            CAircraftModelSetIndex() {}
+
+            //! Build the index for the given models
+            explicit CAircraftModelSetIndex(const CAircraftModelList &models);
+
+            //! The indexed models
+            const CAircraftModelList &models() const { return m_models; }
+
+            //! Model by id
+            const CAircraftModel &model(int id) const { return m_models[id]; }
+
+            //! Number of indexed models
+            int size() const { return m_models.size(); }
+
+            //! Empty index?
+            bool isEmpty() const { return m_models.isEmpty(); }
+
+            //! All ids
+            const ModelIds &allIds() const { return m_all; }
+
+            //! Ids of models with model string
+            const ModelIds &withModelString() const { return m_withModelString; }
+
+            //! Ids of models with valid DB key
+            const ModelIds &withValidDbKey() const { return m_withDbKey; }
+
+            //! Ids of models not marked as excluded
+            const ModelIds &withoutExcluded() const { return m_withoutExcluded; }
+
+            //! \copydoc CAircraftModelList::findByIcaoDesignators
+            ModelIds findByIcaoDesignators(const Aviation::CAircraftIcaoCode &aircraftIcaoCode, const Aviation::CAirlineIcaoCode &airlineIcaoCode) const;
+
+            //! \copydoc CAircraftModelList::findByAircraftDesignatorAndLiveryCombinedCode
+            ModelIds findByAircraftDesignatorAndLiveryCombinedCode(const QString &aircraftDesignator, const QString &combinedCode) const;
+
+            //! \copydoc CAircraftModelList::findByAirlineGroup
+            const ModelIds &findByAirlineGroup(const Aviation::CAirlineIcaoCode &airline) const;
+
+            //! \copydoc CAircraftModelList::findByManufacturer
+            const ModelIds &findByManufacturer(const QString &manufacturer) const;
+
+            //! \copydoc CAircraftModelList::findByFamily
+            const ModelIds &findByFamily(const QString &family) const;
+
+            //! \copydoc CAircraftModelList::findByCombinedType
+            ModelIds findByCombinedType(const QString &combinedType) const;
+
+            //! \copydoc CAircraftModelList::findByCombinedTypeWithColorLivery
+            ModelIds findByCombinedTypeWithColorLivery(const QString &combinedType) const;
+
+            //! \copydoc CAircraftModelList::findByCombinedAndManufacturer
+            ModelIds findByCombinedAndManufacturer(const Aviation::CAircraftIcaoCode &icao) const;
+
+            //! \copydoc CAircraftModelList::findByMilitaryFlag
+            const ModelIds &findByMilitaryFlag(bool military) const { return military ? m_military : m_civilian; }
+
+            //! \copydoc CAircraftModelList::findByVtolFlag
+            const ModelIds &findByVtolFlag(bool vtol) const { return vtol ? m_vtol : m_nonVtol; }
+
+            //! Id of the first model matching the model string or alias (case insensitive), -1 if not found
+            //! \sa CAircraftModelList::findFirstByModelStringAliasOrDefault
+            int findFirstByModelStringAlias(const QString &modelString) const;
+
+            //! Those ids whose model fulfils the predicate, order of ids is kept
+            //! \sa CAircraftModelList::findBy
+            template <typename Predicate>
+            ModelIds findBy(const ModelIds &ids, Predicate predicate) const
+            {
+                ModelIds result;
+                for (int id : ids)
+                {
+                    if (predicate(m_models[id])) { result.push_back(id); }
+                }
+                return result;
+            }
+
+            //! The models for the given ids, in order of the ids
+            CAircraftModelList toModels(const ModelIds &ids) const;
+
+            //! Those candidates which are also in sortedIds, order of candidates is kept
+            //! \remark sortedIds must be in ascending order, candidates can be in any order
+            static ModelIds intersect(const ModelIds &candidates, const ModelIds &sortedIds);
+
+            //! All ids of first, followed by the ids of second not contained in first
+            static ModelIds unite(const ModelIds &first, const ModelIds &second);
+
+            //! All ids of ids not contained in added, followed by all ids of added
+            //! \sa CAircraftModelList::replaceOrAddModelsWithString
+            static ModelIds replaceOrAdd(const ModelIds &ids, const ModelIds &added);
+
+        private:
+            //! Value from hash or empty ids
+            template <typename K>
+            static const ModelIds &idsOrEmpty(const QHash<K, ModelIds> &hash, const K &key);
+
+            CAircraftModelList m_models;                          //!< indexed models
+            ModelIds m_all;                                       //!< all ids
+            ModelIds m_withModelString;                           //!< models with model string
+            ModelIds m_withDbKey;                                 //!< models with valid DB key
+            ModelIds m_withoutExcluded;                           //!< models not excluded
+            ModelIds m_military;                                  //!< military models
+            ModelIds m_civilian;                                  //!< civilian models
+            ModelIds m_vtol;                                      //!< VTOL models
+            ModelIds m_nonVtol;                                   //!< non VTOL models
+            ModelIds m_colorLiveries;                             //!< models with color livery
+            QHash<QString, ModelIds> m_byAircraftDesignator;      //!< aircraft ICAO designator
+            QHash<QString, ModelIds> m_byAirlineDesignator;       //!< airline ICAO designator
+            QHash<int, ModelIds>     m_byAirlineGroup;            //!< airline group id
+            QHash<QString, ModelIds> m_byFamily;                  //!< aircraft family
+            QHash<QString, ModelIds> m_byManufacturer;            //!< manufacturer as stored
+            QHash<QString, ModelIds> m_byManufacturerFolded;      //!< manufacturer, case folded
+            QHash<QString, ModelIds> m_byCombinedType;            //!< combined type such as "L2J"
+            QHash<QString, ModelIds> m_byLiveryCombinedCode;      //!< livery combined code
+            QHash<QString, int>      m_byModelString;             //!< first model by case folded model string
+            QHash<QString, int>      m_byModelStringAlias;        //!< first model by case folded model string alias
+        };
+
+        //! Shared immutable index
+        using CAircraftModelSetIndexPtr = std::shared_ptr<const CAircraftModelSetIndex>;
+    } // namespace
+} // namespace
+
+#endif // guard
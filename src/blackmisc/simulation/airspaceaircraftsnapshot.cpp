@@ -36,17 +36,32 @@ namespace BlackMisc
 
             CSimulatedAircraftList aircraft(allAircraft);
             aircraft.sortByDistanceToReferencePositionRenderedCallsign();
+            Q_ASSERT_X(aircraft.size() == allAircraft.size(), Q_FUNC_INFO, "aircraft got lost");
+            this->initByDistance(aircraft, maxAircraft, maxRenderedDistance);
+        }
+
+        CAirspaceAircraftSnapshot CAirspaceAircraftSnapshot::fromAircraftByDistance(
+            const CSimulatedAircraftList &aircraftByDistance,
+            bool restricted, bool renderingEnabled, int maxAircraft,
+            const CLength &maxRenderedDistance)
+        {
+            CAirspaceAircraftSnapshot snapshot(CSimulatedAircraftList(), restricted, renderingEnabled, maxAircraft, maxRenderedDistance);
+            if (!aircraftByDistance.isEmpty()) { snapshot.initByDistance(aircraftByDistance, maxAircraft, maxRenderedDistance); }
+            return snapshot;
+        }
+
+        void CAirspaceAircraftSnapshot::initByDistance(const CSimulatedAircraftList &aircraft, int maxAircraft, const CLength &maxRenderedDistance)
+        {
             const int numberAll = aircraft.size();
-            Q_ASSERT_X(numberAll == allAircraft.size(), Q_FUNC_INFO, "aircraft got lost");
             const CSimulatedAircraftList vtolAircraft(aircraft.findByVtol(true));
             const int numberVtol = vtolAircraft.size();
             m_aircraftCallsignsByDistance = aircraft.getCallsigns();
-            Q_ASSERT_X(m_aircraftCallsignsByDistance.size() == allAircraft.size(), Q_FUNC_INFO, "redundant or missing callsigns");
+            Q_ASSERT_X(m_aircraftCallsignsByDistance.size() == numberAll, Q_FUNC_INFO, "redundant or missing callsigns");
             m_vtolAircraftCallsignsByDistance = vtolAircraft.getCallsigns();
             Q_ASSERT_X(m_vtolAircraftCallsignsByDistance.size() == numberVtol, Q_FUNC_INFO, "redundant or missing callsigns");
 
             // no restrictions, just find by attributes
-            if (!restricted)
+            if (!m_restricted)
             {
                 m_enabledAircraftCallsignsByDistance = aircraft.findByEnabled(true).getCallsigns();
                 m_disabledAircraftCallsignsByDistance = aircraft.findByEnabled(false).getCallsigns();
@@ -90,6 +105,27 @@ namespace BlackMisc
             }
         }
 
+        void CAirspaceAircraftSnapshot::setDelta(const CCallsignSet &added, const CCallsignSet &removed, const CCallsignSet &renderingChanged)
+        {
+            m_hasDelta = true;
+            m_addedCallsigns = added;
+            m_removedCallsigns = removed;
+            m_renderingChangedCallsigns = renderingChanged;
+        }
+
+        bool CAirspaceAircraftSnapshot::hasRenderingChanges() const
+        {
+            if (!m_hasDelta || m_restrictionChanged) { return true; }
+            return !m_addedCallsigns.isEmpty() || !m_removedCallsigns.isEmpty() || !m_renderingChangedCallsigns.isEmpty();
+        }
+
+        bool CAirspaceAircraftSnapshot::isReconcileRequired(qint64 handledVersion) const
+        {
+            if (m_version < 0 || m_version != handledVersion + 1) { return true; }
+            if (m_version % FullReconcileInterval == 0) { return true; }
+            return this->hasRenderingChanges();
+        }
+
         bool CAirspaceAircraftSnapshot::isValidSnapshot() const
         {
             return m_timestampMsSinceEpoch > 0;
@@ -44,6 +44,13 @@ namespace BlackMisc
                                       int maxAircraft       = 100,
                                       const BlackMisc::PhysicalQuantities::CLength &maxRenderedDistance = { 0, nullptr });
 
+            //! Snapshot of aircraft already sorted by distance, closest first
+            //! \remark allows to keep the order between snapshots instead of sorting all aircraft again
+            static CAirspaceAircraftSnapshot fromAircraftByDistance(
+                const CSimulatedAircraftList &aircraftByDistance,
+                bool restricted, bool renderingEnabled, int maxAircraft,
+                const BlackMisc::PhysicalQuantities::CLength &maxRenderedDistance);
+
             //! Time when snapshot was taken
             const QDateTime getTimestamp() const { return QDateTime::fromMSecsSinceEpoch(m_timestampMsSinceEpoch); }
 
@@ -62,6 +69,41 @@ namespace BlackMisc
             //! VTOL aircraft callsigns by distance, only enabled aircraft
             const BlackMisc::Aviation::CCallsignSet &getEnabledVtolAircraftCallsignsByDistance() const { return m_enabledVtolAircraftCallsignsByDistance; }
 
+            //! Version, incremented with each snapshot, -1 if not versioned
+            qint64 getVersion() const { return m_version; }
+
+            //! Set the version
+            void setVersion(qint64 version) { m_version = version; }
+
+            //! Callsigns added since the previous snapshot
+            const BlackMisc::Aviation::CCallsignSet &getAddedCallsigns() const { return m_addedCallsigns; }
+
+            //! Callsigns removed since the previous snapshot
+            const BlackMisc::Aviation::CCallsignSet &getRemovedCallsigns() const { return m_removedCallsigns; }
+
+            //! Callsigns which changed between enabled and disabled since the previous snapshot, added and removed ones excluded
+            const BlackMisc::Aviation::CCallsignSet &getRenderingChangedCallsigns() const { return m_renderingChangedCallsigns; }
+
+            //! Set the changes compared to the previous snapshot
+            void setDelta(const BlackMisc::Aviation::CCallsignSet &added, const BlackMisc::Aviation::CCallsignSet &removed,
+                          const BlackMisc::Aviation::CCallsignSet &renderingChanged);
+
+            //! Has a delta to the previous snapshot?
+            bool hasDelta() const { return m_hasDelta; }
+
+            //! Could rendering be affected compared to the previous snapshot?
+            //! \remark true if there is no delta, as nothing is known then
+            bool hasRenderingChanges() const;
+
+            //! Has the simulator to be fully reconciled with this snapshot?
+            //! \param handledVersion version of the last snapshot the simulator was reconciled with or skipped
+            //! \remark only a snapshot directly following the handled one without rendering changes can be skipped,
+            //!         every FullReconcileInterval versions a full reconcile is done anyway, so drift in the simulator is healed
+            bool isReconcileRequired(qint64 handledVersion) const;
+
+            //! Versions between full reconciles, even without rendering changes
+            static constexpr int FullReconcileInterval = 10;
+
             //! Valid snapshot?
             bool isValidSnapshot() const;
 
@@ -93,7 +135,11 @@ namespace BlackMisc
             const QString &generatingThreadName() const { return m_threadName; }
 
         private:
+            //! Init from aircraft sorted by distance
+            void initByDistance(const CSimulatedAircraftList &aircraftByDistance, int maxAircraft, const BlackMisc::PhysicalQuantities::CLength &maxRenderedDistance);
+
             qint64 m_timestampMsSinceEpoch = -1;
+            qint64 m_version = -1;
             bool m_restricted = false;
             bool m_renderingEnabled = true;
             bool m_restrictionChanged = false;
@@ -108,6 +154,12 @@ namespace BlackMisc
             BlackMisc::Aviation::CCallsignSet m_vtolAircraftCallsignsByDistance;
             BlackMisc::Aviation::CCallsignSet m_enabledVtolAircraftCallsignsByDistance;
 
+            // delta to previous snapshot
+            bool m_hasDelta = false;
+            BlackMisc::Aviation::CCallsignSet m_addedCallsigns;
+            BlackMisc::Aviation::CCallsignSet m_removedCallsigns;
+            BlackMisc::Aviation::CCallsignSet m_renderingChangedCallsigns;
+
             BLACK_METACLASS(
                 CAirspaceAircraftSnapshot,
                 BLACK_METAMEMBER(timestampMsSinceEpoch),
@@ -115,7 +167,12 @@ namespace BlackMisc
                 BLACK_METAMEMBER(enabledAircraftCallsignsByDistance, 0, DisabledForComparison),
                 BLACK_METAMEMBER(disabledAircraftCallsignsByDistance, 0, DisabledForComparison),
                 BLACK_METAMEMBER(vtolAircraftCallsignsByDistance, 0, DisabledForComparison),
-                BLACK_METAMEMBER(enabledVtolAircraftCallsignsByDistance, 0, DisabledForComparison)
+                BLACK_METAMEMBER(enabledVtolAircraftCallsignsByDistance, 0, DisabledForComparison),
+                BLACK_METAMEMBER(version),
+                BLACK_METAMEMBER(hasDelta, 0, DisabledForComparison),
+                BLACK_METAMEMBER(addedCallsigns, 0, DisabledForComparison),
+                BLACK_METAMEMBER(removedCallsigns, 0, DisabledForComparison),
+                BLACK_METAMEMBER(renderingChangedCallsigns, 0, DisabledForComparison)
             );
         };
     } // namespace
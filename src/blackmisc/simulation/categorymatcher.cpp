@@ -59,9 +59,10 @@ namespace BlackMisc
             }
         }
 
-        CAircraftModelList CCategoryMatcher::reduceByCategories(const CAircraftModelList &alreadyMatchedModels, const CAircraftModelList &modelSet, const CAircraftMatcherSetup &setup, const CSimulatedAircraft &remoteAircraft, bool &reduced, bool shortLog, CStatusMessageList *log) const
+        CAircraftModelSetIndex::ModelIds CCategoryMatcher::reduceByCategories(const CAircraftModelSetIndex &index, const CAircraftModelSetIndex::ModelIds &alreadyMatchedModels, const CAircraftModelSetIndex::ModelIds &modelSet, const CAircraftMatcherSetup &setup, const CSimulatedAircraft &remoteAircraft, bool &reduced, bool shortLog, CStatusMessageList *log) const
         {
             Q_UNUSED(shortLog)
+            using ModelIds = CAircraftModelSetIndex::ModelIds;
 
             reduced = false;
             if (!setup.useCategoryMatching())
@@ -87,14 +88,20 @@ namespace BlackMisc
                 // we have a glider
                 // and we search in the whole set: this is a special case
                 const int firstLevel = this->gliderFirstLevel();
-                const CAircraftModelList gliders = modelSet.findByCategoryFirstLevel(firstLevel); // all gliders from model set
+                const ModelIds gliders = index.findBy(modelSet, [ = ](const CAircraftModel & model) // all gliders from model set
+                {
+                    return model.hasCategory() && model.getAircraftIcaoCode().getCategory().getFirstLevel() == firstLevel;
+                });
                 if (!gliders.isEmpty())
                 {
                     const CAircraftCategory category = remoteAircraft.getAircraftIcaoCode().getCategory();
                     reduced = true; // in any case reduced (to gliders)
 
                     // find same category
-                    const CAircraftModelList sameGliders = gliders.findByCategory(category);
+                    const ModelIds sameGliders = index.findBy(gliders, [ & ](const CAircraftModel & model)
+                    {
+                        return model.getAircraftIcaoCode().getCategory() == category;
+                    });
                     if (!sameGliders.isEmpty())
                     {
                         if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("Reduced to %1 models by category: '%2'").arg(sameGliders.size()).arg(category.toQString(true)), getLogCategories()); }
@@ -105,7 +112,10 @@ namespace BlackMisc
                     const CAircraftCategoryList otherBranches = m_gliders.findInParallelBranch(category);
                     if (!otherBranches.isEmpty())
                     {
-                        const CAircraftModelList otherBranchGliders = gliders.findByCategories(otherBranches);
+                        const ModelIds otherBranchGliders = index.findBy(gliders, [ & ](const CAircraftModel & model)
+                        {
+                            return otherBranches.contains(model.getAircraftIcaoCode().getCategory());
+                        });
                         if (!otherBranchGliders.isEmpty())
                         {
                             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("Reduced to %1 parallel branch models of '%2' by categories: '%3'").arg(otherBranchGliders.size()).arg(category.getLevelAndName(), otherBranches.getLevelsString()), getLogCategories()); }
@@ -116,7 +126,10 @@ namespace BlackMisc
                     const CAircraftCategoryList siblings = m_gliders.findSiblings(category);
                     if (!siblings.isEmpty())
                     {
-                        const CAircraftModelList siblingGliders = modelSet.findByCategories(siblings);
+                        const ModelIds siblingGliders = index.findBy(modelSet, [ & ](const CAircraftModel & model)
+                        {
+                            return model.hasCategory() && siblings.contains(model.getAircraftIcaoCode().getCategory());
+                        });
                         if (!siblings.isEmpty() && !siblingGliders.isEmpty())
                         {
                             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("Reduced to %1 sibling models of '%2' by categories: '%3'").arg(siblingGliders.size()).arg(category.getLevelAndName(), siblings.getLevelsString()), getLogCategories()); }
@@ -133,10 +146,18 @@ namespace BlackMisc
                     static const QStringList substituteIcaos({ "UHEL", "GLID", "ULAC" }); // maybe also GYRO
                     static const QString substituteIcaosStr = substituteIcaos.join(", ");
 
-                    CAircraftModelList substitutes = alreadyMatchedModels.findByDesignatorsOrFamilyWithColorLivery(substituteIcaos);
+                    ModelIds substitutes = index.findBy(alreadyMatchedModels, [ & ](const CAircraftModel & model)
+                    {
+                        if (!model.getLivery().isColorLivery()) { return false; }
+                        const CAircraftIcaoCode &modelIcao = model.getAircraftIcaoCode();
+                        return substituteIcaos.contains(modelIcao.getDesignator()) || (modelIcao.hasFamily() && substituteIcaos.contains(modelIcao.getFamily()));
+                    });
                     if (substitutes.isEmpty())
                     {
-                        substitutes = alreadyMatchedModels.findByCombinedType(QStringLiteral("L1P"));
+                        substitutes = index.findBy(alreadyMatchedModels, [](const CAircraftModel & model)
+                        {
+                            return model.getAircraftIcaoCode().matchesCombinedType(QStringLiteral("L1P"));
+                        });
                         if (!substitutes.isEmpty())
                         {
                             reduced = true;
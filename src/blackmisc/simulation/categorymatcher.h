@@ -12,6 +12,7 @@
 #define BLACKMISC_SIMULATION_CATEGORYMATCHER_H
 
 #include "aircraftmodellist.h"
+#include "aircraftmodelsetindex.h"
 #include "blackmisc/aviation/aircraftcategorylist.h"
 #include "blackmisc/blackmiscexport.h"
 
@@ -45,8 +46,9 @@ namespace BlackMisc
             //! @}
 
             //! Reduce by categories
-            CAircraftModelList reduceByCategories(
-                const CAircraftModelList &alreadyMatchedModels, const CAircraftModelList &modelSet,
+            //! \remark models are given as ids of the index, so models with the same model string are kept apart
+            CAircraftModelSetIndex::ModelIds reduceByCategories(
+                const CAircraftModelSetIndex &index, const CAircraftModelSetIndex::ModelIds &alreadyMatchedModels, const CAircraftModelSetIndex::ModelIds &modelSet,
                 const CAircraftMatcherSetup &setup, const CSimulatedAircraft &remoteAircraft, bool &reduced, bool shortLog, CStatusMessageList *log = nullptr) const;
 
         private:
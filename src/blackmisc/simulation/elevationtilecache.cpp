@@ -0,0 +1,421 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/elevationtilecache.h"
+#include "blackmisc/pq/units.h"
+#include "blackmisc/range.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+using namespace BlackMisc::Geo;
+using namespace BlackMisc::PhysicalQuantities;
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        namespace
+        {
+            //! Grid size
+            //! @{
+            const int LatitudeTiles  = static_cast<int>(std::ceil(180.0 / CElevationTileCache::TileSizeDeg));
+            const int LongitudeTiles = static_cast<int>(std::ceil(360.0 / CElevationTileCache::TileSizeDeg));
+            //! @}
+
+            //! Meters per degree latitude, as in calculateGreatCircleDistance
+            constexpr double MetersPerDegree = 6371000.8 * M_PI / 180.0;
+
+            //! File format
+            //! @{
+            constexpr quint32 FileMagic   = 0x56454C53; // "SLEV"
+            constexpr quint32 FileVersion = 1;
+            constexpr int StreamVersion   = QDataStream::Qt_5_6;
+            //! @}
+
+            //! Distance in meters
+            double distanceM(const ICoordinateGeodetic &c1, const ICoordinateGeodetic &c2)
+            {
+                return calculateGreatCircleDistance(c1, c2).value(CLengthUnit::m());
+            }
+        }
+
+        constexpr double CElevationTileCache::TileSizeDeg;
+        constexpr int CElevationTileCache::MaxElevationsPerTile;
+        constexpr int CElevationTileCache::DefaultMaxElevations;
+
+        template <class Predicate>
+        int CElevationTileCache::removeIf(Predicate predicate)
+        {
+            int removed = 0;
+            for (auto it = m_tiles.begin(); it != m_tiles.end();)
+            {
+                QVector<Elevation> &elevations = it->elevations;
+                for (int i = elevations.size() - 1; i >= 0; i--)
+                {
+                    if (!predicate(elevations[i])) { continue; }
+                    if (elevations[i].onGround) { m_sizeOnGround--; }
+                    elevations.remove(i);
+                    m_size--;
+                    removed++;
+                }
+                if (elevations.isEmpty())
+                {
+                    m_lru.erase(it->lruPos);
+                    it = m_tiles.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+            return removed;
+        }
+
+        void CElevationTileCache::insert(const ICoordinateGeodetic &elevation, bool onGround, bool fromFile)
+        {
+            if (elevation.isNull()) { return; }
+            const TileKey key = tileKey(latitudeIndex(elevation.latitude().value(CAngleUnit::deg())), longitudeIndex(elevation.longitude().value(CAngleUnit::deg())));
+            auto it = m_tiles.find(key);
+            if (it == m_tiles.end())
+            {
+                it = m_tiles.insert(key, Tile());
+                m_lru.push_front(key);
+                it->lruPos = m_lru.begin();
+            }
+            else
+            {
+                this->touch(*it);
+            }
+
+            Elevation e;
+            e.coordinate = CCoordinateGeodetic(elevation);
+            e.onGround = onGround;
+            e.fromFile = fromFile;
+            it->elevations.push_front(e);
+            m_size++;
+            if (onGround) { m_sizeOnGround++; }
+
+            if (it->elevations.size() > MaxElevationsPerTile)
+            {
+                if (it->elevations.last().onGround) { m_sizeOnGround--; }
+                it->elevations.removeLast();
+                m_size--;
+            }
+            this->evict();
+        }
+
+        CElevationTileCache::Elevation CElevationTileCache::findFirstWithinRange(const ICoordinateGeodetic &reference, const CLength &range, bool onGroundOnly)
+        {
+            if (reference.isNull() || m_tiles.isEmpty()) { return {}; }
+            const double rangeM = range.value(CLengthUnit::m());
+
+            // own tile first, the others only if it has no elevation within range
+            const TileKey ownKey = tileKey(latitudeIndex(reference.latitude().value(CAngleUnit::deg())), longitudeIndex(reference.longitude().value(CAngleUnit::deg())));
+            QVector<TileKey> keys = this->tilesInRange(reference, range);
+            const auto own = std::find(keys.begin(), keys.end(), ownKey);
+            if (own != keys.end()) { std::iter_swap(keys.begin(), own); }
+
+            for (TileKey key : as_const(keys))
+            {
+                const auto it = m_tiles.find(key);
+                for (const Elevation &e : as_const(it->elevations))
+                {
+                    if (onGroundOnly && !e.onGround) { continue; }
+                    if (distanceM(e.coordinate, reference) > rangeM) { continue; }
+                    this->touch(*it);
+                    return e;
+                }
+            }
+            return {};
+        }
+
+        CElevationTileCache::Elevation CElevationTileCache::findClosestWithinRange(const ICoordinateGeodetic &reference, const CLength &range, bool onGroundOnly)
+        {
+            if (reference.isNull() || m_tiles.isEmpty()) { return {}; }
+            const double rangeM = range.value(CLengthUnit::m());
+
+            const Elevation *closest = nullptr;
+            Tile *closestTile = nullptr;
+            double closestM = 0;
+            for (TileKey key : this->tilesInRange(reference, range))
+            {
+                const auto it = m_tiles.find(key);
+                for (const Elevation &e : as_const(it->elevations))
+                {
+                    if (onGroundOnly && !e.onGround) { continue; }
+                    const double dM = distanceM(e.coordinate, reference);
+                    if (dM > rangeM) { continue; }
+                    if (closest && dM >= closestM) { continue; }
+                    closest = &e;
+                    closestTile = &it.value();
+                    closestM = dM;
+                }
+            }
+            if (!closest) { return {}; }
+            const Elevation found = *closest;
+            this->touch(*closestTile);
+            return found;
+        }
+
+        CCoordinateGeodeticList CElevationTileCache::findWithinRange(const ICoordinateGeodetic &reference, const CLength &range, bool onGroundOnly) const
+        {
+            CCoordinateGeodeticList found;
+            if (reference.isNull() || m_tiles.isEmpty()) { return found; }
+            const double rangeM = range.value(CLengthUnit::m());
+            for (TileKey key : this->tilesInRange(reference, range))
+            {
+                for (const Elevation &e : m_tiles.constFind(key)->elevations)
+                {
+                    if (onGroundOnly && !e.onGround) { continue; }
+                    if (distanceM(e.coordinate, reference) <= rangeM) { found.push_back(e.coordinate); }
+                }
+            }
+            return found;
+        }
+
+        CCoordinateGeodeticList CElevationTileCache::getElevations(bool onGroundOnly) const
+        {
+            CCoordinateGeodeticList elevations;
+            for (TileKey key : m_lru)
+            {
+                for (const Elevation &e : m_tiles.constFind(key)->elevations)
+                {
+                    if (onGroundOnly && !e.onGround) { continue; }
+                    elevations.push_back(e.coordinate);
+                }
+            }
+            return elevations;
+        }
+
+        int CElevationTileCache::removeInsideRange(const ICoordinateGeodetic &reference, const CLength &range, bool onGroundOnly)
+        {
+            if (reference.isNull() || m_tiles.isEmpty()) { return 0; }
+            const double rangeM = range.value(CLengthUnit::m());
+            return this->removeIf([&](const Elevation & e)
+            {
+                if (onGroundOnly && !e.onGround) { return false; }
+                return distanceM(e.coordinate, reference) <= rangeM;
+            });
+        }
+
+        int CElevationTileCache::removeOutsideRange(const ICoordinateGeodetic &reference, const CLength &range, bool onGroundOnly)
+        {
+            if (reference.isNull() || m_tiles.isEmpty()) { return 0; }
+            const double rangeM = range.value(CLengthUnit::m());
+            return this->removeIf([&](const Elevation & e)
+            {
+                if (onGroundOnly && !e.onGround) { return false; }
+                return distanceM(e.coordinate, reference) > rangeM;
+            });
+        }
+
+        int CElevationTileCache::keepClosest(const ICoordinateGeodetic &reference, int maxNumber)
+        {
+            if (reference.isNull() || m_size <= maxNumber) { return 0; }
+            if (maxNumber < 1)
+            {
+                const int removed = m_size;
+                this->clear();
+                return removed;
+            }
+
+            // distance of the n-th closest elevation
+            QVector<double> distances;
+            distances.reserve(m_size);
+            for (const Tile &tile : as_const(m_tiles))
+            {
+                for (const Elevation &e : tile.elevations) { distances.push_back(distanceM(e.coordinate, reference)); }
+            }
+            std::nth_element(distances.begin(), distances.begin() + (maxNumber - 1), distances.end());
+            const double maxDistanceM = distances[maxNumber - 1];
+
+            // equal distances are kept up to the max.number
+            int equalKept = maxNumber - static_cast<int>(std::count_if(distances.begin(), distances.end(), [ = ](double d) { return d < maxDistanceM; }));
+            return this->removeIf([&](const Elevation & e)
+            {
+                const double dM = distanceM(e.coordinate, reference);
+                if (dM < maxDistanceM) { return false; }
+                if (dM == maxDistanceM && equalKept > 0) { equalKept--; return false; }
+                return true;
+            });
+        }
+
+        void CElevationTileCache::setMaxElevations(int max)
+        {
+            m_maxElevations = qMax(max, MaxElevationsPerTile);
+            this->evict();
+        }
+
+        void CElevationTileCache::clear()
+        {
+            m_tiles.clear();
+            m_lru.clear();
+            m_size = 0;
+            m_sizeOnGround = 0;
+        }
+
+        bool CElevationTileCache::writeToFile(const QString &fileName) const
+        {
+            if (fileName.isEmpty()) { return false; }
+            const QFileInfo fi(fileName);
+            if (!fi.absoluteDir().exists() && !QDir().mkpath(fi.absolutePath())) { return false; }
+
+            QSaveFile file(fileName);
+            if (!file.open(QIODevice::WriteOnly)) { return false; }
+            QDataStream stream(&file);
+            stream.setVersion(StreamVersion);
+            stream << FileMagic << FileVersion << static_cast<qint32>(m_size);
+
+            // least recently used first, so reading the file restores the order
+            for (auto key = m_lru.crbegin(); key != m_lru.crend(); ++key)
+            {
+                const QVector<Elevation> &elevations = m_tiles.constFind(*key)->elevations;
+                for (auto e = elevations.crbegin(); e != elevations.crend(); ++e)
+                {
+                    stream << e->coordinate.latitude().value(CAngleUnit::deg())
+                           << e->coordinate.longitude().value(CAngleUnit::deg())
+                           << e->coordinate.geodeticHeight().value(CLengthUnit::ft())
+                           << e->onGround;
+                }
+            }
+            if (stream.status() != QDataStream::Ok) { file.cancelWriting(); return false; }
+            return file.commit();
+        }
+
+        bool CElevationTileCache::readFromFile(const QString &fileName)
+        {
+            QFile file(fileName);
+            if (!file.open(QIODevice::ReadOnly)) { return false; }
+            QDataStream stream(&file);
+            stream.setVersion(StreamVersion);
+
+            quint32 magic = 0;
+            quint32 version = 0;
+            qint32 count = 0;
+            stream >> magic >> version >> count;
+            if (stream.status() != QDataStream::Ok || magic != FileMagic || version != FileVersion || count < 0) { return false; }
+
+            // all or nothing
+            using Record = std::tuple<double, double, double, bool>;
+            QVector<Record> records;
+            records.reserve(qMin(count, m_maxElevations));
+            for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++)
+            {
+                double latDeg = 0, lonDeg = 0, elvFt = 0;
+                bool onGround = false;
+                stream >> latDeg >> lonDeg >> elvFt >> onGround;
+                records.push_back(Record(latDeg, lonDeg, elvFt, onGround));
+            }
+            if (stream.status() != QDataStream::Ok) { return false; }
+
+            for (const Record &r : as_const(records))
+            {
+                this->insert(CCoordinateGeodetic(std::get<0>(r), std::get<1>(r), std::get<2>(r)), std::get<3>(r), true);
+            }
+            return true;
+        }
+
+        CElevationTileCache::TileKey CElevationTileCache::tileKey(int latIndex, int lonIndex)
+        {
+            return static_cast<TileKey>(static_cast<quint32>(latIndex)) << 32 | static_cast<quint32>(lonIndex);
+        }
+
+        int CElevationTileCache::latitudeIndex(double latitudeDeg)
+        {
+            const int i = static_cast<int>(std::floor((latitudeDeg + 90.0) / TileSizeDeg));
+            return qBound(0, i, LatitudeTiles - 1);
+        }
+
+        int CElevationTileCache::longitudeIndex(double longitudeDeg)
+        {
+            const int i = static_cast<int>(std::floor((longitudeDeg + 180.0) / TileSizeDeg));
+            return ((i % LongitudeTiles) + LongitudeTiles) % LongitudeTiles;
+        }
+
+        QVector<CElevationTileCache::TileKey> CElevationTileCache::tilesInRange(const ICoordinateGeodetic &reference, const CLength &range) const
+        {
+            QVector<TileKey> keys;
+            const double rangeM = range.value(CLengthUnit::m());
+            if (rangeM < 0) { return keys; }
+
+            // bounding box, with a margin as tiles are not exact on a sphere
+            const double latDeg = reference.latitude().value(CAngleUnit::deg());
+            const double lonDeg = reference.longitude().value(CAngleUnit::deg());
+            const double deltaLatDeg = rangeM / MetersPerDegree * 1.01 + 1.0e-6;
+            const double maxAbsLatDeg = qMin(qAbs(latDeg) + deltaLatDeg, 90.0);
+            const double cosLat = std::cos(qDegreesToRadians(maxAbsLatDeg));
+            const double deltaLonDeg = cosLat > 1.0e-3 ? deltaLatDeg / cosLat : 360.0;
+
+            const int latFrom = latitudeIndex(latDeg - deltaLatDeg);
+            const int latTo   = latitudeIndex(latDeg + deltaLatDeg);
+            const bool allLon = deltaLonDeg >= 180.0;
+            const int lonFrom = allLon ? 0 : static_cast<int>(std::floor((lonDeg - deltaLonDeg + 180.0) / TileSizeDeg));
+            const int lonTo   = allLon ? LongitudeTiles - 1 : static_cast<int>(std::floor((lonDeg + deltaLonDeg + 180.0) / TileSizeDeg));
+            const int lonCount = qMin(lonTo - lonFrom + 1, LongitudeTiles);
+            const double boxTiles = static_cast<double>(latTo - latFrom + 1) * lonCount;
+
+            // a large box has mostly empty tiles, then checking the existing tiles is faster
+            if (boxTiles > m_tiles.size())
+            {
+                for (auto it = m_tiles.cbegin(); it != m_tiles.cend(); ++it)
+                {
+                    const int latIndex = static_cast<int>(it.key() >> 32);
+                    const int lonIndex = static_cast<int>(it.key() & 0xFFFFFFFF);
+                    if (latIndex < latFrom || latIndex > latTo) { continue; }
+                    const int lonOffset = (((lonIndex - lonFrom) % LongitudeTiles) + LongitudeTiles) % LongitudeTiles;
+                    if (lonOffset >= lonCount) { continue; }
+                    keys.push_back(it.key());
+                }
+                return keys;
+            }
+
+            for (int lat = latFrom; lat <= latTo; lat++)
+            {
+                for (int lon = 0; lon < lonCount; lon++)
+                {
+                    const TileKey key = tileKey(lat, (((lonFrom + lon) % LongitudeTiles) + LongitudeTiles) % LongitudeTiles);
+                    if (m_tiles.contains(key)) { keys.push_back(key); }
+                }
+            }
+            return keys;
+        }
+
+        void CElevationTileCache::touch(Tile &tile)
+        {
+            if (tile.lruPos == m_lru.begin()) { return; }
+            m_lru.splice(m_lru.begin(), m_lru, tile.lruPos);
+        }
+
+        void CElevationTileCache::removeTile(QHash<TileKey, Tile>::iterator it)
+        {
+            for (const Elevation &e : as_const(it->elevations))
+            {
+                m_size--;
+                if (e.onGround) { m_sizeOnGround--; }
+            }
+            m_lru.erase(it->lruPos);
+            m_tiles.erase(it);
+        }
+
+        void CElevationTileCache::evict()
+        {
+            while (m_size > m_maxElevations && m_lru.size() > 1)
+            {
+                this->removeTile(m_tiles.find(m_lru.back()));
+            }
+        }
+    } // namespace
+} // namespace
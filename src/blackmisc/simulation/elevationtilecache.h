@@ -0,0 +1,157 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_ELEVATIONTILECACHE_H
+#define BLACKMISC_SIMULATION_ELEVATIONTILECACHE_H
+
+#include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/geo/coordinategeodeticlist.h"
+#include "blackmisc/pq/length.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+#include <list>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        //! Ground elevations in tiles of a latitude/longitude grid
+        //! \remark a lookup only checks the tiles overlapping the range, not all elevations
+        //! \remark if there are too many elevations the least recently used tiles are removed
+        //! \remark not threadsafe, ISimulationEnvironmentProvider locks it
+        class BLACKMISC_EXPORT CElevationTileCache
+        {
+        public:
+            //! Tile size in degrees, about 2.2km in latitude
+            static constexpr double TileSizeDeg = 0.02;
+
+            //! Max.elevations per tile, the oldest are replaced
+            static constexpr int MaxElevationsPerTile = 128;
+
+            //! Default max.elevations in all tiles
+            static constexpr int DefaultMaxElevations = 8192;
+
+            //! Cached elevation
+            struct Elevation
+            {
+                Geo::CCoordinateGeodetic coordinate; //!< position and elevation MSL, null if not found
+                bool onGround = false;               //!< elevation of a likely on ground situation (taxiways, runways)
+                bool fromFile = false;               //!< read from file, i.e. from a previous session
+
+                //! Not found?
+                bool isNull() const { return coordinate.isNull(); }
+            };
+
+            //! Ctor
+            CElevationTileCache() {}
+
+            //! Add an elevation
+            //! \remark latest first within the tile
+            void insert(const Geo::ICoordinateGeodetic &elevation, bool onGround, bool fromFile = false);
+
+            //! First elevation within range (latest first in the closest tile)
+            Elevation findFirstWithinRange(const Geo::ICoordinateGeodetic &reference, const PhysicalQuantities::CLength &range, bool onGroundOnly = false);
+
+            //! Closest elevation within range
+            Elevation findClosestWithinRange(const Geo::ICoordinateGeodetic &reference, const PhysicalQuantities::CLength &range, bool onGroundOnly = false);
+
+            //! All elevations within range
+            Geo::CCoordinateGeodeticList findWithinRange(const Geo::ICoordinateGeodetic &reference, const PhysicalQuantities::CLength &range, bool onGroundOnly = false) const;
+
+            //! All elevations, most recently used tiles first
+            Geo::CCoordinateGeodeticList getElevations(bool onGroundOnly = false) const;
+
+            //! Remove elevations within range
+            int removeInsideRange(const Geo::ICoordinateGeodetic &reference, const PhysicalQuantities::CLength &range, bool onGroundOnly = false);
+
+            //! Remove elevations outside range
+            int removeOutsideRange(const Geo::ICoordinateGeodetic &reference, const PhysicalQuantities::CLength &range, bool onGroundOnly = false);
+
+            //! Keep the closest elevations
+            int keepClosest(const Geo::ICoordinateGeodetic &reference, int maxNumber);
+
+            //! Number of elevations
+            int size() const { return m_size; }
+
+            //! Number of on ground elevations
+            int sizeOnGround() const { return m_sizeOnGround; }
+
+            //! Number of tiles
+            int tileCount() const { return m_tiles.size(); }
+
+            //! Empty?
+            bool isEmpty() const { return m_size < 1; }
+
+            //! Max.elevations, least recently used tiles are removed if exceeded
+            void setMaxElevations(int max);
+
+            //! Max.elevations
+            int getMaxElevations() const { return m_maxElevations; }
+
+            //! Remove all
+            void clear();
+
+            //! Write all elevations to a file
+            bool writeToFile(const QString &fileName) const;
+
+            //! Add the elevations of a file
+            //! \remark elevations are marked as from file
+            bool readFromFile(const QString &fileName);
+
+        private:
+            //! Tile key, latitude and longitude index
+            using TileKey = quint64;
+
+            //! One tile
+            struct Tile
+            {
+                QVector<Elevation> elevations;       //!< latest first
+                std::list<TileKey>::iterator lruPos; //!< position in m_lru
+            };
+
+            //! Key of the tile containing a position
+            static TileKey tileKey(int latIndex, int lonIndex);
+
+            //! Index of a latitude in the tile grid
+            static int latitudeIndex(double latitudeDeg);
+
+            //! Index of a longitude in the tile grid
+            static int longitudeIndex(double longitudeDeg);
+
+            //! Keys of all existing tiles overlapping the range
+            QVector<TileKey> tilesInRange(const Geo::ICoordinateGeodetic &reference, const PhysicalQuantities::CLength &range) const;
+
+            //! Tile was used
+            void touch(Tile &tile);
+
+            //! Remove a tile
+            void removeTile(QHash<TileKey, Tile>::iterator it);
+
+            //! Remove elevations matching a predicate, empty tiles are removed
+            template <class Predicate>
+            int removeIf(Predicate predicate);
+
+            //! Remove the least recently used tiles until the max.number is not exceeded
+            void evict();
+
+            QHash<TileKey, Tile> m_tiles;  //!< tiles
+            std::list<TileKey> m_lru;      //!< most recently used tiles first
+            int m_size = 0;                //!< all elevations
+            int m_sizeOnGround = 0;        //!< on ground elevations
+            int m_maxElevations = DefaultMaxElevations; //!< max.elevations in all tiles
+        };
+    } // namespace
+} // namespace
+
+#endif // guard
@@ -212,6 +212,7 @@ namespace BlackMisc
                     BLACK_METAMEMBER(title),
                     BLACK_METAMEMBER(atcType),
                     BLACK_METAMEMBER(atcModel),
+                    BLACK_METAMEMBER(atcAirline),
                     BLACK_METAMEMBER(atcParkingCode),
                     BLACK_METAMEMBER(atcIdColor),
                     BLACK_METAMEMBER(description),
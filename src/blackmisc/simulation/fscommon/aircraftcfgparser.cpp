@@ -12,11 +12,14 @@
 #include "blackmisc/simulation/fscommon/fscommonutil.h"
 #include "blackmisc/fileutils.h"
 #include "blackmisc/logmessage.h"
+#include "blackmisc/parallel.h"
 #include "blackmisc/statusmessagelist.h"
 #include "blackmisc/worker.h"
 #include "blackmisc/stringutils.h"
 #include "blackconfig/buildconfig.h"
 
+#include <QByteArray>
+#include <QDataStream>
 #include <QDateTime>
 #include <QDir>
 #include <QFile>
@@ -28,6 +31,7 @@
 #include <QMetaType>
 #include <QSettings>
 #include <QTextStream>
+#include <QVector>
 #include <Qt>
 #include <QtGlobal>
 #include <atomic>
@@ -49,6 +53,56 @@ namespace BlackMisc
             // response for async. loading
             using LoaderResponse = std::tuple<CAircraftCfgEntriesList, CAircraftModelList, CStatusMessageList>;
 
+            namespace
+            {
+                //! Version of the parsed entries in the manifest, to be increased with any change of the parsing
+                constexpr quint32 ManifestParserVersion = 1;
+
+                //! Version of the stream with the parsed entries
+                constexpr int StreamVersion = QDataStream::Qt_5_6;
+
+                //! Directory found when walking the model directories
+                struct CfgDirectory
+                {
+                    QString path;                //!< directory
+                    QFileInfoList files;         //!< aircraft.cfg/sim.cfg files to be parsed
+                    QVector<int> subDirectories; //!< indexes of the sub directories
+                    CStatusMessageList messages; //!< messages when listing the directory
+                };
+
+                //! Parsed aircraft.cfg/sim.cfg file
+                struct CfgFile
+                {
+                    CAircraftCfgEntriesList entries;         //!< entries of the file
+                    CStatusMessageList messages;             //!< messages if parsing failed
+                    CModelScanManifest::Entry manifestEntry; //!< entry for the new manifest
+                    bool ok = false;                         //!< parsed?
+                };
+
+                //! Parsed entries for the manifest
+                QByteArray toManifest(const CAircraftCfgEntriesList &entries)
+                {
+                    QByteArray parsed;
+                    QDataStream stream(&parsed, QIODevice::WriteOnly);
+                    stream.setVersion(StreamVersion);
+                    stream << entries;
+                    return parsed;
+                }
+
+                //! Parsed entries from the manifest, with the current timestamp of the file
+                bool fromManifest(const QByteArray &parsed, const QDateTime &fileTimestamp, CAircraftCfgEntriesList &o_entries)
+                {
+                    QDataStream stream(parsed);
+                    stream.setVersion(StreamVersion);
+                    CAircraftCfgEntriesList entries;
+                    stream >> entries;
+                    if (stream.status() != QDataStream::Ok) { return false; }
+                    for (CAircraftCfgEntries &e : entries) { e.setUtcTimestamp(fileTimestamp); }
+                    o_entries = entries;
+                    return true;
+                }
+            }
+
             CAircraftCfgParser::CAircraftCfgParser(const CSimulatorInfo &simInfo, QObject *parent) : IAircraftModelLoader(simInfo, parent)
             { }
 
@@ -134,28 +188,137 @@ namespace BlackMisc
 
             CAircraftCfgEntriesList CAircraftCfgParser::performParsing(const QStringList &directories, const QStringList &excludeDirectories, CStatusMessageList &messages)
             {
-                CAircraftCfgEntriesList entries;
-                for (const QString &dir : directories)
+                const QString manifestFile = CModelScanManifest::manifestFilePath(this->getSimulator(), QStringLiteral("aircraftcfg"));
+                return this->parseDirectories(directories, excludeDirectories, manifestFile, messages);
+            }
+
+            CAircraftCfgEntriesList CAircraftCfgParser::parseDirectories(const QStringList &directories, const QStringList &excludeDirectories, const QString &manifestFile, CStatusMessageList &messages)
+            {
+                //
+                // function has to be threadsafe
+                //
+
+                // walk the directory trees level by level, the directories of one level are listed in parallel
+                QVector<CfgDirectory> cfgDirectories;
+                QVector<int> level;
+                for (const QString &directory : directories)
                 {
-                    entries.push_back(this->performParsing(dir, excludeDirectories, messages));
+                    level.push_back(cfgDirectories.size());
+                    CfgDirectory cfgDirectory;
+                    cfgDirectory.path = directory;
+                    cfgDirectories.push_back(cfgDirectory);
                 }
-                return entries;
+                const QVector<int> roots = level;
+
+                while (!level.isEmpty())
+                {
+                    if (m_cancelLoading) { return CAircraftCfgEntriesList(); }
+                    emit this->loadingProgress(this->getSimulator(), QStringLiteral("Listing %1 directories, e.g. '%2'").arg(level.size()).arg(cfgDirectories[level.front()].path), -1);
+
+                    QVector<QStringList> subDirectories(level.size());
+                    CfgDirectory *cfgDirectoriesData = cfgDirectories.data();
+                    QStringList *subDirectoriesData = subDirectories.data();
+                    const int *levelData = level.constData();
+                    runInParallel(level.size(), [ & ](int i)
+                    {
+                        CfgDirectory &cfgDirectory = cfgDirectoriesData[levelData[i]];
+                        this->scanDirectory(cfgDirectory.path, excludeDirectories, cfgDirectory.files, subDirectoriesData[i], cfgDirectory.messages);
+                    });
+
+                    QVector<int> nextLevel;
+                    for (int i = 0; i < level.size(); i++)
+                    {
+                        for (const QString &subDirectory : as_const(subDirectories[i]))
+                        {
+                            const int index = cfgDirectories.size();
+                            cfgDirectories[level[i]].subDirectories.push_back(index);
+                            nextLevel.push_back(index);
+                            CfgDirectory cfgDirectory;
+                            cfgDirectory.path = subDirectory;
+                            cfgDirectories.push_back(cfgDirectory);
+                        }
+                    }
+                    level = nextLevel;
+                }
+
+                // order of the recursive walk: files of a directory, then its sub directories
+                QVector<int> order;
+                QVector<int> stack;
+                for (auto it = roots.crbegin(); it != roots.crend(); ++it) { stack.push_back(*it); }
+                while (!stack.isEmpty())
+                {
+                    const int index = stack.takeLast();
+                    order.push_back(index);
+                    const QVector<int> &subDirectories = cfgDirectories[index].subDirectories;
+                    for (auto it = subDirectories.crbegin(); it != subDirectories.crend(); ++it) { stack.push_back(*it); }
+                }
+
+                QVector<QFileInfo> files;
+                for (int index : as_const(order))
+                {
+                    for (const QFileInfo &file : as_const(cfgDirectories[index].files)) { files.push_back(file); }
+                }
+
+                // parse the files in parallel, unchanged files are taken from the manifest of the last scan
+                CModelScanManifest manifest(ManifestParserVersion);
+                if (!manifestFile.isEmpty()) { manifest.readFromFile(manifestFile); } // no manifest means all files are parsed
+
+                emit this->loadingProgress(this->getSimulator(), QStringLiteral("Parsing %1 files").arg(files.size()), -1);
+                QVector<CfgFile> cfgFiles(files.size());
+                CfgFile *cfgFilesData = cfgFiles.data();
+                const QFileInfo *filesData = files.constData();
+                runInParallel(files.size(), [ & ](int i)
+                {
+                    if (m_cancelLoading) { return; }
+                    CfgFile &cfgFile = cfgFilesData[i];
+                    cfgFile.entries = CAircraftCfgParser::performParsingOfSingleFileWithManifest(filesData[i], manifest, cfgFile.manifestEntry, cfgFile.ok, cfgFile.messages);
+                });
+                if (m_cancelLoading) { return CAircraftCfgEntriesList(); }
+
+                // results in order of the walk
+                CAircraftCfgEntriesList result;
+                CModelScanManifest newManifest(ManifestParserVersion);
+                int fileIndex = 0;
+                for (int index : as_const(order))
+                {
+                    const CfgDirectory &cfgDirectory = cfgDirectories[index];
+                    messages.push_back(cfgDirectory.messages);
+                    for (int f = 0; f < cfgDirectory.files.size(); f++, fileIndex++)
+                    {
+                        const CfgFile &cfgFile = cfgFiles[fileIndex];
+                        if (!cfgFile.ok)
+                        {
+                            messages.push_back(cfgFile.messages);
+                            continue;
+                        }
+                        result.push_back(cfgFile.entries);
+                        newManifest.insert(files[fileIndex].absoluteFilePath(), cfgFile.manifestEntry);
+                    }
+                }
+
+                // files no longer found are dropped, files of directories not scanned are kept
+                manifest.replaceDirectories(directories, newManifest);
+                if (!manifestFile.isEmpty() && !manifest.writeToFile(manifestFile))
+                {
+                    CLogMessage(this).warning(u"Cannot write model scan manifest '%1'") << manifestFile;
+                }
+                return result;
             }
 
-            CAircraftCfgEntriesList CAircraftCfgParser::performParsing(const QString &directory, const QStringList &excludeDirectories, CStatusMessageList &messages)
+            void CAircraftCfgParser::scanDirectory(const QString &directory, const QStringList &excludeDirectories, QFileInfoList &o_files, QStringList &o_subDirectories, CStatusMessageList &messages)
             {
                 //
                 // function has to be threadsafe
                 //
 
-                if (m_cancelLoading) { return CAircraftCfgEntriesList(); }
+                if (m_cancelLoading) { return; }
 
                 // excluded?
                 if (CFileUtils::isExcludedDirectory(directory, excludeDirectories) || isExcludedSubDirectory(directory))
                 {
                     const CStatusMessage m = CStatusMessage(this).info(u"Skipping directory '%1' (excluded)") << directory;
                     messages.push_back(m);
-                    return CAircraftCfgEntriesList();
+                    return;
                 }
 
                 // set directory with name filters, get aircraft.cfg and sub directories
@@ -164,15 +327,13 @@ namespace BlackMisc
                 dir.setNameFilters(fileNameFilters());
                 if (!dir.exists())
                 {
-                    return CAircraftCfgEntriesList(); // can happen if there are shortcuts or linked dirs not available
+                    return; // can happen if there are shortcuts or linked dirs not available
                 }
 
                 const QString currentDir = dir.absolutePath();
-                CAircraftCfgEntriesList result;
-                emit this->loadingProgress(this->getSimulator(), QStringLiteral("Parsing '%1'").arg(currentDir), -1);
 
-                // Dirs last is crucial, since I will break recursion on "aircraft.cfg" level
-                // with T514 this behaviour has been changed
+                // Dirs last, files of a directory are parsed before the files of its sub directories
+                // with T514 the parsing does not stop on "aircraft.cfg" level anymore
                 const QFileInfoList files = dir.entryInfoList(QDir::Files | QDir::AllDirs | QDir::NoDotAndDotDot, QDir::DirsLast);
 
                 // the sim.cfg/aircraft.cfg file should have an *.air file sibling
@@ -189,23 +350,11 @@ namespace BlackMisc
 
                 for (const auto &fileInfo : files)
                 {
-                    if (m_cancelLoading) { return CAircraftCfgEntriesList(); }
                     if (fileInfo.isDir())
                     {
                         const QString nextDir = fileInfo.absoluteFilePath();
                         if (currentDir.startsWith(nextDir, Qt::CaseInsensitive)) { continue; } // do not go up
-                        if (dir == currentDir) { continue; } // do not recursively call same directory
-
-                        const CAircraftCfgEntriesList subList(performParsing(nextDir, excludeDirectories, messages));
-                        if (messages.isSuccess())
-                        {
-                            result.push_back(subList);
-                        }
-                        else
-                        {
-                            const CStatusMessage m = CStatusMessage(this).warning(u"Parsing failed for '%1'") << nextDir;
-                            messages.push_back(m);
-                        }
+                        o_subDirectories.push_back(nextDir);
                     }
                     else
                     {
@@ -213,49 +362,86 @@ namespace BlackMisc
                         if (CBuildConfig::buildWordSize() != 32 && !hasAirFiles) { continue; }
 
                         // due to the filter we expect only "aircraft.cfg"/"sim.cfg" here
-                        // remark: in a 1st version I have used QSettings to parse to file as ini file
-                        // unfortunately some files are malformed which could end up in wrong data
-
-                        const QString fileName = fileInfo.absoluteFilePath(); // full path and name
-                        bool fileOk = false;
-                        CStatusMessageList fileMsgs;
-                        const CAircraftCfgEntriesList fileResults = CAircraftCfgParser::performParsingOfSingleFile(fileName, fileOk, fileMsgs);
-                        if (!fileOk)
-                        {
-                            const CStatusMessage m = CStatusMessage(this).warning(u"Parsing of '%1' failed") << fileName;
-                            messages.push_back(fileMsgs);
-                            continue;
-                        }
-
-                        result.push_back(fileResults);
-
-                        // With T514 we do not skip not anymore
-                        // return result; // do not go any deeper in file tree, we found aircraft.cfg
+                        o_files.push_back(fileInfo);
                     }
                 }
-
-                // all files finished,
-                // normally reached when no aircraft.cfg is found
-                return result;
             }
 
             CAircraftCfgEntriesList CAircraftCfgParser::performParsingOfSingleFile(const QString &fileName, bool &ok, CStatusMessageList &msgs)
             {
-                // due to the filter we expect only "aircraft.cfg" files here
-                // remark: in a 1st version I have used QSettings to parse to file as ini file
-                // unfortunately some files are malformed which could end up in wrong data
+                ok = false;
+                QByteArray content;
+                if (!CAircraftCfgParser::readFile(fileName, content, msgs)) { return CAircraftCfgEntriesList(); }
+                const QFileInfo fileInfo(CFileUtils::fixWindowsUncPath(fileName));
+                return CAircraftCfgParser::performParsingOfContent(fileName, content, CAircraftCfgParser::getFileTimestamp(fileInfo), ok, msgs);
+            }
 
+            CAircraftCfgEntriesList CAircraftCfgParser::performParsingOfSingleFileWithManifest(const QFileInfo &file, const CModelScanManifest &manifest, CModelScanManifest::Entry &o_manifestEntry, bool &ok, CStatusMessageList &msgs)
+            {
                 ok = false;
+                const QString fileName = file.absoluteFilePath(); // full path and name
+                const QFileInfo fileInfo(CFileUtils::fixWindowsUncPath(fileName));
+                const QDateTime timestamp = CAircraftCfgParser::getFileTimestamp(fileInfo);
+
+                // the timestamp is set again, as it also depends on the creation time
+                CAircraftCfgEntriesList entries;
+                if (manifest.findUnchanged(fileName, fileInfo, o_manifestEntry) && fromManifest(o_manifestEntry.parsed, timestamp, entries))
+                {
+                    ok = true;
+                    return entries;
+                }
+
+                QByteArray content;
+                if (!CAircraftCfgParser::readFile(fileName, content, msgs)) { return CAircraftCfgEntriesList(); }
+
+                // touched, but same content
+                const QByteArray contentHash = CModelScanManifest::contentHash(content);
+                if (manifest.findSameContent(fileName, contentHash, o_manifestEntry) && fromManifest(o_manifestEntry.parsed, timestamp, entries))
+                {
+                    o_manifestEntry = CModelScanManifest::createEntry(fileInfo, contentHash, o_manifestEntry.parsed);
+                    ok = true;
+                    return entries;
+                }
+
+                entries = CAircraftCfgParser::performParsingOfContent(fileName, content, timestamp, ok, msgs);
+                if (ok) { o_manifestEntry = CModelScanManifest::createEntry(fileInfo, contentHash, toManifest(entries)); }
+                return entries;
+            }
+
+            bool CAircraftCfgParser::readFile(const QString &fileName, QByteArray &o_content, CStatusMessageList &msgs)
+            {
                 const QString fnFixed = CFileUtils::fixWindowsUncPath(fileName);
                 QFile file(fnFixed); // includes path
                 if (!file.open(QFile::ReadOnly | QFile::Text))
                 {
                     const CStatusMessage m = CStatusMessage(static_cast<CAircraftCfgParser *>(nullptr)).warning(u"Unable to read file '%1'") << fnFixed;
                     msgs.push_back(m);
-                    return CAircraftCfgEntriesList();
+                    return false;
+                }
+                o_content = file.readAll();
+                file.close();
+                return true;
+            }
+
+            QDateTime CAircraftCfgParser::getFileTimestamp(const QFileInfo &fileInfo)
+            {
+                QDateTime fileTimestamp(fileInfo.lastModified());
+                if (!fileTimestamp.isValid() || fileInfo.birthTime() > fileTimestamp)
+                {
+                    fileTimestamp = fileInfo.birthTime();
                 }
+                Q_ASSERT_X(fileTimestamp.isValid(), Q_FUNC_INFO, "Missing file timestamp");
+                return fileTimestamp;
+            }
 
-                QTextStream in(&file);
+            CAircraftCfgEntriesList CAircraftCfgParser::performParsingOfContent(const QString &fileName, const QByteArray &content, const QDateTime &fileTimestamp, bool &ok, CStatusMessageList &msgs)
+            {
+                // due to the filter we expect only "aircraft.cfg" files here
+                // remark: in a 1st version I have used QSettings to parse to file as ini file
+                // unfortunately some files are malformed which could end up in wrong data
+
+                ok = false;
+                QTextStream in(content);
                 QList<CAircraftCfgEntries> tempEntries;
 
                 // parse through the file
@@ -378,17 +564,8 @@ namespace BlackMisc
                     case Unknown: break;
                     }
                 } // all lines
-                file.close();
 
                 // store all entries
-                const QFileInfo fileInfo(fnFixed);
-                QDateTime fileTimestamp(fileInfo.lastModified());
-                if (!fileTimestamp.isValid() || fileInfo.birthTime() > fileTimestamp)
-                {
-                    fileTimestamp = fileInfo.birthTime();
-                }
-                Q_ASSERT_X(fileTimestamp.isValid(), Q_FUNC_INFO, "Missing file timestamp");
-
                 CAircraftCfgEntriesList result;
                 for (const CAircraftCfgEntries &e : as_const(tempEntries))
                 {
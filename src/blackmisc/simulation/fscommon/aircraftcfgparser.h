@@ -15,8 +15,12 @@
 #include "blackmisc/simulation/aircraftmodellist.h"
 #include "blackmisc/simulation/aircraftmodelloader.h"
 #include "blackmisc/simulation/fscommon/aircraftcfgentrieslist.h"
+#include "blackmisc/simulation/modelscanmanifest.h"
 #include "blackmisc/simulation/simulatorinfo.h"
 
+#include <QByteArray>
+#include <QDateTime>
+#include <QFileInfoList>
 #include <QObject>
 #include <QPointer>
 #include <QString>
@@ -56,6 +60,15 @@ namespace BlackMisc
                 //! Parse a single file
                 static CAircraftCfgEntriesList performParsingOfSingleFile(const QString &fileName, bool &ok, CStatusMessageList &msgs);
 
+                //! Parse all files of the directories
+                //! \remark directories are listed and files are parsed in parallel, the entries are in the order of a recursive walk
+                //! \remark files unchanged since the last scan are taken from the manifest, which is updated for the given directories.
+                //!          An empty manifest file means all files are parsed
+                //! \threadsafe
+                CAircraftCfgEntriesList parseDirectories(
+                    const QStringList &directories, const QStringList &excludeDirectories,
+                    const QString &manifestFile, BlackMisc::CStatusMessageList &messages);
+
                 //! Create an parser object for given simulator
                 static CAircraftCfgParser *createModelLoader(const CSimulatorInfo &simInfo, QObject *parent = nullptr);
 
@@ -74,18 +87,37 @@ namespace BlackMisc
                     Unknown
                 };
 
-                //! Perform the parsing for all directories
+                //! Perform the parsing for all directories, with the scan manifest of the simulator
+                //! \sa parseDirectories
                 //! \threadsafe
                 CAircraftCfgEntriesList performParsing(
                     const QStringList &directories, const QStringList &excludeDirectories,
                     BlackMisc::CStatusMessageList &messages);
 
-                //! Perform the parsing for one directory
+                //! Files to be parsed and sub directories of one directory
                 //! \threadsafe
-                CAircraftCfgEntriesList performParsing(
+                void scanDirectory(
                     const QString &directory, const QStringList &excludeDirectories,
+                    QFileInfoList &o_files, QStringList &o_subDirectories,
                     BlackMisc::CStatusMessageList &messages);
 
+                //! Parse a single file, or take the entries from the manifest if the file has not changed
+                //! \threadsafe
+                static CAircraftCfgEntriesList performParsingOfSingleFileWithManifest(
+                    const QFileInfo &file, const CModelScanManifest &manifest,
+                    CModelScanManifest::Entry &o_manifestEntry, bool &ok, CStatusMessageList &msgs);
+
+                //! Read a file
+                static bool readFile(const QString &fileName, QByteArray &o_content, CStatusMessageList &msgs);
+
+                //! Parse the content of a file
+                static CAircraftCfgEntriesList performParsingOfContent(
+                    const QString &fileName, const QByteArray &content, const QDateTime &fileTimestamp,
+                    bool &ok, CStatusMessageList &msgs);
+
+                //! Timestamp of the entries of a file
+                static QDateTime getFileTimestamp(const QFileInfo &fileInfo);
+
                 //! Fix the content read
                 static QString fixedStringContent(const QVariant &qv);
 
@@ -0,0 +1,79 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/interpolationbatch.h"
+#include "blackmisc/simulation/interpolatormulti.h"
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        int CInterpolationBatch::add(CInterpolatorMulti *interpolator, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber)
+        {
+            Q_ASSERT_X(!interpolator || !m_interpolators.contains(interpolator), Q_FUNC_INFO, "Interpolator added twice");
+            m_interpolators.push_back(interpolator);
+            m_setups.push_back(setup);
+            m_aircraftNumbers.push_back(aircraftNumber);
+            return m_interpolators.size() - 1;
+        }
+
+        const QVector<CInterpolationResult> &CInterpolationBatch::interpolate(qint64 currentTimeSinceEpoc)
+        {
+            const int count = m_interpolators.size();
+            m_kernelIndexes.resize(count);
+            m_kernel.resize(count);
+
+            // 1st stage, per aircraft state up to the kernel step
+            int steps = 0;
+            CInterpolationKernel::Step step;
+            for (int i = 0; i < count; i++)
+            {
+                CInterpolatorMulti *interpolator = m_interpolators[i];
+                if (interpolator && interpolator->prepareInterpolation(currentTimeSinceEpoc, m_setups[i], m_aircraftNumbers[i], step))
+                {
+                    m_kernel.setStep(steps, step);
+                    m_kernelIndexes[i] = steps++;
+                }
+                else
+                {
+                    m_kernelIndexes[i] = -1;
+                }
+            }
+
+            // 2nd stage, position and altitude of all aircraft
+            m_kernel.resize(steps);
+            m_kernel.evaluateAll();
+
+            // 3rd stage, per aircraft with the evaluated values
+            m_results.resize(count);
+            static const CInterpolationKernel::Values noValues {{}};
+            for (int i = 0; i < count; i++)
+            {
+                CInterpolatorMulti *interpolator = m_interpolators[i];
+                if (!interpolator)
+                {
+                    m_results[i].reset();
+                    continue;
+                }
+                const int kernelIndex = m_kernelIndexes[i];
+                m_results[i] = interpolator->finishInterpolation(kernelIndex < 0 ? noValues : m_kernel.getValues(kernelIndex));
+            }
+            return m_results;
+        }
+
+        void CInterpolationBatch::clear()
+        {
+            // resize keeps the capacity, clear would release it
+            m_interpolators.resize(0);
+            m_setups.resize(0);
+            m_aircraftNumbers.resize(0);
+            m_kernelIndexes.resize(0);
+            m_results.resize(0);
+        }
+    } // namespace
+} // namespace
@@ -0,0 +1,75 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_INTERPOLATIONBATCH_H
+#define BLACKMISC_SIMULATION_INTERPOLATIONBATCH_H
+
+#include "blackmisc/simulation/interpolationkernel.h"
+#include "blackmisc/simulation/interpolationrenderingsetup.h"
+#include "blackmisc/simulation/interpolator.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QVector>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        class CInterpolatorMulti;
+
+        //! Interpolation of all aircraft of one update step of a driver
+        //! \remark the same result as CInterpolatorMulti::getInterpolation per aircraft,
+        //!         but positions and altitudes of all aircraft are evaluated in one CInterpolationKernel loop
+        //! \remark the interpolators keep their per aircraft state, each interpolator can only be added once per step
+        class BLACKMISC_EXPORT CInterpolationBatch
+        {
+        public:
+            //! Constructor
+            CInterpolationBatch() {}
+
+            //! Add an aircraft
+            //! \param interpolator can be nullptr, then the result is reset
+            //! \param setup
+            //! \param aircraftNumber as passed to CInterpolatorMulti::getInterpolation
+            //! \return index of the result
+            int add(CInterpolatorMulti *interpolator, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber);
+
+            //! Interpolate all aircraft added
+            //! \remark results in the order the aircraft were added
+            const QVector<CInterpolationResult> &interpolate(qint64 currentTimeSinceEpoc);
+
+            //! Result of the last interpolate
+            const CInterpolationResult &getResult(int index) const { return m_results[index]; }
+
+            //! Setup as added
+            const CInterpolationAndRenderingSetupPerCallsign &getSetup(int index) const { return m_setups[index]; }
+
+            //! Number of aircraft
+            int size() const { return m_interpolators.size(); }
+
+            //! No aircraft?
+            bool isEmpty() const { return m_interpolators.isEmpty(); }
+
+            //! Remove all aircraft and results
+            //! \remark keeps the capacity, so a batch used every update step does not allocate
+            void clear();
+
+        private:
+            QVector<CInterpolatorMulti *> m_interpolators; //!< interpolator per aircraft
+            QVector<CInterpolationAndRenderingSetupPerCallsign> m_setups; //!< setup per aircraft
+            QVector<int> m_aircraftNumbers; //!< aircraft number per aircraft
+            QVector<int> m_kernelIndexes;   //!< index in m_kernel, -1 if there is no kernel step
+            CInterpolationKernel m_kernel;  //!< position and altitude of all aircraft
+            QVector<CInterpolationResult> m_results; //!< result per aircraft
+        };
+    } // namespace
+} // namespace
+
+#endif // guard
@@ -0,0 +1,80 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/interpolationkernel.h"
+
+#include <QtGlobal>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        CInterpolationKernel::Values CInterpolationKernel::evaluate(const Step &step)
+        {
+            Values values;
+            for (int c = 0; c < ChannelCount; c++)
+            {
+                values[c] = evaluate(step.t, step.y0[c], step.y1[c], step.a[c], step.b[c]);
+            }
+            return values;
+        }
+
+        void CInterpolationKernel::resize(int count)
+        {
+            m_t.resize(count);
+            for (int c = 0; c < ChannelCount; c++)
+            {
+                m_y0[c].resize(count);
+                m_y1[c].resize(count);
+                m_a[c].resize(count);
+                m_b[c].resize(count);
+                m_values[c].resize(count);
+            }
+        }
+
+        void CInterpolationKernel::setStep(int index, const Step &step)
+        {
+            Q_ASSERT_X(index >= 0 && index < m_t.size(), Q_FUNC_INFO, "Wrong index");
+            m_t[index] = step.t;
+            for (int c = 0; c < ChannelCount; c++)
+            {
+                m_y0[c][index] = step.y0[c];
+                m_y1[c][index] = step.y1[c];
+                m_a[c][index] = step.a[c];
+                m_b[c][index] = step.b[c];
+            }
+        }
+
+        void CInterpolationKernel::evaluateAll()
+        {
+            const int count = m_t.size();
+            const double *t = m_t.constData();
+            for (int c = 0; c < ChannelCount; c++)
+            {
+                // plain loop over contiguous arrays without branches, so the compiler can vectorize it
+                const double *y0 = m_y0[c].constData();
+                const double *y1 = m_y1[c].constData();
+                const double *a = m_a[c].constData();
+                const double *b = m_b[c].constData();
+                double *values = m_values[c].data();
+                for (int i = 0; i < count; i++)
+                {
+                    values[i] = evaluate(t[i], y0[i], y1[i], a[i], b[i]);
+                }
+            }
+        }
+
+        CInterpolationKernel::Values CInterpolationKernel::getValues(int index) const
+        {
+            Q_ASSERT_X(index >= 0 && index < m_t.size(), Q_FUNC_INFO, "Wrong index");
+            Values values;
+            for (int c = 0; c < ChannelCount; c++) { values[c] = m_values[c][index]; }
+            return values;
+        }
+    } // namespace
+} // namespace
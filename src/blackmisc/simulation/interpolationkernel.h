@@ -0,0 +1,94 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_INTERPOLATIONKERNEL_H
+#define BLACKMISC_SIMULATION_INTERPOLATIONKERNEL_H
+
+#include "blackmisc/blackmiscexport.h"
+
+#include <QVector>
+#include <array>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        //! Position and altitude part of an interpolation step, the same for the linear and the spline interpolant
+        //! \remark a value is y = y0 + t (y1 - y0) + t (1 - t) (a (1 - t) + b t), the cubic Hermite form of a spline interval,
+        //!         linear interpolation is the special case a = b = 0
+        //! \remark the steps of many aircraft are evaluated in one loop over contiguous arrays, see CInterpolationBatch
+        class BLACKMISC_EXPORT CInterpolationKernel
+        {
+        public:
+            //! Interpolated values
+            enum Channel
+            {
+                X,             //!< normal vector x
+                Y,             //!< normal vector y
+                Z,             //!< normal vector z
+                Altitude,      //!< altitude in the unit of the interpolant
+                GroundFactor,  //!< on ground factor
+                ChannelCount
+            };
+
+            //! One value per channel
+            using Values = std::array<double, ChannelCount>;
+
+            //! Coefficients of one aircraft
+            struct Step
+            {
+                double t = 0.0;  //!< time fraction 0..1
+                Values y0 {{}};  //!< values for t = 0
+                Values y1 {{}};  //!< values for t = 1
+                Values a {{}};   //!< Hermite coefficient, 0 if linear
+                Values b {{}};   //!< Hermite coefficient, 0 if linear
+            };
+
+            //! Value of one channel
+            static double evaluate(double t, double y0, double y1, double a, double b)
+            {
+                const double s = 1.0 - t;
+                return y0 + t * (y1 - y0) + t * s * (a * s + b * t);
+            }
+
+            //! Values of one step
+            static Values evaluate(const Step &step);
+
+            //! Number of steps
+            int size() const { return m_t.size(); }
+
+            //! Set the number of steps, the values of existing steps are undefined afterwards
+            //! \remark the arrays keep their capacity, so evaluating every frame does not allocate
+            void resize(int count);
+
+            //! Set a step
+            void setStep(int index, const Step &step);
+
+            //! Evaluate all steps
+            void evaluateAll();
+
+            //! Values of a step, valid after evaluateAll
+            Values getValues(int index) const;
+
+        private:
+            //! One array per channel
+            using Columns = std::array<QVector<double>, ChannelCount>;
+
+            QVector<double> m_t; //!< time fractions
+            Columns m_y0;        //!< values for t = 0
+            Columns m_y1;        //!< values for t = 1
+            Columns m_a;         //!< Hermite coefficients
+            Columns m_b;         //!< Hermite coefficients
+            Columns m_values;    //!< results
+        };
+    } // namespace
+} // namespace
+
+#endif // guard
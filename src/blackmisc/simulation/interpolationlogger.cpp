@@ -71,6 +71,31 @@ namespace BlackMisc
             return worker;
         }
 
+        CWorker *CInterpolationLogger::writeTraceInBackground()
+        {
+            const CInterpolationTrace trace = m_traceRecorder.getTrace();
+            if (trace.isEmpty())
+            {
+                CLogMessage(this).warning(u"No interpolation trace recorded");
+                return nullptr;
+            }
+
+            CWorker *worker = CWorker::fromTask(this, "WriteInterpolationTrace", [trace]()
+            {
+                const QString fn = CInterpolationTrace::traceFilePath();
+                const bool s = trace.writeToFile(fn);
+                CLogMessage::preformatted(CInterpolationLogger::logStatusFileWriting(s, fn));
+            });
+            return worker;
+        }
+
+        QString CInterpolationLogger::getLatestTraceFile()
+        {
+            const QString logDir = CSwiftDirectories::logDirectory();
+            const QStringList traces = QDir(logDir).entryList(QStringList({ CInterpolationTrace::filePattern() }), QDir::Files, QDir::Time);
+            return traces.isEmpty() ? QString() : CFileUtils::appendFilePaths(logDir, traces.first());
+        }
+
         QStringList CInterpolationLogger::getLatestLogFiles()
         {
             QStringList files({ "", "" });
@@ -12,6 +12,7 @@
 #define BLACKMISC_SIMULATION_INTERPOLATIONLOGGER_H
 
 #include "interpolationrenderingsetup.h"
+#include "blackmisc/simulation/interpolationtrace.h"
 #include "blackmisc/simulation/remoteaircraftprovider.h"
 #include "blackmisc/aviation/aircraftsituationlist.h"
 #include "blackmisc/aviation/aircraftpartslist.h"
@@ -113,6 +114,16 @@ namespace BlackMisc
             //! Clear log file
             void clearLog();
 
+            //! Recorder of the interpolation trace
+            //! \threadsafe
+            CInterpolationTraceRecorder &traceRecorder() { return m_traceRecorder; }
+
+            //! Write the recorded interpolation trace in background
+            CWorker *writeTraceInBackground();
+
+            //! Latest trace file
+            static QString getLatestTraceFile();
+
             //! Latest log files: 0: Interpolation / 1: Parts
             static QStringList getLatestLogFiles();
 
@@ -223,6 +234,7 @@ namespace BlackMisc
             mutable QReadWriteLock m_lockSituations; //!< lock logging situations
             mutable QReadWriteLock m_lockParts;      //!< lock logging parts
             int m_maxSituations = 2500;              //!< max.number of situations
+            CInterpolationTraceRecorder m_traceRecorder; //!< trace for replays
             QList<PartsLog> m_partsLogs;             //!< logs of parts
             QList<SituationLog> m_situationLogs;     //!< logs of interpolation
         };
@@ -0,0 +1,416 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/interpolationtrace.h"
+#include "blackmisc/simulation/interpolatormulti.h"
+#include "blackmisc/simulation/remoteaircraftproviderdummy.h"
+#include "blackmisc/aviation/aircraftengine.h"
+#include "blackmisc/aviation/aircraftenginelist.h"
+#include "blackmisc/aviation/aircraftlights.h"
+#include "blackmisc/aviation/aircraftparts.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/fileutils.h"
+#include "blackmisc/swiftdirectories.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QStringBuilder>
+#include <cmath>
+#include <memory>
+
+using namespace BlackMisc::Aviation;
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        namespace
+        {
+            //! File format
+            //! @{
+            constexpr quint32 FileMagic   = 0x53574954; // "SWIT" in the big endian stream
+            constexpr quint32 FileVersion = 2;
+            constexpr int StreamVersion   = QDataStream::Qt_5_6;
+            //! @}
+
+            //! Mean earth radius
+            constexpr double EarthRadiusMeters = 6371000.8;
+
+            //! Positions closer than this are the same
+            constexpr double SamePositionM = 0.01;
+
+            //! Write and read a record field by field
+            //! @{
+            void writeRecord(QDataStream &stream, const CInterpolationTrace::InputRecord &record)
+            {
+                stream << record.step << record.callsignId << record.isParts;
+                record.situation.marshalToDataStream(stream);
+                record.parts.marshalToDataStream(stream);
+            }
+
+            void readRecord(QDataStream &stream, CInterpolationTrace::InputRecord &record)
+            {
+                stream >> record.step >> record.callsignId >> record.isParts;
+                record.situation.unmarshalFromDataStream(stream);
+                record.parts.unmarshalFromDataStream(stream);
+            }
+
+            void writeRecord(QDataStream &stream, const CInterpolationTrace::StepRecord &record)
+            {
+                stream << record.step << record.currentTimeMs << record.callsignId << record.aircraftNumber << record.mode << record.flags
+                       << record.normalVector[0] << record.normalVector[1] << record.normalVector[2] << record.altitudeM;
+            }
+
+            void readRecord(QDataStream &stream, CInterpolationTrace::StepRecord &record)
+            {
+                stream >> record.step >> record.currentTimeMs >> record.callsignId >> record.aircraftNumber >> record.mode >> record.flags
+                       >> record.normalVector[0] >> record.normalVector[1] >> record.normalVector[2] >> record.altitudeM;
+            }
+            //! @}
+
+            //! Write records
+            template <typename T>
+            void writeRecords(QDataStream &stream, const QVector<T> &records)
+            {
+                stream << static_cast<qint32>(records.size());
+                for (const T &record : records) { writeRecord(stream, record); }
+            }
+
+            //! Read records written by writeRecords
+            template <typename T>
+            bool readRecords(QDataStream &stream, QVector<T> &o_records)
+            {
+                qint32 count = -1;
+                stream >> count;
+                if (stream.status() != QDataStream::Ok || count < 0) { return false; }
+                o_records.clear();
+                for (qint32 i = 0; i < count; i++)
+                {
+                    T record;
+                    readRecord(stream, record);
+                    if (stream.status() != QDataStream::Ok) { return false; } // truncated file
+                    o_records.push_back(record);
+                }
+                return true;
+            }
+        }
+
+        CCompactParts CCompactParts::fromParts(const CAircraftParts &parts)
+        {
+            CCompactParts compact;
+            compact.m_msSinceEpoch = parts.getMSecsSinceEpoch();
+            compact.m_timeOffsetMs = parts.getTimeOffsetMs();
+
+            const CAircraftEngineList engines = parts.getEngines();
+            compact.m_engines = static_cast<quint8>(qMin(engines.size(), 16));
+            for (const CAircraftEngine &engine : engines)
+            {
+                const int number = engine.getNumber();
+                if (number < 1 || number > 16 || !engine.isOn()) { continue; }
+                compact.m_enginesOn |= static_cast<quint16>(1 << (number - 1));
+            }
+
+            const CAircraftLights lights = parts.getLights();
+            if (lights.isStrobeOn())      { compact.m_lights |= Strobe; }
+            if (lights.isLandingOn())     { compact.m_lights |= Landing; }
+            if (lights.isTaxiOn())        { compact.m_lights |= Taxi; }
+            if (lights.isBeaconOn())      { compact.m_lights |= Beacon; }
+            if (lights.isNavOn())         { compact.m_lights |= Nav; }
+            if (lights.isLogoOn())        { compact.m_lights |= Logo; }
+            if (lights.isRecognitionOn()) { compact.m_lights |= Recognition; }
+            if (lights.isCabinOn())       { compact.m_lights |= Cabin; }
+
+            if (lights.isNull())         { compact.m_flags |= LightsNull; }
+            if (parts.isGearDown())      { compact.m_flags |= GearDown; }
+            if (parts.isSpoilersOut())   { compact.m_flags |= SpoilersOut; }
+            if (parts.isOnGround())      { compact.m_flags |= OnGround; }
+            compact.m_flapsPercent = static_cast<quint8>(qBound(0, parts.getFlapsPercent(), 100));
+            compact.m_partsDetails = static_cast<qint8>(parts.getPartsDetails());
+            return compact;
+        }
+
+        void CCompactParts::marshalToDataStream(QDataStream &stream) const
+        {
+            stream << m_msSinceEpoch << m_timeOffsetMs << m_enginesOn << m_engines << m_lights << m_flags << m_flapsPercent << m_partsDetails;
+        }
+
+        void CCompactParts::unmarshalFromDataStream(QDataStream &stream)
+        {
+            stream >> m_msSinceEpoch >> m_timeOffsetMs >> m_enginesOn >> m_engines >> m_lights >> m_flags >> m_flapsPercent >> m_partsDetails;
+        }
+
+        CAircraftParts CCompactParts::toParts() const
+        {
+            CAircraftLights lights(m_lights & Strobe, m_lights & Landing, m_lights & Taxi, m_lights & Beacon,
+                                   m_lights & Nav, m_lights & Logo, m_lights & Recognition, m_lights & Cabin);
+            lights.setNull(m_flags & LightsNull);
+
+            CAircraftEngineList engines;
+            engines.initEngines(m_engines, false);
+            for (int e = 1; e <= m_engines; e++)
+            {
+                if (m_enginesOn & (1 << (e - 1))) { engines.setEngineOn(e, true); }
+            }
+
+            CAircraftParts parts;
+            parts.setMSecsSinceEpoch(m_msSinceEpoch);
+            parts.setTimeOffsetMs(m_timeOffsetMs);
+            parts.setLights(lights);
+            parts.setEngines(engines);
+            parts.setGearDown(m_flags & GearDown);
+            parts.setSpoilersOut(m_flags & SpoilersOut);
+            parts.setOnGround(m_flags & OnGround);
+            parts.setFlapsPercent(m_flapsPercent);
+            parts.setPartsDetails(static_cast<CAircraftParts::PartsDetails>(m_partsDetails));
+            return parts;
+        }
+
+        QString CInterpolationTrace::ReplayStatistics::toQString() const
+        {
+            return QStringLiteral("inputs: %1 steps: %2 interpolated: %3 status changed: %4 deviating: %5 max.deviation: %6m interpolation: %7ms").
+                   arg(inputs).arg(steps).arg(interpolated).arg(statusChanged).arg(deviating).
+                   arg(maxDeviationM, 0, 'f', 3).arg(static_cast<double>(interpolationNs) / 1e6, 0, 'f', 2);
+        }
+
+        CInterpolationTrace::CInterpolationTrace(const QStringList &callsigns, const QVector<InputRecord> &inputs, const QVector<StepRecord> &steps) :
+            m_callsigns(callsigns), m_inputs(inputs), m_steps(steps)
+        { }
+
+        bool CInterpolationTrace::writeToFile(const QString &fileName) const
+        {
+            if (fileName.isEmpty()) { return false; }
+            const QFileInfo fi(fileName);
+            if (!fi.absoluteDir().exists() && !QDir().mkpath(fi.absolutePath())) { return false; }
+
+            QSaveFile file(fileName);
+            if (!file.open(QIODevice::WriteOnly)) { return false; }
+            QDataStream stream(&file);
+            stream.setVersion(StreamVersion);
+            stream << FileMagic << FileVersion << m_callsigns;
+            writeRecords(stream, m_inputs);
+            writeRecords(stream, m_steps);
+            if (stream.status() != QDataStream::Ok) { file.cancelWriting(); return false; }
+            return file.commit();
+        }
+
+        bool CInterpolationTrace::readFromFile(const QString &fileName)
+        {
+            QFile file(fileName);
+            if (!file.open(QIODevice::ReadOnly)) { return false; }
+            QDataStream stream(&file);
+            stream.setVersion(StreamVersion);
+
+            quint32 magic = 0;
+            quint32 version = 0;
+            stream >> magic >> version;
+            if (stream.status() != QDataStream::Ok || magic != FileMagic || version != FileVersion) { return false; }
+
+            // all or nothing
+            QStringList callsigns;
+            QVector<InputRecord> inputs;
+            QVector<StepRecord> steps;
+            stream >> callsigns;
+            if (stream.status() != QDataStream::Ok) { return false; }
+            if (!readRecords(stream, inputs) || !readRecords(stream, steps)) { return false; }
+
+            m_callsigns = callsigns;
+            m_inputs = inputs;
+            m_steps = steps;
+            return true;
+        }
+
+        CInterpolationTrace::ReplayStatistics CInterpolationTrace::replay() const
+        {
+            ReplayStatistics statistics;
+            if (m_steps.isEmpty()) { return statistics; }
+
+            QVector<CCallsign> callsigns;
+            callsigns.reserve(m_callsigns.size());
+            for (const QString &cs : m_callsigns) { callsigns.push_back(CCallsign(cs)); }
+
+            CRemoteAircraftProviderDummy provider;
+            std::vector<std::unique_ptr<CInterpolatorMulti>> interpolators(static_cast<size_t>(callsigns.size()));
+            CInterpolationAndRenderingSetupPerCallsign setup;
+
+            // without the inputs the steps before the oldest input cannot be interpolated as recorded
+            const quint64 firstStep = m_inputs.isEmpty() ? 0 : m_inputs.front().step;
+            int input = 0;
+            QElapsedTimer timer;
+
+            for (const StepRecord &step : m_steps)
+            {
+                if (step.callsignId >= static_cast<quint32>(callsigns.size())) { continue; }
+
+                for (; input < m_inputs.size() && m_inputs[input].step <= step.step; input++)
+                {
+                    const InputRecord &record = m_inputs[input];
+                    if (record.callsignId >= static_cast<quint32>(callsigns.size())) { continue; }
+                    const CCallsign &cs = callsigns[static_cast<int>(record.callsignId)];
+                    if (record.isParts)
+                    {
+                        provider.insertNewAircraftParts(cs, record.parts.toParts(), false);
+                    }
+                    else
+                    {
+                        provider.insertNewSituation(record.situation.toSituation(cs));
+                        const std::unique_ptr<CInterpolatorMulti> &interpolator = interpolators[record.callsignId];
+                        if (interpolator) { interpolator->markSituationsChanged(); }
+                    }
+                    statistics.inputs++;
+                }
+                if (step.step < firstStep) { continue; }
+
+                std::unique_ptr<CInterpolatorMulti> &interpolator = interpolators[step.callsignId];
+                if (!interpolator)
+                {
+                    interpolator.reset(new CInterpolatorMulti(callsigns[static_cast<int>(step.callsignId)], nullptr, nullptr, &provider));
+                }
+
+                setup.setInterpolatorMode(static_cast<CInterpolationAndRenderingSetupBase::InterpolatorMode>(step.mode));
+                setup.setEnabledAircraftParts(step.flags & PartsEnabled);
+
+                timer.start();
+                const CInterpolationResult result = interpolator->getInterpolation(step.currentTimeMs, setup, step.aircraftNumber);
+                statistics.interpolationNs += timer.nsecsElapsed();
+                statistics.steps++;
+
+                const bool interpolated = result.getInterpolationStatus().isInterpolated();
+                const bool recordedInterpolated = step.flags & Interpolated;
+                if (interpolated != recordedInterpolated) { statistics.statusChanged++; }
+                if (!interpolated) { continue; }
+                statistics.interpolated++;
+                if (!recordedInterpolated) { continue; }
+
+                const CCompactSituation situation = CCompactSituation::fromSituation(result.getInterpolatedSituation());
+                const std::array<double, 3> &v = situation.getNormalVector();
+                const double dx = v[0] - step.normalVector[0];
+                const double dy = v[1] - step.normalVector[1];
+                const double dz = v[2] - step.normalVector[2];
+                const double horizontalM = std::sqrt(dx * dx + dy * dy + dz * dz) * EarthRadiusMeters;
+                const double verticalM = std::isnan(situation.getAltitudeM()) || std::isnan(step.altitudeM) ? 0.0 : situation.getAltitudeM() - step.altitudeM;
+                const double deviationM = std::sqrt(horizontalM * horizontalM + verticalM * verticalM);
+                if (deviationM > SamePositionM) { statistics.deviating++; }
+                statistics.maxDeviationM = qMax(statistics.maxDeviationM, deviationM);
+            }
+            return statistics;
+        }
+
+        QString CInterpolationTrace::traceFilePath()
+        {
+            QString file = filePattern();
+            file.remove('*');
+            const QString ts = QDateTime::currentDateTimeUtc().toString("yyyyMMddhhmmss");
+            return CFileUtils::appendFilePaths(CSwiftDirectories::logDirectory(), ts % file);
+        }
+
+        const QString &CInterpolationTrace::filePattern()
+        {
+            static const QString p("*_interpolation.trace");
+            return p;
+        }
+
+        template <typename T>
+        QVector<T> CInterpolationTraceRecorder::Ring<T>::chronological() const
+        {
+            QVector<T> ordered;
+            if (records.empty()) { return ordered; }
+            const quint64 size = records.size();
+            const quint64 count = qMin(written, size);
+            ordered.reserve(static_cast<int>(count));
+            for (quint64 i = written - count; i < written; i++)
+            {
+                ordered.push_back(records[static_cast<size_t>(i % size)]);
+            }
+            return ordered;
+        }
+
+        CInterpolationTraceRecorder::CInterpolationTraceRecorder(int maxInputs, int maxSteps) :
+            m_maxInputs(qMax(1, maxInputs)), m_maxSteps(qMax(1, maxSteps))
+        { }
+
+        void CInterpolationTraceRecorder::setEnabled(bool enabled)
+        {
+            QMutexLocker l(&m_mutex);
+            if (enabled && m_steps.records.empty())
+            {
+                m_inputs.records.resize(static_cast<size_t>(m_maxInputs));
+                m_steps.records.resize(static_cast<size_t>(m_maxSteps));
+            }
+            if (enabled && !this->isEnabled()) { m_generation++; } // inputs were missed while disabled
+            m_enabled.store(enabled, std::memory_order_relaxed);
+        }
+
+        quint32 CInterpolationTraceRecorder::callsignId(const CCallsign &callsign)
+        {
+            const QString &cs = callsign.asString();
+            QMutexLocker l(&m_mutex);
+            const auto it = m_callsignIds.constFind(cs);
+            if (it != m_callsignIds.constEnd()) { return it.value(); }
+            const quint32 id = static_cast<quint32>(m_callsigns.size());
+            m_callsigns.push_back(cs);
+            m_callsignIds.insert(cs, id);
+            return id;
+        }
+
+        void CInterpolationTraceRecorder::recordSituation(quint32 callsignId, const CCompactSituation &situation)
+        {
+            CInterpolationTrace::InputRecord input;
+            input.callsignId = callsignId;
+            input.situation = situation;
+            this->recordInput(input);
+        }
+
+        void CInterpolationTraceRecorder::recordParts(quint32 callsignId, const CCompactParts &parts)
+        {
+            CInterpolationTrace::InputRecord input;
+            input.callsignId = callsignId;
+            input.isParts = true;
+            input.parts = parts;
+            this->recordInput(input);
+        }
+
+        void CInterpolationTraceRecorder::recordInput(CInterpolationTrace::InputRecord &input)
+        {
+            if (!this->isEnabled()) { return; }
+            QMutexLocker l(&m_mutex);
+            if (m_inputs.records.empty()) { return; }
+            input.step = m_steps.written; // seen by the next step
+            m_inputs.push(input);
+        }
+
+        void CInterpolationTraceRecorder::recordStep(const CInterpolationTrace::StepRecord &step)
+        {
+            if (!this->isEnabled()) { return; }
+            CInterpolationTrace::StepRecord record(step);
+            QMutexLocker l(&m_mutex);
+            if (m_steps.records.empty()) { return; }
+            record.step = m_steps.written;
+            m_steps.push(record);
+        }
+
+        void CInterpolationTraceRecorder::clear()
+        {
+            QMutexLocker l(&m_mutex);
+            m_inputs.written = 0;
+            m_steps.written = 0;
+            m_generation++;
+        }
+
+        CInterpolationTrace CInterpolationTraceRecorder::getTrace() const
+        {
+            QMutexLocker l(&m_mutex);
+            return CInterpolationTrace(m_callsigns, m_inputs.chronological(), m_steps.chronological());
+        }
+    } // namespace
+} // namespace
@@ -0,0 +1,271 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_INTERPOLATIONTRACE_H
+#define BLACKMISC_SIMULATION_INTERPOLATIONTRACE_H
+
+#include "blackmisc/aviation/compactsituation.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QDataStream>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QtGlobal>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace BlackMisc
+{
+    namespace Aviation
+    {
+        class CAircraftParts;
+        class CCallsign;
+    }
+
+    namespace Simulation
+    {
+        //! Aircraft parts as plain values, the parts counterpart of Aviation::CCompactSituation
+        //! \remark trivially copyable, engines beyond 16 are not stored
+        class BLACKMISC_EXPORT CCompactParts
+        {
+        public:
+            //! From parts
+            static CCompactParts fromParts(const Aviation::CAircraftParts &parts);
+
+            //! Back to parts
+            Aviation::CAircraftParts toParts() const;
+
+            //! \copydoc BlackMisc::ITimestampBased::getAdjustedMSecsSinceEpoch
+            qint64 getAdjustedMSecsSinceEpoch() const { return m_msSinceEpoch + m_timeOffsetMs; }
+
+            //! \copydoc BlackMisc::Mixin::DataStreamByMetaClass::marshalToDataStream
+            void marshalToDataStream(QDataStream &stream) const;
+
+            //! \copydoc BlackMisc::Mixin::DataStreamByMetaClass::unmarshalFromDataStream
+            void unmarshalFromDataStream(QDataStream &stream);
+
+        private:
+            //! Flags
+            enum Flag : quint8
+            {
+                GearDown    = 1 << 0,
+                SpoilersOut = 1 << 1,
+                OnGround    = 1 << 2,
+                LightsNull  = 1 << 3
+            };
+
+            //! Lights, one bit per light
+            enum Light : quint8
+            {
+                Strobe      = 1 << 0,
+                Landing     = 1 << 1,
+                Taxi        = 1 << 2,
+                Beacon      = 1 << 3,
+                Nav         = 1 << 4,
+                Logo        = 1 << 5,
+                Recognition = 1 << 6,
+                Cabin       = 1 << 7
+            };
+
+            qint64  m_msSinceEpoch = -1;
+            qint64  m_timeOffsetMs = 0;
+            quint16 m_enginesOn    = 0; //!< one bit per engine
+            quint8  m_engines      = 0; //!< number of engines
+            quint8  m_lights       = 0; //!< Light
+            quint8  m_flags        = 0; //!< Flag
+            quint8  m_flapsPercent = 0;
+            qint8   m_partsDetails = 0;
+        };
+
+        static_assert(std::is_trivially_copyable<CCompactParts>::value, "Copied with memcpy");
+
+        //! Situations and parts seen by the interpolators, and the interpolated positions, as recorded by CInterpolationTraceRecorder
+        //! \remark replayed through CInterpolatorMulti without a simulator, so the interpolation can be benchmarked
+        //!         and compared with the recorded results, e.g. after changing an interpolator
+        class BLACKMISC_EXPORT CInterpolationTrace
+        {
+        public:
+            //! Situation or parts received by an interpolator
+            struct InputRecord
+            {
+                quint64 step = 0;                         //!< sequence number of the interpolation step which saw the input first
+                quint32 callsignId = 0;                   //!< index in the callsign table
+                bool isParts = false;                     //!< parts or situation
+                Aviation::CCompactSituation situation;    //!< situation, if not parts
+                CCompactParts parts;                      //!< parts, if parts
+            };
+
+            //! One interpolation step of one aircraft
+            struct StepRecord
+            {
+                quint64 step = 0;                         //!< sequence number
+                qint64 currentTimeMs = -1;                //!< interpolation time
+                quint32 callsignId = 0;                   //!< index in the callsign table
+                qint16 aircraftNumber = 0;                //!< aircraft number passed to the interpolator
+                quint8 mode = 0;                          //!< CInterpolationAndRenderingSetupBase::InterpolatorMode
+                quint8 flags = 0;                         //!< StepFlag
+                std::array<double, 3> normalVector {{ 0, 0, 0 }}; //!< interpolated position
+                double altitudeM = std::numeric_limits<double>::quiet_NaN(); //!< interpolated altitude
+            };
+
+            //! StepRecord::flags
+            enum StepFlag : quint8
+            {
+                Interpolated = 1 << 0, //!< position was interpolated
+                PartsEnabled = 1 << 1  //!< aircraft parts were enabled in the setup
+            };
+
+            //! Result of a replay
+            struct ReplayStatistics
+            {
+                int inputs = 0;             //!< inserted situations and parts
+                int steps = 0;              //!< replayed steps
+                int interpolated = 0;       //!< steps with an interpolated position
+                int statusChanged = 0;      //!< steps interpolated in the recording, but not in the replay or vice versa
+                int deviating = 0;          //!< interpolated steps with a position more than 1cm off the recording
+                double maxDeviationM = 0;   //!< max. distance to the recorded position
+                qint64 interpolationNs = 0; //!< time spent in the interpolators
+
+                //! As string
+                QString toQString() const;
+            };
+
+            //! Ctor, empty trace
+            CInterpolationTrace() {}
+
+            //! Ctor
+            CInterpolationTrace(const QStringList &callsigns, const QVector<InputRecord> &inputs, const QVector<StepRecord> &steps);
+
+            //! Callsigns, the index is the callsign id
+            const QStringList &getCallsigns() const { return m_callsigns; }
+
+            //! Inputs in recording order
+            const QVector<InputRecord> &getInputs() const { return m_inputs; }
+
+            //! Steps in recording order
+            const QVector<StepRecord> &getSteps() const { return m_steps; }
+
+            //! Empty?
+            bool isEmpty() const { return m_steps.isEmpty(); }
+
+            //! Write to a file
+            bool writeToFile(const QString &fileName) const;
+
+            //! Read from a file, replacing the trace
+            //! \remark false if the file was written with another record layout
+            bool readFromFile(const QString &fileName);
+
+            //! Feed the inputs to interpolators and interpolate all steps again
+            //! \remark the interpolators are created in the calling thread
+            ReplayStatistics replay() const;
+
+            //! File name for a new trace file in the log directory
+            static QString traceFilePath();
+
+            //! File pattern of the trace files
+            static const QString &filePattern();
+
+        private:
+            QStringList m_callsigns;
+            QVector<InputRecord> m_inputs;
+            QVector<StepRecord> m_steps;
+        };
+
+        //! Records the inputs and results of the interpolators into fixed size ring buffers
+        //! \remark cheap enough to stay enabled: recording is a copy of a plain record, the latest records are kept
+        //! \remark inputs and steps have their own buffers, so the frequent steps do not push out the inputs
+        //! \threadsafe
+        class BLACKMISC_EXPORT CInterpolationTraceRecorder
+        {
+        public:
+            //! Ctor
+            //! \remark memory is allocated when enabled
+            CInterpolationTraceRecorder(int maxInputs = 8192, int maxSteps = 65536);
+
+            //! Not copyable
+            //! @{
+            CInterpolationTraceRecorder(const CInterpolationTraceRecorder &) = delete;
+            CInterpolationTraceRecorder &operator =(const CInterpolationTraceRecorder &) = delete;
+            //! @}
+
+            //! Enable or disable recording
+            //! \remark enabling starts a new generation
+            void setEnabled(bool enabled);
+
+            //! Recording?
+            bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+            //! Id of a callsign in the traces
+            //! \remark ids stay valid when the records are cleared
+            quint32 callsignId(const Aviation::CCallsign &callsign);
+
+            //! Record a situation received by an interpolator
+            void recordSituation(quint32 callsignId, const Aviation::CCompactSituation &situation);
+
+            //! Record parts received by an interpolator
+            void recordParts(quint32 callsignId, const CCompactParts &parts);
+
+            //! Record an interpolation step
+            //! \remark the sequence number is set by the recorder
+            void recordStep(const CInterpolationTrace::StepRecord &step);
+
+            //! Remove all records
+            //! \remark starts a new generation
+            void clear();
+
+            //! Incremented when the records are cleared or recording is enabled again
+            //! \remark inputs already recorded by an interpolator are recorded again in a new generation
+            quint32 getGeneration() const { return m_generation.load(std::memory_order_acquire); }
+
+            //! Copy of the records, oldest first
+            CInterpolationTrace getTrace() const;
+
+        private:
+            //! Fixed size buffer, overwriting the oldest record
+            template <typename T>
+            struct Ring
+            {
+                std::vector<T> records;
+                quint64 written = 0;
+
+                //! Add a record
+                void push(const T &record) { records[static_cast<size_t>(written % records.size())] = record; written++; }
+
+                //! Records, oldest first
+                QVector<T> chronological() const;
+            };
+
+            //! Record an input, sets the step number
+            void recordInput(CInterpolationTrace::InputRecord &input);
+
+            const int m_maxInputs = 0;
+            const int m_maxSteps  = 0;
+            std::atomic<bool> m_enabled { false };
+            std::atomic<quint32> m_generation { 0 };
+            mutable QMutex m_mutex; //!< guards everything below
+            Ring<CInterpolationTrace::InputRecord> m_inputs;
+            Ring<CInterpolationTrace::StepRecord> m_steps;
+            QStringList m_callsigns;
+            QHash<QString, quint32> m_callsignIds;
+        };
+    } // namespace
+} // namespace
+
+Q_DECLARE_TYPEINFO(BlackMisc::Simulation::CCompactParts, Q_MOVABLE_TYPE);
+Q_DECLARE_TYPEINFO(BlackMisc::Simulation::CInterpolationTrace::InputRecord, Q_MOVABLE_TYPE);
+Q_DECLARE_TYPEINFO(BlackMisc::Simulation::CInterpolationTrace::StepRecord, Q_MOVABLE_TYPE);
+
+#endif // guard
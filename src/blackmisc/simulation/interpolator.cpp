@@ -9,6 +9,7 @@
 #include "interpolator.h"
 #include "blackconfig/buildconfig.h"
 #include "blackmisc/simulation/interpolationlogger.h"
+#include "blackmisc/simulation/interpolationtrace.h"
 #include "blackmisc/simulation/interpolatorlinear.h"
 #include "blackmisc/simulation/interpolatorspline.h"
 #include "blackmisc/network/fsdsetup.h"
@@ -24,6 +25,8 @@
 #include <QTimer>
 #include <QDateTime>
 #include <QStringBuilder>
+#include <algorithm>
+#include <type_traits>
 
 using namespace BlackConfig;
 using namespace BlackMisc::Aviation;
@@ -88,10 +91,10 @@ namespace BlackMisc
         }
 
         template<typename Derived>
-        CAircraftSituationList CInterpolator<Derived>::remoteAircraftSituationsAndChange(const CInterpolationAndRenderingSetupPerCallsign &setup)
+        QVector<CCompactSituation> CInterpolator<Derived>::remoteAircraftSituationsAndChange(const CInterpolationAndRenderingSetupPerCallsign &setup)
         {
             // const bool vtol = setup.isForcingFullInterpolation() || m_model.isVtol();
-            CAircraftSituationList validSituations = this->remoteAircraftSituations(m_callsign);
+            QVector<CCompactSituation> validSituations = this->remoteAircraftCompactSituations(m_callsign);
 
             // get the changes, we need the second value as we want to look in the past
             // the first value is already based on the latest situation
@@ -106,8 +109,12 @@ namespace BlackMisc
                 if (!os.isNull())
                 {
                     const CLength addValue = os * -1.0; // positive values means too high, negative values too low
-                    int changed = validSituations.addAltitudeOffset(addValue);
-                    Q_UNUSED(changed)
+                    for (CCompactSituation &situation : validSituations)
+                    {
+                        CAircraftSituation s = situation.toSituation(m_callsign);
+                        s.addAltitudeOffset(addValue);
+                        situation = CCompactSituation::fromSituation(s);
+                    }
                 }
             }
             else
@@ -171,63 +178,100 @@ namespace BlackMisc
 
         template<typename Derived>
         CInterpolationResult CInterpolator<Derived>::getInterpolation(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber)
+        {
+            // the same stages as CInterpolationBatch, with a kernel for this aircraft only
+            CInterpolationKernel::Step step;
+            CInterpolationKernel::Values values {{}};
+            if (this->prepareInterpolation(currentTimeSinceEpoc, setup, aircraftNumber, step)) { values = CInterpolationKernel::evaluate(step); }
+            return this->finishInterpolation(values);
+        }
+
+        template<typename Derived>
+        bool CInterpolator<Derived>::prepareInterpolation(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber, CInterpolationKernel::Step &step)
+        {
+            // make sure we can also interpolate parts only (needed in unit tests)
+            if (aircraftNumber < 0) { aircraftNumber = 0; }
+            m_stepAircraftNumber = aircraftNumber;
+            const bool init = this->initIniterpolationStepData(currentTimeSinceEpoc, setup, aircraftNumber);
+            Q_ASSERT_X(!m_currentInterpolationStatus.isInterpolated(), Q_FUNC_INFO, "Expect reset status");
+            m_stepInterpolate = m_unitTest || init; // failure in real scenarios, unit tests move on
+            if (!m_stepInterpolate) { return false; }
+            Q_ASSERT_X(m_currentTimeMsSinceEpoch > 0, Q_FUNC_INFO, "No valid timestamp, interpolator initialized?");
+            return this->prepareInterpolatedSituation(step);
+        }
+
+        template<typename Derived>
+        CInterpolationResult CInterpolator<Derived>::finishInterpolation(const CInterpolationKernel::Values &values)
         {
             CInterpolationResult result;
-            do
+            if (m_stepInterpolate)
             {
-                // make sure we can also interpolate parts only (needed in unit tests)
-                if (aircraftNumber < 0) { aircraftNumber = 0; }
-                const bool init = this->initIniterpolationStepData(currentTimeSinceEpoc, setup, aircraftNumber);
-                Q_ASSERT_X(!m_currentInterpolationStatus.isInterpolated(), Q_FUNC_INFO, "Expect reset status");
-                if (!m_unitTest && !init) { break; } // failure in real scenarios, unit tests move on
-                Q_ASSERT_X(m_currentTimeMsSinceEpoch > 0, Q_FUNC_INFO, "No valid timestamp, interpolator initialized?");
-                const CAircraftSituation interpolatedSituation = this->getInterpolatedSituation();
-                const CAircraftParts interpolatedParts = this->getInterpolatedOrGuessedParts(aircraftNumber);
+                const CAircraftSituation interpolatedSituation = this->finishInterpolatedSituation(values);
+                const CAircraftParts interpolatedParts = this->getInterpolatedOrGuessedParts(m_stepAircraftNumber);
                 result.setValues(interpolatedSituation, interpolatedParts);
             }
-            while (false);
 
             result.setStatus(m_currentInterpolationStatus, m_currentPartsStatus);
+            if (CInterpolationTraceRecorder *recorder = this->traceRecorder()) { this->traceStep(*recorder, result, m_stepAircraftNumber); }
             return result;
         }
 
         template <typename Derived>
-        CAircraftSituation CInterpolator<Derived>::getInterpolatedSituation()
+        bool CInterpolator<Derived>::prepareInterpolatedSituation(CInterpolationKernel::Step &step)
         {
             Q_ASSERT_X(!m_currentInterpolationStatus.isInterpolated(), Q_FUNC_INFO, "Expect reset status");
-            if (m_currentSituations.isEmpty())
+            m_stepHasSituations = !m_currentSituations.isEmpty();
+            m_stepKernel = false;
+            if (!m_stepHasSituations)
             {
                 m_lastSituation = CAircraftSituation::null();
-                return CAircraftSituation::null();
+                return false;
             }
 
             // interpolant as function of derived class
             // CInterpolatorLinear::Interpolant or CInterpolatorSpline::Interpolant
             SituationLog log;
             const auto interpolant = derived()->getInterpolant(log);
-            const bool isValidInterpolant = interpolant.isValid();
+            if (this->doLogging()) { m_stepLog = log; }
+
+            m_stepSituation = m_lastSituation;
+            if (!interpolant.isValid()) { return false; }
+            const CInterpolatorPbh &pbh = interpolant.pbh();
+
+            // init interpolated situation
+            m_stepSituation = this->initInterpolatedSituation(pbh.getOldSituation(), pbh.getNewSituation());
 
-            CAircraftSituation currentSituation = m_lastSituation;
+            // Pitch bank heading first, so follow up steps could use those values
+            m_stepSituation.setHeading(pbh.getHeading());
+            m_stepSituation.setPitch(pbh.getPitch());
+            m_stepSituation.setBank(pbh.getBank());
+            m_stepSituation.setGroundSpeed(pbh.getGroundSpeed());
+
+            // position and altitude are evaluated by the kernel, then the derived interpolant function is used
+            m_stepInterpolateGndFlag = pbh.getNewSituation().hasGroundDetailsForGndInterpolation() && pbh.getOldSituation().hasGroundDetailsForGndInterpolation();
+            m_stepKernel = interpolant.getKernelStep(step);
+            return m_stepKernel;
+        }
+
+        template <typename Derived>
+        CAircraftSituation CInterpolator<Derived>::finishInterpolatedSituation(const CInterpolationKernel::Values &values)
+        {
+            if (!m_stepHasSituations) { return CAircraftSituation::null(); }
+
+            const auto &interpolant = derived()->getCurrentInterpolant();
+            const bool isValidInterpolant = interpolant.isValid();
+            const bool interpolateGndFlag = m_stepInterpolateGndFlag;
+            CAircraftSituation currentSituation = m_stepSituation;
             CAircraftSituation::AltitudeCorrection altCorrection = CAircraftSituation::NoCorrection;
 
             bool isValidInterpolation = false;
             do
             {
                 if (!isValidInterpolant) { break; }
-                const CInterpolatorPbh pbh = interpolant.pbh();
-
-                // init interpolated situation
-                currentSituation = this->initInterpolatedSituation(pbh.getOldSituation(), pbh.getNewSituation());
+                const CInterpolatorPbh &pbh = interpolant.pbh();
 
-                // Pitch bank heading first, so follow up steps could use those values
-                currentSituation.setHeading(pbh.getHeading());
-                currentSituation.setPitch(pbh.getPitch());
-                currentSituation.setBank(pbh.getBank());
-                currentSituation.setGroundSpeed(pbh.getGroundSpeed());
-
-                // use derived interpolant function
-                const bool interpolateGndFlag = pbh.getNewSituation().hasGroundDetailsForGndInterpolation() && pbh.getOldSituation().hasGroundDetailsForGndInterpolation();
-                currentSituation = interpolant.interpolatePositionAndAltitude(currentSituation, interpolateGndFlag);
+                // use derived interpolant function with the values of the kernel
+                currentSituation = m_stepKernel ? interpolant.interpolatePositionAndAltitude(currentSituation, values, interpolateGndFlag) : CAircraftSituation::null();
                 if (currentSituation.isNull()) { break; }
 
                 // if we get here and the vector is invalid it means we haven't handled it correctly in one of the interpolators
@@ -338,6 +382,7 @@ namespace BlackMisc
             // logging
             if (this->doLogging())
             {
+                SituationLog &log = m_stepLog; // as filled by the interpolant
                 log.tsCurrent = m_currentTimeMsSinceEpoch;
                 log.callsign  = m_callsign;
                 log.groundFactor      = currentSituation.getOnGroundFactor();
@@ -350,7 +395,7 @@ namespace BlackMisc
                 log.cgAboveGround = currentSituation.getCG();
                 log.sceneryOffset = m_currentSceneryOffset;
                 log.noInvalidSituations = m_invalidSituations;
-                log.noNetworkSituations = m_currentSituations.sizeInt();
+                log.noNetworkSituations = m_currentSituations.size();
                 log.useParts = this->isRemoteAircraftSupportingParts(m_callsign);
                 m_logger->logInterpolation(log);
 
@@ -368,6 +413,7 @@ namespace BlackMisc
 
             // Parts are supposed to be in correct order, latest first
             const CAircraftPartsList validParts = this->remoteAircraftParts(m_callsign);
+            if (CInterpolationTraceRecorder *recorder = this->traceRecorder()) { this->traceParts(*recorder, validParts); }
 
             // log for empty parts aircraft parts
             if (validParts.isEmpty())
@@ -483,6 +529,85 @@ namespace BlackMisc
             m_logger->logParts(logInfo);
         }
 
+        template<typename Derived>
+        CInterpolationTraceRecorder *CInterpolator<Derived>::traceRecorder() const
+        {
+            if (!m_logger) { return nullptr; }
+            CInterpolationTraceRecorder &recorder = m_logger->traceRecorder();
+            return recorder.isEnabled() ? &recorder : nullptr;
+        }
+
+        template<typename Derived>
+        quint32 CInterpolator<Derived>::traceCallsignId(CInterpolationTraceRecorder &recorder)
+        {
+            if (!m_hasTraceCallsignId)
+            {
+                m_traceCallsignId = recorder.callsignId(m_callsign);
+                m_hasTraceCallsignId = true;
+            }
+            return m_traceCallsignId;
+        }
+
+        template<typename Derived>
+        void CInterpolator<Derived>::syncTraceGeneration(const CInterpolationTraceRecorder &recorder)
+        {
+            const quint32 generation = recorder.getGeneration();
+            if (generation == m_traceGeneration) { return; }
+            m_traceGeneration = generation;
+            m_lastTracedSituationMs = -1;
+            m_lastTracedPartsMs = -1;
+        }
+
+        template<typename Derived>
+        void CInterpolator<Derived>::traceSituations(CInterpolationTraceRecorder &recorder)
+        {
+            this->syncTraceGeneration(recorder);
+            if (m_currentSituations.isEmpty()) { return; }
+            const quint32 id = this->traceCallsignId(recorder);
+
+            // oldest first, as they were added to the provider
+            for (int i = m_currentSituations.size() - 1; i >= 0; i--)
+            {
+                const CCompactSituation &situation = m_currentSituations[i];
+                if (situation.getMSecsSinceEpoch() <= m_lastTracedSituationMs) { continue; }
+                recorder.recordSituation(id, situation);
+                m_lastTracedSituationMs = situation.getMSecsSinceEpoch();
+            }
+        }
+
+        template<typename Derived>
+        void CInterpolator<Derived>::traceParts(CInterpolationTraceRecorder &recorder, const CAircraftPartsList &parts)
+        {
+            this->syncTraceGeneration(recorder);
+            if (parts.isEmpty()) { return; }
+            const quint32 id = this->traceCallsignId(recorder);
+            for (auto it = parts.crbegin(); it != parts.crend(); ++it)
+            {
+                if (it->getMSecsSinceEpoch() <= m_lastTracedPartsMs) { continue; }
+                recorder.recordParts(id, CCompactParts::fromParts(*it));
+                m_lastTracedPartsMs = it->getMSecsSinceEpoch();
+            }
+        }
+
+        template<typename Derived>
+        void CInterpolator<Derived>::traceStep(CInterpolationTraceRecorder &recorder, const CInterpolationResult &result, int aircraftNumber)
+        {
+            CInterpolationTrace::StepRecord step;
+            step.currentTimeMs = m_currentTimeMsSinceEpoch;
+            step.callsignId = this->traceCallsignId(recorder);
+            step.aircraftNumber = static_cast<qint16>(aircraftNumber);
+            step.mode = static_cast<quint8>(std::is_same<Derived, CInterpolatorLinear>::value ? CInterpolationAndRenderingSetupBase::Linear : CInterpolationAndRenderingSetupBase::Spline);
+            if (m_currentSetup.isAircraftPartsEnabled()) { step.flags |= CInterpolationTrace::PartsEnabled; }
+            if (result.getInterpolationStatus().isInterpolated())
+            {
+                const CAircraftSituation &situation = result.getInterpolatedSituation();
+                step.flags |= CInterpolationTrace::Interpolated;
+                step.normalVector = situation.getPosition().normalVectorDouble();
+                if (!situation.getAltitude().isNull()) { step.altitudeM = situation.getAltitude().value(CLengthUnit::m()); }
+            }
+            recorder.recordStep(step);
+        }
+
         template<typename Derived>
         QString CInterpolator<Derived>::getInterpolatorInfo() const
         {
@@ -521,6 +646,13 @@ namespace BlackMisc
             m_interpolationMessages.clear();
         }
 
+        template<typename Derived>
+        void CInterpolator<Derived>::markSituationsChanged()
+        {
+            m_situationsLastModified = -1;
+            m_situationsLastModifiedUsed = -1;
+        }
+
         template<typename Derived>
         bool CInterpolator<Derived>::initIniterpolationStepData(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber)
         {
@@ -541,13 +673,16 @@ namespace BlackMisc
                 m_currentSituations = this->remoteAircraftSituationsAndChange(setup); // only update when needed
             }
 
+            // every step, so the current situations are traced again after the recorder was cleared
+            if (CInterpolationTraceRecorder *recorder = this->traceRecorder()) { this->traceSituations(*recorder); }
+
             if (!m_model.hasCG() || slowUpdateStep)
             {
                 this->getAndFetchModelCG(CLength::null()); // update CG
             }
 
             bool success = false;
-            const int situationsSize = m_currentSituations.sizeInt();
+            const int situationsSize = m_currentSituations.size();
             m_currentInterpolationStatus.setSituationsCount(situationsSize);
             if (m_currentSituations.isEmpty())
             {
@@ -566,7 +701,8 @@ namespace BlackMisc
                 // so even mixing fast/slow updates shall work
                 if (!CBuildConfig::isReleaseBuild())
                 {
-                    Q_ASSERT_X(m_currentSituations.isSortedAdjustedLatestFirstWithoutNullPositions(), Q_FUNC_INFO, "Wrong sort order");
+                    Q_ASSERT_X(std::is_sorted(m_currentSituations.cbegin(), m_currentSituations.cend(), [](const CCompactSituation & a, const CCompactSituation & b) { return a.getAdjustedMSecsSinceEpoch() > b.getAdjustedMSecsSinceEpoch(); }), Q_FUNC_INFO, "Wrong sort order");
+                    Q_ASSERT_X(std::none_of(m_currentSituations.cbegin(), m_currentSituations.cend(), [](const CCompactSituation & s) { return s.isNull(); }), Q_FUNC_INFO, "Null position");
                     Q_ASSERT_X(m_currentSituations.size() <= IRemoteAircraftProvider::MaxSituationsPerCallsign, Q_FUNC_INFO, "Wrong size");
                 }
             }
@@ -579,7 +715,7 @@ namespace BlackMisc
         {
             if (m_currentSituations.isEmpty()) { return CAircraftSituation::null(); }
 
-            CAircraftSituation currentSituation = m_lastSituation.isNull() ? m_currentSituations.front() : m_lastSituation;
+            CAircraftSituation currentSituation = m_lastSituation.isNull() ? this->getCurrentSituation(0) : m_lastSituation;
             if (currentSituation.getCallsign() != m_callsign)
             {
                 BLACK_VERIFY_X(false, Q_FUNC_INFO, "Wrong callsign");
@@ -12,6 +12,8 @@
 #define BLACKMISC_SIMULATION_INTERPOLATOR_H
 
 #include "interpolationrenderingsetup.h"
+#include "interpolationkernel.h"
+#include "interpolationlogger.h"
 #include "blackmisc/simulation/remoteaircraftprovider.h"
 #include "blackmisc/simulation/interpolationsetupprovider.h"
 #include "blackmisc/simulation/simulationenvironmentprovider.h"
@@ -20,6 +22,7 @@
 #include "blackmisc/aviation/aircraftsituation.h"
 #include "blackmisc/aviation/aircraftpartslist.h"
 #include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/compactsituation.h"
 #include "blackmisc/logcategorylist.h"
 #include "blackmisc/statusmessagelist.h"
 
@@ -27,12 +30,14 @@
 #include <QString>
 #include <QtGlobal>
 #include <QTimer>
+#include <QVector>
 
 namespace BlackMisc
 {
     namespace Simulation
     {
         class CInterpolationLogger;
+        class CInterpolationTraceRecorder;
         class CInterpolatorLinear;
         class CInterpolatorSpline;
 
@@ -195,6 +200,15 @@ namespace BlackMisc
             //! Parts and situation interpolated
             CInterpolationResult getInterpolation(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber = -1);
 
+            //! First stage of getInterpolation, everything before position and altitude are evaluated
+            //! emark true if the kernel step has to be evaluated, otherwise any values can be passed to finishInterpolation
+            //! \sa CInterpolationBatch
+            bool prepareInterpolation(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber, CInterpolationKernel::Step &step);
+
+            //! Second stage of getInterpolation with the evaluated kernel values
+            //! \sa CInterpolationBatch
+            CInterpolationResult finishInterpolation(const CInterpolationKernel::Values &values);
+
             //! Takes input between 0 and 1 and returns output between 0 and 1 smoothed with an S-shaped curve.
             //!
             //! Useful for making interpolation seem smoother, efficiently as it just uses simple arithmetic.
@@ -224,6 +238,10 @@ namespace BlackMisc
             //! \private
             void clear();
 
+            //! Fetch the situations from the provider with the next step, even if the provider timestamp did not change
+            //! \remark needed if situations are added faster than the timestamp resolution, e.g. when replaying a trace
+            void markSituationsChanged();
+
             //! Init, or re-init the corressponding model
             //! \remark either by passing a model or using the provider
             void initCorrespondingModel(const CAircraftModel &model = {});
@@ -255,8 +273,15 @@ namespace BlackMisc
             //! Init the interpolated situation
             Aviation::CAircraftSituation initInterpolatedSituation(const Aviation::CAircraftSituation &oldSituation, const Aviation::CAircraftSituation &newSituation) const;
 
-            //! Current interpolated situation
-            Aviation::CAircraftSituation getInterpolatedSituation();
+            //! Current situation with the given index as situation of this callsign
+            //! \remark converted from the compact record, so only for the situations used
+            Aviation::CAircraftSituation getCurrentSituation(int index) const { return m_currentSituations[index].toSituation(m_callsign); }
+
+            //! Interpolated situation up to the kernel step
+            bool prepareInterpolatedSituation(CInterpolationKernel::Step &step);
+
+            //! Current interpolated situation from the evaluated kernel values
+            Aviation::CAircraftSituation finishInterpolatedSituation(const CInterpolationKernel::Values &values);
 
             //! Parts before given offset time
             Aviation::CAircraftParts getInterpolatedParts();
@@ -280,7 +305,7 @@ namespace BlackMisc
             // values for current interpolation step
             qint64 m_currentTimeMsSinceEpoch = -1;                      //!< current time
             qint64 m_lastInvalidLogTs = -1;                             //!< last invalid situation timestamp
-            Aviation::CAircraftSituationList m_currentSituations;       //!< current situations obtained by remoteAircraftSituationsAndChange
+            QVector<Aviation::CCompactSituation> m_currentSituations;   //!< current situations obtained by remoteAircraftSituationsAndChange, compact records of the provider, latest first
             Aviation::CAircraftSituationChange m_pastSituationsChange;  //!< situations change of provider (i.e. network) situations
             CInterpolationAndRenderingSetupPerCallsign m_currentSetup;  //!< used setup
             CInterpolationStatus m_currentInterpolationStatus;          //!< this step's situation status
@@ -301,6 +326,15 @@ namespace BlackMisc
 
             bool m_unitTest = false; //!< mark as unit test
 
+            // state between prepareInterpolation and finishInterpolation
+            int  m_stepAircraftNumber = 0;         //!< aircraft number of the step
+            bool m_stepInterpolate = false;        //!< step initialized
+            bool m_stepHasSituations = false;      //!< situations for the step
+            bool m_stepKernel = false;             //!< kernel step to be evaluated
+            bool m_stepInterpolateGndFlag = false; //!< ground flag interpolated
+            Aviation::CAircraftSituation m_stepSituation; //!< situation before position and altitude
+            SituationLog m_stepLog;                //!< log of the interpolant
+
             //! Verify gnd flag, times, ... true means "OK"
             bool verifyInterpolationSituations(const Aviation::CAircraftSituation &oldest, const Aviation::CAircraftSituation &newer, const Aviation::CAircraftSituation &latest,
                                                const CInterpolationAndRenderingSetupPerCallsign &setup = CInterpolationAndRenderingSetupPerCallsign::null());
@@ -309,12 +343,39 @@ namespace BlackMisc
             CInterpolationLogger *m_logger = nullptr; //!< optional interpolation logger
             QTimer m_initTimer; //!< timer to init model, will be deleted when interpolator is deleted and cancel the call
 
+            // trace, see CInterpolationTraceRecorder
+            quint32 m_traceCallsignId = 0;        //!< id in the trace
+            bool m_hasTraceCallsignId = false;     //!< m_traceCallsignId set?
+            qint64 m_lastTracedSituationMs = -1;  //!< timestamp of the latest traced situation
+            qint64 m_lastTracedPartsMs = -1;      //!< timestamp of the latest traced parts
+            quint32 m_traceGeneration = 0;        //!< recorder generation of the traced situations and parts
+
             //! Log parts
             void logParts(const Aviation::CAircraftParts &parts, int partsNo, bool empty) const;
 
+            //! Trace recorder of the attached logger, nullptr if not recording
+            CInterpolationTraceRecorder *traceRecorder() const;
+
+            //! Id of m_callsign in the trace
+            quint32 traceCallsignId(CInterpolationTraceRecorder &recorder);
+
+            //! Trace all situations and parts again if the recorder was cleared or enabled again
+            void syncTraceGeneration(const CInterpolationTraceRecorder &recorder);
+
+            //! Record the current situations not traced yet
+            void traceSituations(CInterpolationTraceRecorder &recorder);
+
+            //! Record parts not traced yet
+            //! \param parts latest first
+            void traceParts(CInterpolationTraceRecorder &recorder, const Aviation::CAircraftPartsList &parts);
+
+            //! Record the result of this step
+            void traceStep(CInterpolationTraceRecorder &recorder, const CInterpolationResult &result, int aircraftNumber);
+
             //! Get situations and calculate change, also correct altitudes if applicable
             //! \remark calculates offset (scenery) and situations change
-            Aviation::CAircraftSituationList remoteAircraftSituationsAndChange(const CInterpolationAndRenderingSetupPerCallsign &setup);
+            //! \remark the compact records of the provider, only converted if an offset is applied
+            QVector<Aviation::CCompactSituation> remoteAircraftSituationsAndChange(const CInterpolationAndRenderingSetupPerCallsign &setup);
 
             //! Center of gravity, fetched from provider in case needed
             PhysicalQuantities::CLength getAndFetchModelCG(const PhysicalQuantities::CLength &dbCG);
@@ -10,6 +10,7 @@
 #include "interpolatorfunctions.h"
 #include "blackmisc/aviation/aircraftsituationlist.h"
 #include "blackmisc/aviation/altitude.h"
+#include "blackmisc/aviation/compactsituation.h"
 #include "blackmisc/geo/coordinategeodetic.h"
 #include "blackmisc/pq/length.h"
 #include "blackmisc/pq/physicalquantity.h"
@@ -38,29 +39,43 @@ namespace BlackMisc
     {
         CInterpolatorLinear::CInterpolant::CInterpolant(const CAircraftSituation &oldSituation) :
             IInterpolant(1, CInterpolatorPbh(0, oldSituation, oldSituation)),
-            m_oldSituation(oldSituation)
+            m_oldSituation(CCompactSituation::fromSituation(oldSituation))
         { }
 
         CInterpolatorLinear::CInterpolant::CInterpolant(const CAircraftSituation &oldSituation, const CInterpolatorPbh &pbh) :
             IInterpolant(1, pbh),
-            m_oldSituation(oldSituation)
+            m_oldSituation(CCompactSituation::fromSituation(oldSituation))
         { }
 
         CInterpolatorLinear::CInterpolant::CInterpolant(const CAircraftSituation &oldSituation, const CAircraftSituation &newSituation, double timeFraction, qint64 interpolatedTime) :
             IInterpolant(interpolatedTime, 2),
-            m_oldSituation(oldSituation), m_newSituation(newSituation),
+            m_oldSituation(CCompactSituation::fromSituation(oldSituation)), m_newSituation(CCompactSituation::fromSituation(newSituation)),
             m_simulationTimeFraction(timeFraction)
         {
             m_pbh = CInterpolatorPbh(m_simulationTimeFraction, oldSituation, newSituation);
         }
 
+        void CInterpolatorLinear::CInterpolant::setTimes(double timeFraction, qint64 interpolatedTime)
+        {
+            m_simulationTimeFraction = timeFraction;
+            m_interpolatedTime = interpolatedTime;
+            m_pbh.setTimeFraction(timeFraction);
+        }
+
         void CInterpolatorLinear::anchor()
         { }
 
         CAircraftSituation CInterpolatorLinear::CInterpolant::interpolatePositionAndAltitude(const CAircraftSituation &situation, bool interpolateGndFactor) const
         {
-            const std::array<double, 3> oldVec(m_oldSituation.getPosition().normalVectorDouble());
-            const std::array<double, 3> newVec(m_newSituation.getPosition().normalVectorDouble());
+            CInterpolationKernel::Step step;
+            if (!this->getKernelStep(step)) { return CAircraftSituation::null(); }
+            return this->interpolatePositionAndAltitude(situation, CInterpolationKernel::evaluate(step), interpolateGndFactor);
+        }
+
+        bool CInterpolatorLinear::CInterpolant::getKernelStep(CInterpolationKernel::Step &step) const
+        {
+            const std::array<double, 3> &oldVec = m_oldSituation.getNormalVector();
+            const std::array<double, 3> &newVec = m_newSituation.getNormalVector();
 
             if (CBuildConfig::isLocalDeveloperDebugBuild())
             {
@@ -70,26 +85,28 @@ namespace BlackMisc
             }
 
             // Interpolate position: pos = (posB - posA) * t + posA
+            // Interpolate altitude: Alt = (AltB - AltA) * t + AltA
+            // avoid underflow below ground elevation by using getCorrectedAltitude
+            Q_ASSERT_X(m_oldSituation.getAltitudeDatum() == CAltitude::MeanSeaLevel && m_oldSituation.getAltitudeDatum() == m_newSituation.getAltitudeDatum(), Q_FUNC_INFO, "mismatch in reference"); // otherwise no calculation is possible
+            step.t = clampValidTimeFraction(m_simulationTimeFraction);
+            step.y0 = {{ oldVec[0], oldVec[1], oldVec[2], m_oldSituation.getCorrectedAltitudeM(), m_oldSituation.getOnGroundFactor() }};
+            step.y1 = {{ newVec[0], newVec[1], newVec[2], m_newSituation.getCorrectedAltitudeM(), m_newSituation.getOnGroundFactor() }};
+            step.a.fill(0.0);
+            step.b.fill(0.0);
+            return true;
+        }
+
+        CAircraftSituation CInterpolatorLinear::CInterpolant::interpolatePositionAndAltitude(const CAircraftSituation &situation, const CInterpolationKernel::Values &values, bool interpolateGndFactor) const
+        {
             CCoordinateGeodetic newPosition;
-            const double tf = clampValidTimeFraction(m_simulationTimeFraction);
-            newPosition.setNormalVector((newVec[0] - oldVec[0]) * tf + oldVec[0],
-                                        (newVec[1] - oldVec[1]) * tf + oldVec[1],
-                                        (newVec[2] - oldVec[2]) * tf + oldVec[2]);
+            newPosition.setNormalVector(values[CInterpolationKernel::X], values[CInterpolationKernel::Y], values[CInterpolationKernel::Z]);
 
             if (CBuildConfig::isLocalDeveloperDebugBuild())
             {
                 BLACK_VERIFY_X(newPosition.isValidVectorRange(), Q_FUNC_INFO, "Invalid vector");
             }
 
-            // Interpolate altitude: Alt = (AltB - AltA) * t + AltA
-            // avoid underflow below ground elevation by using getCorrectedAltitude
-            const CAltitude oldAlt(m_oldSituation.getCorrectedAltitude());
-            const CAltitude newAlt(m_newSituation.getCorrectedAltitude());
-            Q_ASSERT_X(oldAlt.getReferenceDatum() == CAltitude::MeanSeaLevel && oldAlt.getReferenceDatum() == newAlt.getReferenceDatum(), Q_FUNC_INFO, "mismatch in reference"); // otherwise no calculation is possible
-            const CAltitude altitude((newAlt - oldAlt)
-                                     * tf
-                                     + oldAlt,
-                                     oldAlt.getReferenceDatum());
+            const CAltitude altitude(values[CInterpolationKernel::Altitude], CAltitude::MeanSeaLevel, CLengthUnit::m());
 
             CAircraftSituation newSituation(situation);
             newSituation.setPosition(newPosition);
@@ -104,8 +121,7 @@ namespace BlackMisc
                 {
                     if (CAircraftSituation::isGfEqualAirborne(oldGroundFactor, newGroundFactor)) { newSituation.setOnGround(false); break; }
                     if (CAircraftSituation::isGfEqualOnGround(oldGroundFactor, newGroundFactor)) { newSituation.setOnGround(true);  break; }
-                    const double groundFactor = (newGroundFactor - oldGroundFactor) * tf + oldGroundFactor;
-                    newSituation.setOnGroundFactor(groundFactor);
+                    newSituation.setOnGroundFactor(values[CInterpolationKernel::GroundFactor]);
                     newSituation.setOnGroundFromGroundFactorFromInterpolation(groundInterpolationFactor());
                 }
                 while (false);
@@ -115,9 +131,9 @@ namespace BlackMisc
 
         CInterpolatorLinear::CInterpolant CInterpolatorLinear::getInterpolant(SituationLog &log)
         {
-            // set default situations
-            CAircraftSituation oldSituation = m_interpolant.getOldSituation();
-            CAircraftSituation newSituation = m_interpolant.getNewSituation();
+            // default situations, updated if recalculated
+            CAircraftSituation &oldSituation = m_oldSituation;
+            CAircraftSituation &newSituation = m_newSituation;
 
             Q_ASSERT_X(newSituation.getAdjustedMSecsSinceEpoch() >= oldSituation.getAdjustedMSecsSinceEpoch(), Q_FUNC_INFO, "Wrong order");
 
@@ -130,9 +146,10 @@ namespace BlackMisc
                 m_situationsLastModifiedUsed = m_situationsLastModified;
 
                 // find the first situation earlier than the current time
-                const auto pivot = std::partition_point(m_currentSituations.begin(), m_currentSituations.end(), [ = ](auto &&s) { return s.getAdjustedMSecsSinceEpoch() > m_currentTimeMsSinceEpoch; });
-                const auto situationsNewer = makeRange(m_currentSituations.begin(), pivot);
-                const auto situationsOlder = makeRange(pivot, m_currentSituations.end());
+                // searched in the compact records, only the used situations are converted
+                const auto pivot = std::partition_point(m_currentSituations.cbegin(), m_currentSituations.cend(), [ = ](const CCompactSituation &s) { return s.getAdjustedMSecsSinceEpoch() > m_currentTimeMsSinceEpoch; });
+                const int situationsNewer = static_cast<int>(pivot - m_currentSituations.cbegin());
+                const int situationsOlder = m_currentSituations.size() - situationsNewer;
 
                 // latest first, now 00:20 split time
                 // time     pos
@@ -145,34 +162,38 @@ namespace BlackMisc
 
                 // The first condition covers a situation, when there are no before / after situations.
                 // We just place at the last position until we get before / after situations
-                if (situationsOlder.isEmpty() || situationsNewer.isEmpty())
+                if (situationsOlder < 1 || situationsNewer < 1)
                 {
                     // no before situations
-                    if (situationsOlder.isEmpty())
+                    if (situationsOlder < 1)
                     {
-                        const CAircraftSituation currentSituation(*(situationsNewer.end() - 1)); // oldest newest
+                        const CAircraftSituation currentSituation(this->getCurrentSituation(situationsNewer - 1)); // oldest newest
                         m_currentInterpolationStatus.setInterpolatedAndCheckSituation(false, currentSituation);
                         m_interpolant = { currentSituation };
+                        oldSituation = currentSituation;
+                        newSituation = CAircraftSituation();
                         return m_interpolant;
                     }
 
                     // only one before situation
-                    if (situationsOlder.size() < 2)
+                    if (situationsOlder < 2)
                     {
-                        const CAircraftSituation currentSituation(situationsOlder.front()); // latest oldest
+                        const CAircraftSituation currentSituation(this->getCurrentSituation(situationsNewer)); // latest oldest
                         m_currentInterpolationStatus.setInterpolatedAndCheckSituation(false, currentSituation);
                         m_interpolant = { currentSituation };
+                        oldSituation = currentSituation;
+                        newSituation = CAircraftSituation();
                         return m_interpolant;
                     }
 
                     // extrapolate from two before situations
-                    oldSituation = *(situationsOlder.begin() + 1); // before newest
-                    newSituation = situationsOlder.front(); // newest
+                    oldSituation = this->getCurrentSituation(situationsNewer + 1); // before newest
+                    newSituation = this->getCurrentSituation(situationsNewer); // newest
                 }
                 else
                 {
-                    oldSituation = situationsOlder.front(); // first oldest (aka newest oldest)
-                    newSituation = *(situationsNewer.end() - 1); // latest newest (aka oldest of newer block)
+                    oldSituation = this->getCurrentSituation(situationsNewer); // first oldest (aka newest oldest)
+                    newSituation = this->getCurrentSituation(situationsNewer - 1); // latest newest (aka oldest of newer block)
                     Q_ASSERT(oldSituation.getAdjustedMSecsSinceEpoch() < newSituation.getAdjustedMSecsSinceEpoch());
                 }
 
@@ -229,7 +250,15 @@ namespace BlackMisc
                 log.interpolantRecalc = recalculate;
             }
 
-            m_interpolant = { oldSituation, newSituation, simulationTimeFraction, interpolatedTime };
+            if (recalculate)
+            {
+                m_interpolant = { oldSituation, newSituation, simulationTimeFraction, interpolatedTime };
+            }
+            else
+            {
+                // same situations, no need to convert them again
+                m_interpolant.setTimes(simulationTimeFraction, interpolatedTime);
+            }
             m_interpolant.setRecalculated(recalculate);
 
             return m_interpolant;
@@ -14,7 +14,9 @@
 #include "interpolator.h"
 #include "interpolationlogger.h"
 #include "interpolant.h"
+#include "interpolationkernel.h"
 #include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/compactsituation.h"
 #include "blackmisc/blackmiscexport.h"
 #include <QString>
 #include <QtGlobal>
@@ -53,23 +55,38 @@ namespace BlackMisc
                 //! Perform the interpolation
                 Aviation::CAircraftSituation interpolatePositionAndAltitude(const Aviation::CAircraftSituation &situation, bool interpolateGndFactor) const;
 
+                //! Position and altitude as step of the kernel, altitude in m
+                //! \return false if there is nothing to interpolate
+                bool getKernelStep(CInterpolationKernel::Step &step) const;
+
+                //! Perform the interpolation with the values evaluated by the kernel
+                Aviation::CAircraftSituation interpolatePositionAndAltitude(const Aviation::CAircraftSituation &situation, const CInterpolationKernel::Values &values, bool interpolateGndFactor) const;
+
+                //! Set the time values, the situations remain
+                void setTimes(double timeFraction, qint64 interpolatedTime);
+
                 //! Old situation
-                const Aviation::CAircraftSituation &getOldSituation() const { return m_oldSituation; }
+                const Aviation::CCompactSituation &getOldSituation() const { return m_oldSituation; }
 
                 //! New situation
-                const Aviation::CAircraftSituation &getNewSituation() const { return m_newSituation; }
+                const Aviation::CCompactSituation &getNewSituation() const { return m_newSituation; }
 
             private:
-                Aviation::CAircraftSituation m_oldSituation;
-                Aviation::CAircraftSituation m_newSituation;
+                Aviation::CCompactSituation m_oldSituation; //!< compact, the interpolant is copied with every step
+                Aviation::CCompactSituation m_newSituation; //!< compact, the interpolant is copied with every step
                 double m_simulationTimeFraction = 0.0; //!< 0..1
             };
 
             //! Get the interpolant for the given time point
             CInterpolant getInterpolant(SituationLog &log);
 
+            //! The interpolant of the current step, as returned by getInterpolant
+            const CInterpolant &getCurrentInterpolant() const { return m_interpolant; }
+
         private:
             CInterpolant m_interpolant; //!< current interpolant
+            Aviation::CAircraftSituation m_oldSituation; //!< old situation of the current interpolant
+            Aviation::CAircraftSituation m_newSituation; //!< new situation of the current interpolant, default if there is only one
         };
     } // ns
 } // ns
@@ -33,6 +33,29 @@ namespace BlackMisc
             return CInterpolationResult();
         }
 
+        bool CInterpolatorMulti::prepareInterpolation(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber, CInterpolationKernel::Step &step)
+        {
+            m_stepMode = setup.getInterpolatorMode();
+            switch (m_stepMode)
+            {
+            case CInterpolationAndRenderingSetupBase::Linear: return m_linear.prepareInterpolation(currentTimeSinceEpoc, setup, aircraftNumber, step);
+            case CInterpolationAndRenderingSetupBase::Spline: return m_spline.prepareInterpolation(currentTimeSinceEpoc, setup, aircraftNumber, step);
+            default: break;
+            }
+            return false;
+        }
+
+        CInterpolationResult CInterpolatorMulti::finishInterpolation(const CInterpolationKernel::Values &values)
+        {
+            switch (m_stepMode)
+            {
+            case CInterpolationAndRenderingSetupBase::Linear: return m_linear.finishInterpolation(values);
+            case CInterpolationAndRenderingSetupBase::Spline: return m_spline.finishInterpolation(values);
+            default: break;
+            }
+            return CInterpolationResult();
+        }
+
         const CAircraftSituation &CInterpolatorMulti::getLastInterpolatedSituation(CInterpolationAndRenderingSetupBase::InterpolatorMode mode) const
         {
             switch (mode)
@@ -50,6 +73,12 @@ namespace BlackMisc
             m_spline.attachLogger(logger);
         }
 
+        void CInterpolatorMulti::markSituationsChanged()
+        {
+            m_linear.markSituationsChanged();
+            m_spline.markSituationsChanged();
+        }
+
         void CInterpolatorMulti::initCorrespondingModel(const CAircraftModel &model)
         {
             m_linear.initCorrespondingModel(model);
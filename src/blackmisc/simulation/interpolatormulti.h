@@ -31,6 +31,13 @@ namespace BlackMisc
             //! \copydoc CInterpolator::getInterpolation
             CInterpolationResult getInterpolation(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber);
 
+            //! \copydoc CInterpolator::prepareInterpolation
+            bool prepareInterpolation(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber, CInterpolationKernel::Step &step);
+
+            //! \copydoc CInterpolator::finishInterpolation
+            //! \remark uses the interpolator of the mode passed to prepareInterpolation
+            CInterpolationResult finishInterpolation(const CInterpolationKernel::Values &values);
+
             //! \copydoc CInterpolator::getLastInterpolatedSituation
             const Aviation::CAircraftSituation &getLastInterpolatedSituation(CInterpolationAndRenderingSetupBase::InterpolatorMode mode) const;
 
@@ -40,6 +47,9 @@ namespace BlackMisc
             //! \copydoc CInterpolator::attachLogger
             void attachLogger(CInterpolationLogger *logger);
 
+            //! \copydoc CInterpolator::markSituationsChanged
+            void markSituationsChanged();
+
             //! \copydoc CInterpolator::initCorrespondingModel
             void initCorrespondingModel(const CAircraftModel &model);
 
@@ -49,6 +59,7 @@ namespace BlackMisc
         private:
             CInterpolatorSpline m_spline;
             CInterpolatorLinear m_linear;
+            CInterpolationAndRenderingSetupBase::InterpolatorMode m_stepMode = CInterpolationAndRenderingSetupBase::Spline; //!< mode between prepareInterpolation and finishInterpolation
         };
 
         /**
@@ -88,20 +88,14 @@ namespace BlackMisc
                 return b;
             }
 
-            //! \private Cubic interpolation.
-            double evalSplineInterval(double x, double x0, double x1, double y0, double y1, double k0, double k1)
+            //! \private Cubic interpolation of the interval x0..x1 with the derivatives k0, k1 as step of the kernel.
+            //! \sa CInterpolationKernel
+            void setSplineInterval(CInterpolationKernel::Step &step, int channel, double x0, double x1, double y0, double y1, double k0, double k1)
             {
-                const double t = (x - x0) / (x1 - x0);
-                const double a =  k0 * (x1 - x0) - (y1 - y0);
-                const double b = -k1 * (x1 - x0) + (y1 - y0);
-                const double y = (1 - t) * y0 + t * y1 + t * (1 - t) * (a * (1 - t) + b * t);
-
-                if (CBuildConfig::isLocalDeveloperDebugBuild())
-                {
-                    BLACK_VERIFY_X(t >= 0,   Q_FUNC_INFO, "Expect t >= 0");
-                    BLACK_VERIFY_X(t <= 1.0, Q_FUNC_INFO, "Expect t <= 1");
-                }
-                return y;
+                step.y0[channel] = y0;
+                step.y1[channel] = y1;
+                step.a[channel]  =  k0 * (x1 - x0) - (y1 - y0);
+                step.b[channel]  = -k1 * (x1 - x0) + (y1 - y0);
             }
         }
 
@@ -122,7 +116,7 @@ namespace BlackMisc
                 else
                 {
                     // we start with the latest situation just to init the values
-                    CAircraftSituation f = m_currentSituations.front();
+                    CAircraftSituation f = this->getCurrentSituation(0);
                     f.setAdjustedMSecsSinceEpoch(m_currentTimeMsSinceEpoch); // adjusted time exactly "now"
                     m_s[0] = m_s[1] = m_s[2] = f;
                 }
@@ -142,22 +136,22 @@ namespace BlackMisc
 
             // and use the real values if available
             // m_s[0] .. oldest -> m_[2] .. latest
-            const CAircraftSituation latest = m_currentSituations.front();
-            if (latest.isNewerThanAdjusted(m_s[1])) { m_s[2] = latest; }
+            // searched in the compact records, only the used situations are converted
+            if (m_currentSituations.front().getAdjustedMSecsSinceEpoch() > m_s[1].getAdjustedMSecsSinceEpoch()) { m_s[2] = this->getCurrentSituation(0); }
             const qint64 currentAdjusted = m_s[1].getAdjustedMSecsSinceEpoch();
 
             // with https://dev.swift-project.org/T668#15841 avoid 2 very close positions
             // currently done by time, maybe we can also choose distance
             const qint64 osNotTooClose = qRound64(0.8 * os);
-            const CAircraftSituation older = m_currentSituations.findObjectBeforeAdjustedOrDefault(currentAdjusted - osNotTooClose);
-            if (!older.isNull())
+            const int older = this->latestBeforeAdjusted(currentAdjusted - osNotTooClose);
+            if (older >= 0 && !m_currentSituations[older].isNull())
             {
-                m_s[0] = older;
+                m_s[0] = this->getCurrentSituation(older);
             }
             else
             {
-                const CAircraftSituation closeOlder = m_currentSituations.findObjectBeforeAdjustedOrDefault(currentAdjusted);
-                if (!closeOlder.isNull()) { m_s[0] = closeOlder; }
+                const int closeOlder = this->latestBeforeAdjusted(currentAdjusted);
+                if (closeOlder >= 0 && !m_currentSituations[closeOlder].isNull()) { m_s[0] = this->getCurrentSituation(closeOlder); }
             }
             const qint64 latestAdjusted = m_s[2].getAdjustedMSecsSinceEpoch();
             const qint64 olderAdjusted  = m_s[0].getAdjustedMSecsSinceEpoch();
@@ -180,6 +174,18 @@ namespace BlackMisc
             return hasNewer;
         }
 
+        int CInterpolatorSpline::latestBeforeAdjusted(qint64 msSinceEpoch) const
+        {
+            int latest = -1;
+            for (int i = 0; i < m_currentSituations.size(); i++)
+            {
+                const qint64 adjusted = m_currentSituations[i].getAdjustedMSecsSinceEpoch();
+                if (adjusted >= msSinceEpoch) { continue; }
+                if (latest < 0 || adjusted > m_currentSituations[latest].getAdjustedMSecsSinceEpoch()) { latest = i; }
+            }
+            return latest;
+        }
+
         // pin vtables to this file
         void CInterpolatorSpline::anchor()
         { }
@@ -326,6 +332,13 @@ namespace BlackMisc
         }
 
         CAircraftSituation CInterpolatorSpline::CInterpolant::interpolatePositionAndAltitude(const CAircraftSituation &currentSituation, bool interpolateGndFactor) const
+        {
+            CInterpolationKernel::Step step;
+            if (!this->getKernelStep(step)) { return CAircraftSituation::null(); }
+            return this->interpolatePositionAndAltitude(currentSituation, CInterpolationKernel::evaluate(step), interpolateGndFactor);
+        }
+
+        bool CInterpolatorSpline::CInterpolant::getKernelStep(CInterpolationKernel::Step &step) const
         {
             const double t1 = m_pa.t[1];
             const double t2 = m_pa.t[2]; // latest (adjusted)
@@ -337,11 +350,7 @@ namespace BlackMisc
                 BLACK_VERIFY_X(m_currentTimeMsSinceEpoc >= t1, Q_FUNC_INFO, "invalid timestamp t1");
                 BLACK_VERIFY_X(m_currentTimeMsSinceEpoc <  t2, Q_FUNC_INFO, "invalid timestamp t2"); // t1==t2 results in div/0
             }
-            if (!valid) { return CAircraftSituation::null(); }
-
-            const double newX = evalSplineInterval(m_currentTimeMsSinceEpoc, t1, t2, m_pa.x[1], m_pa.x[2], m_pa.dx[1], m_pa.dx[2]);
-            const double newY = evalSplineInterval(m_currentTimeMsSinceEpoc, t1, t2, m_pa.y[1], m_pa.y[2], m_pa.dy[1], m_pa.dy[2]);
-            const double newZ = evalSplineInterval(m_currentTimeMsSinceEpoc, t1, t2, m_pa.z[1], m_pa.z[2], m_pa.dz[1], m_pa.dz[2]);
+            if (!valid) { return false; }
 
             valid = CAircraftSituation::isValidVector(m_pa.x) && CAircraftSituation::isValidVector(m_pa.y) && CAircraftSituation::isValidVector(m_pa.z);
             if (!valid && CBuildConfig::isLocalDeveloperDebugBuild())
@@ -350,13 +359,24 @@ namespace BlackMisc
                 BLACK_VERIFY_X(CAircraftSituation::isValidVector(m_pa.y), Q_FUNC_INFO, "invalid Y"); // all y values
                 BLACK_VERIFY_X(CAircraftSituation::isValidVector(m_pa.z), Q_FUNC_INFO, "invalid Z"); // all z values
             }
-            if (!valid) { return CAircraftSituation::null(); }
+            if (!valid) { return false; }
+
+            step.t = (m_currentTimeMsSinceEpoc - t1) / (t2 - t1);
+            setSplineInterval(step, CInterpolationKernel::X, t1, t2, m_pa.x[1], m_pa.x[2], m_pa.dx[1], m_pa.dx[2]);
+            setSplineInterval(step, CInterpolationKernel::Y, t1, t2, m_pa.y[1], m_pa.y[2], m_pa.dy[1], m_pa.dy[2]);
+            setSplineInterval(step, CInterpolationKernel::Z, t1, t2, m_pa.z[1], m_pa.z[2], m_pa.dz[1], m_pa.dz[2]);
+            setSplineInterval(step, CInterpolationKernel::Altitude, t1, t2, m_pa.a[1], m_pa.a[2], m_pa.da[1], m_pa.da[2]);
+            setSplineInterval(step, CInterpolationKernel::GroundFactor, t1, t2, m_pa.gnd[1], m_pa.gnd[2], m_pa.dgnd[1], m_pa.dgnd[2]);
+            return true;
+        }
 
+        CAircraftSituation CInterpolatorSpline::CInterpolant::interpolatePositionAndAltitude(const CAircraftSituation &currentSituation, const CInterpolationKernel::Values &values, bool interpolateGndFactor) const
+        {
             CAircraftSituation newSituation(currentSituation);
-            const std::array<double, 3> normalVector = {{ newX, newY, newZ }};
+            const std::array<double, 3> normalVector = {{ values[CInterpolationKernel::X], values[CInterpolationKernel::Y], values[CInterpolationKernel::Z] }};
             const CCoordinateGeodetic currentPosition(normalVector);
 
-            valid = CAircraftSituation::isValidVector(normalVector);
+            const bool valid = CAircraftSituation::isValidVector(normalVector);
             if (!valid && CBuildConfig::isLocalDeveloperDebugBuild())
             {
                 BLACK_VERIFY_X(valid, Q_FUNC_INFO, "invalid vector");
@@ -365,8 +385,7 @@ namespace BlackMisc
             }
             if (!valid) { return CAircraftSituation::null(); }
 
-            const double newA = evalSplineInterval(m_currentTimeMsSinceEpoc, t1, t2, m_pa.a[1], m_pa.a[2], m_pa.da[1], m_pa.da[2]);
-            const CAltitude alt(newA, m_altitudeUnit);
+            const CAltitude alt(values[CInterpolationKernel::Altitude], m_altitudeUnit);
 
             newSituation.setPosition(currentPosition);
             newSituation.setAltitude(alt);
@@ -381,8 +400,7 @@ namespace BlackMisc
                     newSituation.setOnGroundDetails(CAircraftSituation::OnGroundByInterpolation);
                     if (CAircraftSituation::isGfEqualAirborne(gnd1, gnd2)) { newSituation.setOnGround(false); break; }
                     if (CAircraftSituation::isGfEqualOnGround(gnd1, gnd2)) { newSituation.setOnGround(true); break; }
-                    const double newGnd = evalSplineInterval(m_currentTimeMsSinceEpoc, t1, t2, gnd1, gnd2, m_pa.dgnd[1], m_pa.dgnd[2]);
-                    newSituation.setOnGroundFactor(newGnd);
+                    newSituation.setOnGroundFactor(values[CInterpolationKernel::GroundFactor]);
                     newSituation.setOnGroundFromGroundFactorFromInterpolation(groundInterpolationFactor());
                 }
                 while (false);
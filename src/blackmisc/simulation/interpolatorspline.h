@@ -14,6 +14,7 @@
 #include "interpolator.h"
 #include "interpolationlogger.h"
 #include "interpolant.h"
+#include "interpolationkernel.h"
 #include "blackmisc/aviation/aircraftsituation.h"
 #include "blackmisc/blackmiscexport.h"
 #include <QString>
@@ -66,6 +67,13 @@ namespace BlackMisc
                 //! Perform the interpolation
                 Aviation::CAircraftSituation interpolatePositionAndAltitude(const Aviation::CAircraftSituation &currentSituation, bool interpolateGndFactor) const;
 
+                //! Position and altitude as step of the kernel, altitude in the altitude unit of the interpolant
+                //! \return false if the current time is not within the interval or the positions are invalid
+                bool getKernelStep(CInterpolationKernel::Step &step) const;
+
+                //! Perform the interpolation with the values evaluated by the kernel
+                Aviation::CAircraftSituation interpolatePositionAndAltitude(const Aviation::CAircraftSituation &currentSituation, const CInterpolationKernel::Values &values, bool interpolateGndFactor) const;
+
                 //! Old situation
                 const Aviation::CAircraftSituation &getOldSituation() const { return pbh().getOldSituation(); }
 
@@ -84,9 +92,12 @@ namespace BlackMisc
                 qint64 m_currentTimeMsSinceEpoc { -1 };
             };
 
-            //! Strategy used by CInterpolator::getInterpolatedSituation
+            //! Strategy used by CInterpolator::prepareInterpolatedSituation
             CInterpolant getInterpolant(SituationLog &log);
 
+            //! The interpolant of the current step, as returned by getInterpolant
+            const CInterpolant &getCurrentInterpolant() const { return m_interpolant; }
+
         private:
             //! Update the elevations used in CInterpolatorSpline::m_s
             bool updateElevations(bool canSkip);
@@ -100,6 +111,9 @@ namespace BlackMisc
             //! Fill the situations array
             bool fillSituationsArray();
 
+            //! Index of the latest situation with an adjusted timestamp before msSinceEpoch, -1 if there is none
+            int latestBeforeAdjusted(qint64 msSinceEpoch) const;
+
             qint64 m_prevSampleAdjustedTime = 0; //!< previous sample time + offset
             qint64 m_nextSampleAdjustedTime = 0; //!< previous sample time + offset
             qint64 m_prevSampleTime = 0; //!< previous sample "real time"
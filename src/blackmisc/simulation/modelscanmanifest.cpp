@@ -0,0 +1,155 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/modelscanmanifest.h"
+#include "blackmisc/simulation/simulatorinfo.h"
+#include "blackmisc/fileutils.h"
+#include "blackmisc/swiftdirectories.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStringBuilder>
+#include <algorithm>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        namespace
+        {
+            //! File format
+            //! @{
+            constexpr quint32 FileMagic   = 0x4D4E4653; // "MNFS"
+            constexpr quint32 FileVersion = 1;
+            constexpr int StreamVersion   = QDataStream::Qt_5_6;
+            //! @}
+        }
+
+        bool CModelScanManifest::findUnchanged(const QString &filePath, const QFileInfo &file, Entry &o_entry) const
+        {
+            const auto it = m_entries.constFind(filePath);
+            if (it == m_entries.constEnd()) { return false; }
+            if (it->size != file.size() || it->lastModifiedMs != file.lastModified().toMSecsSinceEpoch()) { return false; }
+            o_entry = *it;
+            return true;
+        }
+
+        bool CModelScanManifest::findSameContent(const QString &filePath, const QByteArray &contentHash, Entry &o_entry) const
+        {
+            const auto it = m_entries.constFind(filePath);
+            if (it == m_entries.constEnd() || contentHash.isEmpty() || it->contentHash != contentHash) { return false; }
+            o_entry = *it;
+            return true;
+        }
+
+        CModelScanManifest::Entry CModelScanManifest::createEntry(const QFileInfo &file, const QByteArray &contentHash, const QByteArray &parsed)
+        {
+            Entry entry;
+            entry.lastModifiedMs = file.lastModified().toMSecsSinceEpoch();
+            entry.size = file.size();
+            entry.contentHash = contentHash;
+            entry.parsed = parsed;
+            return entry;
+        }
+
+        QByteArray CModelScanManifest::contentHash(const QByteArray &content)
+        {
+            return QCryptographicHash::hash(content, QCryptographicHash::Md5);
+        }
+
+        void CModelScanManifest::insert(const QString &filePath, const Entry &entry)
+        {
+            m_entries.insert(filePath, entry);
+        }
+
+        void CModelScanManifest::replaceDirectories(const QStringList &directories, const CModelScanManifest &scanned)
+        {
+            QStringList prefixes;
+            for (const QString &directory : directories)
+            {
+                if (directory.isEmpty()) { continue; }
+                QString prefix = QDir::cleanPath(QDir(directory).absolutePath());
+                if (!prefix.endsWith('/')) { prefix += '/'; }
+                prefixes.push_back(prefix);
+            }
+
+            const Qt::CaseSensitivity cs = CFileUtils::osFileNameCaseSensitivity();
+            for (auto it = m_entries.begin(); it != m_entries.end();)
+            {
+                const QString &filePath = it.key();
+                const bool scannedDirectory = std::any_of(prefixes.cbegin(), prefixes.cend(), [&](const QString &prefix) { return filePath.startsWith(prefix, cs); });
+                if (scannedDirectory) { it = m_entries.erase(it); }
+                else { ++it; }
+            }
+            for (auto it = scanned.m_entries.constBegin(); it != scanned.m_entries.constEnd(); ++it)
+            {
+                m_entries.insert(it.key(), it.value());
+            }
+        }
+
+        bool CModelScanManifest::writeToFile(const QString &fileName) const
+        {
+            if (fileName.isEmpty()) { return false; }
+            const QFileInfo fi(fileName);
+            if (!fi.absoluteDir().exists() && !QDir().mkpath(fi.absolutePath())) { return false; }
+
+            QSaveFile file(fileName);
+            if (!file.open(QIODevice::WriteOnly)) { return false; }
+            QDataStream stream(&file);
+            stream.setVersion(StreamVersion);
+            stream << FileMagic << FileVersion << m_parserVersion << static_cast<qint32>(m_entries.size());
+            for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it)
+            {
+                stream << it.key() << it->lastModifiedMs << it->size << it->contentHash << it->parsed;
+            }
+            if (stream.status() != QDataStream::Ok) { file.cancelWriting(); return false; }
+            return file.commit();
+        }
+
+        bool CModelScanManifest::readFromFile(const QString &fileName)
+        {
+            QFile file(fileName);
+            if (!file.open(QIODevice::ReadOnly)) { return false; }
+            QDataStream stream(&file);
+            stream.setVersion(StreamVersion);
+
+            quint32 magic = 0;
+            quint32 version = 0;
+            quint32 parserVersion = 0;
+            qint32 count = 0;
+            stream >> magic >> version >> parserVersion >> count;
+            if (stream.status() != QDataStream::Ok || magic != FileMagic || version != FileVersion || parserVersion != m_parserVersion || count < 0) { return false; }
+
+            // all or nothing
+            QHash<QString, Entry> entries;
+            for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++)
+            {
+                QString filePath;
+                Entry entry;
+                stream >> filePath >> entry.lastModifiedMs >> entry.size >> entry.contentHash >> entry.parsed;
+                entries.insert(filePath, entry);
+            }
+            if (stream.status() != QDataStream::Ok) { return false; }
+            m_entries = entries;
+            return true;
+        }
+
+        QString CModelScanManifest::manifestFilePath(const CSimulatorInfo &simulator, const QString &name)
+        {
+            const QString &id = simulator.toPluginIdentifier();
+            if (id.isEmpty() || name.isEmpty()) { return {}; }
+            static const QString dir = CFileUtils::appendFilePaths(CSwiftDirectories::normalizedApplicationDataDirectory(), "modelscan");
+            return CFileUtils::appendFilePaths(dir, id % u'_' % name % u".manifest");
+        }
+    } // namespace
+} // namespace
@@ -0,0 +1,99 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_MODELSCANMANIFEST_H
+#define BLACKMISC_SIMULATION_MODELSCANMANIFEST_H
+
+#include "blackmisc/blackmiscexport.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QtGlobal>
+
+class QFileInfo;
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        class CSimulatorInfo;
+
+        //! Parsed content of model files (aircraft.cfg, *.acf, ...) from a previous scan of the model directories
+        //! \remark a file is only parsed again if its timestamp, size or content has changed
+        //! \remark the parsed content is serialized by the model loader, the manifest does not know its type
+        //! \remark lookups are threadsafe as long as the manifest is not changed, so files can be looked up in parallel
+        class BLACKMISC_EXPORT CModelScanManifest
+        {
+        public:
+            //! One parsed file
+            struct Entry
+            {
+                qint64 lastModifiedMs = -1; //!< file timestamp
+                qint64 size = -1;           //!< file size
+                QByteArray contentHash;     //!< hash of the file content
+                QByteArray parsed;          //!< parsed content, serialized by the model loader
+            };
+
+            //! Ctor
+            //! \param parserVersion version of the parser, a manifest written by another version is not read
+            explicit CModelScanManifest(quint32 parserVersion = 1) : m_parserVersion(parserVersion) {}
+
+            //! Entry of an unchanged file, same timestamp and size
+            bool findUnchanged(const QString &filePath, const QFileInfo &file, Entry &o_entry) const;
+
+            //! Entry of a file with the same content, e.g. touched or copied with a new timestamp
+            bool findSameContent(const QString &filePath, const QByteArray &contentHash, Entry &o_entry) const;
+
+            //! Entry for a file just parsed
+            static Entry createEntry(const QFileInfo &file, const QByteArray &contentHash, const QByteArray &parsed);
+
+            //! Hash of a file content
+            static QByteArray contentHash(const QByteArray &content);
+
+            //! Add or replace the entry of a file
+            void insert(const QString &filePath, const Entry &entry);
+
+            //! Replace the entries of all files in the given directories by the entries of a new scan of these directories
+            //! \remark entries of other directories are kept, so scanning some directories does not drop the others
+            //! \remark files no longer found in the scanned directories are dropped
+            void replaceDirectories(const QStringList &directories, const CModelScanManifest &scanned);
+
+            //! Entry for the file?
+            bool contains(const QString &filePath) const { return m_entries.contains(filePath); }
+
+            //! Number of files
+            int size() const { return m_entries.size(); }
+
+            //! Empty?
+            bool isEmpty() const { return m_entries.isEmpty(); }
+
+            //! Remove all
+            void clear() { m_entries.clear(); }
+
+            //! Write the manifest to a file
+            bool writeToFile(const QString &fileName) const;
+
+            //! Read the manifest from a file, replacing all entries
+            //! \remark false if the file was written by another parser version
+            bool readFromFile(const QString &fileName);
+
+            //! File for the manifest of a model loader, e.g. "aircraftcfg" for one simulator
+            static QString manifestFilePath(const CSimulatorInfo &simulator, const QString &name);
+
+        private:
+            QHash<QString, Entry> m_entries; //!< entries by absolute file path
+            quint32 m_parserVersion = 1;     //!< version of the parser
+        };
+    } // namespace
+} // namespace
+
+#endif // guard
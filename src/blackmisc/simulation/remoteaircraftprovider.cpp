@@ -73,10 +73,16 @@ namespace BlackMisc
 
         CAircraftSituationList CRemoteAircraftProvider::remoteAircraftSituations(const CCallsign &callsign) const
         {
-            static const CAircraftSituationList empty;
-            QReadLocker l(&m_lockSituations);
-            if (!m_situationsByCallsign.contains(callsign)) { return empty; }
-            return m_situationsByCallsign[callsign];
+            const CSituationHistoryPtr history = this->situationHistory(callsign);
+            if (!history) { return {}; }
+            return history->situations(); // implicitly shared, no deep copy
+        }
+
+        QVector<CCompactSituation> CRemoteAircraftProvider::remoteAircraftCompactSituations(const CCallsign &callsign) const
+        {
+            const CSituationHistoryPtr history = this->situationHistory(callsign);
+            if (!history) { return {}; }
+            return history->compactSituations(); // implicitly shared, no deep copy
         }
 
         CAircraftSituation CRemoteAircraftProvider::remoteAircraftSituation(const CCallsign &callsign, int index) const
@@ -94,25 +100,35 @@ namespace BlackMisc
 
         CAircraftSituationList CRemoteAircraftProvider::latestRemoteAircraftSituations() const
         {
-            QReadLocker l(&m_lockSituations);
-            const QList<CAircraftSituation> situations(m_latestSituationByCallsign.values());
-            l.unlock();
-            return CAircraftSituationList(situations);
+            const auto histories = m_situationsByCallsign.read();
+            CAircraftSituationList situations;
+            for (const CSituationHistoryPtr &history : histories.get())
+            {
+                const auto data = history->read();
+                if (data->lastModified < 0) { continue; } // nothing stored yet
+                situations.push_back(data->latest);
+            }
+            return situations;
         }
 
         CAircraftSituationList CRemoteAircraftProvider::latestOnGroundProviderElevations() const
         {
-            QReadLocker l(&m_lockSituations);
-            const QList<CAircraftSituation> situations(m_latestOnGroundProviderElevation.values());
-            l.unlock();
-            return CAircraftSituationList(situations);
+            const auto histories = m_situationsByCallsign.read();
+            CAircraftSituationList situations;
+            for (const CSituationHistoryPtr &history : histories.get())
+            {
+                const auto data = history->read();
+                if (data->latestOnGroundProviderElevation.getCallsign().isEmpty()) { continue; }
+                situations.push_back(data->latestOnGroundProviderElevation);
+            }
+            return situations;
         }
 
         int CRemoteAircraftProvider::remoteAircraftSituationsCount(const CCallsign &callsign) const
         {
-            QReadLocker l(&m_lockSituations);
-            if (!m_situationsByCallsign.contains(callsign)) { return -1; }
-            return m_situationsByCallsign[callsign].size();
+            const CSituationHistoryPtr history = this->situationHistory(callsign);
+            if (!history) { return -1; }
+            return history->size();
         }
 
         CAircraftPartsList CRemoteAircraftProvider::remoteAircraftParts(const CCallsign &callsign) const
@@ -178,13 +194,10 @@ namespace BlackMisc
                 m_partsAdded = 0;
                 m_partsLastModified.clear();
             }
+            m_situationsByCallsign.sharedWrite([](CSituationHistoryPerCallsign &histories) { histories.clear(); });
+            m_situationsAdded = 0;
             {
                 QWriteLocker l(&m_lockSituations);
-                m_situationsByCallsign.clear();
-                m_latestSituationByCallsign.clear();
-                m_latestOnGroundProviderElevation.clear();
-                m_situationsAdded = 0;
-                m_situationsLastModified.clear();
                 m_testOffset.clear();
             }
             {
@@ -279,40 +292,43 @@ namespace BlackMisc
             }
 
             // list from new to old
+            // only writers of the same callsign are serialized, readers get the published snapshot without locking
+            const CSituationHistoryPtr history = this->situationHistoryOrCreate(cs);
+            m_situationsAdded++;
             CAircraftSituationList updatedSituations; // copy of updated situations
+            history->write([&](CSituationHistory::Data &data)
             {
                 const qint64 now = QDateTime::currentMSecsSinceEpoch();
-                QWriteLocker lock(&m_lockSituations);
-                m_situationsAdded++;
-                m_situationsLastModified[cs] = now;
-                CAircraftSituationList &newSituationsList = m_situationsByCallsign[cs];
+                data.lastModified = now;
+                CAircraftSituationList &newSituationsList = data.situations;
                 newSituationsList.setAdjustedSortHint(CAircraftSituationList::AdjustedTimestampLatestFirst);
                 const int situations = newSituationsList.size();
                 if (situations < 1)
                 {
-                    newSituationsList.prefillLatestAdjustedFirst(situationCorrected, IRemoteAircraftProvider::MaxSituationsPerCallsign);
+                    newSituationsList.prefillLatestAdjustedFirst(situationCorrected, history->capacity());
                 }
                 else
                 {
                     // newSituationsList.push_frontKeepLatestFirstIgnoreOverlapping(situationCorrected, true, IRemoteAircraftProvider::MaxSituationsPerCallsign);
-                    newSituationsList.push_frontKeepLatestFirstAdjustOffset(situationCorrected, true, IRemoteAircraftProvider::MaxSituationsPerCallsign);
+                    newSituationsList.push_frontKeepLatestFirstAdjustOffset(situationCorrected, true, history->capacity());
                     newSituationsList.setAdjustedSortHint(CAircraftSituationList::AdjustedTimestampLatestFirst);
-                    newSituationsList.transferElevationForward(); // transfer elevations, will do nothing if elevations already exist
+                    data.markModified(0); // could replace the latest situation with the same timestamp
+                    if (newSituationsList.transferElevationForward() > 0) { data.markAllModified(); } // transfer elevations, will do nothing if elevations already exist
 
                     // unify all inbound ground information
                     if (situation.hasInboundGroundDetails())
                     {
-                        newSituationsList.setOnGroundDetails(situation.getOnGroundDetails());
+                        if (newSituationsList.setOnGroundDetails(situation.getOnGroundDetails()) > 0) { data.markAllModified(); }
                     }
                 }
-                m_latestSituationByCallsign[cs] = situationCorrected;
+                data.latest = situationCorrected;
 
                 // check sort order
                 if (CBuildConfig::isLocalDeveloperDebugBuild())
                 {
                     BLACK_VERIFY_X(newSituationsList.isSortedAdjustedLatestFirstWithoutNullPositions(), Q_FUNC_INFO, "wrong adjusted sort order");
                     BLACK_VERIFY_X(newSituationsList.isSortedLatestFirst(), Q_FUNC_INFO, "wrong sort order");
-                    BLACK_VERIFY_X(newSituationsList.size() <= IRemoteAircraftProvider::MaxSituationsPerCallsign, Q_FUNC_INFO, "Wrong size");
+                    BLACK_VERIFY_X(newSituationsList.size() <= history->capacity(), Q_FUNC_INFO, "Wrong size");
                 }
 
                 if (!situation.hasInboundGroundDetails())
@@ -323,9 +339,8 @@ namespace BlackMisc
                     // guess GND
                     newSituationsList.front().guessOnGround(simpleChange, aircraftModel);
                 }
-                updatedSituations = m_situationsByCallsign[cs];
-
-            } // lock
+                updatedSituations = newSituationsList;
+            }); // published
 
             // calculate change AFTER gnd. was guessed
             Q_ASSERT_X(!updatedSituations.isEmpty(), Q_FUNC_INFO, "Missing situations");
@@ -337,9 +352,11 @@ namespace BlackMisc
                 const CLength offset = change.getGuessedSceneryDeviation();
                 situationCorrected.setSceneryOffset(offset);
 
-                QWriteLocker lock(&m_lockSituations);
-                m_latestSituationByCallsign[cs].setSceneryOffset(offset);
-                m_situationsByCallsign[cs].front().setSceneryOffset(offset);
+                history->write([&](CSituationHistory::Data &data)
+                {
+                    data.latest.setSceneryOffset(offset);
+                    if (!data.situations.isEmpty()) { data.situations.front().setSceneryOffset(offset); data.markModified(0); }
+                });
             }
 
             // situation has been added
@@ -375,12 +392,14 @@ namespace BlackMisc
             } // lock
 
             // adjust gnd.flag from parts
-            if (!correctiveParts.isEmpty())
+            const CSituationHistoryPtr history = correctiveParts.isEmpty() ? nullptr : this->situationHistory(callsign);
+            if (history)
             {
-                QWriteLocker lock(&m_lockSituations);
-                CAircraftSituationList &situationList = m_situationsByCallsign[callsign];
-                const int c = situationList.adjustGroundFlag(parts);
-                if (c > 0) { m_situationsLastModified[callsign] = ts; }
+                history->write([&](CSituationHistory::Data &data)
+                {
+                    const int c = data.situations.adjustGroundFlag(parts);
+                    if (c > 0) { data.lastModified = ts; data.markAllModified(); }
+                });
             }
 
             // update aircraft
@@ -585,20 +604,24 @@ namespace BlackMisc
             CAircraftSituationChange change;
             bool setForOnGndPosition = false;
 
-            int updated = 0;
+            const CSituationHistoryPtr history = this->situationHistory(callsign);
+            if (!history) { return 0; }
+            const int updated = history->write([&](CSituationHistory::Data &data)
             {
-                QWriteLocker l(&m_lockSituations);
-                CAircraftSituationList &situations = m_situationsByCallsign[callsign];
+                CAircraftSituationList &situations = data.situations;
                 if (situations.isEmpty()) { return 0; }
-                updated = situations.setGroundElevationCheckedAndGuessGround(elevation, info, model, &change, &setForOnGndPosition);
-                if (updated < 1) { return 0; }
-                m_situationsLastModified[callsign] = now;
-                const CAircraftSituation latestSituation = situations.front();
+                const int c = situations.setGroundElevationCheckedAndGuessGround(elevation, info, model, &change, &setForOnGndPosition);
+                if (c < 1) { return 0; }
+                data.lastModified = now;
+                data.markAllModified();
+                const CAircraftSituation &latestSituation = situations.front();
                 if (info == CAircraftSituation::FromProvider && latestSituation.isOnGround())
                 {
-                    m_latestOnGroundProviderElevation[callsign] = latestSituation;
+                    data.latestOnGroundProviderElevation = latestSituation;
                 }
-            }
+                return c;
+            });
+            if (updated < 1) { return 0; }
 
             // update change
             if (!change.isNull())
@@ -792,14 +815,13 @@ namespace BlackMisc
 
         int CRemoteAircraftProvider::aircraftSituationsAdded() const
         {
-            QReadLocker l(&m_lockSituations);
             return m_situationsAdded;
         }
 
         qint64 CRemoteAircraftProvider::situationsLastModified(const CCallsign &callsign) const
         {
-            QReadLocker l(&m_lockSituations);
-            return m_situationsLastModified.value(callsign, -1);
+            const CSituationHistoryPtr history = this->situationHistory(callsign);
+            return history ? history->lastModified() : -1;
         }
 
         qint64 CRemoteAircraftProvider::partsLastModified(const CCallsign &callsign) const
@@ -878,13 +900,7 @@ namespace BlackMisc
                 m_aircraftWithParts.remove(callsign);
                 m_partsLastModified.remove(callsign);
             }
-            {
-                QWriteLocker l2(&m_lockSituations);
-                m_situationsByCallsign.remove(callsign);
-                m_latestSituationByCallsign.remove(callsign);
-                m_latestOnGroundProviderElevation.remove(callsign);
-                m_situationsLastModified.remove(callsign);
-            }
+            m_situationsByCallsign.sharedWrite([&](CSituationHistoryPerCallsign &histories) { histories.remove(callsign); });
             { QWriteLocker l4(&m_lockPartsHistory); m_aircraftPartsMessages.remove(callsign); }
             bool removedCallsign = false;
             {
@@ -896,6 +912,27 @@ namespace BlackMisc
             return removedCallsign;
         }
 
+        CSituationHistoryPtr CRemoteAircraftProvider::situationHistory(const CCallsign &callsign) const
+        {
+            const auto histories = m_situationsByCallsign.read();
+            return histories->value(callsign);
+        }
+
+        CSituationHistoryPtr CRemoteAircraftProvider::situationHistoryOrCreate(const CCallsign &callsign)
+        {
+            CSituationHistoryPtr history = this->situationHistory(callsign);
+            if (history) { return history; }
+
+            // rare case, only when a new callsign is added the index is copied
+            const int capacity = IRemoteAircraftProvider::MaxSituationsPerCallsign;
+            const CSituationHistoryPtr newHistory = std::make_shared<CSituationHistory>(capacity);
+            m_situationsByCallsign.sharedWrite([&](CSituationHistoryPerCallsign &histories)
+            {
+                if (!histories.contains(callsign)) { histories.insert(callsign, newHistory); }
+            });
+            return this->situationHistory(callsign);
+        }
+
         CRemoteAircraftAware::~CRemoteAircraftAware()
         { }
 
@@ -953,6 +990,12 @@ namespace BlackMisc
             return this->provider()->remoteAircraftSituations(callsign);
         }
 
+        QVector<CCompactSituation> CRemoteAircraftAware::remoteAircraftCompactSituations(const CCallsign &callsign) const
+        {
+            Q_ASSERT_X(this->provider(), Q_FUNC_INFO, "No object available");
+            return this->provider()->remoteAircraftCompactSituations(callsign);
+        }
+
         CAircraftSituation CRemoteAircraftAware::remoteAircraftSituation(const CCallsign &callsign, int index) const
         {
             Q_ASSERT_X(this->provider(), Q_FUNC_INFO, "No object available");
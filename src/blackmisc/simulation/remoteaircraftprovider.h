@@ -14,23 +14,27 @@
 #include "blackmisc/simulation/aircraftmodel.h"
 #include "blackmisc/simulation/airspaceaircraftsnapshot.h"
 #include "blackmisc/simulation/reverselookup.h"
+#include "blackmisc/simulation/situationhistory.h"
 #include "blackmisc/simulation/simulatedaircraftlist.h"
 #include "blackmisc/aviation/aircraftpartslist.h"
 #include "blackmisc/aviation/aircraftsituationlist.h"
 #include "blackmisc/aviation/aircraftsituationchangelist.h"
 #include "blackmisc/aviation/percallsign.h"
 #include "blackmisc/aviation/callsignset.h"
+#include "blackmisc/aviation/compactsituation.h"
 #include "blackmisc/provider.h"
 #include "blackmisc/blackmiscexport.h"
 #include "blackmisc/identifiable.h"
 
 #include <QHash>
 #include <QList>
+#include <QVector>
 #include <QMetaObject>
 #include <QObject>
 #include <QJsonObject>
 #include <QtGlobal>
 #include <QReadWriteLock>
+#include <atomic>
 #include <functional>
 
 namespace BlackMisc
@@ -94,6 +98,11 @@ namespace BlackMisc
             //! \threadsafe
             virtual Aviation::CAircraftSituationList remoteAircraftSituations(const Aviation::CCallsign &callsign) const = 0;
 
+            //! Rendered aircraft situations as compact records (per callsign, time history)
+            //! \remark same order as IRemoteAircraftProvider::remoteAircraftSituations, latest first
+            //! \threadsafe
+            virtual QVector<Aviation::CCompactSituation> remoteAircraftCompactSituations(const Aviation::CCallsign &callsign) const = 0;
+
             //! Average update time
             //! \threadsafe
             virtual MillisecondsMinMaxMean remoteAircraftSituationsTimestampDifferenceMinMaxMean(const Aviation::CCallsign &callsign) const = 0;
@@ -314,6 +323,7 @@ namespace BlackMisc
             virtual bool isAircraftInRange(const Aviation::CCallsign &callsign) const override;
             virtual bool isVtolAircraft(const Aviation::CCallsign &callsign) const override;
             virtual Aviation::CAircraftSituationList remoteAircraftSituations(const Aviation::CCallsign &callsign) const override;
+            virtual QVector<Aviation::CCompactSituation> remoteAircraftCompactSituations(const Aviation::CCallsign &callsign) const override;
             virtual Aviation::CAircraftSituation remoteAircraftSituation(const Aviation::CCallsign &callsign, int index) const override;
             virtual MillisecondsMinMaxMean remoteAircraftSituationsTimestampDifferenceMinMaxMean(const Aviation::CCallsign &callsign) const override;
             virtual Aviation::CAircraftSituationList latestRemoteAircraftSituations() const override;
@@ -479,20 +489,25 @@ namespace BlackMisc
             //! \threadsafe
             void storeChange(const Aviation::CAircraftSituationChange &change);
 
-            Aviation::CAircraftSituationListPerCallsign m_situationsByCallsign;        //!< situations, for performance reasons per callsign, thread safe access required
-            Aviation::CAircraftSituationPerCallsign m_latestSituationByCallsign;       //!< latest situations, for performance reasons per callsign, thread safe access required
-            Aviation::CAircraftSituationPerCallsign m_latestOnGroundProviderElevation; //!< situations on ground with elevation from provider
+            //! Situation history of callsign, nullptr if not existing
+            //! \threadsafe lock free
+            CSituationHistoryPtr situationHistory(const Aviation::CCallsign &callsign) const;
+
+            //! Situation history of callsign, created if not existing
+            //! \threadsafe
+            CSituationHistoryPtr situationHistoryOrCreate(const Aviation::CCallsign &callsign);
+
+            LockFree<CSituationHistoryPerCallsign> m_situationsByCallsign;            //!< situations, latest and last modified per callsign, lock free
             Aviation::CAircraftPartsListPerCallsign m_partsByCallsign;                 //!< parts, for performance reasons per callsign, thread safe access required
             Aviation::CAircraftSituationChangeListPerCallsign m_changesByCallsign;     //!< changes, for performance reasons per callsign, thread safe access required (same timestamps as corresponding situations)
             Aviation::CCallsignSet m_aircraftWithParts;                                //!< aircraft supporting parts, thread safe access required
-            int m_situationsAdded = 0; //!< total number of situations added, thread safe access required
+            std::atomic_int m_situationsAdded { 0 }; //!< total number of situations added
             int m_partsAdded      = 0; //!< total number of parts added, thread safe access required
 
             ReverseLookupLogging m_enableReverseLookupMsgs = RevLogSimplifiedInfo;     //!< shall we log. information about the matching process
             Simulation::CSimulatedAircraftPerCallsign m_aircraftInRange;      //!< aircraft, thread safe access required
             Aviation::CStatusMessageListPerCallsign m_reverseLookupMessages;  //!< reverse lookup messages
             Aviation::CStatusMessageListPerCallsign m_aircraftPartsMessages;  //!< status messages for parts history
-            Aviation::CTimestampPerCallsign m_situationsLastModified;         //!< when situations last modified
             Aviation::CTimestampPerCallsign m_partsLastModified;              //!< when parts last modified
             Aviation::CLengthPerCallsign    m_testOffset;                     //!< offsets
             Aviation::CLengthPerCallsign    m_dbCGPerCallsign;                //!< DB CG per callsign
@@ -501,7 +516,7 @@ namespace BlackMisc
             bool m_enableAircraftPartsHistory = true;  //!< shall we keep a history of aircraft parts
 
             // locks
-            mutable QReadWriteLock m_lockSituations;   //!< lock for situations: m_situationsByCallsign
+            mutable QReadWriteLock m_lockSituations;   //!< lock for situation test offsets: m_testOffset
             mutable QReadWriteLock m_lockParts;        //!< lock for parts: m_partsByCallsign, m_aircraftSupportingParts
             mutable QReadWriteLock m_lockChanges;      //!< lock for changes: m_changesByCallsign
             mutable QReadWriteLock m_lockAircraft;     //!< lock aircraft: m_aircraftInRange, m_dbCGPerCallsign
@@ -543,6 +558,9 @@ namespace BlackMisc
             //! \copydoc IRemoteAircraftProvider::remoteAircraftSituations
             Aviation::CAircraftSituationList remoteAircraftSituations(const Aviation::CCallsign &callsign) const;
 
+            //! \copydoc IRemoteAircraftProvider::remoteAircraftCompactSituations
+            QVector<Aviation::CCompactSituation> remoteAircraftCompactSituations(const Aviation::CCallsign &callsign) const;
+
             //! \copydoc IRemoteAircraftProvider::remoteAircraftSituation
             Aviation::CAircraftSituation remoteAircraftSituation(const Aviation::CCallsign &callsign, int index) const;
 
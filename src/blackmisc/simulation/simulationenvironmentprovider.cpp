@@ -9,10 +9,13 @@
 #include "simulationenvironmentprovider.h"
 #include "blackmisc/aviation/aircraftsituationchange.h"
 
+#include "blackmisc/fileutils.h"
 #include "blackmisc/logmessage.h"
+#include "blackmisc/swiftdirectories.h"
 #include "blackmisc/verify.h"
 #include "blackconfig/buildconfig.h"
 
+#include <QFile>
 #include <QStringBuilder>
 
 using namespace BlackConfig;
@@ -37,64 +40,53 @@ namespace BlackMisc
             const CLength minRange = ISimulationEnvironmentProvider::minRange(epsilon);
             const double elvFt = elevationCoordinate.geodeticHeight().value(CLengthUnit::ft());
 
-            CCoordinateGeodetic alreadyInRange;
-            CCoordinateGeodetic alreadyInRangeGnd;
+            CElevationTileCache::Elevation alreadyInRange;
             {
-                QReadLocker l(&m_lockElvCoordinates);
+                QWriteLocker l(&m_lockElvCoordinates);
                 if (!m_enableElevation) { return false; }
 
-                // check if we have already an elevation within range
-                alreadyInRangeGnd = m_elvCoordinatesGnd.findFirstWithinRangeOrDefault(elevationCoordinate, minRange);
-                alreadyInRange    = m_elvCoordinates.findFirstWithinRangeOrDefault(elevationCoordinate, minRange);
+                // check if we have already an elevation within range, gnd. values first
+                alreadyInRange = m_elvCache.findFirstWithinRange(elevationCoordinate, minRange, true);
+                if (alreadyInRange.isNull()) { alreadyInRange = m_elvCache.findFirstWithinRange(elevationCoordinate, minRange); }
             }
 
             constexpr double maxDistFt = 30.0;
-
-            // here we deal with gnd situation and do not expect a lot of variance
-            if (!alreadyInRangeGnd.isNull())
+            if (!alreadyInRange.isNull())
             {
                 // found
-                const double distFt = qAbs(alreadyInRangeGnd.geodeticHeight().value(CLengthUnit::ft()) - elvFt);
-                if (distFt > maxDistFt)
+                const double distFt = qAbs(alreadyInRange.coordinate.geodeticHeight().value(CLengthUnit::ft()) - elvFt);
+                if (distFt <= maxDistFt) { return false; }
+
+                if (alreadyInRange.fromFile)
                 {
+                    // from a previous session, scenery might have changed, the simulator value wins
+                    QWriteLocker l(&m_lockElvCoordinates);
+                    m_elvCache.removeInsideRange(elevationCoordinate, minRange);
+                }
+                else if (alreadyInRange.onGround)
+                {
+                    // here we deal with gnd situation and do not expect a lot of variance
                     // such a huge distance to existing value
                     CLogMessage(this).debug(u"Suspicious GND elevation distance '%1': %2ft at %3") << requestedForCallsign.asString() << distFt << elevationCoordinate.geodeticHeight().valueRoundedAsString(CLengthUnit::ft(), 1);
                     BLACK_AUDIT_X(!CBuildConfig::isLocalDeveloperDebugBuild(), Q_FUNC_INFO, "Suspicious gnd. elevation distance");
+                    return false;
                 }
-                return false;
-            }
-
-            // here we deal with all kind of values, so it can be that
-            // values vary in a much larger range
-            if (!alreadyInRange.isNull())
-            {
-                // found
-                const double distFt = qAbs(alreadyInRange.geodeticHeight().value(CLengthUnit::ft()) - elvFt);
-                if (distFt > maxDistFt)
+                else
                 {
-                    // such a huge distance to existing value
+                    // here we deal with all kind of values, so it can be that
+                    // values vary in a much larger range
                     CLogMessage(this).debug(u"Suspicious NON GND elevation distance for '%1': %2ft at %3") << requestedForCallsign.asString() << distFt << elevationCoordinate.geodeticHeight().valueRoundedAsString(CLengthUnit::ft(), 1);
-                    // BLACK_AUDIT_X(!CBuildConfig::isLocalDeveloperDebugBuild(), Q_FUNC_INFO, "Suspicious elevation distance");
+                    return false;
                 }
-                return false;
             }
 
             const qint64 now = QDateTime::currentMSecsSinceEpoch();
             {
-                // we keep latest at front
+                // we keep latest at front of the tile
                 // * we assume we find them faster
                 // * and need them more frequently (the recent ones)
                 QWriteLocker l(&m_lockElvCoordinates);
-                if (likelyOnGroundElevation)
-                {
-                    if (m_elvCoordinatesGnd.size() > m_maxElevationsGnd) { m_elvCoordinatesGnd.pop_back(); }
-                    m_elvCoordinatesGnd.push_front(elevationCoordinate);
-                }
-                else
-                {
-                    if (m_elvCoordinates.size() > m_maxElevations) { m_elvCoordinates.pop_back(); }
-                    m_elvCoordinates.push_front(elevationCoordinate);
-                }
+                m_elvCache.insert(elevationCoordinate, likelyOnGroundElevation);
 
                 // statistics
                 if (m_pendingElevationRequests.contains(requestedForCallsign))
@@ -273,20 +265,22 @@ namespace BlackMisc
         CCoordinateGeodeticList ISimulationEnvironmentProvider::getAllElevationCoordinates() const
         {
             QReadLocker l(&m_lockElvCoordinates);
-            CCoordinateGeodeticList cl(m_elvCoordinatesGnd);
-            cl.push_back(m_elvCoordinates);
-            return cl;
+            return m_elvCache.getElevations();
         }
 
         CCoordinateGeodeticList ISimulationEnvironmentProvider::getElevationCoordinatesOnGround() const
         {
             QReadLocker l(&m_lockElvCoordinates);
-            return m_elvCoordinatesGnd;
+            return m_elvCache.getElevations(true);
         }
 
         CElevationPlane ISimulationEnvironmentProvider::averageElevationOfOnGroundAircraft(const CAircraftSituation &reference, const CLength &range, int minValues, int sufficientValues) const
         {
-            const CCoordinateGeodeticList coordinates = this->getElevationCoordinatesOnGround();
+            CCoordinateGeodeticList coordinates;
+            {
+                QReadLocker l(&m_lockElvCoordinates);
+                coordinates = m_elvCache.findWithinRange(reference, range, true);
+            }
             return coordinates.averageGeodeticHeight(reference, range, CAircraftSituationChange::allowedAltitudeDeviation(), minValues, sufficientValues);
         }
 
@@ -300,27 +294,15 @@ namespace BlackMisc
         CCoordinateGeodeticList ISimulationEnvironmentProvider::getAllElevationCoordinates(int &maxRemembered) const
         {
             QReadLocker l(&m_lockElvCoordinates);
-            maxRemembered = m_maxElevations;
-            CCoordinateGeodeticList cl(m_elvCoordinatesGnd);
-            cl.push_back(m_elvCoordinates);
-            return cl;
+            maxRemembered = m_elvCache.getMaxElevations();
+            return m_elvCache.getElevations();
         }
 
         int ISimulationEnvironmentProvider::cleanUpElevations(const ICoordinateGeodetic &referenceCoordinate, int maxNumber)
         {
-            int currentMax;
-            CCoordinateGeodeticList coordinates(this->getAllElevationCoordinates(currentMax));
-            if (maxNumber < 0) { maxNumber = currentMax; }
-            const int size = coordinates.size();
-            if (size <= maxNumber) { return 0; }
-            coordinates.sortByEuclideanDistanceSquared(referenceCoordinate);
-            coordinates.truncate(maxNumber);
-            const int delta = size - coordinates.size();
-            {
-                QWriteLocker l(&m_lockElvCoordinates);
-                m_elvCoordinates = coordinates;
-            }
-            return delta;
+            QWriteLocker l(&m_lockElvCoordinates);
+            if (maxNumber < 0) { maxNumber = m_elvCache.getMaxElevations(); }
+            return m_elvCache.keepClosest(referenceCoordinate, maxNumber);
         }
 
         CElevationPlane ISimulationEnvironmentProvider::findClosestElevationWithinRange(const ICoordinateGeodetic &reference, const CLength &range) const
@@ -329,15 +311,14 @@ namespace BlackMisc
 
             // for single point we use a slightly optimized version
             const bool singlePoint = (&range == &CElevationPlane::singlePointRadius() || range.isNull() || range <= CElevationPlane::singlePointRadius());
-            const CCoordinateGeodeticList elevations = this->getAllElevationCoordinates();
-            const CCoordinateGeodetic coordinate = singlePoint ?
-                                                   elevations.findFirstWithinRangeOrDefault(reference, CElevationPlane::singlePointRadius()) :
-                                                   elevations.findClosestWithinRange(reference, range);
-            const bool found = !coordinate.isNull();
 
             {
+                // only the tiles around the reference are checked
                 QWriteLocker l{&m_lockElvCoordinates };
-                if (found)
+                const CCoordinateGeodetic coordinate = singlePoint ?
+                                                       m_elvCache.findFirstWithinRange(reference, CElevationPlane::singlePointRadius()).coordinate :
+                                                       m_elvCache.findClosestWithinRange(reference, range).coordinate;
+                if (!coordinate.isNull())
                 {
                     m_elvFound++;
                     return CElevationPlane(coordinate, reference); // plane with radius = distance to reference
@@ -388,8 +369,8 @@ namespace BlackMisc
             int elv;
             {
                 QReadLocker l(&m_lockElvCoordinates);
-                elvGnd = m_elvCoordinatesGnd.sizeInt();
-                elv    = m_elvCoordinates.sizeInt();
+                elvGnd = m_elvCache.sizeOnGround();
+                elv    = m_elvCache.size() - elvGnd;
             }
             return info.arg(f).arg(m).arg(QString::number(hitRatioPercent, 'f', 1)).arg(elv).arg(elvGnd);
         }
@@ -532,15 +513,17 @@ namespace BlackMisc
 
         int ISimulationEnvironmentProvider::setMaxElevationsRemembered(int max)
         {
+            // never below the default, the elevations of a previous session (read from file) are kept
+            const int maxElevations = qMax(max, CElevationTileCache::DefaultMaxElevations);
             QWriteLocker l(&m_lockElvCoordinates);
-            m_maxElevations = qMax(max, 50);
-            return m_maxElevations;
+            if (maxElevations != m_elvCache.getMaxElevations()) { m_elvCache.setMaxElevations(maxElevations); }
+            return m_elvCache.getMaxElevations();
         }
 
         int ISimulationEnvironmentProvider::getMaxElevationsRemembered() const
         {
             QReadLocker l(&m_lockElvCoordinates);
-            return m_maxElevations;
+            return m_elvCache.getMaxElevations();
         }
 
         void ISimulationEnvironmentProvider::resetSimulationEnvironmentStatistics()
@@ -554,7 +537,7 @@ namespace BlackMisc
         int ISimulationEnvironmentProvider::removeElevationValues(const CAircraftSituation &reference, const CLength &removeRange)
         {
             QWriteLocker l(&m_lockElvCoordinates);
-            const int r = m_elvCoordinatesGnd.removeInsideRange(reference, removeRange);
+            const int r = m_elvCache.removeInsideRange(reference, removeRange, true);
             return r;
         }
 
@@ -563,44 +546,11 @@ namespace BlackMisc
             if (reference.isNull() || keptRange.isNull()) { return false; }
             const CLength r = minRange(keptRange);
 
-            CCoordinateGeodeticList cleanedKeptElvs;
-            bool maxReached = false;
-            bool cleaned    = false;
-
-            {
-                QReadLocker l(&m_lockElvCoordinates);
-                cleanedKeptElvs = m_elvCoordinates;
-                maxReached = m_elvCoordinates.size() >= m_maxElevations;
-            }
-            if (!cleanedKeptElvs.isEmpty() && (forced || maxReached))
-            {
-                const int removed = cleanedKeptElvs.removeOutsideRange(reference, r);
-                if (removed > 0)
-                {
-                    cleaned = true;
-                    QWriteLocker l(&m_lockElvCoordinates);
-                    m_elvCoordinates = cleanedKeptElvs;
-                }
-            }
-
-            cleanedKeptElvs.clear();
-            {
-                QReadLocker l(&m_lockElvCoordinates);
-                cleanedKeptElvs = m_elvCoordinatesGnd;
-                maxReached = m_elvCoordinatesGnd.size() >= m_maxElevationsGnd;
-            }
-            if (!cleanedKeptElvs.isEmpty() && (forced || maxReached))
-            {
-                const int removed = cleanedKeptElvs.removeOutsideRange(reference, r);
-                if (removed > 0)
-                {
-                    cleaned = true;
-                    QWriteLocker l(&m_lockElvCoordinates);
-                    m_elvCoordinatesGnd = cleanedKeptElvs;
-                }
-            }
-
-            return cleaned;
+            // the least recently used tiles are removed anyway, so unless forced only if max.values are reached
+            QWriteLocker l(&m_lockElvCoordinates);
+            const bool maxReached = m_elvCache.size() >= m_elvCache.getMaxElevations();
+            if (m_elvCache.isEmpty() || !(forced || maxReached)) { return false; }
+            return m_elvCache.removeOutsideRange(reference, r) > 0;
         }
 
         ISimulationEnvironmentProvider::ISimulationEnvironmentProvider(const CSimulatorPluginInfo &pluginInfo) :
@@ -695,14 +645,48 @@ namespace BlackMisc
         void ISimulationEnvironmentProvider::clearElevations()
         {
             QWriteLocker l(&m_lockElvCoordinates);
-            m_elvCoordinates.clear();
-            m_elvCoordinatesGnd.clear();
+            m_elvCache.clear();
             m_pendingElevationRequests.clear();
             m_statsCurrentElevRequestTimeMs = -1;
             m_statsMaxElevRequestTimeMs     = -1;
             m_elvFound = m_elvMissed        =  0;
         }
 
+        bool ISimulationEnvironmentProvider::loadElevations()
+        {
+            const QString fn = this->getElevationsFilePath();
+            if (fn.isEmpty() || !QFile::exists(fn)) { return false; }
+
+            QWriteLocker l(&m_lockElvCoordinates);
+            if (!m_enableElevation) { return false; }
+            const int before = m_elvCache.size();
+            if (!m_elvCache.readFromFile(fn))
+            {
+                CLogMessage(this).warning(u"Cannot read elevations from '%1'") << fn;
+                return false;
+            }
+            CLogMessage(this).info(u"Loaded %1 elevations from '%2'") << (m_elvCache.size() - before) << fn;
+            return true;
+        }
+
+        bool ISimulationEnvironmentProvider::saveElevations() const
+        {
+            const QString fn = this->getElevationsFilePath();
+            if (fn.isEmpty()) { return false; }
+
+            QReadLocker l(&m_lockElvCoordinates);
+            if (m_elvCache.isEmpty()) { return false; }
+            return m_elvCache.writeToFile(fn);
+        }
+
+        QString ISimulationEnvironmentProvider::getElevationsFilePath() const
+        {
+            const QString &id = this->getSimulatorInfo().toPluginIdentifier();
+            if (id.isEmpty()) { return {}; }
+            static const QString dir = CFileUtils::appendFilePaths(CSwiftDirectories::normalizedApplicationDataDirectory(), "elevations");
+            return CFileUtils::appendFilePaths(dir, id % u".elv");
+        }
+
         void ISimulationEnvironmentProvider::clearCGs()
         {
             QWriteLocker l(&m_lockCG);
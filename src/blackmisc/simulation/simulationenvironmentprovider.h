@@ -13,6 +13,7 @@
 
 #include "simulatorplugininfo.h"
 #include "aircraftmodel.h"
+#include "elevationtilecache.h"
 #include "blackmisc/simulation/settings/simulatorsettings.h"
 #include "blackmisc/aviation/aircraftsituation.h"
 #include "blackmisc/aviation/percallsign.h"
@@ -135,6 +136,7 @@ namespace BlackMisc
             bool hasSameSimulatorCG(const PhysicalQuantities::CLength &cg, const Aviation::CCallsign &callsign) const;
 
             //! Set number of elevations kept
+            //! \remark at least CElevationTileCache::DefaultMaxElevations, so it only grows the cache beyond the default
             //! \threadsafe
             int setMaxElevationsRemembered(int max);
 
@@ -216,6 +218,18 @@ namespace BlackMisc
             //! Clear elevations
             void clearElevations();
 
+            //! Add the elevations of the last sessions with this simulator
+            //! \threadsafe
+            bool loadElevations();
+
+            //! Save the elevations for the next sessions with this simulator
+            //! \threadsafe
+            bool saveElevations() const;
+
+            //! File with the elevations of the simulator, empty if there is no single simulator
+            //! \threadsafe
+            QString getElevationsFilePath() const;
+
             //! Clear CGs
             //! \threadsafe
             void clearCGs();
@@ -290,11 +304,8 @@ namespace BlackMisc
             QString m_simulatorVersion;    //!< simulator version
             CAircraftModel m_defaultModel; //!< default model
 
-            // idea: the elevations on gnd are likely taxiways and runways, so we keep those
-            int m_maxElevations    = 100;   //!< How many elevations we keep
-            int m_maxElevationsGnd = 400;   //!< How many elevations we keep for elevations on gnd.
-            Geo::CCoordinateGeodeticList    m_elvCoordinates;    //!< elevation cache
-            Geo::CCoordinateGeodeticList    m_elvCoordinatesGnd; //!< elevation cache for on ground situations
+            // idea: the elevations on gnd are likely taxiways and runways, they are looked up first
+            mutable CElevationTileCache m_elvCache; //!< elevation cache, lookups update the least recently used tiles
 
             Aviation::CTimestampPerCallsign m_pendingElevationRequests; //!< pending elevation requests for aircraft callsign
             Aviation::CLengthPerCallsign    m_cgsPerCallsign;           //!< CGs per callsign
@@ -0,0 +1,50 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/situationhistory.h"
+
+using namespace BlackMisc::Aviation;
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        void CSituationHistory::finishWrite(Data &data, int capacity)
+        {
+            data.situations.truncate(capacity);
+
+            // situations prepended with this write are in front of the previous latest situation
+            const QVector<CCompactSituation> &previous = data.compactSituations;
+            const int count = data.situations.size();
+            int prepended = count;
+            if (!previous.isEmpty())
+            {
+                for (int i = 0; i < count; ++i)
+                {
+                    if (data.situations[i].getMSecsSinceEpoch() == previous.front().getMSecsSinceEpoch()) { prepended = i; break; }
+                }
+            }
+
+            // the others are reused if still at the expected position and not modified in place
+            QVector<CCompactSituation> compact;
+            compact.reserve(count);
+            for (int i = 0; i < count; ++i)
+            {
+                const CAircraftSituation &situation = data.situations[i];
+                const int p = i - prepended;
+                const bool reuse = p >= 0 && p < previous.size() && (i < data.modifiedFrom || i > data.modifiedTo) &&
+                                   previous[p].getMSecsSinceEpoch() == situation.getMSecsSinceEpoch() &&
+                                   previous[p].getTimeOffsetMs() == situation.getTimeOffsetMs();
+                compact.push_back(reuse ? previous[p] : CCompactSituation::fromSituation(situation));
+            }
+            data.compactSituations = compact;
+            data.modifiedFrom = std::numeric_limits<int>::max();
+            data.modifiedTo = -1;
+        }
+    } // namespace
+} // namespace
@@ -0,0 +1,128 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_SITUATIONHISTORY_H
+#define BLACKMISC_SIMULATION_SITUATIONHISTORY_H
+
+#include "blackmisc/aviation/aircraftsituationlist.h"
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/compactsituation.h"
+#include "blackmisc/lockfree.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVector>
+#include <QtGlobal>
+#include <limits>
+#include <memory>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        //! Fixed capacity situation history of one callsign, latest situation first
+        //! \remark Writers are serialized per callsign, so there is one writer at a time,
+        //!         readers never block and get an immutable snapshot
+        class BLACKMISC_EXPORT CSituationHistory
+        {
+        public:
+            //! The published (immutable) state
+            struct Data
+            {
+                Aviation::CAircraftSituationList situations;      //!< history, latest first, at most capacity elements
+                Aviation::CAircraftSituation latest;              //!< latest situation as received
+                Aviation::CAircraftSituation latestOnGroundProviderElevation; //!< latest on ground situation with elevation from provider
+                QVector<Aviation::CCompactSituation> compactSituations; //!< same as situations, compact records
+                qint64 lastModified = -1;                         //!< when modified
+
+                //! Mark a situation modified in place, so its compact record is updated when the write ends
+                //! \remark added and removed situations are detected by their timestamps, they need no mark
+                void markModified(int index) { modifiedFrom = qMin(modifiedFrom, index); modifiedTo = qMax(modifiedTo, index); }
+
+                //! Mark all situations modified in place
+                void markAllModified() { this->markModified(0); this->markModified(situations.size() - 1); }
+
+                int modifiedFrom = std::numeric_limits<int>::max(); //!< first situation modified in place with this write
+                int modifiedTo = -1;                                //!< last situation modified in place with this write
+            };
+
+            //! Constructor
+            explicit CSituationHistory(int capacity) : m_capacity(capacity) {}
+
+            //! Capacity
+            int capacity() const { return m_capacity; }
+
+            //! Snapshot of the current state
+            //! \remark cheap, no deep copy
+            //! \threadsafe lock free
+            LockFreeReader<const Data> read() const { return m_data.read(); }
+
+            //! Situations, latest first
+            //! \remark implicitly shared copy of the snapshot
+            //! \threadsafe lock free
+            Aviation::CAircraftSituationList situations() const { return this->read()->situations; }
+
+            //! Situations as compact records, latest first
+            //! \threadsafe lock free
+            QVector<Aviation::CCompactSituation> compactSituations() const { return this->read()->compactSituations; }
+
+            //! Number of situations
+            //! \threadsafe lock free
+            int size() const { return this->read()->situations.size(); }
+
+            //! Last modified timestamp
+            //! \threadsafe lock free
+            qint64 lastModified() const { return this->read()->lastModified; }
+
+            //! Modify the history and publish the result
+            //! \remark the mutator is called exactly once, serialized with all other writers of this callsign
+            //! \remark Data::situations is trimmed to the capacity and Data::compactSituations is updated from it before publishing,
+            //!         only compact records of added and marked situations are converted, see Data::markModified
+            //! \threadsafe
+            template <typename F>
+            auto write(F &&mutator)
+            {
+                QMutexLocker l(&m_writeMutex);
+                auto writer = m_data.uniqueWrite();
+                const WriteFinisher finisher { writer.get(), m_capacity }; // destroyed before the writer publishes
+                return std::forward<F>(mutator)(writer.get());
+            }
+
+        private:
+            //! Trims to the capacity and updates the compact situations when a write ends
+            struct WriteFinisher
+            {
+                Data &data;         //!< written data
+                const int capacity; //!< max. situations
+
+                //! Dtor
+                ~WriteFinisher() { finishWrite(data, capacity); }
+            };
+
+            //! Trim to the capacity and update the compact situations
+            static void finishWrite(Data &data, int capacity);
+
+            const int m_capacity = 0;
+            QMutex m_writeMutex;       //!< serializes writers
+            LockFree<Data> m_data;     //!< published state
+        };
+
+        //! Shared pointer of history
+        using CSituationHistoryPtr = std::shared_ptr<CSituationHistory>;
+
+        //! Histories per callsign
+        using CSituationHistoryPerCallsign = QHash<Aviation::CCallsign, CSituationHistoryPtr>;
+    } // namespace
+} // namespace
+
+#endif // guard
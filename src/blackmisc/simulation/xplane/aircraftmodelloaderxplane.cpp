@@ -21,11 +21,14 @@
 #include "blackmisc/directoryutils.h"
 #include "blackmisc/statusmessage.h"
 #include "blackmisc/logmessage.h"
+#include "blackmisc/parallel.h"
 #include "blackmisc/verify.h"
 #include "blackconfig/buildconfig.h"
 
 #include <string.h>
+#include <QByteArray>
 #include <QChar>
+#include <QDataStream>
 #include <QDateTime>
 #include <QDir>
 #include <QDirIterator>
@@ -65,6 +68,56 @@ namespace BlackMisc
                 }
             }
 
+            namespace
+            {
+                //! Version of the .acf properties in the manifest, to be increased with any change of the parsing
+                constexpr quint32 ManifestParserVersion = 1;
+
+                //! Version of the stream with the .acf properties
+                constexpr int StreamVersion = QDataStream::Qt_5_6;
+
+                //! Properties of an .acf file
+                struct AcfFile
+                {
+                    QString aircraftIcaoCode; //!< Aircraft ICAO code
+                    QString modelDescription; //!< Model description
+                    QString modelName;        //!< Model name
+                    QString author;           //!< Model author
+                    QString modelString;      //!< Generated model string
+                    CModelScanManifest::Entry manifestEntry; //!< entry for the new manifest
+                };
+
+                //! Properties of an .acf file, taken from the manifest if the file has not changed
+                //! \remark .acf files are not hashed, reading them costs as much as extracting the properties
+                //! \threadsafe
+                AcfFile extractAcfFile(const QFileInfo &acfFile, const CModelScanManifest &manifest)
+                {
+                    AcfFile properties;
+                    if (manifest.findUnchanged(acfFile.absoluteFilePath(), acfFile, properties.manifestEntry))
+                    {
+                        QDataStream stream(properties.manifestEntry.parsed);
+                        stream.setVersion(StreamVersion);
+                        stream >> properties.aircraftIcaoCode >> properties.modelDescription >> properties.modelName >> properties.author >> properties.modelString;
+                        if (stream.status() == QDataStream::Ok) { return properties; }
+                    }
+
+                    using namespace BlackMisc::Simulation::XPlane::QtFreeUtils;
+                    const AcfProperties acfProperties = extractAcfProperties(acfFile.filePath().toStdString());
+                    properties.aircraftIcaoCode = QString::fromStdString(acfProperties.aircraftIcaoCode);
+                    properties.modelDescription = QString::fromStdString(acfProperties.modelDescription);
+                    properties.modelName = QString::fromStdString(acfProperties.modelName);
+                    properties.author = QString::fromStdString(acfProperties.author);
+                    properties.modelString = QString::fromStdString(acfProperties.modelString);
+
+                    QByteArray parsed;
+                    QDataStream stream(&parsed, QIODevice::WriteOnly);
+                    stream.setVersion(StreamVersion);
+                    stream << properties.aircraftIcaoCode << properties.modelDescription << properties.modelName << properties.author << properties.modelString;
+                    properties.manifestEntry = CModelScanManifest::createEntry(acfFile, {}, parsed);
+                    return properties;
+                }
+            }
+
             //! Create a description string for a model that doesn't already have one
             static QString descriptionForFlyableModel(const CAircraftModel &model)
             {
@@ -165,11 +218,24 @@ namespace BlackMisc
 
             CAircraftModelList CAircraftModelLoaderXPlane::performParsing(const QStringList &rootDirectories, const QStringList &excludeDirectories)
             {
+                // properties of unchanged .acf files are taken from the manifest of the last scan
+                const QString manifestFile = CModelScanManifest::manifestFilePath(this->getSimulator(), QStringLiteral("acf"));
+                CModelScanManifest manifest(ManifestParserVersion);
+                if (!manifestFile.isEmpty()) { manifest.readFromFile(manifestFile); } // no manifest means all files are parsed
+                CModelScanManifest newManifest(ManifestParserVersion);
+
                 CAircraftModelList allModels;
                 for (const QString &rootDirectory : rootDirectories)
                 {
                     allModels.push_back(parseCslPackages(rootDirectory, excludeDirectories));
-                    allModels.push_back(parseFlyableAirplanes(rootDirectory, excludeDirectories));
+                    allModels.push_back(parseFlyableAirplanes(rootDirectory, excludeDirectories, manifest, newManifest));
+                }
+
+                // files no longer found are dropped, files of directories not scanned are kept
+                manifest.replaceDirectories(rootDirectories, newManifest);
+                if (!manifestFile.isEmpty() && !m_cancelLoading && !manifest.writeToFile(manifestFile))
+                {
+                    CLogMessage(this).warning(u"Cannot write model scan manifest '%1'") << manifestFile;
                 }
                 return allModels;
             }
@@ -185,7 +251,7 @@ namespace BlackMisc
                 models.push_back(model);
             }
 
-            CAircraftModelList CAircraftModelLoaderXPlane::parseFlyableAirplanes(const QString &rootDirectory, const QStringList &excludeDirectories)
+            CAircraftModelList CAircraftModelLoaderXPlane::parseFlyableAirplanes(const QString &rootDirectory, const QStringList &excludeDirectories, const CModelScanManifest &manifest, CModelScanManifest &o_newManifest)
             {
                 Q_UNUSED(excludeDirectories)
                 if (rootDirectory.isEmpty()) { return {}; }
@@ -195,32 +261,49 @@ namespace BlackMisc
 
                 emit loadingProgress(this->getSimulator(), QStringLiteral("Parsing flyable airplanes in '%1'").arg(rootDirectory), -1);
 
-                CAircraftModelList installedModels;
+                QVector<QFileInfo> acfFiles;
                 while (aircraftIt.hasNext())
                 {
                     aircraftIt.next();
                     if (CFileUtils::isExcludedDirectory(aircraftIt.fileInfo(), excludeDirectories, Qt::CaseInsensitive)) { continue; }
+                    acfFiles.push_back(aircraftIt.fileInfo());
+                }
 
-                    using namespace BlackMisc::Simulation::XPlane::QtFreeUtils;
-                    AcfProperties acfProperties = extractAcfProperties(aircraftIt.filePath().toStdString());
+                // .acf files are large, the properties are extracted in parallel
+                QVector<AcfFile> acfProperties(acfFiles.size());
+                AcfFile *acfPropertiesData = acfProperties.data();
+                const QFileInfo *acfFilesData = acfFiles.constData();
+                runInParallel(acfFiles.size(), [ & ](int i)
+                {
+                    if (m_cancelLoading) { return; }
+                    acfPropertiesData[i] = extractAcfFile(acfFilesData[i], manifest);
+                });
+                if (m_cancelLoading) { return {}; }
+
+                CAircraftModelList installedModels;
+                for (int i = 0; i < acfFiles.size(); i++)
+                {
+                    const QFileInfo &acfFile = acfFiles[i];
+                    const AcfFile &acfFileProperties = acfProperties[i];
+                    o_newManifest.insert(acfFile.absoluteFilePath(), acfFileProperties.manifestEntry);
 
-                    const CDistributor dist({}, QString::fromStdString(acfProperties.author), {}, {}, CSimulatorInfo::XPLANE);
+                    const CDistributor dist({}, acfFileProperties.author, {}, {}, CSimulatorInfo::XPLANE);
                     CAircraftModel model;
-                    model.setAircraftIcaoCode(QString::fromStdString(acfProperties.aircraftIcaoCode));
-                    model.setDescription(QString::fromStdString(acfProperties.modelDescription));
-                    model.setName(QString::fromStdString(acfProperties.modelName));
+                    model.setAircraftIcaoCode(acfFileProperties.aircraftIcaoCode);
+                    model.setDescription(acfFileProperties.modelDescription);
+                    model.setName(acfFileProperties.modelName);
                     model.setDistributor(dist);
-                    model.setModelString(QString::fromStdString(acfProperties.modelString));
+                    model.setModelString(acfFileProperties.modelString);
                     if (!model.hasDescription()) { model.setDescription(descriptionForFlyableModel(model)); }
                     model.setModelType(CAircraftModel::TypeOwnSimulatorModel);
                     model.setSimulator(CSimulatorInfo::xplane());
-                    model.setFileDetailsAndTimestamp(aircraftIt.fileInfo());
+                    model.setFileDetailsAndTimestamp(acfFile);
                     model.setModelMode(CAircraftModel::Exclude);
                     addUniqueModel(model, installedModels);
 
                     const QString baseModelString = model.getModelString();
-                    QDirIterator liveryIt(CFileUtils::appendFilePaths(aircraftIt.fileInfo().canonicalPath(), QStringLiteral("liveries")), QDir::Dirs | QDir::NoDotAndDotDot);
-                    emit this->loadingProgress(this->getSimulator(), QStringLiteral("Parsing flyable liveries in '%1'").arg(aircraftIt.fileInfo().canonicalPath()), -1);
+                    QDirIterator liveryIt(CFileUtils::appendFilePaths(acfFile.canonicalPath(), QStringLiteral("liveries")), QDir::Dirs | QDir::NoDotAndDotDot);
+                    emit this->loadingProgress(this->getSimulator(), QStringLiteral("Parsing flyable liveries in '%1'").arg(acfFile.canonicalPath()), -1);
                     while (liveryIt.hasNext())
                     {
                         liveryIt.next();
@@ -238,42 +321,50 @@ namespace BlackMisc
 
                 m_cslPackages.clear();
 
+                QStringList packageFiles;
                 QDir searchPath(rootDirectory, fileFilterCsl());
                 QDirIterator it(searchPath, QDirIterator::Subdirectories);
                 while (it.hasNext())
                 {
-                    QString packageFile = it.next();
+                    const QString packageFile = it.next();
                     if (CFileUtils::isExcludedDirectory(it.filePath(), excludeDirectories)) { continue; }
+                    packageFiles.push_back(packageFile);
+                }
 
-                    const QString packageFilePath = it.fileInfo().absolutePath();
-                    QFile file(packageFile);
+                // the files are read in parallel and only once, for the header and the full run
+                QVector<QString> contents(packageFiles.size());
+                QString *contentsData = contents.data();
+                runInParallel(packageFiles.size(), [ & ](int i)
+                {
+                    QFile file(packageFiles.at(i));
                     file.open(QIODevice::ReadOnly);
-                    QString content;
-
                     QTextStream ts(&file);
-                    content.append(ts.readAll());
+                    contentsData[i] = ts.readAll();
                     file.close();
+                });
 
-                    const auto package = parsePackageHeader(packageFilePath, content);
-                    if (package.hasValidHeader()) m_cslPackages.push_back(package);
+                // packages can depend on each other, so the header of all packages is parsed first
+                QVector<QString> packageContents;
+                for (int i = 0; i < packageFiles.size(); i++)
+                {
+                    const QString packageFilePath = QFileInfo(packageFiles[i]).absolutePath();
+                    const auto package = parsePackageHeader(packageFilePath, contents[i]);
+                    if (package.hasValidHeader())
+                    {
+                        m_cslPackages.push_back(package);
+                        packageContents.push_back(contents[i]);
+                    }
                 }
 
                 CAircraftModelList installedModels;
 
                 // Now we do a full run
-                for (auto &package : m_cslPackages)
+                for (int p = 0; p < m_cslPackages.size(); p++)
                 {
+                    CSLPackage &package = m_cslPackages[p];
                     const QString packageFile = CFileUtils::appendFilePaths(package.path, QStringLiteral("xsb_aircraft.txt"));
                     emit this->loadingProgress(this->getSimulator(), QStringLiteral("Parsing CSL '%1'").arg(packageFile), -1);
-
-                    QFile file(packageFile);
-                    file.open(QIODevice::ReadOnly);
-                    QString content;
-
-                    QTextStream ts(&file);
-                    content.append(ts.readAll());
-                    file.close();
-                    parseFullPackage(content, package);
+                    parseFullPackage(packageContents[p], package);
 
                     for (const auto &plane : as_const(package.planes))
                     {
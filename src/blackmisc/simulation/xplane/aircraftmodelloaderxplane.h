@@ -14,6 +14,7 @@
 #include "blackmisc/blackmiscexport.h"
 #include "blackmisc/simulation/aircraftmodellist.h"
 #include "blackmisc/simulation/aircraftmodelloader.h"
+#include "blackmisc/simulation/modelscanmanifest.h"
 #include "blackmisc/simulation/simulatorinfo.h"
 
 #include <QObject>
@@ -100,7 +101,7 @@ namespace BlackMisc
                 };
 
                 CAircraftModelList performParsing(const QStringList &rootDirectories, const QStringList &excludeDirectories);
-                CAircraftModelList parseFlyableAirplanes(const QString &rootDirectory, const QStringList &excludeDirectories);
+                CAircraftModelList parseFlyableAirplanes(const QString &rootDirectory, const QStringList &excludeDirectories, const CModelScanManifest &manifest, CModelScanManifest &o_newManifest);
                 CAircraftModelList parseCslPackages(const QString &rootDirectory, const QStringList &excludeDirectories);
 
                 bool doPackageSub(QString &ioPath);
@@ -0,0 +1,141 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_XPLANE_QTFREETRAFFICFRAME_H
+#define BLACKMISC_SIMULATION_XPLANE_QTFREETRAFFICFRAME_H
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Strict header only traffic frame layout shared between the X-Plane driver and XSwiftBus.
+// Header only is necessary to no require XSwiftBus to link against BlackMisc.
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        namespace XPlane
+        {
+            namespace QtFreeTrafficFrame
+            {
+                //! Frame magic "XSTF", also detects a different byte order on the other side
+                constexpr std::uint32_t Magic = 0x46545358;
+
+                //! Frame version, increased with any change of the layout
+                constexpr std::uint16_t Version = 1;
+
+                //! Frame header
+                struct Header
+                {
+                    std::uint32_t magic = Magic;     //!< Magic
+                    std::uint16_t version = Version; //!< Version
+                    std::uint16_t planeCount = 0;    //!< Number of plane records following the header
+                };
+
+                //! Groups of values contained in a plane record
+                enum ChangedFlag : std::uint32_t
+                {
+                    Position    = 1 << 0, //!< latitude, longitude, altitude, pitch, roll, heading, on ground
+                    Surfaces    = 1 << 1, //!< control surfaces and lights
+                    Transponder = 1 << 2  //!< code and flags
+                };
+
+                //! Light flags of a plane record
+                enum LightFlag : std::uint8_t
+                {
+                    LandLight   = 1 << 0, //!< landing lights
+                    TaxiLight   = 1 << 1, //!< taxi lights
+                    BeaconLight = 1 << 2, //!< beacon
+                    StrobeLight = 1 << 3, //!< strobes
+                    NavLight    = 1 << 4  //!< navigation lights
+                };
+
+                //! Transponder flags of a plane record
+                enum TransponderFlag : std::uint8_t
+                {
+                    ModeC = 1 << 0, //!< mode C
+                    Ident = 1 << 1  //!< ident
+                };
+
+                //! Values of one plane, only the groups in changedMask are valid
+                struct PlaneRecord
+                {
+                    std::uint32_t planeId = 0;         //!< id passed to addPlane
+                    std::uint32_t changedMask = 0;     //!< ChangedFlag
+                    double latitudeDeg = 0;            //!< Position
+                    double longitudeDeg = 0;           //!< Position
+                    double altitudeFt = 0;             //!< Position
+                    float pitchDeg = 0;                //!< Position
+                    float rollDeg = 0;                 //!< Position
+                    float headingDeg = 0;              //!< Position
+                    float gear = 0;                    //!< Surfaces
+                    float flaps = 0;                   //!< Surfaces
+                    float spoilers = 0;                //!< Surfaces
+                    float speedBrakes = 0;             //!< Surfaces
+                    float slats = 0;                   //!< Surfaces
+                    float wingSweep = 0;               //!< Surfaces
+                    float thrust = 0;                  //!< Surfaces
+                    float elevator = 0;                //!< Surfaces
+                    float rudder = 0;                  //!< Surfaces
+                    float aileron = 0;                 //!< Surfaces
+                    std::int32_t lightPattern = 0;     //!< Surfaces
+                    std::int32_t transponderCode = 0;  //!< Transponder
+                    std::uint8_t onGround = 0;         //!< Position
+                    std::uint8_t lights = 0;           //!< Surfaces, LightFlag
+                    std::uint8_t transponderFlags = 0; //!< Transponder, TransponderFlag
+                    std::uint8_t reserved = 0;         //!< always 0
+                };
+
+                static_assert(sizeof(Header) == 8, "Fixed header size");
+                static_assert(sizeof(PlaneRecord) == 96, "Fixed record size");
+                static_assert(std::is_trivially_copyable<PlaneRecord>::value, "Copied with memcpy");
+
+                //! Maximum number of planes in one frame
+                constexpr std::size_t MaxPlanes = 0xFFFF;
+
+                //! Size of a frame with planeCount records
+                constexpr std::size_t frameSize(std::size_t planeCount)
+                {
+                    return sizeof(Header) + planeCount * sizeof(PlaneRecord);
+                }
+
+                //! Write a frame, records beyond MaxPlanes are ignored
+                //! \remark o_frame must point to at least frameSize(planeCount) bytes
+                inline void writeFrame(const PlaneRecord *records, std::size_t planeCount, char *o_frame)
+                {
+                    if (planeCount > MaxPlanes) { planeCount = MaxPlanes; }
+                    Header header;
+                    header.planeCount = static_cast<std::uint16_t>(planeCount);
+                    std::memcpy(o_frame, &header, sizeof(Header));
+                    if (planeCount > 0) { std::memcpy(o_frame + sizeof(Header), records, planeCount * sizeof(PlaneRecord)); }
+                }
+
+                //! Read a frame
+                //! \return false if the frame has a different magic, version or size
+                inline bool readFrame(const char *frame, std::size_t size, std::vector<PlaneRecord> &o_records)
+                {
+                    o_records.clear();
+                    if (!frame || size < sizeof(Header)) { return false; }
+                    Header header;
+                    std::memcpy(&header, frame, sizeof(Header));
+                    if (header.magic != Magic || header.version != Version) { return false; }
+                    if (size != frameSize(header.planeCount)) { return false; }
+                    o_records.resize(header.planeCount);
+                    if (header.planeCount > 0) { std::memcpy(o_records.data(), frame + sizeof(Header), header.planeCount * sizeof(PlaneRecord)); }
+                    return true;
+                }
+            } // ns
+        } // ns
+    } // ns
+} // ns
+
+#endif // guard
@@ -0,0 +1,98 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SPSCRINGBUFFER_H
+#define BLACKMISC_SPSCRINGBUFFER_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace BlackMisc
+{
+    /*!
+     * Fixed size lock-free ring buffer for one producer thread and one consumer thread.
+     * \remark push and pop never block and never allocate, a full buffer is reported to the producer
+     * \remark the capacity is rounded up to a power of 2
+     */
+    template <typename T>
+    class CSpscRingBuffer
+    {
+    public:
+        //! Constructor
+        explicit CSpscRingBuffer(int capacity) :
+            m_slots(roundUpToPowerOf2(capacity)), m_mask(static_cast<quint32>(m_slots.size()) - 1)
+        {}
+
+        //! Not copyable.
+        //! @{
+        CSpscRingBuffer(const CSpscRingBuffer &) = delete;
+        CSpscRingBuffer &operator =(const CSpscRingBuffer &) = delete;
+        //! @}
+
+        //! Append a value, false if the buffer is full
+        //! \remark only to be called by the producer thread, value is only moved from if true is returned
+        bool tryPush(T &&value)
+        {
+            const quint32 head = m_head.load(std::memory_order_relaxed);
+            if (head - m_tail.load(std::memory_order_acquire) > m_mask) { return false; }
+            m_slots[head & m_mask] = std::move(value);
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        //! Append a value, false if the buffer is full
+        //! \remark only to be called by the producer thread
+        bool tryPush(const T &value)
+        {
+            T copy(value);
+            return this->tryPush(std::move(copy));
+        }
+
+        //! Take the oldest value, false if the buffer is empty
+        //! \remark only to be called by the consumer thread
+        bool tryPop(T &o_value)
+        {
+            const quint32 tail = m_tail.load(std::memory_order_relaxed);
+            if (tail == m_head.load(std::memory_order_acquire)) { return false; }
+            T &slot = m_slots[tail & m_mask];
+            o_value = std::move(slot);
+            slot = T(); // do not keep resources of popped values alive
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        //! Number of values, only a snapshot if called while the other thread is pushing or popping
+        int size() const { return static_cast<int>(m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire)); }
+
+        //! Empty? Only a snapshot if called while the other thread is pushing or popping
+        bool isEmpty() const { return this->size() == 0; }
+
+        //! Maximum number of values
+        int capacity() const { return static_cast<int>(m_slots.size()); }
+
+    private:
+        static int roundUpToPowerOf2(int capacity)
+        {
+            int size = 1;
+            while (size < capacity) { size *= 2; }
+            return size;
+        }
+
+        std::vector<T> m_slots;
+        const quint32 m_mask;
+        std::atomic<quint32> m_head { 0 };        //!< next slot to be written, changed by the producer only
+        char m_padding[64 - sizeof(quint32)] {}; //!< head and tail in different cache lines
+        std::atomic<quint32> m_tail { 0 };        //!< next slot to be read, changed by the consumer only
+    };
+} // ns
+
+#endif // guard
@@ -10,6 +10,7 @@
 
 #include "blackmisc/valuecache.h"
 #include "blackmisc/atomicfile.h"
+#include "blackmisc/binarycachefile.h"
 #include "blackmisc/swiftdirectories.h"
 #include "blackmisc/directoryutils.h"
 #include "blackmisc/identifier.h"
@@ -366,6 +367,16 @@ namespace BlackMisc
     }
 
     CStatusMessage CValueCache::saveToFiles(const QString &dir, const CVariantMap &values, const QString &keysMessage) const
+    {
+        return m_binaryFiles ? saveToBinaryFiles(dir, values, keysMessage) : saveToJsonFiles(dir, values, keysMessage);
+    }
+
+    CStatusMessage CValueCache::exportToJsonFiles(const QString &dir, const QString &keyPrefix) const
+    {
+        return saveToJsonFiles(dir, getAllValues(keyPrefix));
+    }
+
+    CStatusMessage CValueCache::saveToJsonFiles(const QString &dir, const CVariantMap &values, const QString &keysMessage) const
     {
         QMap<QString, CVariantMap> namespaces;
         for (auto it = values.cbegin(); it != values.cend(); ++it)
@@ -393,6 +404,14 @@ namespace BlackMisc
                 return CStatusMessage(this).error(u"Invalid JSON format in %1") << file.fileName();
             }
             auto object = json.object();
+
+            // values saved in the binary format meanwhile
+            const QString binaryFileName = dir + "/" + it.key() + CBinaryCacheFile::fileExtension();
+            if (isBinaryFileCurrent(binaryFileName, file.fileName()))
+            {
+                CVariantMap binaryValues;
+                if (readBinaryFile(binaryFileName, {}, binaryValues, false).isEmpty()) { binaryValues.mergeToMemoizedJson(object); }
+            }
             json.setObject(it->mergeToMemoizedJson(object));
 
             if (!(file.seek(0) && file.resize(0) && file.write(json.toJson()) > 0 && file.checkedClose()))
@@ -404,6 +423,72 @@ namespace BlackMisc
             (keysMessage.isEmpty() ? values.keys().to<QStringList>().join(",") : keysMessage) << dir;
     }
 
+    CStatusMessage CValueCache::saveToBinaryFiles(const QString &dir, const CVariantMap &values, const QString &keysMessage) const
+    {
+        QMap<QString, CVariantMap> namespaces;
+        for (auto it = values.cbegin(); it != values.cend(); ++it)
+        {
+            namespaces[it.key().section('/', 0, m_fileSplitDepth - 1)].insert(it.key(), it.value());
+        }
+        if (! QDir::root().mkpath(dir))
+        {
+            return CStatusMessage(this).error(u"Failed to create directory '%1'") << dir;
+        }
+        for (auto it = namespaces.cbegin(); it != namespaces.cend(); ++it)
+        {
+            const QString fileName = dir + "/" + it.key() + CBinaryCacheFile::fileExtension();
+            const QString jsonFileName = dir + "/" + it.key() + ".json";
+
+            // other values of the same file, as raw data if possible, values saved in the JSON format meanwhile have to be converted
+            CBinaryCacheFile::RawValues rawValues;
+            if (QFile::exists(jsonFileName) && ! isBinaryFileCurrent(fileName, jsonFileName))
+            {
+                QFile jsonFile(jsonFileName);
+                if (! jsonFile.open(QFile::ReadOnly | QFile::Text))
+                {
+                    return CStatusMessage(this).error(u"Failed to open %1: %2") << jsonFile.fileName() << jsonFile.errorString();
+                }
+                CVariantMap jsonValues;
+                const auto messages = jsonValues.convertFromMemoizedJsonNoThrow(QJsonDocument::fromJson(jsonFile.readAll()).object(), this, QStringLiteral("Parsing %1").arg(jsonFile.fileName()));
+                if (! messages.isEmpty())
+                {
+                    return CStatusMessage(this).error(u"Invalid JSON format in %1") << jsonFile.fileName();
+                }
+                for (auto value = jsonValues.cbegin(); value != jsonValues.cend(); ++value) { rawValues.insert(value.key(), CBinaryCacheFile::serializeValue(value.value())); }
+            }
+            else
+            {
+                CBinaryCacheFile existing(fileName);
+                if (QFile::exists(fileName) && existing.open())
+                {
+                    for (const QString &key : existing.keys())
+                    {
+                        const QByteArray raw = existing.rawValue(key);
+                        if (! raw.isEmpty()) { rawValues.insert(key, raw); }
+                    }
+                }
+            } // mapped file closed before it is replaced
+
+            for (auto value = it->cbegin(); value != it->cend(); ++value) { rawValues.insert(value.key(), CBinaryCacheFile::serializeValue(value.value())); }
+
+            CAtomicFile file(fileName);
+            if (! QDir::root().mkpath(QFileInfo(file).path()))
+            {
+                return CStatusMessage(this).error(u"Failed to create directory '%1'") << QFileInfo(file).path();
+            }
+            if (! file.open(QFile::WriteOnly))
+            {
+                return CStatusMessage(this).error(u"Failed to open %1: %2") << file.fileName() << file.errorString();
+            }
+            if (!(CBinaryCacheFile::write(file, rawValues, jsonFileName) && file.checkedClose()))
+            {
+                return CStatusMessage(this).error(u"Failed to write to %1: %2") << file.fileName() << file.errorString();
+            }
+        }
+        return CStatusMessage(this).info(u"Written '%1' to value cache in '%2'") <<
+            (keysMessage.isEmpty() ? values.keys().to<QStringList>().join(",") : keysMessage) << dir;
+    }
+
     CStatusMessage CValueCache::loadFromFiles(const QString &dir)
     {
         QMutexLocker lock(&m_mutex);
@@ -432,16 +517,39 @@ namespace BlackMisc
         }
         if (keys.isEmpty())
         {
-            QDirIterator iter(dir, { "*.json" }, QDir::Files, QDirIterator::Subdirectories);
+            QDirIterator iter(dir, { "*.json", "*" + CBinaryCacheFile::fileExtension() }, QDir::Files, QDirIterator::Subdirectories);
             while (iter.hasNext())
             {
-                keysInFiles.insert(QDir(dir).relativeFilePath(iter.next()), {});
+                QString relative = QDir(dir).relativeFilePath(iter.next());
+                if (relative.endsWith(CBinaryCacheFile::fileExtension())) { relative = relative.chopped(CBinaryCacheFile::fileExtension().size()) + ".json"; }
+                keysInFiles.insert(relative, {});
             }
         }
         bool ok = true;
         for (auto it = keysInFiles.cbegin(); it != keysInFiles.cend(); ++it)
         {
+            // whichever format was written last
             QFile file(QDir(dir).absoluteFilePath(it.key()));
+            const QString binaryFileName = file.fileName().chopped(5) + CBinaryCacheFile::fileExtension();
+            if (isBinaryFileCurrent(binaryFileName, file.fileName()))
+            {
+                CVariantMap temp;
+                const CStatusMessageList messages = readBinaryFile(binaryFileName, it.value(), temp, keysOnly);
+                if (! messages.isEmpty())
+                {
+                    ok = false;
+                    QFile binaryFile(binaryFileName);
+                    backupFile(binaryFile);
+                    CLogMessage::preformatted(messages);
+                }
+                if (messages.isEmpty() || ! file.exists())
+                {
+                    temp.removeDuplicates(currentValues);
+                    o_values.insert(temp, QFileInfo(binaryFileName).lastModified().toMSecsSinceEpoch());
+                    continue;
+                }
+                // corrupted binary file, fall back to the JSON file
+            }
             if (! file.exists())
             {
                 continue;
@@ -480,6 +588,42 @@ namespace BlackMisc
             (keysMessage.isEmpty() ? o_values.keys().to<QStringList>().join(",") : keysMessage) << dir << (ok ? "successfully" : "with errors");
     }
 
+    CStatusMessageList CValueCache::readBinaryFile(const QString &fileName, const QStringList &keys, CVariantMap &o_values, bool keysOnly) const
+    {
+        CBinaryCacheFile file(fileName);
+        if (! file.open())
+        {
+            return CStatusMessage(this).error(u"Failed to read %1: %2") << fileName << file.errorString();
+        }
+
+        CStatusMessageList messages;
+        const QStringList fileKeys = (keys.isEmpty() || keysOnly) ? file.keys() : keys;
+        for (const QString &key : fileKeys)
+        {
+            if (keysOnly) { o_values.insert(key, {}); continue; }
+            if (! file.contains(key)) { continue; }
+
+            // only the requested values are deserialized
+            CVariant value;
+            if (file.value(key, value)) { o_values.insert(key, value); }
+            else { messages.push_back(CStatusMessage(this).error(u"Parsing %1: %2") << fileName << file.errorString()); }
+        }
+        return messages;
+    }
+
+    bool CValueCache::isBinaryFileCurrent(const QString &binaryFileName, const QString &jsonFileName)
+    {
+        const QFileInfo binaryInfo(binaryFileName);
+        if (! binaryInfo.exists()) { return false; }
+        const QFileInfo jsonInfo(jsonFileName);
+        if (! jsonInfo.exists()) { return true; }
+        if (binaryInfo.lastModified() < jsonInfo.lastModified()) { return false; }
+
+        // same or newer timestamp, but the timestamp resolution may be too coarse, so the stamp of the JSON file decides
+        CBinaryCacheFile binaryFile(binaryFileName);
+        return binaryFile.open() && binaryFile.supersedes(jsonFileName);
+    }
+
     void CValueCache::backupFile(QFile &file) const
     {
         QDir dir = getCacheRootDirectory();
@@ -520,14 +664,21 @@ namespace BlackMisc
 
     QString CValueCache::filenameForKey(const QString &key) const
     {
-        return key.section('/', 0, m_fileSplitDepth - 1) + ".json";
+        return key.section('/', 0, m_fileSplitDepth - 1) + (m_binaryFiles ? CBinaryCacheFile::fileExtension() : QStringLiteral(".json"));
     }
 
     QStringList CValueCache::enumerateFiles(const QString &dir) const
     {
         auto values = getAllValues();
         QSet<QString> files;
-        for (auto it = values.begin(); it != values.end(); ++it) { files.insert(dir + "/" + filenameForKey(it.key())); }
+        for (auto it = values.begin(); it != values.end(); ++it)
+        {
+            // files of the other format are also used as long as they exist
+            const QString ns = dir + "/" + it.key().section('/', 0, m_fileSplitDepth - 1);
+            files.insert(dir + "/" + filenameForKey(it.key()));
+            if (QFile::exists(ns + ".json")) { files.insert(ns + ".json"); }
+            if (QFile::exists(ns + CBinaryCacheFile::fileExtension())) { files.insert(ns + CBinaryCacheFile::fileExtension()); }
+        }
         return files.values();
     }
 
@@ -43,6 +43,7 @@
 #include <QThread>
 #include <QVariant>
 #include <QtGlobal>
+#include <atomic>
 #include <stdexcept>
 #include <cstddef>
 #include <tuple>
@@ -219,6 +220,21 @@ namespace BlackMisc
         //! \threadsafe
         CStatusMessage loadFromFiles(const QString &directory);
 
+        //! Save values to Json files in a given directory, regardless of the file format.
+        //! Values are not marked as saved, this is meant for diagnostics.
+        //! \threadsafe
+        CStatusMessage exportToJsonFiles(const QString &directory, const QString &keyPrefix = {}) const;
+
+        //! Save values to binary files instead of Json files.
+        //! \remark loading always supports both formats, per file whichever was written last is used
+        //! \see BlackMisc::CBinaryCacheFile
+        //! \threadsafe
+        void setBinaryFileFormat(bool binary) { m_binaryFiles = binary; }
+
+        //! Are values saved to binary files?
+        //! \threadsafe
+        bool isBinaryFileFormat() const { return m_binaryFiles; }
+
         //! Return the (relative) filename that may is (or would be) used to save the value with the given key.
         //! The file may or may not exist (because it might not have been saved yet).
         //! \threadsafe
@@ -281,11 +297,11 @@ namespace BlackMisc
         }
         //! @}
 
-        //! Save specific values to Json files in a given directory.
+        //! Save specific values to Json or binary files in a given directory.
         //! \threadsafe
         CStatusMessage saveToFiles(const QString &directory, const CVariantMap &values, const QString &keysMessage = {}) const;
 
-        //! Load from Json files in a given directory any values which differ from the current ones, and insert them in o_values.
+        //! Load from Json or binary files in a given directory any values which differ from the current ones, and insert them in o_values.
         //! \threadsafe
         CStatusMessage loadFromFiles(const QString &directory, const QSet<QString> &keys, const CVariantMap &current, CValueCachePacket &o_values, const QString &keysMessage = {}, bool keysOnly = false) const;
 
@@ -322,6 +338,12 @@ namespace BlackMisc
         QMap<QString, QString> m_humanReadable;
         const int m_fileSplitDepth = 1; //!< How many levels of subdirectories to split JSON files
 
+        std::atomic_bool m_binaryFiles { false }; //!< save binary files instead of JSON files
+
+        CStatusMessage saveToJsonFiles(const QString &directory, const CVariantMap &values, const QString &keysMessage = {}) const;
+        CStatusMessage saveToBinaryFiles(const QString &directory, const CVariantMap &values, const QString &keysMessage = {}) const;
+        CStatusMessageList readBinaryFile(const QString &fileName, const QStringList &keys, CVariantMap &o_values, bool keysOnly) const;
+        static bool isBinaryFileCurrent(const QString &binaryFileName, const QString &jsonFileName);
         Element &getElement(const QString &key);
         Element &getElement(const QString &key, QMap<QString, ElementPtr>::const_iterator pos);
         std::tuple<CVariant, qint64, bool> getValue(const QString &key);
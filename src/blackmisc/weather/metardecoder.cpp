@@ -11,6 +11,7 @@
 #include "blackmisc/aviation/airporticaocode.h"
 #include "blackmisc/aviation/altitude.h"
 #include "blackmisc/logmessage.h"
+#include "blackmisc/parallel.h"
 #include "blackmisc/pq/angle.h"
 #include "blackmisc/pq/length.h"
 #include "blackmisc/pq/measurementunit.h"
@@ -29,7 +30,12 @@
 #include <QRegularExpression>
 #include <QRegularExpressionMatch>
 #include <QStringList>
+#include <QStringView>
+#include <QThread>
+#include <QVector>
 #include <QtGlobal>
+#include <atomic>
+#include <functional>
 
 using namespace BlackMisc::PhysicalQuantities;
 using namespace BlackMisc::Aviation;
@@ -44,6 +50,131 @@ namespace BlackMisc
         // http://www.sigmet.de/key.php
         // http://wx.erau.edu/reference/text/metar_code_format.pdf
 
+        // Tokens used by the decoder parts and the single pass decoder
+        namespace
+        {
+            const QHash<QString, CMetar::ReportType> &reportTypes()
+            {
+                static const QHash<QString, CMetar::ReportType> hash =
+                {
+                    { "METAR", CMetar::METAR },
+                    { "SPECI", CMetar::SPECI }
+                };
+                return hash;
+            }
+
+            const QHash<QString, CSpeedUnit> &windUnits()
+            {
+                static const QHash<QString, CSpeedUnit> hash =
+                {
+                    { "KT", CSpeedUnit::kts() },
+                    { "MPS", CSpeedUnit::m_s() },
+                    { "KPH", CSpeedUnit::km_h() },
+                    { "KMH", CSpeedUnit::km_h() }
+                };
+                return hash;
+            }
+
+            const QHash<QString, QString> &cardinalDirections()
+            {
+                static const QHash<QString, QString> hash =
+                {
+                    { "N", "north" },
+                    { "NE", "north-east" },
+                    { "E", "east" },
+                    { "SE", "south-east" },
+                    { "S", "south" },
+                    { "SW", "south-west" },
+                    { "W", "west" },
+                    { "NW", "north-west" },
+                };
+                return hash;
+            }
+
+            const QHash<QString, CPresentWeather::Intensity> &intensities()
+            {
+                static const QHash<QString, CPresentWeather::Intensity> hash =
+                {
+                    { "-", CPresentWeather::Light },
+                    { "+", CPresentWeather::Heavy },
+                    { "VC", CPresentWeather::InVincinity }
+                };
+                return hash;
+            }
+
+            const QHash<QString, CPresentWeather::Descriptor> &descriptors()
+            {
+                static const QHash<QString, CPresentWeather::Descriptor> hash =
+                {
+                    { "MI", CPresentWeather::Shallow },
+                    { "BC", CPresentWeather::Patches },
+                    { "PR", CPresentWeather::Partial },
+                    { "DR", CPresentWeather::Drifting },
+                    { "BL", CPresentWeather::Blowing },
+                    { "SH", CPresentWeather::Showers },
+                    { "TS", CPresentWeather::Thunderstorm },
+                    { "FR", CPresentWeather::Freezing },
+                };
+                return hash;
+            }
+
+            const QHash<QString, CPresentWeather::WeatherPhenomenon> &phenomena()
+            {
+                static const QHash<QString, CPresentWeather::WeatherPhenomenon> hash =
+                {
+                    { "DZ", CPresentWeather::Drizzle },
+                    { "RA", CPresentWeather::Rain },
+                    { "SN", CPresentWeather::Snow },
+                    { "SG", CPresentWeather::SnowGrains },
+                    { "IC", CPresentWeather::IceCrystals },
+                    { "PC", CPresentWeather::IcePellets },
+                    { "GR", CPresentWeather::Hail },
+                    { "GS", CPresentWeather::SnowPellets },
+                    { "UP", CPresentWeather::Unknown },
+                    { "BR", CPresentWeather::Mist },
+                    { "FG", CPresentWeather::Fog },
+                    { "FU", CPresentWeather::Smoke },
+                    { "VA", CPresentWeather::VolcanicAsh },
+                    { "DU", CPresentWeather::Dust },
+                    { "SA", CPresentWeather::Sand },
+                    { "HZ", CPresentWeather::Haze },
+                    { "PO", CPresentWeather::DustSandWhirls },
+                    { "SQ", CPresentWeather::Squalls },
+                    { "FC", CPresentWeather::TornadoOrWaterspout },
+                    { "FC", CPresentWeather::FunnelCloud },
+                    { "SS", CPresentWeather::Sandstorm },
+                    { "DS", CPresentWeather::Duststorm },
+                    { "//", {} },
+                };
+                return hash;
+            }
+
+            const QStringList &clearSkyTokens()
+            {
+                static const QStringList list =
+                {
+                    "SKC",
+                    "NSC",
+                    "CLR",
+                    "NCD"
+                };
+                return list;
+            }
+
+            const QHash<QString, CCloudLayer::Coverage> &cloudCoverages()
+            {
+                static const QHash<QString, CCloudLayer::Coverage> hash =
+                {
+                    { "///", CCloudLayer::None },
+                    { "FEW", CCloudLayer::Few },
+                    { "SCT", CCloudLayer::Scattered },
+                    { "BKN", CCloudLayer::Broken },
+                    { "OVC", CCloudLayer::Overcast }
+                };
+                return hash;
+            }
+        }
+
         class IMetarDecoderPart
         {
         public:
@@ -119,24 +250,13 @@ namespace BlackMisc
             bool validateAndSet(const QRegularExpressionMatch &match, CMetar &metar) const override
             {
                 QString reportTypeAsString = match.captured("reporttype");
-                if (reportTypeAsString.isEmpty() || !getReportTypeHash().contains(reportTypeAsString)) { return false; }
+                if (reportTypeAsString.isEmpty() || !reportTypes().contains(reportTypeAsString)) { return false; }
 
-                metar.setReportType(getReportTypeHash().value(reportTypeAsString));
+                metar.setReportType(reportTypes().value(reportTypeAsString));
                 return true;
             }
 
             virtual bool isMandatory() const override { return false; }
-
-        private:
-            const QHash<QString, CMetar::ReportType> &getReportTypeHash() const
-            {
-                static const QHash<QString, CMetar::ReportType> hash =
-                {
-                    { "METAR", CMetar::METAR },
-                    { "SPECI", CMetar::SPECI }
-                };
-                return hash;
-            }
         };
 
         class CMetarDecoderAirport : public IMetarDecoderPart
@@ -227,18 +347,6 @@ namespace BlackMisc
             virtual QString getDecoderType() const override { return "Wind"; }
 
         protected:
-            const QHash<QString, CSpeedUnit> &getWindUnitHash() const
-            {
-                static const QHash<QString, CSpeedUnit> hash =
-                {
-                    { "KT", CSpeedUnit::kts() },
-                    { "MPS", CSpeedUnit::m_s() },
-                    { "KPH", CSpeedUnit::km_h() },
-                    { "KMH", CSpeedUnit::km_h() }
-                };
-                return hash;
-            }
-
             const QRegularExpression &getRegExp() const override
             {
                 static const QRegularExpression re(getRegExpImpl());
@@ -274,10 +382,10 @@ namespace BlackMisc
                     if (!ok) return false;
                 }
                 QString unitAsString = match.captured("unit");
-                if (!getWindUnitHash().contains(unitAsString)) return false;
+                if (!windUnits().contains(unitAsString)) return false;
 
-                CWindLayer windLayer(CAltitude(0, CAltitude::AboveGround, CLengthUnit::ft()), CAngle(direction, CAngleUnit::deg()), CSpeed(speed, getWindUnitHash().value(unitAsString)),
-                                     CSpeed(gustSpeed, getWindUnitHash().value(unitAsString)));
+                CWindLayer windLayer(CAltitude(0, CAltitude::AboveGround, CLengthUnit::ft()), CAngle(direction, CAngleUnit::deg()), CSpeed(speed, windUnits().value(unitAsString)),
+                                     CSpeed(gustSpeed, windUnits().value(unitAsString)));
                 windLayer.setDirectionVariable(directionVariable);
                 metar.setWindLayer(windLayer);
                 return true;
@@ -295,7 +403,7 @@ namespace BlackMisc
                 // Optional: Gust in two digits (or three digits if required)
                 const QString gustSpeed = QStringLiteral("(G(?<gustSpeed>\\d{2,3}))?");
                 // Unit
-                const QString unit = QStringLiteral("(?<unit>") + QStringList(getWindUnitHash().keys()).join('|') + ")";
+                const QString unit = QStringLiteral("(?<unit>") + QStringList(windUnits().keys()).join('|') + ")";
                 // Regexp
                 const QString regexp = "^" + direction + speed + gustSpeed + unit + " ?";
                 return regexp;
@@ -354,22 +462,6 @@ namespace BlackMisc
             virtual QString getDecoderType() const override { return "Visibility"; }
 
         protected:
-            const QHash<QString, QString> &getCardinalDirections() const
-            {
-                static const QHash<QString, QString> hash =
-                {
-                    { "N", "north" },
-                    { "NE", "north-east" },
-                    { "E", "east" },
-                    { "SE", "south-east" },
-                    { "S", "south" },
-                    { "SW", "south-west" },
-                    { "W", "west" },
-                    { "NW", "north-west" },
-                };
-                return hash;
-            }
-
             const QRegularExpression &getRegExp() const override
             {
                 static const QRegularExpression re(getRegExpImpl());
@@ -433,7 +525,7 @@ namespace BlackMisc
                 // Cardinal directions N, NE etc.
                 // "////" in case no info is available
                 // NDV = No Directional Variation
-                const QString visibility_eu = QStringLiteral("(?<visibility>\\d{4}|/{4})(NDV)?") + "(" + QStringList(getCardinalDirections().keys()).join('|') + ")?";
+                const QString visibility_eu = QStringLiteral("(?<visibility>\\d{4}|/{4})(NDV)?") + "(" + QStringList(cardinalDirections().keys()).join('|') + ")?";
                 // US/Canada version:
                 // Surface visibility reported in statute miles.
                 // A space divides whole miles and fractions.
@@ -509,64 +601,6 @@ namespace BlackMisc
             virtual QString getDecoderType() const override { return "PresentWeather"; }
 
         protected:
-            const QHash<QString, CPresentWeather::Intensity> &getIntensityHash() const
-            {
-                static const QHash<QString, CPresentWeather::Intensity> hash =
-                {
-                    { "-", CPresentWeather::Light },
-                    { "+", CPresentWeather::Heavy },
-                    { "VC", CPresentWeather::InVincinity }
-                };
-                return hash;
-            }
-
-            const QHash<QString, CPresentWeather::Descriptor> &getDescriptorHash() const
-            {
-                static const QHash<QString, CPresentWeather::Descriptor> hash =
-                {
-                    { "MI", CPresentWeather::Shallow },
-                    { "BC", CPresentWeather::Patches },
-                    { "PR", CPresentWeather::Partial },
-                    { "DR", CPresentWeather::Drifting },
-                    { "BL", CPresentWeather::Blowing },
-                    { "SH", CPresentWeather::Showers },
-                    { "TS", CPresentWeather::Thunderstorm },
-                    { "FR", CPresentWeather::Freezing },
-                };
-                return hash;
-            }
-
-            const QHash<QString, CPresentWeather::WeatherPhenomenon> &getWeatherPhenomenaHash() const
-            {
-                static const QHash<QString, CPresentWeather::WeatherPhenomenon> hash =
-                {
-                    { "DZ", CPresentWeather::Drizzle },
-                    { "RA", CPresentWeather::Rain },
-                    { "SN", CPresentWeather::Snow },
-                    { "SG", CPresentWeather::SnowGrains },
-                    { "IC", CPresentWeather::IceCrystals },
-                    { "PC", CPresentWeather::IcePellets },
-                    { "GR", CPresentWeather::Hail },
-                    { "GS", CPresentWeather::SnowPellets },
-                    { "UP", CPresentWeather::Unknown },
-                    { "BR", CPresentWeather::Mist },
-                    { "FG", CPresentWeather::Fog },
-                    { "FU", CPresentWeather::Smoke },
-                    { "VA", CPresentWeather::VolcanicAsh },
-                    { "DU", CPresentWeather::Dust },
-                    { "SA", CPresentWeather::Sand },
-                    { "HZ", CPresentWeather::Haze },
-                    { "PO", CPresentWeather::DustSandWhirls },
-                    { "SQ", CPresentWeather::Squalls },
-                    { "FC", CPresentWeather::TornadoOrWaterspout },
-                    { "FC", CPresentWeather::FunnelCloud },
-                    { "SS", CPresentWeather::Sandstorm },
-                    { "DS", CPresentWeather::Duststorm },
-                    { "//", {} },
-                };
-                return hash;
-            }
-
             virtual bool isRepeatable() const override { return true; }
 
             const QRegularExpression &getRegExp() const override
@@ -579,18 +613,18 @@ namespace BlackMisc
             {
                 QString intensityAsString = match.captured("intensity");
                 CPresentWeather::Intensity itensity = CPresentWeather::Moderate;
-                if (!intensityAsString.isEmpty()) { itensity = getIntensityHash().value(intensityAsString); }
+                if (!intensityAsString.isEmpty()) { itensity = intensities().value(intensityAsString); }
 
                 QString descriptorAsString = match.captured("descriptor");
                 CPresentWeather::Descriptor descriptor = CPresentWeather::None;
-                if (!descriptorAsString.isEmpty()) { descriptor = getDescriptorHash().value(descriptorAsString); }
+                if (!descriptorAsString.isEmpty()) { descriptor = descriptors().value(descriptorAsString); }
 
                 int weatherPhenomena = 0;
                 QString wp1AsString = match.captured("wp1");
-                if (!wp1AsString.isEmpty()) { weatherPhenomena |= getWeatherPhenomenaHash().value(wp1AsString); }
+                if (!wp1AsString.isEmpty()) { weatherPhenomena |= phenomena().value(wp1AsString); }
 
                 QString wp2AsString = match.captured("wp2");
-                if (!wp2AsString.isEmpty()) { weatherPhenomena |= getWeatherPhenomenaHash().value(wp2AsString); }
+                if (!wp2AsString.isEmpty()) { weatherPhenomena |= phenomena().value(wp2AsString); }
 
                 CPresentWeather presentWeather(itensity, descriptor, weatherPhenomena);
                 metar.addPresentWeather(presentWeather);
@@ -610,8 +644,8 @@ namespace BlackMisc
                 // Qualifier intensity. (-) light (no sign) moderate (+) heavy or VC
                 const QString qualifier_intensity("(?<intensity>[-+]|VC)?");
                 // Descriptor, if any
-                const QString qualifier_descriptor = "(?<descriptor>" + QStringList(getDescriptorHash().keys()).join('|') + ")?";
-                const QString weatherPhenomenaJoined = QStringList(getWeatherPhenomenaHash().keys()).join('|');
+                const QString qualifier_descriptor = "(?<descriptor>" + QStringList(descriptors().keys()).join('|') + ")?";
+                const QString weatherPhenomenaJoined = QStringList(phenomena().keys()).join('|');
                 const QString weather_phenomina1 = "(?<wp1>" + weatherPhenomenaJoined + ")?";
                 const QString weather_phenomina2 = "(?<wp2>" + weatherPhenomenaJoined + ")?";
                 const QString weather_phenomina3 = "(?<wp3>" + weatherPhenomenaJoined + ")?";
@@ -627,31 +661,6 @@ namespace BlackMisc
             virtual QString getDecoderType() const override { return "Cloud"; }
 
         protected:
-            const QStringList &getClearSkyTokens() const
-            {
-                static const QStringList list =
-                {
-                    "SKC",
-                    "NSC",
-                    "CLR",
-                    "NCD"
-                };
-                return list;
-            }
-
-            const QHash<QString, CCloudLayer::Coverage> &getCoverage() const
-            {
-                static const QHash<QString, CCloudLayer::Coverage> hash =
-                {
-                    { "///", CCloudLayer::None },
-                    { "FEW", CCloudLayer::Few },
-                    { "SCT", CCloudLayer::Scattered },
-                    { "BKN", CCloudLayer::Broken },
-                    { "OVC", CCloudLayer::Overcast }
-                };
-                return hash;
-            }
-
             virtual bool isRepeatable() const override { return true; }
 
             const QRegularExpression &getRegExp() const override
@@ -672,7 +681,7 @@ namespace BlackMisc
                 QString coverageAsString = match.captured("coverage");
                 QString baseAsString = match.captured("base");
                 Q_ASSERT(!coverageAsString.isEmpty() && !baseAsString.isEmpty());
-                Q_ASSERT(getCoverage().contains(coverageAsString));
+                Q_ASSERT(cloudCoverages().contains(coverageAsString));
                 if (baseAsString == "///") return true;
 
                 bool ok = false;
@@ -681,7 +690,7 @@ namespace BlackMisc
                 base *= 100;
                 if (!ok) return false;
 
-                CCloudLayer cloudLayer(CAltitude(base, CAltitude::AboveGround, CLengthUnit::ft()), {}, getCoverage().value(coverageAsString));
+                CCloudLayer cloudLayer(CAltitude(base, CAltitude::AboveGround, CLengthUnit::ft()), {}, cloudCoverages().value(coverageAsString));
                 metar.addCloudLayer(cloudLayer);
                 QString cb_tcu = match.captured("cb_tcu");
                 if (!cb_tcu.isEmpty()) { }
@@ -694,9 +703,9 @@ namespace BlackMisc
             QString getRegExpImpl() const
             {
                 // Clear sky
-                const QString clearSky = QString("(?<clear_sky>") + getClearSkyTokens().join('|') + QString(")");
+                const QString clearSky = QString("(?<clear_sky>") + clearSkyTokens().join('|') + QString(")");
                 // Cloud coverage.
-                const QString coverage = QString("(?<coverage>") + QStringList(getCoverage().keys()).join('|') + QString(")");
+                const QString coverage = QString("(?<coverage>") + QStringList(cloudCoverages().keys()).join('|') + QString(")");
                 // Cloud base
                 const QString base = QStringLiteral("(?<base>\\d{3}|///)");
                 // CB (Cumulonimbus) or TCU (Towering Cumulus) are appended to the cloud group without a space
@@ -950,6 +959,445 @@ namespace BlackMisc
             }
         };
 
+        //! Single pass METAR decoder working on a string view
+        //! \remark decodes the groups of the decoder parts above in the same order and with the same validation,
+        //!         but without regular expressions and without copying the remaining METAR after each group
+        class CMetarSinglePassDecoder
+        {
+        public:
+            //! Result of a group
+            enum Result
+            {
+                NoMatch, //!< group not found
+                Matched, //!< group found and consumed
+                Invalid  //!< group found, but invalid values
+            };
+
+            //! Constructor
+            //! \remark METAR has to be simplified as by QString::simplified
+            explicit CMetarSinglePassDecoder(QStringView metar) : m_metar(metar) {}
+
+            //! Decode
+            //! \return false if invalid, o_group is the failed group then
+            bool decode(CMetar &metar, QString &o_group)
+            {
+                // same order as in CMetarDecoder::allocateDecoders
+                this->reportType(metar);
+                if (this->airport(metar) != Matched) { o_group = QStringLiteral("Airport"); return false; }
+                if (this->dayTime(metar) != Matched) { o_group = QStringLiteral("DayTime"); return false; }
+                if (this->status(metar) == Invalid) { o_group = QStringLiteral("Status"); return false; }
+                this->wind(metar);
+                this->windDirectionVariations(metar);
+                if (this->visibility(metar) == Invalid) { o_group = QStringLiteral("Visibility"); return false; }
+                this->runwayVisualRange();
+                while (this->presentWeather(metar) == Matched) {}
+                while (this->cloud(metar) == Matched) {}
+                this->verticalVisibility();
+                this->temperature(metar);
+                this->pressure(metar);
+
+                // QFE, recent weather and wind shear are matched by the decoder parts, but not set in the METAR
+                return true;
+            }
+
+        private:
+            Result reportType(CMetar &metar)
+            {
+                const CMetar::ReportType *type = findToken(reportTypes(), this->token(m_pos, 5));
+                if (!type || !this->isChar(m_pos + 5, ' ')) { return NoMatch; }
+                metar.setReportType(*type);
+                return this->consume(6);
+            }
+
+            Result airport(CMetar &metar)
+            {
+                for (int i = 0; i < 4; i++)
+                {
+                    if (!this->isWordChar(m_pos + i)) { return NoMatch; }
+                }
+                if (!this->isChar(m_pos + 4, ' ')) { return NoMatch; }
+                metar.setAirportIcaoCode(CAirportIcaoCode(this->token(m_pos, 4).toString()));
+                return this->consume(5);
+            }
+
+            Result dayTime(CMetar &metar)
+            {
+                if (this->digits(m_pos, 6) < 6 || !this->isChar(m_pos + 6, 'Z') || !this->isChar(m_pos + 7, ' ')) { return NoMatch; }
+                const int day = this->number(m_pos, 2);
+                const int hour = this->number(m_pos + 2, 2);
+                const int minute = this->number(m_pos + 4, 2);
+                if (day < 1 || day > 31 || hour > 23 || minute > 59) { return Invalid; }
+                metar.setDayTime(day, CTime(hour, minute, 0));
+                return this->consume(8);
+            }
+
+            Result status(CMetar &metar)
+            {
+                int length = 0;
+                while (this->isUpper(m_pos + length)) { length++; }
+                if (length < 1 || !this->isChar(m_pos + length, ' ')) { return NoMatch; }
+                if (length == 4 && this->isToken(m_pos, "AUTO")) { metar.setAutomated(true); }
+                else if (length != 3) { return Invalid; } // NIL or correction indicator
+                return this->consume(length + 1);
+            }
+
+            Result wind(CMetar &metar)
+            {
+                int pos = m_pos;
+                int direction = 0;
+                const bool directionVariable = this->isToken(pos, "VRB");
+                const bool noDirection = this->isToken(pos, "///");
+                if (this->digits(pos, 3) == 3) { direction = this->number(pos, 3); }
+                else if (!directionVariable && !noDirection) { return NoMatch; }
+                pos += 3;
+
+                // 2 or 3 digits, a longer number never matches
+                int speed = 0;
+                const int speedDigits = this->digits(pos, 4);
+                const bool noSpeed = speedDigits == 0 && this->isToken(pos, "//");
+                if (speedDigits == 2 || speedDigits == 3) { speed = this->number(pos, speedDigits); pos += speedDigits; }
+                else if (noSpeed) { pos += 2; }
+                else { return NoMatch; }
+
+                int gustSpeed = 0;
+                if (this->isChar(pos, 'G'))
+                {
+                    const int gustDigits = this->digits(pos + 1, 4);
+                    if (gustDigits != 2 && gustDigits != 3) { return NoMatch; }
+                    gustSpeed = this->number(pos + 1, gustDigits);
+                    pos += 1 + gustDigits;
+                }
+
+                const CSpeedUnit *unit = findToken(windUnits(), this->token(pos, 2));
+                if (unit) { pos += 2; }
+                else
+                {
+                    unit = findToken(windUnits(), this->token(pos, 3));
+                    if (!unit) { return NoMatch; }
+                    pos += 3;
+                }
+                if (this->isChar(pos, ' ')) { pos++; }
+                m_pos = pos;
+                if (noDirection || noSpeed) { return Matched; }
+
+                CWindLayer windLayer(CAltitude(0, CAltitude::AboveGround, CLengthUnit::ft()), CAngle(direction, CAngleUnit::deg()), CSpeed(speed, *unit), CSpeed(gustSpeed, *unit));
+                windLayer.setDirectionVariable(directionVariable);
+                metar.setWindLayer(windLayer);
+                return Matched;
+            }
+
+            Result windDirectionVariations(CMetar &metar)
+            {
+                if (this->digits(m_pos, 3) < 3 || !this->isChar(m_pos + 3, 'V') || this->digits(m_pos + 4, 3) < 3 || !this->isChar(m_pos + 7, ' ')) { return NoMatch; }
+                CWindLayer windLayer = metar.getWindLayer();
+                windLayer.setDirection(CAngle(this->number(m_pos, 3), CAngleUnit::deg()), CAngle(this->number(m_pos + 4, 3), CAngleUnit::deg()));
+                metar.setWindLayer(windLayer);
+                return this->consume(8);
+            }
+
+            Result visibility(CMetar &metar)
+            {
+                if (this->isToken(m_pos, "CAVOK "))
+                {
+                    metar.setCavok();
+                    return this->consume(6);
+                }
+
+                // European version, 4 digits in meters, optional NDV and cardinal direction
+                const bool noVisibility = this->isToken(m_pos, "////");
+                if (noVisibility || this->digits(m_pos, 4) == 4)
+                {
+                    int pos = m_pos + 4;
+                    if (this->isToken(pos, "NDV")) { pos += 3; }
+                    for (int length = 1; length <= 2 && !this->isChar(pos, ' '); length++)
+                    {
+                        if (this->isChar(pos + length, ' ') && findToken(cardinalDirections(), this->token(pos, length))) { pos += length; }
+                    }
+                    if (this->isChar(pos, ' '))
+                    {
+                        if (!noVisibility) { metar.setVisibility(CLength(this->number(m_pos, 4), CLengthUnit::m())); }
+                        return this->consume(pos + 1 - m_pos);
+                    }
+                }
+
+                // US/Canada version, e.g. "10SM", "1 1/2SM" or "M1/4SM"
+                // the optional parts are tried in the order the regular expression backtracks
+                for (int distanceDigits = this->digits(m_pos, 2); distanceDigits >= 0; distanceDigits--)
+                {
+                    const int afterDistance = m_pos + distanceDigits;
+                    for (int space = this->isChar(afterDistance, ' ') ? 1 : 0; space >= 0; space--)
+                    {
+                        const int afterSpace = afterDistance + space;
+                        for (int less = this->isChar(afterSpace, 'M') ? 1 : 0; less >= 0; less--)
+                        {
+                            const int afterLess = afterSpace + less;
+                            const bool hasFraction = this->isDigit(afterLess) && this->isChar(afterLess + 1, '/') && this->isDigit(afterLess + 2);
+                            for (int fraction = hasFraction ? 3 : 0; fraction >= 0; fraction -= 3)
+                            {
+                                const int unitPos = afterLess + fraction;
+                                const bool km = this->isToken(unitPos, "KM");
+                                if ((!km && !this->isToken(unitPos, "SM")) || !this->isChar(unitPos + 2, ' ')) { continue; }
+
+                                double visibility = distanceDigits > 0 ? this->number(m_pos, distanceDigits) : 0;
+                                if (fraction > 0)
+                                {
+                                    const int numerator = this->number(afterLess, 1);
+                                    const int denominator = this->number(afterLess + 2, 1);
+                                    if (denominator < 1 || numerator < 1) { return Invalid; }
+                                    visibility += static_cast<double>(numerator) / denominator;
+                                }
+                                metar.setVisibility(CLength(visibility, km ? CLengthUnit::km() : CLengthUnit::SM()));
+                                return this->consume(unitPos + 3 - m_pos);
+                            }
+                        }
+                    }
+                }
+                return NoMatch;
+            }
+
+            Result runwayVisualRange()
+            {
+                // not used yet, only skipped
+                int pos = m_pos;
+                if (!this->isChar(pos, 'R') || this->digits(pos + 1, 2) < 2) { return NoMatch; }
+                pos += 3;
+                while (this->isChar(pos, 'L') || this->isChar(pos, 'C') || this->isChar(pos, 'R')) { pos++; }
+                if (!this->isChar(pos, '/')) { return NoMatch; }
+                pos++;
+                if (this->isChar(pos, 'P') || this->isChar(pos, 'M')) { pos++; }
+                if (this->digits(pos, 4) < 4) { return NoMatch; }
+                pos += 4;
+                if (this->isChar(pos, 'V')) { pos++; }
+                if (this->digits(pos, 4) == 4) { pos += 4; }
+                if (this->isToken(pos, "FT")) { pos += 2; }
+                if (this->isChar(pos, '/')) { pos++; }
+                if (this->isChar(pos, 'D') || this->isChar(pos, 'N') || this->isChar(pos, 'U')) { pos++; }
+                if (!this->isChar(pos, ' ')) { return NoMatch; }
+                return this->consume(pos + 1 - m_pos);
+            }
+
+            Result presentWeather(CMetar &metar)
+            {
+                int pos = m_pos;
+                CPresentWeather::Intensity intensity = CPresentWeather::Moderate;
+                for (int length = 1; length <= 2; length++)
+                {
+                    const CPresentWeather::Intensity *i = findToken(intensities(), this->token(pos, length));
+                    if (i) { intensity = *i; pos += length; break; }
+                }
+
+                CPresentWeather::Descriptor descriptor = CPresentWeather::None;
+                const CPresentWeather::Descriptor *d = findToken(descriptors(), this->token(pos, 2));
+                if (d) { descriptor = *d; pos += 2; }
+
+                // up to 4 phenomena, only the first 2 are used as by the decoder part
+                int weatherPhenomena = 0;
+                for (int i = 0; i < 4; i++)
+                {
+                    const CPresentWeather::WeatherPhenomenon *phenomenon = findToken(phenomena(), this->token(pos, 2));
+                    if (!phenomenon) { break; }
+                    if (i < 2) { weatherPhenomena |= *phenomenon; }
+                    pos += 2;
+                }
+                if (!this->isChar(pos, ' ')) { return NoMatch; }
+
+                metar.addPresentWeather(CPresentWeather(intensity, descriptor, weatherPhenomena));
+                return this->consume(pos + 1 - m_pos);
+            }
+
+            Result cloud(CMetar &metar)
+            {
+                if (this->isChar(m_pos + 3, ' '))
+                {
+                    const QStringView clearSky = this->token(m_pos, 3);
+                    for (const QString &token : clearSkyTokens())
+                    {
+                        if (clearSky != QStringView(token)) { continue; }
+                        metar.removeAllClouds();
+                        return this->consume(4);
+                    }
+                }
+
+                const CCloudLayer::Coverage *coverage = findToken(cloudCoverages(), this->token(m_pos, 3));
+                if (!coverage) { return NoMatch; }
+                int pos = m_pos + 3;
+                const bool noBase = this->isToken(pos, "///");
+                if (!noBase && this->digits(pos, 3) < 3) { return NoMatch; }
+                const int base = noBase ? 0 : this->number(pos, 3) * 100;
+                pos += 3;
+                if (this->isToken(pos, "CB")) { pos += 2; }
+                else if (this->isToken(pos, "TCU") || this->isToken(pos, "///")) { pos += 3; }
+                if (!this->isChar(pos, ' ')) { return NoMatch; }
+                this->consume(pos + 1 - m_pos);
+                if (noBase) { return Matched; }
+
+                metar.addCloudLayer(CCloudLayer(CAltitude(base, CAltitude::AboveGround, CLengthUnit::ft()), {}, *coverage));
+                return Matched;
+            }
+
+            Result verticalVisibility()
+            {
+                // not used yet, only skipped
+                if (!this->isToken(m_pos, "VV")) { return NoMatch; }
+                if (this->digits(m_pos + 2, 3) < 3 && !this->isToken(m_pos + 2, "///")) { return NoMatch; }
+                if (!this->isChar(m_pos + 5, ' ')) { return NoMatch; }
+                return this->consume(6);
+            }
+
+            Result temperature(CMetar &metar)
+            {
+                int pos = m_pos;
+                int temperature = 0;
+                int dewPoint = 0;
+                bool noTemperature = false;
+                bool noDewPoint = false;
+                if (!this->temperatureValue(pos, temperature, noTemperature) || !this->isChar(pos, '/')) { return NoMatch; }
+                pos++;
+                if (!this->temperatureValue(pos, dewPoint, noDewPoint)) { return NoMatch; }
+                if (this->isChar(pos, ' ')) { pos++; }
+                m_pos = pos;
+                if (noTemperature || noDewPoint) { return Matched; }
+
+                metar.setTemperature(CTemperature(temperature, CTemperatureUnit::C()));
+                metar.setDewPoint(CTemperature(dewPoint, CTemperatureUnit::C()));
+                return Matched;
+            }
+
+            Result pressure(CMetar &metar)
+            {
+                // Q => QNH comes in hPa
+                // A => QNH comes in inches of Mercury
+                const bool hPa = this->isChar(m_pos, 'Q');
+                if (!hPa && !this->isChar(m_pos, 'A')) { return NoMatch; }
+                int pos = m_pos + 1;
+                const bool noPressure = this->isToken(pos, "////");
+                if (!noPressure && this->digits(pos, 4) < 4) { return NoMatch; }
+                double pressure = noPressure ? 0 : this->number(pos, 4);
+                pos += 4;
+                if (this->isChar(pos, ' ')) { pos++; }
+                m_pos = pos;
+                if (noPressure) { return Matched; }
+
+                if (!hPa) { pressure /= 100; }
+                metar.setAltimeter(CPressure(pressure, hPa ? CPressureUnit::hPa() : CPressureUnit::inHg()));
+                return Matched;
+            }
+
+            //! Temperature "M?\d{2}" or "//"
+            bool temperatureValue(int &pos, int &o_value, bool &o_null) const
+            {
+                o_null = this->isToken(pos, "//");
+                if (o_null) { pos += 2; return true; }
+                const int start = this->isChar(pos, 'M') ? pos + 1 : pos;
+                if (this->digits(start, 2) < 2) { return false; }
+                o_value = this->number(start, 2);
+                if (start > pos) { o_value *= -1; }
+                pos = start + 2;
+                return true;
+            }
+
+            //! Value of the token in a hash, nullptr if not contained
+            template <class T>
+            static const T *findToken(const QHash<QString, T> &hash, QStringView token)
+            {
+                if (token.isEmpty()) { return nullptr; }
+                for (auto it = hash.cbegin(); it != hash.cend(); ++it)
+                {
+                    if (QStringView(it.key()) == token) { return &it.value(); }
+                }
+                return nullptr;
+            }
+
+            //! Skip characters
+            Result consume(int length) { m_pos += length; return Matched; }
+
+            //! Character at position, null character beyond the end
+            QChar at(int pos) const { return pos < m_metar.size() ? m_metar.at(pos) : QChar(); }
+
+            //! Token of given length, empty if beyond the end
+            QStringView token(int pos, int length) const { return pos + length <= m_metar.size() ? m_metar.mid(pos, length) : QStringView(); }
+
+            //! Character at position?
+            bool isChar(int pos, char c) const { return this->at(pos).unicode() == static_cast<ushort>(c); }
+
+            //! Token at position?
+            bool isToken(int pos, const char *token) const
+            {
+                for (int i = 0; token[i]; i++)
+                {
+                    if (!this->isChar(pos + i, token[i])) { return false; }
+                }
+                return true;
+            }
+
+            //! Digit 0-9, as \d of the regular expressions
+            bool isDigit(int pos) const { const ushort c = this->at(pos).unicode(); return c >= '0' && c <= '9'; }
+
+            //! Upper case letter A-Z
+            bool isUpper(int pos) const { const ushort c = this->at(pos).unicode(); return c >= 'A' && c <= 'Z'; }
+
+            //! Word character, as \w of the regular expressions
+            bool isWordChar(int pos) const
+            {
+                const ushort c = this->at(pos).unicode();
+                return this->isDigit(pos) || this->isUpper(pos) || (c >= 'a' && c <= 'z') || c == '_';
+            }
+
+            //! Number of consecutive digits, max. given number
+            int digits(int pos, int max) const
+            {
+                int n = 0;
+                while (n < max && this->isDigit(pos + n)) { n++; }
+                return n;
+            }
+
+            //! Value of the digits
+            int number(int pos, int length) const
+            {
+                int value = 0;
+                for (int i = 0; i < length; i++) { value = value * 10 + (this->at(pos + i).unicode() - '0'); }
+                return value;
+            }
+
+            QStringView m_metar; //!< simplified METAR
+            int m_pos = 0;       //!< current position
+        };
+
+        namespace
+        {
+            //! Same as QString::simplified would return?
+            bool isSimplified(QStringView string)
+            {
+                if (string.isEmpty()) { return true; }
+                if (string.front().isSpace() || string.back().isSpace()) { return false; }
+                for (int i = 1; i < string.size(); i++)
+                {
+                    const QChar c = string.at(i);
+                    if (c.isSpace() && (c != ' ' || string.at(i - 1) == ' ')) { return false; }
+                }
+                return true;
+            }
+
+            //! Decode with CMetarSinglePassDecoder, the message is not set
+            bool decodeSinglePass(QStringView metarString, CMetar &o_metar)
+            {
+                // simplified copy only if needed, as the decoder parts always work on a simplified copy
+                QString simplified;
+                QStringView metarView = metarString;
+                if (!isSimplified(metarView))
+                {
+                    simplified = metarString.toString().simplified();
+                    metarView = simplified;
+                }
+
+                QString group;
+                CMetarSinglePassDecoder decoder(metarView);
+                if (decoder.decode(o_metar, group)) { return true; }
+                CLogMessage(static_cast<CMetarDecoder *>(nullptr)).debug() << "Invalid METAR:" << metarString.toString() << group;
+                return false;
+            }
+        }
+
         CMetarDecoder::CMetarDecoder()
         {
             allocateDecoders();
@@ -959,6 +1407,14 @@ namespace BlackMisc
         { }
 
         CMetar CMetarDecoder::decode(const QString &metarString) const
+        {
+            CMetar metar;
+            if (!decodeSinglePass(metarString, metar)) { return CMetar(); }
+            metar.setMessage(metarString);
+            return metar;
+        }
+
+        CMetar CMetarDecoder::decodeByRegularExpressions(const QString &metarString) const
         {
             CMetar metar;
             QString metarStringCopy = metarString.simplified();
@@ -977,6 +1433,70 @@ namespace BlackMisc
             return metar;
         }
 
+        CMetarList CMetarDecoder::decodeMetarFile(const QString &metarFile, int *invalidLines, const std::function<bool()> &isCancelled) const
+        {
+            // lines as views into the file
+            QVector<QStringView> lines;
+            const QStringView file(metarFile);
+            int start = 0;
+            while (start < file.size())
+            {
+                int end = metarFile.indexOf('\n', start);
+                if (end < 0) { end = static_cast<int>(file.size()); }
+                QStringView line = file.mid(start, end - start);
+                if (line.endsWith('\r')) { line.chop(1); }
+                if (!line.trimmed().isEmpty()) { lines.push_back(line); }
+                start = end + 1;
+            }
+
+            // results are written by position, so they are in order of the lines
+            const int count = lines.size();
+            const int chunkSize = 64;
+            QVector<CMetar> metars(count);
+            QVector<bool> valid(count, false);
+            CMetar *metarsData = metars.data();
+            bool *validData = valid.data();
+            const QStringView *linesData = lines.constData();
+            std::atomic_int next { 0 };
+            std::atomic_bool cancelled { false };
+            const QThread *callingThread = QThread::currentThread();
+
+            const auto decodeLines = [ & ]
+            {
+                const bool isCallingThread = QThread::currentThread() == callingThread;
+                // chunks of lines, so the workers rarely meet at the counter
+                for (int first = next.fetch_add(chunkSize); first < count; first = next.fetch_add(chunkSize))
+                {
+                    // the predicate is only called by the calling thread, the workers see the flag
+                    if (isCallingThread && isCancelled && isCancelled()) { cancelled = true; }
+                    if (cancelled) { return; }
+                    const int last = qMin(first + chunkSize, count);
+                    for (int i = first; i < last; i++)
+                    {
+                        validData[i] = decodeSinglePass(linesData[i], metarsData[i]);
+                        if (validData[i]) { metarsData[i].setMessage(linesData[i].toString()); }
+                    }
+                }
+            };
+
+            runInThreads(qBound(1, QThread::idealThreadCount(), (count + chunkSize - 1) / chunkSize), decodeLines);
+            if (cancelled)
+            {
+                if (invalidLines) { *invalidLines = 0; }
+                return {};
+            }
+
+            CMetarList decoded;
+            int invalid = 0;
+            for (int i = 0; i < count; i++)
+            {
+                if (valid[i]) { decoded.push_back(metars[i]); }
+                else { invalid++; }
+            }
+            if (invalidLines) { *invalidLines = invalid; }
+            return decoded;
+        }
+
         void CMetarDecoder::allocateDecoders()
         {
             m_decoders.clear();
@@ -13,9 +13,11 @@
 
 #include "blackmisc/blackmiscexport.h"
 #include "blackmisc/weather/metar.h"
+#include "blackmisc/weather/metarlist.h"
 
 #include <QObject>
 #include <QString>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -38,8 +40,22 @@ namespace BlackMisc
             virtual ~CMetarDecoder() override;
 
             //! Decode metar
+            //! \remark single pass over the METAR, same result as decodeByRegularExpressions
+            //! \threadsafe
             CMetar decode(const QString &metarString) const;
 
+            //! Decode metar by the regular expressions of the decoder parts
+            //! \remark former implementation, kept as reference for tests and benchmarks
+            CMetar decodeByRegularExpressions(const QString &metarString) const;
+
+            //! Decode a METAR file, one METAR per line
+            //! \remark lines are decoded in parallel, the METARs are in order of the lines
+            //! \remark empty lines are ignored, invalid lines are skipped and counted in invalidLines
+            //! \param isCancelled called by the calling thread between chunks of lines, decoding stops if it returns true
+            //! \return the METARs, empty if cancelled
+            //! \threadsafe
+            CMetarList decodeMetarFile(const QString &metarFile, int *invalidLines = nullptr, const std::function<bool()> &isCancelled = {}) const;
+
         private:
             void allocateDecoders();
             std::vector<std::unique_ptr<IMetarDecoderPart>> m_decoders;
@@ -44,6 +44,19 @@ namespace BlackSound
             return decoded;
         }
 
+        int COpusDecoder::decodeInto(const QByteArray &opusData, qint16 *pcm, int frameSize)
+        {
+            if (!m_opusDecoder) { return OPUS_INVALID_STATE; }
+            return opus_decode(m_opusDecoder, reinterpret_cast<const unsigned char *>(opusData.constData()), opusData.size(), pcm, frameSize, 0);
+        }
+
+        int COpusDecoder::decodeLost(const QByteArray &nextOpusData, qint16 *pcm, int frameSize)
+        {
+            if (!m_opusDecoder) { return OPUS_INVALID_STATE; }
+            if (nextOpusData.isEmpty()) { return opus_decode(m_opusDecoder, nullptr, 0, pcm, frameSize, 0); }
+            return opus_decode(m_opusDecoder, reinterpret_cast<const unsigned char *>(nextOpusData.constData()), nextOpusData.size(), pcm, frameSize, 1);
+        }
+
         void COpusDecoder::resetState()
         {
             if (!m_opusDecoder) { return; }
@@ -42,6 +42,17 @@ namespace BlackSound
             //! Decode
             QVector<qint16> decode(const QByteArray &opusData, int dataLength, int *decodedLength);
 
+            //! Decode into a buffer of the caller
+            //! \param pcm buffer with space for frameSize samples per channel
+            //! \return samples per channel, negative Opus error code on failure
+            int decodeInto(const QByteArray &opusData, qint16 *pcm, int frameSize);
+
+            //! Replacement for a lost frame of exactly frameSize samples per channel
+            //! \param nextOpusData packet following the lost one, its forward error correction (FEC) data is used,
+            //!        Opus packet loss concealment (PLC) if it has none or it is empty
+            //! \return samples per channel, negative Opus error code on failure
+            int decodeLost(const QByteArray &nextOpusData, qint16 *pcm, int frameSize);
+
             //! Reset
             void resetState();
 
@@ -36,5 +36,10 @@ namespace BlackSound
             encoded.truncate(length);
             return encoded;
         }
+
+        int COpusEncoder::encodeInto(const qint16 *pcmSamples, int samplesLength, char *encoded, int maxEncodedBytes)
+        {
+            return opus_encode(opusEncoder, reinterpret_cast<const opus_int16 *>(pcmSamples), samplesLength, reinterpret_cast<unsigned char *>(encoded), maxEncodedBytes);
+        }
     } // ns
 } // ns
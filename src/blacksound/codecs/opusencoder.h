@@ -43,6 +43,11 @@ namespace BlackSound
             //! Encode
             QByteArray encode(const QVector<qint16> &pcmSamples, int samplesLength, int *encodedLength);
 
+            //! Encode into a buffer of the caller
+            //! \param encoded buffer of maxEncodedBytes
+            //! \return encoded bytes, negative Opus error code on failure
+            int encodeInto(const qint16 *pcmSamples, int samplesLength, char *encoded, int maxEncodedBytes);
+
         private:
             OpusEncoder *opusEncoder = nullptr;
 
@@ -27,6 +27,9 @@ namespace BlackSound
             //! Transform
             float transform(float inSample);
 
+            //! Transform a block of samples in place
+            void transform(float *samples, int count);
+
             //! Set filter parameters
             //! @{
             void setCoefficients(double aa0, double aa1, double aa2, double b0, double b1, double b2);
@@ -0,0 +1,123 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "samplekernels.h"
+
+#include <QtGlobal>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define BLACKSOUND_SSE2
+#   include <emmintrin.h>
+#endif
+
+namespace BlackSound
+{
+    namespace Dsp
+    {
+        bool hasSimdSampleKernels()
+        {
+#ifdef BLACKSOUND_SSE2
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        void clearSamples(float *samples, int count)
+        {
+            if (count < 1) { return; }
+            std::memset(samples, 0, static_cast<size_t>(count) * sizeof(float));
+        }
+
+        void addSamples(float *out, const float *in, int count)
+        {
+            int i = 0;
+#ifdef BLACKSOUND_SSE2
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m128 a0 = _mm_loadu_ps(out + i);
+                const __m128 a1 = _mm_loadu_ps(out + i + 4);
+                const __m128 b0 = _mm_loadu_ps(in + i);
+                const __m128 b1 = _mm_loadu_ps(in + i + 4);
+                _mm_storeu_ps(out + i,     _mm_add_ps(a0, b0));
+                _mm_storeu_ps(out + i + 4, _mm_add_ps(a1, b1));
+            }
+#endif
+            for (; i < count; i++) { out[i] += in[i]; }
+        }
+
+        void applyGain(float *samples, float gain, int count)
+        {
+            int i = 0;
+#ifdef BLACKSOUND_SSE2
+            const __m128 g = _mm_set1_ps(gain);
+            for (; i + 8 <= count; i += 8)
+            {
+                _mm_storeu_ps(samples + i,     _mm_mul_ps(_mm_loadu_ps(samples + i), g));
+                _mm_storeu_ps(samples + i + 4, _mm_mul_ps(_mm_loadu_ps(samples + i + 4), g));
+            }
+#endif
+            for (; i < count; i++) { samples[i] *= gain; }
+        }
+
+        float peakSample(const float *samples, int count)
+        {
+            int i = 0;
+            float peak = 0.0f;
+#ifdef BLACKSOUND_SSE2
+            const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+            __m128 max = _mm_setzero_ps();
+            for (; i + 4 <= count; i += 4)
+            {
+                max = _mm_max_ps(max, _mm_and_ps(_mm_loadu_ps(samples + i), absMask));
+            }
+            alignas(16) float lanes[4];
+            _mm_store_ps(lanes, max);
+            peak = qMax(qMax(lanes[0], lanes[1]), qMax(lanes[2], lanes[3]));
+#endif
+            for (; i < count; i++) { peak = qMax(peak, std::abs(samples[i])); }
+            return peak;
+        }
+
+        int applyGainWithPeak(qint16 *samples, float gain, int count)
+        {
+            int i = 0;
+            int peak = 0;
+#ifdef BLACKSOUND_SSE2
+            const __m128 g = _mm_set1_ps(gain);
+            const __m128i zero = _mm_setzero_si128();
+            __m128i max = zero;
+            for (; i + 8 <= count; i += 8)
+            {
+                __m128i *block = reinterpret_cast<__m128i *>(samples + i);
+                const __m128i in = _mm_loadu_si128(block);
+                const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(in, in), 16); // sign extended to 32bit
+                const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(in, in), 16);
+                const __m128i loGain = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(lo), g));
+                const __m128i hiGain = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(hi), g));
+                const __m128i out = _mm_packs_epi32(loGain, hiGain); // saturated to 16bit
+                _mm_storeu_si128(block, out);
+                max = _mm_max_epi16(max, _mm_max_epi16(out, _mm_subs_epi16(zero, out))); // -32768 saturates to 32767
+            }
+            alignas(16) qint16 lanes[8];
+            _mm_store_si128(reinterpret_cast<__m128i *>(lanes), max);
+            for (const qint16 lane : lanes) { peak = qMax(peak, static_cast<int>(lane)); }
+#endif
+            for (; i < count; i++)
+            {
+                // lrint rounds like _mm_cvtps_epi32, so the result does not depend on the code path
+                const long value = qBound(-32768L, std::lrint(samples[i] * gain), 32767L);
+                samples[i] = static_cast<qint16>(value);
+                peak = qMax(peak, static_cast<int>(qMin(qAbs(value), 32767L)));
+            }
+            return peak;
+        }
+    } // ns
+} // ns
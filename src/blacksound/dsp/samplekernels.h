@@ -0,0 +1,48 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKSOUND_DSP_SAMPLEKERNELS_H
+#define BLACKSOUND_DSP_SAMPLEKERNELS_H
+
+#include "blacksound/blacksoundexport.h"
+
+#include <QtGlobal>
+
+namespace BlackSound
+{
+    namespace Dsp
+    {
+        //! Vectorized kernels working on sample buffers
+        //! \remark SSE2 if available (always on x86_64), scalar fallback otherwise
+        //! @{
+
+        //! Is a SIMD implementation used?
+        BLACKSOUND_EXPORT bool hasSimdSampleKernels();
+
+        //! Set count samples to 0
+        BLACKSOUND_EXPORT void clearSamples(float *samples, int count);
+
+        //! Mix: out[i] += in[i]
+        BLACKSOUND_EXPORT void addSamples(float *out, const float *in, int count);
+
+        //! Gain: samples[i] *= gain
+        BLACKSOUND_EXPORT void applyGain(float *samples, float gain, int count);
+
+        //! Maximum absolute sample value (peak)
+        BLACKSOUND_EXPORT float peakSample(const float *samples, int count);
+
+        //! Gain of 16bit samples in one pass with their peak: samples[i] = round(samples[i] * gain), saturated
+        //! \return maximum absolute sample value after the gain, 0..32767
+        BLACKSOUND_EXPORT int applyGainWithPeak(qint16 *samples, float gain, int count);
+        //! @}
+    } // ns
+} // ns
+
+#endif // guard
@@ -2,6 +2,7 @@
 #include "blacksound/audioutilities.h"
 
 #include <QDebug>
+#include <algorithm>
 
 namespace BlackSound
 {
@@ -28,9 +29,15 @@ namespace BlackSound
         }
 
         int CBufferedWaveProvider::readSamples(QVector<float> &samples, qint64 count)
+        {
+            return this->readSamplesIntoVector(samples, count);
+        }
+
+        int CBufferedWaveProvider::readSamplesInto(float *samples, qint64 count)
         {
             const int len = static_cast<int>(qMin(count, static_cast<qint64>(m_audioBuffer.size())));
-            samples = m_audioBuffer.mid(0, len);
+            if (len < 1) { return 0; }
+            std::copy(m_audioBuffer.constBegin(), m_audioBuffer.constBegin() + len, samples);
             // if (len != 0) qDebug() << "Reading" << count << "samples." << m_audioBuffer.size() << "currently in the buffer.";
             m_audioBuffer.remove(0, len);
             return len;
@@ -37,6 +37,9 @@ namespace BlackSound
             //! ISampleProvider::readSamples
             virtual int readSamples(QVector<float> &samples, qint64 count) override;
 
+            //! ISampleProvider::readSamplesInto
+            virtual int readSamplesInto(float *samples, qint64 count) override;
+
             //! Bytes from buffer
             int getBufferedBytes() const { return m_audioBuffer.size(); }
 
@@ -1,5 +1,6 @@
 #include "equalizersampleprovider.h"
 #include "blacksound/audioutilities.h"
+#include "blacksound/dsp/samplekernels.h"
 #include <QDebug>
 
 using namespace BlackSound::Dsp;
@@ -21,17 +22,20 @@ namespace BlackSound
 
         int CEqualizerSampleProvider::readSamples(QVector<float> &samples, qint64 count)
         {
-            const int samplesRead = m_sourceProvider->readSamples(samples, count);
+            return this->readSamplesIntoVector(samples, count);
+        }
+
+        int CEqualizerSampleProvider::readSamplesInto(float *samples, qint64 count)
+        {
+            const int samplesRead = m_sourceProvider->readSamplesInto(samples, count);
             if (m_bypass) return samplesRead;
 
-            for (int n = 0; n < samplesRead; n++)
+            // band by band over the whole block, same result as sample by sample as the filters are cascaded
+            for (int band = 0; band < m_filters.size(); band++)
             {
-                for (int band = 0; band < m_filters.size(); band++)
-                {
-                    samples[n] = m_filters[band].transform(samples[n]);
-                }
-                samples[n] *= static_cast<float>(m_outputGain);
+                m_filters[band].transform(samples, samplesRead);
             }
+            applyGain(samples, static_cast<float>(m_outputGain), samplesRead);
             return samplesRead;
         }
 
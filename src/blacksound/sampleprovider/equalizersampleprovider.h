@@ -40,6 +40,9 @@ namespace BlackSound
             //! \copydoc ISampleProvider::readSamples
             virtual int readSamples(QVector<float> &samples, qint64 count) override;
 
+            //! \copydoc ISampleProvider::readSamplesInto
+            virtual int readSamplesInto(float *samples, qint64 count) override;
+
             //! Bypassing?
             void setBypassEffects(bool value) { m_bypass = value; }
 
@@ -7,9 +7,11 @@
  */
 
 #include "mixingsampleprovider.h"
+#include "blacksound/dsp/samplekernels.h"
 #include "blackmisc/metadatautils.h"
 
 using namespace BlackMisc;
+using namespace BlackSound::Dsp;
 
 namespace BlackSound
 {
@@ -32,21 +34,26 @@ namespace BlackSound
 
         int CMixingSampleProvider::readSamples(QVector<float> &samples, qint64 count)
         {
-            samples.clear();
-            samples.fill(0, static_cast<int>(count));
+            // all count samples are valid (silence filled)
+            samples.resize(static_cast<int>(count));
+            return this->readSamplesInto(samples.data(), count);
+        }
+
+        int CMixingSampleProvider::readSamplesInto(float *samples, qint64 count)
+        {
+            const int c = static_cast<int>(count);
+            clearSamples(samples, c);
             int outputLen = 0;
 
-            QVector<ISampleProvider *> finishedProviders;
+            // one buffer for all sources, capacity is kept between calls
+            float *sourceBuffer = this->scratchBuffer(count).data();
+
+            QVector<ISampleProvider *> finishedProviders; // no allocation unless used
             for (int i = 0; i < m_sources.size(); i++)
             {
                 ISampleProvider *sampleProvider = m_sources.at(i);
-                QVector<float> sourceBuffer;
-
-                const int len = sampleProvider->readSamples(sourceBuffer, count);
-                for (int n = 0; n < len; n++)
-                {
-                    samples[n] += sourceBuffer[n];
-                }
+                const int len = sampleProvider->readSamplesInto(sourceBuffer, count);
+                addSamples(samples, sourceBuffer, len);
 
                 outputLen = qMax(len, outputLen);
                 if (sampleProvider->isFinished())
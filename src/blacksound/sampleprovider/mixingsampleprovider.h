@@ -33,6 +33,9 @@ namespace BlackSound
             //! \copydoc ISampleProvider::readSamples
             virtual int readSamples(QVector<float> &samples, qint64 count) override;
 
+            //! \copydoc ISampleProvider::readSamplesInto
+            virtual int readSamplesInto(float *samples, qint64 count) override;
+
         private:
             QVector<ISampleProvider *> m_sources;
         };
@@ -0,0 +1,44 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "sampleprovider.h"
+#include "blacksound/dsp/samplekernels.h"
+
+#include <algorithm>
+
+namespace BlackSound
+{
+    namespace SampleProvider
+    {
+        int ISampleProvider::readSamplesInto(float *samples, qint64 count)
+        {
+            QVector<float> &buffer = this->scratchBuffer(count);
+            const int len = qMin(this->readSamples(buffer, count), buffer.size());
+            if (len < 1) { return 0; }
+            std::copy(buffer.constBegin(), buffer.constBegin() + len, samples);
+            return len;
+        }
+
+        QVector<float> &ISampleProvider::scratchBuffer(qint64 count)
+        {
+            const int c = static_cast<int>(count);
+            if (m_scratchBuffer.capacity() < c) { m_scratchBuffer.reserve(c); }
+            m_scratchBuffer.resize(c); // no allocation if capacity is sufficient
+            return m_scratchBuffer;
+        }
+
+        int ISampleProvider::readSamplesIntoVector(QVector<float> &samples, qint64 count)
+        {
+            const int c = static_cast<int>(count);
+            samples.resize(c); // no allocation if capacity is sufficient
+            const int len = qBound(0, this->readSamplesInto(samples.data(), count), c);
+            Dsp::clearSamples(samples.data() + len, c - len); // count samples as before, the rest is silence
+            return len;
+        }
+    } // ns
+} // ns
@@ -33,14 +33,34 @@ namespace BlackSound
             virtual ~ISampleProvider() override {}
 
             //! Read samples
+            //! \return number of samples read, samples has count elements, those not read are silence
             virtual int readSamples(QVector<float> &samples, qint64 count) = 0;
 
+            //! Read samples into a buffer provided by the caller
+            //! \param samples buffer with space for at least count samples
+            //! \param count   number of requested samples
+            //! \return number of samples written, the rest of the buffer is undefined
+            //! \remark The default implementation bridges to the QVector based version using a scratch buffer
+            //!         owned by the provider. Providers in the audio processing chain override it and work in place,
+            //!         so no memory is allocated on the audio thread.
+            virtual int readSamplesInto(float *samples, qint64 count);
+
             //! Finished?
             virtual bool isFinished() const { return false; }
 
         protected:
             //! Verbose logs?
             bool static verbose() { return BlackConfig::CBuildConfig::isLocalDeveloperDebugBuild(); }
+
+            //! Scratch buffer owned by this provider, capacity is kept between the calls
+            QVector<float> &scratchBuffer(qint64 count);
+
+            //! Implement the QVector based version by the buffer based one
+            //! \remark samples is resized to count, the samples not read are set to 0
+            int readSamplesIntoVector(QVector<float> &samples, qint64 count);
+
+        private:
+            QVector<float> m_scratchBuffer; //!< reused buffer
         };
 
     } // ns
@@ -6,6 +6,7 @@ SOURCES += \
     $$files($$PWD/sampleprovider/resourcesound.cpp) \
     $$files($$PWD/sampleprovider/resourcesoundsampleprovider.cpp) \
     $$files($$PWD/sampleprovider/samples.cpp) \
+    $$files($$PWD/sampleprovider/sampleprovider.cpp) \
     $$files($$PWD/sampleprovider/sawtoothgenerator.cpp) \
     $$files($$PWD/sampleprovider/simplecompressoreffect.cpp) \
 
@@ -33,14 +33,19 @@ namespace BlackSound
 
         int CSimpleCompressorEffect::readSamples(QVector<float> &samples, qint64 count)
         {
-            int samplesRead = m_sourceStream->readSamples(samples, count);
+            return this->readSamplesIntoVector(samples, count);
+        }
+
+        int CSimpleCompressorEffect::readSamplesInto(float *samples, qint64 count)
+        {
+            const int samplesRead = m_sourceStream->readSamplesInto(samples, count);
 
             if (m_enabled)
             {
                 for (int sample = 0; sample < samplesRead; sample += m_channels)
                 {
-                    double in1 = samples.at(sample);
-                    double in2 = (m_channels == 1) ? 0 : samples.at(sample + 1);
+                    double in1 = samples[sample];
+                    double in2 = (m_channels == 1) ? 0 : samples[sample + 1];
                     m_simpleCompressor.process(in1, in2);
                     samples[sample] = static_cast<float>(in1);
                     if (m_channels > 1)
@@ -34,6 +34,9 @@ namespace BlackSound
             //! \copydoc ISampleProvider::readSamples
             virtual int readSamples(QVector<float> &samples, qint64 count) override;
 
+            //! \copydoc ISampleProvider::readSamplesInto
+            virtual int readSamplesInto(float *samples, qint64 count) override;
+
             //! Enable
             void setEnabled(bool enabled);
 
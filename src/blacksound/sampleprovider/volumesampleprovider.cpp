@@ -9,9 +9,11 @@
 //! \file
 
 #include "volumesampleprovider.h"
+#include "blacksound/dsp/samplekernels.h"
 #include "blackmisc/metadatautils.h"
 
 using namespace BlackMisc;
+using namespace BlackSound::Dsp;
 
 namespace BlackSound
 {
@@ -28,13 +30,15 @@ namespace BlackSound
 
         int CVolumeSampleProvider::readSamples(QVector<float> &samples, qint64 count)
         {
-            const int samplesRead = m_sourceProvider->readSamples(samples, count);
+            return this->readSamplesIntoVector(samples, count);
+        }
+
+        int CVolumeSampleProvider::readSamplesInto(float *samples, qint64 count)
+        {
+            const int samplesRead = m_sourceProvider->readSamplesInto(samples, count);
             if (!qFuzzyCompare(m_gainRatio, 1.0))
             {
-                for (int n = 0; n < samplesRead; n++)
-                {
-                    samples[n] = static_cast<float>(m_gainRatio * samples[n]);
-                }
+                applyGain(samples, static_cast<float>(m_gainRatio), samplesRead);
             }
             return samplesRead;
         }
@@ -30,6 +30,9 @@ namespace BlackSound
             //! \copydoc ISampleProvider::readSamples
             virtual int readSamples(QVector<float> &samples, qint64 count) override;
 
+            //! \copydoc ISampleProvider::readSamplesInto
+            virtual int readSamplesInto(float *samples, qint64 count) override;
+
             //! Gain ratio, value a amplitude need to be multiplied with
             //! \see http://www.sengpielaudio.com/calculator-amplification.htm
             //! \remark gain ratio is voltage ratio/or amplitude ratio, something between 0.001-7.95 for -60dB to 80dB
@@ -558,6 +558,7 @@ namespace BlackSimPlugin
             const bool updateAllAircraft = this->isUpdateAllRemoteAircraft(now);
             int aircraftNumber = 0;
 
+            m_interpolationBatch.clear();
             for (const CSimulatedAircraft &aircraft : m_renderedAircraft)
             {
                 const CCallsign callsign = aircraft.getCallsign();
@@ -565,7 +566,11 @@ namespace BlackSimPlugin
                 const CInterpolationAndRenderingSetupPerCallsign setup = this->getInterpolationSetupConsolidated(callsign, updateAllAircraft);
                 CInterpolatorMulti *im = m_interpolators[callsign];
                 Q_ASSERT_X(im, Q_FUNC_INFO, "interpolator missing");
-                const CInterpolationResult result = im->getInterpolation(now, setup, aircraftNumber++);
+                m_interpolationBatch.add(im, setup, aircraftNumber++);
+            }
+
+            for (const CInterpolationResult &result : m_interpolationBatch.interpolate(now))
+            {
                 const CAircraftSituation s = result;
                 const CAircraftParts p = result;
                 m_countInterpolatedParts++;
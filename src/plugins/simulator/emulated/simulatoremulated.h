@@ -14,6 +14,7 @@
 #include "../plugincommon/simulatorplugincommon.h"
 #include "blackmisc/aviation/comsystem.h"
 #include "blackmisc/simulation/interpolatormulti.h"
+#include "blackmisc/simulation/interpolationbatch.h"
 #include "blackmisc/simulation/interpolationrenderingsetup.h"
 #include "blackmisc/simulation/interpolationlogger.h"
 #include "blackmisc/simulation/simulatorplugininfo.h"
@@ -188,6 +189,7 @@ namespace BlackSimPlugin
             BlackMisc::CConnectionGuard                     m_connectionGuard;  //!< connected with provider
             BlackMisc::CSettingReadOnly<BlackMisc::Simulation::Settings::TSwiftPlugin> m_pluginSettings { this, &CSimulatorEmulated::onSettingsChanged };
             QMap<BlackMisc::Aviation::CCallsign, BlackMisc::Simulation::CInterpolatorMultiWrapper> m_interpolators; //!< interpolators per callsign
+            BlackMisc::Simulation::CInterpolationBatch m_interpolationBatch; //!< interpolation of all remote aircraft in updateRemoteAircraft
         };
 
         //! Listener for swift
@@ -639,6 +639,9 @@ namespace BlackSimPlugin
             int aircraftNumber = 0;
             const bool updateAllAircraft = this->isUpdateAllRemoteAircraft(currentTimestamp);
             const CCallsignSet callsignsInRange = this->getAircraftInRangeCallsigns();
+            QVector<const CFlightgearMPAircraft *> batchAircraft;
+            batchAircraft.reserve(m_flightgearAircraftObjects.size());
+            m_interpolationBatch.clear();
             for (const CFlightgearMPAircraft &flightgearAircraft : m_flightgearAircraftObjects)
             {
                 const CCallsign callsign(flightgearAircraft.getCallsign());
@@ -653,17 +656,27 @@ namespace BlackSimPlugin
                 // skip no longer in range
                 if (!callsignsInRange.contains(callsign)) { continue; }
 
+                // setup
+                const CInterpolationAndRenderingSetupPerCallsign setup = this->getInterpolationSetupConsolidated(callsign, updateAllAircraft);
+                m_interpolationBatch.add(flightgearAircraft.getInterpolator(), setup, aircraftNumber++);
+                batchAircraft.push_back(&flightgearAircraft);
+            }
+
+            // interpolated situations/parts of all aircraft
+            const QVector<CInterpolationResult> &results = m_interpolationBatch.interpolate(currentTimestamp);
+            for (int i = 0; i < batchAircraft.size(); i++)
+            {
+                const CFlightgearMPAircraft &flightgearAircraft = *batchAircraft[i];
+                const CCallsign callsign(flightgearAircraft.getCallsign());
+
                 planesTransponders.callsigns.push_back(callsign.asString());
                 planesTransponders.codes.push_back(flightgearAircraft.getAircraft().getTransponderCode());
                 CTransponder::TransponderMode transponderMode = flightgearAircraft.getAircraft().getTransponderMode();
                 planesTransponders.idents.push_back(transponderMode == CTransponder::StateIdent);
                 planesTransponders.modeCs.push_back(transponderMode == CTransponder::ModeC);
 
-                // setup
-                const CInterpolationAndRenderingSetupPerCallsign setup = this->getInterpolationSetupConsolidated(callsign, updateAllAircraft);
-
                 // interpolated situation/parts
-                const CInterpolationResult result = flightgearAircraft.getInterpolation(currentTimestamp, setup, aircraftNumber++);
+                const CInterpolationResult &result = results[i];
                 if (result.getInterpolationStatus().hasValidSituation())
                 {
                     const CAircraftSituation interpolatedSituation(result);
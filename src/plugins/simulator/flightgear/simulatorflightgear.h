@@ -16,6 +16,7 @@
 #include "plugins/simulator/plugincommon/simulatorplugincommon.h"
 #include "blackmisc/simulation/aircraftmodellist.h"
 #include "blackmisc/simulation/data/modelcaches.h"
+#include "blackmisc/simulation/interpolationbatch.h"
 #include "blackmisc/simulation/settings/simulatorsettings.h"
 #include "blackmisc/simulation/settings/fgswiftbussettings.h"
 #include "blackmisc/simulation/simulatedaircraftlist.h"
@@ -232,6 +233,7 @@ namespace BlackSimPlugin
             QHash<BlackMisc::Aviation::CCallsign, qint64> m_addingInProgressAircraft; //!< aircraft just adding
             BlackMisc::Simulation::CSimulatedAircraftList m_aircraftAddedFailed; //! aircraft for which adding failed
             CFlightgearMPAircraftObjects m_flightgearAircraftObjects; //!< Flightgear multiplayer aircraft
+            BlackMisc::Simulation::CInterpolationBatch m_interpolationBatch; //!< interpolation of all remote aircraft in updateRemoteAircraft
             FlightgearData m_flightgearData; //!< Flightgear data
 
             // statistics
@@ -1963,6 +1963,9 @@ namespace BlackSimPlugin
             int simObjectNumber = 0;
             const bool traceSendId       = this->isTracingSendId();
             const bool updateAllAircraft = this->isUpdateAllRemoteAircraft(currentTimestamp);
+            QVector<CSimConnectObject> readySimObjects;
+            readySimObjects.reserve(simObjects.size());
+            m_interpolationBatch.clear();
             for (const CSimConnectObject &simObject : simObjects)
             {
                 // happening if aircraft is not yet added to simulator or to be deleted
@@ -1975,17 +1978,25 @@ namespace BlackSimPlugin
                 BLACK_VERIFY_X(hasCs, Q_FUNC_INFO, "missing callsign");
                 BLACK_AUDIT_X(hasValidIds, Q_FUNC_INFO, "Missing ids");
                 if (!hasCs || !hasValidIds) { continue; } // not supposed to happen
-                const DWORD objectId = simObject.getObjectId();
 
                 // setup
+                // simObjectNumber is passed to equally distributed steps like guessing parts
                 const CInterpolationAndRenderingSetupPerCallsign setup = this->getInterpolationSetupConsolidated(callsign, updateAllAircraft);
-                const bool sendGround = setup.isSendingGndFlagToSimulator();
+                m_interpolationBatch.add(simObject.getInterpolator(), setup, simObjectNumber++);
+                readySimObjects.push_back(simObject);
+            }
 
-                // Interpolated situation
-                // simObjectNumber is passed to equally distributed steps like guessing parts
-                const bool slowUpdate = (((m_statsUpdateAircraftRuns + simObjectNumber) % 40) == 0);
-                const CInterpolationResult result = simObject.getInterpolation(currentTimestamp, setup, simObjectNumber++);
-                const bool forceUpdate = slowUpdate || updateAllAircraft || setup.isForcingFullInterpolation();
+            // Interpolated situations of all aircraft
+            const QVector<CInterpolationResult> &results = m_interpolationBatch.interpolate(currentTimestamp);
+            for (int i = 0; i < readySimObjects.size(); i++)
+            {
+                const CSimConnectObject &simObject = readySimObjects[i];
+                const CInterpolationResult &result = results[i];
+                const DWORD objectId = simObject.getObjectId();
+                const bool sendGround = m_interpolationBatch.getSetup(i).isSendingGndFlagToSimulator();
+
+                const bool slowUpdate = (((m_statsUpdateAircraftRuns + i) % 40) == 0);
+                const bool forceUpdate = slowUpdate || updateAllAircraft || m_interpolationBatch.getSetup(i).isForcingFullInterpolation();
                 if (result.getInterpolationStatus().hasValidSituation())
                 {
                     // update situation
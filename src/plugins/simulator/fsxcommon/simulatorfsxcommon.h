@@ -18,6 +18,7 @@
 #include "plugins/simulator/fscommon/simulatorfscommon.h"
 #include "blackcore/simulator.h"
 #include "blackmisc/simulation/interpolatorlinear.h"
+#include "blackmisc/simulation/interpolationbatch.h"
 #include "blackmisc/simulation/simulatorplugininfo.h"
 #include "blackmisc/simulation/settings/simulatorsettings.h"
 #include "blackmisc/simulation/aircraftmodel.h"
@@ -332,6 +333,7 @@ namespace BlackSimPlugin
             HANDLE m_hSimConnect = nullptr;                                     //!< handle to SimConnect object
             DispatchProc m_dispatchProc = &CSimulatorFsxCommon::SimConnectProc; //!< called function for dispatch, can be overriden by specialized P3D function
             CSimConnectObjects m_simConnectObjects;                             //!< AI objects and their object and request ids
+            BlackMisc::Simulation::CInterpolationBatch m_interpolationBatch;    //!< interpolation of all remote aircraft in updateRemoteAircraft
 
             // probes
             bool m_useFsxTerrainProbe = is32bit(); //!< Use FSX Terrain probe?
@@ -63,6 +63,8 @@
 #include <QtGlobal>
 #include <QPointer>
 #include <QElapsedTimer>
+#include <limits>
+#include <cstdint>
 #include <math.h>
 
 using namespace BlackConfig;
@@ -500,6 +502,10 @@ namespace BlackSimPlugin
             connect(m_trafficProxy, &CXSwiftBusTrafficProxy::remoteAircraftAddingFailed, this, &CSimulatorXPlane::onRemoteAircraftAddingFailed);
             if (m_watcher) { m_watcher->setConnection(m_dBusConnection); }
             m_trafficProxy->removeAllPlanes();
+            m_planeIds.clear();
+
+            // frames only with the same layout on both sides
+            m_useTrafficFrames = m_serviceProxy->getCommitHash() == commitHash();
 
             // send the settings
             this->sendXSwiftBusSettings();
@@ -800,7 +806,7 @@ namespace BlackSimPlugin
                 m_trafficProxy->addPlane(callsign, aircraftModel.getModelString(),
                                          newRemoteAircraft.getAircraftIcaoCode().getDesignator(),
                                          newRemoteAircraft.getAirlineIcaoCode().getDesignator(),
-                                         livery);
+                                         livery, this->planeIdOrAssign(newRemoteAircraft.getCallsign()));
                 PlanesPositions pos;
                 pos.push_back(newRemoteAircraft.getSituation());
                 m_trafficProxy->setPlanesPositions(pos);
@@ -867,6 +873,7 @@ namespace BlackSimPlugin
             }
 
             m_trafficProxy->removePlane(callsign.asString());
+            m_planeIds.remove(callsign);
             m_xplaneAircraftObjects.remove(callsign);
             m_pendingToBeAddedAircraft.removeByCallsign(callsign);
 
@@ -1016,10 +1023,15 @@ namespace BlackSimPlugin
             PlanesPositions planesPositions;
             PlanesSurfaces planesSurfaces;
             PlanesTransponders planesTransponders;
+            PlanesFrame planesFrame;
+            if (m_useTrafficFrames) { planesFrame.records.reserve(static_cast<std::size_t>(m_xplaneAircraftObjects.size())); }
 
             int aircraftNumber = 0;
             const bool updateAllAircraft = this->isUpdateAllRemoteAircraft(currentTimestamp);
             const CCallsignSet callsignsInRange = this->getAircraftInRangeCallsigns();
+            QVector<const CXPlaneMPAircraft *> batchAircraft;
+            batchAircraft.reserve(m_xplaneAircraftObjects.size());
+            m_interpolationBatch.clear();
             for (const CXPlaneMPAircraft &xplaneAircraft : m_xplaneAircraftObjects)
             {
                 const CCallsign callsign(xplaneAircraft.getCallsign());
@@ -1034,17 +1046,41 @@ namespace BlackSimPlugin
                 // skip no longer in range
                 if (!callsignsInRange.contains(callsign)) { continue; }
 
-                planesTransponders.callsigns.push_back(callsign.asString());
-                planesTransponders.codes.push_back(xplaneAircraft.getAircraft().getTransponderCode());
-                CTransponder::TransponderMode transponderMode = xplaneAircraft.getAircraft().getTransponderMode();
-                planesTransponders.idents.push_back(transponderMode == CTransponder::StateIdent);
-                planesTransponders.modeCs.push_back(transponderMode == CTransponder::ModeC);
-
                 // setup
                 const CInterpolationAndRenderingSetupPerCallsign setup = this->getInterpolationSetupConsolidated(callsign, updateAllAircraft);
+                m_interpolationBatch.add(xplaneAircraft.getInterpolator(), setup, aircraftNumber++);
+                batchAircraft.push_back(&xplaneAircraft);
+            }
+
+            // interpolated situations/parts of all aircraft
+            const QVector<CInterpolationResult> &results = m_interpolationBatch.interpolate(currentTimestamp);
+            for (int i = 0; i < batchAircraft.size(); i++)
+            {
+                const CXPlaneMPAircraft &xplaneAircraft = *batchAircraft[i];
+                const CCallsign callsign(xplaneAircraft.getCallsign());
+
+                // frame record, only if XSwiftBus knows the plane id
+                const int planeId = m_useTrafficFrames ? m_planeIds.value(callsign, 0) : 0;
+                const bool useFrame = planeId > 0;
+                PlanesFrame::PlaneRecord record;
+                record.planeId = static_cast<std::uint32_t>(planeId);
+
+                const CTransponder::TransponderMode transponderMode = xplaneAircraft.getAircraft().getTransponderMode();
+                if (useFrame)
+                {
+                    PlanesFrame::setTransponder(record, xplaneAircraft.getAircraft().getTransponderCode(),
+                                                transponderMode == CTransponder::ModeC, transponderMode == CTransponder::StateIdent);
+                }
+                else
+                {
+                    planesTransponders.callsigns.push_back(callsign.asString());
+                    planesTransponders.codes.push_back(xplaneAircraft.getAircraft().getTransponderCode());
+                    planesTransponders.idents.push_back(transponderMode == CTransponder::StateIdent);
+                    planesTransponders.modeCs.push_back(transponderMode == CTransponder::ModeC);
+                }
 
                 // interpolated situation/parts
-                const CInterpolationResult result = xplaneAircraft.getInterpolation(currentTimestamp, setup, aircraftNumber++);
+                const CInterpolationResult &result = results[i];
                 if (result.getInterpolationStatus().hasValidSituation())
                 {
                     const CAircraftSituation interpolatedSituation(result);
@@ -1053,7 +1089,8 @@ namespace BlackSimPlugin
                     if (updateAllAircraft || !this->isEqualLastSent(interpolatedSituation))
                     {
                         this->rememberLastSent(interpolatedSituation);
-                        planesPositions.push_back(interpolatedSituation);
+                        if (useFrame) { PlanesFrame::setPosition(record, interpolatedSituation); }
+                        else { planesPositions.push_back(interpolatedSituation); }
                     }
                 }
                 else
@@ -1067,12 +1104,20 @@ namespace BlackSimPlugin
                     if (updateAllAircraft || !this->isEqualLastSent(parts, callsign))
                     {
                         this->rememberLastSent(parts, callsign);
-                        planesSurfaces.push_back(xplaneAircraft.getCallsign(), parts);
+                        if (useFrame) { PlanesFrame::setSurfaces(record, parts); }
+                        else { planesSurfaces.push_back(xplaneAircraft.getCallsign(), parts); }
                     }
                 }
 
+                if (useFrame) { planesFrame.push_back(record); }
+
             } // all callsigns
 
+            if (!planesFrame.isEmpty())
+            {
+                m_trafficProxy->setPlanesFrame(planesFrame.toByteArray());
+            }
+
             if (!planesTransponders.isEmpty())
             {
                 m_trafficProxy->setPlanesTransponders(planesTransponders);
@@ -1096,6 +1141,16 @@ namespace BlackSimPlugin
             this->finishUpdateRemoteAircraftAndSetStatistics(currentTimestamp);
         }
 
+        int CSimulatorXPlane::planeIdOrAssign(const CCallsign &callsign)
+        {
+            auto it = m_planeIds.constFind(callsign);
+            if (it != m_planeIds.cend()) { return it.value(); }
+            const int planeId = m_nextPlaneId;
+            m_nextPlaneId = m_nextPlaneId < std::numeric_limits<int>::max() ? m_nextPlaneId + 1 : 1;
+            m_planeIds.insert(callsign, planeId);
+            return planeId;
+        }
+
         void CSimulatorXPlane::requestRemoteAircraftDataFromXPlane()
         {
             if (this->isShuttingDownOrDisconnected()) { return; }
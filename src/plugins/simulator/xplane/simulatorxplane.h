@@ -16,6 +16,7 @@
 #include "plugins/simulator/plugincommon/simulatorplugincommon.h"
 #include "blackmisc/simulation/aircraftmodellist.h"
 #include "blackmisc/simulation/data/modelcaches.h"
+#include "blackmisc/simulation/interpolationbatch.h"
 #include "blackmisc/simulation/settings/simulatorsettings.h"
 #include "blackmisc/simulation/settings/xswiftbussettings.h"
 #include "blackmisc/simulation/simulatedaircraftlist.h"
@@ -194,6 +195,9 @@ namespace BlackSimPlugin
             //! \remark this is where the interpolated data are set
             void updateRemoteAircraft();
 
+            //! Plane id of an aircraft, assigned if there is none yet
+            int planeIdOrAssign(const BlackMisc::Aviation::CCallsign &callsign);
+
             //! Update airports
             void updateAirportsInRange();
 
@@ -270,11 +274,15 @@ namespace BlackSimPlugin
 
             BlackMisc::Aviation::CAirportList m_airportsInRange; //!< aiports in range of own aircraft
             CXPlaneMPAircraftObjects m_xplaneAircraftObjects;    //!< XPlane multiplayer aircraft
+            BlackMisc::Simulation::CInterpolationBatch m_interpolationBatch; //!< interpolation of all remote aircraft in updateRemoteAircraft
 
             BlackMisc::Simulation::CSimulatedAircraftList m_pendingToBeAddedAircraft;      //!< aircraft to be added
             QHash<BlackMisc::Aviation::CCallsign, qint64> m_addingInProgressAircraft;      //!< aircraft just adding
             BlackMisc::Simulation::CSimulatedAircraftList m_aircraftAddedFailed;           //!< aircraft for which adding failed
             BlackMisc::PhysicalQuantities::CLength m_minSuspicousTerrainProbe { nullptr }; //!< min. distance of "failed" (suspicious) terrain probe requests
+            QHash<BlackMisc::Aviation::CCallsign, int> m_planeIds; //!< plane ids of frames, assigned when adding
+            int  m_nextPlaneId = 1;          //!< next plane id, 0 means no id
+            bool m_useTrafficFrames = false; //!< XSwiftBus of the same version, understanding packed frames
             XPlaneData m_xplaneData; //!< XPlane data
 
             // statistics
@@ -94,9 +94,9 @@ namespace BlackSimPlugin
             m_dbusInterface->callDBus(QLatin1String("setMaxDrawDistance"), nauticalMiles);
         }
 
-        void CXSwiftBusTrafficProxy::addPlane(const QString &callsign, const QString &modelName, const QString &aircraftIcao, const QString &airlineIcao, const QString &livery)
+        void CXSwiftBusTrafficProxy::addPlane(const QString &callsign, const QString &modelName, const QString &aircraftIcao, const QString &airlineIcao, const QString &livery, int planeId)
         {
-            m_dbusInterface->callDBus(QLatin1String("addPlane"), callsign, modelName, aircraftIcao, airlineIcao, livery);
+            m_dbusInterface->callDBus(QLatin1String("addPlane"), callsign, modelName, aircraftIcao, airlineIcao, livery, planeId);
         }
 
         void CXSwiftBusTrafficProxy::removePlane(const QString &callsign)
@@ -136,6 +136,11 @@ namespace BlackSimPlugin
                                       planesTransponders.modeCs, planesTransponders.idents);
         }
 
+        void CXSwiftBusTrafficProxy::setPlanesFrame(const QByteArray &frame)
+        {
+            m_dbusInterface->callDBus(QLatin1String("setPlanesFrame"), frame);
+        }
+
         void CXSwiftBusTrafficProxy::setInterpolatorMode(const QString &callsign, bool spline)
         {
             m_dbusInterface->callDBus(QLatin1String("setInterpolatorMode"), callsign, spline);
@@ -16,11 +16,15 @@
 #include "blackmisc/aviation/aircraftparts.h"
 #include "blackmisc/aviation/callsign.h"
 #include "blackmisc/geo/elevationplane.h"
+#include "blackmisc/simulation/xplane/qtfreetrafficframe.h"
 #include "blackmisc/logcategorylist.h"
 
+#include <QByteArray>
 #include <QObject>
 #include <QString>
 #include <QStringList>
+#include <algorithm>
+#include <vector>
 
 // clazy:excludeall=const-signal-or-slot
 
@@ -142,6 +146,84 @@ namespace BlackSimPlugin
             QList<bool> idents;     //!< List of active idents
         };
 
+        //! Planes positions, surfaces and transponders as one packed frame
+        //! \sa BlackMisc::Simulation::XPlane::QtFreeTrafficFrame
+        struct PlanesFrame
+        {
+            //! Plane record
+            using PlaneRecord = BlackMisc::Simulation::XPlane::QtFreeTrafficFrame::PlaneRecord;
+
+            //! Is empty?
+            bool isEmpty() const { return records.empty(); }
+
+            //! Push back a record if it contains any values
+            void push_back(const PlaneRecord &record)
+            {
+                if (record.changedMask != 0) { records.push_back(record); }
+            }
+
+            //! Set the position of a record from the latest situation
+            static void setPosition(PlaneRecord &record, const BlackMisc::Aviation::CAircraftSituation &situation)
+            {
+                using namespace BlackMisc::PhysicalQuantities;
+                record.changedMask |= BlackMisc::Simulation::XPlane::QtFreeTrafficFrame::Position;
+                record.latitudeDeg = situation.latitude().value(CAngleUnit::deg());
+                record.longitudeDeg = situation.longitude().value(CAngleUnit::deg());
+                record.altitudeFt = situation.getAltitude().value(CLengthUnit::ft());
+                record.pitchDeg = static_cast<float>(situation.getPitch().value(CAngleUnit::deg()));
+                record.rollDeg = static_cast<float>(situation.getBank().value(CAngleUnit::deg()));
+                record.headingDeg = static_cast<float>(situation.getHeading().value(CAngleUnit::deg()));
+                record.onGround = situation.getOnGround() == BlackMisc::Aviation::CAircraftSituation::OnGround ? 1 : 0;
+            }
+
+            //! Set the surfaces of a record from the latest parts, same values as PlanesSurfaces
+            static void setSurfaces(PlaneRecord &record, const BlackMisc::Aviation::CAircraftParts &parts)
+            {
+                using namespace BlackMisc::Simulation::XPlane::QtFreeTrafficFrame;
+                record.changedMask |= Surfaces;
+                record.gear = parts.isFixedGearDown() ? 1 : 0;
+                record.flaps = static_cast<float>(parts.getFlapsPercent() / 100.0);
+                record.spoilers = parts.isSpoilersOut() ? 1 : 0;
+                record.speedBrakes = parts.isSpoilersOut() ? 1 : 0;
+                record.slats = static_cast<float>(parts.getFlapsPercent() / 100.0);
+                record.wingSweep = 0;
+                record.thrust = parts.isAnyEngineOn() ? 0.75f : 0;
+                record.elevator = 0;
+                record.rudder = 0;
+                record.aileron = 0;
+                record.lights = 0;
+                if (parts.getLights().isLandingOn()) { record.lights |= LandLight; }
+                if (parts.getLights().isTaxiOn())    { record.lights |= TaxiLight; }
+                if (parts.getLights().isBeaconOn())  { record.lights |= BeaconLight; }
+                if (parts.getLights().isStrobeOn())  { record.lights |= StrobeLight; }
+                if (parts.getLights().isNavOn())     { record.lights |= NavLight; }
+                record.lightPattern = 0;
+            }
+
+            //! Set the transponder of a record
+            static void setTransponder(PlaneRecord &record, int code, bool modeC, bool ident)
+            {
+                using namespace BlackMisc::Simulation::XPlane::QtFreeTrafficFrame;
+                record.changedMask |= Transponder;
+                record.transponderCode = code;
+                record.transponderFlags = 0;
+                if (modeC) { record.transponderFlags |= ModeC; }
+                if (ident) { record.transponderFlags |= Ident; }
+            }
+
+            //! The packed frame
+            QByteArray toByteArray() const
+            {
+                using namespace BlackMisc::Simulation::XPlane::QtFreeTrafficFrame;
+                const std::size_t count = std::min(records.size(), MaxPlanes);
+                QByteArray frame(static_cast<int>(frameSize(count)), Qt::Uninitialized);
+                writeFrame(records.data(), count, frame.data());
+                return frame;
+            }
+
+            std::vector<PlaneRecord> records; //!< Records, one per plane
+        };
+
         //! Multiplayer Acquire Info
         struct MultiplayerAcquireInfo
         {
@@ -220,7 +302,7 @@ namespace BlackSimPlugin
             void setMaxDrawDistance(double nauticalMiles);
 
             //! \copydoc XSwiftBus::CTraffic::addPlane
-            void addPlane(const QString &callsign, const QString &modelName, const QString &aircraftIcao, const QString &airlineIcao, const QString &livery);
+            void addPlane(const QString &callsign, const QString &modelName, const QString &aircraftIcao, const QString &airlineIcao, const QString &livery, int planeId);
 
             //! \copydoc XSwiftBus::CTraffic::removePlane
             void removePlane(const QString &callsign);
@@ -237,6 +319,9 @@ namespace BlackSimPlugin
             //! \copydoc XSwiftBus::CTraffic::setPlanesTransponders
             void setPlanesTransponders(const BlackSimPlugin::XPlane::PlanesTransponders &planesTransponders);
 
+            //! \copydoc XSwiftBus::CTraffic::setPlanesFrame
+            void setPlanesFrame(const QByteArray &frame);
+
             //! \deprecated XSwiftBus::CTraffic::setInterpolatorMode
             void setInterpolatorMode(const QString &callsign, bool spline);
 
@@ -13,13 +13,17 @@
 #include "blackmisc/math/mathutils.h"
 #include "blackmisc/verify.h"
 #include "blackmisc/logmessage.h"
+#include "blackmisc/parallel.h"
 #include "blackconfig/buildconfig.h"
 
 #include <QNetworkRequest>
 #include <QNetworkReply>
 #include <QEventLoop>
 #include <QStringBuilder>
+#include <QThread>
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 using namespace BlackConfig;
 using namespace BlackMisc;
@@ -118,6 +122,16 @@ namespace BlackWxPlugin
             float surfacePrecipitationRate = 0;
             float pressureAtMsl = 0.0;
         };
+
+        struct GfsField
+        {
+            unsigned char *message = nullptr; // GRIB message containing the field
+            g2int number = 0;                 // field number within the message, starting with 1
+            bool unpacked = false;            // successfully unpacked
+            g2int pdtNumber = 0;              // product definition template number
+            QVector<g2int> pdt;               // product definition template values
+            QVector<float> values;            // value for each point of m_gfsWeatherGrid, same order
+        };
         //! \endcond
 
         const CWeatherDataGfs::Grib2ParameterTable CWeatherDataGfs::m_grib2ParameterTable
@@ -339,9 +353,12 @@ namespace BlackWxPlugin
 
             // Messages should be 76. This is a combination
             // of requested values (e.g. temperature, clouds etc) at specific layers (2 mbar, 10 mbar, surface).
+            // Locating the messages is cheap, unpacking them is what takes the time.
             constexpr int maxMessages = 76;
             int messageNo = 0;
             g2int iseek = 0;
+            QVector<GfsField> fields;
+            auto constData = reinterpret_cast<unsigned char *>(const_cast<char *>(gribData.data()));
             for (;;)
             {
                 if (QThread::currentThread()->isInterruptionRequested()) { return false; }
@@ -349,7 +366,6 @@ namespace BlackWxPlugin
                 // Search next grib field
                 g2int lskip = 0;
                 g2int lgrib = 0;
-                auto constData = reinterpret_cast<unsigned char *>(const_cast<char *>(gribData.data()));
                 findNextGribMessage(constData, gribData.size(), iseek, &lskip, &lgrib);
                 if (lgrib == 0) { break; }
 
@@ -364,28 +380,10 @@ namespace BlackWxPlugin
 
                 for (int n = 0; n < numfields; n++)
                 {
-                    g2int unpack = 1;
-                    g2int expand = 1;
-                    gribfield *gfld = nullptr;
-                    g2_getfld(readPtr, n + 1, unpack, expand, &gfld);
-                    if (gfld->idsectlen < 12) { CLogMessage(this).warning(u"Identification section: wrong length!"); continue; }
-
-                    if (gfld->igdtnum != 0) { CLogMessage(this).warning(u"Can handle only grid definition template number = 0"); }
-
-                    int nscan = gfld->igdtmpl[18];
-                    int npnts = gfld->ngrdpts;
-                    int nx = gfld->igdtmpl[7];
-                    int ny = gfld->igdtmpl[8];
-                    if (nscan != 0) {  CLogMessage(this).error(u"Can only handle scanning mode NS:WE."); }
-                    if (npnts != nx * ny) {  CLogMessage(this).error(u"Cannot handle non-regular grid."); }
-
-                    if (m_gfsWeatherGrid.empty()) { createWeatherGrid(gfld); }
-
-                    if (gfld->ipdtnum == 0) { handleProductDefinitionTemplate40(gfld); }
-                    else if (gfld->ipdtnum == 8) { handleProductDefinitionTemplate48(gfld); }
-                    else { CLogMessage(this).warning(u"Cannot handle product definition template %1") << gfld->ipdtnum; continue; }
-
-                    g2_free(gfld);
+                    GfsField field;
+                    field.message = readPtr;
+                    field.number = n + 1;
+                    fields.push_back(field);
                 }
                 messageNo++;
             }
@@ -397,6 +395,37 @@ namespace BlackWxPlugin
                 BLACK_VERIFY_X(false, Q_FUNC_INFO, "Format change in GRIB, too many messages");
             }
 
+            // The first field which can be unpacked defines the grid. Unpacking it first also initializes the static data
+            // of g2clib, afterwards the fields are independent and are unpacked in parallel.
+            int gridField = 0;
+            for (; gridField < fields.size(); gridField++)
+            {
+                if (QThread::currentThread()->isInterruptionRequested()) { return false; }
+                fields[gridField].unpacked = this->unpackField(fields[gridField], true);
+                if (fields[gridField].unpacked) { break; }
+            }
+
+            if (gridField + 1 < fields.size() && !m_gfsWeatherGrid.isEmpty())
+            {
+                QThread *workerThread = QThread::currentThread();
+                GfsField *fieldData = fields.data() + gridField + 1;
+                runInParallel(fields.size() - gridField - 1, [ & ](int i)
+                {
+                    if (workerThread->isInterruptionRequested()) { return; }
+                    fieldData[i].unpacked = this->unpackField(fieldData[i], false);
+                });
+                if (workerThread->isInterruptionRequested()) { return false; }
+            }
+
+            // Apply in message order, as fields may refer to the same layers
+            for (const GfsField &field : as_const(fields))
+            {
+                if (!field.unpacked) { continue; }
+                if (field.pdtNumber == 0) { handleProductDefinitionTemplate40(field); }
+                else if (field.pdtNumber == 8) { handleProductDefinitionTemplate48(field); }
+                else { CLogMessage(this).warning(u"Cannot handle product definition template %1") << field.pdtNumber; }
+            }
+
             const int weatherGridPointsNo = m_gfsWeatherGrid.size();
             CLogMessage(this).debug() << "Parsed"   << messageNo << "GRIB messages.";
             CLogMessage(this).debug() << "Obtained" << weatherGridPointsNo << "grid points.";
@@ -603,61 +632,159 @@ namespace BlackWxPlugin
             }
             dy = fabs(dy);
 
-            if (nx > 0 && ny > 0)
+            if (nx < 1 || ny < 1) { return; }
+
+            const auto cellLatitude = [ = ](int iy)
             {
-                for (int iy = 0; iy < ny; iy++)
+                return latitude1 - iy * dy;
+            };
+            const auto cellLongitude = [ = ](int ix)
+            {
+                float longitude = longitude1 + ix * dx;
+                if (longitude >= 360.0f) { longitude -= 360.0f; }
+                if (longitude  <   0.0f) { longitude += 360.0f; }
+                return longitude;
+            };
+            const auto appendGridPoint = [ & ](int fieldPosition)
+            {
+                GfsGridPoint gridPoint;
+                gridPoint.latitude = cellLatitude(fieldPosition / nx);
+                gridPoint.longitude = cellLongitude(fieldPosition % nx);
+                gridPoint.fieldPosition = fieldPosition;
+                m_gfsWeatherGrid.append(gridPoint);
+            };
+
+            if (m_maxRange == CLength())
+            {
+                m_gfsWeatherGrid.reserve(npnts);
+                for (int fieldPosition = 0; fieldPosition < npnts; fieldPosition++) { appendGridPoint(fieldPosition); }
+                return;
+            }
+
+            // Instead of checking every cell against every requested point, only the cells around
+            // a requested point are checked. Rows and columns follow from latitude and longitude,
+            // one more row/column on each side covers rounding.
+            constexpr double earthRadiusMeters = 6371000.8;
+            const double rangeRad = m_maxRange.value(CLengthUnit::m()) / earthRadiusMeters;
+            const double rangeDeg = CMathUtils::rad2deg(rangeRad);
+            const int cellsPerCircle = dx > 0.0f ? qRound(360.0f / dx) : 1;
+
+            QVector<int> fieldPositions;
+            for (const CGridPoint &fixedGridPoint : as_const(m_grid))
+            {
+                const CCoordinateGeodetic &position = fixedGridPoint.getPosition();
+                if (position.isNull())
+                {
+                    BLACK_VERIFY_X(!CBuildConfig::isLocalDeveloperDebugBuild(), Q_FUNC_INFO, "Suspicious value, why is that?");
+                    continue;
+                }
+
+                const double latitude = position.latitude().value(CAngleUnit::deg());
+                double longitude = position.longitude().value(CAngleUnit::deg());
+                if (longitude < 0.0) { longitude += 360.0; }
+
+                int iyMin = 0;
+                int iyMax = 0;
+                if (dy > 0.0f)
+                {
+                    iyMin = qMax(0, static_cast<int>(std::floor((north - latitude - rangeDeg) / dy)) - 1);
+                    iyMax = qMin(ny - 1, static_cast<int>(std::ceil((north - latitude + rangeDeg) / dy)) + 1);
+                }
+
+                // all columns if the range contains a pole
+                int ixMin = 0;
+                int ixMax = nx - 1;
+                bool wrap = false;
+                const double sinRange = std::sin(rangeRad);
+                const double cosLatitude = std::cos(CMathUtils::deg2rad(latitude));
+                if (dx > 0.0f && rangeRad < CMathUtils::PIHALF() && sinRange < cosLatitude)
+                {
+                    // max.longitude difference of all positions within range
+                    const double rangeLongitudeDeg = CMathUtils::rad2deg(std::asin(sinRange / cosLatitude));
+                    ixMin = static_cast<int>(std::floor((longitude - rangeLongitudeDeg - longitude1) / dx)) - 1;
+                    ixMax = static_cast<int>(std::ceil((longitude + rangeLongitudeDeg - longitude1) / dx)) + 1;
+                    wrap = true;
+                }
+
+                for (int iy = iyMin; iy <= iyMax; iy++)
                 {
-                    int i = nx * iy;
-                    for (int ix = 0; ix < nx; ix++)
+                    for (int ix = ixMin; ix <= ixMax; ix++)
                     {
-                        GfsGridPoint gridPoint;
-                        gridPoint.latitude = latitude1 - iy * dy;
-                        gridPoint.longitude = longitude1 + ix * dx;
-                        if (gridPoint.longitude >= 360.0f) { gridPoint.longitude -= 360.0f; }
-                        if (gridPoint.longitude  <   0.0f) { gridPoint.longitude += 360.0f; }
-                        gridPoint.fieldPosition = ix + i;
-                        const CCoordinateGeodetic gridPointPosition(gridPoint.latitude, gridPoint.longitude, 0);
-                        if (m_maxRange == CLength())
-                        {
-                            m_gfsWeatherGrid.append(gridPoint);
-                        }
-                        else
-                        {
-                            for (const CGridPoint &fixedGridPoint : as_const(m_grid))
-                            {
-                                const CLength distance = calculateGreatCircleDistance(gridPointPosition, fixedGridPoint.getPosition());
-                                if (distance.isNull())
-                                {
-                                    BLACK_VERIFY_X(!CBuildConfig::isLocalDeveloperDebugBuild(), Q_FUNC_INFO, "Suspicious value, why is that?");
-                                }
-                                else
-                                {
-                                    if (distance < m_maxRange)
-                                    {
-                                        m_gfsWeatherGrid.append(gridPoint);
-                                        break;
-                                    }
-                                }
-                            }
-                        }
-                    } // for
-                } // for
-            } // if
+                        const int column = wrap ? ((ix % cellsPerCircle) + cellsPerCircle) % cellsPerCircle : ix;
+                        if (column >= nx) { continue; }
+
+                        const CCoordinateGeodetic cellPosition(cellLatitude(iy), cellLongitude(column), 0);
+                        const CLength distance = calculateGreatCircleDistance(cellPosition, position);
+                        if (!distance.isNull() && distance < m_maxRange) { fieldPositions.push_back(column + nx * iy); }
+                    }
+                }
+            }
+
+            // same order as the GRIB field, cells in range of several points only once
+            std::sort(fieldPositions.begin(), fieldPositions.end());
+            fieldPositions.erase(std::unique(fieldPositions.begin(), fieldPositions.end()), fieldPositions.end());
+            m_gfsWeatherGrid.reserve(fieldPositions.size());
+            for (int fieldPosition : as_const(fieldPositions)) { appendGridPoint(fieldPosition); }
+        }
+
+        bool CWeatherDataGfs::unpackField(GfsField &field, bool createGrid)
+        {
+            const g2int unpack = 1;
+            const g2int expand = 1;
+            gribfield *gfld = nullptr;
+            const g2int error = g2_getfld(field.message, field.number, unpack, expand, &gfld);
+            if (error != 0 || !gfld)
+            {
+                CLogMessage(this).warning(u"Cannot unpack GRIB field %1: error %2") << field.number << error;
+                if (gfld) { g2_free(gfld); }
+                return false;
+            }
+            if (gfld->idsectlen < 12) { CLogMessage(this).warning(u"Identification section: wrong length!"); g2_free(gfld); return false; }
+
+            if (gfld->igdtnum != 0) { CLogMessage(this).warning(u"Can handle only grid definition template number = 0"); }
+
+            int nscan = gfld->igdtmpl[18];
+            int npnts = gfld->ngrdpts;
+            int nx = gfld->igdtmpl[7];
+            int ny = gfld->igdtmpl[8];
+            if (nscan != 0) {  CLogMessage(this).error(u"Can only handle scanning mode NS:WE."); }
+            if (npnts != nx * ny) {  CLogMessage(this).error(u"Cannot handle non-regular grid."); }
+
+            if (createGrid) { createWeatherGrid(gfld); }
+
+            // m_gfsWeatherGrid is ordered by field position
+            if (!m_gfsWeatherGrid.isEmpty() && (!gfld->fld || m_gfsWeatherGrid.last().fieldPosition >= npnts))
+            {
+                CLogMessage(this).warning(u"GRIB field %1 does not match the grid") << field.number;
+                g2_free(gfld);
+                return false;
+            }
+
+            field.pdtNumber = gfld->ipdtnum;
+            field.pdt.reserve(gfld->ipdtlen);
+            for (g2int i = 0; i < gfld->ipdtlen; i++) { field.pdt.push_back(gfld->ipdtmpl[i]); }
+
+            const int gridPointsNo = m_gfsWeatherGrid.size();
+            field.values.resize(gridPointsNo);
+            for (int i = 0; i < gridPointsNo; i++) { field.values[i] = gfld->fld[m_gfsWeatherGrid[i].fieldPosition]; }
+
+            g2_free(gfld);
+            return true;
         }
 
-        void CWeatherDataGfs::handleProductDefinitionTemplate40(const gribfield *gfld)
+        void CWeatherDataGfs::handleProductDefinitionTemplate40(const GfsField &field)
         {
-            if (gfld->ipdtlen != 15)
+            if (field.pdt.size() != 15)
             {
                 CLogMessage(this).warning(u"Template 4.0 has wrong length");
                 return;
             }
 
             // https://www.nco.ncep.noaa.gov/pmb/docs/grib2/grib2_doc/grib2_temp4-0.shtml
-            g2int parameterCategory = gfld->ipdtmpl[0];
-            g2int parameterNumber = gfld->ipdtmpl[1];
-            g2int typeFirstFixedSurface = gfld->ipdtmpl[9];
-            g2int valueFirstFixedSurface = gfld->ipdtmpl[11];
+            g2int parameterCategory = field.pdt[0];
+            g2int parameterNumber = field.pdt[1];
+            g2int typeFirstFixedSurface = field.pdt[9];
+            g2int valueFirstFixedSurface = field.pdt[11];
 
             std::array<g2int, 2> key { { parameterCategory, parameterNumber } };
             // Make sure the key exists
@@ -680,11 +807,11 @@ namespace BlackWxPlugin
             auto parameterValue = m_grib2ParameterTable[key];
             switch (parameterValue.code)
             {
-            case TMP: setTemperature(gfld->fld, level); break;
-            case RH: setHumidity(gfld->fld, level); break;
-            case UGRD: setWindU(gfld->fld, level); break;
-            case VGRD: setWindV(gfld->fld, level); break;
-            case PRMSL: setPressureAtMsl(gfld->fld); break;
+            case TMP: setTemperature(field.values, level); break;
+            case RH: setHumidity(field.values, level); break;
+            case UGRD: setWindU(field.values, level); break;
+            case VGRD: setWindV(field.values, level); break;
+            case PRMSL: setPressureAtMsl(field.values); break;
             case PRES: /* Do nothing */ break;
             case TCDC: /* Do nothing */ break;
             case PRATE: /* Do nothing */ break;
@@ -694,17 +821,17 @@ namespace BlackWxPlugin
             }
         }
 
-        void CWeatherDataGfs::handleProductDefinitionTemplate48(const gribfield *gfld)
+        void CWeatherDataGfs::handleProductDefinitionTemplate48(const GfsField &field)
         {
-            if (gfld->ipdtlen != 29)
+            if (field.pdt.size() != 29)
             {
                 CLogMessage(this).warning(u"Template 4.8 has wrong length.");
                 return;
             }
 
-            g2int parameterCategory = gfld->ipdtmpl[0];
-            g2int parameterNumber = gfld->ipdtmpl[1];
-            g2int typeFirstFixedSurface = gfld->ipdtmpl[9];
+            g2int parameterCategory = field.pdt[0];
+            g2int parameterNumber = field.pdt[1];
+            g2int typeFirstFixedSurface = field.pdt[9];
 
             std::array<g2int, 2> key { { parameterCategory, parameterNumber } };
             // Make sure the key exists
@@ -730,65 +857,71 @@ namespace BlackWxPlugin
             auto parameterValue = m_grib2ParameterTable[key];
             switch (parameterValue.code)
             {
-            case TCDC: setCloudCoverage(gfld->fld, grib2CloudLevelHash.value(typeFirstFixedSurface)); break;
-            case PRES: setCloudLevel(gfld->fld, typeFirstFixedSurface, grib2CloudLevelHash.value(typeFirstFixedSurface)); break;
-            case PRATE: setPrecipitationRate(gfld->fld); break;
-            case CRAIN: setSurfaceRain(gfld->fld); break;
-            case CSNOW: setSurfaceSnow(gfld->fld); break;
-            case TMP: setCloudTemperature(gfld->fld, typeFirstFixedSurface, grib2CloudLevelHash.value(typeFirstFixedSurface)); break;
+            case TCDC: setCloudCoverage(field.values, grib2CloudLevelHash.value(typeFirstFixedSurface)); break;
+            case PRES: setCloudLevel(field.values, typeFirstFixedSurface, grib2CloudLevelHash.value(typeFirstFixedSurface)); break;
+            case PRATE: setPrecipitationRate(field.values); break;
+            case CRAIN: setSurfaceRain(field.values); break;
+            case CSNOW: setSurfaceSnow(field.values); break;
+            case TMP: setCloudTemperature(field.values, typeFirstFixedSurface, grib2CloudLevelHash.value(typeFirstFixedSurface)); break;
             default: CLogMessage(this).warning(u"Unexpected parameterValue in Template 4.8: %1 (%2)") << parameterValue.code << parameterValue.name; return;
             }
         }
 
-        void CWeatherDataGfs::setTemperature(const g2float *fld, float level)
+        void CWeatherDataGfs::setTemperature(const QVector<float> &values, float level)
         {
-            for (auto &gridPoint : m_gfsWeatherGrid)
+            for (int i = 0; i < m_gfsWeatherGrid.size(); i++)
             {
-                if (level > 0) { gridPoint.isobaricLayers[level].temperature = fld[gridPoint.fieldPosition]; }
+                GfsGridPoint &gridPoint = m_gfsWeatherGrid[i];
+                if (level > 0) { gridPoint.isobaricLayers[level].temperature = values[i]; }
             }
         }
 
-        void CWeatherDataGfs::setHumidity(const g2float *fld, float level)
+        void CWeatherDataGfs::setHumidity(const QVector<float> &values, float level)
         {
-            for (auto &gridPoint : m_gfsWeatherGrid)
+            for (int i = 0; i < m_gfsWeatherGrid.size(); i++)
             {
-                gridPoint.isobaricLayers[level].relativeHumidity = fld[gridPoint.fieldPosition];
+                GfsGridPoint &gridPoint = m_gfsWeatherGrid[i];
+                gridPoint.isobaricLayers[level].relativeHumidity = values[i];
             }
         }
 
-        void CWeatherDataGfs::setWindV(const g2float *fld, float level)
+        void CWeatherDataGfs::setWindV(const QVector<float> &values, float level)
         {
-            for (auto &gridPoint : m_gfsWeatherGrid)
+            for (int i = 0; i < m_gfsWeatherGrid.size(); i++)
             {
-                gridPoint.isobaricLayers[level].windV = fld[gridPoint.fieldPosition];
+                GfsGridPoint &gridPoint = m_gfsWeatherGrid[i];
+                gridPoint.isobaricLayers[level].windV = values[i];
             }
         }
 
-        void CWeatherDataGfs::setWindU(const g2float *fld, float level)
+        void CWeatherDataGfs::setWindU(const QVector<float> &values, float level)
         {
-            for (auto &gridPoint : m_gfsWeatherGrid)
+            for (int i = 0; i < m_gfsWeatherGrid.size(); i++)
             {
-                gridPoint.isobaricLayers[level].windU = fld[gridPoint.fieldPosition];
+                GfsGridPoint &gridPoint = m_gfsWeatherGrid[i];
+                gridPoint.isobaricLayers[level].windU = values[i];
             }
         }
 
-        void CWeatherDataGfs::setCloudCoverage(const g2float *fld, int level)
+        void CWeatherDataGfs::setCloudCoverage(const QVector<float> &values, int level)
         {
-            for (auto &gridPoint : m_gfsWeatherGrid)
+            for (int i = 0; i < m_gfsWeatherGrid.size(); i++)
             {
-                if (fld[gridPoint.fieldPosition] > 0.0f) { gridPoint.cloudLayers[level].totalCoverage = fld[gridPoint.fieldPosition]; }
+                GfsGridPoint &gridPoint = m_gfsWeatherGrid[i];
+                if (values[i] > 0.0f) { gridPoint.cloudLayers[level].totalCoverage = values[i]; }
             }
         }
 
-        void CWeatherDataGfs::setCloudLevel(const g2float *fld, int surfaceType, int level)
+        void CWeatherDataGfs::setCloudLevel(const QVector<float> &values, int surfaceType, int level)
         {
-            for (auto &gridPoint : m_gfsWeatherGrid)
+            for (int i = 0; i < m_gfsWeatherGrid.size(); i++)
             {
+                GfsGridPoint &gridPoint = m_gfsWeatherGrid[i];
                 static const g2float minimumLevel = 1000.0;
                 float levelPressure = std::numeric_limits<float>::quiet_NaN();
-                g2float fieldValue = fld[gridPoint.fieldPosition];
+                g2float fieldValue = values[i];
                 // A value of 9.999e20 is undefined. Check that the pressure value is below
-                if (fieldValue < 9.998e20f && fieldValue > minimumLevel) { levelPressure = fld[gridPoint.fieldPosition]; }
+                if (fieldValue < 9.998e20f && fieldValue > minimumLevel) { levelPressure = values[i]; }
                 switch (surfaceType)
                 {
                 case LowCloudBottomLevel:
@@ -808,13 +941,14 @@ namespace BlackWxPlugin
             }
         }
 
-        void CWeatherDataGfs::setCloudTemperature(const g2float *fld, int surfaceType, int level)
+        void CWeatherDataGfs::setCloudTemperature(const QVector<float> &values, int surfaceType, int level)
         {
-            for (auto &gridPoint : m_gfsWeatherGrid)
+            for (int i = 0; i < m_gfsWeatherGrid.size(); i++)
             {
+                GfsGridPoint &gridPoint = m_gfsWeatherGrid[i];
                 float temperature = std::numeric_limits<float>::quiet_NaN();
-                g2float fieldValue = fld[gridPoint.fieldPosition];
-                if (fieldValue < 9.998e20f) { temperature = fld[gridPoint.fieldPosition]; }
+                g2float fieldValue = values[i];
+                if (fieldValue < 9.998e20f) { temperature = values[i]; }
                 switch (surfaceType)
                 {
                 case LowCloudTopLevel:
@@ -829,35 +963,39 @@ namespace BlackWxPlugin
             }
         }
 
-        void CWeatherDataGfs::setPressureAtMsl(const g2float *fld)
+        void CWeatherDataGfs::setPressureAtMsl(const QVector<float> &values)
         {
-            for (auto &gridPoint : m_gfsWeatherGrid)
+            for (int i = 0; i < m_gfsWeatherGrid.size(); i++)
             {
-                gridPoint.pressureAtMsl = fld[gridPoint.fieldPosition];
+                GfsGridPoint &gridPoint = m_gfsWeatherGrid[i];
+                gridPoint.pressureAtMsl = values[i];
             }
         }
 
-        void CWeatherDataGfs::setSurfaceRain(const g2float *fld)
+        void CWeatherDataGfs::setSurfaceRain(const QVector<float> &values)
         {
-            for (auto &gridPoint : m_gfsWeatherGrid)
+            for (int i = 0; i < m_gfsWeatherGrid.size(); i++)
             {
-                gridPoint.surfaceRain = fld[gridPoint.fieldPosition];
+                GfsGridPoint &gridPoint = m_gfsWeatherGrid[i];
+                gridPoint.surfaceRain = values[i];
             }
         }
 
-        void CWeatherDataGfs::setSurfaceSnow(const g2float *fld)
+        void CWeatherDataGfs::setSurfaceSnow(const QVector<float> &values)
         {
-            for (auto &gridPoint : m_gfsWeatherGrid)
+            for (int i = 0; i < m_gfsWeatherGrid.size(); i++)
             {
-                gridPoint.surfaceSnow = fld[gridPoint.fieldPosition];
+                GfsGridPoint &gridPoint = m_gfsWeatherGrid[i];
+                gridPoint.surfaceSnow = values[i];
             }
         }
 
-        void CWeatherDataGfs::setPrecipitationRate(const g2float *fld)
+        void CWeatherDataGfs::setPrecipitationRate(const QVector<float> &values)
         {
-            for (auto &gridPoint : m_gfsWeatherGrid)
+            for (int i = 0; i < m_gfsWeatherGrid.size(); i++)
             {
-                gridPoint.surfacePrecipitationRate = fld[gridPoint.fieldPosition];
+                GfsGridPoint &gridPoint = m_gfsWeatherGrid[i];
+                gridPoint.surfacePrecipitationRate = values[i];
             }
         }
 
@@ -34,6 +34,7 @@ namespace BlackWxPlugin
         struct Grib2ParameterKey;
         struct Grib2ParameterValue;
         struct GfsGridPoint;
+        struct GfsField;
 
         /*!
          * GFS implemenation
@@ -70,20 +71,26 @@ namespace BlackWxPlugin
             BlackMisc::Network::CUrl getDownloadUrl() const;
             bool parseGfsFileImpl(const QByteArray &gribData);
             void findNextGribMessage(unsigned char *buffer, g2int size, g2int iseek, g2int *lskip, g2int *lgrib);
+            //! Points of m_grid within range, as GRIB cell indexes computed from latitude and longitude
             void createWeatherGrid(const gribfield *gfld);
-            void handleProductDefinitionTemplate40(const gribfield *gfld);
-            void handleProductDefinitionTemplate48(const gribfield *gfld);
-            void setTemperature(const g2float *fld, float level);
-            void setHumidity(const g2float *fld, float level);
-            void setWindV(const g2float *fld, float level);
-            void setWindU(const g2float *fld, float level);
-            void setCloudCoverage(const g2float *fld, int level);
-            void setCloudLevel(const g2float *fld, int surfaceType, int level);
-            void setCloudTemperature(const g2float *fld, int surfaceType, int level);
-            void setPressureAtMsl(const g2float *fld);
-            void setSurfaceRain(const g2float *fld);
-            void setSurfaceSnow(const g2float *fld);
-            void setPrecipitationRate(const g2float *fld);
+
+            //! Unpack a field and keep its values at the points of m_gfsWeatherGrid
+            //! \threadsafe if createGrid is false
+            bool unpackField(GfsField &field, bool createGrid);
+
+            void handleProductDefinitionTemplate40(const GfsField &field);
+            void handleProductDefinitionTemplate48(const GfsField &field);
+            void setTemperature(const QVector<float> &values, float level);
+            void setHumidity(const QVector<float> &values, float level);
+            void setWindV(const QVector<float> &values, float level);
+            void setWindU(const QVector<float> &values, float level);
+            void setCloudCoverage(const QVector<float> &values, int level);
+            void setCloudLevel(const QVector<float> &values, int surfaceType, int level);
+            void setCloudTemperature(const QVector<float> &values, int surfaceType, int level);
+            void setPressureAtMsl(const QVector<float> &values);
+            void setSurfaceRain(const QVector<float> &values);
+            void setSurfaceSnow(const QVector<float> &values);
+            void setPrecipitationRate(const QVector<float> &values);
 
             BlackMisc::PhysicalQuantities::CTemperature calculateDewPoint(const BlackMisc::PhysicalQuantities::CTemperature &temperature, double relativeHumidity);
 
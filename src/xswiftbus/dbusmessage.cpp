@@ -250,6 +250,19 @@ namespace XSwiftBus
         dbus_message_iter_next(&m_messageIterator);
     }
 
+    void CDBusMessage::getArgument(std::vector<char> &value)
+    {
+        if (dbus_message_iter_get_arg_type(&m_messageIterator) != DBUS_TYPE_ARRAY) { return; }
+        if (dbus_message_iter_get_element_type(&m_messageIterator) != DBUS_TYPE_BYTE) { return; }
+        DBusMessageIter arrayIterator;
+        dbus_message_iter_recurse(&m_messageIterator, &arrayIterator);
+        const char *bytes = nullptr;
+        int size = 0;
+        dbus_message_iter_get_fixed_array(&arrayIterator, &bytes, &size);
+        if (bytes && size > 0) { value.assign(bytes, bytes + size); }
+        dbus_message_iter_next(&m_messageIterator);
+    }
+
     CDBusMessage CDBusMessage::createSignal(const std::string &path, const std::string &interfaceName, const std::string &signalName)
     {
         DBusMessage *signal = dbus_message_new_signal(path.c_str(), interfaceName.c_str(), signalName.c_str());
@@ -94,6 +94,7 @@ namespace XSwiftBus
         void getArgument(std::vector<bool> &value);
         void getArgument(std::vector<double> &value);
         void getArgument(std::vector<std::string> &value);
+        void getArgument(std::vector<char> &value);
         //! @}
 
         //! Creates a DBus message containing a DBus signal
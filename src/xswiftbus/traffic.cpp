@@ -21,6 +21,7 @@
 #include <XPLM/XPLMPlanes.h>
 #include <XPLM/XPLMPlugin.h>
 #include "blackmisc/simulation/xplane/qtfreeutils.h"
+#include "blackmisc/simulation/xplane/qtfreetrafficframe.h"
 #include <cassert>
 #include <cstring>
 #include <cmath>
@@ -297,7 +298,7 @@ namespace XSwiftBus
         if (s.setMaxDrawDistanceNM(nauticalMiles)) { this->setSettings(s); }
     }
 
-    void CTraffic::addPlane(const std::string &callsign, const std::string &modelName, const std::string &aircraftIcao, const std::string &airlineIcao, const std::string &livery)
+    void CTraffic::addPlane(const std::string &callsign, const std::string &modelName, const std::string &aircraftIcao, const std::string &airlineIcao, const std::string &livery, int planeId)
     {
         auto planeIt = m_planesByCallsign.find(callsign);
         if (planeIt != m_planesByCallsign.end()) { return; }
@@ -322,6 +323,11 @@ namespace XSwiftBus
         Plane *plane = new Plane(id, callsign, aircraftIcao, airlineIcao, livery, modelName);
         m_planesByCallsign[callsign] = plane;
         m_planesById[id] = plane;
+        if (planeId > 0)
+        {
+            plane->planeId = static_cast<std::uint32_t>(planeId);
+            m_planesByPlaneId[plane->planeId] = plane;
+        }
 
         // Create view menu item
         CMenuItem planeViewMenuItem = m_followPlaneViewSubMenu.item(callsign, [this, callsign] { switchToFollowPlaneView(callsign); });
@@ -349,6 +355,7 @@ namespace XSwiftBus
         Plane *plane = planeIt->second;
         m_planesByCallsign.erase(callsign);
         m_planesById.erase(plane->id);
+        if (plane->planeId > 0) { m_planesByPlaneId.erase(plane->planeId); }
         XPMPDestroyPlane(plane->id);
         delete plane;
     }
@@ -371,6 +378,7 @@ namespace XSwiftBus
 
         m_planesByCallsign.clear();
         m_planesById.clear();
+        m_planesByPlaneId.clear();
         m_followPlaneViewMenuItems.clear();
         m_followPlaneViewSequence.clear();
     }
@@ -386,25 +394,7 @@ namespace XSwiftBus
 
             Plane *plane = planeIt->second;
             if (!plane) { continue; }
-            plane->positions[2].lat = latitudesDeg.at(i);
-            plane->positions[2].lon = longitudesDeg.at(i);
-            plane->positions[2].elevation = altitudesFt.at(i);
-            plane->positions[2].pitch   = static_cast<float>(pitchesDeg.at(i));
-            plane->positions[2].roll    = static_cast<float>(rollsDeg.at(i));
-            plane->positions[2].heading = static_cast<float>(headingsDeg.at(i));
-            plane->positions[2].offsetScale = 1.0f;
-            plane->positions[2].clampToGround = true;
-            plane->positionTimes[2] = std::chrono::steady_clock::now();
-
-            // save 2 positions at 1-second intervals for use in interpolation
-            if (plane->positionTimes[2] - plane->positionTimes[1] > 1s)
-            {
-                plane->positionTimes[0] = plane->positionTimes[1];
-                plane->positionTimes[1] = plane->positionTimes[2];
-                std::memcpy(&plane->positions[0], &plane->positions[1], sizeof(plane->positions[0]));
-                std::memcpy(&plane->positions[1], &plane->positions[2], sizeof(plane->positions[0]));
-            }
-
+            setPlanePosition(plane, latitudesDeg.at(i), longitudesDeg.at(i), altitudesFt.at(i), pitchesDeg.at(i), rollsDeg.at(i), headingsDeg.at(i));
             if (setOnGround) { plane->isOnGround = onGrounds.at(i); }
         }
     }
@@ -436,21 +426,7 @@ namespace XSwiftBus
             plane->surfaces.yokePitch = static_cast<float>(elevators.at(i));
             plane->surfaces.yokeHeading = static_cast<float>(rudders.at(i));
             plane->surfaces.yokeRoll = static_cast<float>(ailerons.at(i));
-            if (bundleTaxiLandingLights)
-            {
-                const bool on = landLights.at(i) || taxiLights.at(i);
-                plane->surfaces.lights.landLights = on;
-                plane->surfaces.lights.taxiLights = on;
-            }
-            else
-            {
-                plane->surfaces.lights.landLights = landLights.at(i);
-                plane->surfaces.lights.taxiLights = taxiLights.at(i);
-            }
-            plane->surfaces.lights.bcnLights = beaconLights.at(i);
-            plane->surfaces.lights.strbLights = strobeLights.at(i);
-            plane->surfaces.lights.navLights = navLights.at(i);
-            plane->surfaces.lights.flashPattern = static_cast<unsigned int>(lightPatterns.at(i));
+            setPlaneLights(plane, landLights.at(i), taxiLights.at(i), beaconLights.at(i), strobeLights.at(i), navLights.at(i), lightPatterns.at(i), bundleTaxiLandingLights);
         }
     }
 
@@ -464,13 +440,107 @@ namespace XSwiftBus
             Plane *plane = planeIt->second;
             if (!plane) { continue; }
 
-            plane->surveillance.code = codes.at(i);
-            if (idents.at(i)) { plane->surveillance.mode = xpmpTransponderMode_ModeC_Ident; }
-            else if (modeCs.at(i)) { plane->surveillance.mode = xpmpTransponderMode_ModeC; }
-            else { plane->surveillance.mode = xpmpTransponderMode_Standby; }
+            setPlaneTransponder(plane, codes.at(i), modeCs.at(i), idents.at(i));
+        }
+    }
+
+    void CTraffic::setPlanesFrame(const std::vector<char> &frame)
+    {
+        using namespace BlackMisc::Simulation::XPlane::QtFreeTrafficFrame;
+
+        std::vector<PlaneRecord> records;
+        if (!readFrame(frame.data(), frame.size(), records))
+        {
+            WARNING_LOG("Ignoring traffic frame with wrong layout");
+            return;
+        }
+
+        const bool bundleTaxiLandingLights = this->getSettings().isBundlingTaxiAndLandingLights();
+        for (const PlaneRecord &record : records)
+        {
+            auto planeIt = m_planesByPlaneId.find(record.planeId);
+            if (planeIt == m_planesByPlaneId.end()) { continue; }
+
+            Plane *plane = planeIt->second;
+            if (!plane) { continue; }
+
+            if (record.changedMask & Position)
+            {
+                setPlanePosition(plane, record.latitudeDeg, record.longitudeDeg, record.altitudeFt, record.pitchDeg, record.rollDeg, record.headingDeg);
+                plane->isOnGround = record.onGround != 0;
+            }
+            if (record.changedMask & Surfaces)
+            {
+                plane->hasSurfaces = true;
+                plane->targetGearPosition = record.gear;
+                plane->surfaces.flapRatio = record.flaps;
+                plane->surfaces.spoilerRatio = record.spoilers;
+                plane->surfaces.speedBrakeRatio = record.speedBrakes;
+                plane->surfaces.slatRatio = record.slats;
+                plane->surfaces.wingSweep = record.wingSweep;
+                plane->surfaces.thrust = record.thrust;
+                plane->surfaces.yokePitch = record.elevator;
+                plane->surfaces.yokeHeading = record.rudder;
+                plane->surfaces.yokeRoll = record.aileron;
+                setPlaneLights(plane, record.lights & LandLight, record.lights & TaxiLight, record.lights & BeaconLight,
+                               record.lights & StrobeLight, record.lights & NavLight, record.lightPattern, bundleTaxiLandingLights);
+            }
+            if (record.changedMask & Transponder)
+            {
+                setPlaneTransponder(plane, record.transponderCode, record.transponderFlags & ModeC, record.transponderFlags & Ident);
+            }
+        }
+    }
+
+    void CTraffic::setPlanePosition(Plane *plane, double latitudeDeg, double longitudeDeg, double altitudeFt, double pitchDeg, double rollDeg, double headingDeg)
+    {
+        plane->positions[2].lat = latitudeDeg;
+        plane->positions[2].lon = longitudeDeg;
+        plane->positions[2].elevation = altitudeFt;
+        plane->positions[2].pitch   = static_cast<float>(pitchDeg);
+        plane->positions[2].roll    = static_cast<float>(rollDeg);
+        plane->positions[2].heading = static_cast<float>(headingDeg);
+        plane->positions[2].offsetScale = 1.0f;
+        plane->positions[2].clampToGround = true;
+        plane->positionTimes[2] = std::chrono::steady_clock::now();
+
+        // save 2 positions at 1-second intervals for use in interpolation
+        if (plane->positionTimes[2] - plane->positionTimes[1] > 1s)
+        {
+            plane->positionTimes[0] = plane->positionTimes[1];
+            plane->positionTimes[1] = plane->positionTimes[2];
+            std::memcpy(&plane->positions[0], &plane->positions[1], sizeof(plane->positions[0]));
+            std::memcpy(&plane->positions[1], &plane->positions[2], sizeof(plane->positions[0]));
         }
     }
 
+    void CTraffic::setPlaneLights(Plane *plane, bool landLight, bool taxiLight, bool beaconLight, bool strobeLight, bool navLight, int lightPattern, bool bundleTaxiLandingLights)
+    {
+        if (bundleTaxiLandingLights)
+        {
+            const bool on = landLight || taxiLight;
+            plane->surfaces.lights.landLights = on;
+            plane->surfaces.lights.taxiLights = on;
+        }
+        else
+        {
+            plane->surfaces.lights.landLights = landLight;
+            plane->surfaces.lights.taxiLights = taxiLight;
+        }
+        plane->surfaces.lights.bcnLights = beaconLight;
+        plane->surfaces.lights.strbLights = strobeLight;
+        plane->surfaces.lights.navLights = navLight;
+        plane->surfaces.lights.flashPattern = static_cast<unsigned int>(lightPattern);
+    }
+
+    void CTraffic::setPlaneTransponder(Plane *plane, int code, bool modeC, bool ident)
+    {
+        plane->surveillance.code = code;
+        if (ident) { plane->surveillance.mode = xpmpTransponderMode_ModeC_Ident; }
+        else if (modeC) { plane->surveillance.mode = xpmpTransponderMode_ModeC; }
+        else { plane->surveillance.mode = xpmpTransponderMode_Standby; }
+    }
+
     void CTraffic::getRemoteAircraftData(std::vector<std::string> &callsigns, std::vector<double> &latitudesDeg, std::vector<double> &longitudesDeg,
                                          std::vector<double> &elevationsM, std::vector<bool> &waterFlags, std::vector<double> &verticalOffsets) const
     {
@@ -637,16 +707,18 @@ namespace XSwiftBus
                 std::string aircraftIcao;
                 std::string airlineIcao;
                 std::string livery;
+                int planeId = 0; // not sent by older drivers
                 message.beginArgumentRead();
                 message.getArgument(callsign);
                 message.getArgument(modelName);
                 message.getArgument(aircraftIcao);
                 message.getArgument(airlineIcao);
                 message.getArgument(livery);
+                message.getArgument(planeId);
 
                 queueDBusCall([ = ]()
                 {
-                    addPlane(callsign, modelName, aircraftIcao, airlineIcao, livery);
+                    addPlane(callsign, modelName, aircraftIcao, airlineIcao, livery, planeId);
                 });
             }
             else if (message.getMethodName() == "removePlane")
@@ -754,6 +826,17 @@ namespace XSwiftBus
                     setPlanesTransponders(callsigns, codes, modeCs, idents);
                 });
             }
+            else if (message.getMethodName() == "setPlanesFrame")
+            {
+                maybeSendEmptyDBusReply(wantsReply, sender, serial);
+                std::vector<char> frame;
+                message.beginArgumentRead();
+                message.getArgument(frame);
+                queueDBusCall([ = ]()
+                {
+                    setPlanesFrame(frame);
+                });
+            }
             else if (message.getMethodName() == "getRemoteAircraftData")
             {
                 std::vector<std::string> requestedCallsigns;
@@ -21,6 +21,7 @@
 #include "XPMPMultiplayer.h"
 #include <XPLM/XPLMCamera.h>
 #include <XPLM/XPLMDisplay.h>
+#include <cstdint>
 #include <functional>
 #include <utility>
 
@@ -88,7 +89,8 @@ namespace XSwiftBus
         void setMaxDrawDistance(double nauticalMiles);
 
         //! Introduce a new traffic aircraft
-        void addPlane(const std::string &callsign, const std::string &modelName, const std::string &aircraftIcao, const std::string &airlineIcao, const std::string &livery);
+        //! \remark planeId identifies the aircraft in frames of setPlanesFrame, 0 if the driver does not send frames
+        void addPlane(const std::string &callsign, const std::string &modelName, const std::string &aircraftIcao, const std::string &airlineIcao, const std::string &livery, int planeId = 0);
 
         //! Remove a traffic aircraft
         void removePlane(const std::string &callsign);
@@ -111,6 +113,10 @@ namespace XSwiftBus
         //! Set the transponder of multiple traffic aircraft
         void setPlanesTransponders(const std::vector<std::string> &callsigns, const std::vector<int> &codes, const std::vector<bool> &modeCs, const std::vector<bool> &idents);
 
+        //! Set position, surfaces and transponder of multiple traffic aircraft from a packed frame
+        //! \sa BlackMisc::Simulation::XPlane::QtFreeTrafficFrame
+        void setPlanesFrame(const std::vector<char> &frame);
+
         //! Get remote aircrafts data (lat, lon, elevation and CG)
         void getRemoteAircraftData(std::vector<std::string> &callsigns, std::vector<double> &latitudesDeg, std::vector<double> &longitudesDeg,
                                    std::vector<double> &elevationsM, std::vector<bool> &waterFlags, std::vector<double> &verticalOffsets) const;
@@ -169,6 +175,7 @@ namespace XSwiftBus
         struct Plane
         {
             void *id = nullptr;
+            std::uint32_t planeId = 0;
             std::string callsign;
             std::string aircraftIcao;
             std::string airlineIcao;
@@ -231,6 +238,13 @@ namespace XSwiftBus
         static bool isValidPosition(const XPLMCameraPosition_t *camPos);
         //! @}
 
+        //! Set the values of one plane, shared by the array and the frame setters
+        //! @{
+        static void setPlanePosition(Plane *plane, double latitudeDeg, double longitudeDeg, double altitudeFt, double pitchDeg, double rollDeg, double headingDeg);
+        static void setPlaneLights(Plane *plane, bool landLight, bool taxiLight, bool beaconLight, bool strobeLight, bool navLight, int lightPattern, bool bundleTaxiLandingLights);
+        static void setPlaneTransponder(Plane *plane, int code, bool modeC, bool ident);
+        //! @}
+
         //! Pos as string
         //! @{
         static std::string pos2String(const XPMPPlanePosition_t &position);
@@ -240,6 +254,7 @@ namespace XSwiftBus
         std::unordered_map<std::string, std::string> m_modelStrings; // mapping uppercase to mixedcase
         std::unordered_map<std::string, Plane *> m_planesByCallsign;
         std::unordered_map<void *, Plane *> m_planesById;
+        std::unordered_map<std::uint32_t, Plane *> m_planesByPlaneId;
         std::vector<std::string> m_followPlaneViewSequence;
         // std::chrono::system_clock::time_point m_timestampLastSimFrame = std::chrono::system_clock::now();
 
@@ -2,6 +2,7 @@
 
 XSWIFTBUS_DEPENDENTS = $$SourceRoot/src/xswiftbus \
     $$SourceRoot/src/blackmisc/simulation/xplane/qtfreeutils.* \
+    $$SourceRoot/src/blackmisc/simulation/xplane/qtfreetrafficframe.* \
     $$SourceRoot/src/blackmisc/simulation/settings/xswiftbussettingsqtfree.*
 
 XSWIFTBUS_COMMIT = $$system(git log -n 1 --format=%h -- $$XSWIFTBUS_DEPENDENTS)
@@ -41,6 +41,7 @@
 #include "blackcore/fsd/planeinforequestfsinn.h"
 #include "blackcore/fsd/planeinformationfsinn.h"
 #include "blackcore/fsd/enums.h"
+#include "blackcore/fsd/messagebase.h"
 #include "test.h"
 
 #include <QObject>
@@ -90,6 +91,8 @@ namespace BlackMiscTest
         void testPong();
         void testServerError();
         void testTextMessage();
+        void testMessageTypeFromPrefix();
+        void testSplitTokens();
     };
 
     void CTestFsdMessages::testAddAtc()
@@ -601,6 +604,46 @@ namespace BlackMiscTest
     {
 
     }
+
+    void CTestFsdMessages::testMessageTypeFromPrefix()
+    {
+        int prefixLength = -1;
+        QCOMPARE(messageTypeFromPrefix(u"@N:ABCD:1200:1:48.11028:8.56972:1000:0:4290769188:0", prefixLength), MessageType::PilotDataUpdate);
+        QCOMPARE(prefixLength, 1);
+        QCOMPARE(messageTypeFromPrefix(u"%ABCD:28200:5:145:5:48.11028:8.56972:100", prefixLength), MessageType::AtcDataUpdate);
+        QCOMPARE(prefixLength, 1);
+        QCOMPARE(messageTypeFromPrefix(u"!RSERVER:ABCD", prefixLength), MessageType::RegistrationInfo);
+        QCOMPARE(prefixLength, 2);
+        QCOMPARE(messageTypeFromPrefix(u"#TMABCD:@28200:Hello", prefixLength), MessageType::TextMessage);
+        QCOMPARE(prefixLength, 3);
+        QCOMPARE(messageTypeFromPrefix(u"$!!SERVER:ABCD:Bye", prefixLength), MessageType::KillRequest);
+        QCOMPARE(prefixLength, 3);
+        QCOMPARE(messageTypeFromPrefix(u"-MDABCD:SERVER", prefixLength), MessageType::RevBClientParts);
+        QCOMPARE(prefixLength, 3);
+        QCOMPARE(messageTypeFromPrefix(u"$XYABCD:SERVER", prefixLength), MessageType::Unknown);
+        QCOMPARE(prefixLength, 0);
+        QCOMPARE(messageTypeFromPrefix(u"#T", prefixLength), MessageType::Unknown);
+        QCOMPARE(prefixLength, 0);
+        QCOMPARE(messageTypeFromPrefix(u"", prefixLength), MessageType::Unknown);
+        QCOMPARE(prefixLength, 0);
+
+        // every prefix of the table resolves to its own type
+        for (const MessageTypePrefix &p : messageTypePrefixes())
+        {
+            const QString prefix = QString::fromLatin1(p.prefix);
+            QCOMPARE(messageTypeFromPrefix(QString(prefix + "ABCD:SERVER"), prefixLength), p.type);
+            QCOMPARE(prefixLength, prefix.size());
+        }
+    }
+
+    void CTestFsdMessages::testSplitTokens()
+    {
+        const QString payloads[] = { "ABCD:SERVER:7a57f2dd9d360d347b", "ABCD", "ABCD::", ":", "" };
+        for (const QString &payload : payloads)
+        {
+            QCOMPARE(splitTokens(payload), payload.split(':'));
+        }
+    }
 }
 
 //! main
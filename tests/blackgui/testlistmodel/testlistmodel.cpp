@@ -0,0 +1,272 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackgui
+
+#include "blackgui/models/statusmessagelistmodel.h"
+#include "blackgui/models/userlistmodel.h"
+#include "blackmisc/statusmessagelist.h"
+#include "blackmisc/network/userlist.h"
+#include "blackmisc/network/user.h"
+#include "test.h"
+
+#include <QModelIndex>
+#include <QObject>
+#include <QRandomGenerator>
+#include <QTest>
+#include <QVector>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Network;
+using namespace BlackGui::Models;
+
+namespace BlackGuiTest
+{
+    //! Test the list model updates by differences
+    class CTestListModel : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Random small changes are applied as removed, moved, inserted and changed rows
+        void updateByDifferences();
+
+        //! Many changes reset the model
+        void updateWithReset();
+
+        //! Models with compare functions sort in the order of the compare functions, not of the displayed values
+        void sortByCompareFunction();
+
+    private:
+        //! Kind of change
+        enum Change { Insert, Remove, Move, Replace, Mixed, Duplicate, ChangeCount };
+
+        //! Rows as seen by a view, only changed by the signals of the model
+        class CViewRows
+        {
+        public:
+            //! Connect to the model
+            explicit CViewRows(CUserListModel &model);
+
+            QVector<CUser> rows;   //!< rows as in the view
+            int inserted = 0;      //!< rowsInserted signals
+            int removed = 0;       //!< rowsRemoved signals
+            int moved = 0;         //!< rowsMoved signals
+            int changed = 0;       //!< dataChanged signals
+            int resets = 0;        //!< modelReset signals
+
+            //! Reset the signal counts
+            void resetCounts() { inserted = removed = moved = changed = resets = 0; }
+        };
+
+        //! User with a unique id
+        static CUser createUser(int id, QRandomGenerator &random);
+
+        //! Apply one random change, returns the change applied
+        static Change applyChange(Change change, CUserList &users, int &nextId, QRandomGenerator &random);
+    };
+
+    CTestListModel::CViewRows::CViewRows(CUserListModel &model)
+    {
+        QObject::connect(&model, &CUserListModel::rowsInserted, [&](const QModelIndex &, int first, int last)
+        {
+            for (int r = first; r <= last; r++) { rows.insert(r, model.at(model.index(r, 0))); }
+            inserted++;
+        });
+        QObject::connect(&model, &CUserListModel::rowsRemoved, [&](const QModelIndex &, int first, int last)
+        {
+            rows.remove(first, last - first + 1);
+            removed++;
+        });
+        QObject::connect(&model, &CUserListModel::rowsMoved, [&](const QModelIndex &, int first, int last, const QModelIndex &, int destination)
+        {
+            const int count = last - first + 1;
+            const QVector<CUser> movedRows = rows.mid(first, count);
+            rows.remove(first, count);
+            const int to = destination > last ? destination - count : destination; // destination is before the move
+            for (int i = 0; i < count; i++) { rows.insert(to + i, movedRows[i]); }
+            moved++;
+        });
+        QObject::connect(&model, &CUserListModel::dataChanged, [&](const QModelIndex &topLeft, const QModelIndex &bottomRight)
+        {
+            for (int r = topLeft.row(); r <= bottomRight.row(); r++) { rows[r] = model.at(model.index(r, 0)); }
+            changed++;
+        });
+        QObject::connect(&model, &CUserListModel::modelReset, [&]
+        {
+            rows.clear();
+            for (const CUser &user : model.container()) { rows.push_back(user); }
+            resets++;
+        });
+    }
+
+    void CTestListModel::updateByDifferences()
+    {
+        QRandomGenerator random(4711); // reproducible
+        CUserListModel model(CUserListModel::UserDetailed);
+        CViewRows view(model);
+
+        CUserList users;
+        int nextId = 0;
+        for (; nextId < 200; nextId++) { users.push_back(createUser(nextId, random)); }
+        model.update(users, false);
+        QCOMPARE(view.resets, 1);
+
+        for (int i = 0; i < 600; i++)
+        {
+            // with equal objects the signals depend on which of them is matched, only the rows are checked then
+            const bool duplicates = i >= 300;
+            const Change change = applyChange(static_cast<Change>(random.bounded(static_cast<int>(duplicates ? ChangeCount : Duplicate))), users, nextId, random);
+            view.resetCounts();
+            model.update(users, false);
+
+            // the view has the same rows as the model, without a reset
+            QCOMPARE(model.container(), users);
+            QCOMPARE(view.rows.size(), users.size());
+            for (int r = 0; r < users.size(); r++) { QCOMPARE(view.rows[r], users[r]); }
+            QCOMPARE(view.resets, 0);
+            if (duplicates) { continue; }
+
+            switch (change)
+            {
+            case Insert:  QVERIFY(view.inserted == 1 && view.removed == 0 && view.moved == 0 && view.changed == 0); break;
+            case Remove:  QVERIFY(view.inserted == 0 && view.removed == 1 && view.moved == 0 && view.changed == 0); break;
+            case Move:    QVERIFY(view.inserted == 0 && view.removed == 0 && view.moved <= 1 && view.changed == 0); break;
+            case Replace: QVERIFY(view.inserted == 0 && view.removed == 0 && view.moved == 0 && view.changed == 1); break;
+            default: break;
+            }
+        }
+    }
+
+    void CTestListModel::updateWithReset()
+    {
+        QRandomGenerator random(815);
+        CUserListModel model(CUserListModel::UserDetailed);
+        CViewRows view(model);
+
+        CUserList users;
+        int nextId = 0;
+        for (; nextId < 100; nextId++) { users.push_back(createUser(nextId, random)); }
+        model.update(users, false);
+
+        // more than half of the rows are different
+        for (int r = 0; r < 60; r++) { users[r] = createUser(nextId++, random); }
+        view.resetCounts();
+        model.update(users, false);
+        QCOMPARE(view.resets, 1);
+        QCOMPARE(view.inserted + view.removed + view.moved + view.changed, 0);
+        QCOMPARE(view.rows.size(), users.size());
+        for (int r = 0; r < users.size(); r++) { QCOMPARE(view.rows[r], users[r]); }
+
+        // all rows removed
+        view.resetCounts();
+        model.update(CUserList(), false);
+        QCOMPARE(view.resets, 1);
+        QVERIFY(view.rows.isEmpty());
+    }
+
+    void CTestListModel::sortByCompareFunction()
+    {
+        CStatusMessageListModel model;
+        model.setMode(CStatusMessageListModel::Simplified);
+        const int severityColumn = 1; // sorted by severity as string
+        const int messageColumn = 2;
+
+        // severity by enum, not alphabetically as displayed
+        CStatusMessageList messages;
+        messages.push_back(CStatusMessage(CStatusMessage::SeverityWarning, u"w"));
+        messages.push_back(CStatusMessage(CStatusMessage::SeverityDebug, u"d"));
+        messages.push_back(CStatusMessage(CStatusMessage::SeverityError, u"e"));
+        messages.push_back(CStatusMessage(CStatusMessage::SeverityInfo, u"i"));
+        CStatusMessageList sorted = model.sortContainerByColumn(messages, severityColumn, Qt::AscendingOrder);
+        QCOMPARE(sorted.size(), 4);
+        QCOMPARE(sorted[0].getSeverity(), CStatusMessage::SeverityDebug);
+        QCOMPARE(sorted[1].getSeverity(), CStatusMessage::SeverityInfo);
+        QCOMPARE(sorted[2].getSeverity(), CStatusMessage::SeverityWarning);
+        QCOMPARE(sorted[3].getSeverity(), CStatusMessage::SeverityError);
+
+        // messages case sensitive
+        messages.clear();
+        messages.push_back(CStatusMessage(CStatusMessage::SeverityInfo, u"b"));
+        messages.push_back(CStatusMessage(CStatusMessage::SeverityInfo, u"A"));
+        messages.push_back(CStatusMessage(CStatusMessage::SeverityInfo, u"a"));
+        messages.push_back(CStatusMessage(CStatusMessage::SeverityInfo, u"B"));
+        sorted = model.sortContainerByColumn(messages, messageColumn, Qt::AscendingOrder);
+        QCOMPARE(sorted.size(), 4);
+        QCOMPARE(sorted[0].getMessage(), QStringLiteral("A"));
+        QCOMPARE(sorted[1].getMessage(), QStringLiteral("B"));
+        QCOMPARE(sorted[2].getMessage(), QStringLiteral("a"));
+        QCOMPARE(sorted[3].getMessage(), QStringLiteral("b"));
+    }
+
+    CUser CTestListModel::createUser(int id, QRandomGenerator &random)
+    {
+        return CUser(QString::number(1000000 + id), QStringLiteral("User %1").arg(random.generate()));
+    }
+
+    CTestListModel::Change CTestListModel::applyChange(Change change, CUserList &users, int &nextId, QRandomGenerator &random)
+    {
+        switch (change)
+        {
+        case Insert:
+            {
+                const int at = random.bounded(users.size() + 1);
+                const int count = 1 + random.bounded(5);
+                for (int i = 0; i < count; i++) { users.insert(users.begin() + at, createUser(nextId++, random)); }
+            }
+            break;
+        case Remove:
+            {
+                if (users.size() < 100) { return applyChange(Insert, users, nextId, random); }
+                const int at = random.bounded(users.size() - 5);
+                const int count = 1 + random.bounded(5);
+                users.erase(users.begin() + at, users.begin() + at + count);
+            }
+            break;
+        case Move:
+            {
+                const int from = random.bounded(users.size());
+                const CUser user = users[from];
+                users.erase(users.begin() + from);
+                users.insert(users.begin() + random.bounded(users.size() + 1), user);
+            }
+            break;
+        case Replace:
+            {
+                const int at = random.bounded(users.size());
+                CUser user = users[at];
+                user.setRealName(QStringLiteral("Renamed %1").arg(random.generate()));
+                users[at] = user;
+            }
+            break;
+        case Duplicate:
+            {
+                const CUser user = users[random.bounded(users.size())];
+                users.insert(users.begin() + random.bounded(users.size() + 1), user);
+            }
+            break;
+        case Mixed:
+        default:
+            {
+                const int changes = 2 + random.bounded(4);
+                for (int i = 0; i < changes; i++) { applyChange(static_cast<Change>(random.bounded(static_cast<int>(Mixed))), users, nextId, random); }
+            }
+            break;
+        }
+        return change;
+    }
+}
+
+//! main
+BLACKTEST_MAIN(BlackGuiTest::CTestListModel);
+
+#include "testlistmodel.moc"
+
+//! \endcond
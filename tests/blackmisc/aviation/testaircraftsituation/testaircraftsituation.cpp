@@ -13,6 +13,7 @@
 #include "blackconfig/buildconfig.h"
 #include "blackmisc/aviation/aircraftsituationchange.h"
 #include "blackmisc/aviation/aircraftsituationlist.h"
+#include "blackmisc/aviation/compactsituation.h"
 #include "blackmisc/network/fsdsetup.h"
 #include "blackmisc/cputime.h"
 // #include "blackmisc/math/mathutils.h"
@@ -64,6 +65,9 @@ namespace BlackMiscTest
         //! Using sort hint
         void sortHint();
 
+        //! Compact situation conversion
+        void compactSituation();
+
     private:
         //! Test situations (ascending)
         static BlackMisc::Aviation::CAircraftSituationList testSituations();
@@ -303,6 +307,63 @@ namespace BlackMiscTest
         }
     }
 
+    void CTestAircraftSituation::compactSituation()
+    {
+        const CCallsign callsign("DAMBZ");
+        CAircraftSituation situation = testSituations().front();
+        situation.setCallsign(callsign);
+        situation.setHeading(CHeading(123.0, CHeading::True, CAngleUnit::deg()));
+        situation.setPitch(CAngle(2.5, CAngleUnit::deg()));
+        situation.setBank(CAngle(-10.0, CAngleUnit::deg()));
+        situation.setGroundSpeed(CSpeed(250, CSpeedUnit::kts()));
+        situation.setCG(cg());
+        situation.setInterimFlag(true);
+        situation.setOnGround(CAircraftSituation::NotOnGround, CAircraftSituation::InFromNetwork);
+        const CElevationPlane ep(situation, CAltitude(500, CAltitude::MeanSeaLevel, CLengthUnit::ft()), CElevationPlane::singlePointRadius());
+        situation.setGroundElevation(ep, CAircraftSituation::FromProvider);
+
+        const CCompactSituation compact = CCompactSituation::fromSituation(situation);
+        QVERIFY(!compact.isNull());
+        QVERIFY(compact.hasGroundElevation());
+        QVERIFY(compact.hasFlag(CCompactSituation::Interim));
+        QCOMPARE(compact.getAdjustedMSecsSinceEpoch(), situation.getAdjustedMSecsSinceEpoch());
+        QCOMPARE(compact.getOnGround(), CAircraftSituation::NotOnGround);
+
+        const CAircraftSituation back = compact.toSituation(callsign);
+        QCOMPARE(back.getCallsign(), callsign);
+        QCOMPARE(back.getMSecsSinceEpoch(), situation.getMSecsSinceEpoch());
+        QCOMPARE(back.getTimeOffsetMs(), situation.getTimeOffsetMs());
+        QCOMPARE(back.getAltitude().valueRounded(CLengthUnit::ft(), 3), situation.getAltitude().valueRounded(CLengthUnit::ft(), 3));
+        QCOMPARE(back.getCorrectedAltitude().valueRounded(CLengthUnit::ft(), 3), situation.getCorrectedAltitude().valueRounded(CLengthUnit::ft(), 3));
+        QCOMPARE(back.getGroundElevation().valueRounded(CLengthUnit::ft(), 3), situation.getGroundElevation().valueRounded(CLengthUnit::ft(), 3));
+        QCOMPARE(back.getGroundElevationInfo(), CAircraftSituation::FromProvider);
+        QCOMPARE(back.getPosition().latitude().valueRounded(CAngleUnit::deg(), 6), situation.getPosition().latitude().valueRounded(CAngleUnit::deg(), 6));
+        QCOMPARE(back.getPosition().longitude().valueRounded(CAngleUnit::deg(), 6), situation.getPosition().longitude().valueRounded(CAngleUnit::deg(), 6));
+        QCOMPARE(back.getHeading().valueRounded(CAngleUnit::deg(), 3), situation.getHeading().valueRounded(CAngleUnit::deg(), 3));
+        QCOMPARE(back.getHeading().getReferenceNorth(), CHeading::True);
+        QCOMPARE(back.getPitch().valueRounded(CAngleUnit::deg(), 3), 2.5);
+        QCOMPARE(back.getBank().valueRounded(CAngleUnit::deg(), 3), -10.0);
+        QCOMPARE(back.getGroundSpeed().valueRounded(CSpeedUnit::kts(), 3), 250.0);
+        QCOMPARE(back.getCG().valueRounded(CLengthUnit::ft(), 3), cg().valueRounded(CLengthUnit::ft(), 3));
+        QCOMPARE(back.getOnGround(), CAircraftSituation::NotOnGround);
+        QCOMPARE(back.getOnGroundDetails(), CAircraftSituation::InFromNetwork);
+        QCOMPARE(back.getOnGroundFactor(), situation.getOnGroundFactor());
+        QVERIFY(back.isInterim());
+        QVERIFY(back.getPressureAltitude().isNull());
+        QVERIFY(back.getSceneryOffset().isNull());
+
+        // null values remain null
+        QVERIFY(CCompactSituation().isNull());
+        QVERIFY(CCompactSituation::fromSituation(CAircraftSituation::null()).isNull());
+        QVERIFY(CCompactSituation().toSituation(callsign).isNull());
+
+        // lists
+        const CAircraftSituationList situations = testSituations();
+        const QVector<CCompactSituation> compactList = CCompactSituation::fromSituations(situations);
+        QCOMPARE(compactList.size(), situations.size());
+        QCOMPARE(CCompactSituation::toSituations(compactList, callsign).size(), situations.size());
+    }
+
     CAircraftSituationList CTestAircraftSituation::testSituations()
     {
         // "Kugaaruk Airport","Pelly Bay","Canada","YBB","CYBB",68.534401,-89.808098,56,-7,"A","America/Edmonton","airport","OurAirports"
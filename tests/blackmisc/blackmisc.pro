@@ -13,7 +13,10 @@ SUBDIRS += \
     testdbus \
     testicon \
     testidentifier \
+    testjson \
     testlibrarypath \
+    testloghandler \
+    testparallel \
     testprocess \
     testpropertyindex \
     testsharedstate \
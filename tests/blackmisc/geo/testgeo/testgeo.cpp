@@ -11,17 +11,24 @@
 //! \ingroup testblackmisc
 
 #include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/geo/coordinategeodeticlist.h"
+#include "blackmisc/geo/geospatialindex.h"
 #include "blackmisc/geo/earthangle.h"
 #include "blackmisc/geo/latitude.h"
 #include "blackmisc/pq/physicalquantity.h"
 #include "blackmisc/pq/units.h"
+#include "blackmisc/simulation/elevationtilecache.h"
 #include "test.h"
 
+#include <QList>
+#include <QTemporaryDir>
 #include <QTest>
+#include <cmath>
 
 using namespace BlackMisc::Geo;
 using namespace BlackMisc::PhysicalQuantities;
 using namespace BlackMisc::Math;
+using namespace BlackMisc::Simulation;
 
 namespace BlackMiscTest
 {
@@ -36,6 +43,12 @@ namespace BlackMiscTest
 
         //! CCoordinateGeodetic unit tests
         void coordinateGeodetic();
+
+        //! Spatial index, results have to be the same as with the linear list functions
+        void spatialIndex();
+
+        //! Elevation tile cache, results have to be the same as with the linear list functions
+        void elevationTileCache();
     };
 
     void CTestGeo::geoBasics()
@@ -79,6 +92,118 @@ namespace BlackMiscTest
         latValue = testCoordinate.latitude().value(CAngleUnit::deg());
         QCOMPARE(latValue, newLat.value(CAngleUnit::deg()));
     }
+
+    void CTestGeo::spatialIndex()
+    {
+        // spread over the whole globe, including the poles and the date line
+        CCoordinateGeodeticList coordinates;
+        for (int i = 0; i < 2000; i++)
+        {
+            coordinates.push_back(CCoordinateGeodetic(std::fmod(i * 7.123, 180.0) - 90.0, std::fmod(i * 13.377, 360.0) - 180.0));
+        }
+        coordinates.push_back(CCoordinateGeodetic(90.0, 0.0));
+        coordinates.push_back(CCoordinateGeodetic(-90.0, 0.0));
+        coordinates.push_back(CCoordinateGeodetic(10.0, 180.0));
+        CGeoSpatialIndex index = CGeoSpatialIndex::fromObjects(coordinates);
+        QCOMPARE(index.size(), coordinates.size());
+
+        const QList<CCoordinateGeodetic> references({ { 0.0, 0.0 }, { 47.5, 8.5 }, { 89.9, 45.0 }, { -33.9, 151.2 }, { 10.0, -179.9 } });
+        const QList<CLength> ranges({ CLength(0, CLengthUnit::m()), CLength(50, CLengthUnit::km()), CLength(500, CLengthUnit::NM()), CLength(5000, CLengthUnit::km()), CLength(30000, CLengthUnit::km()) });
+        for (const CCoordinateGeodetic &reference : references)
+        {
+            for (const CLength &range : ranges)
+            {
+                QCOMPARE(coordinates.findWithinRange(index, reference, range), coordinates.findWithinRange(reference, range));
+                QCOMPARE(index.containsObjectInRange(reference, range), coordinates.containsObjectInRange(reference, range));
+                QCOMPARE(coordinates.findClosestWithinRange(index, reference, range), coordinates.findClosestWithinRange(reference, range));
+            }
+
+            // equal distances can be in any order, so compare the distances
+            for (int number : { 1, 5, 50, 5000 })
+            {
+                const CCoordinateGeodeticList byIndex = coordinates.findClosest(index, number, reference);
+                const CCoordinateGeodeticList byList = coordinates.findClosest(number, reference);
+                QCOMPARE(byIndex.size(), byList.size());
+                for (int i = 0; i < byIndex.size(); i++)
+                {
+                    QCOMPARE(calculateEuclideanDistanceSquared(byIndex[i], reference), calculateEuclideanDistanceSquared(byList[i], reference));
+                }
+            }
+        }
+
+        // incremental updates
+        const CCoordinateGeodetic zurich(47.46, 8.55);
+        const CLength range(10, CLengthUnit::km());
+        QVERIFY(!index.containsObjectInRange(zurich, range));
+        index.update(42, zurich);
+        coordinates[42] = zurich;
+        QCOMPARE(index.findWithinRange(zurich, range), CGeoSpatialIndex::Ids({ 42 }));
+        index.update(42, CCoordinateGeodetic());
+        QVERIFY(index.findWithinRange(zurich, range).isEmpty());
+        const int id = index.add(zurich);
+        QCOMPARE(id, coordinates.size());
+        QCOMPARE(index.findClosest(1, zurich), CGeoSpatialIndex::Ids({ id }));
+    }
+
+    void CTestGeo::elevationTileCache()
+    {
+        // around an airport and across the date line
+        CCoordinateGeodeticList elevations;
+        for (int i = 0; i < 500; i++)
+        {
+            elevations.push_back(CCoordinateGeodetic(47.4 + std::fmod(i * 0.00731, 0.15), 8.5 + std::fmod(i * 0.01377, 0.2), 1400.0 + i % 17));
+            elevations.push_back(CCoordinateGeodetic(-16.0 + std::fmod(i * 0.00731, 0.15), 179.9 + std::fmod(i * 0.01377, 0.2) - (i % 2 ? 360.0 : 0.0), 10.0));
+        }
+
+        CElevationTileCache cache;
+        for (const CCoordinateGeodetic &e : elevations) { cache.insert(e, true); }
+        QCOMPARE(cache.size(), elevations.size());
+        QCOMPARE(cache.sizeOnGround(), elevations.size());
+
+        const QList<CCoordinateGeodetic> references({ { 47.45, 8.55 }, { 47.3, 8.5 }, { -15.95, 179.99 }, { -15.95, -179.95 } });
+        const QList<CLength> ranges({ CLength(50, CLengthUnit::m()), CLength(500, CLengthUnit::m()), CLength(5, CLengthUnit::km()), CLength(100, CLengthUnit::km()) });
+        for (const CCoordinateGeodetic &reference : references)
+        {
+            for (const CLength &range : ranges)
+            {
+                QCOMPARE(cache.findWithinRange(reference, range).size(), elevations.findWithinRange(reference, range).size());
+                const CCoordinateGeodetic closest = elevations.findClosestWithinRange(reference, range);
+                const CElevationTileCache::Elevation found = cache.findClosestWithinRange(reference, range);
+                QCOMPARE(found.isNull(), closest.isNull());
+                if (!closest.isNull()) { QCOMPARE(calculateGreatCircleDistance(found.coordinate, reference), calculateGreatCircleDistance(closest, reference)); }
+                QCOMPARE(cache.findFirstWithinRange(reference, range).isNull(), closest.isNull());
+            }
+        }
+
+        // persisted
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString fn = dir.filePath("test.elv");
+        QVERIFY(cache.writeToFile(fn));
+        CElevationTileCache read;
+        QVERIFY(read.readFromFile(fn));
+        QCOMPARE(read.size(), cache.size());
+        QCOMPARE(read.tileCount(), cache.tileCount());
+        const CElevationTileCache::Elevation readElevation = read.findFirstWithinRange(elevations.front(), CLength(1, CLengthUnit::m()));
+        QVERIFY(readElevation.fromFile);
+        QVERIFY(readElevation.onGround);
+        QCOMPARE(readElevation.coordinate.geodeticHeight().value(CLengthUnit::ft()), 1400.0);
+        QVERIFY(!read.readFromFile(dir.filePath("missing.elv")));
+
+        // least recently used tiles are removed
+        cache.findFirstWithinRange(references.front(), CLength(5, CLengthUnit::km()));
+        cache.setMaxElevations(CElevationTileCache::MaxElevationsPerTile);
+        QVERIFY(cache.size() <= CElevationTileCache::MaxElevationsPerTile);
+        QVERIFY(!cache.findFirstWithinRange(references.front(), CLength(5, CLengthUnit::km())).isNull());
+        QVERIFY(cache.findFirstWithinRange(references[2], CLength(5, CLengthUnit::km())).isNull());
+
+        const int sizeBefore = cache.size();
+        QCOMPARE(cache.keepClosest(references.front(), 10), sizeBefore - 10);
+        QCOMPARE(cache.size(), 10);
+        cache.clear();
+        QVERIFY(cache.isEmpty());
+        QCOMPARE(cache.tileCount(), 0);
+    }
 } // ns
 
 //! main
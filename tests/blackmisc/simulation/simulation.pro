@@ -1,6 +1,9 @@
 TEMPLATE = subdirs
 SUBDIRS += \
+    testaircraftmodelsetindex \
+    testairspaceaircraftsnapshot \
     testinterpolatorlinear \
     testinterpolatormisc \
     testinterpolatorparts \
+    testmodelscanmanifest \
     testxplane \
@@ -0,0 +1,181 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/aircraftmodelsetindex.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/airlineicaocode.h"
+#include "blackmisc/aviation/livery.h"
+#include "blackmisc/country.h"
+#include "test.h"
+
+#include <QTest>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Simulation;
+
+namespace BlackMiscTest
+{
+    //! Model set index, results have to be the same as with the CAircraftModelList finders
+    class CTestAircraftModelSetIndex : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Finders on the index vs. finders on the list
+        void findersLikeList();
+
+        //! Model string and alias lookup
+        void modelStringLookup();
+
+        //! Filter ids by a predicate
+        void findByPredicate();
+
+        //! Intersect, unite and replace keep the order
+        void intersectAndUnite();
+
+    private:
+        //! Test models
+        static CAircraftModelList testModels();
+
+        //! Compare ids with expected models, including order
+        static bool sameModels(const CAircraftModelSetIndex &index, const CAircraftModelSetIndex::ModelIds &ids, const CAircraftModelList &expected);
+    };
+
+    void CTestAircraftModelSetIndex::findersLikeList()
+    {
+        const CAircraftModelList models = testModels();
+        const CAircraftModelSetIndex index(models);
+        QCOMPARE(index.size(), models.size());
+
+        for (const CAircraftModel &model : models)
+        {
+            const CAircraftIcaoCode &aircraft = model.getAircraftIcaoCode();
+            const CAirlineIcaoCode  &airline  = model.getAirlineIcaoCode();
+            QVERIFY(sameModels(index, index.findByIcaoDesignators(aircraft, CAirlineIcaoCode::null()), models.findByIcaoDesignators(aircraft, CAirlineIcaoCode::null())));
+            QVERIFY(sameModels(index, index.findByIcaoDesignators(CAircraftIcaoCode::null(), airline), models.findByIcaoDesignators(CAircraftIcaoCode::null(), airline)));
+            QVERIFY(sameModels(index, index.findByIcaoDesignators(aircraft, airline), models.findByIcaoDesignators(aircraft, airline)));
+            QVERIFY(sameModels(index, index.findByAircraftDesignatorAndLiveryCombinedCode(aircraft.getDesignator().toLower(), model.getLivery().getCombinedCode()), models.findByAircraftDesignatorAndLiveryCombinedCode(aircraft.getDesignator().toLower(), model.getLivery().getCombinedCode())));
+            QVERIFY(sameModels(index, index.findByAirlineGroup(airline), models.findByAirlineGroup(airline)));
+            QVERIFY(sameModels(index, index.findByFamily(aircraft.getFamily()), models.findByFamily(aircraft.getFamily())));
+            QVERIFY(sameModels(index, index.findByManufacturer(aircraft.getManufacturer()), models.findByManufacturer(aircraft.getManufacturer())));
+            QVERIFY(sameModels(index, index.findByCombinedType(aircraft.getCombinedType()), models.findByCombinedType(aircraft.getCombinedType())));
+            QVERIFY(sameModels(index, index.findByCombinedTypeWithColorLivery(aircraft.getCombinedType()), models.findByCombinedTypeWithColorLivery(aircraft.getCombinedType())));
+            QVERIFY(sameModels(index, index.findByCombinedAndManufacturer(aircraft), models.findByCombinedAndManufacturer(aircraft)));
+        }
+
+        // wildcards are resolved by the ICAO code
+        for (const QString &wildcard : { QStringLiteral("L*J"), QStringLiteral("L-J"), QStringLiteral("**P"), QStringLiteral("H1-") })
+        {
+            QVERIFY(sameModels(index, index.findByCombinedType(wildcard), models.findByCombinedType(wildcard)));
+        }
+
+        QVERIFY(sameModels(index, index.findByMilitaryFlag(true),  models.findByMilitaryFlag(true)));
+        QVERIFY(sameModels(index, index.findByMilitaryFlag(false), models.findByMilitaryFlag(false)));
+        QVERIFY(sameModels(index, index.findByVtolFlag(true),  models.findByVtolFlag(true)));
+        QVERIFY(sameModels(index, index.findByVtolFlag(false), models.findByVtolFlag(false)));
+        QVERIFY(index.findByFamily(QString()).isEmpty());
+        QVERIFY(index.findByCombinedType("L2").isEmpty());
+    }
+
+    void CTestAircraftModelSetIndex::modelStringLookup()
+    {
+        CAircraftModelList models = testModels();
+        models[2].setModelStringAlias("ALIAS");
+        models[3].setModelString("alias");
+        const CAircraftModelSetIndex index(models);
+
+        // first match by string or alias, case insensitive
+        QCOMPARE(index.findFirstByModelStringAlias("Alias"), 2);
+        QCOMPARE(index.findFirstByModelStringAlias("m1"), 1);
+        QCOMPARE(index.findFirstByModelStringAlias("unknown"), -1);
+        QCOMPARE(index.findFirstByModelStringAlias(QString()), -1);
+        QCOMPARE(index.model(index.findFirstByModelStringAlias("Alias")).getModelString(), models.findFirstByModelStringAliasOrDefault("Alias").getModelString());
+
+    }
+
+    void CTestAircraftModelSetIndex::findByPredicate()
+    {
+        // same model strings are still different models
+        CAircraftModelList models = testModels();
+        models[6].setModelString(models[0].getModelString());
+        const CAircraftModelSetIndex index(models);
+
+        using Ids = CAircraftModelSetIndex::ModelIds;
+        const auto isB738 = [](const CAircraftModel &model) { return model.getAircraftIcaoCode().getDesignator() == "B738"; };
+        QCOMPARE(index.findBy(Ids({ 6, 2, 0, 1 }), isB738), Ids({ 6, 0 }));
+        QVERIFY(index.findBy(Ids({ 2, 3 }), isB738).isEmpty());
+        QVERIFY(index.findBy(Ids(), isB738).isEmpty());
+    }
+
+    void CTestAircraftModelSetIndex::intersectAndUnite()
+    {
+        using Ids = CAircraftModelSetIndex::ModelIds;
+        QCOMPARE(CAircraftModelSetIndex::intersect(Ids({ 1, 3, 5, 7 }), Ids({ 3, 4, 7 })), Ids({ 3, 7 }));
+        QCOMPARE(CAircraftModelSetIndex::intersect(Ids({ 7, 1, 3 }), Ids({ 1, 3, 7 })), Ids({ 7, 1, 3 }));
+        QCOMPARE(CAircraftModelSetIndex::intersect(Ids({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }), Ids({ 9 })), Ids({ 9 }));
+        QVERIFY(CAircraftModelSetIndex::intersect(Ids(), Ids({ 1 })).isEmpty());
+        QCOMPARE(CAircraftModelSetIndex::unite(Ids({ 5, 2 }), Ids({ 1, 2, 6 })), Ids({ 5, 2, 1, 6 }));
+        QCOMPARE(CAircraftModelSetIndex::unite(Ids(), Ids({ 1 })), Ids({ 1 }));
+
+        // as CAircraftModelList::replaceOrAddModelsWithString, replaced ids move to the end
+        QCOMPARE(CAircraftModelSetIndex::replaceOrAdd(Ids({ 5, 2, 7 }), Ids({ 6, 2 })), Ids({ 5, 7, 6, 2 }));
+        QCOMPARE(CAircraftModelSetIndex::replaceOrAdd(Ids(), Ids({ 1 })), Ids({ 1 }));
+        QCOMPARE(CAircraftModelSetIndex::replaceOrAdd(Ids({ 1 }), Ids()), Ids({ 1 }));
+    }
+
+    CAircraftModelList CTestAircraftModelSetIndex::testModels()
+    {
+        CAirlineIcaoCode dlh("DLH", "Lufthansa", CCountry("DE", "Germany"), "LUFTHANSA", false, true);
+        dlh.setGroupId(1);
+        dlh.setGroupDesignator("LHG");
+        CAirlineIcaoCode swr("SWR", "Swiss", CCountry("CH", "Switzerland"), "SWISS", false, true);
+        swr.setGroupId(1);
+        swr.setGroupDesignator("LHG");
+        const CAirlineIcaoCode baw("BAW", "British Airways", CCountry("GB", "United Kingdom"), "SPEEDBIRD", false, true);
+
+        CAircraftIcaoCode b738("B738", "L2J", "Boeing", "737-800", "M", true, false, false, 0);
+        b738.setFamily("B737");
+        CAircraftIcaoCode b737("B737", "L2J", "BOEING", "737-700", "M", true, false, false, 0);
+        b737.setFamily("B737");
+        CAircraftIcaoCode a320("A320", "L2J", "AIRBUS", "A320", "M", true, false, false, 0);
+        a320.setFamily("A320");
+        const CAircraftIcaoCode c172("C172", "L1P", "CESSNA", "172", "L", true, false, false, 0);
+        const CAircraftIcaoCode h60("H60", "H2T", "SIKORSKY", "Black Hawk", "L", true, false, true, 0);
+        const CAircraftIcaoCode uhel("UHEL", "H1T", "", "Helicopter", "L", true, false, false, 0);
+
+        const CLivery color(CLivery::colorLiveryMarker() + "FF0000FF0000", CAirlineIcaoCode(), "red", "red", "red", false);
+        CAircraftModelList models;
+        models.push_back(CAircraftModel("M0", CAircraftModel::TypeUnknown, "", b738, CLivery(CLivery::getStandardCode(dlh), dlh, "std")));
+        models.push_back(CAircraftModel("M1", CAircraftModel::TypeUnknown, "", b737, CLivery(CLivery::getStandardCode(swr), swr, "std")));
+        models.push_back(CAircraftModel("M2", CAircraftModel::TypeUnknown, "", a320, CLivery(CLivery::getStandardCode(baw), baw, "std")));
+        models.push_back(CAircraftModel("M3", CAircraftModel::TypeUnknown, "", c172, color));
+        models.push_back(CAircraftModel("M4", CAircraftModel::TypeUnknown, "", h60, color));
+        models.push_back(CAircraftModel("M5", CAircraftModel::TypeUnknown, "", uhel));
+        models.push_back(CAircraftModel("M6", CAircraftModel::TypeUnknown, "", b738, color));
+        models.push_back(CAircraftModel("M7", CAircraftModel::TypeUnknown, "", a320, CLivery(CLivery::getStandardCode(dlh), dlh, "std")));
+        return models;
+    }
+
+    bool CTestAircraftModelSetIndex::sameModels(const CAircraftModelSetIndex &index, const CAircraftModelSetIndex::ModelIds &ids, const CAircraftModelList &expected)
+    {
+        return index.toModels(ids).getModelStringList(false) == expected.getModelStringList(false);
+    }
+}
+
+//! main
+BLACKTEST_MAIN(BlackMiscTest::CTestAircraftModelSetIndex);
+
+#include "testaircraftmodelsetindex.moc"
+
+//! \endcond
@@ -0,0 +1,117 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/airspaceaircraftsnapshot.h"
+#include "blackmisc/simulation/simulatedaircraftlist.h"
+#include "blackmisc/simulation/simulatedaircraft.h"
+#include "blackmisc/aviation/callsignset.h"
+#include "blackmisc/pq/length.h"
+#include "test.h"
+
+#include <QTest>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::PhysicalQuantities;
+using namespace BlackMisc::Simulation;
+
+namespace BlackMiscTest
+{
+    //! Airspace snapshot delta and the decision when the simulator has to be reconciled
+    class CTestAirspaceAircraftSnapshot : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Snapshots without delta or version always require a reconcile
+        void unversionedSnapshot();
+
+        //! A following snapshot without rendering changes is skipped
+        void deltaEarlyOut();
+
+        //! Every FullReconcileInterval versions a reconcile is done anyway
+        void periodicReconcile();
+
+    private:
+        //! Restricted snapshot with the given version and delta
+        static CAirspaceAircraftSnapshot snapshot(qint64 version, const CCallsignSet &added = {}, const CCallsignSet &removed = {}, const CCallsignSet &renderingChanged = {});
+    };
+
+    void CTestAirspaceAircraftSnapshot::unversionedSnapshot()
+    {
+        const CAirspaceAircraftSnapshot unversioned = CAirspaceAircraftSnapshot::fromAircraftByDistance({ CSimulatedAircraft("DLH123", {}, {}) }, true, true, 10, CLength(0, nullptr));
+        QVERIFY(!unversioned.hasDelta());
+        QVERIFY(unversioned.hasRenderingChanges());
+        QVERIFY(unversioned.isReconcileRequired(-1));
+        QVERIFY(unversioned.isReconcileRequired(unversioned.getVersion() - 1));
+
+        // versioned, but no delta
+        CAirspaceAircraftSnapshot noDelta(unversioned);
+        noDelta.setVersion(1);
+        QVERIFY(noDelta.isReconcileRequired(0));
+    }
+
+    void CTestAirspaceAircraftSnapshot::deltaEarlyOut()
+    {
+        const CCallsignSet callsigns({ CCallsign("DLH123") });
+
+        // directly following, nothing changed
+        QVERIFY(!snapshot(1).hasRenderingChanges());
+        QVERIFY(!snapshot(1).isReconcileRequired(0));
+        QVERIFY(!snapshot(2).isReconcileRequired(1));
+
+        // a snapshot was missed, the delta is incomplete
+        QVERIFY(snapshot(3).isReconcileRequired(1));
+        QVERIFY(snapshot(3).isReconcileRequired(3));
+
+        // rendering relevant changes
+        QVERIFY(snapshot(2, callsigns).isReconcileRequired(1));
+        QVERIFY(snapshot(2, {}, callsigns).isReconcileRequired(1));
+        QVERIFY(snapshot(2, {}, {}, callsigns).isReconcileRequired(1));
+
+        // restriction changed
+        CAirspaceAircraftSnapshot unrestricted = CAirspaceAircraftSnapshot::fromAircraftByDistance({}, false, true, 10, CLength(0, nullptr));
+        CAirspaceAircraftSnapshot restricted = snapshot(2);
+        restricted.setRestrictionChanged(unrestricted);
+        QVERIFY(restricted.isRestrictionChanged());
+        QVERIFY(restricted.isReconcileRequired(1));
+    }
+
+    void CTestAirspaceAircraftSnapshot::periodicReconcile()
+    {
+        int reconciles = 0;
+        qint64 handled = 0;
+        const int versions = 3 * CAirspaceAircraftSnapshot::FullReconcileInterval;
+        for (qint64 version = 1; version <= versions; ++version)
+        {
+            if (snapshot(version).isReconcileRequired(handled)) { reconciles++; }
+            handled = version;
+        }
+        QCOMPARE(reconciles, 3);
+        QVERIFY(snapshot(CAirspaceAircraftSnapshot::FullReconcileInterval).isReconcileRequired(CAirspaceAircraftSnapshot::FullReconcileInterval - 1));
+    }
+
+    CAirspaceAircraftSnapshot CTestAirspaceAircraftSnapshot::snapshot(qint64 version, const CCallsignSet &added, const CCallsignSet &removed, const CCallsignSet &renderingChanged)
+    {
+        CAirspaceAircraftSnapshot snapshot = CAirspaceAircraftSnapshot::fromAircraftByDistance({ CSimulatedAircraft("DLH123", {}, {}) }, true, true, 10, CLength(0, nullptr));
+        snapshot.setDelta(added, removed, renderingChanged);
+        snapshot.setVersion(version);
+        return snapshot;
+    }
+}
+
+//! main
+BLACKTEST_MAIN(BlackMiscTest::CTestAirspaceAircraftSnapshot);
+
+#include "testairspaceaircraftsnapshot.moc"
+
+//! \endcond
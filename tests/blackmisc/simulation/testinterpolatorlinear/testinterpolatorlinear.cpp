@@ -10,8 +10,12 @@
 //! \file
 //! \ingroup testblackmisc
 
+#include "blackmisc/simulation/interpolationbatch.h"
+#include "blackmisc/simulation/interpolationlogger.h"
+#include "blackmisc/simulation/interpolationtrace.h"
 #include "blackmisc/simulation/interpolator.h"
 #include "blackmisc/simulation/interpolatorlinear.h"
+#include "blackmisc/simulation/interpolatormulti.h"
 #include "blackmisc/simulation/remoteaircraftproviderdummy.h"
 #include "blackmisc/aviation/aircraftengine.h"
 #include "blackmisc/aviation/aircraftenginelist.h"
@@ -34,11 +38,14 @@
 
 #include <QCoreApplication>
 #include <QDebug>
+#include <QDir>
 #include <QEventLoop>
+#include <QFile>
 #include <QScopedPointer>
 #include <QTest>
 #include <QTime>
 #include <QtDebug>
+#include <algorithm>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Aviation;
@@ -60,6 +67,12 @@ namespace BlackMiscTest
         //! Interpolator PBH
         void pbhInterpolatorTest();
 
+        //! Batch interpolation of several aircraft, as used by the drivers
+        void batchInterpolationTest();
+
+        //! Recorded interpolation trace replayed
+        void traceReplayTest();
+
     private:
         //! Test situation for testing
         static BlackMisc::Aviation::CAircraftSituation getTestSituation(const BlackMisc::Aviation::CCallsign &callsign, int number, qint64 ts, qint64 deltaT, qint64 offset);
@@ -320,6 +333,125 @@ namespace BlackMiscTest
         }
     }
 
+    void CTestInterpolatorLinear::batchInterpolationTest()
+    {
+        const CCallsign cs1("SWIFT1");
+        const CCallsign cs2("SWIFT2");
+        CRemoteAircraftProviderDummy provider;
+        CInterpolatorMulti interpolator(cs1, nullptr, nullptr, &provider);
+        CInterpolatorMulti batchInterpolator1(cs1, nullptr, nullptr, &provider);
+        CInterpolatorMulti batchInterpolator2(cs2, nullptr, nullptr, &provider);
+
+        const qint64 ts = 1425000000000;
+        const qint64 deltaT = 5000; // ms
+        const qint64 offset = 5000; // ms
+        for (int i = IRemoteAircraftProvider::MaxSituationsPerCallsign - 1; i >= 0; i--)
+        {
+            provider.insertNewSituation(getTestSituation(cs1, i, ts, deltaT, offset));
+            provider.insertNewSituation(getTestSituation(cs2, i, ts, deltaT, offset));
+        }
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 1000);
+
+        CInterpolationBatch batch;
+        for (CInterpolationAndRenderingSetupBase::InterpolatorMode mode : { CInterpolationAndRenderingSetupBase::Linear, CInterpolationAndRenderingSetupBase::Spline })
+        {
+            CInterpolationAndRenderingSetupPerCallsign setup;
+            setup.setInterpolatorMode(mode);
+            for (qint64 currentTime = ts - 2 * deltaT + offset; currentTime < ts; currentTime += deltaT / 20)
+            {
+                const CInterpolationResult single = interpolator.getInterpolation(currentTime, setup, 0);
+
+                // the aircraft are added for every step like in the drivers
+                batch.clear();
+                QCOMPARE(batch.add(&batchInterpolator1, setup, 0), 0);
+                QCOMPARE(batch.add(nullptr, setup, 1), 1);
+                QCOMPARE(batch.add(&batchInterpolator2, setup, 2), 2);
+                const QVector<CInterpolationResult> &results = batch.interpolate(currentTime);
+                QCOMPARE(results.size(), 3);
+                QVERIFY2(results[0].getInterpolationStatus().isInterpolated(), "Value was not interpolated");
+                QVERIFY2(!results[1].getInterpolationStatus().isInterpolated(), "No interpolator, no interpolation");
+                QVERIFY2(results[2].getInterpolationStatus().isInterpolated(), "Value was not interpolated");
+
+                // same as the single interpolation
+                const CAircraftSituation s(single);
+                const CAircraftSituation s1(results[0]);
+                const CAircraftSituation s2(results[2]);
+                QCOMPARE(s1.getCallsign(), cs1);
+                QCOMPARE(s2.getCallsign(), cs2);
+                QCOMPARE(s1.getPosition().latitude().valueRounded(CAngleUnit::deg(), 5), s.getPosition().latitude().valueRounded(CAngleUnit::deg(), 5));
+                QCOMPARE(s1.getPosition().longitude().valueRounded(CAngleUnit::deg(), 5), s.getPosition().longitude().valueRounded(CAngleUnit::deg(), 5));
+                QCOMPARE(s1.getAltitude().valueRounded(CLengthUnit::ft(), 1), s.getAltitude().valueRounded(CLengthUnit::ft(), 1));
+                QCOMPARE(s1.getHeading().valueRounded(CAngleUnit::deg(), 3), s.getHeading().valueRounded(CAngleUnit::deg(), 3));
+                QCOMPARE(s1.getOnGround(), s.getOnGround());
+                QCOMPARE(s2.getPosition().latitude().valueRounded(CAngleUnit::deg(), 5), s1.getPosition().latitude().valueRounded(CAngleUnit::deg(), 5));
+            }
+        }
+    }
+
+    void CTestInterpolatorLinear::traceReplayTest()
+    {
+        const CCallsign cs("SWIFT");
+        CRemoteAircraftProviderDummy provider;
+        CInterpolationLogger logger;
+        logger.traceRecorder().setEnabled(true);
+        CInterpolatorLinear interpolator(cs, nullptr, nullptr, &provider, &logger);
+
+        const qint64 ts = 1425000000000;
+        const qint64 deltaT = 5000; // ms
+        const qint64 offset = 5000; // ms
+        for (int i = IRemoteAircraftProvider::MaxSituationsPerCallsign - 1; i >= 0; i--)
+        {
+            provider.insertNewSituation(getTestSituation(cs, i, ts, deltaT, offset));
+        }
+        for (int i = 9; i >= 0; i--)
+        {
+            provider.insertNewAircraftParts(cs, getTestParts(i, ts, deltaT), false);
+        }
+
+        const CInterpolationAndRenderingSetupPerCallsign setup;
+        int steps = 0;
+        for (qint64 currentTime = ts - 2 * deltaT + offset; currentTime < ts; currentTime += deltaT / 20)
+        {
+            QVERIFY2(interpolator.getInterpolation(currentTime, setup, 0).getInterpolationStatus().isInterpolated(), "Value was not interpolated");
+            steps++;
+        }
+
+        // compact parts
+        const CAircraftParts parts = getTestParts(0, ts, deltaT);
+        const CAircraftParts compactParts = CCompactParts::fromParts(parts).toParts();
+        QVERIFY2(compactParts.getLights() == parts.getLights(), "Wrong lights");
+        QVERIFY2(compactParts.getEngines() == parts.getEngines(), "Wrong engines");
+        QVERIFY2(compactParts.isGearDown() == parts.isGearDown() && compactParts.getFlapsPercent() == parts.getFlapsPercent(), "Wrong gear/flaps");
+        QVERIFY2(compactParts.getMSecsSinceEpoch() == parts.getMSecsSinceEpoch(), "Wrong timestamp");
+
+        // file round trip
+        const CInterpolationTrace trace = logger.traceRecorder().getTrace();
+        QVERIFY2(trace.getSteps().size() == steps, "Wrong number of steps");
+        QVERIFY2(!trace.getInputs().isEmpty(), "Missing inputs");
+        const QString fn = QDir::temp().filePath("testinterpolatorlinear.trace");
+        QVERIFY2(trace.writeToFile(fn), "Cannot write trace");
+        CInterpolationTrace readTrace;
+        const bool read = readTrace.readFromFile(fn);
+        QFile::remove(fn);
+        QVERIFY2(read, "Cannot read trace");
+        QVERIFY2(readTrace.getSteps().size() == steps && readTrace.getInputs().size() == trace.getInputs().size(), "Wrong trace read");
+
+        // replay gives the recorded positions
+        const CInterpolationTrace::ReplayStatistics statistics = readTrace.replay();
+        QVERIFY2(statistics.steps == steps, "Wrong number of replayed steps");
+        QVERIFY2(statistics.statusChanged == 0, "Replay interpolated differently");
+        QVERIFY2(statistics.deviating == 0, qPrintable(statistics.toQString()));
+
+        // after clearing, the situations already seen are recorded again
+        logger.traceRecorder().clear();
+        QVERIFY2(interpolator.getInterpolation(ts - deltaT, setup, 0).getInterpolationStatus().isInterpolated(), "Value was not interpolated");
+        const CInterpolationTrace cleared = logger.traceRecorder().getTrace();
+        QVERIFY2(cleared.getSteps().size() == 1, "Wrong number of steps after clear");
+        const auto isSituation = [](const CInterpolationTrace::InputRecord &input) { return !input.isParts; };
+        QVERIFY2(std::count_if(cleared.getInputs().begin(), cleared.getInputs().end(), isSituation) ==
+                 std::count_if(trace.getInputs().begin(), trace.getInputs().end(), isSituation), "Situations not recorded again");
+    }
+
     CAircraftSituation CTestInterpolatorLinear::getTestSituation(const CCallsign &callsign, int number, qint64 ts, qint64 deltaT, qint64 offset)
     {
         const CAltitude alt(number, CAltitude::MeanSeaLevel, CLengthUnit::m());
@@ -0,0 +1,244 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/fscommon/aircraftcfgparser.h"
+#include "blackmisc/simulation/fscommon/aircraftcfgentrieslist.h"
+#include "blackmisc/simulation/modelscanmanifest.h"
+#include "blackmisc/simulation/simulatorinfo.h"
+#include "blackmisc/statusmessagelist.h"
+#include "test.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Simulation;
+using namespace BlackMisc::Simulation::FsCommon;
+
+namespace BlackMiscTest
+{
+    //! Model scan manifest and incremental scans of model directories
+    class CTestModelScanManifest : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Lookup of unchanged files and files with the same content
+        void lookup();
+
+        //! Writing and reading the manifest file
+        void manifestFile();
+
+        //! Entries of directories not scanned are kept
+        void replaceDirectories();
+
+        //! Incremental scans give the same entries as full scans
+        void incrementalScan();
+
+    private:
+        //! Write a file, creating its directory
+        static bool writeFile(const QString &filePath, const QByteArray &content);
+
+        //! aircraft.cfg with the given titles, plus the *.air file needed by the parser
+        static bool writeAircraftCfg(const QString &directory, const QStringList &titles);
+
+        //! Set the modification time of a file
+        static bool touchFile(const QString &filePath, const QDateTime &timestamp);
+    };
+
+    void CTestModelScanManifest::lookup()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY2(tempDir.isValid(), "Invalid directory");
+        const QString filePath = tempDir.filePath("aircraft.cfg");
+        const QByteArray content("[FLTSIM.0]\ntitle=Test\n");
+        QVERIFY(writeFile(filePath, content));
+
+        CModelScanManifest manifest;
+        const QByteArray hash = CModelScanManifest::contentHash(content);
+        manifest.insert(filePath, CModelScanManifest::createEntry(QFileInfo(filePath), hash, "parsed"));
+        QVERIFY(manifest.contains(filePath));
+        QCOMPARE(manifest.size(), 1);
+
+        CModelScanManifest::Entry entry;
+        QVERIFY(manifest.findUnchanged(filePath, QFileInfo(filePath), entry));
+        QCOMPARE(entry.parsed, QByteArray("parsed"));
+        QVERIFY(!manifest.findUnchanged(tempDir.filePath("other.cfg"), QFileInfo(filePath), entry));
+
+        // touched, same content
+        QVERIFY(touchFile(filePath, QFileInfo(filePath).lastModified().addSecs(-3600)));
+        QVERIFY(!manifest.findUnchanged(filePath, QFileInfo(filePath), entry));
+        QVERIFY(manifest.findSameContent(filePath, hash, entry));
+
+        // changed content
+        QVERIFY(writeFile(filePath, content + "description=changed\n"));
+        QVERIFY(!manifest.findUnchanged(filePath, QFileInfo(filePath), entry));
+        QVERIFY(!manifest.findSameContent(filePath, CModelScanManifest::contentHash(content + "description=changed\n"), entry));
+        QVERIFY(!manifest.findSameContent(filePath, {}, entry));
+    }
+
+    void CTestModelScanManifest::manifestFile()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY2(tempDir.isValid(), "Invalid directory");
+        const QString cfgFile = tempDir.filePath("aircraft.cfg");
+        QVERIFY(writeFile(cfgFile, "[FLTSIM.0]\ntitle=Test\n"));
+
+        constexpr quint32 parserVersion = 3;
+        CModelScanManifest manifest(parserVersion);
+        manifest.insert(cfgFile, CModelScanManifest::createEntry(QFileInfo(cfgFile), "hash", "parsed"));
+        manifest.insert(tempDir.filePath("sim.cfg"), CModelScanManifest::createEntry(QFileInfo(cfgFile), {}, {}));
+        const QString manifestFile = tempDir.filePath("modelscan/test.manifest");
+        QVERIFY(manifest.writeToFile(manifestFile));
+
+        CModelScanManifest read(parserVersion);
+        QVERIFY(read.readFromFile(manifestFile));
+        QCOMPARE(read.size(), 2);
+        CModelScanManifest::Entry entry;
+        QVERIFY(read.findUnchanged(cfgFile, QFileInfo(cfgFile), entry));
+        QCOMPARE(entry.contentHash, QByteArray("hash"));
+        QCOMPARE(entry.parsed, QByteArray("parsed"));
+
+        // written by another parser version
+        CModelScanManifest otherVersion(parserVersion + 1);
+        QVERIFY(!otherVersion.readFromFile(manifestFile));
+        QVERIFY(otherVersion.isEmpty());
+
+        // truncated, all or nothing
+        QFile file(manifestFile);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QVERIFY(file.resize(file.size() - 4));
+        file.close();
+        QVERIFY(!read.readFromFile(manifestFile));
+        QCOMPARE(read.size(), 2);
+        QVERIFY(!read.readFromFile(tempDir.filePath("missing.manifest")));
+    }
+
+    void CTestModelScanManifest::replaceDirectories()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY2(tempDir.isValid(), "Invalid directory");
+        const QDir root(tempDir.path());
+
+        CModelScanManifest manifest;
+        const CModelScanManifest::Entry entry;
+        manifest.insert(root.absoluteFilePath("a/removed.cfg"), entry);
+        manifest.insert(root.absoluteFilePath("a/sub/removed.cfg"), entry);
+        manifest.insert(root.absoluteFilePath("a/kept.cfg"), entry);
+        manifest.insert(root.absoluteFilePath("b/other.cfg"), entry);
+        manifest.insert(root.absoluteFilePath("ab/other.cfg"), entry);
+
+        CModelScanManifest scanned;
+        scanned.insert(root.absoluteFilePath("a/kept.cfg"), entry);
+        scanned.insert(root.absoluteFilePath("a/new.cfg"), entry);
+
+        manifest.replaceDirectories({ root.absoluteFilePath("a") + "/" }, scanned);
+        QCOMPARE(manifest.size(), 4);
+        QVERIFY(!manifest.contains(root.absoluteFilePath("a/removed.cfg")));
+        QVERIFY(!manifest.contains(root.absoluteFilePath("a/sub/removed.cfg")));
+        QVERIFY(manifest.contains(root.absoluteFilePath("a/kept.cfg")));
+        QVERIFY(manifest.contains(root.absoluteFilePath("a/new.cfg")));
+        QVERIFY(manifest.contains(root.absoluteFilePath("b/other.cfg")));
+        QVERIFY(manifest.contains(root.absoluteFilePath("ab/other.cfg"))); // same prefix, but another directory
+    }
+
+    void CTestModelScanManifest::incrementalScan()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY2(tempDir.isValid(), "Invalid directory");
+        const QDir root(tempDir.filePath("SimObjects"));
+        const QString manifestFile = tempDir.filePath("modelscan/aircraftcfg.manifest");
+
+        QVERIFY(writeAircraftCfg(root.absoluteFilePath("Airplanes/A320"), { "A320 Lufthansa", "A320 Swiss" }));
+        QVERIFY(writeAircraftCfg(root.absoluteFilePath("Airplanes/B737"), { "B737 Ryanair" }));
+        QVERIFY(writeAircraftCfg(root.absoluteFilePath("Airplanes/B737/Variants/B737-800"), { "B737-800 KLM" }));
+        QVERIFY(writeAircraftCfg(root.absoluteFilePath("Rotorcraft/Bell"), { "Bell 206" }));
+
+        CAircraftCfgParser parser(CSimulatorInfo::fsx());
+        const QStringList directories({ root.absolutePath() });
+        const auto compareScans = [&](int expectedEntries)
+        {
+            CStatusMessageList fullMessages;
+            CStatusMessageList incrementalMessages;
+            const CAircraftCfgEntriesList full = parser.parseDirectories(directories, {}, {}, fullMessages);
+            const CAircraftCfgEntriesList incremental = parser.parseDirectories(directories, {}, manifestFile, incrementalMessages);
+            QCOMPARE(full.size(), expectedEntries);
+            QCOMPARE(incremental, full);
+            QCOMPARE(incrementalMessages.size(), fullMessages.size());
+        };
+
+        // first scan writes the manifest, the second one uses it
+        compareScans(5);
+        compareScans(5);
+        CModelScanManifest manifest;
+        QVERIFY(manifest.readFromFile(manifestFile));
+        QCOMPARE(manifest.size(), 4);
+
+        // changed, touched, added and removed files
+        QVERIFY(writeAircraftCfg(root.absoluteFilePath("Airplanes/A320"), { "A320 Lufthansa", "A320 Swiss", "A320 Austrian" }));
+        const QString b737 = root.absoluteFilePath("Airplanes/B737/aircraft.cfg");
+        QVERIFY(touchFile(b737, QFileInfo(b737).lastModified().addSecs(3600)));
+        QVERIFY(writeAircraftCfg(root.absoluteFilePath("Airplanes/DHC6"), { "DHC6 Twin Otter" }));
+        QVERIFY(QDir(root.absoluteFilePath("Rotorcraft")).removeRecursively());
+        compareScans(6);
+        compareScans(6);
+        QVERIFY(manifest.readFromFile(manifestFile));
+        QCOMPARE(manifest.size(), 4);
+
+        // a scan of some directories keeps the entries of the others
+        CStatusMessageList messages;
+        const CAircraftCfgEntriesList partial = parser.parseDirectories({ root.absoluteFilePath("Airplanes/B737") }, {}, manifestFile, messages);
+        QCOMPARE(partial.size(), 2);
+        QVERIFY(manifest.readFromFile(manifestFile));
+        QCOMPARE(manifest.size(), 4);
+        QVERIFY(manifest.contains(root.absoluteFilePath("Airplanes/A320/aircraft.cfg")));
+        QVERIFY(manifest.contains(root.absoluteFilePath("Airplanes/DHC6/aircraft.cfg")));
+        compareScans(6);
+    }
+
+    bool CTestModelScanManifest::writeFile(const QString &filePath, const QByteArray &content)
+    {
+        if (!QDir().mkpath(QFileInfo(filePath).absolutePath())) { return false; }
+        QFile file(filePath);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) { return false; }
+        return file.write(content) == content.size();
+    }
+
+    bool CTestModelScanManifest::writeAircraftCfg(const QString &directory, const QStringList &titles)
+    {
+        QByteArray content("[GENERAL]\natc_type=TEST\n\n");
+        for (int i = 0; i < titles.size(); i++)
+        {
+            content += "[FLTSIM." + QByteArray::number(i) + "]\ntitle=" + titles[i].toUtf8() + "\ntexture=" + QByteArray::number(i) + "\n\n";
+        }
+        return writeFile(QDir(directory).absoluteFilePath("aircraft.cfg"), content) &&
+               writeFile(QDir(directory).absoluteFilePath("model.air"), "air");
+    }
+
+    bool CTestModelScanManifest::touchFile(const QString &filePath, const QDateTime &timestamp)
+    {
+        QFile file(filePath);
+        if (!file.open(QIODevice::ReadWrite)) { return false; }
+        return file.setFileTime(timestamp, QFileDevice::FileModificationTime);
+    }
+}
+
+//! main
+BLACKTEST_MAIN(BlackMiscTest::CTestModelScanManifest);
+
+#include "testmodelscanmanifest.moc"
+
+//! \endcond
@@ -11,6 +11,7 @@
 //! \ingroup testblackmisc
 
 #include "blackmisc/simulation/xplane/qtfreeutils.h"
+#include "blackmisc/simulation/xplane/qtfreetrafficframe.h"
 #include "blackmisc/simulation/settings/xswiftbussettings.h"
 #include "blackmisc/simulation/settings/xswiftbussettingsqtfree.inc"
 #include "blackmisc/swiftdirectories.h"
@@ -18,6 +19,7 @@
 #include "test.h"
 
 #include <QTest>
+#include <vector>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Simulation::XPlane::QtFreeUtils;
@@ -38,6 +40,7 @@ namespace BlackMiscTest
         void acfPropertiesTest();
         void xSwiftBusSettingsTest();
         void qtFreeUtils();
+        void trafficFrameTest();
     };
 
     void CTestXPlane::getFileNameTest()
@@ -178,6 +181,64 @@ namespace BlackMiscTest
         vOut = normalizeValue(-190, -180.0, 180.0);
         QVERIFY2(qFuzzyCompare(170, vOut), "Wrong normalize +-180");
     }
+
+    void CTestXPlane::trafficFrameTest()
+    {
+        using namespace BlackMisc::Simulation::XPlane::QtFreeTrafficFrame;
+
+        std::vector<PlaneRecord> records(3);
+        records[0].planeId = 1;
+        records[0].changedMask = Position | Transponder;
+        records[0].latitudeDeg = 48.353889;
+        records[0].longitudeDeg = 11.786111;
+        records[0].altitudeFt = 1487.5;
+        records[0].headingDeg = 260.0f;
+        records[0].onGround = 1;
+        records[0].transponderCode = 7000;
+        records[0].transponderFlags = ModeC;
+        records[1].planeId = 2;
+        records[1].changedMask = Surfaces;
+        records[1].flaps = 0.5f;
+        records[1].lights = LandLight | NavLight;
+        records[2].planeId = 70000;
+        records[2].changedMask = Transponder;
+        records[2].transponderFlags = ModeC | Ident;
+
+        std::vector<char> frame(frameSize(records.size()));
+        writeFrame(records.data(), records.size(), frame.data());
+
+        std::vector<PlaneRecord> read;
+        QVERIFY2(readFrame(frame.data(), frame.size(), read), "Cannot read frame");
+        QCOMPARE(read.size(), records.size());
+        QCOMPARE(read[0].planeId, 1u);
+        QCOMPARE(read[0].changedMask, static_cast<std::uint32_t>(Position | Transponder));
+        QCOMPARE(read[0].latitudeDeg, 48.353889);
+        QCOMPARE(read[0].longitudeDeg, 11.786111);
+        QCOMPARE(read[0].altitudeFt, 1487.5);
+        QCOMPARE(read[0].headingDeg, 260.0f);
+        QCOMPARE(read[0].onGround, static_cast<std::uint8_t>(1));
+        QCOMPARE(read[0].transponderCode, 7000);
+        QCOMPARE(read[1].flaps, 0.5f);
+        QCOMPARE(read[1].lights, static_cast<std::uint8_t>(LandLight | NavLight));
+        QCOMPARE(read[2].planeId, 70000u);
+        QCOMPARE(read[2].transponderFlags, static_cast<std::uint8_t>(ModeC | Ident));
+
+        // empty frame is valid
+        std::vector<char> emptyFrame(frameSize(0));
+        writeFrame(nullptr, 0, emptyFrame.data());
+        QVERIFY(readFrame(emptyFrame.data(), emptyFrame.size(), read));
+        QVERIFY(read.empty());
+
+        // truncated, wrong magic, other version
+        QVERIFY(!readFrame(frame.data(), frame.size() - 1, read));
+        QVERIFY(!readFrame(frame.data(), 4, read));
+        std::vector<char> wrong(frame);
+        wrong[0] = 'Y';
+        QVERIFY(!readFrame(wrong.data(), wrong.size(), read));
+        wrong = frame;
+        wrong[4] = static_cast<char>(Version + 1);
+        QVERIFY(!readFrame(wrong.data(), wrong.size(), read));
+    }
 }
 
 //! main
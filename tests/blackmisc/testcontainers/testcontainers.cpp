@@ -24,6 +24,7 @@
 #include "blackmisc/range.h"
 #include "blackmisc/registermetadata.h"
 #include "blackmisc/sequence.h"
+#include "blackmisc/spscringbuffer.h"
 #include "blackmisc/math/mathutils.h"
 #include "test.h"
 
@@ -70,6 +71,7 @@ namespace BlackMiscTest
         void dictionaryBasics();
         void timestampList();
         void offsetTimestampList();
+        void spscRingBuffer();
     };
 
     void CTestContainers::initTestCase()
@@ -424,6 +426,32 @@ namespace BlackMiscTest
             }
         }
     }
+
+    void CTestContainers::spscRingBuffer()
+    {
+        CSpscRingBuffer<QString> ring(3);
+        QVERIFY2(ring.capacity() == 4, "Capacity rounded up to power of 2");
+        QVERIFY2(ring.isEmpty(), "Initially empty");
+
+        QString value;
+        QVERIFY2(!ring.tryPop(value), "Nothing to pop");
+        for (int i = 0; i < 4; i++) { QVERIFY2(ring.tryPush(QString::number(i)), "Push until full"); }
+        QVERIFY2(!ring.tryPush(QStringLiteral("4")), "Full");
+        QVERIFY2(ring.size() == 4, "Wrong size");
+
+        // wrap around several times, FIFO order
+        for (int i = 4; i < 20; i++)
+        {
+            QVERIFY2(ring.tryPop(value), "Pop");
+            QVERIFY2(value == QString::number(i - 4), "Wrong order");
+            QVERIFY2(ring.tryPush(QString::number(i)), "Push after pop");
+        }
+        for (int i = 16; i < 20; i++)
+        {
+            QVERIFY2(ring.tryPop(value) && value == QString::number(i), "Wrong order");
+        }
+        QVERIFY2(ring.isEmpty(), "Empty after popping all");
+    }
 } //namespace
 
 //! main
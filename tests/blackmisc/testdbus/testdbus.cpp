@@ -15,14 +15,18 @@
 
 #include "blackmisc/registermetadata.h"
 #include "blackmisc/simulation/simulatedaircraftlist.h"
+#include "blackmisc/aviation/atcstationlist.h"
+#include "blackmisc/test/testing.h"
 #include "blackmisc/test/testservice.h"
 #include "blackmisc/test/testserviceinterface.h"
+#include "blackmisc/dbusblobcall.h"
 #include "blackmisc/dbusutils.h"
 #include "test.h"
 #include <QDBusConnection>
 #include <QTest>
 
 using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
 using namespace BlackMisc::Simulation;
 using namespace BlackMisc::Test;
 
@@ -42,6 +46,9 @@ namespace BlackMiscTest
 
         //! Signature size
         void signatureSize();
+
+        //! Slot called with arguments and return value as blobs
+        void blobCall();
     };
 
     void CTestDBus::initTestCase()
@@ -82,6 +89,23 @@ namespace BlackMiscTest
         s = CDBusUtils::dBusSignature(al);
         QVERIFY2(s.length() <= max, "Signature CSimulatedAircraftList");
     }
+
+    void CTestDBus::blobCall()
+    {
+        CTestService testService(false);
+        const CAtcStationList stations = CTesting::createAtcStations(100, false);
+
+        QVariant result;
+        QVERIFY(CDBusBlobCall::unpackResult(CDBusBlobCall::invoke(&testService, "pingAtcStationList", CDBusBlobCall::packArguments({ QVariant::fromValue(stations) })), result));
+        QCOMPARE(result.value<CAtcStationList>(), stations);
+
+        QVERIFY(CDBusBlobCall::unpackResult(CDBusBlobCall::invoke(&testService, "getAtcStationList", CDBusBlobCall::packArguments({ 5 })), result));
+        QCOMPARE(result.value<CAtcStationList>().size(), 5);
+
+        // unknown slot or wrong arguments
+        QVERIFY(CDBusBlobCall::invoke(&testService, "noSuchSlot", CDBusBlobCall::packArguments({})).isEmpty());
+        QVERIFY(CDBusBlobCall::invoke(&testService, "getAtcStationList", CDBusBlobCall::packArguments({ 1, 2 })).isEmpty());
+    }
 }
 
 //! main
@@ -0,0 +1,177 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/json.h"
+#include "test.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QObject>
+#include <QTest>
+#include <QVector>
+
+using namespace BlackMisc;
+
+namespace BlackMiscTest
+{
+    //! Raw JSON splitting, as used for the VATSIM data file
+    class CTestJson : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Escaped quotes and backslashes in keys and values
+        void escapes();
+
+        //! Nested objects and arrays are kept as raw values
+        void nesting();
+
+        //! Empty object and array
+        void empty();
+
+        //! Whitespace between the tokens
+        void whitespace();
+
+        //! Malformed and truncated input is rejected
+        void malformed();
+
+        //! The raw values are the same as the values of a parsed document
+        void sameAsDocument();
+    };
+
+    void CTestJson::escapes()
+    {
+        QHash<QString, QByteArray> members;
+        QVERIFY(Json::splitRawObjectMembers(R"({"a\"b":"x\\","c":"\\\"}",  "d\\":"]"})", members));
+        QCOMPARE(members.size(), 3);
+        QCOMPARE(members.value("a\"b"), QByteArray(R"("x\\")"));
+        QCOMPARE(members.value("c"), QByteArray(R"("\\\"}")"));
+        QCOMPARE(members.value("d\\"), QByteArray(R"("]")"));
+
+        QVector<QByteArray> elements;
+        QVERIFY(Json::splitRawArrayElements(R"(["\"","\\",",]"])", elements));
+        QCOMPARE(elements, QVector<QByteArray>({ R"("\"")", R"("\\")", R"(",]")" }));
+    }
+
+    void CTestJson::nesting()
+    {
+        QHash<QString, QByteArray> members;
+        QVERIFY(Json::splitRawObjectMembers(R"({"pilots":[{"callsign":"DLH1","flight_plan":{"route":"A [B] {C}"}},{"callsign":"DLH2"}],"general":{"version":3},"n":-1.5e3,"t":true,"z":null})", members));
+        QCOMPARE(members.size(), 5);
+        QCOMPARE(members.value("general"), QByteArray(R"({"version":3})"));
+        QCOMPARE(members.value("n"), QByteArray("-1.5e3"));
+        QCOMPARE(members.value("t"), QByteArray("true"));
+        QCOMPARE(members.value("z"), QByteArray("null"));
+
+        QVector<QByteArray> pilots;
+        QVERIFY(Json::splitRawArrayElements(members.value("pilots"), pilots));
+        QCOMPARE(pilots.size(), 2);
+        QCOMPARE(pilots[0], QByteArray(R"({"callsign":"DLH1","flight_plan":{"route":"A [B] {C}"}})"));
+        QCOMPARE(pilots[1], QByteArray(R"({"callsign":"DLH2"})"));
+
+        QVector<QByteArray> elements;
+        QVERIFY(Json::splitRawArrayElements("[[1,[2]],[],{}]", elements));
+        QCOMPARE(elements, QVector<QByteArray>({ "[1,[2]]", "[]", "{}" }));
+    }
+
+    void CTestJson::empty()
+    {
+        QHash<QString, QByteArray> members { { "stale", "1" } };
+        QVERIFY(Json::splitRawObjectMembers("{}", members));
+        QVERIFY(members.isEmpty());
+        QVERIFY(Json::splitRawObjectMembers(" { \n } ", members));
+        QVERIFY(members.isEmpty());
+
+        QVector<QByteArray> elements { "stale" };
+        QVERIFY(Json::splitRawArrayElements("[]", elements));
+        QVERIFY(elements.isEmpty());
+        QVERIFY(Json::splitRawArrayElements("[\t]", elements));
+        QVERIFY(elements.isEmpty());
+
+        QVERIFY(Json::splitRawObjectMembers(R"({"a":{},"b":[]})", members));
+        QCOMPARE(members.value("a"), QByteArray("{}"));
+        QCOMPARE(members.value("b"), QByteArray("[]"));
+    }
+
+    void CTestJson::whitespace()
+    {
+        QHash<QString, QByteArray> members;
+        QVERIFY(Json::splitRawObjectMembers("\r\n{ \"a\" :\t1 ,\n\"b\"\r\n:\n[ 1 , 2 ]\n}\r\n", members));
+        QCOMPARE(members.size(), 2);
+        QCOMPARE(members.value("a"), QByteArray("1"));
+        QCOMPARE(members.value("b"), QByteArray("[ 1 , 2 ]"));
+
+        QVector<QByteArray> elements;
+        QVERIFY(Json::splitRawArrayElements(" [ 1 ,\"x y\" , { \"a\" : 2 } ] ", elements));
+        QCOMPARE(elements, QVector<QByteArray>({ "1", "\"x y\"", "{ \"a\" : 2 }" }));
+    }
+
+    void CTestJson::malformed()
+    {
+        QHash<QString, QByteArray> members;
+        QVector<QByteArray> elements;
+        const QVector<QByteArray> malformedObjects
+        {
+            "", "   ", "[]", "{", "}", "{\"a\"}", "{\"a\":}", "{\"a\" 1}", "{a:1}", "{\"a\":1,}", "{\"a\":1 \"b\":2}",
+            "{\"a\":1}}", "{\"a\":1} x", "{\"a\":\"1}", "{\"a\":\"1\\\"}", "{\"a\":[1,2}", "{\"a\":{\"b\":1}",
+            "{\"pilots\":[{\"callsign\":\"DLH1\"},{\"callsign\":\"DL" // truncated download
+        };
+        for (const QByteArray &json : malformedObjects)
+        {
+            QVERIFY2(!Json::splitRawObjectMembers(json, members), json.constData());
+        }
+
+        const QVector<QByteArray> malformedArrays
+        {
+            "", "{}", "[", "]", "[1,]", "[,1]", "[1 2]", "[1]]", "[1] x", "[\"1]", "[[1]", "[{\"a\":1]", "[1,\"a"
+        };
+        for (const QByteArray &json : malformedArrays)
+        {
+            QVERIFY2(!Json::splitRawArrayElements(json, elements), json.constData());
+        }
+    }
+
+    void CTestJson::sameAsDocument()
+    {
+        const QByteArray json = R"({"general":{"version":3,"update":"20200101"},"pilots":[{"callsign":"DLH1","latitude":50.1,"altitude":35000,"remarks":"\/v\/ \"quoted\""},{"callsign":"BAW2","flight_plan":null}],"controllers":[]})";
+        const QJsonObject document = QJsonDocument::fromJson(json).object();
+        QHash<QString, QByteArray> members;
+        QVERIFY(Json::splitRawObjectMembers(json, members));
+        QCOMPARE(members.size(), document.size());
+        for (auto it = document.constBegin(); it != document.constEnd(); ++it)
+        {
+            // wrapped, so scalars can be compared as well
+            const QJsonValue raw = QJsonDocument::fromJson("[" + members.value(it.key()) + "]").array().at(0);
+            QCOMPARE(raw, it.value());
+        }
+
+        QVector<QByteArray> pilots;
+        QVERIFY(Json::splitRawArrayElements(members.value("pilots"), pilots));
+        const QJsonArray documentPilots = document.value("pilots").toArray();
+        QCOMPARE(pilots.size(), documentPilots.size());
+        for (int i = 0; i < pilots.size(); i++)
+        {
+            QCOMPARE(QJsonDocument::fromJson(pilots[i]).object(), documentPilots.at(i).toObject());
+        }
+    }
+}
+
+//! main
+BLACKTEST_APPLESS_MAIN(BlackMiscTest::CTestJson);
+
+#include "testjson.moc"
+
+//! \endcond
@@ -0,0 +1,27 @@
+load(common_pre)
+
+QT += core testlib
+
+TARGET = testjson
+CONFIG   -= app_bundle
+CONFIG   += blackconfig
+CONFIG   += blackmisc
+CONFIG   += testcase
+CONFIG   += no_testcase_installs
+
+TEMPLATE = app
+
+DEPENDPATH += \
+    . \
+    $$SourceRoot/src \
+    $$SourceRoot/tests \
+
+INCLUDEPATH += \
+    $$SourceRoot/src \
+    $$SourceRoot/tests \
+
+SOURCES += testjson.cpp
+
+DESTDIR = $$DestRoot/bin
+
+load(common_post)
@@ -0,0 +1,202 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/loghandler.h"
+#include "blackmisc/logmessage.h"
+#include "blackmisc/logcategory.h"
+#include "blackmisc/logcategorylist.h"
+#include "blackmisc/statusmessage.h"
+#include "test.h"
+
+#include <QObject>
+#include <QScopedPointer>
+#include <QSemaphore>
+#include <QThread>
+#include <QTest>
+#include <QVector>
+
+using namespace BlackMisc;
+
+namespace BlackMiscTest
+{
+    //! Delivery of log messages logged in the main thread and in other threads
+    class CTestLogHandler : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Install the handler and subscribe
+        void initTestCase();
+
+        //! Clear the received messages
+        void init();
+
+        //! Messages of the main thread are delivered before the log call returns
+        void mainThreadSynchronous();
+
+        //! Messages of other threads are delivered by the main thread, in order
+        void crossThreadDispatch();
+
+        //! More messages than fit into the queue of a thread keep their order
+        void overflowOrder();
+
+        //! Format strings are still valid when the message is formatted by the main thread
+        void ownedFormat();
+
+    private:
+        //! Messages received by the subscriber
+        struct CReceived
+        {
+            QString message;  //!< message text
+            bool mainThread;  //!< received in the main thread
+        };
+
+        //! Log a numbered message
+        static void logNumbered(int number);
+
+        //! Check the received messages are numbered from 0 to count - 1
+        bool isInOrder(int count) const;
+
+        QVector<CReceived> m_received;
+        QString m_nestedMessage; //!< logged by the subscriber when receiving a message
+    };
+
+    namespace
+    {
+        const CLogCategory &testCategory()
+        {
+            static const CLogCategory category("swift.test.loghandler");
+            return category;
+        }
+    }
+
+    void CTestLogHandler::initTestCase()
+    {
+        CLogHandler::instance()->install(true);
+        CLogHandler::instance()->enableConsoleOutput(false);
+        CLogHandler::instance()->handlerForCategory(testCategory())->subscribe(this, [this](const CStatusMessage &message)
+        {
+            m_received.push_back({ message.getMessage(), QThread::currentThread() == this->thread() });
+            if (!m_nestedMessage.isEmpty() && message.getMessage() != m_nestedMessage)
+            {
+                CLogMessage(testCategory()).info(m_nestedMessage);
+            }
+        });
+    }
+
+    void CTestLogHandler::init()
+    {
+        CLogHandler::instance()->flush();
+        m_received.clear();
+        m_nestedMessage.clear();
+    }
+
+    void CTestLogHandler::mainThreadSynchronous()
+    {
+        logNumbered(0);
+        QCOMPARE(m_received.size(), 1);
+        QCOMPARE(m_received[0].message, QStringLiteral("message 0"));
+        QVERIFY(m_received[0].mainThread);
+
+        // a message logged by a subscriber is queued, then delivered after the message being delivered
+        m_nestedMessage = QStringLiteral("nested");
+        logNumbered(1);
+        QCOMPARE(m_received.size(), 2);
+        QCOMPARE(m_received[1].message, QStringLiteral("message 1"));
+        QTRY_COMPARE(m_received.size(), 3);
+        QCOMPARE(m_received[2].message, QStringLiteral("nested"));
+    }
+
+    void CTestLogHandler::crossThreadDispatch()
+    {
+        constexpr int count = 100;
+        QScopedPointer<QThread> thread(QThread::create([] { for (int i = 0; i < count; i++) { logNumbered(i); } }));
+        thread->start();
+        QVERIFY(thread->wait(10000));
+
+        // only dispatched by the event loop of the main thread
+        QVERIFY(m_received.isEmpty());
+        QTRY_COMPARE(m_received.size(), count);
+        QVERIFY(this->isInOrder(count));
+        for (const CReceived &received : m_received) { QVERIFY(received.mainThread); }
+
+        // main thread messages come after the messages queued before
+        thread.reset(QThread::create([] { logNumbered(count); }));
+        thread->start();
+        QVERIFY(thread->wait(10000));
+        logNumbered(count + 1);
+        QCOMPARE(m_received.size(), count + 2);
+        QVERIFY(this->isInOrder(count + 2));
+    }
+
+    void CTestLogHandler::overflowOrder()
+    {
+        constexpr int count = 2000; // many times the capacity of a queue
+        QSemaphore logged;
+        QSemaphore proceed;
+        QScopedPointer<QThread> thread(QThread::create([&]
+        {
+            for (int i = 0; i < count; i++) { logNumbered(i); }
+            logged.release();
+            proceed.acquire(); // logging again while the overflow of the first messages is dispatched
+            for (int i = count; i < 2 * count; i++) { logNumbered(i); }
+        }));
+        thread->start();
+        QVERIFY(logged.tryAcquire(1, 10000));
+        QVERIFY(m_received.isEmpty());
+
+        proceed.release();
+        CLogHandler::instance()->flush();
+        QVERIFY(thread->wait(10000));
+        QTRY_COMPARE(m_received.size(), 2 * count);
+        QVERIFY(this->isInOrder(2 * count));
+    }
+
+    void CTestLogHandler::ownedFormat()
+    {
+        bool queued = false;
+        QScopedPointer<QThread> thread(QThread::create([&queued]
+        {
+            QString format = QStringLiteral("format %1");
+            queued = CLogHandler::logDeferred({ testCategory() }, CStatusMessage::SeverityInfo, CStrongStringView(QStringView(format)), { "0" });
+            format.fill(QChar('x')); // the view would show this
+            format.clear();
+        }));
+        thread->start();
+        QVERIFY(thread->wait(10000));
+        QVERIFY(queued);
+        QTRY_COMPARE(m_received.size(), 1);
+        QCOMPARE(m_received[0].message, QStringLiteral("format 0"));
+    }
+
+    void CTestLogHandler::logNumbered(int number)
+    {
+        CLogMessage(testCategory()).info(u"message %1") << number;
+    }
+
+    bool CTestLogHandler::isInOrder(int count) const
+    {
+        if (m_received.size() != count) { return false; }
+        for (int i = 0; i < count; i++)
+        {
+            if (m_received[i].message != QStringLiteral("message %1").arg(i)) { return false; }
+        }
+        return true;
+    }
+}
+
+//! main
+BLACKTEST_MAIN(BlackMiscTest::CTestLogHandler);
+
+#include "testloghandler.moc"
+
+//! \endcond
@@ -0,0 +1,133 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/db/paralleljsondecoding.h"
+#include "blackmisc/aviation/airlineicaocode.h"
+#include "blackmisc/parallel.h"
+#include "test.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QTest>
+#include <QThread>
+#include <QVector>
+#include <algorithm>
+#include <atomic>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Db;
+
+namespace BlackMiscTest
+{
+    //! Parallel helpers and the parallel decoding of DB JSON
+    class CTestParallel : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Each index is processed exactly once
+        void runInParallel();
+
+        //! Parallel work started by parallel work completes
+        void nestedRunInParallel();
+
+        //! Parallel decoding gives the same objects as decoding one by one
+        void decodeJsonArray();
+
+    private:
+        //! DB JSON of airlines
+        static QJsonArray airlinesJson(int count);
+    };
+
+    void CTestParallel::runInParallel()
+    {
+        for (int count : { 0, 1, 7, 1000 })
+        {
+            for (int chunkSize : { 1, 3, 64 })
+            {
+                QVector<int> calls(count, 0);
+                int *data = calls.data();
+                BlackMisc::runInParallel(count, [data](int i) { data[i]++; }, chunkSize);
+                QVERIFY2(std::all_of(calls.cbegin(), calls.cend(), [](int c) { return c == 1; }), "Index not processed exactly once");
+            }
+        }
+    }
+
+    void CTestParallel::nestedRunInParallel()
+    {
+        // more outer work than threads, so the inner calls find a busy pool
+        const int outer = 4 * qMax(2, QThread::idealThreadCount());
+        constexpr int inner = 100;
+        std::atomic_int sum { 0 };
+        BlackMisc::runInParallel(outer, [&](int)
+        {
+            BlackMisc::runInParallel(inner, [&](int i) { sum += i; });
+        });
+        QCOMPARE(sum.load(), outer * (inner * (inner - 1) / 2));
+    }
+
+    void CTestParallel::decodeJsonArray()
+    {
+        const QJsonArray array = airlinesJson(2000);
+        QVector<CAirlineIcaoCode> serial;
+        for (const QJsonValue &value : array) { serial.push_back(CAirlineIcaoCode::fromDatabaseJson(value.toObject())); }
+        QCOMPARE(serial.size(), array.size());
+
+        for (int chunkSize : { 1, 7, 256, 5000 })
+        {
+            std::atomic_int decoders { 0 };
+            const QVector<CAirlineIcaoCode> parallel = decodeJsonArrayInParallel<CAirlineIcaoCode>(array, [&decoders]
+            {
+                decoders++;
+                return [](const QJsonObject &json) { return CAirlineIcaoCode::fromDatabaseJson(json); };
+            }, chunkSize);
+            QCOMPARE(parallel, serial);
+            QVERIFY2(decoders >= 1 && decoders <= qMax(1, QThread::idealThreadCount()), "One decoder per thread expected");
+        }
+
+        QVERIFY(decodeJsonArrayInParallel<CAirlineIcaoCode>(QJsonArray(), []
+        {
+            return [](const QJsonObject &json) { return CAirlineIcaoCode::fromDatabaseJson(json); };
+        }).isEmpty());
+    }
+
+    QJsonArray CTestParallel::airlinesJson(int count)
+    {
+        QJsonArray array;
+        for (int i = 0; i < count; i++)
+        {
+            const QString designator = QString(QChar('A' + i % 26)) + QChar('A' + (i / 26) % 26) + QChar('A' + (i / 676) % 26);
+            QJsonObject json;
+            json.insert("id", i + 1);
+            json.insert("designator", designator);
+            json.insert("iata", designator.left(2));
+            json.insert("callsign", QStringLiteral("CALLSIGN %1").arg(i));
+            json.insert("name", QStringLiteral("Airline %1").arg(i));
+            json.insert("country", QStringLiteral("DE"));
+            json.insert("countryname", QStringLiteral("Germany"));
+            json.insert("va", i % 3 == 0 ? "Y" : "N");
+            json.insert("operating", i % 5 == 0 ? "N" : "Y");
+            json.insert("military", "N");
+            json.insert("lastupdated", QStringLiteral("2020-01-01 12:00:00"));
+            array.push_back(json);
+        }
+        return array;
+    }
+}
+
+//! main
+BLACKTEST_APPLESS_MAIN(BlackMiscTest::CTestParallel);
+
+#include "testparallel.moc"
+
+//! \endcond
@@ -13,6 +13,7 @@
 #include "blackmisc/valuecache.h"
 #include "blackmisc/aviation/atcstation.h"
 #include "blackmisc/aviation/atcstationlist.h"
+#include "blackmisc/binarycachefile.h"
 #include "blackmisc/dictionary.h"
 #include "blackmisc/identifier.h"
 #include "blackmisc/registermetadata.h"
@@ -78,6 +79,9 @@ namespace BlackMiscTest
 
         //! Test saving to and loading from files.
         void saveAndLoad();
+
+        //! Test saving to and loading from binary files.
+        void saveAndLoadBinary();
     };
 
     //! Simple class which uses CCached, for testing.
@@ -313,6 +317,76 @@ namespace BlackMiscTest
         QCOMPARE(test2Values, testData);
     }
 
+    void CTestValueCache::saveAndLoadBinary()
+    {
+        CSimulatedAircraftList aircraft({ CSimulatedAircraft("BAW001", {}, {}) });
+        CAtcStationList atcStations({ CAtcStation("EGLL_TWR") });
+        const CVariantMap testData
+        {
+            { "namespace1/value1", CVariant::from(1) },
+            { "namespace1/value2", CVariant::from(2) },
+            { "namespace2/aircraft", CVariant::from(aircraft) },
+            { "namespace2/atcstations", CVariant::from(atcStations) }
+        };
+        CValueCache cache(1);
+        cache.setBinaryFileFormat(true);
+        cache.insertValues({ testData, QDateTime::currentMSecsSinceEpoch() });
+
+        QDir dir(QDir::currentPath() + "/testcachebinary");
+        if (dir.exists()) { dir.removeRecursively(); }
+
+        auto status = cache.saveToFiles(dir.absolutePath());
+        QVERIFY(status.isSuccess());
+
+        auto files = dir.entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot, QDir::Name);
+        QCOMPARE(files.size(), 2);
+        QCOMPARE(files[0].fileName(), QString("namespace1.bin"));
+        QCOMPARE(files[1].fileName(), QString("namespace2.bin"));
+
+        // single value, only that one is deserialized
+        CBinaryCacheFile binaryFile(files[1].absoluteFilePath());
+        QVERIFY(binaryFile.open());
+        QCOMPARE(binaryFile.keys(), QStringList({ "namespace2/aircraft", "namespace2/atcstations" }));
+        CVariant value;
+        QVERIFY(binaryFile.value("namespace2/atcstations", value));
+        QCOMPARE(value, CVariant::from(atcStations));
+        binaryFile.close();
+
+        // loading does not depend on the format used for saving
+        CValueCache cache2(1);
+        status = cache2.loadFromFiles(dir.absolutePath());
+        QVERIFY(status.isSuccess());
+        QCOMPARE(cache2.getAllValues(), testData);
+
+        // JSON export for diagnostics, the JSON files contain the same values
+        status = cache2.exportToJsonFiles(dir.absolutePath());
+        QVERIFY(status.isSuccess());
+        QVERIFY(QFileInfo::exists(dir.absoluteFilePath("namespace1.json")));
+
+        // binary files saved again, with the same timestamp as the JSON files or not they supersede them
+        status = cache.saveToFiles(dir.absolutePath());
+        QVERIFY(status.isSuccess());
+
+        // corrupted value is detected by its checksum
+        QFile corrupted(files[0].absoluteFilePath());
+        QVERIFY(corrupted.open(QFile::ReadWrite));
+        QVERIFY(corrupted.seek(corrupted.size() - 1));
+        char last = 0;
+        QVERIFY(corrupted.getChar(&last));
+        QVERIFY(corrupted.seek(corrupted.size() - 1));
+        QVERIFY(corrupted.putChar(static_cast<char>(~last)));
+        corrupted.close();
+        CBinaryCacheFile corruptedFile(files[0].absoluteFilePath());
+        QVERIFY(corruptedFile.open());
+        QVERIFY(!corruptedFile.value("namespace1/value2", value));
+        corruptedFile.close();
+
+        // falls back to the JSON file
+        CValueCache cache3(1);
+        cache3.loadFromFiles(dir.absolutePath());
+        QCOMPARE(cache3.getAllValues(), testData);
+    }
+
     //! Is value between 0 - 100?
     bool validator(int value, QString &)
     {
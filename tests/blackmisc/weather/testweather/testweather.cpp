@@ -12,6 +12,7 @@
 
 #include "blackmisc/aviation/airporticaocode.h"
 #include "blackmisc/aviation/altitude.h"
+#include "blackmisc/fileutils.h"
 #include "blackmisc/mixin/mixincompare.h"
 #include "blackmisc/pq/angle.h"
 #include "blackmisc/pq/length.h"
@@ -21,10 +22,12 @@
 #include "blackmisc/pq/temperature.h"
 #include "blackmisc/pq/time.h"
 #include "blackmisc/pq/units.h"
+#include "blackmisc/swiftdirectories.h"
 #include "blackmisc/weather/cloudlayer.h"
 #include "blackmisc/weather/cloudlayerlist.h"
 #include "blackmisc/weather/metar.h"
 #include "blackmisc/weather/metardecoder.h"
+#include "blackmisc/weather/metarlist.h"
 #include "blackmisc/weather/presentweather.h"
 #include "blackmisc/weather/presentweatherlist.h"
 #include "blackmisc/weather/temperaturelayer.h"
@@ -37,6 +40,7 @@
 
 #include <QTest>
 
+using namespace BlackMisc;
 using namespace BlackMisc::Weather;
 using namespace BlackMisc::Aviation;
 using namespace BlackMisc::PhysicalQuantities;
@@ -63,6 +67,9 @@ namespace BlackMiscTest
 
         //! Testing METAR decoder
         void metarDecoder();
+
+        //! Testing single pass METAR decoder against the regular expressions, and parallel decoding of a METAR file
+        void metarDecoderFile();
     };
 
     void CTestWeather::cloudLayer()
@@ -215,10 +222,35 @@ namespace BlackMiscTest
         QVERIFY2(cloudLayers2.findByBase(CAltitude(30000, CAltitude::AboveGround, CLengthUnit::ft())).getCoverage() == CCloudLayer::Scattered, "Failed to parse cloud layer in 30000 ft");
     }
 
+    void CTestWeather::metarDecoderFile()
+    {
+        const QString metarFile = CFileUtils::readFileToString(CSwiftDirectories::shareTestDirectory(), "metars.txt");
+        QVERIFY2(!metarFile.isEmpty(), "Missing METAR test file");
+
+        CMetarDecoder metarDecoder;
+        CMetarList expectedMetars;
+        int expectedInvalid = 0;
+        for (const QString &line : metarFile.split('\n'))
+        {
+            if (line.trimmed().isEmpty()) { continue; }
+            const CMetar metar = metarDecoder.decodeByRegularExpressions(line);
+            QVERIFY2(metarDecoder.decode(line) == metar, qPrintable("Different METAR for: " + line));
+            if (metar == CMetar()) { expectedInvalid++; }
+            else { expectedMetars.push_back(metar); }
+        }
+        QVERIFY2(expectedMetars.size() > 100, "Too few valid METARs");
+        QVERIFY2(expectedInvalid > 0, "Invalid METARs expected");
+
+        int invalid = 0;
+        const CMetarList metars = metarDecoder.decodeMetarFile(metarFile, &invalid);
+        QVERIFY2(metars == expectedMetars, "Parallel decoding differs");
+        QCOMPARE(invalid, expectedInvalid);
+    }
+
 } // namespace
 
 //! main
-BLACKTEST_APPLESS_MAIN(BlackMiscTest::CTestWeather);
+BLACKTEST_MAIN(BlackMiscTest::CTestWeather);
 
 #include "testweather.moc"
 